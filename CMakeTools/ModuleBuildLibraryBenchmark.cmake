@@ -0,0 +1,42 @@
+# This module configures how to build benchmarks for a library
+# The following arguments are valid:
+# 	CRIMILD_LIBRARY_NAME: (Required) Name of the library
+#	CRIMILD_LIBRARY_DEPENDENCIES: (Optional) Any dependencies that are required in order to build the library
+#	CRIMILD_INCLUDE_DIRECTORIES: (Optional) Additional include directories for dependencies
+#	CRIMILD_LINK_DIRECTORIES: (Optional) Additional link directories for dependencies
+
+MESSAGE( "   Adding benchmarks" )
+
+FIND_PACKAGE( Threads )
+
+FILE( GLOB_RECURSE CRIMILD_BENCHMARKS_SOURCE_FILES "${CRIMILD_SOURCE_DIR}/${CRIMILD_LIBRARY_NAME}/bench/*.cpp" )
+
+# All libraries share the runner from core
+IF ( NOT ${CRIMILD_LIBRARY_NAME} STREQUAL "core" )
+	SET( CRIMILD_BENCHMARKS_SOURCE_FILES
+		${CRIMILD_BENCHMARKS_SOURCE_FILES}
+		${CRIMILD_SOURCE_DIR}/core/bench/BenchmarkRunner.cpp )
+ENDIF ()
+
+SET( CRIMILD_BENCHMARKS_DEPENDENCIES
+	crimild_${CRIMILD_LIBRARY_NAME}
+	${CRIMILD_LIBRARY_DEPENDENCIES}
+	${CMAKE_THREAD_LIBS_INIT}
+)
+
+SET( CRIMILD_BENCHMARKS_INCLUDE_DIRECTORIES
+	${CRIMILD_SOURCE_DIR}/core/bench
+	${CRIMILD_SOURCE_DIR}/${CRIMILD_LIBRARY_NAME}/src
+	${CRIMILD_SOURCE_DIR}/${CRIMILD_LIBRARY_NAME}/bench
+	${CRIMILD_INCLUDE_DIRECTORIES}
+)
+
+INCLUDE_DIRECTORIES( ${CRIMILD_BENCHMARKS_INCLUDE_DIRECTORIES} )
+
+LINK_DIRECTORIES( ${CRIMILD_LINK_DIRECTORIES} )
+
+SET( CRIMILD_BENCHMARK_EXECUTABLE_NAME crimild_${CRIMILD_LIBRARY_NAME}_bench )
+
+ADD_EXECUTABLE( ${CRIMILD_BENCHMARK_EXECUTABLE_NAME} ${CRIMILD_BENCHMARKS_SOURCE_FILES} )
+
+TARGET_LINK_LIBRARIES( ${CRIMILD_BENCHMARK_EXECUTABLE_NAME} ${CRIMILD_BENCHMARKS_DEPENDENCIES} )
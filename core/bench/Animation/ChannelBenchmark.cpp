@@ -0,0 +1,142 @@
+/*
+ * Copyright (c) 2013, Hernan Saez
+ * All rights reserved.
+ * 
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *     * Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in the
+ *       documentation and/or other materials provided with the distribution.
+ *     * Neither the name of the <organization> nor the
+ *       names of its contributors may be used to endorse or promote products
+ *       derived from this software without specific prior written permission.
+ * 
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL <COPYRIGHT HOLDER> BE LIABLE FOR ANY
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "Utils/Benchmark.hpp"
+
+#include "Animation/ChannelImpl.hpp"
+
+#include <random>
+#include <sstream>
+
+using namespace crimild;
+using namespace crimild::animation;
+using namespace crimild::benchmark;
+
+namespace crimild {
+
+	namespace benchmark {
+
+		/**
+		   \brief The lookup channels used to do, scanning all keys from the beginning
+		 */
+		static void linearScanSample( containers::Array< crimild::Real32 > const &times, containers::Array< crimild::Real32 > const &keys, crimild::Real32 t, crimild::Real32 &result )
+		{
+			if ( t <= times.first() ) {
+				result = keys.first();
+				return;
+			}
+
+			if ( t >= times.last() ) {
+				result = keys.last();
+				return;
+			}
+
+			crimild::Size index = 0;
+			for ( ; index < times.size() - 1; index++ ) {
+				if ( t < times[ index + 1 ] ) {
+					break;
+				}
+			}
+
+			const auto u = ( t - times[ index ] ) / ( times[ index + 1 ] - times[ index ] );
+			Interpolation::linear( keys[ index ], keys[ index + 1 ], u, result );
+		}
+
+	}
+
+}
+
+CRIMILD_BENCHMARK( Animation, channels )
+{
+	// evaluations per run, playing the clip forward at 60 fps
+	const crimild::Size EVALUATIONS = 1000;
+	const crimild::Real32 DT = 1.0f / 60.0f;
+
+	std::mt19937 rng( 1234 );
+	std::uniform_real_distribution< crimild::Real32 > jitter( 0.5f, 1.5f );
+
+	for ( crimild::Size keyCount : { 16, 256, 4096, 65536 } ) {
+		// unevenly spaced keys, about 30 per second
+		containers::Array< crimild::Real32 > times( keyCount );
+		containers::Array< crimild::Real32 > keys( keyCount );
+		crimild::Real32 time = 0.0f;
+		for ( crimild::Size i = 0; i < keyCount; i++ ) {
+			times[ i ] = time;
+			keys[ i ] = jitter( rng );
+			time += jitter( rng ) / 30.0f;
+		}
+
+		auto channel = crimild::alloc< Real32Channel >( "channel", times, keys );
+		auto uniform = crimild::alloc< Real32Channel >( "channel", times, keys );
+		uniform->resample( 30.0f );
+
+		const auto duration = channel->getDuration();
+
+		std::stringstream prefix;
+		prefix << keyCount << " keys: ";
+
+		crimild::Real32 t = 0.0f;
+		crimild::Real32 result = 0.0f;
+		auto advance = [ & ] {
+			t += DT;
+			if ( t >= duration ) {
+				t -= duration;
+			}
+		};
+
+		bm.measure( prefix.str() + "linear scan", EVALUATIONS, [ & ] {
+			for ( crimild::Size i = 0; i < EVALUATIONS; i++ ) {
+				linearScanSample( times, keys, t, result );
+				advance();
+			}
+		});
+
+		bm.measure( prefix.str() + "binary search", EVALUATIONS, [ & ] {
+			for ( crimild::Size i = 0; i < EVALUATIONS; i++ ) {
+				// an invalid cursor forces a search every time
+				crimild::Size cursor = keyCount;
+				channel->sample( t, cursor, result );
+				advance();
+			}
+		});
+
+		crimild::Size cursor = 0;
+		bm.measure( prefix.str() + "cached cursor", EVALUATIONS, [ & ] {
+			for ( crimild::Size i = 0; i < EVALUATIONS; i++ ) {
+				channel->sample( t, cursor, result );
+				advance();
+			}
+		});
+
+		bm.measure( prefix.str() + "uniform samples", EVALUATIONS, [ & ] {
+			for ( crimild::Size i = 0; i < EVALUATIONS; i++ ) {
+				uniform->sample( t, cursor, result );
+				advance();
+			}
+		});
+	}
+}
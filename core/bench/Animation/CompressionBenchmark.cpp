@@ -0,0 +1,158 @@
+/*
+ * Copyright (c) 2013, Hernan Saez
+ * All rights reserved.
+ * 
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *     * Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in the
+ *       documentation and/or other materials provided with the distribution.
+ *     * Neither the name of the <organization> nor the
+ *       names of its contributors may be used to endorse or promote products
+ *       derived from this software without specific prior written permission.
+ * 
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL <COPYRIGHT HOLDER> BE LIABLE FOR ANY
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "Utils/Benchmark.hpp"
+
+#include "Animation/ChannelImpl.hpp"
+#include "Animation/CompressedChannel.hpp"
+
+#include <cmath>
+
+using namespace crimild;
+using namespace crimild::animation;
+using namespace crimild::benchmark;
+
+CRIMILD_BENCHMARK( Animation, compression )
+{
+	// a typical character clip: 10 seconds at 30 fps for 64 joints
+	const crimild::Size JOINT_COUNT = 64;
+	const crimild::Size KEY_COUNT = 300;
+	const crimild::Real32 TOLERANCE = 0.001f;
+	const crimild::Real32 DT = 1.0f / 60.0f;
+
+	containers::Array< crimild::Real32 > times( KEY_COUNT );
+	for ( crimild::Size i = 0; i < KEY_COUNT; i++ ) {
+		times[ i ] = i / 30.0f;
+	}
+
+	containers::Array< SharedPointer< Vector3fChannel >> positions;
+	containers::Array< SharedPointer< Quaternion4fChannel >> rotations;
+	containers::Array< SharedPointer< Real32Channel >> scales;
+
+	for ( crimild::Size j = 0; j < JOINT_COUNT; j++ ) {
+		containers::Array< Vector3f > p( KEY_COUNT );
+		containers::Array< Quaternion4f > r( KEY_COUNT );
+		containers::Array< crimild::Real32 > s( KEY_COUNT );
+		for ( crimild::Size i = 0; i < KEY_COUNT; i++ ) {
+			const auto t = times[ i ];
+			// only the root joint moves, the rest have constant offsets
+			p[ i ] = j == 0 ? Vector3f( t, 0.1f * std::sin( 8.0f * t ), 0.0f ) : Vector3f( 0.0f, 0.5f, 0.0f );
+			r[ i ] = Quaternion4f::createFromAxisAngle( Vector3f( 1.0f, 0.0f, 0.0f ), 0.5f * std::sin( 2.0f * t + j ) );
+			s[ i ] = 1.0f;
+		}
+		positions.add( crimild::alloc< Vector3fChannel >( "p", times, p ) );
+		rotations.add( crimild::alloc< Quaternion4fChannel >( "r", times, r ) );
+		scales.add( crimild::alloc< Real32Channel >( "s", times, s ) );
+	}
+
+	crimild::Size rawSize = 0;
+	crimild::Size compressedSize = 0;
+	crimild::Size compressedKeys = 0;
+
+	containers::Array< SharedPointer< CompressedVector3fChannel >> compressedPositions;
+	containers::Array< SharedPointer< CompressedQuaternion4fChannel >> compressedRotations;
+	containers::Array< SharedPointer< CompressedReal32Channel >> compressedScales;
+
+	for ( crimild::Size j = 0; j < JOINT_COUNT; j++ ) {
+		auto p = crimild::alloc< CompressedVector3fChannel >( "p", times, positions[ j ]->getKeys(), TOLERANCE );
+		auto r = crimild::alloc< CompressedQuaternion4fChannel >( "r", times, rotations[ j ]->getKeys(), TOLERANCE );
+		auto s = crimild::alloc< CompressedReal32Channel >( "s", times, scales[ j ]->getKeys(), TOLERANCE );
+		compressedPositions.add( p );
+		compressedRotations.add( r );
+		compressedScales.add( s );
+
+		rawSize += KEY_COUNT * ( 3 * sizeof( crimild::Real32 ) + sizeof( Vector3f ) + sizeof( Quaternion4f ) + sizeof( crimild::Real32 ) );
+		compressedSize += p->getSizeInBytes() + r->getSizeInBytes() + s->getSizeInBytes();
+		compressedKeys += p->getKeyCount() + r->getKeyCount() + s->getKeyCount();
+	}
+
+	bm.report( "Raw size", rawSize / 1024.0, "KB" );
+	bm.report( "Compressed size", compressedSize / 1024.0, "KB" );
+	bm.report( "Compression ratio", crimild::Real64( rawSize ) / compressedSize, "x" );
+	bm.report( "Keys kept", 100.0 * compressedKeys / ( 3 * JOINT_COUNT * KEY_COUNT ), "%" );
+
+	// measure the error introduced by compression
+	crimild::Real64 maxPositionError = 0.0;
+	crimild::Real64 maxRotationError = 0.0;
+	for ( crimild::Size j = 0; j < JOINT_COUNT; j++ ) {
+		crimild::Size c0 = 0, c1 = 0, c2 = 0, c3 = 0;
+		for ( crimild::Real32 t = 0.0f; t < times.last(); t += DT ) {
+			Vector3f p0, p1;
+			positions[ j ]->sample( t, c0, p0 );
+			compressedPositions[ j ]->sample( t, c1, p1 );
+			maxPositionError = Numericd::max( maxPositionError, ( p0 - p1 ).getMagnitude() );
+
+			Quaternion4f r0, r1;
+			rotations[ j ]->sample( t, c2, r0 );
+			compressedRotations[ j ]->sample( t, c3, r1 );
+			maxRotationError = Numericd::max( maxRotationError, compression::KeyCodec< Quaternion4f >::error( r0, r1 ) );
+		}
+	}
+	bm.report( "Max position error", maxPositionError, "units" );
+	bm.report( "Max rotation error", maxRotationError, "rad" );
+
+	// per-sample decode cost, evaluating every channel once per frame
+	containers::Array< crimild::Size > cursors( 3 * JOINT_COUNT );
+	crimild::Real32 t = 0.0f;
+	auto reset = [ & ] {
+		for ( crimild::Size i = 0; i < cursors.size(); i++ ) {
+			cursors[ i ] = 0;
+		}
+		t = 0.0f;
+	};
+
+	auto advance = [ & ] {
+		t += DT;
+		if ( t >= times.last() ) {
+			t = 0.0f;
+		}
+	};
+
+	Vector3f p;
+	Quaternion4f r;
+	crimild::Real32 s;
+
+	reset();
+	bm.measure( "Sample (raw)", 3 * JOINT_COUNT, [ & ] {
+		for ( crimild::Size j = 0; j < JOINT_COUNT; j++ ) {
+			positions[ j ]->sample( t, cursors[ 3 * j + 0 ], p );
+			rotations[ j ]->sample( t, cursors[ 3 * j + 1 ], r );
+			scales[ j ]->sample( t, cursors[ 3 * j + 2 ], s );
+		}
+		advance();
+	});
+
+	reset();
+	bm.measure( "Sample (compressed)", 3 * JOINT_COUNT, [ & ] {
+		for ( crimild::Size j = 0; j < JOINT_COUNT; j++ ) {
+			compressedPositions[ j ]->sample( t, cursors[ 3 * j + 0 ], p );
+			compressedRotations[ j ]->sample( t, cursors[ 3 * j + 1 ], r );
+			compressedScales[ j ]->sample( t, cursors[ 3 * j + 2 ], s );
+		}
+		advance();
+	});
+}
@@ -0,0 +1,201 @@
+/*
+ * Copyright (c) 2013, Hernan Saez
+ * All rights reserved.
+ * 
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *     * Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in the
+ *       documentation and/or other materials provided with the distribution.
+ *     * Neither the name of the <organization> nor the
+ *       names of its contributors may be used to endorse or promote products
+ *       derived from this software without specific prior written permission.
+ * 
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL <COPYRIGHT HOLDER> BE LIABLE FOR ANY
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "Utils/Benchmark.hpp"
+
+#include "Animation/Animation.hpp"
+#include "Animation/ChannelImpl.hpp"
+#include "Animation/Clip.hpp"
+#include "Animation/PoseBatch.hpp"
+#include "Animation/Skeleton.hpp"
+#include "Concurrency/JobScheduler.hpp"
+#include "SceneGraph/Group.hpp"
+#include "Visitors/UpdateWorldState.hpp"
+
+#include <cmath>
+#include <sstream>
+#include <vector>
+
+using namespace crimild;
+using namespace crimild::animation;
+using namespace crimild::benchmark;
+
+namespace crimild {
+
+	namespace benchmark {
+
+		/**
+		   \brief A character with a spine and four limbs
+		 */
+		static SharedPointer< Group > buildCharacter( crimild::Size jointsPerLimb )
+		{
+			auto root = crimild::alloc< Group >();
+			crimild::UInt32 jointId = 0;
+
+			auto addJoint = [ &jointId ]( Group *parent ) {
+				auto node = crimild::alloc< Group >();
+				node->local().setTranslate( 0.0f, 0.2f, 0.0f );
+				node->attachComponent< Joint >( "joint_" + std::to_string( jointId ), jointId );
+				++jointId;
+				parent->attachNode( node );
+				return crimild::get_ptr( node );
+			};
+
+			auto spine = crimild::get_ptr( root );
+			for ( crimild::Size i = 0; i < jointsPerLimb; i++ ) {
+				spine = addJoint( spine );
+			}
+
+			for ( crimild::Size limb = 0; limb < 4; limb++ ) {
+				auto parent = spine;
+				for ( crimild::Size i = 0; i < jointsPerLimb; i++ ) {
+					parent = addJoint( parent );
+				}
+			}
+
+			root->attachComponent< Skeleton >()->bind();
+			root->perform( UpdateWorldState() );
+			return root;
+		}
+
+		static SharedPointer< Clip > buildClip( std::string name, crimild::Size jointCount, crimild::Size keyCount, crimild::Real32 speed )
+		{
+			auto clip = crimild::alloc< Clip >( name );
+			clip->setFrameRate( 30.0f );
+
+			containers::Array< crimild::Real32 > times( keyCount );
+			for ( crimild::Size k = 0; k < keyCount; k++ ) {
+				times[ k ] = k;
+			}
+
+			for ( crimild::Size j = 0; j < jointCount; j++ ) {
+				containers::Array< Vector3f > positions( keyCount );
+				containers::Array< Quaternion4f > rotations( keyCount );
+				containers::Array< crimild::Real32 > scales( keyCount );
+				for ( crimild::Size k = 0; k < keyCount; k++ ) {
+					const auto phase = speed * k / keyCount * Numericf::TWO_PI + j;
+					positions[ k ] = Vector3f( 0.0f, 0.2f + 0.01f * std::sin( phase ), 0.0f );
+					rotations[ k ] = Quaternion4f::createFromAxisAngle( Vector3f( 1.0f, 0.0f, 0.0f ), 0.5f * std::sin( phase ) );
+					scales[ k ] = 1.0f;
+				}
+
+				auto jointName = "joint_" + std::to_string( j );
+				clip->addChannel( crimild::alloc< Vector3fChannel >( jointName + "[p]", times, positions ) );
+				clip->addChannel( crimild::alloc< Quaternion4fChannel >( jointName + "[r]", times, rotations ) );
+				clip->addChannel( crimild::alloc< Real32Channel >( jointName + "[s]", times, scales ) );
+			}
+
+			return clip;
+		}
+
+	}
+
+}
+
+CRIMILD_BENCHMARK( Animation, crowd )
+{
+	const crimild::Size CHARACTER_COUNT = 1000;
+	const crimild::Size JOINTS_PER_LIMB = 6;
+	const crimild::Size JOINT_COUNT = 5 * JOINTS_PER_LIMB;
+	const crimild::Size KEY_COUNT = 60;
+	const crimild::Real32 RUN_WEIGHT = 0.3f;
+	const crimild::Real64 DT = 1.0 / 60.0;
+	const int WORKER_COUNTS[] = { 1, 4 };
+
+	auto walk = buildClip( "walk", JOINT_COUNT, KEY_COUNT, 1.0f );
+	auto run = buildClip( "run", JOINT_COUNT, KEY_COUNT, 2.0f );
+
+	std::vector< SharedPointer< Group >> characters;
+	std::vector< SharedPointer< Animation >> walkAnimations;
+	std::vector< SharedPointer< Animation >> runAnimations;
+	std::vector< SharedPointer< PoseAnimator >> animators;
+
+	for ( crimild::Size i = 0; i < CHARACTER_COUNT; i++ ) {
+		auto character = buildCharacter( JOINTS_PER_LIMB );
+		auto skeleton = character->getComponent< Skeleton >();
+		characters.push_back( character );
+
+		walkAnimations.push_back( crimild::alloc< Animation >( walk ) );
+		runAnimations.push_back( crimild::alloc< Animation >( run ) );
+
+		// bindings could be shared since all skeletons are the same
+		auto animator = crimild::alloc< PoseAnimator >( crimild::retain( skeleton ) );
+		animator->addLayer( crimild::alloc< ClipBinding >( walk, skeleton ) );
+		animator->addLayer( crimild::alloc< ClipBinding >( run, skeleton ), RUN_WEIGHT );
+		animator->setTimeOffset( 0.01f * i );
+		animators.push_back( animator );
+	}
+
+	bm.report( "Joints per character", JOINT_COUNT, "joints" );
+
+	// Channels are resolved by name for each character
+	auto byName = [ & ] {
+		const Clock c( DT );
+		for ( crimild::Size i = 0; i < CHARACTER_COUNT; i++ ) {
+			walkAnimations[ i ]->update( c );
+			walkAnimations[ i ]->lerp( runAnimations[ i ], RUN_WEIGHT );
+			characters[ i ]->getComponent< Skeleton >()->animate( walkAnimations[ i ] );
+		}
+	};
+
+	bm.measure( "Animation (by name)", CHARACTER_COUNT, byName );
+	bm.measureAllocations( "Animation (by name)", byName );
+
+	auto compiled = [ & ] {
+		const Clock c( DT );
+		for ( auto &animator : animators ) {
+			animator->update( c );
+			animator->evaluate();
+			animator->apply();
+		}
+	};
+
+	bm.measure( "Compiled poses (sequential)", CHARACTER_COUNT, compiled );
+	bm.measureAllocations( "Compiled poses (sequential)", compiled );
+
+	PoseBatch batch;
+	auto batched = [ & ] {
+		const Clock c( DT );
+		for ( auto &animator : animators ) {
+			animator->update( c );
+			batch.add( animator );
+		}
+		batch.execute();
+	};
+
+	for ( auto workerCount : WORKER_COUNTS ) {
+		concurrency::JobScheduler scheduler;
+		scheduler.configure( workerCount - 1 );
+		scheduler.start();
+
+		std::stringstream label;
+		label << "Compiled poses (batch, " << workerCount << " workers)";
+		bm.measure( label.str(), CHARACTER_COUNT, batched );
+
+		scheduler.stop();
+	}
+}
@@ -0,0 +1,129 @@
+/*
+ * Copyright (c) 2013, Hernan Saez
+ * All rights reserved.
+ * 
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *     * Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in the
+ *       documentation and/or other materials provided with the distribution.
+ *     * Neither the name of the <organization> nor the
+ *       names of its contributors may be used to endorse or promote products
+ *       derived from this software without specific prior written permission.
+ * 
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL <COPYRIGHT HOLDER> BE LIABLE FOR ANY
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "Utils/Benchmark.hpp"
+
+#include "Animation/SkinningEngine.hpp"
+#include "Concurrency/JobScheduler.hpp"
+#include "Rendering/VertexBufferObject.hpp"
+
+#include <random>
+#include <sstream>
+
+using namespace crimild;
+using namespace crimild::animation;
+using namespace crimild::benchmark;
+
+CRIMILD_BENCHMARK( Animation, skinning )
+{
+	const crimild::Size VERTEX_COUNT = 50000;
+	const crimild::Size JOINT_COUNT = 64;
+	const int WORKER_COUNTS[] = { 1, 4 };
+
+	const SkinningEngine::Kernel KERNELS[] = {
+		SkinningEngine::Kernel::SCALAR,
+		SkinningEngine::Kernel::SSE,
+		SkinningEngine::Kernel::AVX,
+	};
+
+	const SkinningEngine::Method METHODS[] = {
+		SkinningEngine::Method::LINEAR_BLEND,
+		SkinningEngine::Method::DUAL_QUATERNION,
+	};
+
+	std::mt19937 rng( 1234 );
+	std::uniform_real_distribution< crimild::Real32 > value( -1.0f, 1.0f );
+	std::uniform_real_distribution< crimild::Real32 > unit( 0.0f, 1.0f );
+
+	SkinningPalette palette;
+	palette.resize( JOINT_COUNT );
+	for ( crimild::Size i = 0; i < JOINT_COUNT; i++ ) {
+		Transformation t;
+		t.setTranslate( value( rng ), value( rng ), value( rng ) );
+		t.setRotate( Quaternion4f::createFromAxisAngle( Vector3f( value( rng ), value( rng ), value( rng ) ).getNormalized(), Numericf::PI * value( rng ) ) );
+		palette.set( i, t.computeModelMatrix() );
+	}
+
+	// four influences per vertex, like the ones created by SceneImporter
+	auto input = crimild::alloc< VertexBufferObject >( VertexFormat( 3, 0, 3, 0, 2, 4, 4 ), VERTEX_COUNT );
+	for ( crimild::Size v = 0; v < VERTEX_COUNT; v++ ) {
+		input->setPositionAt( v, Vector3f( value( rng ), value( rng ), value( rng ) ) );
+		input->setNormalAt( v, Vector3f( value( rng ), value( rng ), value( rng ) ).getNormalized() );
+
+		crimild::Real32 weights[ 4 ];
+		crimild::Real32 total = 0.0f;
+		for ( crimild::Size k = 0; k < 4; k++ ) {
+			weights[ k ] = unit( rng );
+			total += weights[ k ];
+		}
+		for ( crimild::Size k = 0; k < 4; k++ ) {
+			input->setBoneIdAt( v, k, rng() % JOINT_COUNT );
+			input->setBoneWeightAt( v, k, weights[ k ] / total );
+		}
+	}
+
+	auto output = SkinningEngine::createOutputBuffer( crimild::get_ptr( input ) );
+
+	SkinningEngine engine;
+
+	for ( auto method : METHODS ) {
+		const std::string methodName = method == SkinningEngine::Method::LINEAR_BLEND ? "Linear blend" : "Dual quaternion";
+		engine.setMethod( method );
+
+		for ( auto kernel : KERNELS ) {
+			if ( kernel != SkinningEngine::Kernel::SCALAR && kernel > SkinningEngine::getDefaultKernel() ) {
+				// not supported by this build
+				continue;
+			}
+
+			engine.setKernel( kernel );
+
+			const auto label = methodName + " " + SkinningEngine::getKernelName( kernel );
+			auto rate = bm.measure( label, VERTEX_COUNT, [ & ] {
+				engine.skin( palette, crimild::get_ptr( input ), crimild::get_ptr( output ) );
+			});
+			bm.report( label, rate / 1000.0, "vertices/ms" );
+		}
+	}
+
+	engine.setMethod( SkinningEngine::Method::LINEAR_BLEND );
+	engine.setKernel( SkinningEngine::getDefaultKernel() );
+
+	for ( auto workerCount : WORKER_COUNTS ) {
+		concurrency::JobScheduler scheduler;
+		scheduler.configure( workerCount - 1 );
+		scheduler.start();
+
+		std::stringstream label;
+		label << "Linear blend " << SkinningEngine::getKernelName( engine.getKernel() ) << " (" << workerCount << " workers)";
+		bm.measure( label.str(), VERTEX_COUNT, [ & ] {
+			engine.skin( palette, crimild::get_ptr( input ), crimild::get_ptr( output ) );
+		});
+
+		scheduler.stop();
+	}
+}
@@ -0,0 +1,243 @@
+/*
+ * Copyright (c) 2013, Hernan Saez
+ * All rights reserved.
+ * 
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *     * Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in the
+ *       documentation and/or other materials provided with the distribution.
+ *     * Neither the name of the <organization> nor the
+ *       names of its contributors may be used to endorse or promote products
+ *       derived from this software without specific prior written permission.
+ * 
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL <COPYRIGHT HOLDER> BE LIABLE FOR ANY
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "Utils/Benchmark.hpp"
+
+#include "Crimild.hpp"
+
+#include <cstdio>
+#include <sstream>
+
+using namespace crimild;
+using namespace crimild::benchmark;
+
+namespace crimild {
+
+	namespace benchmark {
+
+		/**
+		   \brief Builds a scene with large vertex, index and image payloads
+		 */
+		static SharedPointer< Group > buildHeavyScene( crimild::Size geometryCount, crimild::Size vertexCount, crimild::Size indexCount, crimild::Size imageSize )
+		{
+			auto scene = crimild::alloc< Group >( "scene" );
+
+			const auto &format = VertexFormat::VF_P3_N3_UV2;
+
+			for ( crimild::Size i = 0; i < geometryCount; i++ ) {
+				auto vbo = crimild::alloc< VertexBufferObject >( format, vertexCount );
+				auto vertices = vbo->data();
+				for ( crimild::Size v = 0; v < vertexCount * format.getVertexSize(); v++ ) {
+					vertices[ v ] = static_cast< VertexPrecision >( ( v + i ) % 1024 ) / 1024.0f;
+				}
+
+				auto ibo = crimild::alloc< IndexBufferObject >( indexCount );
+				for ( crimild::Size idx = 0; idx < indexCount; idx++ ) {
+					ibo->setIndexAt( idx, ( idx * 7 + i ) % vertexCount );
+				}
+
+				auto primitive = crimild::alloc< Primitive >();
+				primitive->setVertexBuffer( vbo );
+				primitive->setIndexBuffer( ibo );
+
+				auto image = crimild::alloc< Image >( imageSize, imageSize, 4, nullptr );
+				auto pixels = image->getData();
+				for ( crimild::Size p = 0; p < imageSize * imageSize * 4; p++ ) {
+					pixels[ p ] = ( p + i ) & 0xFF;
+				}
+
+				auto material = crimild::alloc< Material >();
+				material->setColorMap( crimild::alloc< Texture >( image ) );
+
+				std::stringstream name;
+				name << "geometry " << i;
+				auto geometry = crimild::alloc< Geometry >( name.str() );
+				geometry->attachPrimitive( primitive );
+				geometry->getComponent< MaterialComponent >()->attachMaterial( material );
+				geometry->local().setTranslate( i, 0.0f, 0.0f );
+
+				scene->attachNode( geometry );
+			}
+
+			return scene;
+		}
+
+		static crimild::Size getFileSize( std::string path )
+		{
+			FILE *file = fopen( path.c_str(), "rb" );
+			if ( file == nullptr ) {
+				return 0;
+			}
+
+			fseek( file, 0, SEEK_END );
+			crimild::Size size = ftell( file );
+			fclose( file );
+			return size;
+		}
+
+		/**
+		   \brief Reads one byte per page from every vertex, index and image buffer
+
+		   Forces memory-mapped data to be loaded from disk
+		 */
+		static crimild::Size touchPayloads( Node *scene )
+		{
+			crimild::Size sum = 0;
+			auto touch = [ &sum ]( const void *data, crimild::Size size ) {
+				auto bytes = static_cast< const crimild::Byte * >( data );
+				for ( crimild::Size i = 0; i < size; i += 4096 ) {
+					sum += bytes[ i ];
+				}
+			};
+
+			scene->perform( Apply( [ &touch ]( Node *node ) {
+				auto geometry = dynamic_cast< Geometry * >( node );
+				if ( geometry == nullptr ) {
+					return;
+				}
+
+				geometry->forEachPrimitive( [ &touch ]( Primitive *primitive ) {
+					touch( primitive->getVertexBuffer()->getData(), primitive->getVertexBuffer()->getSizeInBytes() );
+					touch( primitive->getIndexBuffer()->getData(), primitive->getIndexBuffer()->getSizeInBytes() );
+				});
+
+				geometry->getComponent< MaterialComponent >()->forEachMaterial( [ &touch ]( Material *material ) {
+					auto image = material->getColorMap()->getImage();
+					touch( image->getData(), image->getWidth() * image->getHeight() * image->getBpp() );
+				});
+			}));
+
+			return sum;
+		}
+
+	}
+
+}
+
+CRIMILD_BENCHMARK( Coding, sceneLoading )
+{
+	crimild::init();
+
+	// ~200 MB of payload data
+	const crimild::Size GEOMETRY_COUNT = 126;
+	const crimild::Size VERTEX_COUNT = 40000;
+	const crimild::Size INDEX_COUNT = 60000;
+	const crimild::Size IMAGE_SIZE = 256;
+
+	const std::string TAGGED_FILE = "scene_loading_bench.crimild";
+	const std::string BINARY_FILE = "scene_loading_bench.crimildb";
+
+	{
+		auto scene = buildHeavyScene( GEOMETRY_COUNT, VERTEX_COUNT, INDEX_COUNT, IMAGE_SIZE );
+
+		{
+			auto encoder = crimild::alloc< coding::FileEncoder >();
+			encoder->encode( scene );
+			encoder->write( TAGGED_FILE );
+		}
+
+		{
+			auto encoder = crimild::alloc< coding::BinaryEncoder >();
+			encoder->encode( scene );
+			encoder->write( BINARY_FILE );
+		}
+	}
+
+	bm.report( "FileEncoder file size", getFileSize( TAGGED_FILE ) / ( 1024.0 * 1024.0 ), "MB" );
+	bm.report( "BinaryEncoder file size", getFileSize( BINARY_FILE ) / ( 1024.0 * 1024.0 ), "MB" );
+
+	// both files are in the page cache at this point, so these
+	// numbers do not include the actual disk reads
+
+	bm.measure( "FileDecoder", 1, [ & ] {
+		auto decoder = crimild::alloc< coding::FileDecoder >();
+		decoder->read( TAGGED_FILE );
+		touchPayloads( crimild::get_ptr( decoder->getObjectAt< Node >( 0 ) ) );
+	});
+
+	bm.measure( "BinaryDecoder (mmap)", 1, [ & ] {
+		auto decoder = crimild::alloc< coding::BinaryDecoder >();
+		decoder->read( BINARY_FILE );
+	});
+
+	bm.measure( "BinaryDecoder (mmap + touch payloads)", 1, [ & ] {
+		auto decoder = crimild::alloc< coding::BinaryDecoder >();
+		decoder->read( BINARY_FILE );
+		touchPayloads( crimild::get_ptr( decoder->getObjectAt< Node >( 0 ) ) );
+	});
+
+	remove( TAGGED_FILE.c_str() );
+	remove( BINARY_FILE.c_str() );
+}
+
+
+CRIMILD_BENCHMARK( Coding, parallelDecoding )
+{
+	crimild::init();
+
+	// lots of small objects, so decoding is dominated by per-object costs
+	const crimild::Size GEOMETRY_COUNT = 2000;
+	const crimild::Size VERTEX_COUNT = 500;
+	const crimild::Size INDEX_COUNT = 750;
+	const crimild::Size IMAGE_SIZE = 32;
+	const int WORKER_COUNTS[] = { 1, 4 };
+
+	const std::string TAGGED_FILE = "parallel_decoding_bench.crimild";
+
+	{
+		auto scene = buildHeavyScene( GEOMETRY_COUNT, VERTEX_COUNT, INDEX_COUNT, IMAGE_SIZE );
+		auto encoder = crimild::alloc< coding::FileEncoder >();
+		encoder->encode( scene );
+		encoder->write( TAGGED_FILE );
+	}
+
+	bm.report( "File size", getFileSize( TAGGED_FILE ) / ( 1024.0 * 1024.0 ), "MB" );
+
+	bm.measure( "FileDecoder (sequential)", GEOMETRY_COUNT, [ & ] {
+		auto decoder = crimild::alloc< coding::FileDecoder >();
+		decoder->read( TAGGED_FILE );
+	});
+
+	for ( auto workerCount : WORKER_COUNTS ) {
+		concurrency::JobScheduler scheduler;
+		scheduler.configure( workerCount - 1 );
+		scheduler.start();
+
+		std::stringstream label;
+		label << "FileDecoder (parallel, " << workerCount << " workers)";
+
+		bm.measure( label.str(), GEOMETRY_COUNT, [ & ] {
+			auto decoder = crimild::alloc< coding::FileDecoder >();
+			decoder->setParallelDecodingEnabled( true );
+			decoder->read( TAGGED_FILE );
+		});
+
+		scheduler.stop();
+	}
+
+	remove( TAGGED_FILE.c_str() );
+}
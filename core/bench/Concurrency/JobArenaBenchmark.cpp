@@ -0,0 +1,81 @@
+/*
+ * Copyright (c) 2013, Hernan Saez
+ * All rights reserved.
+ * 
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *     * Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in the
+ *       documentation and/or other materials provided with the distribution.
+ *     * Neither the name of the <organization> nor the
+ *       names of its contributors may be used to endorse or promote products
+ *       derived from this software without specific prior written permission.
+ * 
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL <COPYRIGHT HOLDER> BE LIABLE FOR ANY
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "Utils/Benchmark.hpp"
+
+#include "Concurrency/JobScheduler.hpp"
+#include "Concurrency/Async.hpp"
+
+#include <atomic>
+#include <sstream>
+
+using namespace crimild;
+using namespace crimild::concurrency;
+
+CRIMILD_BENCHMARK( JobArena, heapVsArena )
+{
+	const int JOB_COUNT = 100000;
+	const int WORKER_COUNTS[] = { 1, 2, 4, 8 };
+
+	for ( auto workerCount : WORKER_COUNTS ) {
+		JobScheduler scheduler;
+		scheduler.configure( workerCount - 1 );
+		scheduler.start();
+
+		std::atomic< int > count( 0 );
+
+		// capture enough data to force std::function to allocate memory,
+		// like RTRenderer does for every pixel
+		int a = 1, b = 2, c = 3, d = 4, e = 5, f = 6;
+
+		std::stringstream heapLabel;
+		heapLabel << "heap (JobPtr), " << workerCount << " workers";
+		bm.measure( heapLabel.str(), JOB_COUNT, [ & ] {
+			auto parent = crimild::concurrency::async();
+			for ( int i = 0; i < JOB_COUNT; i++ ) {
+				crimild::concurrency::async( parent, [ &count, a, b, c, d, e, f ] {
+					count += a + b + c + d + e + f;
+				});
+			}
+			crimild::concurrency::wait( parent );
+		});
+
+		std::stringstream arenaLabel;
+		arenaLabel << "arena (Job *), " << workerCount << " workers";
+		bm.measure( arenaLabel.str(), JOB_COUNT, [ & ] {
+			auto parent = crimild::concurrency::async_arena();
+			for ( int i = 0; i < JOB_COUNT; i++ ) {
+				crimild::concurrency::async_arena( parent, [ &count, a, b, c, d, e, f ] {
+					count += a + b + c + d + e + f;
+				});
+			}
+			crimild::concurrency::wait( parent );
+		});
+
+		scheduler.stop();
+	}
+}
@@ -0,0 +1,101 @@
+/*
+ * Copyright (c) 2013, Hernan Saez
+ * All rights reserved.
+ * 
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *     * Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in the
+ *       documentation and/or other materials provided with the distribution.
+ *     * Neither the name of the <organization> nor the
+ *       names of its contributors may be used to endorse or promote products
+ *       derived from this software without specific prior written permission.
+ * 
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL <COPYRIGHT HOLDER> BE LIABLE FOR ANY
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "Utils/Benchmark.hpp"
+#include "Utils/SceneBuilder.hpp"
+
+#include "Concurrency/JobScheduler.hpp"
+#include "Concurrency/ParallelFor.hpp"
+
+#include "SceneGraph/Node.hpp"
+
+#include "Visitors/Apply.hpp"
+#include "Visitors/ParallelApply.hpp"
+
+#include <sstream>
+#include <vector>
+
+using namespace crimild;
+using namespace crimild::concurrency;
+
+namespace crimild {
+
+	namespace benchmark {
+
+		void updateNode( Node *node )
+		{
+			node->world().computeFrom( node->getLocal(), node->getLocal() );
+		}
+
+	}
+
+}
+
+using namespace crimild::benchmark;
+
+CRIMILD_BENCHMARK( ParallelFor, sceneTraversal )
+{
+	const crimild::Size NODE_COUNTS[] = { 10000, 100000, 1000000 };
+	const int WORKER_COUNTS[] = { 1, 4 };
+
+	for ( auto nodeCount : NODE_COUNTS ) {
+		auto scene = buildScene( nodeCount );
+
+		for ( auto workerCount : WORKER_COUNTS ) {
+			JobScheduler scheduler;
+			scheduler.configure( workerCount - 1 );
+			scheduler.start();
+
+			std::stringstream suffix;
+			suffix << ", " << nodeCount << " nodes, " << workerCount << " workers";
+
+			bm.measure( "Apply (sequential)" + suffix.str(), nodeCount, [ & ] {
+				scene->perform( Apply( updateNode ) );
+			});
+
+			bm.measure( "ParallelApply" + suffix.str(), nodeCount, [ & ] {
+				scene->perform( ParallelApply( updateNode ) );
+			});
+
+			// flattening is usually done once and cached
+			std::vector< Node * > nodes;
+			scene->perform( Apply( [ &nodes ]( Node *node ) {
+				nodes.push_back( node );
+			}));
+
+			bm.measure( "parallel_for (flattened)" + suffix.str(), nodeCount, [ & ] {
+				parallel_for( Range( 0, nodes.size() ), 0, [ &nodes ]( Range const &r ) {
+					for ( auto i = r.begin; i < r.end; i++ ) {
+						updateNode( nodes[ i ] );
+					}
+				});
+			});
+
+			scheduler.stop();
+		}
+	}
+}
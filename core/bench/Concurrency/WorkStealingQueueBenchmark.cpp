@@ -0,0 +1,247 @@
+/*
+ * Copyright (c) 2013, Hernan Saez
+ * All rights reserved.
+ * 
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *     * Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in the
+ *       documentation and/or other materials provided with the distribution.
+ *     * Neither the name of the <organization> nor the
+ *       names of its contributors may be used to endorse or promote products
+ *       derived from this software without specific prior written permission.
+ * 
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL <COPYRIGHT HOLDER> BE LIABLE FOR ANY
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "Utils/Benchmark.hpp"
+
+#include "Concurrency/WorkStealingDeque.hpp"
+#include "Concurrency/JobScheduler.hpp"
+#include "Concurrency/Async.hpp"
+
+#include <atomic>
+#include <list>
+#include <mutex>
+#include <sstream>
+#include <thread>
+#include <vector>
+
+using namespace crimild;
+using namespace crimild::concurrency;
+
+namespace crimild {
+
+	namespace benchmark {
+
+		/**
+		   \brief The mutex-based queue previously used by JobScheduler, kept for comparison
+		 */
+		template< class T >
+		class LockedWorkStealingQueue {
+			using Mutex = std::mutex;
+			using Lock = std::lock_guard< Mutex >;
+
+		public:
+			bool empty( void )
+			{
+				Lock lock( _mutex );
+				return _elems.size() == 0;
+			}
+
+			void push( T const &elem )
+			{
+				Lock lock( _mutex );
+				_elems.push_back( elem );
+			}
+
+			T pop( void )
+			{
+				Lock lock( _mutex );
+				if ( _elems.size() == 0 ) {
+					return nullptr;
+				}
+				auto e = _elems.back();
+				_elems.pop_back();
+				return e;
+			}
+
+			T steal( void )
+			{
+				Lock lock( _mutex );
+				if ( _elems.size() == 0 ) {
+					return nullptr;
+				}
+				auto e = _elems.front();
+				_elems.pop_front();
+				return e;
+			}
+
+		private:
+			std::list< T > _elems;
+			Mutex _mutex;
+		};
+
+		struct BenchJob {
+			int value;
+		};
+
+		/**
+		   \brief Simulates a scheduler loop with the given queue type
+
+		   Every worker owns a queue and spawns a batch of jobs into it. Then, workers 
+		   consume jobs from their own queue and steal from the others until all jobs
+		   have been executed. 
+		 */
+		template< class QueueType >
+		void runWorkers( int workerCount, int jobsPerWorker )
+		{
+			std::vector< QueueType * > queues;
+			for ( int i = 0; i < workerCount; i++ ) {
+				queues.push_back( new QueueType() );
+			}
+
+			std::vector< BenchJob > jobs( workerCount * jobsPerWorker );
+			std::atomic< int > executed( 0 );
+			std::atomic< int > ready( 0 );
+			const int total = jobs.size();
+
+			auto worker = [ & ]( int idx ) {
+				ready++;
+				while ( ready < workerCount ) {
+					std::this_thread::yield();
+				}
+
+				auto queue = queues[ idx ];
+				for ( int i = 0; i < jobsPerWorker; i++ ) {
+					auto &job = jobs[ idx * jobsPerWorker + i ];
+					job.value = i;
+					queue->push( &job );
+				}
+
+				// count jobs locally to avoid measuring contention on the global counter
+				int localCount = 0;
+				unsigned victim = idx;
+				while ( true ) {
+					auto job = queue->pop();
+					if ( job == nullptr ) {
+						victim = ( victim + 1 ) % workerCount;
+						job = queues[ victim ]->steal();
+					}
+
+					if ( job != nullptr ) {
+						job->value++;
+						if ( ++localCount == 64 ) {
+							executed.fetch_add( localCount, std::memory_order_relaxed );
+							localCount = 0;
+						}
+					}
+					else {
+						executed.fetch_add( localCount, std::memory_order_relaxed );
+						localCount = 0;
+						if ( executed.load( std::memory_order_relaxed ) >= total ) {
+							break;
+						}
+						std::this_thread::yield();
+					}
+				}
+			};
+
+			std::vector< std::thread > threads;
+			for ( int i = 1; i < workerCount; i++ ) {
+				threads.push_back( std::thread( worker, i ) );
+			}
+			worker( 0 );
+			for ( auto &t : threads ) {
+				t.join();
+			}
+
+			for ( auto q : queues ) {
+				delete q;
+			}
+		}
+
+	}
+
+}
+
+using namespace crimild::benchmark;
+
+static const int WORKER_COUNTS[] = { 1, 2, 4, 8, 16, 32, 64 };
+
+CRIMILD_BENCHMARK( WorkStealingQueue, singleThreadPushPop )
+{
+	const int COUNT = 100000;
+	std::vector< BenchJob > jobs( COUNT );
+
+	LockedWorkStealingQueue< BenchJob * > locked;
+	bm.measure( "locked (std::list + std::mutex)", COUNT, [ & ] {
+		for ( auto &j : jobs ) locked.push( &j );
+		while ( locked.pop() != nullptr );
+	});
+
+	WorkStealingQueue< BenchJob * > lockFree;
+	bm.measure( "lock-free (Chase-Lev)", COUNT, [ & ] {
+		for ( auto &j : jobs ) lockFree.push( &j );
+		while ( lockFree.pop() != nullptr );
+	});
+}
+
+CRIMILD_BENCHMARK( WorkStealingQueue, workers )
+{
+	const int JOBS_PER_WORKER = 20000;
+
+	for ( auto workerCount : WORKER_COUNTS ) {
+		std::stringstream lockedLabel;
+		lockedLabel << "locked, " << workerCount << " workers";
+		bm.measure( lockedLabel.str(), workerCount * JOBS_PER_WORKER, [ & ] {
+			runWorkers< LockedWorkStealingQueue< BenchJob * >>( workerCount, JOBS_PER_WORKER );
+		});
+
+		std::stringstream lockFreeLabel;
+		lockFreeLabel << "lock-free, " << workerCount << " workers";
+		bm.measure( lockFreeLabel.str(), workerCount * JOBS_PER_WORKER, [ & ] {
+			runWorkers< WorkStealingQueue< BenchJob * >>( workerCount, JOBS_PER_WORKER );
+		});
+	}
+}
+
+CRIMILD_BENCHMARK( JobScheduler, asyncJobs )
+{
+	const int JOB_COUNT = 100000;
+
+	for ( auto workerCount : WORKER_COUNTS ) {
+		JobScheduler scheduler;
+
+		// the main thread counts as a worker
+		scheduler.configure( workerCount - 1 );
+		scheduler.start();
+
+		std::atomic< int > count( 0 );
+
+		std::stringstream label;
+		label << "async, " << workerCount << " workers";
+		bm.measure( label.str(), JOB_COUNT, [ & ] {
+			auto parent = crimild::concurrency::async();
+			for ( int i = 0; i < JOB_COUNT; i++ ) {
+				crimild::concurrency::async( parent, [ &count ] {
+					count++;
+				});
+			}
+			crimild::concurrency::wait( parent );
+		});
+
+		scheduler.stop();
+	}
+}
@@ -0,0 +1,223 @@
+/*
+ * Copyright (c) 2013, Hernan Saez
+ * All rights reserved.
+ * 
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *     * Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in the
+ *       documentation and/or other materials provided with the distribution.
+ *     * Neither the name of the <organization> nor the
+ *       names of its contributors may be used to endorse or promote products
+ *       derived from this software without specific prior written permission.
+ * 
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL <COPYRIGHT HOLDER> BE LIABLE FOR ANY
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "Utils/Benchmark.hpp"
+
+#include "Mathematics/Intersection.hpp"
+#include "Mathematics/RayPacket.hpp"
+
+#include <limits>
+#include <random>
+#include <string>
+#include <vector>
+
+using namespace crimild;
+using namespace crimild::benchmark;
+
+namespace crimild {
+
+	namespace benchmark {
+
+		/**
+		   \brief The random spheres scene used by the raytracer examples
+
+		   A huge sphere acting as the ground, a grid of small spheres and
+		   three big ones in the middle
+		 */
+		std::vector< Sphere3f > buildRandomSpheres( void )
+		{
+			std::mt19937 rng( 1234 );
+			std::uniform_real_distribution< crimild::Real32 > jitter( 0.0f, 0.9f );
+
+			std::vector< Sphere3f > spheres;
+			spheres.push_back( Sphere3f( Vector3f( 0.0f, -1000.0f, 0.0f ), 1000.0f ) );
+			for ( int a = -11; a < 11; a++ ) {
+				for ( int b = -11; b < 11; b++ ) {
+					spheres.push_back( Sphere3f( Vector3f( a + jitter( rng ), 0.2f, b + jitter( rng ) ), 0.2f ) );
+				}
+			}
+			spheres.push_back( Sphere3f( Vector3f( 0.0f, 1.0f, 0.0f ), 1.0f ) );
+			spheres.push_back( Sphere3f( Vector3f( -4.0f, 1.0f, 0.0f ), 1.0f ) );
+			spheres.push_back( Sphere3f( Vector3f( 4.0f, 1.0f, 0.0f ), 1.0f ) );
+			return spheres;
+		}
+
+		/**
+		   \brief Primary rays for a pinhole camera, in scanline order
+		 */
+		std::vector< Ray3f > buildPrimaryRays( crimild::Size width, crimild::Size height )
+		{
+			const Vector3f eye( 13.0f, 2.0f, 3.0f );
+			const auto forward = ( Vector3f( 0.0f, 0.0f, 0.0f ) - eye ).getNormalized();
+			const auto right = ( forward ^ Vector3f( 0.0f, 1.0f, 0.0f ) ).getNormalized();
+			const auto up = right ^ forward;
+			const auto halfHeight = std::tan( 0.5f * 20.0f * Numericf::DEG_TO_RAD );
+			const auto halfWidth = halfHeight * width / height;
+
+			std::vector< Ray3f > rays;
+			for ( crimild::Size y = 0; y < height; y++ ) {
+				for ( crimild::Size x = 0; x < width; x++ ) {
+					auto u = ( 2.0f * ( x + 0.5f ) / width - 1.0f ) * halfWidth;
+					auto v = ( 1.0f - 2.0f * ( y + 0.5f ) / height ) * halfHeight;
+					rays.push_back( Ray3f( eye, ( forward + u * right + v * up ).getNormalized() ) );
+				}
+			}
+			return rays;
+		}
+
+		template< crimild::Size N >
+		crimild::Size tracePackets( const std::vector< Sphere3f > &spheres, const std::vector< Ray3f > &rays, Intersection::Kernel kernel )
+		{
+			crimild::Size hits = 0;
+			for ( crimild::Size first = 0; first < rays.size(); first += N ) {
+				RayPacket< N > packet;
+				for ( crimild::Size i = 0; i < N && first + i < rays.size(); i++ ) {
+					packet.set( i, rays[ first + i ] );
+				}
+
+				crimild::Real32 t[ N ];
+				for ( auto &value : t ) {
+					value = std::numeric_limits< crimild::Real32 >::max();
+				}
+
+				crimild::UInt32 mask = 0;
+				for ( const auto &sphere : spheres ) {
+					mask |= Intersection::find( sphere, packet, t, Numericf::ZERO_TOLERANCE, kernel );
+				}
+
+				for ( crimild::Size i = 0; i < N; i++ ) {
+					hits += ( mask >> i ) & 1;
+				}
+			}
+			return hits;
+		}
+
+		template< crimild::Size N >
+		crimild::Size testPackets( const std::vector< Vector3f > &bounds, const std::vector< Ray3f > &rays, Intersection::Kernel kernel )
+		{
+			crimild::Real32 tMax[ N ];
+			for ( auto &value : tMax ) {
+				value = std::numeric_limits< crimild::Real32 >::max();
+			}
+
+			crimild::Size hits = 0;
+			for ( crimild::Size first = 0; first < rays.size(); first += N ) {
+				RayPacket< N > packet;
+				for ( crimild::Size i = 0; i < N && first + i < rays.size(); i++ ) {
+					packet.set( i, rays[ first + i ] );
+				}
+
+				for ( crimild::Size b = 0; b < bounds.size(); b += 2 ) {
+					auto mask = Intersection::test( bounds[ b ], bounds[ b + 1 ], packet, tMax, 0.0f, kernel );
+					for ( crimild::Size i = 0; i < N; i++ ) {
+						hits += ( mask >> i ) & 1;
+					}
+				}
+			}
+			return hits;
+		}
+
+	}
+
+}
+
+CRIMILD_BENCHMARK( Intersection, rayPackets )
+{
+	const crimild::Size WIDTH = 64;
+	const crimild::Size HEIGHT = 48;
+
+	auto spheres = buildRandomSpheres();
+	auto rays = buildPrimaryRays( WIDTH, HEIGHT );
+
+	std::vector< Vector3f > bounds;
+	for ( const auto &sphere : spheres ) {
+		auto extent = Vector3f( sphere.getRadius(), sphere.getRadius(), sphere.getRadius() );
+		bounds.push_back( sphere.getCenter() - extent );
+		bounds.push_back( sphere.getCenter() + extent );
+	}
+
+	bm.report( "Spheres", spheres.size(), "spheres" );
+
+	crimild::Size hits = 0;
+	bm.measure( "Spheres (Single ray)", rays.size(), [ & ] {
+		hits = 0;
+		for ( const auto &ray : rays ) {
+			auto nearest = std::numeric_limits< crimild::Real32 >::max();
+			for ( const auto &sphere : spheres ) {
+				auto t = Intersection::find( sphere, ray, Numericf::ZERO_TOLERANCE, nearest );
+				if ( t >= 0.0f ) {
+					nearest = t;
+				}
+			}
+			if ( nearest < std::numeric_limits< crimild::Real32 >::max() ) {
+				++hits;
+			}
+		}
+	});
+	bm.report( "Hits", hits, "rays" );
+
+	bm.measure( "Boxes (Single ray)", rays.size(), [ & ] {
+		hits = 0;
+		for ( const auto &ray : rays ) {
+			for ( crimild::Size b = 0; b < bounds.size(); b += 2 ) {
+				hits += Intersection::test( bounds[ b ], bounds[ b + 1 ], ray ) ? 1 : 0;
+			}
+		}
+	});
+
+	const Intersection::Kernel KERNELS[] = {
+		Intersection::Kernel::SCALAR,
+		Intersection::Kernel::SSE,
+		Intersection::Kernel::AVX,
+	};
+
+	for ( auto kernel : KERNELS ) {
+		if ( kernel != Intersection::Kernel::SCALAR && kernel > Intersection::getDefaultKernel() ) {
+			// not supported by this build
+			continue;
+		}
+
+		std::string name = Intersection::getKernelName( kernel );
+
+		bm.measure( "Spheres (4-wide, " + name + ")", rays.size(), [ & ] {
+			hits = tracePackets< 4 >( spheres, rays, kernel );
+		});
+
+		bm.measure( "Spheres (8-wide, " + name + ")", rays.size(), [ & ] {
+			hits = tracePackets< 8 >( spheres, rays, kernel );
+		});
+
+		bm.measure( "Boxes (4-wide, " + name + ")", rays.size(), [ & ] {
+			hits = testPackets< 4 >( bounds, rays, kernel );
+		});
+
+		bm.measure( "Boxes (8-wide, " + name + ")", rays.size(), [ & ] {
+			hits = testPackets< 8 >( bounds, rays, kernel );
+		});
+	}
+}
+
@@ -0,0 +1,186 @@
+/*
+ * Copyright (c) 2013, Hernan Saez
+ * All rights reserved.
+ * 
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *     * Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in the
+ *       documentation and/or other materials provided with the distribution.
+ *     * Neither the name of the <organization> nor the
+ *       names of its contributors may be used to endorse or promote products
+ *       derived from this software without specific prior written permission.
+ * 
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL <COPYRIGHT HOLDER> BE LIABLE FOR ANY
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "Utils/Benchmark.hpp"
+
+#include "ParticleSystem/ParticleData.hpp"
+#include "ParticleSystem/Renderers/PointSpriteParticleRenderer.hpp"
+#include "ParticleSystem/Renderers/OrientedQuadParticleRenderer.hpp"
+#include "Rendering/StreamingVertexBufferObject.hpp"
+#include "SceneGraph/Camera.hpp"
+#include "SceneGraph/Group.hpp"
+#include "Simulation/AssetManager.hpp"
+
+#include <random>
+#include <vector>
+
+using namespace crimild;
+using namespace crimild::benchmark;
+
+namespace crimild {
+
+	namespace benchmark {
+
+		/**
+		   \brief Replaces GPU buffer mapping with plain memory
+		 */
+		class StubStreamingMapper : public StreamingVertexBufferObject::Mapper {
+		public:
+			virtual VertexPrecision *map( StreamingVertexBufferObject *vbo, crimild::Size offset, crimild::Size size, crimild::Bool discard ) override
+			{
+				if ( _memory.size() * sizeof( VertexPrecision ) < vbo->getSizeInBytes() ) {
+					_memory.resize( vbo->getSizeInBytes() / sizeof( VertexPrecision ) );
+				}
+				return &_memory[ offset / sizeof( VertexPrecision ) ];
+			}
+
+			virtual void unmap( StreamingVertexBufferObject *vbo, crimild::Size offset, crimild::Size size ) override
+			{
+
+			}
+
+		private:
+			std::vector< VertexPrecision > _memory;
+		};
+
+		void setStubStreamingMapper( Group *node, StreamingVertexBufferObject::Mapper *mapper )
+		{
+			node->getNodeAt< Geometry >( 0 )->forEachPrimitive( [ mapper ]( Primitive *primitive ) {
+				if ( auto vbo = dynamic_cast< StreamingVertexBufferObject * >( primitive->getVertexBuffer() ) ) {
+					vbo->setMapper( mapper );
+				}
+			});
+		}
+
+	}
+
+}
+
+CRIMILD_BENCHMARK( ParticleSystem, renderers )
+{
+	// fits 16-bit indices, even for quads
+	const crimild::Size COUNT = 16000;
+
+	// renderers need a main camera and will look for default shaders
+	AssetManager assets;
+	auto camera = crimild::alloc< Camera >();
+	Camera::setMainCamera( camera );
+
+	ParticleData particles( COUNT );
+	particles.createAttribArray< Vector3f >( ParticleAttrib::POSITION );
+	particles.createAttribArray< RGBAColorf >( ParticleAttrib::COLOR );
+	particles.createAttribArray< crimild::Real32 >( ParticleAttrib::UNIFORM_SCALE );
+	particles.generate();
+
+	std::mt19937 rng( 1234 );
+	std::uniform_real_distribution< crimild::Real32 > value( -10.0f, 10.0f );
+	std::uniform_real_distribution< crimild::Real32 > unit( 0.0f, 1.0f );
+
+	auto ps = particles.getAttrib( ParticleAttrib::POSITION )->getData< Vector3f >();
+	auto cs = particles.getAttrib( ParticleAttrib::COLOR )->getData< RGBAColorf >();
+	auto ss = particles.getAttrib( ParticleAttrib::UNIFORM_SCALE )->getData< crimild::Real32 >();
+	for ( crimild::Size i = 0; i < COUNT; i++ ) {
+		particles.wake( i );
+		ps[ i ] = Vector3f( value( rng ), value( rng ), value( rng ) );
+		cs[ i ] = RGBAColorf( unit( rng ), unit( rng ), unit( rng ), 1.0f );
+		ss[ i ] = unit( rng );
+	}
+
+	StubStreamingMapper mapper;
+
+	// Generic path: new buffers are allocated and filled every frame
+	auto pointSpritesVBO = [ & ] {
+		auto vbo = crimild::alloc< VertexBufferObject >( VertexFormat::VF_P3_C4_UV2, COUNT );
+		for ( crimild::Size i = 0; i < COUNT; i++ ) {
+			vbo->setPositionAt( i, ps[ i ] );
+		}
+		for ( crimild::Size i = 0; i < COUNT; i++ ) {
+			vbo->setTextureCoordAt( i, Vector2f( ss[ i ], 0.0f ) );
+		}
+		for ( crimild::Size i = 0; i < COUNT; i++ ) {
+			vbo->setRGBAColorAt( i, cs[ i ] );
+		}
+		auto ibo = crimild::alloc< IndexBufferObject >( COUNT );
+		ibo->generateIncrementalIndices();
+	};
+
+	bm.measure( "Point sprites (VBO)", COUNT, pointSpritesVBO );
+	bm.measureAllocations( "Point sprites (VBO)", pointSpritesVBO );
+
+	auto pointSpritesNode = crimild::alloc< Group >();
+	PointSpriteParticleRenderer pointSprites;
+	pointSprites.configure( crimild::get_ptr( pointSpritesNode ), &particles );
+	setStubStreamingMapper( crimild::get_ptr( pointSpritesNode ), &mapper );
+
+	auto pointSpritesStreamed = [ & ] {
+		pointSprites.update( crimild::get_ptr( pointSpritesNode ), 0.0, &particles );
+	};
+
+	bm.measure( "Point sprites (streamed)", COUNT, pointSpritesStreamed );
+	bm.measureAllocations( "Point sprites (streamed)", pointSpritesStreamed );
+
+	auto orientedQuadsVBO = [ & ] {
+		auto vbo = crimild::alloc< VertexBufferObject >( VertexFormat::VF_P3_UV2, 4 * COUNT );
+		auto ibo = crimild::alloc< IndexBufferObject >( 6 * COUNT );
+		const auto up = camera->getWorld().computeUp();
+		const auto right = camera->getWorld().computeRight();
+		const Vector3f offsets[] = { up - right, -up - right, -up + right, up + right };
+		const Vector2f uvs[] = { Vector2f( 0.0f, 0.0f ), Vector2f( 0.0f, 1.0f ), Vector2f( 1.0f, 1.0f ), Vector2f( 1.0f, 0.0f ) };
+		for ( crimild::Size i = 0; i < COUNT; i++ ) {
+			for ( crimild::Size j = 0; j < 4; j++ ) {
+				vbo->setPositionAt( 4 * i + j, ps[ i ] + ss[ i ] * offsets[ j ] );
+				vbo->setTextureCoordAt( 4 * i + j, uvs[ j ] );
+			}
+		}
+		for ( crimild::Size i = 0; i < COUNT; i++ ) {
+			ibo->setIndexAt( 6 * i + 0, 4 * i + 0 );
+			ibo->setIndexAt( 6 * i + 1, 4 * i + 1 );
+			ibo->setIndexAt( 6 * i + 2, 4 * i + 2 );
+			ibo->setIndexAt( 6 * i + 3, 4 * i + 0 );
+			ibo->setIndexAt( 6 * i + 4, 4 * i + 2 );
+			ibo->setIndexAt( 6 * i + 5, 4 * i + 3 );
+		}
+	};
+
+	bm.measure( "Oriented quads (VBO)", COUNT, orientedQuadsVBO );
+	bm.measureAllocations( "Oriented quads (VBO)", orientedQuadsVBO );
+
+	auto orientedQuadsNode = crimild::alloc< Group >();
+	OrientedQuadParticleRenderer orientedQuads;
+	orientedQuads.configure( crimild::get_ptr( orientedQuadsNode ), &particles );
+	setStubStreamingMapper( crimild::get_ptr( orientedQuadsNode ), &mapper );
+
+	auto orientedQuadsStreamed = [ & ] {
+		orientedQuads.update( crimild::get_ptr( orientedQuadsNode ), 0.0, &particles );
+	};
+
+	bm.measure( "Oriented quads (streamed)", COUNT, orientedQuadsStreamed );
+	bm.measureAllocations( "Oriented quads (streamed)", orientedQuadsStreamed );
+
+	Camera::setMainCamera( nullptr );
+}
+
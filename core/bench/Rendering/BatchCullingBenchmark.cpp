@@ -0,0 +1,99 @@
+/*
+ * Copyright (c) 2013, Hernan Saez
+ * All rights reserved.
+ * 
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *     * Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in the
+ *       documentation and/or other materials provided with the distribution.
+ *     * Neither the name of the <organization> nor the
+ *       names of its contributors may be used to endorse or promote products
+ *       derived from this software without specific prior written permission.
+ * 
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL <COPYRIGHT HOLDER> BE LIABLE FOR ANY
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "Utils/Benchmark.hpp"
+
+#include "Boundings/BatchCulling.hpp"
+#include "Boundings/SphereBoundingVolume.hpp"
+#include "SceneGraph/Camera.hpp"
+#include "Visitors/UpdateWorldState.hpp"
+
+#include <random>
+#include <vector>
+
+using namespace crimild;
+using namespace crimild::benchmark;
+
+CRIMILD_BENCHMARK( Culling, batchCulling )
+{
+	const crimild::Size COUNT = 100000;
+
+	auto camera = crimild::alloc< Camera >( 60.0f, 16.0f / 9.0f, 0.1f, 400.0f );
+	camera->perform( UpdateWorldState() );
+	camera->computeCullingPlanes();
+
+	std::mt19937 rng( 1234 );
+	std::uniform_real_distribution< crimild::Real32 > position( -500.0f, 500.0f );
+
+	std::vector< SharedPointer< BoundingVolume >> volumes;
+	SphereBatch spheres;
+	BoxBatch boxes;
+	for ( crimild::Size i = 0; i < COUNT; i++ ) {
+		auto center = Vector3f( position( rng ), position( rng ), position( rng ) );
+		volumes.push_back( crimild::alloc< SphereBoundingVolume >( center, 1.0f ) );
+		spheres.push( center, 1.0f );
+		boxes.push( center - Vector3f( 1.0f, 1.0f, 1.0f ), center + Vector3f( 1.0f, 1.0f, 1.0f ) );
+	}
+
+	std::vector< crimild::UInt8 > visible( COUNT );
+
+	bm.measure( "Camera::culled", COUNT, [ & ] {
+		for ( crimild::Size i = 0; i < COUNT; i++ ) {
+			visible[ i ] = camera->culled( crimild::get_ptr( volumes[ i ] ) ) ? 0 : 1;
+		}
+	});
+
+	bm.measure( "SphereBatch::push", COUNT, [ & ] {
+		spheres.clear();
+		for ( auto &volume : volumes ) {
+			spheres.push( crimild::get_ptr( volume ) );
+		}
+	});
+
+	const BatchCulling::Kernel KERNELS[] = {
+		BatchCulling::Kernel::SCALAR,
+		BatchCulling::Kernel::SSE,
+		BatchCulling::Kernel::AVX,
+	};
+
+	for ( auto kernel : KERNELS ) {
+		if ( kernel != BatchCulling::Kernel::SCALAR && kernel > BatchCulling::getDefaultKernel() ) {
+			// not supported by this build
+			continue;
+		}
+
+		std::string name = BatchCulling::getKernelName( kernel );
+
+		bm.measure( "Spheres (" + name + ")", COUNT, [ & ] {
+			BatchCulling::cull( spheres, camera->getCullingPlanes(), Camera::CULLING_PLANE_COUNT, &visible[ 0 ], kernel );
+		});
+
+		bm.measure( "Boxes (" + name + ")", COUNT, [ & ] {
+			BatchCulling::cull( boxes, camera->getCullingPlanes(), Camera::CULLING_PLANE_COUNT, &visible[ 0 ], kernel );
+		});
+	}
+}
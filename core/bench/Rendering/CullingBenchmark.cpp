@@ -0,0 +1,169 @@
+/*
+ * Copyright (c) 2013, Hernan Saez
+ * All rights reserved.
+ * 
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *     * Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in the
+ *       documentation and/or other materials provided with the distribution.
+ *     * Neither the name of the <organization> nor the
+ *       names of its contributors may be used to endorse or promote products
+ *       derived from this software without specific prior written permission.
+ * 
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL <COPYRIGHT HOLDER> BE LIABLE FOR ANY
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "Utils/Benchmark.hpp"
+
+#include "SceneGraph/Camera.hpp"
+#include "SceneGraph/Geometry.hpp"
+#include "SceneGraph/Group.hpp"
+#include "SceneGraph/SpatialIndex.hpp"
+
+#include "Rendering/RenderQueue.hpp"
+
+#include "Visitors/ComputeRenderQueue.hpp"
+#include "Visitors/UpdateWorldState.hpp"
+
+#include <random>
+#include <vector>
+
+using namespace crimild;
+using namespace crimild::benchmark;
+
+namespace crimild {
+
+	namespace benchmark {
+
+		/**
+		   \brief Builds a scene with geometries spread in groups of 100
+
+		   If clustered is true, geometries in a group are close to each
+		   other (i.e. props in a room). Otherwise, they're scattered
+		   across the whole world, so groups' bounds are not useful
+		   for culling (i.e. a group for all trees in a level).
+		 */
+		SharedPointer< Group > buildCullingScene( crimild::Size geometryCount, bool clustered, std::vector< Geometry * > &geometries )
+		{
+			const crimild::Real32 WORLD_SIZE = 1000.0f;
+			const crimild::Real32 CLUSTER_SIZE = 20.0f;
+
+			std::mt19937 rng( 1234 );
+			std::uniform_real_distribution< crimild::Real32 > world( -0.5f * WORLD_SIZE, 0.5f * WORLD_SIZE );
+			std::uniform_real_distribution< crimild::Real32 > cluster( -0.5f * CLUSTER_SIZE, 0.5f * CLUSTER_SIZE );
+
+			auto scene = crimild::alloc< Group >();
+			Group *group = nullptr;
+			for ( crimild::Size i = 0; i < geometryCount; i++ ) {
+				if ( i % 100 == 0 ) {
+					auto g = crimild::alloc< Group >();
+					if ( clustered ) {
+						g->local().setTranslate( world( rng ), world( rng ), world( rng ) );
+					}
+					scene->attachNode( g );
+					group = crimild::get_ptr( g );
+				}
+
+				auto geometry = crimild::alloc< Geometry >();
+				if ( clustered ) {
+					geometry->local().setTranslate( cluster( rng ), cluster( rng ), cluster( rng ) );
+				}
+				else {
+					geometry->local().setTranslate( world( rng ), world( rng ), world( rng ) );
+				}
+				group->attachNode( geometry );
+				geometries.push_back( crimild::get_ptr( geometry ) );
+			}
+
+			scene->perform( UpdateWorldState() );
+
+			return scene;
+		}
+
+		std::vector< SharedPointer< Camera >> buildCullingCameras( void )
+		{
+			std::vector< SharedPointer< Camera >> cameras;
+			for ( int i = 0; i < 4; i++ ) {
+				auto camera = crimild::alloc< Camera >( 60.0f, 16.0f / 9.0f, 0.1f, 400.0f );
+				camera->local().rotate().fromAxisAngle( Vector3f( 0.0f, 1.0f, 0.0f ), i * Numericf::HALF_PI );
+				camera->perform( UpdateWorldState() );
+				cameras.push_back( camera );
+			}
+			return cameras;
+		}
+
+	}
+
+}
+
+CRIMILD_BENCHMARK( Culling, computeRenderQueue )
+{
+	const crimild::Size GEOMETRY_COUNT = 100000;
+
+	auto cameras = buildCullingCameras();
+	RenderQueue renderQueue;
+
+	for ( auto clustered : { true, false } ) {
+		std::vector< Geometry * > geometries;
+		auto scene = buildCullingScene( GEOMETRY_COUNT, clustered, geometries );
+
+		auto suffix = std::string( clustered ? ", clustered" : ", scattered" );
+		auto camerasSuffix = suffix + ", 4 cameras";
+
+		crimild::Size visitedNodeCount = 0;
+		bm.measure( "Traversal" + camerasSuffix, GEOMETRY_COUNT * cameras.size(), [ & ] {
+			visitedNodeCount = 0;
+			for ( auto &camera : cameras ) {
+				ComputeRenderQueue computeRenderQueue( crimild::get_ptr( camera ), &renderQueue );
+				scene->perform( computeRenderQueue );
+				visitedNodeCount += computeRenderQueue.getVisitedNodeCount();
+			}
+		});
+		bm.report( "Traversal" + camerasSuffix, visitedNodeCount, "visited nodes" );
+
+		SpatialIndex index;
+		bm.measure( "SpatialIndex build" + suffix, GEOMETRY_COUNT, [ & ] {
+			index.clear();
+			index.update( crimild::get_ptr( scene ) );
+		});
+
+		bm.measure( "SpatialIndex" + camerasSuffix, GEOMETRY_COUNT * cameras.size(), [ & ] {
+			visitedNodeCount = 0;
+			for ( auto &camera : cameras ) {
+				ComputeRenderQueue computeRenderQueue( crimild::get_ptr( camera ), &renderQueue, &index );
+				scene->perform( computeRenderQueue );
+				visitedNodeCount += computeRenderQueue.getVisitedNodeCount();
+			}
+		});
+		bm.report( "SpatialIndex" + camerasSuffix, visitedNodeCount, "visible geometries" );
+
+		bm.measure( "SpatialIndex update (static)" + suffix, GEOMETRY_COUNT, [ & ] {
+			index.update( crimild::get_ptr( scene ) );
+		});
+
+		// 1% of the geometries are animated every frame
+		crimild::Size frame = 0;
+		bm.measure( "UpdateWorldState + SpatialIndex update (1% moving)" + suffix, GEOMETRY_COUNT, [ & ] {
+			// move back and forth, so geometries stay around the same place
+			auto offset = ( ( frame / 100 ) % 2 == 0 ? 1.0f : -1.0f );
+			auto first = frame++ % 100;
+			for ( crimild::Size i = first; i < geometries.size(); i += 100 ) {
+				geometries[ i ]->local().translate() += Vector3f( offset, 0.0f, 0.0f );
+			}
+			scene->perform( UpdateWorldState() );
+			index.update( crimild::get_ptr( scene ) );
+		});
+	}
+}
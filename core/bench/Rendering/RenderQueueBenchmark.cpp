@@ -0,0 +1,250 @@
+/*
+ * Copyright (c) 2013, Hernan Saez
+ * All rights reserved.
+ * 
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *     * Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in the
+ *       documentation and/or other materials provided with the distribution.
+ *     * Neither the name of the <organization> nor the
+ *       names of its contributors may be used to endorse or promote products
+ *       derived from this software without specific prior written permission.
+ * 
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL <COPYRIGHT HOLDER> BE LIABLE FOR ANY
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "Utils/Benchmark.hpp"
+
+#include "Components/RenderStateComponent.hpp"
+#include "Concurrency/JobScheduler.hpp"
+#include "Concurrency/TaskGraph.hpp"
+#include "Rendering/AlphaState.hpp"
+#include "Rendering/Material.hpp"
+#include "Rendering/RenderQueue.hpp"
+#include "Rendering/ShaderProgram.hpp"
+#include "Rendering/Texture.hpp"
+#include "SceneGraph/Camera.hpp"
+#include "SceneGraph/Geometry.hpp"
+#include "SceneGraph/Group.hpp"
+#include "Visitors/ComputeRenderQueue.hpp"
+#include "Visitors/UpdateWorldState.hpp"
+
+#include <limits>
+#include <random>
+#include <sstream>
+#include <vector>
+
+using namespace crimild;
+using namespace crimild::benchmark;
+using namespace crimild::concurrency;
+
+namespace crimild {
+
+	namespace benchmark {
+
+		/**
+		   \brief Builds a scene with geometries sharing a few programs, materials and textures
+
+		   One out of ten materials is translucent
+		 */
+		SharedPointer< Group > buildRenderQueueScene( crimild::Size geometryCount )
+		{
+			const crimild::Size PROGRAM_COUNT = 8;
+			const crimild::Size TEXTURE_COUNT = 16;
+			const crimild::Size MATERIAL_COUNT = 64;
+
+			std::vector< SharedPointer< ShaderProgram >> programs;
+			for ( crimild::Size i = 0; i < PROGRAM_COUNT; i++ ) {
+				programs.push_back( crimild::alloc< ShaderProgram >() );
+			}
+
+			std::vector< SharedPointer< Texture >> textures;
+			for ( crimild::Size i = 0; i < TEXTURE_COUNT; i++ ) {
+				textures.push_back( crimild::alloc< Texture >() );
+			}
+
+			std::vector< SharedPointer< Material >> materials;
+			for ( crimild::Size i = 0; i < MATERIAL_COUNT; i++ ) {
+				auto material = crimild::alloc< Material >();
+				material->setProgram( programs[ ( i * 7 ) % PROGRAM_COUNT ] );
+				material->setColorMap( textures[ ( i * 5 ) % TEXTURE_COUNT ] );
+				if ( i % 10 == 0 ) {
+					material->setAlphaState( AlphaState::ENABLED );
+				}
+				materials.push_back( material );
+			}
+
+			std::mt19937 rng( 1234 );
+			std::uniform_real_distribution< crimild::Real32 > position( -50.0f, 50.0f );
+			std::uniform_real_distribution< crimild::Real32 > depth( -200.0f, -10.0f );
+
+			auto scene = crimild::alloc< Group >();
+			Group *group = nullptr;
+			for ( crimild::Size i = 0; i < geometryCount; i++ ) {
+				if ( i % 100 == 0 ) {
+					auto g = crimild::alloc< Group >();
+					scene->attachNode( g );
+					group = crimild::get_ptr( g );
+				}
+
+				auto geometry = crimild::alloc< Geometry >();
+				geometry->local().setTranslate( position( rng ), position( rng ), depth( rng ) );
+				auto rs = geometry->attachComponent< RenderStateComponent >();
+				rs->attachMaterial( materials[ rng() % MATERIAL_COUNT ] );
+				group->attachNode( geometry );
+			}
+
+			scene->perform( UpdateWorldState() );
+
+			return scene;
+		}
+
+		/**
+		   \brief Counts how many times programs, materials and textures change
+		   while walking renderables in order
+		 */
+		void countStateChanges( RenderQueue *renderQueue, RenderQueue::RenderableType type, crimild::Size &programChanges, crimild::Size &materialChanges, crimild::Size &textureChanges )
+		{
+			ShaderProgram *program = nullptr;
+			Material *material = nullptr;
+			Texture *texture = nullptr;
+
+			renderQueue->each( renderQueue->getRenderables( type ), [ & ]( RenderQueue::Renderable *renderable ) {
+				auto m = crimild::get_ptr( renderable->material );
+				if ( m->getProgram() != program ) {
+					program = m->getProgram();
+					++programChanges;
+				}
+				if ( m != material ) {
+					material = m;
+					++materialChanges;
+				}
+				if ( m->getColorMap() != texture ) {
+					texture = m->getColorMap();
+					++textureChanges;
+				}
+			});
+		}
+
+	}
+
+}
+
+CRIMILD_BENCHMARK( Rendering, renderQueue )
+{
+	const crimild::Size GEOMETRY_COUNTS[] = { 1000, 10000 };
+
+	auto camera = crimild::alloc< Camera >( 90.0f, 1.0f, 1.0f, 1000.0f );
+	camera->perform( UpdateWorldState() );
+
+	for ( auto geometryCount : GEOMETRY_COUNTS ) {
+		auto scene = buildRenderQueueScene( geometryCount );
+
+		std::stringstream suffix;
+		suffix << ", " << geometryCount << " geometries";
+
+		// what UpdateSystem used to do every frame
+		auto freshQueue = [ & ] {
+			auto renderQueue = crimild::alloc< RenderQueue >();
+			ComputeRenderQueue computeRenderQueue( crimild::get_ptr( camera ), crimild::get_ptr( renderQueue ) );
+			scene->perform( computeRenderQueue );
+		};
+
+		// queues and visitors are kept between frames
+		auto renderQueue = crimild::alloc< RenderQueue >();
+		ComputeRenderQueue computeRenderQueue( crimild::get_ptr( camera ), crimild::get_ptr( renderQueue ) );
+		auto persistentQueue = [ & ] {
+			scene->perform( computeRenderQueue );
+		};
+
+		bm.measure( "Fresh queue" + suffix.str(), geometryCount, freshQueue );
+		bm.measureAllocations( "Fresh queue" + suffix.str(), freshQueue );
+
+		bm.measure( "Persistent queue" + suffix.str(), geometryCount, persistentQueue );
+		bm.measureAllocations( "Persistent queue" + suffix.str(), persistentQueue );
+
+		crimild::Size programChanges = 0;
+		crimild::Size materialChanges = 0;
+		crimild::Size textureChanges = 0;
+		countStateChanges( crimild::get_ptr( renderQueue ), RenderQueue::RenderableType::OPAQUE, programChanges, materialChanges, textureChanges );
+		bm.report( "Opaque program changes" + suffix.str(), programChanges, "" );
+		bm.report( "Opaque material changes" + suffix.str(), materialChanges, "" );
+		bm.report( "Opaque texture changes" + suffix.str(), textureChanges, "" );
+	}
+}
+
+CRIMILD_BENCHMARK( Rendering, parallelRenderQueues )
+{
+	const crimild::Size GEOMETRY_COUNT = 100000;
+	const crimild::Size CAMERA_COUNT = 8;
+	const int WORKER_COUNTS[] = { 1, 4 };
+
+	auto scene = buildRenderQueueScene( GEOMETRY_COUNT );
+
+	// i.e. main camera, shadow cameras and offscreen cameras
+	std::vector< SharedPointer< Camera >> cameras;
+	for ( crimild::Size i = 0; i < CAMERA_COUNT; i++ ) {
+		auto camera = crimild::alloc< Camera >( 90.0f, 1.0f, 1.0f, 1000.0f );
+		camera->local().rotate().fromAxisAngle( Vector3f( 0.0f, 1.0f, 0.0f ), 0.2f * i );
+		camera->perform( UpdateWorldState() );
+		cameras.push_back( camera );
+	}
+
+	for ( auto workerCount : WORKER_COUNTS ) {
+		JobScheduler scheduler;
+		scheduler.configure( workerCount - 1 );
+		scheduler.start();
+
+		std::stringstream suffix;
+		suffix << ", " << GEOMETRY_COUNT << " geometries, " << workerCount << " workers";
+
+		for ( auto split : { false, true } ) {
+			std::vector< SharedPointer< RenderQueue >> renderQueues;
+			std::vector< UniquePointer< ComputeRenderQueue >> visitors;
+			for ( auto &camera : cameras ) {
+				auto renderQueue = crimild::alloc< RenderQueue >();
+				visitors.push_back( crimild::alloc_unique< ComputeRenderQueue >( crimild::get_ptr( camera ), crimild::get_ptr( renderQueue ) ) );
+				visitors.back()->setParallelThreshold( split ? 0 : std::numeric_limits< crimild::Size >::max() );
+				renderQueues.push_back( renderQueue );
+			}
+
+			std::string mode = split ? " (subtree jobs)" : "";
+
+			bm.measure( "1 camera" + mode + suffix.str(), GEOMETRY_COUNT, [ & ] {
+				scene->perform( *visitors[ 0 ] );
+			});
+
+			bm.measure( "8 cameras, sequential" + mode + suffix.str(), GEOMETRY_COUNT * CAMERA_COUNT, [ & ] {
+				for ( auto &visitor : visitors ) {
+					scene->perform( *visitor );
+				}
+			});
+
+			TaskGraph frame;
+			for ( auto &visitor : visitors ) {
+				auto v = visitor.get();
+				frame.addTask( "Compute Render Queue", [ v, &scene ] {
+					scene->perform( *v );
+				});
+			}
+
+			bm.measure( "8 cameras, parallel" + mode + suffix.str(), GEOMETRY_COUNT * CAMERA_COUNT, [ & ] {
+				frame.execute();
+			});
+		}
+
+		scheduler.stop();
+	}
+}
@@ -0,0 +1,91 @@
+/*
+ * Copyright (c) 2013, Hernan Saez
+ * All rights reserved.
+ * 
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *     * Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in the
+ *       documentation and/or other materials provided with the distribution.
+ *     * Neither the name of the <organization> nor the
+ *       names of its contributors may be used to endorse or promote products
+ *       derived from this software without specific prior written permission.
+ * 
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL <COPYRIGHT HOLDER> BE LIABLE FOR ANY
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "Utils/Benchmark.hpp"
+#include "Utils/SceneBuilder.hpp"
+
+#include "Concurrency/JobScheduler.hpp"
+
+#include "SceneGraph/TransformHierarchy.hpp"
+
+#include "Visitors/Apply.hpp"
+#include "Visitors/UpdateWorldState.hpp"
+
+#include <sstream>
+#include <vector>
+
+using namespace crimild;
+using namespace crimild::benchmark;
+using namespace crimild::concurrency;
+
+CRIMILD_BENCHMARK( TransformHierarchy, updateWorldState )
+{
+	const crimild::Size NODE_COUNTS[] = { 10000, 100000 };
+
+	JobScheduler scheduler;
+	scheduler.configure( 3 );
+	scheduler.start();
+
+	for ( auto nodeCount : NODE_COUNTS ) {
+		auto scene = buildScene( nodeCount );
+
+		std::vector< Node * > nodes;
+		scene->perform( Apply( [ &nodes ]( Node *node ) {
+			nodes.push_back( node );
+		}));
+
+		std::stringstream suffix;
+		suffix << ", " << nodeCount << " nodes";
+
+		bm.measure( "UpdateWorldState (full)" + suffix.str(), nodeCount, [ & ] {
+			scene->perform( UpdateWorldState() );
+		});
+
+		auto hierarchy = crimild::alloc< TransformHierarchy >();
+		hierarchy->update( crimild::get_ptr( scene ) );
+
+		bm.measure( "TransformHierarchy (all dirty)" + suffix.str(), nodeCount, [ & ] {
+			scene->local().setTranslate( 0.0f, 1.0f, 0.0f );
+			hierarchy->update( crimild::get_ptr( scene ) );
+		});
+
+		// 1% of the nodes are animated every frame
+		crimild::Size frame = 0;
+		bm.measure( "TransformHierarchy (1% dirty)" + suffix.str(), nodeCount, [ & ] {
+			for ( crimild::Size i = frame++ % 100; i < nodes.size(); i += 100 ) {
+				nodes[ i ]->local().setTranslate( 1.0f, 0.0f, 0.0f );
+			}
+			hierarchy->update( crimild::get_ptr( scene ) );
+		});
+
+		bm.measure( "TransformHierarchy (static)" + suffix.str(), nodeCount, [ & ] {
+			hierarchy->update( crimild::get_ptr( scene ) );
+		});
+	}
+
+	scheduler.stop();
+}
@@ -0,0 +1,188 @@
+/*
+ * Copyright (c) 2013, Hernan Saez
+ * All rights reserved.
+ * 
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *     * Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in the
+ *       documentation and/or other materials provided with the distribution.
+ *     * Neither the name of the <organization> nor the
+ *       names of its contributors may be used to endorse or promote products
+ *       derived from this software without specific prior written permission.
+ * 
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL <COPYRIGHT HOLDER> BE LIABLE FOR ANY
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef CRIMILD_BENCHMARK_UTILS_BENCHMARK_
+#define CRIMILD_BENCHMARK_UTILS_BENCHMARK_
+
+#include "Foundation/Types.hpp"
+
+#include <chrono>
+#include <functional>
+#include <iomanip>
+#include <iostream>
+#include <string>
+#include <vector>
+
+namespace crimild {
+
+	namespace benchmark {
+
+		/**
+		   \brief Number of heap allocations performed so far by the current process
+
+		   Implemented by the benchmark runner by replacing the global operator new
+		 */
+		crimild::Size getAllocationCount( void );
+
+		/**
+		   \brief A minimal benchmark runner
+
+		   Benchmarks are registered with the CRIMILD_BENCHMARK macro and
+		   executed by the runner in the order they were registered. Each
+		   benchmark measures one or more labeled workloads and reports 
+		   their throughput in items per second.
+		 */
+		class Benchmark {
+		public:
+			using Callback = std::function< void( Benchmark & ) >;
+
+			Benchmark( std::string group, std::string name, Callback const &callback )
+				: _group( group ),
+				  _name( name ),
+				  _callback( callback )
+			{
+
+			}
+
+			std::string getFullName( void ) const { return _group + "." + _name; }
+
+			void run( void )
+			{
+				std::cout << "[ RUN      ] " << getFullName() << std::endl;
+				_callback( *this );
+			}
+
+			/**
+			   \brief Runs a workload repeatedly and reports its throughput
+
+			   The workload is executed until at least getMinTime() seconds 
+			   have elapsed, after a single warm up run.
+
+			   \param itemsPerRun Number of items processed by each invocation
+			   of the workload (i.e. jobs, nodes, particles, rays...)
+			 */
+			crimild::Real64 measure( std::string label, crimild::Size itemsPerRun, std::function< void( void ) > const &fn )
+			{
+				using Clock = std::chrono::high_resolution_clock;
+
+				// warm up
+				fn();
+
+				crimild::Size runs = 0;
+				crimild::Real64 elapsed = 0;
+				auto start = Clock::now();
+				do {
+					fn();
+					++runs;
+					elapsed = std::chrono::duration< crimild::Real64 >( Clock::now() - start ).count();
+				} while ( elapsed < getMinTime() );
+
+				auto itemsPerSecond = ( runs * itemsPerRun ) / elapsed;
+				report( label, itemsPerSecond, "items/s" );
+				report( label, 1000.0 * elapsed / runs, "ms/run" );
+				return itemsPerSecond;
+			}
+
+			/**
+			   \brief Runs a workload once (after a warm up run) and reports how many
+			   heap allocations it performed
+			 */
+			crimild::Size measureAllocations( std::string label, std::function< void( void ) > const &fn )
+			{
+				// warm up
+				fn();
+
+				auto before = getAllocationCount();
+				fn();
+				auto count = getAllocationCount() - before;
+
+				report( label, count, "allocations/run" );
+				return count;
+			}
+
+			/**
+			   \brief Reports an arbitrary value (i.e. memory usage)
+			 */
+			void report( std::string label, crimild::Real64 value, std::string units )
+			{
+				std::cout << "             "
+						  << std::left << std::setw( 48 ) << label
+						  << std::right << std::setw( 18 ) << std::fixed << std::setprecision( 3 ) << value
+						  << " " << units
+						  << std::endl;
+			}
+
+		public:
+			static crimild::Real64 &getMinTime( void )
+			{
+				static crimild::Real64 minTime = 0.5;
+				return minTime;
+			}
+
+			static std::vector< Benchmark > &getRegistry( void )
+			{
+				static std::vector< Benchmark > registry;
+				return registry;
+			}
+
+			static int add( std::string group, std::string name, Callback const &callback )
+			{
+				getRegistry().push_back( Benchmark( group, name, callback ) );
+				return getRegistry().size();
+			}
+
+			/**
+			   \brief Executes all benchmarks whose names contain the filter string
+			 */
+			static int runAll( std::string filter )
+			{
+				int count = 0;
+				for ( auto &b : getRegistry() ) {
+					if ( filter == "" || b.getFullName().find( filter ) != std::string::npos ) {
+						b.run();
+						++count;
+					}
+				}
+				return count;
+			}
+
+		private:
+			std::string _group;
+			std::string _name;
+			Callback _callback;
+		};
+
+	}
+
+}
+
+#define CRIMILD_BENCHMARK( GROUP, NAME ) \
+	static void crimild_benchmark_##GROUP##_##NAME( crimild::benchmark::Benchmark & ); \
+	static int crimild_benchmark_##GROUP##_##NAME##_registered = crimild::benchmark::Benchmark::add( #GROUP, #NAME, crimild_benchmark_##GROUP##_##NAME ); \
+	static void crimild_benchmark_##GROUP##_##NAME( crimild::benchmark::Benchmark &bm )
+
+#endif
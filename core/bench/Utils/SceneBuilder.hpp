@@ -0,0 +1,69 @@
+/*
+ * Copyright (c) 2013, Hernan Saez
+ * All rights reserved.
+ * 
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *     * Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in the
+ *       documentation and/or other materials provided with the distribution.
+ *     * Neither the name of the <organization> nor the
+ *       names of its contributors may be used to endorse or promote products
+ *       derived from this software without specific prior written permission.
+ * 
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL <COPYRIGHT HOLDER> BE LIABLE FOR ANY
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef CRIMILD_BENCHMARK_UTILS_SCENE_BUILDER_
+#define CRIMILD_BENCHMARK_UTILS_SCENE_BUILDER_
+
+#include "SceneGraph/Group.hpp"
+
+#include <vector>
+
+namespace crimild {
+
+	namespace benchmark {
+
+		/**
+		   \brief Builds a scene with the given number of nodes
+
+		   Every group has up to fanout children, like a typical scene hierarchy
+		 */
+		inline SharedPointer< Group > buildScene( crimild::Size nodeCount, crimild::Size fanout = 10 )
+		{
+			auto scene = crimild::alloc< Group >();
+			std::vector< Group * > parents = { crimild::get_ptr( scene ) };
+			crimild::Size count = 1;
+			crimild::Size parentIdx = 0;
+
+			while ( count < nodeCount ) {
+				auto parent = parents[ parentIdx++ ];
+				for ( crimild::Size i = 0; i < fanout && count < nodeCount; i++ ) {
+					auto group = crimild::alloc< Group >();
+					group->local().setTranslate( 1.0f, 0.0f, 0.0f );
+					parent->attachNode( group );
+					parents.push_back( crimild::get_ptr( group ) );
+					++count;
+				}
+			}
+
+			return scene;
+		}
+
+	}
+
+}
+
+#endif
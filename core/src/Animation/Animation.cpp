@@ -103,6 +103,19 @@ void Animation::evaluate( void )
 	getClip()->evaluate( animationTime, this );
 }
 
+crimild::Size &Animation::getChannelCursor( crimild::Size channelIndex )
+{
+	if ( channelIndex >= _channelCursors.size() ) {
+		auto count = _channelCursors.size();
+		_channelCursors.resize( channelIndex + 1 );
+		for ( auto i = count; i <= channelIndex; i++ ) {
+			_channelCursors[ i ] = 0;
+		}
+	}
+
+	return _channelCursors[ channelIndex ];
+}
+
 Animation *Animation::lerp( SharedPointer< Animation > const &other, crimild::Real32 factor, crimild::Bool sync )
 {
 	return lerp( crimild::get_ptr( other ), factor, sync );
@@ -102,6 +102,18 @@ namespace crimild {
 		private:
 			void evaluate( void );
 
+		public:
+			/**
+			   \brief Last keyframe index used by the clip's channel at channelIndex
+
+			   Clips are shared, so keyframe cursors are kept by each animation
+			   instead of by the channels themselves. 
+			 */
+			crimild::Size &getChannelCursor( crimild::Size channelIndex );
+
+		private:
+			containers::Array< crimild::Size > _channelCursors;
+
 		public:
 			template< typename T >
 			Animation *setValue( const std::string &channelName, const T &value )
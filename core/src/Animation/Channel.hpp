@@ -37,6 +37,7 @@ namespace crimild {
 	namespace animation {
 
 		class Animation;
+		class Pose;
 
 		class Channel :
 			public coding::Codable,
@@ -50,7 +51,41 @@ namespace crimild {
 
 			virtual crimild::Real32 getDuration( void ) const = 0;
 
-			virtual void evaluate( crimild::Real32 t, Animation *animation ) = 0;
+			/**
+			   \brief Evaluates the channel without a cached keyframe cursor
+			 */
+			void evaluate( crimild::Real32 t, Animation *animation )
+			{
+				crimild::Size cursor = 0;
+				evaluate( t, animation, cursor );
+			}
+
+			/**
+			   \brief Evaluates the channel at time t
+
+			   Channels are shared by all animations playing the same clip, so the
+			   index of the last keyframe used is kept by the caller in the cursor
+			   parameter (see Animation::getChannelCursor())
+			 */
+			virtual void evaluate( crimild::Real32 t, Animation *animation, crimild::Size &cursor ) = 0;
+
+			/**
+			   \brief Evaluates the channel at time t, storing the result for the given joint
+
+			   The type of the channel's keys determines which component of the 
+			   joint's transformation is set. Does nothing by default.
+			   
+			   \see ClipBinding
+			 */
+			virtual void evaluate( crimild::Real32 t, Pose &pose, crimild::Size joint, crimild::Size &cursor ) { }
+
+			/**
+			   \brief Resamples keyframes at a fixed rate (in samples per time unit)
+
+			   Uniformly sampled channels compute keyframe indices in constant time.
+			   Usually invoked once when importing clips. Does nothing by default.
+			 */
+			virtual void resample( crimild::Real32 sampleRate ) { }
 		};
 
 	}
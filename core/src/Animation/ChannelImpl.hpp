@@ -30,6 +30,8 @@
 
 #include "Channel.hpp"
 #include "Animation.hpp"
+#include "KeyframeCursor.hpp"
+#include "Pose.hpp"
 
 #include "Coding/Encoder.hpp"
 #include "Coding/Decoder.hpp"
@@ -40,7 +42,7 @@ namespace crimild {
 
 		template< typename T >
 		class ChannelImpl : public Channel {
-		private:
+		public:
 			using TimeArray = containers::Array< crimild::Real32 >;
 			using KeyArray = containers::Array< T >;
 			
@@ -77,49 +79,130 @@ namespace crimild {
 				return _times.last();
 			}
 
-			virtual void evaluate( crimild::Real32 t, Animation *animation ) override
+			const TimeArray &getTimes( void ) const { return _times; }
+			const KeyArray &getKeys( void ) const { return _keys; }
+
+			using Channel::evaluate;
+
+			virtual void evaluate( crimild::Real32 t, Animation *animation, crimild::Size &cursor ) override
 			{
 				if ( _keys.size() == 0 || _times.size() == 0 ) {
 					return;
 				}
 				
 				T result;
+				sample( t, cursor, result );
+				animation->setValue( getName(), result );
+			}
+
+			virtual void evaluate( crimild::Real32 t, Pose &pose, crimild::Size joint, crimild::Size &cursor ) override
+			{
+				if ( _keys.size() == 0 || _times.size() == 0 ) {
+					return;
+				}
+
+				T result;
+				sample( t, cursor, result );
+				pose.set( joint, result );
+			}
+
+			/**
+			   \brief Computes the value of the channel at time t
+			 */
+			void sample( crimild::Real32 t, crimild::Size &cursor, T &result ) const
+			{
+				const auto count = _times.size();
+				const auto times = _times.getData();
+				const auto keys = _keys.getData();
 
-				if ( _keys.size() == 1 || t <= _times.first() ) {
-					result = _keys.first();
+				if ( count == 1 || t <= times[ 0 ] ) {
+					result = keys[ 0 ];
+					return;
 				}
-				else if ( t >= _times.last() ) {
-					result = _keys.last();
+				
+				if ( t >= times[ count - 1 ] ) {
+					result = keys[ count - 1 ];
+					return;
+				}
+
+				crimild::Size index = 0;
+				crimild::Real32 u = 0.0f;
+				if ( _sampleRate > 0.0f ) {
+					// uniform samples. No need to search for the index
+					const auto s = ( t - times[ 0 ] ) * _sampleRate;
+					index = Numeric< crimild::Size >::min( static_cast< crimild::Size >( s ), count - 2 );
+					u = Numericf::clamp( s - index, 0.0f, 1.0f );
 				}
 				else {
-					// TODO: cache last index to avoid this loop
-					crimild::Size index = 0;
-					for ( ; index < _times.size() - 1; index++ ) {
-						if ( t < _times[ index + 1 ] ) {
-							break;
-						}
-					}
-					
-					const auto t0 = _times[ index ];
-					const auto t1 = _times[ index + 1 ];
-
-					const auto &v0 = _keys[ index ];
-					const auto &v1 = _keys[ index + 1 ];
-
-					const auto u = ( t - t0 ) / ( t1 - t0 );
-					interpolate( v0, v1, u, result );
+					index = findKeyframe( count, t, cursor, [ times ]( crimild::Size i ) { return times[ i ]; } );
+					u = ( t - times[ index ] ) / ( times[ index + 1 ] - times[ index ] );
 				}
-				animation->setValue( getName(), result );
+
+				interpolate( keys[ index ], keys[ index + 1 ], u, result );
+			}
+
+			/**
+			   \brief Samples rate for uniformly sampled channels. Zero otherwise
+			 */
+			crimild::Real32 getSampleRate( void ) const { return _sampleRate; }
+
+			/**
+			   \brief Replaces keyframes with uniformly spaced samples
+
+			   The actual rate might be higher than the requested one so the first 
+			   and last keyframe times are preserved and no fewer samples than 
+			   the original keyframes are used. Channels whose 
+			   keyframes are already evenly spaced are not resampled at all.
+			 */
+			virtual void resample( crimild::Real32 sampleRate ) override
+			{
+				const auto count = _times.size();
+				if ( count < 2 || _keys.size() != count || sampleRate <= 0.0f ) {
+					return;
+				}
+
+				const auto t0 = _times.first();
+				const auto duration = _times.last() - t0;
+				if ( duration <= 0.0f ) {
+					return;
+				}
+
+				const auto step = duration / ( count - 1 );
+				auto uniform = true;
+				for ( crimild::Size i = 1; uniform && i < count; i++ ) {
+					uniform = Numericf::fabs( _times[ i ] - ( t0 + i * step ) ) <= 1e-3f * step;
+				}
+
+				if ( uniform ) {
+					_sampleRate = 1.0f / step;
+					return;
+				}
+
+				// never use fewer samples than the original keyframes
+				const auto sampleCount = Numeric< crimild::Size >::max( count, static_cast< crimild::Size >( Numericf::ceil( duration * sampleRate ) ) + 1 );
+				const auto rate = ( sampleCount - 1 ) / duration;
+
+				TimeArray times( sampleCount );
+				KeyArray keys( sampleCount );
+				crimild::Size cursor = 0;
+				for ( crimild::Size i = 0; i < sampleCount; i++ ) {
+					times[ i ] = i < sampleCount - 1 ? t0 + i / rate : _times.last();
+					sample( times[ i ], cursor, keys[ i ] );
+				}
+
+				_times = std::move( times );
+				_keys = std::move( keys );
+				_sampleRate = rate;
 			}
 
 		private:
 			template< typename U >
-			void interpolate( const U& start, const U& end, crimild::Real32 t, U &result )
+			static void interpolate( const U& start, const U& end, crimild::Real32 t, U &result )
 			{
 				Interpolation::linear( start, end, t, result );
 			}
 
-			void interpolate( const Quaternion4f &start, const Quaternion4f &end, crimild::Real32 t, Quaternion4f &result )
+			static void interpolate( const Quaternion4f &start, const Quaternion4f &end, crimild::Real32 t, Quaternion4f &result )
 			{
 				Interpolation::slerp( start, end, t, result );
 			}
@@ -127,6 +210,7 @@ namespace crimild {
 		private:
 			TimeArray _times;
 			KeyArray _keys;
+			crimild::Real32 _sampleRate = 0.0f;
 
 			/**
 			   \name Coding
@@ -141,6 +225,7 @@ namespace crimild {
 				encoder.encode( "name", getName() );
 				encoder.encode( "times", _times );
 				encoder.encode( "keys", _keys );
+				encoder.encode( "sampleRate", _sampleRate );
 			}
 			
 			virtual void decode( coding::Decoder &decoder ) override
@@ -153,6 +238,7 @@ namespace crimild {
 				
 				decoder.decode( "times", _times );
 				decoder.decode( "keys", _keys );
+				decoder.decode( "sampleRate", _sampleRate );
 			}
 			
 			//@}
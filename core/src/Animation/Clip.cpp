@@ -27,6 +27,9 @@
 
 #include "Clip.hpp"
 #include "Channel.hpp"
+#include "Animation.hpp"
+#include "ChannelImpl.hpp"
+#include "CompressedChannel.hpp"
 #include "Coding/Encoder.hpp"
 #include "Coding/Decoder.hpp"
 
@@ -58,8 +61,30 @@ void Clip::addChannel( SharedPointer< Channel > const &channel )
 
 void Clip::evaluate( crimild::Real32 t, Animation *animation )
 {
-	_channels.each( [ t, animation ]( SharedPointer< Channel > &channel ) {
-		channel->evaluate( t, animation );
+	_channels.each( [ t, animation ]( SharedPointer< Channel > &channel, crimild::Size index ) {
+		channel->evaluate( t, animation, animation->getChannelCursor( index ) );
+	});
+}
+
+void Clip::resample( crimild::Real32 sampleRate )
+{
+	_channels.each( [ sampleRate ]( SharedPointer< Channel > &channel ) {
+		channel->resample( sampleRate );
+	});
+}
+
+void Clip::compress( crimild::Real32 tolerance )
+{
+	_channels.each( [ tolerance ]( SharedPointer< Channel > &channel ) {
+		if ( auto c = dynamic_cast< Vector3fChannel * >( crimild::get_ptr( channel ) ) ) {
+			channel = crimild::alloc< CompressedVector3fChannel >( c->getName(), c->getTimes(), c->getKeys(), tolerance );
+		}
+		else if ( auto c = dynamic_cast< Quaternion4fChannel * >( crimild::get_ptr( channel ) ) ) {
+			channel = crimild::alloc< CompressedQuaternion4fChannel >( c->getName(), c->getTimes(), c->getKeys(), tolerance );
+		}
+		else if ( auto c = dynamic_cast< Real32Channel * >( crimild::get_ptr( channel ) ) ) {
+			channel = crimild::alloc< CompressedReal32Channel >( c->getName(), c->getTimes(), c->getKeys(), tolerance );
+		}
 	});
 }
 
@@ -61,12 +61,27 @@ namespace crimild {
 
 		public:
 			void addChannel( SharedPointer< Channel > const &channel );
+			containers::Array< SharedPointer< Channel >> &getChannels( void ) { return _channels; }
 
 		private:
 			containers::Array< SharedPointer< Channel >> _channels;
 
 		public:
 			void evaluate( crimild::Real32 t, Animation *animation );
+
+			/**
+			   \brief Resamples all channels at a fixed rate
+
+			   \see Channel::resample()
+			 */
+			void resample( crimild::Real32 sampleRate );
+
+			/**
+			   \brief Replaces channels with compressed ones
+
+			   \see CompressedChannelImpl
+			 */
+			void compress( crimild::Real32 tolerance );
 			
 			/**
 			   \name Coding
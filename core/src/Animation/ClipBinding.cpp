@@ -0,0 +1,68 @@
+/*
+ * Copyright (c) 2013, Hernan Saez
+ * All rights reserved.
+ * 
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *     * Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in the
+ *       documentation and/or other materials provided with the distribution.
+ *     * Neither the name of the <organization> nor the
+ *       names of its contributors may be used to endorse or promote products
+ *       derived from this software without specific prior written permission.
+ * 
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL <COPYRIGHT HOLDER> BE LIABLE FOR ANY
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "ClipBinding.hpp"
+#include "Clip.hpp"
+#include "Channel.hpp"
+#include "Skeleton.hpp"
+
+using namespace crimild;
+using namespace crimild::animation;
+
+ClipBinding::ClipBinding( SharedPointer< Clip > const &clip, Skeleton *skeleton )
+	: _clip( clip ),
+	  _duration( clip->getDuration() ),
+	  _frameRate( clip->getFrameRate() )
+{
+	clip->getChannels().each( [ this, skeleton ]( SharedPointer< Channel > &channel ) {
+		auto name = channel->getName();
+		auto suffix = name.rfind( '[' );
+		if ( suffix != std::string::npos && name.back() == ']' ) {
+			name = name.substr( 0, suffix );
+		}
+
+		auto joint = skeleton->getJointIndex( name );
+		if ( joint >= 0 ) {
+			_entries.push_back( Entry { crimild::get_ptr( channel ), static_cast< crimild::Size >( joint ) } );
+		}
+	});
+}
+
+ClipBinding::~ClipBinding( void )
+{
+
+}
+
+void ClipBinding::evaluate( crimild::Real32 t, Pose &pose, crimild::Size *cursors ) const
+{
+	const auto N = _entries.size();
+	for ( crimild::Size i = 0; i < N; i++ ) {
+		const auto &e = _entries[ i ];
+		e.channel->evaluate( t, pose, e.joint, cursors[ i ] );
+	}
+}
+
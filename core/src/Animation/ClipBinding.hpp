@@ -0,0 +1,99 @@
+/*
+ * Copyright (c) 2013, Hernan Saez
+ * All rights reserved.
+ * 
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *     * Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in the
+ *       documentation and/or other materials provided with the distribution.
+ *     * Neither the name of the <organization> nor the
+ *       names of its contributors may be used to endorse or promote products
+ *       derived from this software without specific prior written permission.
+ * 
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL <COPYRIGHT HOLDER> BE LIABLE FOR ANY
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef CRIMILD_ANIMATION_CLIP_BINDING_
+#define CRIMILD_ANIMATION_CLIP_BINDING_
+
+#include "Foundation/SharedObject.hpp"
+#include "Foundation/Types.hpp"
+
+#include <vector>
+
+namespace crimild {
+
+	namespace animation {
+
+		class Clip;
+		class Channel;
+		class Pose;
+		class Skeleton;
+
+		/**
+		   \brief Maps the channels in a clip to joint indices in a skeleton
+
+		   Channel names are resolved only once, when the binding is created.
+		   Channels are expected to be named after joints, optionally followed 
+		   by a suffix like "[p]", "[r]" or "[s]". Channels that do not match 
+		   any joint are ignored.
+
+		   A binding can be shared by all skeletons with the same joint layout 
+		   (i.e. clones of the same character). Keyframe cursors are provided 
+		   by the caller, since they depend on each playback instance.
+		 */
+		class ClipBinding : public SharedObject {
+		public:
+			ClipBinding( SharedPointer< Clip > const &clip, Skeleton *skeleton );
+			virtual ~ClipBinding( void );
+
+			Clip *getClip( void ) { return crimild::get_ptr( _clip ); }
+
+			crimild::Real32 getDuration( void ) const { return _duration; }
+			crimild::Real32 getFrameRate( void ) const { return _frameRate; }
+
+			/**
+			   \brief Number of channels bound to joints
+
+			   This is also the number of cursors required by evaluate()
+			 */
+			crimild::Size getChannelCount( void ) const { return _entries.size(); }
+
+			/**
+			   \brief Evaluates all bound channels at time t
+
+			   Joints without channels are not modified, so the pose should be
+			   initialized beforehand (usually, with the skeleton's rest pose).
+			 */
+			void evaluate( crimild::Real32 t, Pose &pose, crimild::Size *cursors ) const;
+
+		private:
+			struct Entry {
+				Channel *channel;
+				crimild::Size joint;
+			};
+
+			SharedPointer< Clip > _clip;
+			crimild::Real32 _duration = 0.0f;
+			crimild::Real32 _frameRate = 1.0f;
+			std::vector< Entry > _entries;
+		};
+
+	}
+
+}
+
+#endif
+
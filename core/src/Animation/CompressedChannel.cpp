@@ -0,0 +1,63 @@
+/*
+ * Copyright (c) 2013, Hernan Saez
+ * All rights reserved.
+ * 
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *     * Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in the
+ *       documentation and/or other materials provided with the distribution.
+ *     * Neither the name of the <organization> nor the
+ *       names of its contributors may be used to endorse or promote products
+ *       derived from this software without specific prior written permission.
+ * 
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL <COPYRIGHT HOLDER> BE LIABLE FOR ANY
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "CompressedChannel.hpp"
+
+using namespace crimild;
+using namespace crimild::animation;
+
+void compression::packQuaternion( const Quaternion4f &q, crimild::UInt16 *out )
+{
+	auto data = q.getRawData();
+	const auto length = data.getMagnitude();
+	if ( length > 0.0 ) {
+		data /= length;
+	}
+
+	crimild::UInt16 largest = 0;
+	for ( crimild::UInt16 i = 1; i < 4; i++ ) {
+		if ( Numericf::fabs( data[ i ] ) > Numericf::fabs( data[ largest ] ) ) {
+			largest = i;
+		}
+	}
+
+	const auto sign = data[ largest ] < 0.0f ? -1.0f : 1.0f;
+	const auto SCALE = 0x7FFF / Numericf::SQRT_TWO;
+	const auto OFFSET = Numericf::SQRT_TWO_DIV_TWO;
+
+	crimild::Size j = 0;
+	for ( crimild::UInt16 i = 0; i < 4; i++ ) {
+		if ( i != largest ) {
+			const auto v = Numericf::clamp( sign * data[ i ] + OFFSET, 0.0f, Numericf::SQRT_TWO );
+			out[ j++ ] = static_cast< crimild::UInt16 >( v * SCALE + 0.5f ) & 0x7FFF;
+		}
+	}
+
+	out[ 0 ] |= ( largest >> 1 ) << 15;
+	out[ 1 ] |= ( largest & 1 ) << 15;
+}
+
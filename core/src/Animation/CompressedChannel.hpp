@@ -0,0 +1,541 @@
+/*
+ * Copyright (c) 2013, Hernan Saez
+ * All rights reserved.
+ * 
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *     * Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in the
+ *       documentation and/or other materials provided with the distribution.
+ *     * Neither the name of the <organization> nor the
+ *       names of its contributors may be used to endorse or promote products
+ *       derived from this software without specific prior written permission.
+ * 
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL <COPYRIGHT HOLDER> BE LIABLE FOR ANY
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef CRIMILD_ANIMATION_COMPRESSED_CHANNEL_
+#define CRIMILD_ANIMATION_COMPRESSED_CHANNEL_
+
+#include "Channel.hpp"
+#include "Animation.hpp"
+#include "KeyframeCursor.hpp"
+#include "Pose.hpp"
+
+#include "Coding/Encoder.hpp"
+#include "Coding/Decoder.hpp"
+#include "Foundation/Containers/Array.hpp"
+#include "Mathematics/Interpolation.hpp"
+
+#include <cstring>
+
+namespace crimild {
+
+	namespace animation {
+
+		namespace compression {
+
+			static const crimild::UInt16 MAX_QUANTIZED_VALUE = 0xFFFF;
+
+			inline crimild::UInt16 quantize( crimild::Real32 value, crimild::Real32 min, crimild::Real32 extent )
+			{
+				if ( extent <= 0.0f ) {
+					return 0;
+				}
+
+				const auto u = Numericf::clamp( ( value - min ) / extent, 0.0f, 1.0f );
+				return static_cast< crimild::UInt16 >( u * MAX_QUANTIZED_VALUE + 0.5f );
+			}
+
+			inline crimild::Real32 dequantize( crimild::UInt16 value, crimild::Real32 min, crimild::Real32 extent )
+			{
+				return min + value * ( extent / MAX_QUANTIZED_VALUE );
+			}
+
+			/**
+			   \brief Quantized values are coded as raw bytes, which are stored as a single block by all encoders
+			 */
+			inline void toBytes( const containers::Array< crimild::UInt16 > &values, containers::ByteArray &bytes )
+			{
+				bytes.resize( values.size() * sizeof( crimild::UInt16 ) );
+				if ( values.size() > 0 ) {
+					memcpy( bytes.getData(), values.getData(), bytes.size() );
+				}
+			}
+
+			inline void fromBytes( const containers::ByteArray &bytes, containers::Array< crimild::UInt16 > &values )
+			{
+				values.resize( bytes.size() / sizeof( crimild::UInt16 ) );
+				if ( values.size() > 0 ) {
+					memcpy( values.getData(), bytes.getData(), values.size() * sizeof( crimild::UInt16 ) );
+				}
+			}
+
+			/**
+			   \brief Encodes a unit quaternion in 48 bits using the smallest three representation
+
+			   The largest component is dropped and the other three are stored with 15 bits
+			   each. The index of the dropped component goes into the two remaining top bits.
+			   Since q and -q describe the same rotation, the quaternion is negated if needed 
+			   so the dropped component is always positive.
+			 */
+			void packQuaternion( const Quaternion4f &q, crimild::UInt16 *out );
+
+			inline Quaternion4f unpackQuaternion( const crimild::UInt16 *in )
+			{
+				// components are in the range [ -1 / sqrt( 2 ), 1 / sqrt( 2 ) ]
+				const auto SCALE = Numericf::SQRT_TWO / 0x7FFF;
+				const auto OFFSET = Numericf::SQRT_TWO_DIV_TWO;
+
+				const auto a = ( in[ 0 ] & 0x7FFF ) * SCALE - OFFSET;
+				const auto b = ( in[ 1 ] & 0x7FFF ) * SCALE - OFFSET;
+				const auto c = ( in[ 2 ] & 0x7FFF ) * SCALE - OFFSET;
+				const auto d = Numericf::sqrt( Numericf::max( 0.0f, 1.0f - a * a - b * b - c * c ) );
+
+				switch ( ( ( in[ 0 ] >> 15 ) << 1 ) | ( in[ 1 ] >> 15 ) ) {
+					case 0: return Quaternion4f( d, a, b, c );
+					case 1: return Quaternion4f( a, d, b, c );
+					case 2: return Quaternion4f( a, b, d, c );
+					default: return Quaternion4f( a, b, c, d );
+				}
+			}
+
+			/**
+			   \brief Describes how to store keys of a given type
+			 */
+			template< typename T >
+			struct KeyCodec;
+
+			template<>
+			struct KeyCodec< crimild::Real32 > {
+				static const crimild::Size WORD_COUNT = 1;
+
+				static crimild::Real32 error( crimild::Real32 a, crimild::Real32 b ) { return Numericf::fabs( a - b ); }
+
+				static void interpolate( crimild::Real32 a, crimild::Real32 b, crimild::Real32 u, crimild::Real32 &result ) { result = a + u * ( b - a ); }
+
+				static void expand( crimild::Real32 key, Vector3f &min, Vector3f &max )
+				{
+					min[ 0 ] = Numericf::min( min[ 0 ], key );
+					max[ 0 ] = Numericf::max( max[ 0 ], key );
+				}
+
+				static void encode( crimild::Real32 key, const Vector3f &min, const Vector3f &extent, crimild::UInt16 *out )
+				{
+					out[ 0 ] = quantize( key, min[ 0 ], extent[ 0 ] );
+				}
+
+				static void decode( const crimild::UInt16 *in, const Vector3f &min, const Vector3f &extent, crimild::Real32 &key )
+				{
+					key = dequantize( in[ 0 ], min[ 0 ], extent[ 0 ] );
+				}
+			};
+
+			template<>
+			struct KeyCodec< Vector3f > {
+				static const crimild::Size WORD_COUNT = 3;
+
+				static crimild::Real32 error( const Vector3f &a, const Vector3f &b ) { return ( a - b ).getMagnitude(); }
+
+				static void interpolate( const Vector3f &a, const Vector3f &b, crimild::Real32 u, Vector3f &result ) { Interpolation::linear( a, b, u, result ); }
+
+				static void expand( const Vector3f &key, Vector3f &min, Vector3f &max )
+				{
+					for ( crimild::Size i = 0; i < 3; i++ ) {
+						min[ i ] = Numericf::min( min[ i ], key[ i ] );
+						max[ i ] = Numericf::max( max[ i ], key[ i ] );
+					}
+				}
+
+				static void encode( const Vector3f &key, const Vector3f &min, const Vector3f &extent, crimild::UInt16 *out )
+				{
+					for ( crimild::Size i = 0; i < 3; i++ ) {
+						out[ i ] = quantize( key[ i ], min[ i ], extent[ i ] );
+					}
+				}
+
+				static void decode( const crimild::UInt16 *in, const Vector3f &min, const Vector3f &extent, Vector3f &key )
+				{
+					key = Vector3f(
+						dequantize( in[ 0 ], min[ 0 ], extent[ 0 ] ),
+						dequantize( in[ 1 ], min[ 1 ], extent[ 1 ] ),
+						dequantize( in[ 2 ], min[ 2 ], extent[ 2 ] ) );
+				}
+			};
+
+			template<>
+			struct KeyCodec< Quaternion4f > {
+				static const crimild::Size WORD_COUNT = 3;
+
+				/**
+				   \brief Angle (in radians) between two rotations
+				 */
+				static crimild::Real32 error( const Quaternion4f &a, const Quaternion4f &b )
+				{
+					const auto d = Numericf::min( 1.0f, Numericf::fabs( a.getRawData() * b.getRawData() ) );
+					return 2.0f * Numericf::acos( d );
+				}
+
+				static void interpolate( const Quaternion4f &a, const Quaternion4f &b, crimild::Real32 u, Quaternion4f &result ) { Interpolation::slerp( a, b, u, result ); }
+
+				static void expand( const Quaternion4f &, Vector3f &, Vector3f & )
+				{
+					// quaternions are always stored in the same range
+				}
+
+				static void encode( const Quaternion4f &key, const Vector3f &, const Vector3f &, crimild::UInt16 *out )
+				{
+					packQuaternion( key, out );
+				}
+
+				static void decode( const crimild::UInt16 *in, const Vector3f &, const Vector3f &, Quaternion4f &key )
+				{
+					key = unpackQuaternion( in );
+				}
+			};
+
+		}
+
+		/**
+		   \brief A channel storing quantized keys
+
+		   Keys are compressed when the channel is created:
+		   - Keys that can be reconstructed by interpolating their neighbors within 
+		   the given tolerance are removed.
+		   - Channels whose keys are all within the tolerance of the first one are 
+		   reduced to a single key (constant tracks).
+		   - Times and values are quantized to 16 bits each, using the actual range 
+		   of values in the channel. Quaternions use 48 bits per key.
+
+		   Tolerance is measured as a distance for scalars and vectors and as an 
+		   angle (in radians) for quaternions.
+		 */
+		template< typename T >
+		class CompressedChannelImpl : public Channel {
+		private:
+			using Codec = compression::KeyCodec< T >;
+			using QuantizedArray = containers::Array< crimild::UInt16 >;
+
+		public:
+			static const crimild::Size WORD_COUNT = Codec::WORD_COUNT;
+
+		public:
+			CompressedChannelImpl( void ) { }
+
+			CompressedChannelImpl( std::string name, const containers::Array< crimild::Real32 > &times, const containers::Array< T > &keys, crimild::Real32 tolerance )
+				: Channel( name )
+			{
+				compress( times, keys, tolerance );
+			}
+
+			virtual ~CompressedChannelImpl( void )
+			{
+
+			}
+
+			virtual crimild::Real32 getDuration( void ) const override
+			{
+				return _endTime;
+			}
+
+			crimild::Size getKeyCount( void ) const { return _keys.size() / WORD_COUNT; }
+
+			/**
+			   \brief Memory used by the compressed keys, including range data
+			 */
+			crimild::Size getSizeInBytes( void ) const
+			{
+				return sizeof( crimild::UInt16 ) * ( _times.size() + _keys.size() ) 
+					+ 2 * sizeof( crimild::Real32 ) 
+					+ 2 * sizeof( Vector3f );
+			}
+
+			using Channel::evaluate;
+
+			virtual void evaluate( crimild::Real32 t, Animation *animation, crimild::Size &cursor ) override
+			{
+				if ( _keys.size() == 0 ) {
+					return;
+				}
+
+				T result;
+				sample( t, cursor, result );
+				animation->setValue( getName(), result );
+			}
+
+			virtual void evaluate( crimild::Real32 t, Pose &pose, crimild::Size joint, crimild::Size &cursor ) override
+			{
+				if ( _keys.size() == 0 ) {
+					return;
+				}
+
+				T result;
+				sample( t, cursor, result );
+				pose.set( joint, result );
+			}
+
+			void sample( crimild::Real32 t, crimild::Size &cursor, T &result ) const
+			{
+				const auto count = getKeyCount();
+				const auto keys = _keys.getData();
+
+				if ( count == 1 || t <= _startTime ) {
+					Codec::decode( keys, _rangeMin, _rangeExtent, result );
+					return;
+				}
+
+				if ( t >= _endTime ) {
+					Codec::decode( keys + WORD_COUNT * ( count - 1 ), _rangeMin, _rangeExtent, result );
+					return;
+				}
+
+				// search in quantized time, so times don't need to be decoded
+				const auto times = _times.getData();
+				const auto q = ( t - _startTime ) * _timeScale;
+				const auto index = findKeyframe( count, q, cursor, [ times ]( crimild::Size i ) { return crimild::Real32( times[ i ] ); } );
+
+				const auto t0 = crimild::Real32( times[ index ] );
+				const auto t1 = crimild::Real32( times[ index + 1 ] );
+				const auto u = t1 > t0 ? ( q - t0 ) / ( t1 - t0 ) : 0.0f;
+
+				T v0, v1;
+				Codec::decode( keys + WORD_COUNT * index, _rangeMin, _rangeExtent, v0 );
+				Codec::decode( keys + WORD_COUNT * ( index + 1 ), _rangeMin, _rangeExtent, v1 );
+				Codec::interpolate( v0, v1, u, result );
+			}
+
+		private:
+			void compress( const containers::Array< crimild::Real32 > &times, const containers::Array< T > &keys, crimild::Real32 tolerance )
+			{
+				const auto count = Numeric< crimild::Size >::min( times.size(), keys.size() );
+				if ( count == 0 ) {
+					return;
+				}
+
+				_startTime = times[ 0 ];
+				_endTime = times[ count - 1 ];
+				updateTimeScale();
+
+				auto constant = true;
+				for ( crimild::Size i = 1; constant && i < count; i++ ) {
+					constant = Codec::error( keys[ 0 ], keys[ i ] ) <= tolerance;
+				}
+
+				// compute range for quantization. Constant tracks only need the first key
+				Vector3f min( Numericf::POSITIVE_INFINITY, Numericf::POSITIVE_INFINITY, Numericf::POSITIVE_INFINITY );
+				Vector3f max( -Numericf::POSITIVE_INFINITY, -Numericf::POSITIVE_INFINITY, -Numericf::POSITIVE_INFINITY );
+				for ( crimild::Size i = 0; i < ( constant ? 1 : count ); i++ ) {
+					Codec::expand( keys[ i ], min, max );
+				}
+				for ( crimild::Size i = 0; i < 3; i++ ) {
+					if ( min[ i ] > max[ i ] ) {
+						min[ i ] = max[ i ] = 0.0f;
+					}
+				}
+				_rangeMin = min;
+				_rangeExtent = max - min;
+
+				if ( constant ) {
+					_keys.resize( WORD_COUNT );
+					_times.resize( 0 );
+					Codec::encode( keys[ 0 ], _rangeMin, _rangeExtent, &_keys[ 0 ] );
+					return;
+				}
+
+				// all keys are quantized first, so key reduction measures 
+				// the error of the decoded channel
+				QuantizedArray quantizedTimes( count );
+				QuantizedArray quantizedKeys( WORD_COUNT * count );
+				for ( crimild::Size i = 0; i < count; i++ ) {
+					quantizedTimes[ i ] = compression::quantize( times[ i ], _startTime, _endTime - _startTime );
+					Codec::encode( keys[ i ], _rangeMin, _rangeExtent, &quantizedKeys[ WORD_COUNT * i ] );
+				}
+
+				// select keys that cannot be interpolated from their neighbors
+				containers::Array< crimild::Size > selected;
+				selected.add( 0 );
+
+				crimild::Size a = 0;
+				while ( a < count - 1 ) {
+					auto b = a + 1;
+					while ( b + 1 < count && fits( times, keys, quantizedTimes, quantizedKeys, a, b + 1, tolerance ) ) {
+						++b;
+					}
+					selected.add( b );
+					a = b;
+				}
+
+				const auto selectedCount = selected.size();
+				_keys.resize( WORD_COUNT * selectedCount );
+				_times.resize( selectedCount );
+				for ( crimild::Size i = 0; i < selectedCount; i++ ) {
+					const auto index = selected[ i ];
+					_times[ i ] = quantizedTimes[ index ];
+					for ( crimild::Size w = 0; w < WORD_COUNT; w++ ) {
+						_keys[ WORD_COUNT * i + w ] = quantizedKeys[ WORD_COUNT * index + w ];
+					}
+				}
+			}
+
+			/**
+			   \brief Checks if all keys between a and b can be interpolated from them
+
+			   Keys a and b are decoded and interpolated the same way sample() does,
+			   so quantization errors are taken into account
+			 */
+			crimild::Bool fits( const containers::Array< crimild::Real32 > &times, const containers::Array< T > &keys, const QuantizedArray &quantizedTimes, const QuantizedArray &quantizedKeys, crimild::Size a, crimild::Size b, crimild::Real32 tolerance ) const
+			{
+				T v0, v1;
+				Codec::decode( &quantizedKeys[ WORD_COUNT * a ], _rangeMin, _rangeExtent, v0 );
+				Codec::decode( &quantizedKeys[ WORD_COUNT * b ], _rangeMin, _rangeExtent, v1 );
+
+				const auto t0 = crimild::Real32( quantizedTimes[ a ] );
+				const auto t1 = crimild::Real32( quantizedTimes[ b ] );
+				for ( auto i = a + 1; i < b; i++ ) {
+					const auto q = ( times[ i ] - _startTime ) * _timeScale;
+					const auto u = t1 > t0 ? Numericf::clamp( ( q - t0 ) / ( t1 - t0 ), 0.0f, 1.0f ) : 0.0f;
+					T value;
+					Codec::interpolate( v0, v1, u, value );
+					if ( Codec::error( value, keys[ i ] ) > tolerance ) {
+						return false;
+					}
+				}
+				return true;
+			}
+
+			void updateTimeScale( void )
+			{
+				const auto duration = _endTime - _startTime;
+				_timeScale = duration > 0.0f ? compression::MAX_QUANTIZED_VALUE / duration : 0.0f;
+			}
+
+		private:
+			crimild::Real32 _startTime = 0.0f;
+			crimild::Real32 _endTime = 0.0f;
+			crimild::Real32 _timeScale = 0.0f;
+			Vector3f _rangeMin;
+			Vector3f _rangeExtent;
+			QuantizedArray _times;
+			QuantizedArray _keys;
+
+			/**
+			   \name Coding
+			*/
+			//@{
+
+		public:
+			virtual void encode( coding::Encoder &encoder ) override
+			{
+				Codable::encode( encoder );
+
+				encoder.encode( "name", getName() );
+				encoder.encode( "startTime", _startTime );
+				encoder.encode( "endTime", _endTime );
+				encoder.encode( "rangeMin", _rangeMin );
+				encoder.encode( "rangeExtent", _rangeExtent );
+				containers::ByteArray timeBytes;
+				compression::toBytes( _times, timeBytes );
+				encoder.encode( "times", timeBytes );
+
+				containers::ByteArray keyBytes;
+				compression::toBytes( _keys, keyBytes );
+				encoder.encode( "keys", keyBytes );
+			}
+
+			virtual void decode( coding::Decoder &decoder ) override
+			{
+				Codable::decode( decoder );
+
+				std::string name;
+				decoder.decode( "name", name );
+				setName( name );
+
+				decoder.decode( "startTime", _startTime );
+				decoder.decode( "endTime", _endTime );
+				decoder.decode( "rangeMin", _rangeMin );
+				decoder.decode( "rangeExtent", _rangeExtent );
+				containers::ByteArray timeBytes;
+				decoder.decode( "times", timeBytes );
+				compression::fromBytes( timeBytes, _times );
+
+				containers::ByteArray keyBytes;
+				decoder.decode( "keys", keyBytes );
+				compression::fromBytes( keyBytes, _keys );
+
+				updateTimeScale();
+			}
+
+			//@}
+		};
+
+		class CompressedVector3fChannel : public CompressedChannelImpl< Vector3f > {
+			CRIMILD_IMPLEMENT_RTTI( crimild::animation::CompressedVector3fChannel )
+
+		public:
+			CompressedVector3fChannel( void ) { }
+
+			CompressedVector3fChannel( std::string name, const containers::Array< crimild::Real32 > &times, const containers::Array< Vector3f > &keys, crimild::Real32 tolerance )
+				: CompressedChannelImpl( name, times, keys, tolerance )
+			{
+
+			}
+
+			virtual ~CompressedVector3fChannel( void )
+			{
+
+			}
+		};
+
+		class CompressedQuaternion4fChannel : public CompressedChannelImpl< Quaternion4f > {
+			CRIMILD_IMPLEMENT_RTTI( crimild::animation::CompressedQuaternion4fChannel )
+
+		public:
+			CompressedQuaternion4fChannel( void ) { }
+
+			CompressedQuaternion4fChannel( std::string name, const containers::Array< crimild::Real32 > &times, const containers::Array< Quaternion4f > &keys, crimild::Real32 tolerance )
+				: CompressedChannelImpl( name, times, keys, tolerance )
+			{
+
+			}
+
+			virtual ~CompressedQuaternion4fChannel( void )
+			{
+
+			}
+		};
+
+		class CompressedReal32Channel : public CompressedChannelImpl< crimild::Real32 > {
+			CRIMILD_IMPLEMENT_RTTI( crimild::animation::CompressedReal32Channel )
+
+		public:
+			CompressedReal32Channel( void ) { }
+
+			CompressedReal32Channel( std::string name, const containers::Array< crimild::Real32 > &times, const containers::Array< crimild::Real32 > &keys, crimild::Real32 tolerance )
+				: CompressedChannelImpl( name, times, keys, tolerance )
+			{
+
+			}
+
+			virtual ~CompressedReal32Channel( void )
+			{
+
+			}
+		};
+
+	}
+
+}
+
+#endif
+
@@ -0,0 +1,84 @@
+/*
+ * Copyright (c) 2013, Hernan Saez
+ * All rights reserved.
+ * 
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *     * Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in the
+ *       documentation and/or other materials provided with the distribution.
+ *     * Neither the name of the <organization> nor the
+ *       names of its contributors may be used to endorse or promote products
+ *       derived from this software without specific prior written permission.
+ * 
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL <COPYRIGHT HOLDER> BE LIABLE FOR ANY
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef CRIMILD_ANIMATION_KEYFRAME_CURSOR_
+#define CRIMILD_ANIMATION_KEYFRAME_CURSOR_
+
+#include "Foundation/Types.hpp"
+
+namespace crimild {
+
+	namespace animation {
+
+		/**
+		   \brief Finds the pair of keyframes [ index, index + 1 ] surrounding time t
+
+		   The cursor holds the index returned by the previous lookup, which
+		   is the one we need most of the time since animations are usually
+		   played forward in small steps. If neither the cached segment nor 
+		   the next one contain t, the index is found using a binary search.
+		   The cursor is updated with the result.
+
+		   Requires at least two keyframes and times[ 0 ] <= t < times[ count - 1 ].
+		   The timeAt callable must return the time for a given keyframe index.
+		 */
+		template< typename TimeAt >
+		crimild::Size findKeyframe( crimild::Size count, crimild::Real32 t, crimild::Size &cursor, TimeAt const &timeAt )
+		{
+			if ( cursor + 1 < count && timeAt( cursor ) <= t ) {
+				if ( t < timeAt( cursor + 1 ) ) {
+					return cursor;
+				}
+
+				if ( cursor + 2 < count && t < timeAt( cursor + 2 ) ) {
+					return ++cursor;
+				}
+			}
+
+			// invariant: timeAt( lo ) <= t < timeAt( hi )
+			crimild::Size lo = 0;
+			crimild::Size hi = count - 1;
+			while ( hi - lo > 1 ) {
+				const auto mid = lo + ( hi - lo ) / 2;
+				if ( t < timeAt( mid ) ) {
+					hi = mid;
+				}
+				else {
+					lo = mid;
+				}
+			}
+
+			cursor = lo;
+			return lo;
+		}
+
+	}
+
+}
+
+#endif
+
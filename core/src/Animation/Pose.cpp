@@ -0,0 +1,135 @@
+/*
+ * Copyright (c) 2013, Hernan Saez
+ * All rights reserved.
+ * 
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *     * Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in the
+ *       documentation and/or other materials provided with the distribution.
+ *     * Neither the name of the <organization> nor the
+ *       names of its contributors may be used to endorse or promote products
+ *       derived from this software without specific prior written permission.
+ * 
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL <COPYRIGHT HOLDER> BE LIABLE FOR ANY
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "Pose.hpp"
+
+#include <cmath>
+
+using namespace crimild;
+using namespace crimild::animation;
+
+Pose::Pose( crimild::Size jointCount )
+{
+	resize( jointCount );
+}
+
+Pose::~Pose( void )
+{
+
+}
+
+void Pose::resize( crimild::Size jointCount )
+{
+	_jointCount = jointCount;
+
+	_tx.assign( jointCount, 0.0f );
+	_ty.assign( jointCount, 0.0f );
+	_tz.assign( jointCount, 0.0f );
+	_rx.assign( jointCount, 0.0f );
+	_ry.assign( jointCount, 0.0f );
+	_rz.assign( jointCount, 0.0f );
+	_rw.assign( jointCount, 1.0f );
+	_s.assign( jointCount, 1.0f );
+}
+
+void Pose::lerp( const Pose &a, const Pose &b, crimild::Real32 factor, Pose &result )
+{
+	const auto N = Numeric< crimild::Size >::min( a._jointCount, b._jointCount );
+	if ( result._jointCount != N ) {
+		result.resize( N );
+	}
+
+	const auto u = factor;
+	const auto v = 1.0f - factor;
+
+	for ( crimild::Size i = 0; i < N; i++ ) {
+		result._tx[ i ] = v * a._tx[ i ] + u * b._tx[ i ];
+		result._ty[ i ] = v * a._ty[ i ] + u * b._ty[ i ];
+		result._tz[ i ] = v * a._tz[ i ] + u * b._tz[ i ];
+		result._s[ i ] = v * a._s[ i ] + u * b._s[ i ];
+	}
+
+	for ( crimild::Size i = 0; i < N; i++ ) {
+		// use the shortest path
+		const auto d = a._rx[ i ] * b._rx[ i ] + a._ry[ i ] * b._ry[ i ] + a._rz[ i ] * b._rz[ i ] + a._rw[ i ] * b._rw[ i ];
+		const auto w = d < 0.0f ? -u : u;
+
+		const auto x = v * a._rx[ i ] + w * b._rx[ i ];
+		const auto y = v * a._ry[ i ] + w * b._ry[ i ];
+		const auto z = v * a._rz[ i ] + w * b._rz[ i ];
+		const auto q = v * a._rw[ i ] + w * b._rw[ i ];
+		const auto invLength = 1.0f / std::sqrt( x * x + y * y + z * z + q * q );
+
+		result._rx[ i ] = x * invLength;
+		result._ry[ i ] = y * invLength;
+		result._rz[ i ] = z * invLength;
+		result._rw[ i ] = q * invLength;
+	}
+}
+
+void Pose::add( const Pose &base, const Pose &additive, crimild::Real32 strength, Pose &result )
+{
+	const auto N = Numeric< crimild::Size >::min( base._jointCount, additive._jointCount );
+	if ( result._jointCount != N ) {
+		result.resize( N );
+	}
+
+	const auto u = strength;
+	const auto v = 1.0f - strength;
+
+	for ( crimild::Size i = 0; i < N; i++ ) {
+		result._tx[ i ] = base._tx[ i ] + u * additive._tx[ i ];
+		result._ty[ i ] = base._ty[ i ] + u * additive._ty[ i ];
+		result._tz[ i ] = base._tz[ i ] + u * additive._tz[ i ];
+		result._s[ i ] = base._s[ i ] + u * additive._s[ i ];
+	}
+
+	for ( crimild::Size i = 0; i < N; i++ ) {
+		// scale the additive rotation by blending it with the identity
+		const auto sign = additive._rw[ i ] < 0.0f ? -u : u;
+		auto x = sign * additive._rx[ i ];
+		auto y = sign * additive._ry[ i ];
+		auto z = sign * additive._rz[ i ];
+		auto w = v + sign * additive._rw[ i ];
+		const auto invLength = 1.0f / std::sqrt( x * x + y * y + z * z + w * w );
+		x *= invLength;
+		y *= invLength;
+		z *= invLength;
+		w *= invLength;
+
+		// result = base * additive
+		const auto bx = base._rx[ i ];
+		const auto by = base._ry[ i ];
+		const auto bz = base._rz[ i ];
+		const auto bw = base._rw[ i ];
+		result._rx[ i ] = bw * x + bx * w + by * z - bz * y;
+		result._ry[ i ] = bw * y - bx * z + by * w + bz * x;
+		result._rz[ i ] = bw * z + bx * y - by * x + bz * w;
+		result._rw[ i ] = bw * w - bx * x - by * y - bz * z;
+	}
+}
+
@@ -0,0 +1,133 @@
+/*
+ * Copyright (c) 2013, Hernan Saez
+ * All rights reserved.
+ * 
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *     * Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in the
+ *       documentation and/or other materials provided with the distribution.
+ *     * Neither the name of the <organization> nor the
+ *       names of its contributors may be used to endorse or promote products
+ *       derived from this software without specific prior written permission.
+ * 
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL <COPYRIGHT HOLDER> BE LIABLE FOR ANY
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef CRIMILD_ANIMATION_POSE_
+#define CRIMILD_ANIMATION_POSE_
+
+#include "Foundation/Types.hpp"
+#include "Mathematics/Transformation.hpp"
+
+#include <vector>
+
+namespace crimild {
+
+	namespace animation {
+
+		/**
+		   \brief Local transformations for all joints in a skeleton
+
+		   Joints are identified by their index in the skeleton (see 
+		   Skeleton::getJointIndex()). Each component is stored in its own
+		   array (structure of arrays), so blending poses is done with simple
+		   loops over contiguous floats that compilers can vectorize.
+		 */
+		class Pose {
+		public:
+			explicit Pose( crimild::Size jointCount = 0 );
+			~Pose( void );
+
+			crimild::Size getJointCount( void ) const { return _jointCount; }
+
+			/**
+			   \brief Resizes the pose. All joints are reset to the identity
+			 */
+			void resize( crimild::Size jointCount );
+
+			void set( crimild::Size joint, const Vector3f &translation )
+			{
+				_tx[ joint ] = translation[ 0 ];
+				_ty[ joint ] = translation[ 1 ];
+				_tz[ joint ] = translation[ 2 ];
+			}
+
+			void set( crimild::Size joint, const Quaternion4f &rotation )
+			{
+				const auto &q = rotation.getRawData();
+				_rx[ joint ] = q[ 0 ];
+				_ry[ joint ] = q[ 1 ];
+				_rz[ joint ] = q[ 2 ];
+				_rw[ joint ] = q[ 3 ];
+			}
+
+			void set( crimild::Size joint, crimild::Real32 scale )
+			{
+				_s[ joint ] = scale;
+			}
+
+			void set( crimild::Size joint, const Transformation &t )
+			{
+				set( joint, t.getTranslate() );
+				set( joint, t.getRotate() );
+				set( joint, t.getScale() );
+			}
+
+			Vector3f getTranslation( crimild::Size joint ) const { return Vector3f( _tx[ joint ], _ty[ joint ], _tz[ joint ] ); }
+			Quaternion4f getRotation( crimild::Size joint ) const { return Quaternion4f( _rx[ joint ], _ry[ joint ], _rz[ joint ], _rw[ joint ] ); }
+			crimild::Real32 getScale( crimild::Size joint ) const { return _s[ joint ]; }
+
+			Transformation getTransformation( crimild::Size joint ) const
+			{
+				return Transformation( getTranslation( joint ), getRotation( joint ), getScale( joint ) );
+			}
+
+		public:
+			/**
+			   \brief Blends two poses. Result might be one of the inputs
+
+			   Rotations are blended using normalized linear interpolation,
+			   which is accurate enough for the small angles between poses
+			   and much cheaper than slerp.
+			 */
+			static void lerp( const Pose &a, const Pose &b, crimild::Real32 factor, Pose &result );
+
+			/**
+			   \brief Adds a pose on top of another one. Result might be one of the inputs
+
+			   Translations and scales are added, while rotations are concatenated.
+			   Strength scales the contribution of the additive pose.
+			 */
+			static void add( const Pose &base, const Pose &additive, crimild::Real32 strength, Pose &result );
+
+		private:
+			crimild::Size _jointCount = 0;
+
+			std::vector< crimild::Real32 > _tx;
+			std::vector< crimild::Real32 > _ty;
+			std::vector< crimild::Real32 > _tz;
+			std::vector< crimild::Real32 > _rx;
+			std::vector< crimild::Real32 > _ry;
+			std::vector< crimild::Real32 > _rz;
+			std::vector< crimild::Real32 > _rw;
+			std::vector< crimild::Real32 > _s;
+		};
+
+	}
+
+}
+
+#endif
+
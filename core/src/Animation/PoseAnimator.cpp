@@ -0,0 +1,93 @@
+/*
+ * Copyright (c) 2013, Hernan Saez
+ * All rights reserved.
+ * 
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *     * Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in the
+ *       documentation and/or other materials provided with the distribution.
+ *     * Neither the name of the <organization> nor the
+ *       names of its contributors may be used to endorse or promote products
+ *       derived from this software without specific prior written permission.
+ * 
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL <COPYRIGHT HOLDER> BE LIABLE FOR ANY
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "PoseAnimator.hpp"
+#include "Skeleton.hpp"
+
+#include <cmath>
+
+using namespace crimild;
+using namespace crimild::animation;
+
+PoseAnimator::PoseAnimator( SharedPointer< Skeleton > const &skeleton )
+	: _skeleton( skeleton )
+{
+	_skeleton->getCurrentPose( _restPose );
+	_pose = _restPose;
+	_layerPose = _restPose;
+}
+
+PoseAnimator::~PoseAnimator( void )
+{
+
+}
+
+crimild::Size PoseAnimator::addLayer( SharedPointer< ClipBinding > const &binding, crimild::Real32 weight )
+{
+	_layers.push_back( Layer { binding, weight, std::vector< crimild::Size >( binding->getChannelCount(), 0 ) } );
+	return _layers.size() - 1;
+}
+
+crimild::Real32 PoseAnimator::computeLayerTime( const Layer &layer ) const
+{
+	const auto duration = layer.binding->getDuration();
+	if ( duration <= 0.0f ) {
+		return 0.0f;
+	}
+
+	const auto t = ( _clock.getAccumTime() + _timeOffset ) * layer.binding->getFrameRate();
+	const auto result = std::fmod( t, duration );
+	return result < 0.0f ? result + duration : result;
+}
+
+void PoseAnimator::evaluate( void )
+{
+	_pose = _restPose;
+
+	for ( crimild::Size i = 0; i < _layers.size(); i++ ) {
+		auto &layer = _layers[ i ];
+		const auto t = computeLayerTime( layer );
+
+		if ( i == 0 ) {
+			// the first layer is the base pose, no blending needed
+			layer.binding->evaluate( t, _pose, layer.cursors.data() );
+		}
+		else if ( layer.weight > 0.0f ) {
+			_layerPose = _restPose;
+			layer.binding->evaluate( t, _layerPose, layer.cursors.data() );
+			Pose::lerp( _pose, _layerPose, layer.weight, _pose );
+		}
+	}
+
+	_skeleton->computePoseMatrices( _pose );
+}
+
+void PoseAnimator::apply( void )
+{
+	_skeleton->applyPose( _pose );
+}
+
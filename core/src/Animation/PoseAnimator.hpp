@@ -0,0 +1,130 @@
+/*
+ * Copyright (c) 2013, Hernan Saez
+ * All rights reserved.
+ * 
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *     * Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in the
+ *       documentation and/or other materials provided with the distribution.
+ *     * Neither the name of the <organization> nor the
+ *       names of its contributors may be used to endorse or promote products
+ *       derived from this software without specific prior written permission.
+ * 
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL <COPYRIGHT HOLDER> BE LIABLE FOR ANY
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef CRIMILD_ANIMATION_POSE_ANIMATOR_
+#define CRIMILD_ANIMATION_POSE_ANIMATOR_
+
+#include "Pose.hpp"
+#include "ClipBinding.hpp"
+
+#include "Foundation/SharedObject.hpp"
+#include "Mathematics/Clock.hpp"
+
+#include <vector>
+
+namespace crimild {
+
+	namespace animation {
+
+		class Skeleton;
+
+		/**
+		   \brief Plays and blends clips for a single skeleton using compiled poses
+
+		   Each layer plays a clip (through a ClipBinding) and is blended on top 
+		   of the previous ones using its weight (the first layer's weight is 
+		   ignored). Layers with zero weight are not evaluated at all. All clips 
+		   are played in a loop.
+
+		   Unlike Animation, no per-channel lookups by name are performed and 
+		   no memory is allocated once layers have been added.
+
+		   \see PoseBatch
+		 */
+		class PoseAnimator : public SharedObject {
+		public:
+			explicit PoseAnimator( SharedPointer< Skeleton > const &skeleton );
+			virtual ~PoseAnimator( void );
+
+			Skeleton *getSkeleton( void ) { return crimild::get_ptr( _skeleton ); }
+
+			/**
+			   \brief Adds a new layer and returns its index
+			 */
+			crimild::Size addLayer( SharedPointer< ClipBinding > const &binding, crimild::Real32 weight = 1.0f );
+
+			crimild::Size getLayerCount( void ) const { return _layers.size(); }
+
+			void setLayerWeight( crimild::Size layer, crimild::Real32 weight ) { _layers[ layer ].weight = weight; }
+			crimild::Real32 getLayerWeight( crimild::Size layer ) const { return _layers[ layer ].weight; }
+
+			/**
+			   \brief Time (in seconds) added to the clock when evaluating clips
+			 */
+			void setTimeOffset( crimild::Real32 offset ) { _timeOffset = offset; }
+			crimild::Real32 getTimeOffset( void ) const { return _timeOffset; }
+
+			const Clock &getClock( void ) const { return _clock; }
+
+			/**
+			   \brief The rest pose, used for joints that are not animated
+
+			   Initialized with the current local transformations of all joints
+			 */
+			Pose &getRestPose( void ) { return _restPose; }
+
+			const Pose &getPose( void ) const { return _pose; }
+
+			void update( const Clock &c ) { _clock += c; }
+
+			/**
+			   \brief Computes the final pose and the skeleton's pose matrices
+
+			   The scene is not modified, so different animators can be 
+			   evaluated concurrently
+			 */
+			void evaluate( void );
+
+			/**
+			   \brief Sets the local transformations of joint nodes from the last evaluated pose
+			 */
+			void apply( void );
+
+		private:
+			struct Layer {
+				SharedPointer< ClipBinding > binding;
+				crimild::Real32 weight;
+				std::vector< crimild::Size > cursors;
+			};
+
+			crimild::Real32 computeLayerTime( const Layer &layer ) const;
+
+			SharedPointer< Skeleton > _skeleton;
+			std::vector< Layer > _layers;
+			Clock _clock;
+			crimild::Real32 _timeOffset = 0.0f;
+			Pose _restPose;
+			Pose _pose;
+			Pose _layerPose;
+		};
+
+	}
+
+}
+
+#endif
+
@@ -0,0 +1,77 @@
+/*
+ * Copyright (c) 2013, Hernan Saez
+ * All rights reserved.
+ * 
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *     * Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in the
+ *       documentation and/or other materials provided with the distribution.
+ *     * Neither the name of the <organization> nor the
+ *       names of its contributors may be used to endorse or promote products
+ *       derived from this software without specific prior written permission.
+ * 
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL <COPYRIGHT HOLDER> BE LIABLE FOR ANY
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef CRIMILD_ANIMATION_POSE_BATCH_
+#define CRIMILD_ANIMATION_POSE_BATCH_
+
+#include "PoseAnimator.hpp"
+
+#include <vector>
+
+namespace crimild {
+
+	namespace animation {
+
+		/**
+		   \brief Evaluates the poses for many skeletons at once
+
+		   Poses are evaluated in parallel using the JobScheduler, if available,
+		   since each animator only modifies its own skeleton's joints. Then, 
+		   local transformations are applied to joint nodes sequentially, 
+		   in the order in which animators were added.
+		 */
+		class PoseBatch {
+		public:
+			PoseBatch( void );
+			~PoseBatch( void );
+
+			void add( SharedPointer< PoseAnimator > const &animator );
+
+			crimild::Size getAnimatorCount( void ) const { return _animators.size(); }
+
+			/**
+			   \brief Number of animators evaluated by each job
+			 */
+			void setGrainSize( crimild::Size value ) { _grainSize = value; }
+			crimild::Size getGrainSize( void ) const { return _grainSize; }
+
+			/**
+			   \brief Evaluates and applies all poses and clears the batch
+			 */
+			void execute( void );
+
+		private:
+			std::vector< SharedPointer< PoseAnimator >> _animators;
+			crimild::Size _grainSize = 16;
+		};
+
+	}
+
+}
+
+#endif
+
@@ -28,6 +28,7 @@
 #include "Skeleton.hpp"
 #include "Clip.hpp"
 #include "Animation.hpp"
+#include "Pose.hpp"
 #include "SceneGraph/Node.hpp"
 #include "Visitors/Apply.hpp"
 #include "Debug/DebugRenderHelper.hpp"
@@ -97,11 +98,91 @@ void Skeleton::start( void )
 {
 	NodeComponent::start();
 
+	bind();
+}
+
+void Skeleton::bind( void )
+{
+	_jointsByIndex.clear();
+	_parentIndices.clear();
+
+	// nodes are visited before their children
 	getNode()->perform( Apply( [ this ]( Node *node ) {
 		if ( auto joint = node->getComponent< Joint >() ) {
 			getJoints().insert( joint->getName(), crimild::retain( joint ) );
+
+			crimild::Int32 parentIndex = -1;
+			if ( auto parent = node->getParent() ) {
+				if ( auto parentJoint = parent->getComponent< Joint >() ) {
+					auto it = std::find( _jointsByIndex.begin(), _jointsByIndex.end(), parentJoint );
+					if ( it != _jointsByIndex.end() ) {
+						parentIndex = static_cast< crimild::Int32 >( it - _jointsByIndex.begin() );
+					}
+				}
+			}
+
+			_jointsByIndex.push_back( joint );
+			_parentIndices.push_back( parentIndex );
 		}
 	}));
+
+	_modelTransforms.resize( _jointsByIndex.size() );
+}
+
+crimild::Int32 Skeleton::getJointIndex( const std::string &name ) const
+{
+	for ( crimild::Size i = 0; i < _jointsByIndex.size(); i++ ) {
+		if ( _jointsByIndex[ i ]->getName() == name ) {
+			return static_cast< crimild::Int32 >( i );
+		}
+	}
+
+	return -1;
+}
+
+void Skeleton::getCurrentPose( Pose &pose )
+{
+	const auto N = _jointsByIndex.size();
+	pose.resize( N );
+	for ( crimild::Size i = 0; i < N; i++ ) {
+		pose.set( i, _jointsByIndex[ i ]->getNode()->getLocal() );
+	}
+}
+
+void Skeleton::computePoseMatrices( const Pose &pose )
+{
+	const auto N = Numeric< crimild::Size >::min( _jointsByIndex.size(), pose.getJointCount() );
+	for ( crimild::Size i = 0; i < N; i++ ) {
+		auto joint = _jointsByIndex[ i ];
+		auto &model = _modelTransforms[ i ];
+
+		// parents come first, so their model transformations are up to date
+		const auto parentIndex = _parentIndices[ i ];
+		if ( parentIndex >= 0 ) {
+			model.computeFrom( _modelTransforms[ parentIndex ], pose.getTransformation( i ) );
+		}
+		else {
+			auto node = joint->getNode();
+			if ( node->hasParent() ) {
+				model.computeFrom( node->getParent()->getWorld(), pose.getTransformation( i ) );
+			}
+			else {
+				model = pose.getTransformation( i );
+			}
+		}
+
+		Transformation t;
+		t.computeFrom( model, joint->getOffset() );
+		joint->setPoseMatrix( t.computeModelMatrix() );
+	}
+}
+
+void Skeleton::applyPose( const Pose &pose )
+{
+	const auto N = Numeric< crimild::Size >::min( _jointsByIndex.size(), pose.getJointCount() );
+	for ( crimild::Size i = 0; i < N; i++ ) {
+		_jointsByIndex[ i ]->getNode()->setLocal( pose.getTransformation( i ) );
+	}
 }
 
 void Skeleton::animate( Animation *animation )
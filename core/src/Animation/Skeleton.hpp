@@ -32,6 +32,9 @@
 #include "Foundation/NamedObject.hpp"
 #include "Foundation/Containers/Map.hpp"
 #include "Mathematics/Matrix.hpp"
+#include "Mathematics/Transformation.hpp"
+
+#include <vector>
 
 namespace crimild {
 
@@ -39,6 +42,7 @@ namespace crimild {
 
 		class Clip;
 		class Animation;
+		class Pose;
 
 		class Joint :
 			public NamedObject,
@@ -116,6 +120,64 @@ namespace crimild {
 		public:
 			void animate( SharedPointer< Animation > const &animation ) { animate( crimild::get_ptr( animation ) ); }
 			void animate( Animation *animation );
+
+			/**
+			   \name Compiled poses
+
+			   Joints are assigned dense indices, so poses can be stored 
+			   in flat arrays (see Pose and ClipBinding) instead of being 
+			   resolved by name every frame.
+			 */
+			//@{
+
+		public:
+			/**
+			   \brief Collects joints and assigns them dense indices
+
+			   Parents always have lower indices than their children. Invoked 
+			   automatically by start(). Must be called again if joints change.
+			 */
+			void bind( void );
+
+			crimild::Size getJointCount( void ) const { return _jointsByIndex.size(); }
+			Joint *getJointAt( crimild::Size index ) { return _jointsByIndex[ index ]; }
+
+			/**
+			   \brief The dense index for a joint, or -1 if there is no joint with that name
+			 */
+			crimild::Int32 getJointIndex( const std::string &name ) const;
+
+			/**
+			   \brief The index of a joint's parent, or -1 if the parent is not a joint
+			 */
+			crimild::Int32 getParentJointIndex( crimild::Size index ) const { return _parentIndices[ index ]; }
+
+			/**
+			   \brief Stores the current local transformation of all joints
+			 */
+			void getCurrentPose( Pose &pose );
+
+			/**
+			   \brief Computes the pose matrices for all joints
+			   
+			   Only joints are modified, so it is safe to compute poses for 
+			   different skeletons concurrently.
+			 */
+			void computePoseMatrices( const Pose &pose );
+
+			/**
+			   \brief Sets the local transformation of all joint nodes
+
+			   Modifies the scene, so it must not be called concurrently
+			 */
+			void applyPose( const Pose &pose );
+
+		private:
+			std::vector< Joint * > _jointsByIndex;
+			std::vector< crimild::Int32 > _parentIndices;
+			std::vector< Transformation > _modelTransforms;
+
+			//@}
 			
 			/**
 			   \name Cloning
@@ -0,0 +1,759 @@
+/*
+ * Copyright (c) 2013, Hernan Saez
+ * All rights reserved.
+ * 
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *     * Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in the
+ *       documentation and/or other materials provided with the distribution.
+ *     * Neither the name of the <organization> nor the
+ *       names of its contributors may be used to endorse or promote products
+ *       derived from this software without specific prior written permission.
+ * 
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL <COPYRIGHT HOLDER> BE LIABLE FOR ANY
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "SkinningEngine.hpp"
+#include "Skeleton.hpp"
+
+#include "Concurrency/ParallelFor.hpp"
+#include "Foundation/Log.hpp"
+#include "Mathematics/Simd.hpp"
+#include "Rendering/SkinnedMesh.hpp"
+#include "Rendering/VertexBufferObject.hpp"
+
+#include <cmath>
+#include <limits>
+
+using namespace crimild;
+using namespace crimild::animation;
+
+SkinningPalette::SkinningPalette( void )
+{
+
+}
+
+SkinningPalette::~SkinningPalette( void )
+{
+
+}
+
+void SkinningPalette::resize( crimild::Size jointCount )
+{
+	_rows.resize( 12 * jointCount );
+	_dualQuaternions.resize( 8 * jointCount );
+	_scales.resize( jointCount );
+
+	Matrix4f identity;
+	identity.makeIdentity();
+	for ( crimild::Size i = 0; i < jointCount; i++ ) {
+		set( i, identity );
+	}
+}
+
+void SkinningPalette::set( crimild::Size jointId, const Matrix4f &poseMatrix )
+{
+	// matrices are stored in column-major order
+	auto rows = &_rows[ 12 * jointId ];
+	for ( crimild::Size r = 0; r < 3; r++ ) {
+		for ( crimild::Size c = 0; c < 4; c++ ) {
+			rows[ 4 * r + c ] = poseMatrix[ 4 * c + r ];
+		}
+	}
+
+	const auto scale = std::sqrt( poseMatrix[ 0 ] * poseMatrix[ 0 ] + poseMatrix[ 1 ] * poseMatrix[ 1 ] + poseMatrix[ 2 ] * poseMatrix[ 2 ] );
+	_scales[ jointId ] = scale;
+
+	// extract the rotation (see Quaternion::fromRotationMatrix)
+	const auto invScale = scale > 0.0f ? 1.0f / scale : 0.0f;
+	auto R = [ &rows, invScale ]( crimild::Size r, crimild::Size c ) { return rows[ 4 * r + c ] * invScale; };
+
+	crimild::Real32 q[ 4 ] = { 0.0f, 0.0f, 0.0f, 1.0f };
+	const auto trace = R( 0, 0 ) + R( 1, 1 ) + R( 2, 2 );
+	if ( scale == 0.0f ) {
+		// degenerated matrix. keep identity rotation
+	}
+	else if ( trace > 0.0f ) {
+		const auto S = 2.0f * std::sqrt( trace + 1.0f );
+		q[ 0 ] = ( R( 2, 1 ) - R( 1, 2 ) ) / S;
+		q[ 1 ] = ( R( 0, 2 ) - R( 2, 0 ) ) / S;
+		q[ 2 ] = ( R( 1, 0 ) - R( 0, 1 ) ) / S;
+		q[ 3 ] = 0.25f * S;
+	}
+	else if ( R( 0, 0 ) > R( 1, 1 ) && R( 0, 0 ) > R( 2, 2 ) ) {
+		const auto S = 2.0f * std::sqrt( 1.0f + R( 0, 0 ) - R( 1, 1 ) - R( 2, 2 ) );
+		q[ 0 ] = 0.25f * S;
+		q[ 1 ] = ( R( 0, 1 ) + R( 1, 0 ) ) / S;
+		q[ 2 ] = ( R( 0, 2 ) + R( 2, 0 ) ) / S;
+		q[ 3 ] = ( R( 2, 1 ) - R( 1, 2 ) ) / S;
+	}
+	else if ( R( 1, 1 ) > R( 2, 2 ) ) {
+		const auto S = 2.0f * std::sqrt( 1.0f + R( 1, 1 ) - R( 0, 0 ) - R( 2, 2 ) );
+		q[ 0 ] = ( R( 0, 1 ) + R( 1, 0 ) ) / S;
+		q[ 1 ] = 0.25f * S;
+		q[ 2 ] = ( R( 1, 2 ) + R( 2, 1 ) ) / S;
+		q[ 3 ] = ( R( 0, 2 ) - R( 2, 0 ) ) / S;
+	}
+	else {
+		const auto S = 2.0f * std::sqrt( 1.0f + R( 2, 2 ) - R( 0, 0 ) - R( 1, 1 ) );
+		q[ 0 ] = ( R( 0, 2 ) + R( 2, 0 ) ) / S;
+		q[ 1 ] = ( R( 1, 2 ) + R( 2, 1 ) ) / S;
+		q[ 2 ] = 0.25f * S;
+		q[ 3 ] = ( R( 1, 0 ) - R( 0, 1 ) ) / S;
+	}
+
+	// dual = 0.5 * t * q
+	const crimild::Real32 t[ 3 ] = { rows[ 3 ], rows[ 7 ], rows[ 11 ] };
+	auto dq = &_dualQuaternions[ 8 * jointId ];
+	dq[ 0 ] = q[ 0 ];
+	dq[ 1 ] = q[ 1 ];
+	dq[ 2 ] = q[ 2 ];
+	dq[ 3 ] = q[ 3 ];
+	dq[ 4 ] = 0.5f * ( q[ 3 ] * t[ 0 ] + t[ 1 ] * q[ 2 ] - t[ 2 ] * q[ 1 ] );
+	dq[ 5 ] = 0.5f * ( q[ 3 ] * t[ 1 ] + t[ 2 ] * q[ 0 ] - t[ 0 ] * q[ 2 ] );
+	dq[ 6 ] = 0.5f * ( q[ 3 ] * t[ 2 ] + t[ 0 ] * q[ 1 ] - t[ 1 ] * q[ 0 ] );
+	dq[ 7 ] = -0.5f * ( t[ 0 ] * q[ 0 ] + t[ 1 ] * q[ 1 ] + t[ 2 ] * q[ 2 ] );
+}
+
+void SkinningPalette::update( Skeleton *skeleton )
+{
+	crimild::Size jointCount = 0;
+	skeleton->getJoints().each( [ &jointCount ]( const std::string &, SharedPointer< Joint > const &joint ) {
+		jointCount = Numeric< crimild::Size >::max( jointCount, joint->getId() + 1 );
+	});
+
+	if ( jointCount != getJointCount() ) {
+		resize( jointCount );
+	}
+
+	skeleton->getJoints().each( [ this ]( const std::string &, SharedPointer< Joint > const &joint ) {
+		set( joint->getId(), joint->getPoseMatrix() );
+	});
+}
+
+void SkinningPalette::update( SkinnedMesh *mesh )
+{
+	const auto &poses = mesh->getAnimationState()->getJointPoses();
+	if ( poses.size() != getJointCount() ) {
+		resize( poses.size() );
+	}
+
+	for ( crimild::Size i = 0; i < poses.size(); i++ ) {
+		set( i, poses[ i ] );
+	}
+}
+
+namespace crimild {
+
+	namespace internal {
+
+		/**
+		   \brief Buffer layout shared by all kernels
+
+		   Offsets and strides are expressed in number of floats. Normal 
+		   offsets are negative if there are no normals.
+		 */
+		struct SkinningStreams {
+			const SkinningPalette *palette;
+
+			const crimild::Real32 *input;
+			crimild::Size inputStride;
+			crimild::Size positions;
+			crimild::Int32 normals;
+			crimild::Size boneIds;
+			crimild::Size boneWeights;
+			crimild::Size influences;
+
+			crimild::Real32 *output;
+			crimild::Size outputStride;
+			crimild::Size outputPositions;
+			crimild::Int32 outputNormals;
+		};
+
+		struct SkinnedBounds {
+			crimild::Real32 min[ 3 ];
+			crimild::Real32 max[ 3 ];
+
+			static SkinnedBounds empty( void )
+			{
+				const auto inf = std::numeric_limits< crimild::Real32 >::infinity();
+				return SkinnedBounds { { inf, inf, inf }, { -inf, -inf, -inf } };
+			}
+
+			static SkinnedBounds merge( SkinnedBounds const &a, SkinnedBounds const &b )
+			{
+				SkinnedBounds result;
+				for ( crimild::Size i = 0; i < 3; i++ ) {
+					result.min[ i ] = std::min( a.min[ i ], b.min[ i ] );
+					result.max[ i ] = std::max( a.max[ i ], b.max[ i ] );
+				}
+				return result;
+			}
+		};
+
+		using SkinningKernel = void (*)( const SkinningStreams &, crimild::Size, crimild::Size, SkinnedBounds & );
+
+		static const crimild::Size MAX_SKINNING_INFLUENCES = 4;
+
+		/**
+		   \brief Collects influences with non-zero weights
+		 */
+		inline crimild::Size gatherInfluences( const SkinningStreams &s, const crimild::Real32 *vertex, crimild::Size *joints, crimild::Real32 *weights )
+		{
+			const auto jointCount = static_cast< crimild::Real32 >( s.palette->getJointCount() );
+
+			crimild::Size count = 0;
+			for ( crimild::Size k = 0; k < s.influences; k++ ) {
+				const auto w = vertex[ s.boneWeights + k ];
+				const auto id = vertex[ s.boneIds + k ];
+				if ( w != 0.0f && id >= 0.0f && id < jointCount ) {
+					joints[ count ] = static_cast< crimild::Size >( id );
+					weights[ count ] = w;
+					++count;
+				}
+			}
+			return count;
+		}
+
+		inline void writeVertex( const SkinningStreams &s, crimild::Size v, const crimild::Real32 *p, const crimild::Real32 *n, SkinnedBounds &bounds )
+		{
+			auto out = s.output + v * s.outputStride;
+
+			auto position = out + s.outputPositions;
+			for ( crimild::Size i = 0; i < 3; i++ ) {
+				position[ i ] = p[ i ];
+				bounds.min[ i ] = std::min( bounds.min[ i ], p[ i ] );
+				bounds.max[ i ] = std::max( bounds.max[ i ], p[ i ] );
+			}
+
+			if ( n != nullptr && s.outputNormals >= 0 ) {
+				auto normal = out + s.outputNormals;
+				const auto lengthSquared = n[ 0 ] * n[ 0 ] + n[ 1 ] * n[ 1 ] + n[ 2 ] * n[ 2 ];
+				const auto invLength = lengthSquared > 0.0f ? 1.0f / std::sqrt( lengthSquared ) : 0.0f;
+				for ( crimild::Size i = 0; i < 3; i++ ) {
+					normal[ i ] = n[ i ] * invLength;
+				}
+			}
+		}
+
+		/*
+		   All kernels compute skinned positions as ( ( c0 * x + c1 * y ) + c2 * z ) + c3,
+		   where ci are the columns of the blended matrix, and blend joints in 
+		   the same order. Keep it that way, so kernels produce the same results.
+		 */
+
+		inline void transformScalar( const SkinningStreams &s, crimild::Size v, const crimild::Real32 *vertex, const crimild::Real32 *m, SkinnedBounds &bounds )
+		{
+			const auto position = vertex + s.positions;
+			crimild::Real32 p[ 3 ];
+			for ( crimild::Size r = 0; r < 3; r++ ) {
+				const auto row = m + 4 * r;
+				p[ r ] = row[ 0 ] * position[ 0 ] + row[ 1 ] * position[ 1 ] + row[ 2 ] * position[ 2 ] + row[ 3 ];
+			}
+
+			if ( s.normals < 0 ) {
+				writeVertex( s, v, p, nullptr, bounds );
+				return;
+			}
+
+			const auto normal = vertex + s.normals;
+			crimild::Real32 n[ 3 ];
+			for ( crimild::Size r = 0; r < 3; r++ ) {
+				const auto row = m + 4 * r;
+				n[ r ] = row[ 0 ] * normal[ 0 ] + row[ 1 ] * normal[ 1 ] + row[ 2 ] * normal[ 2 ];
+			}
+			writeVertex( s, v, p, n, bounds );
+		}
+
+		/**
+		   \brief Blends dual quaternions for a vertex, using the first joint as pivot
+
+		   Quaternions in the opposite hemisphere are negated, so blending
+		   follows the shortest path.
+		 */
+		inline void blendDualQuaternionsScalar( const SkinningStreams &s, const crimild::Size *joints, const crimild::Real32 *weights, crimild::Size count, crimild::Real32 *dq, crimild::Real32 &scale )
+		{
+			const auto dqs = s.palette->getDualQuaternions();
+			const auto scales = s.palette->getScales();
+			const auto pivot = dqs + 8 * joints[ 0 ];
+
+			for ( crimild::Size i = 0; i < 8; i++ ) {
+				dq[ i ] = 0.0f;
+			}
+			scale = 0.0f;
+
+			for ( crimild::Size k = 0; k < count; k++ ) {
+				const auto other = dqs + 8 * joints[ k ];
+				const auto dot = pivot[ 0 ] * other[ 0 ] + pivot[ 1 ] * other[ 1 ] + pivot[ 2 ] * other[ 2 ] + pivot[ 3 ] * other[ 3 ];
+				const auto w = dot < 0.0f ? -weights[ k ] : weights[ k ];
+				for ( crimild::Size i = 0; i < 8; i++ ) {
+					dq[ i ] += w * other[ i ];
+				}
+				scale += weights[ k ] * scales[ joints[ k ] ];
+			}
+		}
+
+		/**
+		   \brief Normalizes a blended dual quaternion and converts it into matrix rows
+		 */
+		inline void dualQuaternionToRows( const crimild::Real32 *dq, crimild::Real32 scale, crimild::Real32 *m )
+		{
+			const auto lengthSquared = dq[ 0 ] * dq[ 0 ] + dq[ 1 ] * dq[ 1 ] + dq[ 2 ] * dq[ 2 ] + dq[ 3 ] * dq[ 3 ];
+			if ( lengthSquared == 0.0f ) {
+				// no influences. Collapse vertices, like linear blending does
+				for ( crimild::Size i = 0; i < 12; i++ ) {
+					m[ i ] = 0.0f;
+				}
+				return;
+			}
+
+			const auto invLength = 1.0f / std::sqrt( lengthSquared );
+			const auto x = dq[ 0 ] * invLength;
+			const auto y = dq[ 1 ] * invLength;
+			const auto z = dq[ 2 ] * invLength;
+			const auto w = dq[ 3 ] * invLength;
+			const auto dx = dq[ 4 ] * invLength;
+			const auto dy = dq[ 5 ] * invLength;
+			const auto dz = dq[ 6 ] * invLength;
+			const auto dw = dq[ 7 ] * invLength;
+
+			// rotation, scaled
+			m[ 0 ] = scale * ( 1.0f - 2.0f * ( y * y + z * z ) );
+			m[ 1 ] = scale * ( 2.0f * ( x * y - w * z ) );
+			m[ 2 ] = scale * ( 2.0f * ( x * z + w * y ) );
+			m[ 4 ] = scale * ( 2.0f * ( x * y + w * z ) );
+			m[ 5 ] = scale * ( 1.0f - 2.0f * ( x * x + z * z ) );
+			m[ 6 ] = scale * ( 2.0f * ( y * z - w * x ) );
+			m[ 8 ] = scale * ( 2.0f * ( x * z - w * y ) );
+			m[ 9 ] = scale * ( 2.0f * ( y * z + w * x ) );
+			m[ 10 ] = scale * ( 1.0f - 2.0f * ( x * x + y * y ) );
+
+			// translation = 2 * dual * conjugate( real )
+			m[ 3 ] = 2.0f * ( w * dx - dw * x + y * dz - z * dy );
+			m[ 7 ] = 2.0f * ( w * dy - dw * y + z * dx - x * dz );
+			m[ 11 ] = 2.0f * ( w * dz - dw * z + x * dy - y * dx );
+		}
+
+		void copyVertices( const SkinningStreams &s, crimild::Size begin, crimild::Size end, SkinnedBounds &bounds )
+		{
+			for ( auto v = begin; v < end; v++ ) {
+				const auto vertex = s.input + v * s.inputStride;
+				writeVertex( s, v, vertex + s.positions, s.normals >= 0 ? vertex + s.normals : nullptr, bounds );
+			}
+		}
+
+		void skinLinearBlendScalar( const SkinningStreams &s, crimild::Size begin, crimild::Size end, SkinnedBounds &bounds )
+		{
+			const auto rows = s.palette->getRows();
+
+			crimild::Size joints[ MAX_SKINNING_INFLUENCES ];
+			crimild::Real32 weights[ MAX_SKINNING_INFLUENCES ];
+			crimild::Real32 m[ 12 ];
+
+			for ( auto v = begin; v < end; v++ ) {
+				const auto vertex = s.input + v * s.inputStride;
+				const auto count = gatherInfluences( s, vertex, joints, weights );
+
+				for ( crimild::Size i = 0; i < 12; i++ ) {
+					m[ i ] = 0.0f;
+				}
+
+				for ( crimild::Size k = 0; k < count; k++ ) {
+					const auto row = rows + 12 * joints[ k ];
+					for ( crimild::Size i = 0; i < 12; i++ ) {
+						m[ i ] += weights[ k ] * row[ i ];
+					}
+				}
+
+				transformScalar( s, v, vertex, m, bounds );
+			}
+		}
+
+		void skinDualQuaternionScalar( const SkinningStreams &s, crimild::Size begin, crimild::Size end, SkinnedBounds &bounds )
+		{
+			crimild::Size joints[ MAX_SKINNING_INFLUENCES ];
+			crimild::Real32 weights[ MAX_SKINNING_INFLUENCES ];
+			crimild::Real32 dq[ 8 ];
+			crimild::Real32 scale;
+			crimild::Real32 m[ 12 ];
+
+			for ( auto v = begin; v < end; v++ ) {
+				const auto vertex = s.input + v * s.inputStride;
+				const auto count = gatherInfluences( s, vertex, joints, weights );
+
+				if ( count > 0 ) {
+					blendDualQuaternionsScalar( s, joints, weights, count, dq, scale );
+				}
+				else {
+					for ( crimild::Size i = 0; i < 8; i++ ) {
+						dq[ i ] = 0.0f;
+					}
+					scale = 0.0f;
+				}
+
+				dualQuaternionToRows( dq, scale, m );
+				transformScalar( s, v, vertex, m, bounds );
+			}
+		}
+
+#if defined( CRIMILD_SIMD_SSE )
+
+		/**
+		   \brief Transforms a vertex using the rows of a blended matrix
+		 */
+		inline void transformSSE( const SkinningStreams &s, crimild::Size v, const crimild::Real32 *vertex, __m128 r0, __m128 r1, __m128 r2, SkinnedBounds &bounds )
+		{
+			// transpose, so columns can be scaled by each coordinate
+			auto r3 = _mm_setzero_ps();
+			_MM_TRANSPOSE4_PS( r0, r1, r2, r3 );
+
+			const auto position = vertex + s.positions;
+			auto p = _mm_add_ps( _mm_add_ps( _mm_add_ps( _mm_mul_ps( r0, _mm_set1_ps( position[ 0 ] ) ), _mm_mul_ps( r1, _mm_set1_ps( position[ 1 ] ) ) ), _mm_mul_ps( r2, _mm_set1_ps( position[ 2 ] ) ) ), r3 );
+
+			alignas( 16 ) crimild::Real32 p4[ 4 ];
+			_mm_store_ps( p4, p );
+
+			if ( s.normals < 0 ) {
+				writeVertex( s, v, p4, nullptr, bounds );
+				return;
+			}
+
+			const auto normal = vertex + s.normals;
+			auto n = _mm_add_ps( _mm_add_ps( _mm_mul_ps( r0, _mm_set1_ps( normal[ 0 ] ) ), _mm_mul_ps( r1, _mm_set1_ps( normal[ 1 ] ) ) ), _mm_mul_ps( r2, _mm_set1_ps( normal[ 2 ] ) ) );
+
+			alignas( 16 ) crimild::Real32 n4[ 4 ];
+			_mm_store_ps( n4, n );
+
+			writeVertex( s, v, p4, n4, bounds );
+		}
+
+		void skinLinearBlendSSE( const SkinningStreams &s, crimild::Size begin, crimild::Size end, SkinnedBounds &bounds )
+		{
+			const auto rows = s.palette->getRows();
+
+			crimild::Size joints[ MAX_SKINNING_INFLUENCES ];
+			crimild::Real32 weights[ MAX_SKINNING_INFLUENCES ];
+
+			for ( auto v = begin; v < end; v++ ) {
+				const auto vertex = s.input + v * s.inputStride;
+				const auto count = gatherInfluences( s, vertex, joints, weights );
+
+				auto r0 = _mm_setzero_ps();
+				auto r1 = _mm_setzero_ps();
+				auto r2 = _mm_setzero_ps();
+
+				for ( crimild::Size k = 0; k < count; k++ ) {
+					const auto row = rows + 12 * joints[ k ];
+					const auto w = _mm_set1_ps( weights[ k ] );
+					r0 = _mm_add_ps( r0, _mm_mul_ps( w, _mm_loadu_ps( row ) ) );
+					r1 = _mm_add_ps( r1, _mm_mul_ps( w, _mm_loadu_ps( row + 4 ) ) );
+					r2 = _mm_add_ps( r2, _mm_mul_ps( w, _mm_loadu_ps( row + 8 ) ) );
+				}
+
+				transformSSE( s, v, vertex, r0, r1, r2, bounds );
+			}
+		}
+
+		void skinDualQuaternionSSE( const SkinningStreams &s, crimild::Size begin, crimild::Size end, SkinnedBounds &bounds )
+		{
+			const auto dqs = s.palette->getDualQuaternions();
+			const auto scales = s.palette->getScales();
+
+			crimild::Size joints[ MAX_SKINNING_INFLUENCES ];
+			crimild::Real32 weights[ MAX_SKINNING_INFLUENCES ];
+			alignas( 16 ) crimild::Real32 dq[ 8 ];
+			alignas( 16 ) crimild::Real32 m[ 12 ];
+
+			for ( auto v = begin; v < end; v++ ) {
+				const auto vertex = s.input + v * s.inputStride;
+				const auto count = gatherInfluences( s, vertex, joints, weights );
+
+				auto real = _mm_setzero_ps();
+				auto dual = _mm_setzero_ps();
+				crimild::Real32 scale = 0.0f;
+
+				if ( count > 0 ) {
+					const auto pivot = dqs + 8 * joints[ 0 ];
+					for ( crimild::Size k = 0; k < count; k++ ) {
+						const auto other = dqs + 8 * joints[ k ];
+						const auto dot = pivot[ 0 ] * other[ 0 ] + pivot[ 1 ] * other[ 1 ] + pivot[ 2 ] * other[ 2 ] + pivot[ 3 ] * other[ 3 ];
+						const auto w = _mm_set1_ps( dot < 0.0f ? -weights[ k ] : weights[ k ] );
+						real = _mm_add_ps( real, _mm_mul_ps( w, _mm_loadu_ps( other ) ) );
+						dual = _mm_add_ps( dual, _mm_mul_ps( w, _mm_loadu_ps( other + 4 ) ) );
+						scale += weights[ k ] * scales[ joints[ k ] ];
+					}
+				}
+
+				_mm_store_ps( dq, real );
+				_mm_store_ps( dq + 4, dual );
+				dualQuaternionToRows( dq, scale, m );
+
+				transformSSE( s, v, vertex, _mm_load_ps( m ), _mm_load_ps( m + 4 ), _mm_load_ps( m + 8 ), bounds );
+			}
+		}
+
+#endif
+
+#if defined( CRIMILD_SIMD_AVX )
+
+		/**
+		   \brief Loads two groups of four values into the lower and upper lanes
+		 */
+		inline __m256 loadPairAVX( const crimild::Real32 *a, const crimild::Real32 *b )
+		{
+			return _mm256_insertf128_ps( _mm256_castps128_ps256( _mm_loadu_ps( a ) ), _mm_loadu_ps( b ), 1 );
+		}
+
+		inline __m256 broadcastPairAVX( crimild::Real32 a, crimild::Real32 b )
+		{
+			return _mm256_insertf128_ps( _mm256_castps128_ps256( _mm_set1_ps( a ) ), _mm_set1_ps( b ), 1 );
+		}
+
+		/**
+		   \brief Skins two vertices at a time, one per 128-bit lane
+		 */
+		void skinLinearBlendAVX( const SkinningStreams &s, crimild::Size begin, crimild::Size end, SkinnedBounds &bounds )
+		{
+			const auto rows = s.palette->getRows();
+
+			crimild::Size jointsA[ MAX_SKINNING_INFLUENCES ];
+			crimild::Real32 weightsA[ MAX_SKINNING_INFLUENCES ];
+			crimild::Size jointsB[ MAX_SKINNING_INFLUENCES ];
+			crimild::Real32 weightsB[ MAX_SKINNING_INFLUENCES ];
+			alignas( 32 ) crimild::Real32 p8[ 8 ];
+			alignas( 32 ) crimild::Real32 n8[ 8 ];
+
+			auto v = begin;
+			for ( ; v + 2 <= end; v += 2 ) {
+				const auto vertexA = s.input + v * s.inputStride;
+				const auto vertexB = vertexA + s.inputStride;
+				const auto countA = gatherInfluences( s, vertexA, jointsA, weightsA );
+				const auto countB = gatherInfluences( s, vertexB, jointsB, weightsB );
+				const auto count = Numeric< crimild::Size >::max( countA, countB );
+
+				auto r0 = _mm256_setzero_ps();
+				auto r1 = _mm256_setzero_ps();
+				auto r2 = _mm256_setzero_ps();
+
+				for ( crimild::Size k = 0; k < count; k++ ) {
+					// missing influences are blended with zero weight
+					const auto rowA = rows + ( k < countA ? 12 * jointsA[ k ] : 0 );
+					const auto rowB = rows + ( k < countB ? 12 * jointsB[ k ] : 0 );
+					const auto w = broadcastPairAVX( k < countA ? weightsA[ k ] : 0.0f, k < countB ? weightsB[ k ] : 0.0f );
+					r0 = _mm256_add_ps( r0, _mm256_mul_ps( w, loadPairAVX( rowA, rowB ) ) );
+					r1 = _mm256_add_ps( r1, _mm256_mul_ps( w, loadPairAVX( rowA + 4, rowB + 4 ) ) );
+					r2 = _mm256_add_ps( r2, _mm256_mul_ps( w, loadPairAVX( rowA + 8, rowB + 8 ) ) );
+				}
+
+				// transpose each lane
+				const auto r3 = _mm256_setzero_ps();
+				const auto t0 = _mm256_unpacklo_ps( r0, r1 );
+				const auto t1 = _mm256_unpacklo_ps( r2, r3 );
+				const auto t2 = _mm256_unpackhi_ps( r0, r1 );
+				const auto t3 = _mm256_unpackhi_ps( r2, r3 );
+				const auto c0 = _mm256_shuffle_ps( t0, t1, _MM_SHUFFLE( 1, 0, 1, 0 ) );
+				const auto c1 = _mm256_shuffle_ps( t0, t1, _MM_SHUFFLE( 3, 2, 3, 2 ) );
+				const auto c2 = _mm256_shuffle_ps( t2, t3, _MM_SHUFFLE( 1, 0, 1, 0 ) );
+				const auto c3 = _mm256_shuffle_ps( t2, t3, _MM_SHUFFLE( 3, 2, 3, 2 ) );
+
+				const auto positionA = vertexA + s.positions;
+				const auto positionB = vertexB + s.positions;
+				auto p = _mm256_add_ps( _mm256_mul_ps( c0, broadcastPairAVX( positionA[ 0 ], positionB[ 0 ] ) ), _mm256_mul_ps( c1, broadcastPairAVX( positionA[ 1 ], positionB[ 1 ] ) ) );
+				p = _mm256_add_ps( _mm256_add_ps( p, _mm256_mul_ps( c2, broadcastPairAVX( positionA[ 2 ], positionB[ 2 ] ) ) ), c3 );
+				_mm256_store_ps( p8, p );
+
+				if ( s.normals < 0 ) {
+					writeVertex( s, v, p8, nullptr, bounds );
+					writeVertex( s, v + 1, p8 + 4, nullptr, bounds );
+					continue;
+				}
+
+				const auto normalA = vertexA + s.normals;
+				const auto normalB = vertexB + s.normals;
+				auto n = _mm256_add_ps( _mm256_mul_ps( c0, broadcastPairAVX( normalA[ 0 ], normalB[ 0 ] ) ), _mm256_mul_ps( c1, broadcastPairAVX( normalA[ 1 ], normalB[ 1 ] ) ) );
+				n = _mm256_add_ps( n, _mm256_mul_ps( c2, broadcastPairAVX( normalA[ 2 ], normalB[ 2 ] ) ) );
+				_mm256_store_ps( n8, n );
+
+				writeVertex( s, v, p8, n8, bounds );
+				writeVertex( s, v + 1, p8 + 4, n8 + 4, bounds );
+			}
+
+			// remaining vertex, if any
+			skinLinearBlendScalar( s, v, end, bounds );
+		}
+
+		/**
+		   \brief Blends real and dual parts at once
+		 */
+		void skinDualQuaternionAVX( const SkinningStreams &s, crimild::Size begin, crimild::Size end, SkinnedBounds &bounds )
+		{
+			const auto dqs = s.palette->getDualQuaternions();
+			const auto scales = s.palette->getScales();
+
+			crimild::Size joints[ MAX_SKINNING_INFLUENCES ];
+			crimild::Real32 weights[ MAX_SKINNING_INFLUENCES ];
+			alignas( 32 ) crimild::Real32 dq[ 8 ];
+			alignas( 16 ) crimild::Real32 m[ 12 ];
+
+			for ( auto v = begin; v < end; v++ ) {
+				const auto vertex = s.input + v * s.inputStride;
+				const auto count = gatherInfluences( s, vertex, joints, weights );
+
+				auto blended = _mm256_setzero_ps();
+				crimild::Real32 scale = 0.0f;
+
+				if ( count > 0 ) {
+					const auto pivot = dqs + 8 * joints[ 0 ];
+					for ( crimild::Size k = 0; k < count; k++ ) {
+						const auto other = dqs + 8 * joints[ k ];
+						const auto dot = pivot[ 0 ] * other[ 0 ] + pivot[ 1 ] * other[ 1 ] + pivot[ 2 ] * other[ 2 ] + pivot[ 3 ] * other[ 3 ];
+						const auto w = _mm256_set1_ps( dot < 0.0f ? -weights[ k ] : weights[ k ] );
+						blended = _mm256_add_ps( blended, _mm256_mul_ps( w, _mm256_loadu_ps( other ) ) );
+						scale += weights[ k ] * scales[ joints[ k ] ];
+					}
+				}
+
+				_mm256_store_ps( dq, blended );
+				dualQuaternionToRows( dq, scale, m );
+
+				transformSSE( s, v, vertex, _mm_load_ps( m ), _mm_load_ps( m + 4 ), _mm_load_ps( m + 8 ), bounds );
+			}
+		}
+
+#endif
+
+		static SkinningKernel selectSkinningKernel( SkinningEngine::Method method, SkinningEngine::Kernel kernel )
+		{
+			const auto dualQuaternion = method == SkinningEngine::Method::DUAL_QUATERNION;
+
+			switch ( kernel ) {
+#if defined( CRIMILD_SIMD_AVX )
+				case SkinningEngine::Kernel::AVX:
+					return dualQuaternion ? skinDualQuaternionAVX : skinLinearBlendAVX;
+#endif
+
+#if defined( CRIMILD_SIMD_SSE )
+				case SkinningEngine::Kernel::SSE:
+					return dualQuaternion ? skinDualQuaternionSSE : skinLinearBlendSSE;
+#endif
+
+				case SkinningEngine::Kernel::SCALAR:
+					return dualQuaternion ? skinDualQuaternionScalar : skinLinearBlendScalar;
+
+				default:
+					// not supported by this build
+					return selectSkinningKernel( method, SkinningEngine::getDefaultKernel() );
+			}
+		}
+
+	}
+
+}
+
+SkinningEngine::Kernel SkinningEngine::getDefaultKernel( void )
+{
+#if defined( CRIMILD_SIMD_AVX )
+	return Kernel::AVX;
+#elif defined( CRIMILD_SIMD_SSE )
+	return Kernel::SSE;
+#else
+	return Kernel::SCALAR;
+#endif
+}
+
+const char *SkinningEngine::getKernelName( Kernel kernel )
+{
+	switch ( kernel ) {
+		case Kernel::AVX:
+			return "AVX";
+		case Kernel::SSE:
+			return "SSE";
+		default:
+			return "Scalar";
+	}
+}
+
+SharedPointer< VertexBufferObject > SkinningEngine::createOutputBuffer( const VertexBufferObject *input )
+{
+	const auto &format = input->getVertexFormat();
+	return crimild::alloc< VertexBufferObject >( format.hasNormals() ? VertexFormat::VF_P3_N3 : VertexFormat::VF_P3, input->getVertexCount() );
+}
+
+SkinningEngine::SkinningEngine( void )
+	: _kernel( getDefaultKernel() )
+{
+
+}
+
+SkinningEngine::~SkinningEngine( void )
+{
+
+}
+
+crimild::Bool SkinningEngine::skin( const SkinningPalette &palette, const VertexBufferObject *input, VertexBufferObject *output )
+{
+	if ( input == nullptr || output == nullptr || output->getVertexCount() < input->getVertexCount() ) {
+		Log::warning( CRIMILD_CURRENT_CLASS_NAME, "Invalid buffers for skinning" );
+		return false;
+	}
+
+	const auto &inputFormat = input->getVertexFormat();
+	const auto &outputFormat = output->getVertexFormat();
+	if ( inputFormat.getPositionComponents() != 3 || outputFormat.getPositionComponents() != 3 ) {
+		Log::warning( CRIMILD_CURRENT_CLASS_NAME, "Skinning requires 3D positions" );
+		return false;
+	}
+
+	internal::SkinningStreams s;
+	s.palette = &palette;
+	s.input = input->getData();
+	s.inputStride = inputFormat.getVertexSize();
+	s.positions = inputFormat.getPositionsOffset();
+	s.normals = inputFormat.getNormalComponents() == 3 ? inputFormat.getNormalsOffset() : -1;
+	s.boneIds = inputFormat.getBoneIdsOffset();
+	s.boneWeights = inputFormat.getBoneWeightsOffset();
+	s.influences = Numeric< crimild::Size >::min( internal::MAX_SKINNING_INFLUENCES, Numeric< crimild::Size >::min( inputFormat.getBoneIdComponents(), inputFormat.getBoneWeightComponents() ) );
+	s.output = output->data();
+	s.outputStride = outputFormat.getVertexSize();
+	s.outputPositions = outputFormat.getPositionsOffset();
+	s.outputNormals = outputFormat.getNormalComponents() == 3 ? outputFormat.getNormalsOffset() : -1;
+
+	auto kernel = internal::selectSkinningKernel( _method, _kernel );
+	if ( s.influences == 0 || palette.getJointCount() == 0 ) {
+		kernel = internal::copyVertices;
+	}
+
+	auto skinRange = [ &s, kernel ]( concurrency::Range const &range ) {
+		auto bounds = internal::SkinnedBounds::empty();
+		kernel( s, range.begin, range.end, bounds );
+		return bounds;
+	};
+
+	const auto vertexCount = input->getVertexCount();
+	const concurrency::Range vertices( 0, vertexCount );
+
+	auto bounds = concurrency::parallel_reduce( vertices, _grainSize, internal::SkinnedBounds::empty(), skinRange, internal::SkinnedBounds::merge );
+
+	if ( vertexCount > 0 ) {
+		_boundsMin = Vector3f( bounds.min[ 0 ], bounds.min[ 1 ], bounds.min[ 2 ] );
+		_boundsMax = Vector3f( bounds.max[ 0 ], bounds.max[ 1 ], bounds.max[ 2 ] );
+	}
+	else {
+		_boundsMin = Vector3f::ZERO;
+		_boundsMax = Vector3f::ZERO;
+	}
+
+	return true;
+}
@@ -0,0 +1,205 @@
+/*
+ * Copyright (c) 2013, Hernan Saez
+ * All rights reserved.
+ * 
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *     * Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in the
+ *       documentation and/or other materials provided with the distribution.
+ *     * Neither the name of the <organization> nor the
+ *       names of its contributors may be used to endorse or promote products
+ *       derived from this software without specific prior written permission.
+ * 
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL <COPYRIGHT HOLDER> BE LIABLE FOR ANY
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef CRIMILD_ANIMATION_SKINNING_ENGINE_
+#define CRIMILD_ANIMATION_SKINNING_ENGINE_
+
+#include "Foundation/Types.hpp"
+#include "Foundation/Memory.hpp"
+#include "Mathematics/Matrix.hpp"
+#include "Mathematics/Vector.hpp"
+
+#include <vector>
+
+namespace crimild {
+
+	class VertexBufferObject;
+	class SkinnedMesh;
+
+	namespace animation {
+
+		class Skeleton;
+
+		/**
+		   \brief Joint transformations packed for CPU skinning
+
+		   Joints are indexed by Joint::getId(), which is the value stored in 
+		   the bone id attribute of skinned vertices (same as the uniforms 
+		   used by the GPU path). Each joint is stored both as the first three
+		   rows of its pose matrix and as a unit dual quaternion plus a 
+		   uniform scale.
+		 */
+		class SkinningPalette {
+		public:
+			SkinningPalette( void );
+			~SkinningPalette( void );
+
+			/**
+			   \brief Resizes the palette. All joints are reset to identity
+			 */
+			void resize( crimild::Size jointCount );
+
+			crimild::Size getJointCount( void ) const { return _scales.size(); }
+
+			/**
+			   \brief Sets a joint's transformation
+
+			   Pose matrices are expected to be affine with uniform scale 
+			   (see Transformation::computeModelMatrix())
+			 */
+			void set( crimild::Size jointId, const Matrix4f &poseMatrix );
+
+			/**
+			   \brief Collects the pose matrices for all joints in a skeleton
+			 */
+			void update( Skeleton *skeleton );
+
+			/**
+			   \brief Collects the joint poses for a legacy skinned mesh
+			 */
+			void update( SkinnedMesh *mesh );
+
+			/**
+			   \brief Pose matrix rows, 12 values per joint
+			 */
+			const crimild::Real32 *getRows( void ) const { return _rows.data(); }
+
+			/**
+			   \brief Dual quaternions stored as ( real.xyzw, dual.xyzw ), 8 values per joint
+			 */
+			const crimild::Real32 *getDualQuaternions( void ) const { return _dualQuaternions.data(); }
+
+			const crimild::Real32 *getScales( void ) const { return _scales.data(); }
+
+		private:
+			std::vector< crimild::Real32 > _rows;
+			std::vector< crimild::Real32 > _dualQuaternions;
+			std::vector< crimild::Real32 > _scales;
+		};
+
+		/**
+		   \brief Skins vertices on the CPU
+
+		   Reads positions, normals, bone ids and bone weights from a vertex
+		   buffer and writes skinned positions and normals into a separate one
+		   (see createOutputBuffer()), which can then be used for hit-tests
+		   or exports without a GPU. Skinned vertices are in world space, 
+		   just like the ones computed by the standard shader program.
+
+		   Vertices are processed in chunks of at most getGrainSize() elements,
+		   in parallel if the job scheduler is running. A tight bounding box
+		   is computed while skinning.
+
+		   Depending on the instruction sets available at compile time (see
+		   Simd.hpp), joint transformations are blended using SSE or AVX. 
+		   Results for different kernels are the same, up to rounding errors.
+		 */
+		class SkinningEngine {
+		public:
+			enum class Kernel {
+				SCALAR,
+				SSE,
+				AVX,
+			};
+
+			/**
+			   \brief The widest kernel supported by this build
+			 */
+			static Kernel getDefaultKernel( void );
+
+			static const char *getKernelName( Kernel kernel );
+
+			enum class Method {
+				/**
+				   \brief Blends pose matrices. Same as the GPU path
+				 */
+				LINEAR_BLEND,
+
+				/**
+				   \brief Blends dual quaternions, which preserves volume around joints
+				 */
+				DUAL_QUATERNION,
+			};
+
+			/**
+			   \brief Creates a buffer for storing skinned positions (and normals, if any)
+			 */
+			static SharedPointer< VertexBufferObject > createOutputBuffer( const VertexBufferObject *input );
+
+		public:
+			SkinningEngine( void );
+			~SkinningEngine( void );
+
+			void setMethod( Method method ) { _method = method; }
+			Method getMethod( void ) const { return _method; }
+
+			/**
+			   \brief Sets the requested kernel. If not supported, the default one is used instead
+			 */
+			void setKernel( Kernel kernel ) { _kernel = kernel; }
+			Kernel getKernel( void ) const { return _kernel; }
+
+			void setGrainSize( crimild::Size grainSize ) { _grainSize = grainSize; }
+			crimild::Size getGrainSize( void ) const { return _grainSize; }
+
+			/**
+			   \brief Skins all vertices in the input buffer
+
+			   Vertices without bone ids or weights are copied unchanged. Bone 
+			   ids not included in the palette are ignored.
+
+			   \param output A buffer with at least as many vertices as the input 
+			   one (see createOutputBuffer())
+			   \returns false if buffers are not compatible
+			 */
+			crimild::Bool skin( const SkinningPalette &palette, const VertexBufferObject *input, VertexBufferObject *output );
+
+			/**
+			   \name Skinned bounds
+
+			   Computed by the last call to skin()
+			 */
+			//@{
+
+			const Vector3f &getBoundsMin( void ) const { return _boundsMin; }
+			const Vector3f &getBoundsMax( void ) const { return _boundsMax; }
+
+			//@}
+
+		private:
+			Method _method = Method::LINEAR_BLEND;
+			Kernel _kernel;
+			crimild::Size _grainSize = 1024;
+			Vector3f _boundsMin;
+			Vector3f _boundsMax;
+		};
+
+	}
+
+}
+
+#endif
@@ -0,0 +1,445 @@
+/*
+ * Copyright (c) 2013, Hernan Saez
+ * All rights reserved.
+ * 
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *     * Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in the
+ *       documentation and/or other materials provided with the distribution.
+ *     * Neither the name of the <organization> nor the
+ *       names of its contributors may be used to endorse or promote products
+ *       derived from this software without specific prior written permission.
+ * 
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL <COPYRIGHT HOLDER> BE LIABLE FOR ANY
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "BatchCulling.hpp"
+#include "PlaneBoundingVolume.hpp"
+
+#include "Mathematics/Simd.hpp"
+
+#include <cmath>
+#include <limits>
+
+using namespace crimild;
+
+void SphereBatch::clear( void )
+{
+	_centerX.clear();
+	_centerY.clear();
+	_centerZ.clear();
+	_radius.clear();
+}
+
+void SphereBatch::reserve( crimild::Size count )
+{
+	_centerX.reserve( count );
+	_centerY.reserve( count );
+	_centerZ.reserve( count );
+	_radius.reserve( count );
+}
+
+void SphereBatch::push( const Vector3f &center, crimild::Real32 radius )
+{
+	_centerX.push_back( center[ 0 ] );
+	_centerY.push_back( center[ 1 ] );
+	_centerZ.push_back( center[ 2 ] );
+	_radius.push_back( radius );
+}
+
+void SphereBatch::push( const BoundingVolume *volume )
+{
+	auto radius = volume->getRadius();
+
+	// only planes have a zero radius, so avoid casting every volume
+	if ( radius == 0.0f && dynamic_cast< const PlaneBoundingVolume * >( volume ) != nullptr ) {
+		radius = std::numeric_limits< crimild::Real32 >::infinity();
+	}
+
+	push( volume->getCenter(), radius );
+}
+
+void BoxBatch::clear( void )
+{
+	_centerX.clear();
+	_centerY.clear();
+	_centerZ.clear();
+	_extentX.clear();
+	_extentY.clear();
+	_extentZ.clear();
+}
+
+void BoxBatch::reserve( crimild::Size count )
+{
+	_centerX.reserve( count );
+	_centerY.reserve( count );
+	_centerZ.reserve( count );
+	_extentX.reserve( count );
+	_extentY.reserve( count );
+	_extentZ.reserve( count );
+}
+
+void BoxBatch::push( const Vector3f &min, const Vector3f &max )
+{
+	_centerX.push_back( 0.5f * ( min[ 0 ] + max[ 0 ] ) );
+	_centerY.push_back( 0.5f * ( min[ 1 ] + max[ 1 ] ) );
+	_centerZ.push_back( 0.5f * ( min[ 2 ] + max[ 2 ] ) );
+	_extentX.push_back( 0.5f * ( max[ 0 ] - min[ 0 ] ) );
+	_extentY.push_back( 0.5f * ( max[ 1 ] - min[ 1 ] ) );
+	_extentZ.push_back( 0.5f * ( max[ 2 ] - min[ 2 ] ) );
+}
+
+namespace crimild {
+
+	namespace internal {
+
+		/*
+		   All kernels compute distances as ( ( nx * x + ny * y ) + nz * z ) + d, 
+		   which is the same order used by Distance::compute(), and compare them 
+		   against the negated radius. Keep it that way, or results will differ
+		   between kernels (that also means multiplications and additions must
+		   not be contracted into FMA instructions).
+		 */
+
+		void cullSpheresScalar( const SphereBatch &spheres, crimild::Size begin, const Plane3f *planes, crimild::Size planeCount, crimild::UInt8 *visible )
+		{
+			const auto x = spheres.getCenterX();
+			const auto y = spheres.getCenterY();
+			const auto z = spheres.getCenterZ();
+			const auto r = spheres.getRadius();
+
+			for ( crimild::Size i = begin; i < spheres.getCount(); i++ ) {
+				crimild::UInt8 result = 1;
+				for ( crimild::Size p = 0; p < planeCount; p++ ) {
+					const auto &n = planes[ p ].getNormal();
+					crimild::Real32 d = n[ 0 ] * x[ i ] + n[ 1 ] * y[ i ] + n[ 2 ] * z[ i ] + planes[ p ].getConstant();
+					if ( d < -r[ i ] ) {
+						result = 0;
+						break;
+					}
+				}
+				visible[ i ] = result;
+			}
+		}
+
+		void cullBoxesScalar( const BoxBatch &boxes, crimild::Size begin, const Plane3f *planes, crimild::Size planeCount, crimild::UInt8 *visible )
+		{
+			const auto x = boxes.getCenterX();
+			const auto y = boxes.getCenterY();
+			const auto z = boxes.getCenterZ();
+			const auto ex = boxes.getExtentX();
+			const auto ey = boxes.getExtentY();
+			const auto ez = boxes.getExtentZ();
+
+			for ( crimild::Size i = begin; i < boxes.getCount(); i++ ) {
+				crimild::UInt8 result = 1;
+				for ( crimild::Size p = 0; p < planeCount; p++ ) {
+					const auto &n = planes[ p ].getNormal();
+					crimild::Real32 r = ex[ i ] * std::fabs( n[ 0 ] ) + ey[ i ] * std::fabs( n[ 1 ] ) + ez[ i ] * std::fabs( n[ 2 ] );
+					crimild::Real32 d = n[ 0 ] * x[ i ] + n[ 1 ] * y[ i ] + n[ 2 ] * z[ i ] + planes[ p ].getConstant();
+					if ( d < -r ) {
+						result = 0;
+						break;
+					}
+				}
+				visible[ i ] = result;
+			}
+		}
+
+		/**
+		   \brief Plane coefficients, packed as ( nx, ny, nz, d, |nx|, |ny|, |nz| )
+
+		   SIMD kernels broadcast them to all lanes while iterating. Registers
+		   are not stored in containers, since over-aligned types are not
+		   supported by std::allocator.
+		 */
+		void packPlanes( const Plane3f *planes, crimild::Size planeCount, std::vector< crimild::Real32 > &result )
+		{
+			result.resize( 7 * planeCount );
+			for ( crimild::Size p = 0; p < planeCount; p++ ) {
+				const auto &n = planes[ p ].getNormal();
+				auto coeffs = &result[ 7 * p ];
+				coeffs[ 0 ] = n[ 0 ];
+				coeffs[ 1 ] = n[ 1 ];
+				coeffs[ 2 ] = n[ 2 ];
+				coeffs[ 3 ] = planes[ p ].getConstant();
+				coeffs[ 4 ] = std::fabs( n[ 0 ] );
+				coeffs[ 5 ] = std::fabs( n[ 1 ] );
+				coeffs[ 6 ] = std::fabs( n[ 2 ] );
+			}
+		}
+
+#if defined( CRIMILD_SIMD_SSE )
+
+		inline __m128 distanceSSE( const crimild::Real32 *plane, __m128 x, __m128 y, __m128 z )
+		{
+			auto nx = _mm_set1_ps( plane[ 0 ] );
+			auto ny = _mm_set1_ps( plane[ 1 ] );
+			auto nz = _mm_set1_ps( plane[ 2 ] );
+			auto d = _mm_set1_ps( plane[ 3 ] );
+			return _mm_add_ps( _mm_add_ps( _mm_add_ps( _mm_mul_ps( nx, x ), _mm_mul_ps( ny, y ) ), _mm_mul_ps( nz, z ) ), d );
+		}
+
+		inline void storeVisibleSSE( int culledMask, crimild::UInt8 *visible )
+		{
+			for ( int j = 0; j < 4; j++ ) {
+				visible[ j ] = ( culledMask & ( 1 << j ) ) ? 0 : 1;
+			}
+		}
+
+		crimild::Size cullSpheresSSE( const SphereBatch &spheres, const Plane3f *planes, crimild::Size planeCount, crimild::UInt8 *visible )
+		{
+			std::vector< crimild::Real32 > ps;
+			packPlanes( planes, planeCount, ps );
+
+			const auto zero = _mm_setzero_ps();
+			const auto count = spheres.getCount();
+
+			crimild::Size i = 0;
+			for ( ; i + 4 <= count; i += 4 ) {
+				auto x = _mm_loadu_ps( spheres.getCenterX() + i );
+				auto y = _mm_loadu_ps( spheres.getCenterY() + i );
+				auto z = _mm_loadu_ps( spheres.getCenterZ() + i );
+				auto negR = _mm_sub_ps( zero, _mm_loadu_ps( spheres.getRadius() + i ) );
+
+				auto culled = zero;
+				for ( crimild::Size p = 0; p < planeCount; p++ ) {
+					culled = _mm_or_ps( culled, _mm_cmplt_ps( distanceSSE( &ps[ 7 * p ], x, y, z ), negR ) );
+					if ( _mm_movemask_ps( culled ) == 0xF ) {
+						break;
+					}
+				}
+
+				storeVisibleSSE( _mm_movemask_ps( culled ), visible + i );
+			}
+
+			return i;
+		}
+
+		crimild::Size cullBoxesSSE( const BoxBatch &boxes, const Plane3f *planes, crimild::Size planeCount, crimild::UInt8 *visible )
+		{
+			std::vector< crimild::Real32 > ps;
+			packPlanes( planes, planeCount, ps );
+
+			const auto zero = _mm_setzero_ps();
+			const auto count = boxes.getCount();
+
+			crimild::Size i = 0;
+			for ( ; i + 4 <= count; i += 4 ) {
+				auto x = _mm_loadu_ps( boxes.getCenterX() + i );
+				auto y = _mm_loadu_ps( boxes.getCenterY() + i );
+				auto z = _mm_loadu_ps( boxes.getCenterZ() + i );
+				auto ex = _mm_loadu_ps( boxes.getExtentX() + i );
+				auto ey = _mm_loadu_ps( boxes.getExtentY() + i );
+				auto ez = _mm_loadu_ps( boxes.getExtentZ() + i );
+
+				auto culled = zero;
+				for ( crimild::Size p = 0; p < planeCount; p++ ) {
+					auto plane = &ps[ 7 * p ];
+					auto absX = _mm_set1_ps( plane[ 4 ] );
+					auto absY = _mm_set1_ps( plane[ 5 ] );
+					auto absZ = _mm_set1_ps( plane[ 6 ] );
+					auto r = _mm_add_ps( _mm_add_ps( _mm_mul_ps( ex, absX ), _mm_mul_ps( ey, absY ) ), _mm_mul_ps( ez, absZ ) );
+					culled = _mm_or_ps( culled, _mm_cmplt_ps( distanceSSE( plane, x, y, z ), _mm_sub_ps( zero, r ) ) );
+					if ( _mm_movemask_ps( culled ) == 0xF ) {
+						break;
+					}
+				}
+
+				storeVisibleSSE( _mm_movemask_ps( culled ), visible + i );
+			}
+
+			return i;
+		}
+
+#endif
+
+#if defined( CRIMILD_SIMD_AVX )
+
+		inline __m256 distanceAVX( const crimild::Real32 *plane, __m256 x, __m256 y, __m256 z )
+		{
+			auto nx = _mm256_set1_ps( plane[ 0 ] );
+			auto ny = _mm256_set1_ps( plane[ 1 ] );
+			auto nz = _mm256_set1_ps( plane[ 2 ] );
+			auto d = _mm256_set1_ps( plane[ 3 ] );
+			return _mm256_add_ps( _mm256_add_ps( _mm256_add_ps( _mm256_mul_ps( nx, x ), _mm256_mul_ps( ny, y ) ), _mm256_mul_ps( nz, z ) ), d );
+		}
+
+		inline void storeVisibleAVX( int culledMask, crimild::UInt8 *visible )
+		{
+			for ( int j = 0; j < 8; j++ ) {
+				visible[ j ] = ( culledMask & ( 1 << j ) ) ? 0 : 1;
+			}
+		}
+
+		crimild::Size cullSpheresAVX( const SphereBatch &spheres, const Plane3f *planes, crimild::Size planeCount, crimild::UInt8 *visible )
+		{
+			std::vector< crimild::Real32 > ps;
+			packPlanes( planes, planeCount, ps );
+
+			const auto zero = _mm256_setzero_ps();
+			const auto count = spheres.getCount();
+
+			crimild::Size i = 0;
+			for ( ; i + 8 <= count; i += 8 ) {
+				auto x = _mm256_loadu_ps( spheres.getCenterX() + i );
+				auto y = _mm256_loadu_ps( spheres.getCenterY() + i );
+				auto z = _mm256_loadu_ps( spheres.getCenterZ() + i );
+				auto negR = _mm256_sub_ps( zero, _mm256_loadu_ps( spheres.getRadius() + i ) );
+
+				auto culled = zero;
+				for ( crimild::Size p = 0; p < planeCount; p++ ) {
+					culled = _mm256_or_ps( culled, _mm256_cmp_ps( distanceAVX( &ps[ 7 * p ], x, y, z ), negR, _CMP_LT_OQ ) );
+					if ( _mm256_movemask_ps( culled ) == 0xFF ) {
+						break;
+					}
+				}
+
+				storeVisibleAVX( _mm256_movemask_ps( culled ), visible + i );
+			}
+
+			return i;
+		}
+
+		crimild::Size cullBoxesAVX( const BoxBatch &boxes, const Plane3f *planes, crimild::Size planeCount, crimild::UInt8 *visible )
+		{
+			std::vector< crimild::Real32 > ps;
+			packPlanes( planes, planeCount, ps );
+
+			const auto zero = _mm256_setzero_ps();
+			const auto count = boxes.getCount();
+
+			crimild::Size i = 0;
+			for ( ; i + 8 <= count; i += 8 ) {
+				auto x = _mm256_loadu_ps( boxes.getCenterX() + i );
+				auto y = _mm256_loadu_ps( boxes.getCenterY() + i );
+				auto z = _mm256_loadu_ps( boxes.getCenterZ() + i );
+				auto ex = _mm256_loadu_ps( boxes.getExtentX() + i );
+				auto ey = _mm256_loadu_ps( boxes.getExtentY() + i );
+				auto ez = _mm256_loadu_ps( boxes.getExtentZ() + i );
+
+				auto culled = zero;
+				for ( crimild::Size p = 0; p < planeCount; p++ ) {
+					auto plane = &ps[ 7 * p ];
+					auto absX = _mm256_set1_ps( plane[ 4 ] );
+					auto absY = _mm256_set1_ps( plane[ 5 ] );
+					auto absZ = _mm256_set1_ps( plane[ 6 ] );
+					auto r = _mm256_add_ps( _mm256_add_ps( _mm256_mul_ps( ex, absX ), _mm256_mul_ps( ey, absY ) ), _mm256_mul_ps( ez, absZ ) );
+					culled = _mm256_or_ps( culled, _mm256_cmp_ps( distanceAVX( plane, x, y, z ), _mm256_sub_ps( zero, r ), _CMP_LT_OQ ) );
+					if ( _mm256_movemask_ps( culled ) == 0xFF ) {
+						break;
+					}
+				}
+
+				storeVisibleAVX( _mm256_movemask_ps( culled ), visible + i );
+			}
+
+			return i;
+		}
+
+#endif
+
+	}
+
+}
+
+BatchCulling::Kernel BatchCulling::getDefaultKernel( void )
+{
+#if defined( CRIMILD_SIMD_AVX )
+	return Kernel::AVX;
+#elif defined( CRIMILD_SIMD_SSE )
+	return Kernel::SSE;
+#else
+	return Kernel::SCALAR;
+#endif
+}
+
+const char *BatchCulling::getKernelName( Kernel kernel )
+{
+	switch ( kernel ) {
+		case Kernel::AVX:
+			return "AVX";
+		case Kernel::SSE:
+			return "SSE";
+		default:
+			return "Scalar";
+	}
+}
+
+void BatchCulling::cull( const SphereBatch &spheres, const Plane3f *planes, crimild::Size planeCount, crimild::UInt8 *visible, Kernel kernel )
+{
+	crimild::Size begin = 0;
+
+	switch ( kernel ) {
+#if defined( CRIMILD_SIMD_AVX )
+		case Kernel::AVX:
+			begin = internal::cullSpheresAVX( spheres, planes, planeCount, visible );
+			break;
+#endif
+
+#if defined( CRIMILD_SIMD_SSE )
+		case Kernel::SSE:
+			begin = internal::cullSpheresSSE( spheres, planes, planeCount, visible );
+			break;
+#endif
+
+		case Kernel::SCALAR:
+			break;
+
+		default:
+			// not supported by this build
+			if ( getDefaultKernel() != Kernel::SCALAR ) {
+				cull( spheres, planes, planeCount, visible, getDefaultKernel() );
+				return;
+			}
+			break;
+	}
+
+	// remaining spheres
+	internal::cullSpheresScalar( spheres, begin, planes, planeCount, visible );
+}
+
+void BatchCulling::cull( const BoxBatch &boxes, const Plane3f *planes, crimild::Size planeCount, crimild::UInt8 *visible, Kernel kernel )
+{
+	crimild::Size begin = 0;
+
+	switch ( kernel ) {
+#if defined( CRIMILD_SIMD_AVX )
+		case Kernel::AVX:
+			begin = internal::cullBoxesAVX( boxes, planes, planeCount, visible );
+			break;
+#endif
+
+#if defined( CRIMILD_SIMD_SSE )
+		case Kernel::SSE:
+			begin = internal::cullBoxesSSE( boxes, planes, planeCount, visible );
+			break;
+#endif
+
+		case Kernel::SCALAR:
+			break;
+
+		default:
+			// not supported by this build
+			if ( getDefaultKernel() != Kernel::SCALAR ) {
+				cull( boxes, planes, planeCount, visible, getDefaultKernel() );
+				return;
+			}
+			break;
+	}
+
+	// remaining boxes
+	internal::cullBoxesScalar( boxes, begin, planes, planeCount, visible );
+}
@@ -0,0 +1,151 @@
+/*
+ * Copyright (c) 2013, Hernan Saez
+ * All rights reserved.
+ * 
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *     * Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in the
+ *       documentation and/or other materials provided with the distribution.
+ *     * Neither the name of the <organization> nor the
+ *       names of its contributors may be used to endorse or promote products
+ *       derived from this software without specific prior written permission.
+ * 
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL <COPYRIGHT HOLDER> BE LIABLE FOR ANY
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef CRIMILD_CORE_BOUNDINGS_BATCH_CULLING_
+#define CRIMILD_CORE_BOUNDINGS_BATCH_CULLING_
+
+#include "Foundation/Types.hpp"
+#include "Mathematics/Vector.hpp"
+#include "Mathematics/Plane.hpp"
+
+#include <vector>
+
+namespace crimild {
+
+	class BoundingVolume;
+
+	/**
+	   \brief Packed world-space spheres
+
+	   Values are stored as a structure of arrays, so several spheres 
+	   can be loaded into SIMD registers at once.
+	 */
+	class SphereBatch {
+	public:
+		void clear( void );
+		void reserve( crimild::Size count );
+
+		crimild::Size getCount( void ) const { return _radius.size(); }
+
+		void push( const Vector3f &center, crimild::Real32 radius );
+
+		/**
+		   \brief Pushes the sphere used by BoundingVolume::whichSide()
+
+		   Spheres and AABBs are culled using their enclosing spheres. Other 
+		   volumes (i.e. planes) are never culled, so they're pushed with 
+		   an infinite radius.
+		 */
+		void push( const BoundingVolume *volume );
+
+		const crimild::Real32 *getCenterX( void ) const { return _centerX.data(); }
+		const crimild::Real32 *getCenterY( void ) const { return _centerY.data(); }
+		const crimild::Real32 *getCenterZ( void ) const { return _centerZ.data(); }
+		const crimild::Real32 *getRadius( void ) const { return _radius.data(); }
+
+	private:
+		std::vector< crimild::Real32 > _centerX;
+		std::vector< crimild::Real32 > _centerY;
+		std::vector< crimild::Real32 > _centerZ;
+		std::vector< crimild::Real32 > _radius;
+	};
+
+	/**
+	   \brief Packed world-space axis-aligned boxes
+
+	   Boxes are stored as centers and extents (half sizes)
+	 */
+	class BoxBatch {
+	public:
+		void clear( void );
+		void reserve( crimild::Size count );
+
+		crimild::Size getCount( void ) const { return _extentX.size(); }
+
+		void push( const Vector3f &min, const Vector3f &max );
+
+		const crimild::Real32 *getCenterX( void ) const { return _centerX.data(); }
+		const crimild::Real32 *getCenterY( void ) const { return _centerY.data(); }
+		const crimild::Real32 *getCenterZ( void ) const { return _centerZ.data(); }
+		const crimild::Real32 *getExtentX( void ) const { return _extentX.data(); }
+		const crimild::Real32 *getExtentY( void ) const { return _extentY.data(); }
+		const crimild::Real32 *getExtentZ( void ) const { return _extentZ.data(); }
+
+	private:
+		std::vector< crimild::Real32 > _centerX;
+		std::vector< crimild::Real32 > _centerY;
+		std::vector< crimild::Real32 > _centerZ;
+		std::vector< crimild::Real32 > _extentX;
+		std::vector< crimild::Real32 > _extentY;
+		std::vector< crimild::Real32 > _extentZ;
+	};
+
+	/**
+	   \brief Tests packed bounding volumes against a set of planes
+
+	   A volume is culled if it's completely behind at least one of the
+	   planes, which is the same criteria used by Camera::culled(). 
+	   Depending on the instruction sets available at compile time (see 
+	   Simd.hpp), volumes are tested eight (AVX) or four (SSE) at a 
+	   time. All kernels perform the exact same floating point operations,
+	   so results do not depend on the kernel being used.
+	 */
+	class BatchCulling {
+	public:
+		enum class Kernel {
+			SCALAR,
+			SSE,
+			AVX,
+		};
+
+		/**
+		   \brief The widest kernel supported by this build
+		 */
+		static Kernel getDefaultKernel( void );
+
+		static const char *getKernelName( Kernel kernel );
+
+		/**
+		   \brief Culls spheres
+
+		   \param visible Output array with one element per sphere. Set to 1 if
+		   the sphere is not culled by any plane, 0 otherwise
+		   \param kernel Requested kernel. If not supported, the default one is used instead
+		 */
+		static void cull( const SphereBatch &spheres, const Plane3f *planes, crimild::Size planeCount, crimild::UInt8 *visible, Kernel kernel = getDefaultKernel() );
+
+		/**
+		   \brief Culls boxes
+
+		   \see cull( const SphereBatch & )
+		 */
+		static void cull( const BoxBatch &boxes, const Plane3f *planes, crimild::Size planeCount, crimild::UInt8 *visible, Kernel kernel = getDefaultKernel() );
+	};
+
+}
+
+#endif
@@ -0,0 +1,413 @@
+/*
+ * Copyright (c) 2013, Hernan Saez
+ * All rights reserved.
+ * 
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *     * Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in the
+ *       documentation and/or other materials provided with the distribution.
+ *     * Neither the name of the <organization> nor the
+ *       names of its contributors may be used to endorse or promote products
+ *       derived from this software without specific prior written permission.
+ * 
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL <COPYRIGHT HOLDER> BE LIABLE FOR ANY
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "DynamicAABBTree.hpp"
+
+#include "Mathematics/Numeric.hpp"
+
+#include <algorithm>
+
+using namespace crimild;
+
+namespace crimild {
+
+	namespace internal {
+
+		inline Vector3f minPerComponent( const Vector3f &a, const Vector3f &b )
+		{
+			return Vector3f( Numericf::min( a[ 0 ], b[ 0 ] ), Numericf::min( a[ 1 ], b[ 1 ] ), Numericf::min( a[ 2 ], b[ 2 ] ) );
+		}
+
+		inline Vector3f maxPerComponent( const Vector3f &a, const Vector3f &b )
+		{
+			return Vector3f( Numericf::max( a[ 0 ], b[ 0 ] ), Numericf::max( a[ 1 ], b[ 1 ] ), Numericf::max( a[ 2 ], b[ 2 ] ) );
+		}
+
+		inline crimild::Real32 surfaceArea( const Vector3f &min, const Vector3f &max )
+		{
+			auto dx = max[ 0 ] - min[ 0 ];
+			auto dy = max[ 1 ] - min[ 1 ];
+			auto dz = max[ 2 ] - min[ 2 ];
+			return 2.0f * ( dx * dy + dy * dz + dz * dx );
+		}
+
+		inline crimild::Real32 combinedSurfaceArea( const Vector3f &min0, const Vector3f &max0, const Vector3f &min1, const Vector3f &max1 )
+		{
+			return surfaceArea( minPerComponent( min0, min1 ), maxPerComponent( max0, max1 ) );
+		}
+
+		inline bool contains( const Vector3f &outerMin, const Vector3f &outerMax, const Vector3f &innerMin, const Vector3f &innerMax )
+		{
+			for ( int i = 0; i < 3; i++ ) {
+				if ( innerMin[ i ] < outerMin[ i ] || innerMax[ i ] > outerMax[ i ] ) {
+					return false;
+				}
+			}
+			return true;
+		}
+
+	}
+
+}
+
+DynamicAABBTree::DynamicAABBTree( crimild::Real32 margin )
+	: _margin( margin )
+{
+
+}
+
+DynamicAABBTree::~DynamicAABBTree( void )
+{
+
+}
+
+void DynamicAABBTree::clear( void )
+{
+	_nodes.clear();
+	_root = NULL_NODE;
+	_freeList = NULL_NODE;
+	_proxyCount = 0;
+}
+
+DynamicAABBTree::ProxyId DynamicAABBTree::allocateNode( void )
+{
+	if ( _freeList == NULL_NODE ) {
+		_nodes.push_back( Node() );
+		_nodes.back().next = NULL_NODE;
+		_freeList = static_cast< ProxyId >( _nodes.size() - 1 );
+	}
+
+	auto nodeId = _freeList;
+	auto &node = _nodes[ nodeId ];
+	_freeList = node.next;
+
+	node.parent = NULL_NODE;
+	node.child1 = NULL_NODE;
+	node.child2 = NULL_NODE;
+	node.height = 0;
+	node.userData = nullptr;
+
+	return nodeId;
+}
+
+void DynamicAABBTree::freeNode( ProxyId nodeId )
+{
+	auto &node = _nodes[ nodeId ];
+	node.next = _freeList;
+	node.height = -1;
+	node.userData = nullptr;
+	_freeList = nodeId;
+}
+
+DynamicAABBTree::ProxyId DynamicAABBTree::createProxy( const Vector3f &min, const Vector3f &max, void *userData )
+{
+	auto proxyId = allocateNode();
+
+	auto &node = _nodes[ proxyId ];
+	node.min = min - Vector3f( _margin );
+	node.max = max + Vector3f( _margin );
+	node.userData = userData;
+
+	insertLeaf( proxyId );
+	++_proxyCount;
+
+	return proxyId;
+}
+
+void DynamicAABBTree::destroyProxy( ProxyId proxyId )
+{
+	removeLeaf( proxyId );
+	freeNode( proxyId );
+	--_proxyCount;
+}
+
+bool DynamicAABBTree::moveProxy( ProxyId proxyId, const Vector3f &min, const Vector3f &max )
+{
+	auto &node = _nodes[ proxyId ];
+
+	if ( internal::contains( node.min, node.max, min, max ) ) {
+		// reinsert anyway if the fat box is way too big for the new one
+		auto extra = Vector3f( 4.0f * _margin );
+		if ( internal::contains( min - extra, max + extra, node.min, node.max ) ) {
+			return false;
+		}
+	}
+
+	removeLeaf( proxyId );
+
+	node.min = min - Vector3f( _margin );
+	node.max = max + Vector3f( _margin );
+
+	insertLeaf( proxyId );
+
+	return true;
+}
+
+void DynamicAABBTree::insertLeaf( ProxyId leaf )
+{
+	if ( _root == NULL_NODE ) {
+		_root = leaf;
+		_nodes[ _root ].parent = NULL_NODE;
+		return;
+	}
+
+	// find the best sibling using the surface area heuristic
+	const auto leafMin = _nodes[ leaf ].min;
+	const auto leafMax = _nodes[ leaf ].max;
+
+	auto index = _root;
+	while ( !_nodes[ index ].isLeaf() ) {
+		const auto &node = _nodes[ index ];
+
+		auto area = internal::surfaceArea( node.min, node.max );
+		auto combinedArea = internal::combinedSurfaceArea( node.min, node.max, leafMin, leafMax );
+
+		// cost of creating a new parent for this node and the new leaf
+		auto cost = 2.0f * combinedArea;
+
+		// minimum cost of pushing the leaf further down the tree
+		auto inheritanceCost = 2.0f * ( combinedArea - area );
+
+		auto descendCost = [ this, &leafMin, &leafMax, inheritanceCost ]( ProxyId childId ) {
+			const auto &child = _nodes[ childId ];
+			auto combined = internal::combinedSurfaceArea( child.min, child.max, leafMin, leafMax );
+			if ( child.isLeaf() ) {
+				return combined + inheritanceCost;
+			}
+			return ( combined - internal::surfaceArea( child.min, child.max ) ) + inheritanceCost;
+		};
+
+		auto cost1 = descendCost( node.child1 );
+		auto cost2 = descendCost( node.child2 );
+
+		if ( cost < cost1 && cost < cost2 ) {
+			break;
+		}
+
+		index = cost1 < cost2 ? node.child1 : node.child2;
+	}
+
+	auto sibling = index;
+
+	// create a new parent (might invalidate references to nodes)
+	auto oldParent = _nodes[ sibling ].parent;
+	auto newParent = allocateNode();
+
+	_nodes[ newParent ].parent = oldParent;
+	_nodes[ newParent ].min = internal::minPerComponent( leafMin, _nodes[ sibling ].min );
+	_nodes[ newParent ].max = internal::maxPerComponent( leafMax, _nodes[ sibling ].max );
+	_nodes[ newParent ].height = _nodes[ sibling ].height + 1;
+	_nodes[ newParent ].child1 = sibling;
+	_nodes[ newParent ].child2 = leaf;
+	_nodes[ sibling ].parent = newParent;
+	_nodes[ leaf ].parent = newParent;
+
+	if ( oldParent != NULL_NODE ) {
+		if ( _nodes[ oldParent ].child1 == sibling ) {
+			_nodes[ oldParent ].child1 = newParent;
+		}
+		else {
+			_nodes[ oldParent ].child2 = newParent;
+		}
+	}
+	else {
+		_root = newParent;
+	}
+
+	refit( _nodes[ leaf ].parent );
+}
+
+void DynamicAABBTree::removeLeaf( ProxyId leaf )
+{
+	if ( leaf == _root ) {
+		_root = NULL_NODE;
+		return;
+	}
+
+	auto parent = _nodes[ leaf ].parent;
+	auto grandParent = _nodes[ parent ].parent;
+	auto sibling = _nodes[ parent ].child1 == leaf ? _nodes[ parent ].child2 : _nodes[ parent ].child1;
+
+	if ( grandParent != NULL_NODE ) {
+		// connect sibling to grand parent and discard the parent
+		if ( _nodes[ grandParent ].child1 == parent ) {
+			_nodes[ grandParent ].child1 = sibling;
+		}
+		else {
+			_nodes[ grandParent ].child2 = sibling;
+		}
+		_nodes[ sibling ].parent = grandParent;
+		freeNode( parent );
+
+		refit( grandParent );
+	}
+	else {
+		_root = sibling;
+		_nodes[ sibling ].parent = NULL_NODE;
+		freeNode( parent );
+	}
+}
+
+void DynamicAABBTree::refit( ProxyId nodeId )
+{
+	while ( nodeId != NULL_NODE ) {
+		nodeId = balance( nodeId );
+
+		auto &node = _nodes[ nodeId ];
+		const auto &child1 = _nodes[ node.child1 ];
+		const auto &child2 = _nodes[ node.child2 ];
+
+		node.height = 1 + std::max( child1.height, child2.height );
+		node.min = internal::minPerComponent( child1.min, child2.min );
+		node.max = internal::maxPerComponent( child1.max, child2.max );
+
+		nodeId = node.parent;
+	}
+}
+
+DynamicAABBTree::ProxyId DynamicAABBTree::balance( ProxyId iA )
+{
+	auto &A = _nodes[ iA ];
+	if ( A.isLeaf() || A.height < 2 ) {
+		return iA;
+	}
+
+	auto iB = A.child1;
+	auto iC = A.child2;
+	auto &B = _nodes[ iB ];
+	auto &C = _nodes[ iC ];
+
+	auto balance = C.height - B.height;
+
+	// swaps A with one of its children (X), moving X's smallest 
+	// child down to A and keeping the biggest one under X
+	auto rotate = [ this, iA, &A ]( ProxyId iX, ProxyId iOther, bool replaceFirst ) {
+		auto &X = _nodes[ iX ];
+		auto &other = _nodes[ iOther ];
+		auto iF = X.child1;
+		auto iG = X.child2;
+		auto &F = _nodes[ iF ];
+		auto &G = _nodes[ iG ];
+
+		X.child1 = iA;
+		X.parent = A.parent;
+		A.parent = iX;
+
+		if ( X.parent != NULL_NODE ) {
+			if ( _nodes[ X.parent ].child1 == iA ) {
+				_nodes[ X.parent ].child1 = iX;
+			}
+			else {
+				_nodes[ X.parent ].child2 = iX;
+			}
+		}
+		else {
+			_root = iX;
+		}
+
+		auto iKeep = F.height > G.height ? iF : iG;
+		auto iMove = F.height > G.height ? iG : iF;
+		auto &keep = _nodes[ iKeep ];
+		auto &move = _nodes[ iMove ];
+
+		X.child2 = iKeep;
+		if ( replaceFirst ) {
+			A.child1 = iMove;
+		}
+		else {
+			A.child2 = iMove;
+		}
+		move.parent = iA;
+
+		A.min = internal::minPerComponent( other.min, move.min );
+		A.max = internal::maxPerComponent( other.max, move.max );
+		A.height = 1 + std::max( other.height, move.height );
+
+		X.min = internal::minPerComponent( A.min, keep.min );
+		X.max = internal::maxPerComponent( A.max, keep.max );
+		X.height = 1 + std::max( A.height, keep.height );
+	};
+
+	if ( balance > 1 ) {
+		// rotate C up
+		rotate( iC, iB, false );
+		return iC;
+	}
+
+	if ( balance < -1 ) {
+		// rotate B up
+		rotate( iB, iC, true );
+		return iB;
+	}
+
+	return iA;
+}
+
+bool DynamicAABBTree::validate( void ) const
+{
+	if ( _root == NULL_NODE ) {
+		return _proxyCount == 0;
+	}
+
+	if ( _nodes[ _root ].parent != NULL_NODE ) {
+		return false;
+	}
+
+	return validate( _root, NULL_NODE ) == static_cast< crimild::Int32 >( _proxyCount );
+}
+
+crimild::Int32 DynamicAABBTree::validate( ProxyId nodeId, ProxyId parent ) const
+{
+	const auto &node = _nodes[ nodeId ];
+
+	if ( node.parent != parent ) {
+		return -1;
+	}
+
+	if ( node.isLeaf() ) {
+		return ( node.child2 == NULL_NODE && node.height == 0 ) ? 1 : -1;
+	}
+
+	const auto &child1 = _nodes[ node.child1 ];
+	const auto &child2 = _nodes[ node.child2 ];
+
+	if ( node.height != 1 + std::max( child1.height, child2.height ) ) {
+		return -1;
+	}
+
+	if ( !internal::contains( node.min, node.max, child1.min, child1.max ) || !internal::contains( node.min, node.max, child2.min, child2.max ) ) {
+		return -1;
+	}
+
+	auto leaves1 = validate( node.child1, nodeId );
+	auto leaves2 = validate( node.child2, nodeId );
+	if ( leaves1 < 0 || leaves2 < 0 ) {
+		return -1;
+	}
+
+	return leaves1 + leaves2;
+}
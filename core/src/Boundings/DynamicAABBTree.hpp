@@ -0,0 +1,216 @@
+/*
+ * Copyright (c) 2013, Hernan Saez
+ * All rights reserved.
+ * 
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *     * Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in the
+ *       documentation and/or other materials provided with the distribution.
+ *     * Neither the name of the <organization> nor the
+ *       names of its contributors may be used to endorse or promote products
+ *       derived from this software without specific prior written permission.
+ * 
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL <COPYRIGHT HOLDER> BE LIABLE FOR ANY
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef CRIMILD_CORE_BOUNDINGS_DYNAMIC_AABB_TREE_
+#define CRIMILD_CORE_BOUNDINGS_DYNAMIC_AABB_TREE_
+
+#include "Foundation/Types.hpp"
+#include "Mathematics/Vector.hpp"
+
+#include <vector>
+
+namespace crimild {
+
+	/**
+	   \brief A bounding volume hierarchy of axis-aligned boxes
+
+	   Each leaf (or proxy) stores a box that is slightly bigger than 
+	   the one provided by the user (a "fat" box), so objects can move 
+	   a little without requiring the tree to be updated. When a proxy 
+	   moves outside of its fat box, it's removed and inserted again 
+	   using the surface area heuristic to pick the best sibling. The
+	   tree is kept balanced with rotations after each insertion/removal.
+
+	   Nodes are stored in a single contiguous array and recycled
+	   using a free list, so the tree does not allocate memory once
+	   it has reached its working size.
+
+	   Queries are read-only and can be performed by several threads
+	   at the same time, as long as the tree is not modified.
+	 */
+	class DynamicAABBTree {
+	public:
+		using ProxyId = crimild::Int32;
+
+		static const ProxyId NULL_NODE = -1;
+
+		/**
+		   \brief Result of testing a box during queries
+		 */
+		enum class TestResult {
+			/**
+			   \brief The box (and all of its descendants) is discarded
+			 */
+			OUTSIDE,
+
+			/**
+			   \brief Descendants must be tested individually
+			 */
+			INTERSECTS,
+
+			/**
+			   \brief All of the descendants are accepted without further tests
+			 */
+			INSIDE,
+		};
+
+	public:
+		explicit DynamicAABBTree( crimild::Real32 margin = 0.1f );
+		~DynamicAABBTree( void );
+
+		/**
+		   \brief Creates a new leaf for the box [min, max]
+		 */
+		ProxyId createProxy( const Vector3f &min, const Vector3f &max, void *userData );
+
+		void destroyProxy( ProxyId proxyId );
+
+		/**
+		   \brief Updates a proxy's box
+
+		   \returns true if the proxy had to be reinserted in the tree
+		 */
+		bool moveProxy( ProxyId proxyId, const Vector3f &min, const Vector3f &max );
+
+		void *getUserData( ProxyId proxyId ) const { return _nodes[ proxyId ].userData; }
+
+		const Vector3f &getFatMin( ProxyId proxyId ) const { return _nodes[ proxyId ].min; }
+		const Vector3f &getFatMax( ProxyId proxyId ) const { return _nodes[ proxyId ].max; }
+
+		crimild::Size getProxyCount( void ) const { return _proxyCount; }
+
+		/**
+		   \brief Height of the tree. Zero for an empty tree or a single leaf
+		 */
+		crimild::Int32 getHeight( void ) const { return _root != NULL_NODE ? _nodes[ _root ].height : 0; }
+
+		void clear( void );
+
+		/**
+		   \brief Checks the structure of the tree. Useful for debugging
+		 */
+		bool validate( void ) const;
+
+		/**
+		   \brief Traverses the tree, discarding whole branches
+
+		   \param test A function classifying a box: TestResult( const Vector3f &min, const Vector3f &max )
+		   \param visit A function invoked for each accepted proxy: void( ProxyId, void *userData, bool inside ).
+		   The inside parameter is true if the proxy was accepted because one of its ancestors 
+		   was fully inside.
+		 */
+		template< typename TestFn, typename VisitFn >
+		void query( TestFn const &test, VisitFn const &visit ) const
+		{
+			if ( _root == NULL_NODE ) {
+				return;
+			}
+
+			struct Entry {
+				ProxyId id;
+				bool inside;
+			};
+
+			std::vector< Entry > stack;
+			stack.reserve( 64 );
+			stack.push_back( Entry { _root, false } );
+
+			while ( !stack.empty() ) {
+				auto entry = stack.back();
+				stack.pop_back();
+
+				auto &node = _nodes[ entry.id ];
+				auto inside = entry.inside;
+
+				if ( !inside ) {
+					auto result = test( node.min, node.max );
+					if ( result == TestResult::OUTSIDE ) {
+						continue;
+					}
+					inside = ( result == TestResult::INSIDE );
+				}
+
+				if ( node.isLeaf() ) {
+					visit( entry.id, node.userData, inside );
+				}
+				else {
+					// push the second child first, so leaves are visited in order
+					stack.push_back( Entry { node.child2, inside } );
+					stack.push_back( Entry { node.child1, inside } );
+				}
+			}
+		}
+
+	private:
+		struct Node {
+			Vector3f min;
+			Vector3f max;
+
+			void *userData = nullptr;
+
+			union {
+				ProxyId parent;
+				ProxyId next;
+			};
+
+			ProxyId child1 = NULL_NODE;
+			ProxyId child2 = NULL_NODE;
+
+			/**
+			   \brief Zero for leaves, -1 for free nodes
+			 */
+			crimild::Int32 height = -1;
+
+			bool isLeaf( void ) const { return child1 == NULL_NODE; }
+		};
+
+		ProxyId allocateNode( void );
+		void freeNode( ProxyId nodeId );
+
+		void insertLeaf( ProxyId leaf );
+		void removeLeaf( ProxyId leaf );
+
+		ProxyId balance( ProxyId a );
+
+		/**
+		   \brief Recomputes boxes and heights from a node up to the root
+		 */
+		void refit( ProxyId nodeId );
+
+		crimild::Int32 validate( ProxyId nodeId, ProxyId parent ) const;
+
+	private:
+		std::vector< Node > _nodes;
+		ProxyId _root = NULL_NODE;
+		ProxyId _freeList = NULL_NODE;
+		crimild::Size _proxyCount = 0;
+		crimild::Real32 _margin;
+	};
+
+}
+
+#endif
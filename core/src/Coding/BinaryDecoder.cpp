@@ -0,0 +1,407 @@
+/*
+ * Copyright (c) 2013, Hernan Saez
+ * All rights reserved.
+ * 
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *     * Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in the
+ *       documentation and/or other materials provided with the distribution.
+ *     * Neither the name of the <organization> nor the
+ *       names of its contributors may be used to endorse or promote products
+ *       derived from this software without specific prior written permission.
+ * 
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL <COPYRIGHT HOLDER> BE LIABLE FOR ANY
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "BinaryDecoder.hpp"
+
+#include "Foundation/Log.hpp"
+#include "Foundation/MappedFile.hpp"
+#include "Foundation/ObjectFactory.hpp"
+#include "Foundation/Version.hpp"
+
+#include <cstdint>
+
+using namespace crimild;
+using namespace crimild::coding;
+
+namespace crimild {
+
+	namespace coding {
+
+		namespace internal {
+
+			/**
+			   \brief Owns a copy of the data passed to BinaryDecoder::fromBytes()
+			 */
+			class BinaryDecoderStorage : public SharedObject {
+			public:
+				explicit BinaryDecoderStorage( const containers::ByteArray &bytes )
+					: _bytes( bytes.size() )
+				{
+					memcpy( _bytes.getData(), bytes.getData(), bytes.size() );
+				}
+
+				virtual ~BinaryDecoderStorage( void )
+				{
+
+				}
+
+				crimild::Byte *getData( void ) { return _bytes.getData(); }
+				crimild::Size getSize( void ) const { return _bytes.size(); }
+
+			private:
+				containers::ByteArray _bytes;
+			};
+
+			static crimild::Bool isInRange( crimild::UInt64 offset, crimild::UInt64 count, crimild::UInt64 elementSize, crimild::UInt64 size )
+			{
+				return offset <= size && count <= ( size - offset ) / elementSize;
+			}
+
+			static crimild::Bool isAligned( crimild::UInt64 offset )
+			{
+				return offset % binary::ALIGNMENT == 0;
+			}
+
+		}
+
+	}
+
+}
+
+BinaryDecoder::BinaryDecoder( void )
+{
+
+}
+
+BinaryDecoder::~BinaryDecoder( void )
+{
+
+}
+
+crimild::Bool BinaryDecoder::read( std::string filePath )
+{
+	auto file = crimild::alloc< MappedFile >();
+	if ( !file->open( filePath ) ) {
+		return false;
+	}
+
+	return fromMemory( file->getData(), file->getSize(), file );
+}
+
+crimild::Bool BinaryDecoder::fromBytes( const containers::ByteArray &bytes )
+{
+	auto storage = crimild::alloc< internal::BinaryDecoderStorage >( bytes );
+	return fromMemory( storage->getData(), storage->getSize(), storage );
+}
+
+crimild::Bool BinaryDecoder::fromMemory( crimild::Byte *data, crimild::Size size, SharedPointer< SharedObject > const &storage )
+{
+	_storage = storage;
+	_data = data;
+	_size = size;
+
+	if ( !validate() ) {
+		_storage = nullptr;
+		_data = nullptr;
+		_size = 0;
+		return false;
+	}
+
+	setVersion( Version( getString( _header->versionString ) ) );
+
+	_keys.clear();
+	_keys.reserve( _header->stringCount );
+	for ( crimild::UInt32 i = 0; i < _header->stringCount; i++ ) {
+		_keys[ getString( i ) ] = i;
+	}
+
+	// build all objects first, so links can be resolved in any order
+	_objects.resize( _header->objectCount );
+	_decoded.assign( _header->objectCount, false );
+	for ( crimild::Size i = 0; i < _header->objectCount; i++ ) {
+		auto className = getString( _objectRecords[ i ].className );
+		auto obj = crimild::dynamic_cast_ptr< Codable >( ObjectFactory::getInstance()->build( className ) );
+		if ( obj == nullptr ) {
+			Log::error( CRIMILD_CURRENT_CLASS_NAME, "Cannot build object of type ", className );
+			return false;
+		}
+		_objects[ i ] = obj;
+	}
+
+	for ( crimild::Size i = 0; i < _header->rootCount; i++ ) {
+		auto index = _roots[ i ];
+		decodeObject( index );
+		addRootObject( crimild::dynamic_cast_ptr< SharedObject >( _objects[ index ] ) );
+	}
+
+	return true;
+}
+
+crimild::Bool BinaryDecoder::validate( void )
+{
+	if ( _data == nullptr || _size < sizeof( binary::Header ) ) {
+		Log::error( CRIMILD_CURRENT_CLASS_NAME, "Invalid data format. Not enough data" );
+		return false;
+	}
+
+	if ( reinterpret_cast< std::uintptr_t >( _data ) % binary::ALIGNMENT != 0 ) {
+		Log::error( CRIMILD_CURRENT_CLASS_NAME, "Invalid data alignment" );
+		return false;
+	}
+
+	_header = reinterpret_cast< const binary::Header * >( _data );
+	if ( memcmp( _header->magic, binary::MAGIC, sizeof( binary::MAGIC ) ) != 0 ) {
+		Log::error( CRIMILD_CURRENT_CLASS_NAME, "Invalid data format. Wrong magic number" );
+		return false;
+	}
+
+	if ( _header->formatVersion != binary::FORMAT_VERSION ) {
+		Log::error( CRIMILD_CURRENT_CLASS_NAME, "Unsupported format version ", _header->formatVersion );
+		return false;
+	}
+
+	if ( !internal::isInRange( _header->stringsOffset, _header->stringCount, sizeof( binary::StringRecord ), _size )
+		|| !internal::isInRange( _header->objectsOffset, _header->objectCount, sizeof( binary::ObjectRecord ), _size )
+		|| !internal::isInRange( _header->fieldsOffset, _header->fieldCount, sizeof( binary::FieldRecord ), _size )
+		|| !internal::isInRange( _header->rootsOffset, _header->rootCount, sizeof( crimild::UInt32 ), _size )
+		|| !internal::isInRange( _header->blobsOffset, _header->blobsSize, 1, _size )
+		|| !internal::isAligned( _header->stringsOffset )
+		|| !internal::isAligned( _header->objectsOffset )
+		|| !internal::isAligned( _header->fieldsOffset )
+		|| !internal::isAligned( _header->rootsOffset )
+		|| !internal::isAligned( _header->blobsOffset )
+		|| _header->versionString >= _header->stringCount ) {
+		Log::error( CRIMILD_CURRENT_CLASS_NAME, "Invalid data format. Corrupted header" );
+		return false;
+	}
+
+	_strings = reinterpret_cast< const binary::StringRecord * >( _data + _header->stringsOffset );
+	_objectRecords = reinterpret_cast< const binary::ObjectRecord * >( _data + _header->objectsOffset );
+	_fields = reinterpret_cast< const binary::FieldRecord * >( _data + _header->fieldsOffset );
+	_roots = reinterpret_cast< const crimild::UInt32 * >( _data + _header->rootsOffset );
+	_blobs = _data + _header->blobsOffset;
+
+	for ( crimild::Size i = 0; i < _header->stringCount; i++ ) {
+		if ( !internal::isInRange( _strings[ i ].offset, _strings[ i ].length, 1, _size ) ) {
+			Log::error( CRIMILD_CURRENT_CLASS_NAME, "Invalid data format. Corrupted string table" );
+			return false;
+		}
+	}
+
+	for ( crimild::Size i = 0; i < _header->objectCount; i++ ) {
+		const auto &obj = _objectRecords[ i ];
+		if ( obj.className >= _header->stringCount || !internal::isInRange( obj.firstField, obj.fieldCount, 1, _header->fieldCount ) ) {
+			Log::error( CRIMILD_CURRENT_CLASS_NAME, "Invalid data format. Corrupted object ", i );
+			return false;
+		}
+
+		const crimild::UInt64 end = obj.firstField + obj.fieldCount;
+		for ( crimild::UInt64 j = obj.firstField; j < end; j++ ) {
+			const auto &field = _fields[ j ];
+			auto valid = field.key < _header->stringCount;
+			switch ( field.type ) {
+				case binary::FieldType::VALUE:
+					valid = valid && field.size <= binary::INLINE_VALUE_SIZE;
+					break;
+
+				case binary::FieldType::BLOB:
+					valid = valid && internal::isInRange( field.offset, field.size, 1, _header->blobsSize ) && internal::isAligned( field.offset );
+					break;
+
+				case binary::FieldType::LINK:
+					valid = valid && ( field.size < _header->objectCount || field.size == binary::INVALID_INDEX );
+					break;
+
+				case binary::FieldType::ARRAY:
+					valid = valid && field.span < end - j && field.size <= field.span;
+					break;
+
+				default:
+					valid = false;
+					break;
+			}
+
+			if ( !valid ) {
+				Log::error( CRIMILD_CURRENT_CLASS_NAME, "Invalid data format. Corrupted field ", j );
+				return false;
+			}
+		}
+	}
+
+	for ( crimild::Size i = 0; i < _header->rootCount; i++ ) {
+		if ( _roots[ i ] >= _header->objectCount ) {
+			Log::error( CRIMILD_CURRENT_CLASS_NAME, "Invalid data format. Cannot find root object ", _roots[ i ] );
+			return false;
+		}
+	}
+
+	return true;
+}
+
+std::string BinaryDecoder::getString( crimild::UInt32 index ) const
+{
+	const auto &record = _strings[ index ];
+	return std::string( reinterpret_cast< const char * >( _data + record.offset ), record.length );
+}
+
+void BinaryDecoder::decodeObject( crimild::UInt32 index )
+{
+	if ( _decoded[ index ] ) {
+		return;
+	}
+
+	// flag the object before decoding it to support cycles
+	_decoded[ index ] = true;
+
+	auto previous = _current;
+	std::vector< ArrayScope > arrays;
+	std::swap( arrays, _arrays );
+	_current = index;
+
+	_objects[ index ]->decode( *this );
+
+	_current = previous;
+	std::swap( arrays, _arrays );
+}
+
+const binary::FieldRecord *BinaryDecoder::findField( std::string const &key )
+{
+	if ( _current == binary::INVALID_INDEX ) {
+		return nullptr;
+	}
+
+	if ( !_arrays.empty() ) {
+		// array elements are read in order, ignoring their keys
+		auto &scope = _arrays.back();
+		if ( scope.next >= scope.end ) {
+			return nullptr;
+		}
+
+		auto field = _fields + scope.next;
+		scope.next += 1 + ( field->type == binary::FieldType::ARRAY ? field->span : 0 );
+		return field;
+	}
+
+	auto it = _keys.find( key );
+	if ( it == _keys.end() ) {
+		return nullptr;
+	}
+
+	const auto keyIndex = it->second;
+	const auto &obj = _objectRecords[ _current ];
+	const crimild::UInt64 end = obj.firstField + obj.fieldCount;
+	for ( crimild::UInt64 i = obj.firstField; i < end; ) {
+		auto field = _fields + i;
+		if ( field->key == keyIndex ) {
+			return field;
+		}
+
+		// skip array elements
+		i += 1 + ( field->type == binary::FieldType::ARRAY ? field->span : 0 );
+	}
+
+	return nullptr;
+}
+
+const crimild::Byte *BinaryDecoder::getPlainData( const binary::FieldRecord *field, crimild::Size size ) const
+{
+	if ( field == nullptr || field->size != size ) {
+		return nullptr;
+	}
+
+	if ( field->type == binary::FieldType::VALUE ) {
+		return field->bytes;
+	}
+
+	if ( field->type == binary::FieldType::BLOB ) {
+		return getBlobData( field );
+	}
+
+	return nullptr;
+}
+
+crimild::Bool BinaryDecoder::decode( std::string key, SharedPointer< coding::Codable > &codable )
+{
+	auto field = findField( key );
+	if ( field == nullptr || field->type != binary::FieldType::LINK || field->size == binary::INVALID_INDEX ) {
+		codable = nullptr;
+		return false;
+	}
+
+	auto index = static_cast< crimild::UInt32 >( field->size );
+	decodeObject( index );
+	codable = _objects[ index ];
+
+	return true;
+}
+
+crimild::Bool BinaryDecoder::decode( std::string key, std::string &value )
+{
+	auto field = findField( key );
+	if ( field == nullptr || field->type != binary::FieldType::BLOB ) {
+		return false;
+	}
+
+	value = std::string( reinterpret_cast< const char * >( getBlobData( field ) ), field->size );
+
+	return true;
+}
+
+crimild::Bool BinaryDecoder::decodeBlob( std::string key, BlobView &blob )
+{
+	auto field = findField( key );
+	if ( field == nullptr || field->type != binary::FieldType::BLOB ) {
+		return false;
+	}
+
+	blob.data = getBlobData( field );
+	blob.size = field->size;
+	blob.storage = _storage;
+
+	return true;
+}
+
+crimild::Size BinaryDecoder::beginDecodingArray( std::string key )
+{
+	auto field = findField( key );
+	if ( field == nullptr || field->type != binary::FieldType::ARRAY ) {
+		// push an empty scope anyway, since endDecodingArray() will be called
+		_arrays.push_back( ArrayScope { 0, 0 } );
+		return 0;
+	}
+
+	crimild::Size first = ( field - _fields ) + 1;
+	_arrays.push_back( ArrayScope { first, first + field->span } );
+
+	return field->size;
+}
+
+std::string BinaryDecoder::beginDecodingArrayElement( std::string key, crimild::Size index )
+{
+	return key;
+}
+
+void BinaryDecoder::endDecodingArrayElement( std::string key, crimild::Size index )
+{
+	// no-op
+}
+
+void BinaryDecoder::endDecodingArray( std::string key )
+{
+	_arrays.pop_back();
+}
+
@@ -0,0 +1,208 @@
+/*
+ * Copyright (c) 2013, Hernan Saez
+ * All rights reserved.
+ * 
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *     * Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in the
+ *       documentation and/or other materials provided with the distribution.
+ *     * Neither the name of the <organization> nor the
+ *       names of its contributors may be used to endorse or promote products
+ *       derived from this software without specific prior written permission.
+ * 
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL <COPYRIGHT HOLDER> BE LIABLE FOR ANY
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef CRIMILD_CORE_CODING_BINARY_DECODER_
+#define CRIMILD_CORE_CODING_BINARY_DECODER_
+
+#include "Decoder.hpp"
+#include "BinaryFormat.hpp"
+
+#include <cstring>
+#include <unordered_map>
+#include <vector>
+
+namespace crimild {
+
+	namespace coding {
+
+		/**
+		   \brief Decodes objects from a binary container
+
+		   Files are memory-mapped when possible (see MappedFile). Large
+		   payloads like vertex, index or image data are accessed in-place 
+		   through decodeBlob() and never copied. Objects referencing those
+		   payloads keep the underlying storage alive.
+
+		   Shared objects are decoded only once.
+		 */
+        class BinaryDecoder : public Decoder {
+        public:
+            BinaryDecoder( void );
+            virtual ~BinaryDecoder( void );
+
+		public:
+            virtual crimild::Bool decode( std::string key, SharedPointer< coding::Codable > &codable ) override;
+
+            virtual crimild::Bool decode( std::string key, std::string &value ) override;
+            
+            virtual crimild::Bool decode( std::string key, crimild::Size &value ) override { return decodeValue( key, value ); }
+            virtual crimild::Bool decode( std::string key, crimild::UInt8 &value ) override { return decodeValue( key, value ); }
+            virtual crimild::Bool decode( std::string key, crimild::UInt16 &value ) override { return decodeValue( key, value ); }
+            virtual crimild::Bool decode( std::string key, crimild::Int16 &value ) override { return decodeValue( key, value ); }
+            virtual crimild::Bool decode( std::string key, crimild::Int32 &value ) override { return decodeValue( key, value ); }
+            virtual crimild::Bool decode( std::string key, crimild::UInt32 &value ) override { return decodeValue( key, value ); }
+            virtual crimild::Bool decode( std::string key, crimild::Bool &value ) override { return decodeValue( key, value ); }
+			virtual crimild::Bool decode( std::string key, crimild::Real32 &value ) override { return decodeValue( key, value ); }
+			virtual crimild::Bool decode( std::string key, crimild::Real64 &value ) override { return decodeValue( key, value ); }
+			virtual crimild::Bool decode( std::string key, crimild::Vector2f &value ) override { return decodeValue( key, value ); }
+			virtual crimild::Bool decode( std::string key, crimild::Vector3f &value ) override { return decodeValue( key, value ); }
+            virtual crimild::Bool decode( std::string key, crimild::Vector4f &value ) override { return decodeValue( key, value ); }
+            virtual crimild::Bool decode( std::string key, crimild::Matrix3f &value ) override { return decodeValue( key, value ); }
+            virtual crimild::Bool decode( std::string key, crimild::Matrix4f &value ) override { return decodeValue( key, value ); }
+            virtual crimild::Bool decode( std::string key, crimild::Quaternion4f &value ) override { return decodeValue( key, value ); }
+            virtual crimild::Bool decode( std::string key, Transformation &value ) override { return decodeValue( key, value ); }
+            virtual crimild::Bool decode( std::string key, VertexFormat &value ) override { return decodeValue( key, value ); }
+            
+            virtual crimild::Bool decode( std::string key, containers::ByteArray &value ) override { return decodeArray( key, value ); }
+            virtual crimild::Bool decode( std::string key, containers::Array< crimild::Real32 > &value ) override { return decodeArray( key, value ); }
+            virtual crimild::Bool decode( std::string key, containers::Array< Vector3f > &value ) override { return decodeArray( key, value ); }
+            virtual crimild::Bool decode( std::string key, containers::Array< Vector4f > &value ) override { return decodeArray( key, value ); }
+            virtual crimild::Bool decode( std::string key, containers::Array< Matrix3f > &value ) override { return decodeArray( key, value ); }
+            virtual crimild::Bool decode( std::string key, containers::Array< Matrix4f > &value ) override { return decodeArray( key, value ); }
+            virtual crimild::Bool decode( std::string key, containers::Array< Quaternion4f > &value ) override { return decodeArray( key, value ); }
+
+			virtual crimild::Bool decodeBlob( std::string key, BlobView &blob ) override;
+
+			/**
+			   \brief Memory-maps a file and decodes its contents
+			 */
+			crimild::Bool read( std::string filePath );
+
+			/**
+			   \brief Decodes objects from a copy of the given bytes
+			 */
+            crimild::Bool fromBytes( const containers::ByteArray &bytes );
+
+			/**
+			   \brief Decodes objects from a block of memory owned by storage
+
+			   The memory must be aligned to binary::ALIGNMENT bytes
+			 */
+			crimild::Bool fromMemory( crimild::Byte *data, crimild::Size size, SharedPointer< SharedObject > const &storage );
+
+		protected:
+			virtual crimild::Size beginDecodingArray( std::string key ) override;
+			virtual std::string beginDecodingArrayElement( std::string key, crimild::Size index ) override;
+			virtual void endDecodingArrayElement( std::string key, crimild::Size index ) override;
+			virtual void endDecodingArray( std::string key ) override;
+
+		private:
+			template< typename T >
+			crimild::Bool decodeValue( std::string key, T &value )
+			{
+				using Plain = binary::PlainValue< T >;
+				auto data = getPlainData( findField( key ), sizeof( typename Plain::Type ) );
+				if ( data == nullptr ) {
+					value = T();
+					return false;
+				}
+
+				typename Plain::Type plain;
+				memcpy( &plain, data, sizeof( plain ) );
+				value = Plain::unpack( plain );
+				return true;
+			}
+
+			template< typename T >
+			crimild::Bool decodeArray( std::string key, containers::Array< T > &value )
+			{
+				auto field = findField( key );
+				if ( field == nullptr || field->type != binary::FieldType::BLOB ) {
+					return false;
+				}
+
+				using Plain = binary::PlainValue< T >;
+				const auto N = field->size / sizeof( typename Plain::Type );
+				const auto data = getBlobData( field );
+				value.resize( N );
+				for ( crimild::Size i = 0; i < N; i++ ) {
+					typename Plain::Type plain;
+					memcpy( &plain, data + i * sizeof( plain ), sizeof( plain ) );
+					value[ i ] = Plain::unpack( plain );
+				}
+
+				return true;
+			}
+
+			/**
+			   \brief Finds a field in the current object or the next element
+			   of the array being decoded, if any
+			 */
+			const binary::FieldRecord *findField( std::string const &key );
+
+			/**
+			   \brief Returns a pointer to the field's value if it's plain data of the given size
+			 */
+			const crimild::Byte *getPlainData( const binary::FieldRecord *field, crimild::Size size ) const;
+
+			crimild::Byte *getBlobData( const binary::FieldRecord *field ) const { return _blobs + field->offset; }
+
+			std::string getString( crimild::UInt32 index ) const;
+
+			crimild::Bool validate( void );
+
+			void decodeObject( crimild::UInt32 index );
+
+		private:
+			SharedPointer< SharedObject > _storage;
+			crimild::Byte *_data = nullptr;
+			crimild::Size _size = 0;
+
+			const binary::Header *_header = nullptr;
+			const binary::StringRecord *_strings = nullptr;
+			const binary::ObjectRecord *_objectRecords = nullptr;
+			const binary::FieldRecord *_fields = nullptr;
+			const crimild::UInt32 *_roots = nullptr;
+			crimild::Byte *_blobs = nullptr;
+
+			std::unordered_map< std::string, crimild::UInt32 > _keys;
+
+			std::vector< SharedPointer< Codable >> _objects;
+			std::vector< crimild::Bool > _decoded;
+
+			/**
+			   \brief Index of the object being decoded
+			 */
+			crimild::UInt32 _current = binary::INVALID_INDEX;
+
+			struct ArrayScope {
+				crimild::Size next;
+				crimild::Size end;
+			};
+
+			/**
+			   \brief Arrays being decoded in the current object
+			 */
+			std::vector< ArrayScope > _arrays;
+        };
+        
+	}
+    
+}
+
+#endif
+
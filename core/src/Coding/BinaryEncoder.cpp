@@ -0,0 +1,321 @@
+/*
+ * Copyright (c) 2013, Hernan Saez
+ * All rights reserved.
+ * 
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *     * Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in the
+ *       documentation and/or other materials provided with the distribution.
+ *     * Neither the name of the <organization> nor the
+ *       names of its contributors may be used to endorse or promote products
+ *       derived from this software without specific prior written permission.
+ * 
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL <COPYRIGHT HOLDER> BE LIABLE FOR ANY
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "BinaryEncoder.hpp"
+
+#include "Foundation/Log.hpp"
+#include "Foundation/Version.hpp"
+
+#include <cstdio>
+
+using namespace crimild;
+using namespace crimild::coding;
+
+BinaryEncoder::BinaryEncoder( void )
+{
+
+}
+
+BinaryEncoder::~BinaryEncoder( void )
+{
+
+}
+
+crimild::Bool BinaryEncoder::encode( SharedPointer< Codable > const &obj )
+{
+	if ( obj == nullptr ) {
+		return false;
+	}
+
+	auto isRoot = _current == binary::INVALID_INDEX;
+	auto index = encodeObject( obj );
+
+	if ( isRoot && std::find( _roots.begin(), _roots.end(), index ) == _roots.end() ) {
+		_roots.push_back( index );
+	}
+
+	return true;
+}
+
+crimild::Bool BinaryEncoder::encode( std::string key, SharedPointer< Codable > const &obj )
+{
+	if ( _current == binary::INVALID_INDEX ) {
+		Log::error( CRIMILD_CURRENT_CLASS_NAME, "Cannot encode links outside an object" );
+		return false;
+	}
+
+	// null links are encoded anyway to keep array elements in order
+	auto index = obj != nullptr ? encodeObject( obj ) : binary::INVALID_INDEX;
+	addField( key, binary::FieldType::LINK, index );
+
+	return obj != nullptr;
+}
+
+crimild::Bool BinaryEncoder::encode( std::string key, std::string value )
+{
+	return encodeBlob( key, value.c_str(), value.length() );
+}
+
+crimild::Bool BinaryEncoder::encodeBlob( std::string key, const void *data, crimild::Size size )
+{
+	auto offset = binary::align( _blobs.size() );
+
+	auto &field = addField( key, binary::FieldType::BLOB, size );
+	field.offset = offset;
+
+	_blobs.resize( offset + size );
+	if ( size > 0 ) {
+		memcpy( &_blobs[ offset ], data, size );
+	}
+
+	return true;
+}
+
+void BinaryEncoder::encodeArrayBegin( std::string key, crimild::Size count )
+{
+	addField( key, binary::FieldType::ARRAY, count );
+	_arrays.push_back( _objects[ _current ].fields.size() - 1 );
+}
+
+std::string BinaryEncoder::beginEncodingArrayElement( std::string key, crimild::Size index )
+{
+	// elements are identified by their position, so there's no need for unique keys
+	return key;
+}
+
+void BinaryEncoder::endEncodingArrayElement( std::string key, crimild::Size index )
+{
+	// no-op
+}
+
+void BinaryEncoder::encodeArrayEnd( std::string key )
+{
+	auto &fields = _objects[ _current ].fields;
+	auto header = _arrays.back();
+	_arrays.pop_back();
+
+	fields[ header ].span = fields.size() - header - 1;
+}
+
+binary::FieldRecord &BinaryEncoder::addField( std::string const &key, binary::FieldType type, crimild::UInt64 size )
+{
+	binary::FieldRecord field;
+	memset( &field, 0, sizeof( binary::FieldRecord ) );
+	field.key = addString( key );
+	field.type = type;
+	field.size = size;
+
+	auto &fields = _objects[ _current ].fields;
+	fields.push_back( field );
+	return fields.back();
+}
+
+crimild::UInt32 BinaryEncoder::addString( std::string const &str )
+{
+	auto it = _stringIndices.find( str );
+	if ( it != _stringIndices.end() ) {
+		return it->second;
+	}
+
+	auto index = static_cast< crimild::UInt32 >( _strings.size() );
+	_strings.push_back( str );
+	_stringIndices[ str ] = index;
+	return index;
+}
+
+crimild::UInt32 BinaryEncoder::encodeObject( SharedPointer< Codable > const &obj )
+{
+	auto it = _objectIndices.find( obj->getUniqueID() );
+	if ( it != _objectIndices.end() ) {
+		return it->second;
+	}
+
+	// register the object before encoding it to support cycles
+	auto index = static_cast< crimild::UInt32 >( _objects.size() );
+	_objectIndices[ obj->getUniqueID() ] = index;
+
+	ObjectEntry entry;
+	entry.object = obj;
+	entry.className = addString( obj->getClassName() );
+	_objects.push_back( entry );
+
+	auto previous = _current;
+	std::vector< crimild::Size > arrays;
+	std::swap( arrays, _arrays );
+	_current = index;
+
+	obj->encode( *this );
+
+	_current = previous;
+	std::swap( arrays, _arrays );
+
+	return index;
+}
+
+void BinaryEncoder::buildMetadata( std::vector< crimild::Byte > &out ) const
+{
+	crimild::Size fieldCount = 0;
+	for ( const auto &obj : _objects ) {
+		fieldCount += obj.fields.size();
+	}
+
+	crimild::Size charCount = 0;
+	for ( const auto &str : _strings ) {
+		charCount += str.length() + 1;
+	}
+
+	auto versionString = getVersion().getDescription();
+	charCount += versionString.length() + 1;
+	auto stringCount = _strings.size() + 1;
+
+	binary::Header header;
+	memset( &header, 0, sizeof( binary::Header ) );
+	memcpy( header.magic, binary::MAGIC, sizeof( binary::MAGIC ) );
+	header.formatVersion = binary::FORMAT_VERSION;
+	header.versionString = _strings.size();
+
+	header.stringsOffset = binary::align( sizeof( binary::Header ) );
+	header.stringCount = stringCount;
+	header.objectsOffset = binary::align( header.stringsOffset + stringCount * sizeof( binary::StringRecord ) + charCount );
+	header.objectCount = _objects.size();
+	header.fieldsOffset = binary::align( header.objectsOffset + _objects.size() * sizeof( binary::ObjectRecord ) );
+	header.fieldCount = fieldCount;
+	header.rootsOffset = binary::align( header.fieldsOffset + fieldCount * sizeof( binary::FieldRecord ) );
+	header.rootCount = _roots.size();
+	header.blobsOffset = binary::align( header.rootsOffset + _roots.size() * sizeof( crimild::UInt32 ) );
+	header.blobsSize = _blobs.size();
+
+	out.assign( header.blobsOffset, 0 );
+	memcpy( &out[ 0 ], &header, sizeof( binary::Header ) );
+
+	// strings
+	auto records = reinterpret_cast< binary::StringRecord * >( &out[ header.stringsOffset ] );
+	auto charOffset = header.stringsOffset + stringCount * sizeof( binary::StringRecord );
+	auto writeString = [ & ]( std::string const &str ) {
+		records->offset = charOffset;
+		records->length = str.length();
+		++records;
+		memcpy( &out[ charOffset ], str.c_str(), str.length() + 1 );
+		charOffset += str.length() + 1;
+	};
+	for ( const auto &str : _strings ) {
+		writeString( str );
+	}
+	writeString( versionString );
+
+	// objects and fields
+	auto objects = reinterpret_cast< binary::ObjectRecord * >( &out[ header.objectsOffset ] );
+	auto fields = reinterpret_cast< binary::FieldRecord * >( &out[ header.fieldsOffset ] );
+	crimild::UInt32 firstField = 0;
+	for ( const auto &obj : _objects ) {
+		objects->className = obj.className;
+		objects->reserved = 0;
+		objects->firstField = firstField;
+		objects->fieldCount = obj.fields.size();
+		++objects;
+
+		if ( obj.fields.size() > 0 ) {
+			memcpy( fields + firstField, &obj.fields[ 0 ], obj.fields.size() * sizeof( binary::FieldRecord ) );
+			firstField += obj.fields.size();
+		}
+	}
+
+	// roots
+	if ( _roots.size() > 0 ) {
+		memcpy( &out[ header.rootsOffset ], &_roots[ 0 ], _roots.size() * sizeof( crimild::UInt32 ) );
+	}
+}
+
+containers::ByteArray BinaryEncoder::getBytes( void ) const
+{
+	std::vector< crimild::Byte > metadata;
+	buildMetadata( metadata );
+
+	containers::ByteArray result( metadata.size() + _blobs.size() );
+	memcpy( result.getData(), &metadata[ 0 ], metadata.size() );
+	if ( _blobs.size() > 0 ) {
+		memcpy( result.getData() + metadata.size(), &_blobs[ 0 ], _blobs.size() );
+	}
+
+	return result;
+}
+
+crimild::Bool BinaryEncoder::write( std::string filePath ) const
+{
+	if ( _objects.size() == 0 ) {
+		Log::error( CRIMILD_CURRENT_CLASS_NAME, "Not enough data to write" );
+		return false;
+	}
+
+	FILE *file = fopen( filePath.c_str(), "wb" );
+	if ( file == nullptr ) {
+		Log::error( CRIMILD_CURRENT_CLASS_NAME, "Cannot open file ", filePath );
+		return false;
+	}
+
+	// write sections directly from their sources, avoiding
+	// an extra copy of the whole payload
+	std::vector< crimild::Byte > metadata;
+	buildMetadata( metadata );
+
+	auto success = fwrite( &metadata[ 0 ], 1, metadata.size(), file ) == metadata.size();
+	if ( success && _blobs.size() > 0 ) {
+		success = fwrite( &_blobs[ 0 ], 1, _blobs.size(), file ) == _blobs.size();
+	}
+
+	fclose( file );
+
+	if ( !success ) {
+		Log::error( CRIMILD_CURRENT_CLASS_NAME, "Cannot write file ", filePath );
+	}
+
+	return success;
+}
+
+std::string BinaryEncoder::dump( void )
+{
+	std::stringstream ss;
+
+	ss << "Objects:\n";
+	for ( crimild::Size i = 0; i < _objects.size(); i++ ) {
+		const auto &obj = _objects[ i ];
+		ss << "\t" << i << " " << _strings[ obj.className ] << "\n";
+		for ( const auto &field : obj.fields ) {
+			ss << "\t\t" << _strings[ field.key ] << " " << static_cast< crimild::UInt32 >( field.type ) << " " << field.size << "\n";
+		}
+	}
+
+	ss << "Roots:\n";
+	for ( auto root : _roots ) {
+		ss << "\t" << root << "\n";
+	}
+
+	ss << "Blobs: " << _blobs.size() << " bytes\n";
+
+	return ss.str();
+}
+
@@ -0,0 +1,186 @@
+/*
+ * Copyright (c) 2013, Hernan Saez
+ * All rights reserved.
+ * 
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *     * Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in the
+ *       documentation and/or other materials provided with the distribution.
+ *     * Neither the name of the <organization> nor the
+ *       names of its contributors may be used to endorse or promote products
+ *       derived from this software without specific prior written permission.
+ * 
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL <COPYRIGHT HOLDER> BE LIABLE FOR ANY
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef CRIMILD_CORE_CODING_BINARY_ENCODER_
+#define CRIMILD_CORE_CODING_BINARY_ENCODER_
+
+#include "Codable.hpp"
+#include "Encoder.hpp"
+#include "BinaryFormat.hpp"
+
+#include <cstring>
+#include <type_traits>
+#include <unordered_map>
+#include <vector>
+
+namespace crimild {
+
+	namespace coding {
+
+		/**
+		   \brief Encodes objects into a binary container
+
+		   See BinaryFormat.hpp for a description of the layout. Shared objects 
+		   are encoded only once. Use BinaryDecoder to read the resulting data.
+		 */
+        class BinaryEncoder : public Encoder {
+        public:
+            BinaryEncoder( void );
+            virtual ~BinaryEncoder( void );
+
+		public:
+            virtual crimild::Bool encode( SharedPointer< Codable > const &obj ) override;
+            virtual crimild::Bool encode( std::string key, SharedPointer< Codable > const &obj ) override;
+            
+            virtual crimild::Bool encode( std::string key, std::string value ) override;
+            
+            virtual crimild::Bool encode( std::string key, const Transformation &value ) override { return encodeValue( key, value ); }
+            virtual crimild::Bool encode( std::string key, crimild::Size value ) override { return encodeValue( key, value ); }
+            virtual crimild::Bool encode( std::string key, crimild::UInt8 value ) override { return encodeValue( key, value ); }
+            virtual crimild::Bool encode( std::string key, crimild::UInt16 value ) override { return encodeValue( key, value ); }
+            virtual crimild::Bool encode( std::string key, crimild::Int16 value ) override { return encodeValue( key, value ); }
+            virtual crimild::Bool encode( std::string key, crimild::Int32 value ) override { return encodeValue( key, value ); }
+            virtual crimild::Bool encode( std::string key, crimild::UInt32 value ) override { return encodeValue( key, value ); }
+            virtual crimild::Bool encode( std::string key, crimild::Real32 value ) override { return encodeValue( key, value ); }
+            virtual crimild::Bool encode( std::string key, crimild::Real64 value ) override { return encodeValue( key, value ); }
+            virtual crimild::Bool encode( std::string key, const Vector2f &value ) override { return encodeValue( key, value ); }
+            virtual crimild::Bool encode( std::string key, const Vector3f &value ) override { return encodeValue( key, value ); }
+            virtual crimild::Bool encode( std::string key, const Vector4f &value ) override { return encodeValue( key, value ); }
+            virtual crimild::Bool encode( std::string key, const Matrix3f &value ) override { return encodeValue( key, value ); }
+            virtual crimild::Bool encode( std::string key, const Matrix4f &value ) override { return encodeValue( key, value ); }
+            virtual crimild::Bool encode( std::string key, const Quaternion4f &value ) override { return encodeValue( key, value ); }
+            virtual crimild::Bool encode( std::string key, crimild::Bool value ) override { return encodeValue( key, value ); }
+            virtual crimild::Bool encode( std::string key, const crimild::VertexFormat &value ) override { return encodeValue( key, value ); }
+
+			virtual crimild::Bool encode( std::string key, containers::ByteArray &value ) override { return encodeArray( key, value ); }
+			virtual crimild::Bool encode( std::string key, containers::Array< crimild::Real32 > &value ) override { return encodeArray( key, value ); }
+			virtual crimild::Bool encode( std::string key, containers::Array< Vector3f > &value ) override { return encodeArray( key, value ); }
+			virtual crimild::Bool encode( std::string key, containers::Array< Vector4f > &value ) override { return encodeArray( key, value ); }
+			virtual crimild::Bool encode( std::string key, containers::Array< Matrix3f > &value ) override { return encodeArray( key, value ); }
+			virtual crimild::Bool encode( std::string key, containers::Array< Matrix4f > &value ) override { return encodeArray( key, value ); }
+			virtual crimild::Bool encode( std::string key, containers::Array< Quaternion4f > &value ) override { return encodeArray( key, value ); }
+
+			virtual crimild::Bool encodeBytes( std::string key, const crimild::Byte *data, crimild::Size size ) override { return encodeBlob( key, data, size ); }
+
+            containers::ByteArray getBytes( void ) const;
+
+			/**
+			   \brief Writes the encoded data to a file
+			 */
+			crimild::Bool write( std::string filePath ) const;
+            
+        protected:
+			virtual void encodeArrayBegin( std::string key, crimild::Size count ) override;
+			virtual std::string beginEncodingArrayElement( std::string key, crimild::Size index ) override;
+			virtual void endEncodingArrayElement( std::string key, crimild::Size index ) override;
+			virtual void encodeArrayEnd( std::string key ) override;
+
+        private:
+            template< typename T >
+            crimild::Bool encodeValue( std::string key, const T &value )
+            {
+				using Plain = binary::PlainValue< T >;
+				const auto plain = Plain::pack( value );
+				const auto size = sizeof( typename Plain::Type );
+
+				if ( size > binary::INLINE_VALUE_SIZE ) {
+					return encodeBlob( key, &plain, size );
+				}
+
+				auto &field = addField( key, binary::FieldType::VALUE, size );
+				memcpy( field.bytes, &plain, size );
+				return true;
+            }
+
+			template< typename T >
+			crimild::Bool encodeArray( std::string key, containers::Array< T > &value )
+			{
+				if ( std::is_trivially_copyable< T >::value ) {
+					return encodeBlob( key, value.getData(), value.size() * sizeof( T ) );
+				}
+
+				using Plain = binary::PlainValue< T >;
+				std::vector< typename Plain::Type > plain( value.size() );
+				for ( crimild::Size i = 0; i < plain.size(); i++ ) {
+					plain[ i ] = Plain::pack( value[ i ] );
+				}
+				return encodeBlob( key, plain.data(), plain.size() * sizeof( typename Plain::Type ) );
+			}
+
+			crimild::Bool encodeBlob( std::string key, const void *data, crimild::Size size );
+
+			binary::FieldRecord &addField( std::string const &key, binary::FieldType type, crimild::UInt64 size );
+
+			crimild::UInt32 addString( std::string const &str );
+
+			/**
+			   \brief Registers and encodes an object, if needed
+			 */
+			crimild::UInt32 encodeObject( SharedPointer< Codable > const &obj );
+
+			/**
+			   \brief Generates everything but the blobs section, including
+			   padding so the blobs section starts at an aligned offset
+			 */
+			void buildMetadata( std::vector< crimild::Byte > &out ) const;
+
+		private:
+			struct ObjectEntry {
+				SharedPointer< Codable > object;
+				crimild::UInt32 className;
+				std::vector< binary::FieldRecord > fields;
+			};
+
+			std::vector< ObjectEntry > _objects;
+			std::unordered_map< Codable::UniqueID, crimild::UInt32 > _objectIndices;
+			std::vector< crimild::UInt32 > _roots;
+
+			std::vector< std::string > _strings;
+			std::unordered_map< std::string, crimild::UInt32 > _stringIndices;
+
+			std::vector< crimild::Byte > _blobs;
+
+			/**
+			   \brief Index of the object being encoded
+			 */
+			crimild::UInt32 _current = binary::INVALID_INDEX;
+
+			/**
+			   \brief Field indices for the arrays being encoded in the current object
+			 */
+			std::vector< crimild::Size > _arrays;
+
+        public:
+            virtual std::string dump( void ) override;
+        };
+        
+	}
+    
+}
+
+#endif
+
@@ -0,0 +1,291 @@
+/*
+ * Copyright (c) 2013, Hernan Saez
+ * All rights reserved.
+ * 
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *     * Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in the
+ *       documentation and/or other materials provided with the distribution.
+ *     * Neither the name of the <organization> nor the
+ *       names of its contributors may be used to endorse or promote products
+ *       derived from this software without specific prior written permission.
+ * 
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL <COPYRIGHT HOLDER> BE LIABLE FOR ANY
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef CRIMILD_CORE_CODING_BINARY_FORMAT_
+#define CRIMILD_CORE_CODING_BINARY_FORMAT_
+
+#include "Foundation/Types.hpp"
+#include "Mathematics/Vector.hpp"
+#include "Mathematics/Matrix.hpp"
+#include "Mathematics/Quaternion.hpp"
+#include "Mathematics/Transformation.hpp"
+#include "Rendering/VertexFormat.hpp"
+
+#include <type_traits>
+
+namespace crimild {
+
+	namespace coding {
+
+		/**
+		   \brief Layout of binary containers
+
+		   A binary container is organized in sections, each of them starting
+		   at a 16-byte aligned offset from the beginning of the data:
+
+		   - Header
+		   - String table: one StringRecord per string, followed by the
+		     null-terminated characters. Keys and class names are stored once.
+		   - Objects: one fixed-size ObjectRecord per encoded object
+		   - Fields: fixed-size FieldRecords, grouped by object
+		   - Roots: indices of the root objects
+		   - Blobs: strings and array payloads, each of them 16-byte aligned
+
+		   Values up to 16 bytes long are stored inline in their field records.
+		   Math types are stored as plain arrays of components (see PlainValue).
+		   Arrays of elements that are not plain data (i.e. objects) are stored as an
+		   ARRAY field followed by one field per element. 
+
+		   All values are stored using the native byte order.
+		 */
+		namespace binary {
+
+			constexpr crimild::Size ALIGNMENT = 16;
+			constexpr crimild::Size INLINE_VALUE_SIZE = 16;
+			constexpr crimild::UInt32 FORMAT_VERSION = 1;
+			constexpr crimild::UInt32 INVALID_INDEX = 0xFFFFFFFF;
+
+			inline crimild::Size align( crimild::Size offset )
+			{
+				return ( offset + ALIGNMENT - 1 ) & ~( ALIGNMENT - 1 );
+			}
+
+			struct Header {
+				crimild::Char magic[ 8 ];
+				crimild::UInt32 formatVersion;
+				crimild::UInt32 versionString;
+
+				crimild::UInt64 stringsOffset;
+				crimild::UInt64 stringCount;
+				crimild::UInt64 objectsOffset;
+				crimild::UInt64 objectCount;
+				crimild::UInt64 fieldsOffset;
+				crimild::UInt64 fieldCount;
+				crimild::UInt64 rootsOffset;
+				crimild::UInt64 rootCount;
+				crimild::UInt64 blobsOffset;
+				crimild::UInt64 blobsSize;
+			};
+
+			static const crimild::Char MAGIC[ 8 ] = { 'C', 'R', 'I', 'M', 'I', 'L', 'D', 'B' };
+
+			struct StringRecord {
+				/**
+				   \brief Offset relative to the beginning of the data
+				 */
+				crimild::UInt32 offset;
+				crimild::UInt32 length;
+			};
+
+			struct ObjectRecord {
+				crimild::UInt32 className;
+				crimild::UInt32 reserved;
+				crimild::UInt32 firstField;
+				crimild::UInt32 fieldCount;
+			};
+
+			enum class FieldType : crimild::UInt32 {
+				/**
+				   \brief Plain data stored inline
+				 */
+				VALUE,
+
+				/**
+				   \brief Plain data stored in the blobs section
+				 */
+				BLOB,
+
+				/**
+				   \brief A reference to another object
+				 */
+				LINK,
+
+				/**
+				   \brief Array header, followed by one field per element
+				 */
+				ARRAY,
+			};
+
+			struct FieldRecord {
+				crimild::UInt32 key;
+				FieldType type;
+
+				/**
+				   \brief Value size in bytes (VALUE and BLOB), object index (LINK)
+				   or element count (ARRAY)
+				 */
+				crimild::UInt64 size;
+
+				union {
+					/**
+					   \brief Inline value (VALUE)
+					 */
+					crimild::Byte bytes[ INLINE_VALUE_SIZE ];
+
+					/**
+					   \brief Offset relative to the blobs section (BLOB)
+					 */
+					crimild::UInt64 offset;
+
+					/**
+					   \brief Number of records used by the array elements, 
+					   including nested ones (ARRAY)
+					 */
+					crimild::UInt64 span;
+				};
+			};
+
+			static_assert( sizeof( Header ) % ALIGNMENT == 0, "Invalid binary header size" );
+			static_assert( sizeof( ObjectRecord ) == 16, "Invalid binary object record size" );
+			static_assert( sizeof( FieldRecord ) == 32, "Invalid binary field record size" );
+
+			/**
+			   \brief Converts values to and from the representation stored in fields
+
+			   Only trivially copyable types are stored as-is. Math types are 
+			   stored as plain arrays of their components, so values are never
+			   copied byte by byte into (or out of) non-trivial classes.
+			 */
+			template< typename T >
+			struct PlainValue {
+				static_assert( std::is_trivially_copyable< T >::value, "Value must be trivially copyable" );
+
+				using Type = T;
+
+				static Type pack( T const &value ) { return value; }
+				static T unpack( Type const &plain ) { return plain; }
+			};
+
+			template< crimild::Size SIZE, typename PRECISION >
+			struct PlainValue< Vector< SIZE, PRECISION >> {
+				struct Type {
+					PRECISION data[ SIZE ];
+				};
+
+				static Type pack( Vector< SIZE, PRECISION > const &value )
+				{
+					Type plain;
+					for ( crimild::Size i = 0; i < SIZE; i++ ) {
+						plain.data[ i ] = value[ i ];
+					}
+					return plain;
+				}
+
+				static Vector< SIZE, PRECISION > unpack( Type const &plain ) { return Vector< SIZE, PRECISION >( plain.data ); }
+			};
+
+			template< crimild::Size SIZE, typename PRECISION >
+			struct PlainValue< Matrix< SIZE, PRECISION >> {
+				struct Type {
+					PRECISION data[ SIZE * SIZE ];
+				};
+
+				static Type pack( Matrix< SIZE, PRECISION > const &value )
+				{
+					Type plain;
+					for ( crimild::Size i = 0; i < SIZE * SIZE; i++ ) {
+						plain.data[ i ] = value[ i ];
+					}
+					return plain;
+				}
+
+				static Matrix< SIZE, PRECISION > unpack( Type const &plain ) { return Matrix< SIZE, PRECISION >( plain.data ); }
+			};
+
+			template< typename PRECISION >
+			struct PlainValue< Quaternion< PRECISION >> {
+				using Type = typename PlainValue< Vector< 4, PRECISION >>::Type;
+
+				static Type pack( Quaternion< PRECISION > const &value ) { return PlainValue< Vector< 4, PRECISION >>::pack( value.getRawData() ); }
+				static Quaternion< PRECISION > unpack( Type const &plain ) { return Quaternion< PRECISION >( PlainValue< Vector< 4, PRECISION >>::unpack( plain ) ); }
+			};
+
+			template<>
+			struct PlainValue< Transformation > {
+				struct Type {
+					PlainValue< Vector3f >::Type translate;
+					PlainValue< Quaternion4f >::Type rotate;
+					crimild::Real32 scale;
+					crimild::UInt8 isIdentity;
+				};
+
+				static Type pack( Transformation const &value )
+				{
+					Type plain;
+					plain.translate = PlainValue< Vector3f >::pack( value.getTranslate() );
+					plain.rotate = PlainValue< Quaternion4f >::pack( value.getRotate() );
+					plain.scale = value.getScale();
+					plain.isIdentity = value.isIdentity() ? 1 : 0;
+					return plain;
+				}
+
+				static Transformation unpack( Type const &plain )
+				{
+					Transformation value;
+					if ( !plain.isIdentity ) {
+						value.setTranslate( PlainValue< Vector3f >::unpack( plain.translate ) );
+						value.setRotate( PlainValue< Quaternion4f >::unpack( plain.rotate ) );
+						value.setScale( plain.scale );
+					}
+					return value;
+				}
+			};
+
+			template<>
+			struct PlainValue< VertexFormat > {
+				struct Type {
+					crimild::UInt8 components[ 7 ];
+				};
+
+				static Type pack( VertexFormat const &value )
+				{
+					return Type { {
+						value.getPositionComponents(),
+						value.getColorComponents(),
+						value.getNormalComponents(),
+						value.getTangentComponents(),
+						value.getTextureCoordComponents(),
+						value.getBoneIdComponents(),
+						value.getBoneWeightComponents(),
+					} };
+				}
+
+				static VertexFormat unpack( Type const &plain )
+				{
+					auto &c = plain.components;
+					return VertexFormat( c[ 0 ], c[ 1 ], c[ 2 ], c[ 3 ], c[ 4 ], c[ 5 ], c[ 6 ] );
+				}
+			};
+
+		}
+
+	}
+
+}
+
+#endif
+
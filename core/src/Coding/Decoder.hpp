@@ -99,6 +99,25 @@ namespace crimild {
             virtual crimild::Bool decode( std::string key, containers::Array< Matrix4f > &value ) = 0;
             virtual crimild::Bool decode( std::string key, containers::Array< Quaternion4f > &value ) = 0;
 
+			/**
+			   \brief A block of decoded bytes that is owned by the decoder's storage
+
+			   The storage object must be kept alive for as long as the data is in use
+			 */
+			struct BlobView {
+				crimild::Byte *data = nullptr;
+				crimild::Size size = 0;
+				SharedPointer< SharedObject > storage;
+			};
+
+			/**
+			   \brief Decodes a block of bytes without copying it
+
+			   Returns false if the decoder does not support zero-copy access. In
+			   that case, the value must be decoded using one of the array overloads
+			 */
+			virtual crimild::Bool decodeBlob( std::string key, BlobView &blob ) { return false; }
+
             template< typename T >
             crimild::Bool decode( std::string key, containers::Array< SharedPointer< T >> &value )
             {
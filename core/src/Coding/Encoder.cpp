@@ -27,6 +27,8 @@
 
 #include "Encoder.hpp"
 
+#include <cstring>
+
 using namespace crimild;
 using namespace crimild::coding;
 
@@ -40,6 +42,15 @@ Encoder::~Encoder( void )
 
 }
 
+crimild::Bool Encoder::encodeBytes( std::string key, const crimild::Byte *data, crimild::Size size )
+{
+	containers::ByteArray bytes( size );
+	if ( size > 0 ) {
+		memcpy( bytes.getData(), data, size );
+	}
+	return encode( key, bytes );
+}
+
 std::string Encoder::dump( void )
 {
     return "empty";
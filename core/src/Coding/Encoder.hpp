@@ -90,6 +90,15 @@ namespace crimild {
 			virtual crimild::Bool encode( std::string key, containers::Array< Matrix3f > & ) = 0;
 			virtual crimild::Bool encode( std::string key, containers::Array< Matrix4f > & ) = 0;
 			virtual crimild::Bool encode( std::string key, containers::Array< Quaternion4f > & ) = 0;
+
+			/**
+			   \brief Encodes a block of bytes not owned by a ByteArray
+
+			   Decoded the same way as a ByteArray. By default, bytes are 
+			   copied into a temporary array, but encoders supporting blobs
+			   can write them directly.
+			 */
+			virtual crimild::Bool encodeBytes( std::string key, const crimild::Byte *data, crimild::Size size );
             
             template< typename T, typename U >
             crimild::Bool encode( std::string key, containers::Array< T, U > &a )
@@ -27,6 +27,11 @@
 
 #include "FileDecoder.hpp"
 #include "Foundation/Log.hpp"
+#include "Foundation/MappedFile.hpp"
+#include "Mathematics/Numeric.hpp"
+
+#include <cstdio>
+#include <cstring>
 
 using namespace crimild;
 using namespace crimild::coding;
@@ -41,26 +46,136 @@ FileDecoder::~FileDecoder( void )
 
 }
 
+namespace crimild {
+
+	namespace coding {
+
+		namespace internal {
+
+			/**
+			   \brief Reads a file in chunks, using a fixed-size buffer
+			 */
+			class ChunkedFileReader : public MemoryDecoder::Reader {
+			public:
+				ChunkedFileReader( FILE *file, crimild::Size size, crimild::Size chunkSize )
+					: _file( file ),
+					  _remaining( size ),
+					  _buffer( Numeric< crimild::Size >::max( 1, chunkSize ) )
+				{
+
+				}
+
+				virtual ~ChunkedFileReader( void )
+				{
+
+				}
+
+				virtual crimild::Bool readRawBytes( void *data, crimild::Size count ) override
+				{
+					auto out = static_cast< crimild::Byte * >( data );
+
+					while ( count > 0 ) {
+						if ( _offset == _available ) {
+							if ( count >= _buffer.size() ) {
+								// large values skip the buffer completely
+								return readFromFile( out, count ) == count;
+							}
+
+							_offset = 0;
+							_available = readFromFile( _buffer.getData(), _buffer.size() );
+							if ( _available == 0 ) {
+								return false;
+							}
+						}
+
+						auto n = Numeric< crimild::Size >::min( count, _available - _offset );
+						memcpy( out, _buffer.getData() + _offset, n );
+						_offset += n;
+						out += n;
+						count -= n;
+					}
+
+					return true;
+				}
+
+			private:
+				crimild::Size readFromFile( crimild::Byte *out, crimild::Size count )
+				{
+					count = Numeric< crimild::Size >::min( count, _remaining );
+					auto n = fread( out, 1, count, _file );
+					_remaining -= n;
+					return n;
+				}
+
+			private:
+				FILE *_file = nullptr;
+				crimild::Size _remaining = 0;
+				containers::ByteArray _buffer;
+				crimild::Size _offset = 0;
+				crimild::Size _available = 0;
+			};
+
+		}
+
+	}
+
+}
+
 crimild::Bool FileDecoder::read( std::string filePath )
 {
+	return read( filePath, nullptr );
+}
+
+crimild::Bool FileDecoder::read( std::string filePath, RootCallback const &callback )
+{
+	if ( isParallelDecodingEnabled() ) {
+		return readMapped( filePath, callback );
+	}
+
 	FILE *file = fopen( filePath.c_str(), "rb" );
 	if ( file == nullptr ) {
 		Log::error( CRIMILD_CURRENT_CLASS_NAME, "Cannot open file ", filePath );
 		return false;
 	}
 
-	crimild::Size size;
-	fread( &size, 1, sizeof( crimild::Size ), file );
+	crimild::Size size = 0;
+	if ( fread( &size, 1, sizeof( crimild::Size ), file ) != sizeof( crimild::Size ) ) {
+		Log::error( CRIMILD_CURRENT_CLASS_NAME, "Cannot read file ", filePath );
+		fclose( file );
+		return false;
+	}
 
+	auto success = true;
 	if ( size > 0 ) {
-		containers::ByteArray bytes( size );
-		fread( &bytes[ 0 ], 1, size, file );
-		fromBytes( bytes );
+		internal::ChunkedFileReader reader( file, size, getChunkSize() );
+		success = decodeFrom( reader, callback );
 	}
 
 	fclose( file );
 	
-	return true;
+	return success;
 }
 
+crimild::Bool FileDecoder::readMapped( std::string filePath, RootCallback const &callback )
+{
+	// records are parsed in parallel, so the whole file must be accessible
+	auto file = crimild::alloc< MappedFile >();
+	if ( !file->open( filePath ) ) {
+		Log::error( CRIMILD_CURRENT_CLASS_NAME, "Cannot open file ", filePath );
+		return false;
+	}
+
+	crimild::Size size = 0;
+	if ( file->getSize() < sizeof( crimild::Size ) ) {
+		Log::error( CRIMILD_CURRENT_CLASS_NAME, "Cannot read file ", filePath );
+		return false;
+	}
+	memcpy( &size, file->getData(), sizeof( crimild::Size ) );
 
+	if ( size > file->getSize() - sizeof( crimild::Size ) ) {
+		Log::error( CRIMILD_CURRENT_CLASS_NAME, "Invalid file size ", filePath );
+		return false;
+	}
+
+	return size == 0 || decodeParallel( file->getData() + sizeof( crimild::Size ), size, callback );
+}
@@ -40,6 +40,28 @@ namespace crimild {
 			virtual ~FileDecoder( void );
 
 			crimild::Bool read( std::string filePath );
+
+			/**
+			   \brief Reads and decodes a file incrementally
+
+			   The file is read in chunks of getChunkSize() bytes (large values are read
+			   directly into their destination), so the whole file is never kept in memory.
+			   The callback is invoked for every root object as soon as it and all
+			   of its dependencies are decoded, before reaching the end of the file.
+
+			   If parallel decoding is enabled, the file is memory-mapped instead
+			   and roots are notified once all objects are decoded.
+			 */
+			crimild::Bool read( std::string filePath, RootCallback const &callback );
+
+			crimild::Size getChunkSize( void ) const { return _chunkSize; }
+			void setChunkSize( crimild::Size chunkSize ) { _chunkSize = chunkSize; }
+
+		private:
+			crimild::Bool readMapped( std::string filePath, RootCallback const &callback );
+
+		private:
+			crimild::Size _chunkSize = 64 * 1024;
 		};
         
 	}
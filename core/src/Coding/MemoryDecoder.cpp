@@ -31,8 +31,14 @@
 
 #include "Foundation/Log.hpp"
 #include "Foundation/ObjectFactory.hpp"
+#include "Concurrency/ParallelFor.hpp"
 
+#include <algorithm>
+#include <atomic>
+#include <cstring>
 #include <sstream>
+#include <unordered_map>
+#include <vector>
 
 using namespace crimild;
 using namespace crimild::containers;
@@ -48,22 +54,37 @@ MemoryDecoder::~MemoryDecoder( void )
 
 }
 
+SharedPointer< Codable > MemoryDecoder::getLink( std::string const &key )
+{
+	return _links[ _currentObj->getUniqueID() ][ key ];
+}
+
 crimild::Bool MemoryDecoder::decode( std::string key, SharedPointer< coding::Codable > &codable )
 {
-	codable = _links[ _currentObj->getUniqueID() ][ key ];
+	codable = getLink( key );
     if ( codable == nullptr ) {
         return false;
     }
-	
+
+    decodeObject( codable );
+
+	return true;
+}
+
+void MemoryDecoder::decodeObject( SharedPointer< Codable > const &obj )
+{
+    // shared objects are decoded only once
+    if ( !_decodedObjects.insert( obj->getUniqueID() ).second ) {
+        return;
+    }
+
 	auto temp = _currentObj;
-	_currentObj = codable;
+	_currentObj = obj;
 
     auto &self = *this;
-	codable->decode( self );
+	obj->decode( self );
 
 	_currentObj = temp;
-
-	return true;
 }
 
 crimild::Bool MemoryDecoder::decode( std::string key, std::string &value )
@@ -74,7 +95,10 @@ crimild::Bool MemoryDecoder::decode( std::string key, std::string &value )
 	}
     
     if ( l > 0 ) {
-        auto obj = crimild::cast_ptr< EncodedData >( _links[ _currentObj->getUniqueID() ][ key ] );
+        auto obj = crimild::cast_ptr< EncodedData >( getLink( key ) );
+        if ( obj == nullptr || obj->getBytes().size() < l ) {
+            return false;
+        }
 
         containers::ByteArray data( l + 1 );
         memcpy( &data[ 0 ], obj->getBytes().getData(), l );
@@ -109,40 +133,108 @@ void MemoryDecoder::endDecodingArray( std::string key )
 	// no-op
 }
 
+namespace crimild {
+
+    namespace coding {
+
+        namespace internal {
+
+            class ByteArrayReader : public MemoryDecoder::Reader {
+            public:
+                explicit ByteArrayReader( const containers::ByteArray &bytes )
+                    : _bytes( bytes )
+                {
+
+                }
+
+                virtual ~ByteArrayReader( void )
+                {
+
+                }
+
+                virtual crimild::Bool readRawBytes( void *data, crimild::Size count ) override
+                {
+                    if ( count > _bytes.size() - _offset ) {
+                        return false;
+                    }
+
+                    memcpy( data, _bytes.getData() + _offset, sizeof( crimild::Byte ) * count );
+                    _offset += count;
+                    return true;
+                }
+
+            private:
+                const containers::ByteArray &_bytes;
+                crimild::Size _offset = 0;
+            };
+
+        }
+
+    }
+
+}
+
 crimild::Bool MemoryDecoder::fromBytes( const containers::ByteArray &bytes )
 {
-    crimild::Size offset = 0;
+    return fromBytes( bytes, nullptr );
+}
 
-	crimild::Int8 flag;
-	offset += read( bytes, flag, offset );
+crimild::Bool MemoryDecoder::fromBytes( const containers::ByteArray &bytes, RootCallback const &callback )
+{
+    if ( isParallelDecodingEnabled() ) {
+        return decodeParallel( bytes.getData(), bytes.size(), callback );
+    }
 
-	if ( flag != Tags::TAG_DATA_START ) {
+    internal::ByteArrayReader reader( bytes );
+    return decodeFrom( reader, callback );
+}
+
+crimild::Bool MemoryDecoder::decodeFrom( Reader &reader, RootCallback const &callback )
+{
+	crimild::Int8 flag;
+	if ( !read( reader, flag ) || flag != Tags::TAG_DATA_START ) {
 		Log::error( CRIMILD_CURRENT_CLASS_NAME, "Invalid data format" );
 		return false;
 	}
 
-    offset += read( bytes, flag, offset );
-    if ( flag != Tags::TAG_DATA_VERSION ) {
+    if ( !read( reader, flag ) || flag != Tags::TAG_DATA_VERSION ) {
         Log::error( CRIMILD_CURRENT_CLASS_NAME, "Invalid data format. FLAG_VERSION expected" );
         return false;
     }
     
 	std::string versionStr;
-	offset += read( bytes, versionStr, offset );
+	if ( !read( reader, versionStr ) ) {
+		Log::error( CRIMILD_CURRENT_CLASS_NAME, "Invalid data format. Cannot read version" );
+		return false;
+	}
 	setVersion( Version( versionStr ) );
 
+	crimild::Bool streamable = false;
+
 	while ( true ) {
-		offset += read( bytes, flag, offset );
+		if ( !read( reader, flag ) ) {
+			Log::error( CRIMILD_CURRENT_CLASS_NAME, "Invalid data format. Unexpected end of data" );
+			return false;
+		}
+
         if ( flag == Tags::TAG_DATA_END ) {
+			finishPendingObject();
 			break;
 		}
 
-		if ( flag == Tags::TAG_OBJECT_BEGIN ) {
-			Codable::UniqueID objID;
-			offset += read( bytes, objID, offset );
+		if ( flag == Tags::TAG_DATA_STREAMABLE ) {
+			streamable = true;
+		}
+		else if ( flag == Tags::TAG_OBJECT_BEGIN ) {
+			// the previous object has no more links
+			finishPendingObject();
 
+			Codable::UniqueID objID;
 			std::string className;
-			offset += read( bytes, className, offset );
+			if ( !read( reader, objID ) || !read( reader, className ) ) {
+				Log::error( CRIMILD_CURRENT_CLASS_NAME, "Invalid data format. Cannot read object" );
+				return false;
+			}
 
             auto obj = crimild::dynamic_cast_ptr< Codable >( ObjectFactory::getInstance()->build( className ) );
 			if ( obj == nullptr ) {
@@ -154,25 +246,30 @@ crimild::Bool MemoryDecoder::fromBytes( const containers::ByteArray &bytes )
 
 			if ( auto encoded = crimild::dynamic_cast_ptr< EncodedData >( obj ) ) {
 				ByteArray data;
-				offset += read( bytes, data, offset );
+				if ( !read( reader, data ) ) {
+					Log::error( CRIMILD_CURRENT_CLASS_NAME, "Invalid data format. Cannot read data for object ", objID );
+					return false;
+				}
 				encoded->setBytes( data );
 			}
+			else if ( streamable ) {
+				_pendingObj = obj;
+			}
 
-			offset += read( bytes, flag, offset );
-			if ( flag != Tags::TAG_OBJECT_END ) {
+			if ( !read( reader, flag ) || flag != Tags::TAG_OBJECT_END ) {
 				Log::error( CRIMILD_CURRENT_CLASS_NAME, "Invalid data format. Expected ", Tags::TAG_OBJECT_END );
 				return false;
 			}
 		}
 		else if ( flag == Tags::TAG_LINK_BEGIN ) {
 			Codable::UniqueID parentObjID;
-			offset += read( bytes, parentObjID, offset );
-
 			std::string linkName;
-			offset += read( bytes, linkName, offset );
-
 			Codable::UniqueID objID;
-			offset += read( bytes, objID, offset );
+			if ( !read( reader, parentObjID ) || !read( reader, linkName ) || !read( reader, objID ) ) {
+				Log::error( CRIMILD_CURRENT_CLASS_NAME, "Invalid data format. Cannot read link" );
+				return false;
+			}
+
 			auto obj = _objects[ objID ];
 			if ( obj == nullptr ) {
 				Log::error( CRIMILD_CURRENT_CLASS_NAME, "Invalid data format. Cannot find object with id ", objID );
@@ -186,15 +283,25 @@ crimild::Bool MemoryDecoder::fromBytes( const containers::ByteArray &bytes )
             }
 			_links[ parent->getUniqueID() ][ linkName ] = obj;
 
-			offset += read( bytes, flag, offset );
-			if ( flag != Tags::TAG_LINK_END ) {
+			if ( streamable && crimild::dynamic_cast_ptr< EncodedData >( obj ) != nullptr ) {
+				// encoded values are linked only once. Once the parent is
+				// decoded, they will be discarded along with its links
+				_objects.remove( objID );
+			}
+
+			if ( !read( reader, flag ) || flag != Tags::TAG_LINK_END ) {
 				Log::error( CRIMILD_CURRENT_CLASS_NAME, "Invalid data format. Expected ", Tags::TAG_LINK_END );
 				return false;
 			}
 		}
 		else if ( flag == Tags::TAG_ROOT_OBJECT_BEGIN ) {
+			finishPendingObject();
+
 			Codable::UniqueID objID;
-			offset += read( bytes, objID, offset );
+			if ( !read( reader, objID ) ) {
+				Log::error( CRIMILD_CURRENT_CLASS_NAME, "Invalid data format. Cannot read root object" );
+				return false;
+			}
 
 			auto obj = _objects[ objID ];
 			if ( obj == nullptr ) {
@@ -204,8 +311,15 @@ crimild::Bool MemoryDecoder::fromBytes( const containers::ByteArray &bytes )
             
             addRootObject( crimild::dynamic_cast_ptr< SharedObject >( obj ) );
 
-			offset += read( bytes, flag, offset );
-			if ( flag != Tags::TAG_ROOT_OBJECT_END ) {
+			if ( streamable ) {
+				// all of the root's dependencies have been decoded already
+				decodeObject( obj );
+				if ( callback != nullptr ) {
+					callback( crimild::dynamic_cast_ptr< SharedObject >( obj ) );
+				}
+			}
+
+			if ( !read( reader, flag ) || flag != Tags::TAG_ROOT_OBJECT_END ) {
 				Log::error( CRIMILD_CURRENT_CLASS_NAME, "Invalid data format. Expected ", Tags::TAG_ROOT_OBJECT_END );
 				return false;
 			}
@@ -215,48 +329,506 @@ crimild::Bool MemoryDecoder::fromBytes( const containers::ByteArray &bytes )
 			return false;
 		}
 	}
-    
-	auto rootCount = getObjectCount();
-    for ( crimild::Size i = 0; i < rootCount; i++ ) {
-        auto obj = crimild::dynamic_cast_ptr< Codable >( getObjectAt< SharedObject >( i ) );
-        _currentObj = obj;
-        obj->decode( *this );
-        _currentObj = nullptr;
-    }
+
+	if ( !streamable ) {
+		// links might be anywhere in the data, so roots 
+		// can only be decoded at the very end
+		auto rootCount = getObjectCount();
+		for ( crimild::Size i = 0; i < rootCount; i++ ) {
+			auto obj = crimild::dynamic_cast_ptr< Codable >( getObjectAt< SharedObject >( i ) );
+			_currentObj = nullptr;
+			decodeObject( obj );
+			if ( callback != nullptr ) {
+				callback( getObjectAt< SharedObject >( i ) );
+			}
+		}
+	}
 
 	return true;
 }
 
-crimild::Size MemoryDecoder::read( const containers::ByteArray &bytes, Codable::UniqueID &value, crimild::Size offset )
+void MemoryDecoder::finishPendingObject( void )
 {
-    return readRawBytes( bytes, &value, sizeof( Codable::UniqueID ), offset );
+	if ( _pendingObj == nullptr ) {
+		return;
+	}
+
+	auto obj = _pendingObj;
+	_pendingObj = nullptr;
+
+	// all of the object's dependencies have been read and decoded already
+	decodeObject( obj );
+
+	// discard links (and encoded values) since they are no longer needed
+	_links.remove( obj->getUniqueID() );
 }
 
-crimild::Size MemoryDecoder::read( const containers::ByteArray &bytes, crimild::Int8 &value, crimild::Size offset )
+crimild::Bool MemoryDecoder::read( Reader &reader, Codable::UniqueID &value )
 {
-    return readRawBytes( bytes, &value, sizeof( crimild::Int8 ), offset );
+    return reader.readRawBytes( &value, sizeof( Codable::UniqueID ) );
 }
 
-crimild::Size MemoryDecoder::read( const containers::ByteArray &bytes, std::string &value, crimild::Size offset )
+crimild::Bool MemoryDecoder::read( Reader &reader, crimild::Int8 &value )
+{
+    return reader.readRawBytes( &value, sizeof( crimild::Int8 ) );
+}
+
+crimild::Bool MemoryDecoder::read( Reader &reader, std::string &value )
 {
     containers::ByteArray buffer;
-    auto readBytes = read( bytes, buffer, offset );
-    value = std::string( ( const char * ) buffer.getData() );
-    return readBytes;
+    if ( !read( reader, buffer ) ) {
+        return false;
+    }
+
+    value = std::string( ( const char * ) buffer.getData(), strnlen( ( const char * ) buffer.getData(), buffer.size() ) );
+    return true;
 }
 
-crimild::Size MemoryDecoder::read( const containers::ByteArray &bytes, containers::ByteArray &value, crimild::Size offset )
+crimild::Bool MemoryDecoder::read( Reader &reader, containers::ByteArray &value )
 {
     crimild::Size count;
-    auto readBytes = readRawBytes( bytes, &count, sizeof( crimild::Size ), offset );
+    if ( !reader.readRawBytes( &count, sizeof( crimild::Size ) ) ) {
+        return false;
+    }
+
     value.resize( count );
-    readBytes += readRawBytes( bytes, value.getData(), count, offset + readBytes );
-    return readBytes;
+    return count == 0 || reader.readRawBytes( value.getData(), count );
 }
 
-crimild::Size MemoryDecoder::readRawBytes( const containers::ByteArray &bytes, void *data, crimild::Size count, crimild::Size offset )
-{
-    memcpy( data, bytes.getData() + offset, sizeof( crimild::Byte ) * count );
-    return count;
+
+namespace crimild {
+
+    namespace coding {
+
+        namespace internal {
+
+            /**
+               \brief A block of bytes inside the encoded data
+             */
+            struct ByteSpan {
+                const crimild::Byte *data = nullptr;
+                crimild::Size size = 0;
+            };
+
+            inline crimild::Bool operator<( ByteSpan const &a, ByteSpan const &b )
+            {
+                auto res = memcmp( a.data, b.data, std::min( a.size, b.size ) );
+                return res < 0 || ( res == 0 && a.size < b.size );
+            }
+
+            /**
+               \brief Reads values from memory without copying them
+             */
+            class SpanReader {
+            public:
+                SpanReader( const crimild::Byte *data, crimild::Size size )
+                    : _data( data ),
+                      _size( size )
+                {
+
+                }
+
+                template< typename T >
+                crimild::Bool read( T &value )
+                {
+                    if ( sizeof( T ) > _size - _offset ) {
+                        return false;
+                    }
+
+                    memcpy( &value, _data + _offset, sizeof( T ) );
+                    _offset += sizeof( T );
+                    return true;
+                }
+
+                crimild::Bool read( ByteSpan &value )
+                {
+                    crimild::Size count;
+                    if ( !read( count ) || count > _size - _offset ) {
+                        return false;
+                    }
+
+                    value.data = _data + _offset;
+                    value.size = count;
+                    _offset += count;
+                    return true;
+                }
+
+                /**
+                   \brief Reads a string, ignoring any trailing null characters
+                 */
+                crimild::Bool readString( ByteSpan &value )
+                {
+                    if ( !read( value ) ) {
+                        return false;
+                    }
+
+                    value.size = strnlen( ( const char * ) value.data, value.size );
+                    return true;
+                }
+
+            private:
+                const crimild::Byte *_data = nullptr;
+                crimild::Size _size = 0;
+                crimild::Size _offset = 0;
+            };
+
+            struct ObjectRecord {
+                /**
+                   \brief Index of the object's builder or NO_BUILDER for encoded values
+                 */
+                crimild::UInt32 builder;
+                ByteSpan data;
+
+                static constexpr crimild::UInt32 NO_BUILDER = 0xFFFFFFFF;
+            };
+
+            struct LinkRecord {
+                Codable::UniqueID parentID;
+                Codable::UniqueID childID;
+                ByteSpan name;
+            };
+
+            struct ResolvedLink {
+                ByteSpan name;
+                crimild::UInt32 child;
+            };
+
+            /**
+               \brief Decodes a single object at a time, assuming all of its links are already decoded
+
+               Each job uses its own instance, so objects can be decoded concurrently
+             */
+            class LinkedObjectDecoder : public MemoryDecoder {
+            public:
+                LinkedObjectDecoder( std::vector< SharedPointer< Codable >> const &objects, const Version &version )
+                    : _allObjects( objects )
+                {
+                    setVersion( version );
+                }
+
+                virtual ~LinkedObjectDecoder( void )
+                {
+
+                }
+
+                void decodeObject( crimild::UInt32 index, const ResolvedLink *begin, const ResolvedLink *end )
+                {
+                    // sorting keeps lookups fast for objects with lots of links (i.e. arrays)
+                    _sortedLinks.assign( begin, end );
+                    std::stable_sort( _sortedLinks.begin(), _sortedLinks.end(), []( ResolvedLink const &a, ResolvedLink const &b ) {
+                        return a.name < b.name;
+                    });
+
+                    _allObjects[ index ]->decode( *this );
+                }
+
+                using MemoryDecoder::decode;
+
+                virtual crimild::Bool decode( std::string key, SharedPointer< Codable > &codable ) override
+                {
+                    // linked objects have been decoded already
+                    codable = getLink( key );
+                    return codable != nullptr;
+                }
+
+            protected:
+                virtual SharedPointer< Codable > getLink( std::string const &key ) override
+                {
+                    ResolvedLink link;
+                    link.name.data = ( const crimild::Byte * ) key.c_str();
+                    link.name.size = key.length();
+
+                    // in case of duplicated keys, the last one wins
+                    auto it = std::upper_bound( _sortedLinks.begin(), _sortedLinks.end(), link, []( ResolvedLink const &a, ResolvedLink const &b ) {
+                        return a.name < b.name;
+                    });
+                    if ( it == _sortedLinks.begin() || ( it - 1 )->name < link.name ) {
+                        return nullptr;
+                    }
+
+                    return _allObjects[ ( it - 1 )->child ];
+                }
+
+            private:
+                std::vector< SharedPointer< Codable >> const &_allObjects;
+                std::vector< ResolvedLink > _sortedLinks;
+            };
+
+        }
+
+    }
+
 }
 
+crimild::Bool MemoryDecoder::decodeParallel( const crimild::Byte *data, crimild::Size size, RootCallback const &callback )
+{
+    using namespace internal;
+
+    SpanReader reader( data, size );
+
+    crimild::Int8 flag;
+    if ( !reader.read( flag ) || flag != Tags::TAG_DATA_START ) {
+        Log::error( CRIMILD_CURRENT_CLASS_NAME, "Invalid data format" );
+        return false;
+    }
+
+    ByteSpan versionStr;
+    if ( !reader.read( flag ) || flag != Tags::TAG_DATA_VERSION || !reader.readString( versionStr ) ) {
+        Log::error( CRIMILD_CURRENT_CLASS_NAME, "Invalid data format. Cannot read version" );
+        return false;
+    }
+    setVersion( Version( std::string( ( const char * ) versionStr.data, versionStr.size ) ) );
+
+    // Phase 1: locate records without copying anything and build objects in parallel.
+    // Builders are resolved up front, so jobs never access the factory's registry
+
+    std::vector< ObjectRecord > records;
+    std::vector< LinkRecord > links;
+    std::vector< Codable::UniqueID > rootIDs;
+    std::unordered_map< Codable::UniqueID, crimild::UInt32 > indices;
+    std::vector< ObjectFactory::Builder > builders;
+    std::unordered_map< std::string, crimild::UInt32 > builderIndices;
+
+    const std::string encodedDataClassName( EncodedData::__CLASS_NAME );
+
+    while ( true ) {
+        if ( !reader.read( flag ) ) {
+            Log::error( CRIMILD_CURRENT_CLASS_NAME, "Invalid data format. Unexpected end of data" );
+            return false;
+        }
+
+        if ( flag == Tags::TAG_DATA_END ) {
+            break;
+        }
+
+        if ( flag == Tags::TAG_DATA_STREAMABLE ) {
+            // record order does not matter here
+        }
+        else if ( flag == Tags::TAG_OBJECT_BEGIN ) {
+            Codable::UniqueID objID;
+            ByteSpan classNameSpan;
+            if ( !reader.read( objID ) || !reader.readString( classNameSpan ) ) {
+                Log::error( CRIMILD_CURRENT_CLASS_NAME, "Invalid data format. Cannot read object" );
+                return false;
+            }
+
+            ObjectRecord record;
+            record.builder = ObjectRecord::NO_BUILDER;
+
+            std::string className( ( const char * ) classNameSpan.data, classNameSpan.size );
+            if ( className == encodedDataClassName ) {
+                if ( !reader.read( record.data ) ) {
+                    Log::error( CRIMILD_CURRENT_CLASS_NAME, "Invalid data format. Cannot read data for object ", objID );
+                    return false;
+                }
+            }
+            else {
+                auto it = builderIndices.find( className );
+                if ( it == builderIndices.end() ) {
+                    auto builder = ObjectFactory::getInstance()->getBuilder( className );
+                    if ( builder == nullptr ) {
+                        Log::error( CRIMILD_CURRENT_CLASS_NAME, "Cannot build object of type ", className );
+                        return false;
+                    }
+                    it = builderIndices.insert( std::make_pair( className, static_cast< crimild::UInt32 >( builders.size() ) ) ).first;
+                    builders.push_back( builder );
+                }
+                record.builder = it->second;
+            }
+
+            indices[ objID ] = static_cast< crimild::UInt32 >( records.size() );
+            records.push_back( record );
+
+            if ( !reader.read( flag ) || flag != Tags::TAG_OBJECT_END ) {
+                Log::error( CRIMILD_CURRENT_CLASS_NAME, "Invalid data format. Expected ", Tags::TAG_OBJECT_END );
+                return false;
+            }
+        }
+        else if ( flag == Tags::TAG_LINK_BEGIN ) {
+            LinkRecord link;
+            if ( !reader.read( link.parentID ) || !reader.readString( link.name ) || !reader.read( link.childID ) ) {
+                Log::error( CRIMILD_CURRENT_CLASS_NAME, "Invalid data format. Cannot read link" );
+                return false;
+            }
+            links.push_back( link );
+
+            if ( !reader.read( flag ) || flag != Tags::TAG_LINK_END ) {
+                Log::error( CRIMILD_CURRENT_CLASS_NAME, "Invalid data format. Expected ", Tags::TAG_LINK_END );
+                return false;
+            }
+        }
+        else if ( flag == Tags::TAG_ROOT_OBJECT_BEGIN ) {
+            Codable::UniqueID objID;
+            if ( !reader.read( objID ) ) {
+                Log::error( CRIMILD_CURRENT_CLASS_NAME, "Invalid data format. Cannot read root object" );
+                return false;
+            }
+            rootIDs.push_back( objID );
+
+            if ( !reader.read( flag ) || flag != Tags::TAG_ROOT_OBJECT_END ) {
+                Log::error( CRIMILD_CURRENT_CLASS_NAME, "Invalid data format. Expected ", Tags::TAG_ROOT_OBJECT_END );
+                return false;
+            }
+        }
+        else {
+            Log::error( CRIMILD_CURRENT_CLASS_NAME, "Unknown flag ", flag );
+            return false;
+        }
+    }
+
+    const auto objectCount = records.size();
+
+    std::vector< SharedPointer< Codable >> objects( objectCount );
+    std::atomic< crimild::Bool > buildFailed( false );
+
+    concurrency::parallel_for( concurrency::Range( 0, objectCount ), 0, [ & ]( concurrency::Range const &range ) {
+        for ( auto i = range.begin; i < range.end; i++ ) {
+            auto &record = records[ i ];
+            if ( record.builder == ObjectRecord::NO_BUILDER ) {
+                auto encoded = crimild::alloc< EncodedData >();
+                encoded->getBytes().resize( record.data.size );
+                if ( record.data.size > 0 ) {
+                    memcpy( encoded->getBytes().getData(), record.data.data, record.data.size );
+                }
+                objects[ i ] = encoded;
+            }
+            else {
+                objects[ i ] = crimild::dynamic_cast_ptr< Codable >( builders[ record.builder ]() );
+                if ( objects[ i ] == nullptr ) {
+                    buildFailed = true;
+                }
+            }
+        }
+    });
+
+    if ( buildFailed ) {
+        Log::error( CRIMILD_CURRENT_CLASS_NAME, "Cannot build objects" );
+        return false;
+    }
+
+    // Phase 2: resolve links by unique ID, keeping the order in which they appear
+    // in the data. Links are grouped by parent using a counting sort
+
+    std::vector< crimild::UInt32 > linkOffsets( objectCount + 1, 0 );
+    std::vector< crimild::UInt32 > linkParents( links.size() );
+    std::vector< ResolvedLink > resolvedLinks( links.size() );
+
+    for ( crimild::Size i = 0; i < links.size(); i++ ) {
+        auto parentIt = indices.find( links[ i ].parentID );
+        auto childIt = indices.find( links[ i ].childID );
+        if ( parentIt == indices.end() || childIt == indices.end() ) {
+            Log::error( CRIMILD_CURRENT_CLASS_NAME, "Invalid data format. Cannot find object with id ", links[ i ].childID );
+            return false;
+        }
+
+        linkParents[ i ] = parentIt->second;
+        ++linkOffsets[ parentIt->second + 1 ];
+
+        resolvedLinks[ i ].name = links[ i ].name;
+        resolvedLinks[ i ].child = childIt->second;
+    }
+
+    for ( crimild::Size i = 0; i < objectCount; i++ ) {
+        linkOffsets[ i + 1 ] += linkOffsets[ i ];
+    }
+
+    std::vector< ResolvedLink > sortedLinks( links.size() );
+    {
+        auto next = linkOffsets;
+        for ( crimild::Size i = 0; i < links.size(); i++ ) {
+            sortedLinks[ next[ linkParents[ i ] ]++ ] = resolvedLinks[ i ];
+        }
+    }
+
+    std::vector< crimild::UInt32 > roots;
+    for ( auto rootID : rootIDs ) {
+        auto it = indices.find( rootID );
+        if ( it == indices.end() ) {
+            Log::error( CRIMILD_CURRENT_CLASS_NAME, "Invalid data format. Cannot find object with id ", rootID );
+            return false;
+        }
+        roots.push_back( it->second );
+    }
+
+    // Compute dependency levels for every object reachable from a root. Objects are
+    // decoded after everything they link to, so leaves go first. Encoded values
+    // don't need decoding at all.
+
+    const crimild::Int32 UNVISITED = -1;
+    const crimild::Int32 VISITING = -2;
+
+    std::vector< crimild::Int32 > levels( objectCount, UNVISITED );
+    crimild::Int32 maxLevel = -1;
+
+    auto isEncodedData = [ &records ]( crimild::UInt32 index ) {
+        return records[ index ].builder == ObjectRecord::NO_BUILDER;
+    };
+
+    std::vector< std::pair< crimild::UInt32, crimild::UInt32 >> stack;
+    for ( auto root : roots ) {
+        if ( isEncodedData( root ) || levels[ root ] != UNVISITED ) {
+            continue;
+        }
+
+        levels[ root ] = VISITING;
+        stack.push_back( std::make_pair( root, linkOffsets[ root ] ) );
+
+        while ( !stack.empty() ) {
+            auto &top = stack.back();
+            auto obj = top.first;
+            if ( top.second < linkOffsets[ obj + 1 ] ) {
+                auto child = sortedLinks[ top.second++ ].child;
+                if ( !isEncodedData( child ) && levels[ child ] == UNVISITED ) {
+                    levels[ child ] = VISITING;
+                    stack.push_back( std::make_pair( child, linkOffsets[ child ] ) );
+                }
+                continue;
+            }
+
+            // children still being visited are part of a cycle and are ignored
+            crimild::Int32 level = 0;
+            for ( auto l = linkOffsets[ obj ]; l < linkOffsets[ obj + 1 ]; l++ ) {
+                auto child = sortedLinks[ l ].child;
+                if ( !isEncodedData( child ) && levels[ child ] >= 0 ) {
+                    level = std::max( level, levels[ child ] + 1 );
+                }
+            }
+            levels[ obj ] = level;
+            maxLevel = std::max( maxLevel, level );
+            stack.pop_back();
+        }
+    }
+
+    std::vector< std::vector< crimild::UInt32 >> objectsByLevel( maxLevel + 1 );
+    for ( crimild::UInt32 i = 0; i < objectCount; i++ ) {
+        if ( levels[ i ] >= 0 ) {
+            objectsByLevel[ levels[ i ] ].push_back( i );
+        }
+    }
+
+    // Objects in the same level don't depend on each other, so they can be decoded
+    // in parallel. Each job uses its own decoder context
+
+    const auto &version = getVersion();
+    for ( auto const &level : objectsByLevel ) {
+        concurrency::parallel_for( concurrency::Range( 0, level.size() ), 0, [ & ]( concurrency::Range const &range ) {
+            LinkedObjectDecoder context( objects, version );
+            for ( auto i = range.begin; i < range.end; i++ ) {
+                auto obj = level[ i ];
+                auto begin = sortedLinks.data() + linkOffsets[ obj ];
+                auto end = sortedLinks.data() + linkOffsets[ obj + 1 ];
+                context.decodeObject( obj, begin, end );
+            }
+        });
+    }
+
+    for ( auto root : roots ) {
+        auto obj = crimild::dynamic_cast_ptr< SharedObject >( objects[ root ] );
+        addRootObject( obj );
+        if ( callback != nullptr ) {
+            callback( obj );
+        }
+    }
+
+    return true;
+}
@@ -33,6 +33,9 @@
 
 #include "Foundation/Containers/Map.hpp"
 
+#include <functional>
+#include <unordered_set>
+
 namespace crimild {
 
 	namespace coding {
@@ -73,13 +76,79 @@ namespace crimild {
             virtual crimild::Bool decode( std::string key, containers::Array< Matrix4f > &value ) override { return decodeDataArray( key, value ); }
             virtual crimild::Bool decode( std::string key, containers::Array< Quaternion4f > &value ) override { return decodeDataArray( key, value ); }
             
+            /**
+               \brief Callback invoked for every root object once it is fully decoded
+             */
+            using RootCallback = std::function< void( SharedPointer< SharedObject > const & ) >;
+
             crimild::Bool fromBytes( const containers::ByteArray &bytes );
+
+            /**
+               \brief Decodes objects from bytes, notifying about each root as soon as it's ready
+
+               Roots are only notified before reaching the end of the data if it
+               was encoded in streamable form (see Tags::TAG_DATA_STREAMABLE).
+             */
+            crimild::Bool fromBytes( const containers::ByteArray &bytes, RootCallback const &callback );
+
+            /**
+               \brief Decodes objects in parallel (disabled by default)
+
+               When enabled, all data is parsed before decoding anything (see decodeParallel()),
+               so roots are only notified once every object is ready.
+             */
+            void setParallelDecodingEnabled( crimild::Bool enabled ) { _parallelDecodingEnabled = enabled; }
+            crimild::Bool isParallelDecodingEnabled( void ) const { return _parallelDecodingEnabled; }
+
+            /**
+               \brief A source of encoded bytes
+             */
+            class Reader {
+            public:
+                virtual ~Reader( void ) { }
+
+                /**
+                   \brief Reads exactly count bytes. Returns false otherwise
+                 */
+                virtual crimild::Bool readRawBytes( void *data, crimild::Size count ) = 0;
+            };
+
+        protected:
+            /**
+               \brief Decodes objects as they are read
+
+               For streamable data, each object is decoded as soon as all of its links
+               are known and encoded values are discarded right after that, so memory
+               usage is bounded by the size of the decoded objects. 
+             */
+            crimild::Bool decodeFrom( Reader &reader, RootCallback const &callback );
+
+            /**
+               \brief Decodes objects from a block of memory using the JobScheduler
+
+               Decoding is split in two phases. First, object records are located and
+               then built in parallel. Second, links are resolved by unique ID in the order 
+               they appear in the data and objects are decoded in dependency order: every 
+               object is decoded after all of its links, while objects that don't depend on 
+               each other are decoded in parallel using independent decoder contexts. 
+               
+               The result does not depend on the number of workers. If no JobScheduler 
+               is running, all objects are decoded on the calling thread.
+
+               Data must remain valid until this function returns.
+             */
+            crimild::Bool decodeParallel( const crimild::Byte *data, crimild::Size size, RootCallback const &callback );
+
+            /**
+               \brief Finds the object linked to the current one using the given key
+             */
+            virtual SharedPointer< Codable > getLink( std::string const &key );
             
         private:
             template< typename T >
             crimild::Bool decodeData( std::string key, T &value )
             {
-                auto obj = crimild::cast_ptr< EncodedData >( _links[ _currentObj->getUniqueID() ][ key ] );
+                auto obj = crimild::cast_ptr< EncodedData >( getLink( key ) );
                 if ( obj == nullptr ) {
                     value = T();
                     return false;
@@ -93,7 +162,7 @@ namespace crimild {
 			template< typename T >
 			crimild::Bool decodeDataArray( std::string key, containers::Array< T > &value )
 			{
-                auto obj = crimild::cast_ptr< EncodedData >( _links[ _currentObj->getUniqueID() ][ key ] );
+                auto obj = crimild::cast_ptr< EncodedData >( getLink( key ) );
 				if ( obj == nullptr ) {
 					return false;
 				}
@@ -114,16 +183,28 @@ namespace crimild {
 			virtual void endDecodingArray( std::string key ) override;
 
         private:
-            static crimild::Size read( const containers::ByteArray &bytes, crimild::Int8 &value, crimild::Size offset );
-            static crimild::Size read( const containers::ByteArray &bytes, Codable::UniqueID &value, crimild::Size offset );
-            static crimild::Size read( const containers::ByteArray &bytes, std::string &value, crimild::Size offset );
-            static crimild::Size read( const containers::ByteArray &bytes, containers::ByteArray &value, crimild::Size offset );
-            static crimild::Size readRawBytes( const containers::ByteArray &bytes, void *data, crimild::Size count, crimild::Size offset );
+            static crimild::Bool read( Reader &reader, crimild::Int8 &value );
+            static crimild::Bool read( Reader &reader, Codable::UniqueID &value );
+            static crimild::Bool read( Reader &reader, std::string &value );
+            static crimild::Bool read( Reader &reader, containers::ByteArray &value );
+
+            /**
+               \brief Decodes an object, unless it has been decoded already
+             */
+            void decodeObject( SharedPointer< Codable > const &obj );
+
+            /**
+               \brief Decodes the last object read from a streamable source and discards its links
+             */
+            void finishPendingObject( void );
             
         private:
             containers::Map< Codable::UniqueID, containers::Map< std::string, SharedPointer< Codable >>> _links;
             containers::Map< Codable::UniqueID, SharedPointer< Codable >> _objects;
+            std::unordered_set< Codable::UniqueID > _decodedObjects;
             SharedPointer< Codable > _currentObj;
+            SharedPointer< Codable > _pendingObj;
+            crimild::Bool _parallelDecodingEnabled = false;
         };
         
 	}
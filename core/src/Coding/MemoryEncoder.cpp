@@ -30,6 +30,10 @@
 
 #include <Foundation/Version.hpp>
 
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
 using namespace crimild;
 using namespace crimild::coding;
 
@@ -128,34 +132,107 @@ containers::ByteArray MemoryEncoder::getBytes( void ) const
     
     append( result, Tags::TAG_DATA_VERSION );
     append( result, getVersion().getDescription() );
-    
-    auto temp = _sortedObjects;
-    while ( !temp.empty() ) {
-        auto obj = temp.pop();
+
+    append( result, Tags::TAG_DATA_STREAMABLE );
+
+    std::unordered_map< Codable::UniqueID, SharedPointer< Codable >> objects;
+    _sortedObjects.each( [ &objects ]( const SharedPointer< Codable > &obj, crimild::Size ) {
+        objects[ obj->getUniqueID() ] = obj;
+    });
+
+    std::unordered_map< Codable::UniqueID, const containers::Map< std::string, Codable::UniqueID > * > links;
+    _links.each( [ &links ]( const Codable::UniqueID &key, const containers::Map< std::string, Codable::UniqueID > &ls ) {
+        links[ key ] = &ls;
+    });
+
+    // Objects are written in post-order, each of them followed by its links. That
+    // way, an object's dependencies are always written before the object itself
+    // and decoders can process it as soon as its links are read. The traversal
+    // uses an explicit stack, so deep hierarchies cannot overflow the call stack.
+    struct PendingObject {
+        Codable::UniqueID objID;
+        const containers::Map< std::string, Codable::UniqueID > *links;
+        std::vector< Codable::UniqueID > children;
+        crimild::Size nextChild;
+    };
+
+    std::unordered_set< Codable::UniqueID > visited;
+    std::vector< PendingObject > pending;
+
+    auto pushObject = [ & ]( Codable::UniqueID objID ) {
+        visited.insert( objID );
+
+        auto it = links.find( objID );
+        auto ls = it != links.end() ? it->second : nullptr;
+
+        PendingObject p { objID, ls, {}, 0 };
+        if ( ls != nullptr ) {
+            ls->each( [ &p ]( const std::string &, const Codable::UniqueID &childID ) {
+                p.children.push_back( childID );
+            });
+        }
+        pending.push_back( std::move( p ) );
+    };
+
+    auto writeObject = [ & ]( const PendingObject &p ) {
+        auto objID = p.objID;
+        auto obj = objects[ objID ];
         append( result, Tags::TAG_OBJECT_BEGIN );
-        append( result, obj->getUniqueID() );
+        append( result, objID );
         append( result, obj->getClassName() );
         if ( auto data = crimild::dynamic_cast_ptr< EncodedData >( obj ) ) {
             append( result, data->getBytes() );
         }
         append( result, Tags::TAG_OBJECT_END );
-    }
-    
-    _links.each( [ &result ]( const Codable::UniqueID &key, const containers::Map< std::string, Codable::UniqueID > &ls ) {
-        ls.each( [ &result, key ]( const std::string &name, const Codable::UniqueID &value ) {
-            append( result, Tags::TAG_LINK_BEGIN );
-            append( result, key );
-            append( result, name );
-            append( result, value );
-            append( result, Tags::TAG_LINK_END );
-        });
-    });
-    
-    _roots.each( [ &result ]( const SharedPointer< Codable > &obj, crimild::Size ) {
+
+        if ( p.links != nullptr ) {
+            p.links->each( [ &result, objID ]( const std::string &name, const Codable::UniqueID &childID ) {
+                append( result, Tags::TAG_LINK_BEGIN );
+                append( result, objID );
+                append( result, name );
+                append( result, childID );
+                append( result, Tags::TAG_LINK_END );
+            });
+        }
+    };
+
+    auto appendObject = [ & ]( Codable::UniqueID objID ) {
+        if ( visited.count( objID ) > 0 ) {
+            return;
+        }
+
+        pushObject( objID );
+        while ( !pending.empty() ) {
+            auto &top = pending.back();
+            if ( top.nextChild < top.children.size() ) {
+                auto childID = top.children[ top.nextChild++ ];
+                if ( visited.count( childID ) == 0 ) {
+                    // invalidates 'top'
+                    pushObject( childID );
+                }
+            }
+            else {
+                writeObject( top );
+                pending.pop_back();
+            }
+        }
+    };
+
+    // each root is written right after its dependencies, so decoders can 
+    // handle them before reaching the end of the data
+    _roots.each( [ &result, &appendObject ]( const SharedPointer< Codable > &obj, crimild::Size ) {
+        appendObject( obj->getUniqueID() );
+
         append( result, Tags::TAG_ROOT_OBJECT_BEGIN );
         append( result, obj->getUniqueID() );
         append( result, Tags::TAG_ROOT_OBJECT_END );
     });
+
+    // objects not reachable from any root (if any)
+    auto temp = _sortedObjects;
+    while ( !temp.empty() ) {
+        appendObject( temp.pop()->getUniqueID() );
+    }
     
     append( result, Tags::TAG_DATA_END );
     
@@ -39,5 +39,6 @@ const crimild::Int8 Tags::TAG_LINK_END = 105;
 const crimild::Int8 Tags::TAG_ROOT_OBJECT_BEGIN = 106;
 const crimild::Int8 Tags::TAG_ROOT_OBJECT_END = 107;
 const crimild::Int8 Tags::TAG_DATA_END = 108;
+const crimild::Int8 Tags::TAG_DATA_STREAMABLE = 109;
 
 
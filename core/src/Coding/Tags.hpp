@@ -45,6 +45,15 @@ namespace crimild {
 			static const crimild::Int8 TAG_ROOT_OBJECT_BEGIN;
 			static const crimild::Int8 TAG_ROOT_OBJECT_END;
 			static const crimild::Int8 TAG_DATA_END;
+
+			/**
+			   \brief Indicates that objects are sorted by dependency and followed by their links
+
+			   When present, it must be written right after the version. Every object
+			   can then be decoded as soon as its links are read, which allows decoders 
+			   to process data incrementally.
+			 */
+			static const crimild::Int8 TAG_DATA_STREAMABLE;
 		};
         
 	}
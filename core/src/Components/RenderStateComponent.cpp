@@ -44,9 +44,11 @@ RenderStateComponent::~RenderStateComponent( void )
 
 void RenderStateComponent::forEachMaterial( std::function< void( Material * ) > callback )
 {
-	_materials.each( [ callback ]( SharedPointer< Material > &m ) {
-		callback( crimild::get_ptr( m ) );
-	});
+	// avoid wrapping (and copying) the callback, since that
+	// might require memory allocations
+	for ( crimild::Size i = 0; i < _materials.size(); i++ ) {
+		callback( crimild::get_ptr( _materials[ i ] ) );
+	}
 }
 
 void RenderStateComponent::forEachLight( std::function< void( Light * ) > callback )
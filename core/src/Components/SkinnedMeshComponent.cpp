@@ -58,6 +58,7 @@ void SkinnedMeshComponent::start( void )
 	NodeComponent::start();
 
 	_time = 0;
+	_cursors.clear();
 }
 
 void SkinnedMeshComponent::update( const Clock &c )
@@ -105,21 +106,22 @@ void SkinnedMeshComponent::update( const Clock &c )
 		_animationProgressCallback( animationProgress );
 	}
 
-	getNode()->perform( Apply( [ skeleton, currentClip, animationState, animationTime ]( Node *node ) {
+	getNode()->perform( Apply( [ this, skeleton, currentClip, animationState, animationTime ]( Node *node ) {
 
 		Transformation modelTransform;
 
 		if ( currentClip->getChannels().find( node->getName() ) ) {
 			auto channel = currentClip->getChannels()[ node->getName() ];
+			auto &cursor = _cursors[ crimild::get_ptr( channel ) ];
 
 			Transformation tTransform;
-			channel->computePosition( animationTime, tTransform.translate() );
+			channel->computePosition( animationTime, tTransform.translate(), cursor.position );
 
 			Transformation rTransform;
-			channel->computeRotation( animationTime, rTransform.rotate() );
+			channel->computeRotation( animationTime, rTransform.rotate(), cursor.rotation );
 
-			float scale;
-			channel->computeScale( animationTime, scale );
+			float scale = 1.0f;
+			channel->computeScale( animationTime, scale, cursor.scale );
 			Transformation sTransform;
 			sTransform.setScale( scale );
 
@@ -31,10 +31,11 @@
 #include "NodeComponent.hpp"
 
 #include "Foundation/SharedObject.hpp"
+#include "Rendering/SkinnedMesh.hpp"
 
-namespace crimild {
+#include <unordered_map>
 
-	class SkinnedMesh;
+namespace crimild {
 
 	class SkinnedMeshComponent : public NodeComponent {
 		CRIMILD_IMPLEMENT_RTTI( crimild::SkinnedMeshComponent )
@@ -73,6 +74,11 @@ namespace crimild {
 		bool _loop;
 		float _timeScale;
 		AnimationProgressCallback _animationProgressCallback;
+
+		/**
+		   \brief Keyframe cursors for each channel in the current clip
+		 */
+		std::unordered_map< SkinnedMeshAnimationChannel *, SkinnedMeshAnimationChannel::Cursor > _cursors;
         
         /**
             \name Clonning
@@ -75,3 +75,14 @@ void crimild::concurrency::wait( JobPtr const &job )
 	JobScheduler::getInstance()->wait( job );
 }
 
+Job *crimild::concurrency::async_arena( void )
+{
+	auto job = JobScheduler::getInstance()->allocateJob();
+	job->reset();
+	return job;
+}
+
+void crimild::concurrency::wait( Job *job )
+{
+	JobScheduler::getInstance()->wait( job );
+}
@@ -29,6 +29,7 @@
 #define CRIMILD_CORE_ASYNC_
 
 #include "Job.hpp"
+#include "JobScheduler.hpp"
 
 namespace crimild {
 
@@ -87,6 +88,48 @@ namespace crimild {
          */
 		void wait( JobPtr const &job );
 
+		/**
+		   \name Arena jobs
+
+		   These functions create jobs using the current worker's JobArena
+		   instead of allocating them in the heap. Callbacks are stored inline
+		   and jobs are referenced by raw pointers, making them much cheaper
+		   than regular jobs when spawning lots of small tasks.
+
+		   \remarks Arena jobs are recycled once completed. Do not keep
+		   references to them after waiting for their root job, which must
+		   happen within the same frame.
+		 */
+		//@{
+
+		/**
+		   \brief Creates an empty root job in the current worker's arena
+
+		   \remarks You must wait() for the returned job. Otherwise, the
+		   arena won't be able to recycle its jobs.
+		 */
+		Job *async_arena( void );
+
+		/**
+		   \brief Creates and dispatches an arena job linked to a parent
+		 */
+		template< typename Fn >
+		Job *async_arena( Job *parent, Fn &&callback )
+		{
+			auto scheduler = JobScheduler::getInstance();
+			auto job = scheduler->allocateJob();
+			job->reset( parent, std::forward< Fn >( callback ) );
+			scheduler->schedule( job );
+			return job;
+		}
+
+		/**
+		   \brief Waits for an arena job to be completed
+		 */
+		void wait( Job *job );
+
+		//@}
+
 	}
 
 }
@@ -26,13 +26,13 @@
  */
 
 #include "Job.hpp"
+#include "JobArena.hpp"
 
 using namespace crimild;
 using namespace crimild::concurrency;
 
 Job::Job( void )
-	: _callback( nullptr ),
-      _parent( nullptr ),
+	: _parent( nullptr ),
 	  _childCount( 0 )
 {
 
@@ -45,23 +45,36 @@ Job::~Job( void )
 
 void Job::reset( void )
 {
-	_callback = nullptr;
+	_closure.reset();
 	_parent = nullptr;
 	_childCount = 0;
+
+	// empty arena jobs are always roots
+	_releaseOnWait = isArenaJob();
 }
 
 void Job::reset( JobCallback const &callback )
 {
-	_callback = callback;
-	_parent = nullptr;
-	_childCount = 1;
+	reset( JobPtr(), callback );
 }
 
 void Job::reset( JobPtr const &parent, JobCallback const &callback )
 {
-	_callback = callback;
-    _parent = crimild::get_ptr( parent );
+	if ( callback != nullptr ) {
+		_closure.set( callback );
+	}
+	else {
+		_closure.reset();
+	}
+
+	setParent( crimild::get_ptr( parent ) );
+}
+
+void Job::setParent( Job *parent )
+{
+	_parent = parent;
 	_childCount = 1;
+	_releaseOnWait = false;
 
 	if ( _parent != nullptr ) {
 		_parent->increaseChildCount();
@@ -70,13 +83,14 @@ void Job::reset( JobPtr const &parent, JobCallback const &callback )
 
 void Job::increaseChildCount( void )
 {
-	++_childCount;
+	_childCount.fetch_add( 1, std::memory_order_relaxed );
 }
 
 void Job::decreaseChildCount( void )
 {
-	if ( _childCount > 0 ) {
-		--_childCount;
+	auto count = _childCount.load( std::memory_order_relaxed );
+	while ( count > 0 && !_childCount.compare_exchange_weak( count, count - 1, std::memory_order_acq_rel ) ) {
+		// retry
 	}
 }
 
@@ -87,8 +101,11 @@ void Job::attachContinuation( JobContinuationCallback const &callback )
 
 void Job::execute( void )
 {
-	if ( _callback != nullptr ) {
-		_callback();
+	if ( _closure.isValid() ) {
+		_closure();
+
+		// release any captured resources as soon as possible
+		_closure.reset();
 	}
 
 	finish();
@@ -96,12 +113,19 @@ void Job::execute( void )
 
 void Job::finish( void )
 {
-	decreaseChildCount();
-	if ( isCompleted() ) {
-		if ( _parent != nullptr ) {
-			_parent->finish();
+	// Another thread might recycle or destroy this job as soon as 
+	// the counter reaches zero, so copy everything we need first
+	auto parent = _parent;
+	auto arena = _releaseOnWait ? nullptr : _arena;
+
+	if ( _childCount.fetch_sub( 1, std::memory_order_acq_rel ) == 1 ) {
+		if ( parent != nullptr ) {
+			parent->finish();
+		}
+
+		if ( arena != nullptr ) {
+			// arena jobs are not recycled until they are released
+			arena->release( this );
 		}
-        _callback = nullptr;
 	}
 }
-
@@ -28,11 +28,15 @@
 #ifndef CRIMILD_CORE_CONCURRENCY_JOB_
 #define CRIMILD_CORE_CONCURRENCY_JOB_
 
+#include "JobClosure.hpp"
+
 #include "Foundation/NamedObject.hpp"
 #include "Foundation/SharedObject.hpp"
+#include "Foundation/Types.hpp"
 
 #include <atomic>
 #include <functional>
+#include <vector>
 
 namespace crimild {
 
@@ -52,10 +56,21 @@ namespace crimild {
 		 */
 		using JobContinuationCallback = std::function< void( void ) >;
 
+		class JobScheduler;
+		class JobArena;
+
 		/**
 		   \brief Describes a job that can be executed concurrently
+
+		   Jobs are either allocated in the heap and managed by a JobPtr
+		   or allocated from a worker's JobArena (see async_arena()). In the
+		   latter case, jobs are referenced by raw pointers and recycled by
+		   the arena once completed.
 		 */
 		class Job : public SharedObject, public NamedObject {
+			friend class JobScheduler;
+			friend class JobArena;
+
 		public:
 			Job( void );
 			virtual ~Job( void );
@@ -63,18 +78,33 @@ namespace crimild {
 			void reset( void );
 			void reset( JobCallback const &callback );
 			void reset( JobPtr const &parent, JobCallback const &callback );
+
+			/**
+			   \brief Resets the job using an arbitrary callable
+
+			   The callable is stored inline whenever possible (see JobClosure)
+			 */
+			template< typename Fn >
+			void reset( Job *parent, Fn &&callback )
+			{
+				_closure.set( std::forward< Fn >( callback ) );
+				setParent( parent );
+			}
 			
 			void execute( void );
 			void finish( void );
 
-			bool isCompleted( void ) const { return _childCount == 0; }
+			bool isCompleted( void ) const { return _childCount.load( std::memory_order_acquire ) == 0; }
 
 		private:
-			JobCallback _callback;
+			JobClosure _closure;
 
 		public:
 			Job *getParent( void ) const { return _parent; }
 
+		private:
+			void setParent( Job *parent );
+
 		private:
 			Job *_parent = nullptr;
 
@@ -109,6 +139,44 @@ namespace crimild {
 		private:
 			std::vector< JobContinuationCallback > _continuations;
 
+			//@}
+
+		private:
+			/**
+			   \brief Keeps the job alive while it's waiting in a worker queue
+
+			   Worker queues only store raw pointers, so the scheduler holds
+			   a reference here until the job is executed.
+			 */
+			JobPtr _scheduledRef;
+
+			/**
+			   \name Arena support
+			 */
+			//@{
+
+		public:
+			bool isArenaJob( void ) const { return _arena != nullptr; }
+
+		private:
+			/**
+			   \brief The arena this job was allocated from, if any
+			 */
+			JobArena *_arena = nullptr;
+
+			/**
+			   \brief Pending counter of the arena block containing this job
+			 */
+			std::atomic< crimild::Size > *_arenaPending = nullptr;
+
+			/**
+			   \brief Indicates that the job is released by wait() instead of by finish()
+
+			   Set for empty root jobs, since they may complete several
+			   times while children are still being added to them.
+			 */
+			bool _releaseOnWait = false;
+
 			//@}
 		};
 
@@ -117,4 +185,3 @@ namespace crimild {
 }
 
 #endif
-
@@ -0,0 +1,98 @@
+/*
+ * Copyright (c) 2013, Hernan Saez
+ * All rights reserved.
+ * 
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *     * Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in the
+ *       documentation and/or other materials provided with the distribution.
+ *     * Neither the name of the <organization> nor the
+ *       names of its contributors may be used to endorse or promote products
+ *       derived from this software without specific prior written permission.
+ * 
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL <COPYRIGHT HOLDER> BE LIABLE FOR ANY
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "JobArena.hpp"
+
+using namespace crimild;
+using namespace crimild::concurrency;
+
+constexpr crimild::Size JobArena::BLOCK_SIZE;
+
+JobArena::JobArena( void )
+	: _pending( 0 )
+{
+
+}
+
+JobArena::~JobArena( void )
+{
+
+}
+
+Job *JobArena::allocate( void )
+{
+	if ( _pending.load( std::memory_order_acquire ) == 0 ) {
+		// all jobs are done. Start over
+		_current = 0;
+		_next = 0;
+	}
+
+	if ( _blocks.empty() ) {
+		_blocks.push_back( crimild::alloc_unique< Block >() );
+	}
+
+	if ( _next == BLOCK_SIZE ) {
+		// current block is full. Move to the next one in the ring
+		// whose jobs are all completed, or insert a new one
+		auto blockCount = _blocks.size();
+		auto found = false;
+		for ( crimild::Size i = 1; !found && i < blockCount; i++ ) {
+			auto candidate = ( _current + i ) % blockCount;
+			if ( _blocks[ candidate ]->pending.load( std::memory_order_acquire ) == 0 ) {
+				_current = candidate;
+				found = true;
+			}
+		}
+
+		if ( !found ) {
+			_blocks.insert( _blocks.begin() + _current + 1, crimild::alloc_unique< Block >() );
+			++_current;
+		}
+
+		_next = 0;
+	}
+
+	auto block = _blocks[ _current ].get();
+	auto job = &block->jobs[ _next ];
+	++_next;
+
+	block->pending.fetch_add( 1, std::memory_order_relaxed );
+	_pending.fetch_add( 1, std::memory_order_relaxed );
+
+	job->_arena = this;
+	job->_arenaPending = &block->pending;
+	job->_releaseOnWait = false;
+	job->_scheduledRef = nullptr;
+
+	return job;
+}
+
+void JobArena::release( Job *job )
+{
+	job->_arenaPending->fetch_sub( 1, std::memory_order_release );
+	_pending.fetch_sub( 1, std::memory_order_release );
+}
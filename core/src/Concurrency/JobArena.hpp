@@ -0,0 +1,106 @@
+/*
+ * Copyright (c) 2013, Hernan Saez
+ * All rights reserved.
+ * 
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *     * Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in the
+ *       documentation and/or other materials provided with the distribution.
+ *     * Neither the name of the <organization> nor the
+ *       names of its contributors may be used to endorse or promote products
+ *       derived from this software without specific prior written permission.
+ * 
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL <COPYRIGHT HOLDER> BE LIABLE FOR ANY
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef CRIMILD_CORE_CONCURRENCY_JOB_ARENA_
+#define CRIMILD_CORE_CONCURRENCY_JOB_ARENA_
+
+#include "Job.hpp"
+
+#include "Foundation/NonCopyable.hpp"
+#include "Foundation/Types.hpp"
+
+#include <atomic>
+#include <memory>
+#include <vector>
+
+namespace crimild {
+
+	namespace concurrency {
+
+		/**
+		   \brief A pool of reusable jobs owned by a single worker
+
+		   Jobs are allocated linearly from a ring of blocks of preallocated
+		   Job objects. Each block counts its pending jobs, and is reused once
+		   all of them are completed. If no other block is free, a new one 
+		   is inserted after the current one. That way, the number of
+		   blocks only depends on how many jobs are pending at the same time,
+		   even if the arena never becomes completely idle. 
+
+		   When all jobs are done, the arena rewinds to the first block.
+
+		   \remarks Only the owner worker can allocate jobs, but any thread
+		   can release them.
+		 */
+		class JobArena : public NonCopyable {
+		public:
+			static constexpr crimild::Size BLOCK_SIZE = 1024;
+
+		public:
+			JobArena( void );
+			virtual ~JobArena( void );
+
+			/**
+			   \brief Retrieves an unused job
+
+			   \remarks Only the owner thread may call this method
+			 */
+			Job *allocate( void );
+
+			/**
+			   \brief Notifies that a job allocated from this arena is completed
+
+			   The job may be reused as soon as this function returns
+			 */
+			void release( Job *job );
+
+			crimild::Size getCapacity( void ) const { return _blocks.size() * BLOCK_SIZE; }
+
+			crimild::Size getPendingCount( void ) const { return _pending.load( std::memory_order_relaxed ); }
+
+		private:
+			struct Block {
+				Block( void ) : jobs( new Job[ BLOCK_SIZE ] ), pending( 0 ) { }
+
+				std::unique_ptr< Job[] > jobs;
+				std::atomic< crimild::Size > pending;
+			};
+
+			/**
+			   \brief Blocks in ring order
+			 */
+			std::vector< std::unique_ptr< Block >> _blocks;
+			crimild::Size _current = 0;
+			crimild::Size _next = 0;
+			std::atomic< crimild::Size > _pending;
+		};
+
+	}
+
+}
+
+#endif
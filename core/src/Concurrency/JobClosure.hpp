@@ -0,0 +1,127 @@
+/*
+ * Copyright (c) 2013, Hernan Saez
+ * All rights reserved.
+ * 
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *     * Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in the
+ *       documentation and/or other materials provided with the distribution.
+ *     * Neither the name of the <organization> nor the
+ *       names of its contributors may be used to endorse or promote products
+ *       derived from this software without specific prior written permission.
+ * 
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL <COPYRIGHT HOLDER> BE LIABLE FOR ANY
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef CRIMILD_CORE_CONCURRENCY_JOB_CLOSURE_
+#define CRIMILD_CORE_CONCURRENCY_JOB_CLOSURE_
+
+#include "Foundation/NonCopyable.hpp"
+
+#include <cstddef>
+#include <new>
+#include <type_traits>
+#include <utility>
+
+namespace crimild {
+
+	namespace concurrency {
+
+		/**
+		   \brief A type-erased callable with inline storage
+
+		   Unlike std::function, callables up to STORAGE_SIZE bytes are stored
+		   inside the closure itself, so creating jobs does not allocate memory
+		   in the common case. Bigger callables are moved to the heap.
+		 */
+		class JobClosure : public NonCopyable {
+		public:
+			static constexpr std::size_t STORAGE_SIZE = 64;
+
+		private:
+			using Storage = std::aligned_storage< STORAGE_SIZE, alignof( std::max_align_t ) >::type;
+
+			template< typename Fn, bool Inline >
+			struct Impl;
+
+			template< typename Fn >
+			struct Impl< Fn, true > {
+				static void create( Storage *storage, Fn &&fn ) { new ( storage ) Fn( std::move( fn ) ); }
+				static void create( Storage *storage, Fn const &fn ) { new ( storage ) Fn( fn ); }
+				static Fn *get( Storage *storage ) { return reinterpret_cast< Fn * >( storage ); }
+				static void invoke( Storage *storage ) { ( *get( storage ) )(); }
+				static void destroy( Storage *storage ) { get( storage )->~Fn(); }
+			};
+
+			template< typename Fn >
+			struct Impl< Fn, false > {
+				static void create( Storage *storage, Fn &&fn ) { *reinterpret_cast< Fn ** >( storage ) = new Fn( std::move( fn ) ); }
+				static void create( Storage *storage, Fn const &fn ) { *reinterpret_cast< Fn ** >( storage ) = new Fn( fn ); }
+				static Fn *get( Storage *storage ) { return *reinterpret_cast< Fn ** >( storage ); }
+				static void invoke( Storage *storage ) { ( *get( storage ) )(); }
+				static void destroy( Storage *storage ) { delete get( storage ); }
+			};
+
+			template< typename Fn >
+			using ImplFor = Impl< Fn, sizeof( Fn ) <= STORAGE_SIZE && alignof( Fn ) <= alignof( std::max_align_t ) >;
+
+		public:
+			JobClosure( void ) { }
+
+			~JobClosure( void )
+			{
+				reset();
+			}
+
+			template< typename Fn >
+			void set( Fn &&fn )
+			{
+				using FnType = typename std::decay< Fn >::type;
+
+				reset();
+
+				ImplFor< FnType >::create( &_storage, std::forward< Fn >( fn ) );
+				_invoke = &ImplFor< FnType >::invoke;
+				_destroy = &ImplFor< FnType >::destroy;
+			}
+
+			void reset( void )
+			{
+				if ( _destroy != nullptr ) {
+					_destroy( &_storage );
+				}
+
+				_invoke = nullptr;
+				_destroy = nullptr;
+			}
+
+			bool isValid( void ) const { return _invoke != nullptr; }
+
+			void operator()( void )
+			{
+				_invoke( &_storage );
+			}
+
+		private:
+			Storage _storage;
+			void ( *_invoke )( Storage * ) = nullptr;
+			void ( *_destroy )( Storage * ) = nullptr;
+		};
+
+	}
+
+}
+
+#endif
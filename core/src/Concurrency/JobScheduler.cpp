@@ -32,8 +32,32 @@
 using namespace crimild;
 using namespace crimild::concurrency;
 
+namespace crimild {
+
+	namespace concurrency {
+
+		/**
+		   \brief Global counter used to tag each run of a scheduler
+		 */
+		static std::atomic< crimild::UInt32 > s_schedulerGeneration( 0 );
+
+		/**
+		   \brief Caches the worker index for the current thread
+		 */
+		struct WorkerIndexCache {
+			crimild::UInt32 generation = 0;
+			int index = -1;
+		};
+
+		static thread_local WorkerIndexCache t_workerIndex;
+
+	}
+
+}
+
 JobScheduler::JobScheduler( void )
-	: _numWorkers( std::thread::hardware_concurrency() )
+	: _numWorkers( std::thread::hardware_concurrency() ),
+	  _externalJobCount( 0 )
 {
 
 }
@@ -55,13 +79,25 @@ bool JobScheduler::start( void )
 {
 	_state = JobScheduler::State::INITIALIZING;
 
+	_generation = ++s_schedulerGeneration;
+
+	// allocate all worker slots before starting threads, so the
+	// array is never modified while running
+	_workerSlots.clear();
+	for ( int i = 0; i <= getNumWorkers(); i++ ) {
+		auto w = crimild::alloc_unique< Worker >();
+		w->jobCount = 0;
+		w->seed = 2463534242u + i;
+		_workerSlots.push_back( std::move( w ) );
+	}
+
 	// initialize the main thread as another worker
-    initWorker( true );
+    initWorker( 0 );
 
     Log::info( CRIMILD_CURRENT_CLASS_NAME, "Initializing job scheduler with ", getNumWorkers(), " workers" );
 
 	for ( int i = 0; i < getNumWorkers(); i++ ) {
-		_workers.push_back( std::thread( std::bind( &JobScheduler::worker, this ) ) );
+		_workers.push_back( std::thread( std::bind( &JobScheduler::worker, this, i + 1 ) ) );
 	}
 
 	_state = JobScheduler::State::RUNNING;
@@ -80,14 +116,30 @@ void JobScheduler::stop( void )
 	}
 
 	_workers.clear();
-    _workerJobQueues.clear();
+
+	// release any pending job
+	for ( auto &w : _workerSlots ) {
+		while ( auto job = w->queue.pop() ) {
+			job->_scheduledRef = nullptr;
+		}
+	}
+	_workerSlots.clear();
+
+	{
+		std::lock_guard< std::mutex > lock( _externalJobsMutex );
+		for ( auto job : _externalJobs ) {
+			job->_scheduledRef = nullptr;
+		}
+		_externalJobs.clear();
+		_externalJobCount = 0;
+	}
 
 	_state = JobScheduler::State::STOPPED;
 }
 
-void JobScheduler::worker( void )
+void JobScheduler::worker( int workerIndex )
 {
-    initWorker();
+    initWorker( workerIndex );
 
 	while ( getState() == JobScheduler::State::INITIALIZING ) {
 		// wait for startup to complete
@@ -99,16 +151,18 @@ void JobScheduler::worker( void )
 	}
 }
 
-void JobScheduler::initWorker( bool mainWorker )
+void JobScheduler::initWorker( int workerIndex )
 {
     std::lock_guard< std::mutex > lock( _mutex );
     
-    if ( mainWorker ) {
+    if ( workerIndex == 0 ) {
         _mainWorkerId = getWorkerId();
     }
 
-    _workerStats[ getWorkerId() ].jobCount = 0;
-	_workerJobQueues[ getWorkerId() ] = crimild::alloc< WorkerJobQueue >();
+	_workerSlots[ workerIndex ]->id = getWorkerId();
+
+	t_workerIndex.generation = _generation;
+	t_workerIndex.index = workerIndex;
 }	
 
 JobScheduler::WorkerId JobScheduler::getWorkerId( void ) const
@@ -116,20 +170,54 @@ JobScheduler::WorkerId JobScheduler::getWorkerId( void ) const
 	return std::this_thread::get_id();
 }
 
+int JobScheduler::getWorkerIndex( void ) const
+{
+	if ( t_workerIndex.generation != _generation ) {
+		return -1;
+	}
+
+	return t_workerIndex.index;
+}
+
+JobScheduler::Worker *JobScheduler::getCurrentWorker( void ) const
+{
+	auto idx = getWorkerIndex();
+	if ( idx < 0 || idx >= static_cast< int >( _workerSlots.size() ) ) {
+		return nullptr;
+	}
+
+	return _workerSlots[ idx ].get();
+}
+
 JobScheduler::WorkerJobQueue *JobScheduler::getWorkerJobQueue( void )
 {
-	return crimild::get_ptr( _workerJobQueues[ getWorkerId() ] );
+	auto worker = getCurrentWorker();
+	return worker != nullptr ? &worker->queue : nullptr;
 }
 
-JobScheduler::WorkerJobQueue *JobScheduler::getRandomJobQueue( void )
+JobScheduler::WorkerJobQueue *JobScheduler::getRandomJobQueue( Worker *thief )
 {
-	if ( _workerJobQueues.size() == 0 ) {
+	auto count = _workerSlots.size();
+	if ( count == 0 ) {
 		return nullptr;
 	}
 
-	for ( auto &it : _workerJobQueues ) {
-		if ( it.second != nullptr && !it.second->empty() ) {
-			return crimild::get_ptr( it.second );
+	// pick a random victim and then try all of them in order, starting from there
+	crimild::UInt32 start = 0;
+	if ( thief != nullptr ) {
+		// xorshift
+		auto x = thief->seed;
+		x ^= x << 13;
+		x ^= x >> 17;
+		x ^= x << 5;
+		thief->seed = x;
+		start = x % count;
+	}
+
+	for ( size_t i = 0; i < count; i++ ) {
+		auto victim = _workerSlots[ ( start + i ) % count ].get();
+		if ( victim != thief && !victim->queue.empty() ) {
+			return &victim->queue;
 		}
 	}
 
@@ -147,29 +235,62 @@ void JobScheduler::schedule( JobPtr const &job )
         Log::error( CRIMILD_CURRENT_CLASS_NAME, "Cannot schedule new jobs since the scheduler is not running" );
         return;
     }
-    
-	auto queue = getWorkerJobQueue();
-	queue->push( job );
+
+	// keep the job alive until it's executed
+	job->_scheduledRef = job;
+
+	schedule( crimild::get_ptr( job ) );
+}
+
+Job *JobScheduler::allocateJob( void )
+{
+	auto worker = getCurrentWorker();
+	if ( worker != nullptr ) {
+		return worker->arena.allocate();
+	}
+
+	std::lock_guard< std::mutex > lock( _externalJobsMutex );
+	return _externalArena.allocate();
 }
 
-JobPtr JobScheduler::getJob( void )
+void JobScheduler::schedule( Job *job )
 {
 	auto queue = getWorkerJobQueue();
+	if ( queue != nullptr ) {
+		queue->push( job );
+	}
+	else {
+		// only the owner can push into a worker queue, so jobs 
+		// coming from other threads are kept apart
+		std::lock_guard< std::mutex > lock( _externalJobsMutex );
+		_externalJobs.push_back( job );
+		++_externalJobCount;
+	}
+}
 
-	if ( queue != nullptr && !queue->empty() ) {
-		auto job = queue->pop();
+Job *JobScheduler::getJob( void )
+{
+	auto worker = getCurrentWorker();
+	if ( worker != nullptr ) {
+		auto job = worker->queue.pop();
 		if ( job != nullptr ) {
 			return job;
 		}
 	}
 
-	auto stealQueue = getRandomJobQueue();
-	if ( stealQueue == nullptr || stealQueue == queue ) {
-		// do not steal from ourselves
-		return nullptr;
+	if ( _externalJobCount > 0 ) {
+		std::lock_guard< std::mutex > lock( _externalJobsMutex );
+		if ( !_externalJobs.empty() ) {
+			auto job = _externalJobs.front();
+			_externalJobs.pop_front();
+			--_externalJobCount;
+			return job;
+		}
 	}
 
-	if ( !stealQueue->empty() ) {
+	// do not steal from ourselves
+	auto stealQueue = getRandomJobQueue( worker );
+	if ( stealQueue != nullptr ) {
 		return stealQueue->steal();
 	}
 
@@ -181,7 +302,10 @@ bool JobScheduler::executeNextJob( void )
 	auto job = getJob();
 	if ( job != nullptr ) {
 		execute( job );
-		_workerStats[ getWorkerId() ].jobCount++;
+		auto worker = getCurrentWorker();
+		if ( worker != nullptr ) {
+			worker->jobCount.fetch_add( 1, std::memory_order_relaxed );
+		}
 		return true;
 	}
 
@@ -194,6 +318,20 @@ void JobScheduler::execute( JobPtr const &job )
 	job->execute();
 }
 
+void JobScheduler::execute( Job *job )
+{
+	if ( job->_scheduledRef == nullptr ) {
+		// arena jobs are not reference counted
+		job->execute();
+		return;
+	}
+
+	// take ownership of the reference that was keeping the job alive
+	auto ref = std::move( job->_scheduledRef );
+	job->_scheduledRef = nullptr;
+	ref->execute();
+}
+
 void JobScheduler::wait( JobPtr const &job )
 {
 	while( !job->isCompleted() ) {
@@ -201,6 +339,18 @@ void JobScheduler::wait( JobPtr const &job )
 	}
 }
 
+void JobScheduler::wait( Job *job )
+{
+	while( !job->isCompleted() ) {
+		executeNextJob();
+	}
+
+	if ( job->_releaseOnWait ) {
+		job->_releaseOnWait = false;
+		job->_arena->release( job );
+	}
+}
+
 void JobScheduler::yield( void )
 {
 //    if ( isMainWorker() ) {
@@ -237,8 +387,10 @@ void JobScheduler::executeDelayedJobs( void )
 
 void JobScheduler::eachWorkerStat( std::function< void( WorkerId, const WorkerStat & ) > const &callback ) const
 {
-	for ( const auto &it : _workerStats ) {
-		callback( it.first, it.second );
+	for ( const auto &w : _workerSlots ) {
+		WorkerStat stat;
+		stat.jobCount = w->jobCount.load( std::memory_order_relaxed );
+		callback( w->id, stat );
 	}
 }
 
@@ -246,8 +398,7 @@ void JobScheduler::clearWorkerStats( void )
 {
 	std::lock_guard< std::mutex > lock( _mutex );
 
-	for ( auto &it : _workerStats ) {
-		it.second.jobCount = 0;
+	for ( auto &w : _workerSlots ) {
+		w->jobCount = 0;
 	}
 }
-
@@ -29,15 +29,17 @@
 #define CRIMILD_CORE_CONCURRENCY_JOB_SCHEDULER_
 
 #include "Job.hpp"
+#include "JobArena.hpp"
 #include "WorkStealingDeque.hpp"
 
 #include "Foundation/Singleton.hpp"
 #include "Foundation/ConcurrentList.hpp"
 
 #include <vector>
+#include <list>
 #include <thread>
 #include <mutex>
-#include <map>
+#include <atomic>
 
 namespace crimild {
 
@@ -104,47 +106,117 @@ namespace crimild {
             
             bool isMainWorker( void ) const { return getWorkerId() == _mainWorkerId; }
 
+            /**
+                \brief Dense index for the current worker
+
+                The main worker is always at index zero. Threads that are not 
+                managed by the scheduler get a negative value.
+             */
+            int getWorkerIndex( void ) const;
+
 		private:
             int _numWorkers;
 			std::vector< std::thread > _workers;
             WorkerId _mainWorkerId;
 
+		public:
+			struct WorkerStat {
+				size_t jobCount = 0;
+			};
+			
 		private:
-			using WorkerJobQueue = WorkStealingQueue< JobPtr >;
+			using WorkerJobQueue = WorkStealingQueue< Job * >;
 
-			void initWorker( bool mainWorker = false );
+			/**
+			   \brief Per-thread data for each worker
+
+			   Workers are stored in a dense array and accessed by index, so
+			   no lookup is required when scheduling or executing jobs.
+			 */
+			struct Worker {
+				WorkerId id;
+				WorkerJobQueue queue;
+				JobArena arena;
+				std::atomic< size_t > jobCount;
+				crimild::UInt32 seed;
+
+				// avoid false sharing between workers
+				char padding[ 64 ];
+			};
+
+			void initWorker( int workerIndex );
+			Worker *getCurrentWorker( void ) const;
 			WorkerJobQueue *getWorkerJobQueue( void );
-			WorkerJobQueue *getRandomJobQueue( void );
+			WorkerJobQueue *getRandomJobQueue( Worker *thief );
 
-			void worker( void );
+			void worker( int workerIndex );
 
 		private:
-			std::map< WorkerId, SharedPointer< WorkerJobQueue >> _workerJobQueues;
+			std::vector< UniquePointer< Worker >> _workerSlots;
+
+			/**
+			   \brief Incremented every time the scheduler starts
+
+			   Used to invalidate worker indices cached by threads from
+			   previous runs
+			 */
+			crimild::UInt32 _generation = 0;
+
+			/**
+			   \brief Jobs scheduled from threads not managed by the scheduler
+			 */
+			std::list< Job * > _externalJobs;
+			std::atomic< size_t > _externalJobCount;
+			std::mutex _externalJobsMutex;
+			JobArena _externalArena;
 
 		public:
 			void schedule( JobPtr const &job );
 			void wait( JobPtr const &job );
 
+			/**
+			   \brief Allocates a job from the current worker's arena
+
+			   \see async_arena()
+			 */
+			Job *allocateJob( void );
+
+			/**
+			   \brief Schedules an arena job
+			 */
+			void schedule( Job *job );
+
+			/**
+			   \brief Waits for an arena job to complete
+
+			   If the job is an empty root job, it's also released
+			   back to its arena.
+			 */
+			void wait( Job *job );
+
 			void yield( void );
 
+			/**
+			   \brief Executes the next available job, if any
+
+			   Useful for implementing custom waiting loops. If there are no
+			   jobs available, the current thread yields.
+
+			   \returns true if a job was executed
+			 */
+			bool executeNextJob( void );
+
 		private:
-			JobPtr getJob( void );
+			Job *getJob( void );
 			
-			bool executeNextJob( void );
 			void execute( JobPtr const &job );
+			void execute( Job *job );
 
 		public:
-			struct WorkerStat {
-				size_t jobCount = 0;
-			};
-			
 			void eachWorkerStat( std::function< void( WorkerId, const WorkerStat & ) > const &callback ) const;
 			
 			void clearWorkerStats( void );
 
-		private:
-			std::map< WorkerId, WorkerStat > _workerStats;
-            
         private:
             std::mutex _mutex;
             
@@ -0,0 +1,188 @@
+/*
+ * Copyright (c) 2013, Hernan Saez
+ * All rights reserved.
+ * 
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *     * Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in the
+ *       documentation and/or other materials provided with the distribution.
+ *     * Neither the name of the <organization> nor the
+ *       names of its contributors may be used to endorse or promote products
+ *       derived from this software without specific prior written permission.
+ * 
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL <COPYRIGHT HOLDER> BE LIABLE FOR ANY
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef CRIMILD_CORE_CONCURRENCY_PARALLEL_FOR_
+#define CRIMILD_CORE_CONCURRENCY_PARALLEL_FOR_
+
+#include "Async.hpp"
+#include "JobScheduler.hpp"
+
+#include "Foundation/Types.hpp"
+
+#include <vector>
+
+namespace crimild {
+
+	namespace concurrency {
+
+		/**
+		   \brief A half-open range of indices [begin, end)
+		 */
+		struct Range {
+			crimild::Size begin;
+			crimild::Size end;
+
+			Range( crimild::Size b, crimild::Size e ) : begin( b ), end( e ) { }
+
+			crimild::Size size( void ) const { return end > begin ? end - begin : 0; }
+			bool empty( void ) const { return size() == 0; }
+		};
+
+		namespace internal {
+
+			/**
+			   \brief Checks if there's a running scheduler to execute jobs
+			 */
+			inline bool isSchedulerRunning( void )
+			{
+				return JobScheduler::hasInstance() && JobScheduler::getInstance()->isRunning();
+			}
+
+			/**
+			   \brief Computes a grain size if none was provided
+
+			   Aims for several chunks per worker, so there's enough 
+			   work to steal when chunks are unbalanced. Only the calling 
+			   thread is counted if no scheduler is running.
+			 */
+			inline crimild::Size computeGrain( Range const &range, crimild::Size grain )
+			{
+				if ( grain > 0 ) {
+					return grain;
+				}
+
+				const crimild::Size CHUNKS_PER_WORKER = 8;
+				auto workerCount = static_cast< crimild::Size >( isSchedulerRunning() ? JobScheduler::getInstance()->getNumWorkers() + 1 : 1 );
+				auto g = range.size() / ( workerCount * CHUNKS_PER_WORKER );
+				return g > 0 ? g : 1;
+			}
+
+			/**
+			   \brief Recursively splits a range until it's no bigger than grain
+
+			   The upper half of a range is spawned as a new job (that may be 
+			   stolen by other workers) while the lower half is processed by the 
+			   current thread. Ranges are always split at multiples of grain, so 
+			   the resulting chunks are the same regardless of how many workers 
+			   are available.
+			 */
+			template< typename Fn >
+			void splitRange( Job *parent, Range range, crimild::Size grain, Fn const *fn )
+			{
+				while ( range.size() > grain ) {
+					auto chunkCount = ( range.size() + grain - 1 ) / grain;
+					auto mid = range.begin + ( chunkCount / 2 ) * grain;
+					Range upper( mid, range.end );
+					crimild::concurrency::async_arena( parent, [ parent, upper, grain, fn ] {
+						splitRange( parent, upper, grain, fn );
+					});
+					range.end = mid;
+				}
+
+				( *fn )( range );
+			}
+
+		}
+
+		/**
+		   \brief Executes a function for all sub-ranges in parallel
+
+		   The range is split into chunks of at most grain indices, which are
+		   processed by the scheduler's workers. The calling thread takes part
+		   in the computation and blocks until all chunks are done. If no 
+		   scheduler is running, the whole range is processed by the calling 
+		   thread instead.
+
+		   \param grain Maximum number of indices per chunk. If zero, the grain
+		   is computed based on the number of workers.
+		   \param fn A function receiving a sub-range: void( Range const & )
+		 */
+		template< typename Fn >
+		void parallel_for( Range const &range, crimild::Size grain, Fn const &fn )
+		{
+			if ( range.empty() ) {
+				return;
+			}
+
+			grain = internal::computeGrain( range, grain );
+			if ( range.size() <= grain || !internal::isSchedulerRunning() ) {
+				fn( range );
+				return;
+			}
+
+			auto root = crimild::concurrency::async_arena();
+			internal::splitRange( root, range, grain, &fn );
+			crimild::concurrency::wait( root );
+		}
+
+		/**
+		   \brief Computes a value in parallel for a range of indices
+
+		   Each chunk of at most grain indices is mapped to a partial result,
+		   and then all partial results are combined in order on the calling 
+		   thread. Chunks depend only on the range and the grain (not on how 
+		   they are scheduled), so the result is deterministic (even for 
+		   floating point types) as long as an explicit grain is provided. 
+		   If grain is zero, it's computed based on the number of workers 
+		   and results may differ between configurations.
+
+		   \param identity The initial value for the reduction
+		   \param map A function computing a partial result: T( Range const & )
+		   \param reduce A function combining two partial results: T( T const &, T const & )
+		 */
+		template< typename T, typename MapFn, typename ReduceFn >
+		T parallel_reduce( Range const &range, crimild::Size grain, T const &identity, MapFn const &map, ReduceFn const &reduce )
+		{
+			if ( range.empty() ) {
+				return identity;
+			}
+
+			grain = internal::computeGrain( range, grain );
+			auto chunkCount = ( range.size() + grain - 1 ) / grain;
+
+			std::vector< T > partials( chunkCount, identity );
+
+			parallel_for( Range( 0, chunkCount ), 1, [ &range, grain, &partials, &map ]( Range const &chunks ) {
+				for ( auto c = chunks.begin; c < chunks.end; c++ ) {
+					auto begin = range.begin + c * grain;
+					auto end = begin + grain < range.end ? begin + grain : range.end;
+					partials[ c ] = map( Range( begin, end ) );
+				}
+			});
+
+			auto result = identity;
+			for ( auto &p : partials ) {
+				result = reduce( result, p );
+			}
+			return result;
+		}
+
+	}
+
+}
+
+#endif
@@ -0,0 +1,176 @@
+/*
+ * Copyright (c) 2013, Hernan Saez
+ * All rights reserved.
+ * 
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *     * Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in the
+ *       documentation and/or other materials provided with the distribution.
+ *     * Neither the name of the <organization> nor the
+ *       names of its contributors may be used to endorse or promote products
+ *       derived from this software without specific prior written permission.
+ * 
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL <COPYRIGHT HOLDER> BE LIABLE FOR ANY
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "TaskGraph.hpp"
+#include "Async.hpp"
+#include "JobScheduler.hpp"
+
+#include "Foundation/Log.hpp"
+
+using namespace crimild;
+using namespace crimild::concurrency;
+
+TaskGraph::TaskGraph( void )
+{
+
+}
+
+TaskGraph::~TaskGraph( void )
+{
+
+}
+
+TaskGraph::TaskId TaskGraph::addTask( std::string name, TaskCallback const &callback, Affinity affinity )
+{
+	_tasks.push_back( Task { name, callback, affinity, std::vector< TaskId >(), 0 } );
+	return _tasks.size() - 1;
+}
+
+void TaskGraph::addDependency( TaskId task, TaskId dependency )
+{
+	if ( task >= _tasks.size() || dependency >= _tasks.size() ) {
+		Log::error( CRIMILD_CURRENT_CLASS_NAME, "Invalid task id" );
+		return;
+	}
+
+	_tasks[ dependency ].successors.push_back( task );
+	_tasks[ task ].dependencyCount++;
+}
+
+void TaskGraph::clear( void )
+{
+	_tasks.clear();
+	_pending = nullptr;
+}
+
+bool TaskGraph::isValid( void ) const
+{
+	// Kahn's algorithm: the graph is acyclic if all tasks can be sorted
+	std::vector< crimild::Size > counts;
+	std::vector< TaskId > ready;
+	for ( TaskId i = 0; i < _tasks.size(); i++ ) {
+		counts.push_back( _tasks[ i ].dependencyCount );
+		if ( counts[ i ] == 0 ) {
+			ready.push_back( i );
+		}
+	}
+
+	crimild::Size visited = 0;
+	while ( !ready.empty() ) {
+		auto id = ready.back();
+		ready.pop_back();
+		++visited;
+
+		for ( auto s : _tasks[ id ].successors ) {
+			if ( --counts[ s ] == 0 ) {
+				ready.push_back( s );
+			}
+		}
+	}
+
+	return visited == _tasks.size();
+}
+
+bool TaskGraph::execute( void )
+{
+	if ( !isValid() ) {
+		Log::error( CRIMILD_CURRENT_CLASS_NAME, "Cannot execute task graph since it contains cycles" );
+		return false;
+	}
+
+	auto count = _tasks.size();
+	_pending.reset( new std::atomic< crimild::Size >[ count ] );
+	for ( TaskId i = 0; i < count; i++ ) {
+		_pending[ i ] = _tasks[ i ].dependencyCount;
+	}
+
+	auto root = crimild::concurrency::async_arena();
+
+	for ( TaskId i = 0; i < count; i++ ) {
+		if ( _tasks[ i ].dependencyCount == 0 ) {
+			onTaskReady( root, i );
+		}
+	}
+
+	// help executing jobs until all tasks are done, giving priority to the
+	// ones that must be executed by this thread
+	auto scheduler = JobScheduler::getInstance();
+	while ( !root->isCompleted() ) {
+		TaskId id = 0;
+		bool hasCallerTask = false;
+		{
+			std::lock_guard< std::mutex > lock( _callerTasksMutex );
+			if ( !_callerTasks.empty() ) {
+				id = _callerTasks.front();
+				_callerTasks.pop_front();
+				hasCallerTask = true;
+			}
+		}
+
+		if ( hasCallerTask ) {
+			run( root, id );
+			root->finish();
+		}
+		else {
+			scheduler->executeNextJob();
+		}
+	}
+
+	crimild::concurrency::wait( root );
+
+	return true;
+}
+
+void TaskGraph::onTaskReady( Job *root, TaskId id )
+{
+	if ( _tasks[ id ].affinity == Affinity::CALLER ) {
+		// keep the root job alive until the task is executed
+		root->increaseChildCount();
+
+		std::lock_guard< std::mutex > lock( _callerTasksMutex );
+		_callerTasks.push_back( id );
+	}
+	else {
+		crimild::concurrency::async_arena( root, [ this, root, id ] {
+			run( root, id );
+		});
+	}
+}
+
+void TaskGraph::run( Job *root, TaskId id )
+{
+	auto &task = _tasks[ id ];
+	if ( task.callback != nullptr ) {
+		task.callback();
+	}
+
+	for ( auto s : task.successors ) {
+		if ( _pending[ s ].fetch_sub( 1, std::memory_order_acq_rel ) == 1 ) {
+			onTaskReady( root, s );
+		}
+	}
+}
@@ -0,0 +1,145 @@
+/*
+ * Copyright (c) 2013, Hernan Saez
+ * All rights reserved.
+ * 
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *     * Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in the
+ *       documentation and/or other materials provided with the distribution.
+ *     * Neither the name of the <organization> nor the
+ *       names of its contributors may be used to endorse or promote products
+ *       derived from this software without specific prior written permission.
+ * 
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL <COPYRIGHT HOLDER> BE LIABLE FOR ANY
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef CRIMILD_CORE_CONCURRENCY_TASK_GRAPH_
+#define CRIMILD_CORE_CONCURRENCY_TASK_GRAPH_
+
+#include "Job.hpp"
+
+#include "Foundation/SharedObject.hpp"
+#include "Foundation/Types.hpp"
+
+#include <atomic>
+#include <functional>
+#include <list>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+namespace crimild {
+
+	namespace concurrency {
+
+		/**
+		   \brief A set of tasks with dependencies between them
+
+		   Tasks are executed on the JobScheduler as soon as all of their 
+		   dependencies are completed, so independent branches of the graph
+		   run in parallel. A task may use parallel_for() or async() internally
+		   to split its own work.
+
+		   A graph can be executed many times. For example, a whole frame 
+		   can be described as a graph (update components, then world state,
+		   then render queues for each camera) and executed on every step.
+		 */
+		class TaskGraph : public SharedObject {
+		public:
+			using TaskId = crimild::Size;
+			using TaskCallback = std::function< void( void ) >;
+
+			/**
+			   \brief Indicates which threads may execute a task
+			 */
+			enum class Affinity {
+				/**
+				   \brief Any worker can execute the task
+				 */
+				ANY,
+
+				/**
+				   \brief The task is executed by the thread calling execute()
+
+				   Use it for tasks that are not thread safe or that need to
+				   run in the main thread (i.e. broadcasting messages)
+				 */
+				CALLER,
+			};
+
+		public:
+			TaskGraph( void );
+			virtual ~TaskGraph( void );
+
+			TaskId addTask( std::string name, TaskCallback const &callback, Affinity affinity = Affinity::ANY );
+
+			/**
+			   \brief Indicates that a task cannot start until another one is completed
+			 */
+			void addDependency( TaskId task, TaskId dependency );
+
+			crimild::Size getTaskCount( void ) const { return _tasks.size(); }
+
+			std::string const &getTaskName( TaskId task ) const { return _tasks[ task ].name; }
+
+			void clear( void );
+
+			/**
+			   \brief Checks that there are no cycles in the graph
+			 */
+			bool isValid( void ) const;
+
+			/**
+			   \brief Executes all tasks and waits for them to complete
+
+			   \returns false if the graph has cycles. No task is executed in that case
+			 */
+			bool execute( void );
+
+		private:
+			void run( Job *root, TaskId id );
+			void onTaskReady( Job *root, TaskId id );
+
+		private:
+			struct Task {
+				std::string name;
+				TaskCallback callback;
+				Affinity affinity;
+				std::vector< TaskId > successors;
+				crimild::Size dependencyCount;
+			};
+
+			std::vector< Task > _tasks;
+
+			/**
+			   \brief Remaining dependencies for each task during execution
+			 */
+			std::unique_ptr< std::atomic< crimild::Size >[] > _pending;
+
+			/**
+			   \brief Tasks ready to be executed by the calling thread
+			 */
+			std::list< TaskId > _callerTasks;
+			std::mutex _callerTasksMutex;
+		};
+
+		using TaskGraphPtr = SharedPointer< TaskGraph >;
+
+	}
+
+}
+
+#endif
@@ -29,102 +29,239 @@
 #define CRIMILD_CORE_CONCURRENCY_WORK_STEALING_QUEUE_
 
 #include "Foundation/SharedObject.hpp"
+#include "Foundation/Types.hpp"
 
+#include <atomic>
 #include <vector>
-#include <list>
-#include <mutex>
+#include <type_traits>
 
 namespace crimild {
 
 	/**
-	   \brief A double-ended queue implemeting the work stealing pattern
+	   \brief A lock-free double-ended queue implementing the work stealing pattern
+
+	   This is a Chase-Lev deque (using the memory model described in 
+	   "Correct and Efficient Work-Stealing for Weak Memory Models" by
+	   Le et al.). Only the thread owning the queue may call push() and 
+	   pop(), which operate on the private end (LIFO). Any other thread
+	   can call steal() to retrieve elements from the public end (FIFO).
+
+	   Elements are stored in a circular buffer that grows (doubling its 
+	   capacity) whenever it gets full. Old buffers are retired instead 
+	   of deleted, since thieves might still be reading from them, and 
+	   they're released only when the queue is destroyed. 
+
+	   \remarks T must be a trivially copyable type (usually a raw pointer), 
+	   since elements are read and written atomically. A default-constructed
+	   T (i.e. nullptr) is returned when no element could be retrieved.
 	 */
 	template< class T >
     class WorkStealingQueue : public SharedObject {
-		using Mutex = std::mutex;
-		using Lock = std::lock_guard< Mutex >;
-		
+		static_assert( std::is_trivially_copyable< T >::value, "WorkStealingQueue requires a trivially copyable type" );
+
+	private:
+		using Index = crimild::Int64;
+
+		/**
+		   \brief Circular buffer with a power-of-two capacity
+		 */
+		class Buffer {
+		public:
+			explicit Buffer( Index capacity )
+				: _capacity( capacity ),
+				  _mask( capacity - 1 ),
+				  _elems( new std::atomic< T >[ capacity ] )
+			{
+
+			}
+
+			~Buffer( void )
+			{
+				delete [] _elems;
+			}
+
+			Index capacity( void ) const { return _capacity; }
+
+			T get( Index i ) const
+			{
+				return _elems[ i & _mask ].load( std::memory_order_relaxed );
+			}
+
+			void put( Index i, T const &elem )
+			{
+				_elems[ i & _mask ].store( elem, std::memory_order_relaxed );
+			}
+
+			Buffer *grow( Index bottom, Index top ) const
+			{
+				auto buffer = new Buffer( 2 * _capacity );
+				for ( auto i = top; i != bottom; i++ ) {
+					buffer->put( i, get( i ) );
+				}
+				return buffer;
+			}
+
+		private:
+			Index _capacity;
+			Index _mask;
+			std::atomic< T > *_elems;
+		};
+
+	public:
+		static constexpr Index DEFAULT_CAPACITY = 1024;
+
 	public:
-		WorkStealingQueue( void )
+		/**
+		   \param capacity Initial capacity. Must be a power of two
+		 */
+		explicit WorkStealingQueue( Index capacity = DEFAULT_CAPACITY )
+			: _top( 0 ),
+			  _bottom( 0 ),
+			  _buffer( new Buffer( capacity ) )
 		{
 
 		}
 
 		~WorkStealingQueue( void )
 		{
-
+			delete _buffer.load( std::memory_order_relaxed );
+			for ( auto b : _retiredBuffers ) {
+				delete b;
+			}
 		}
-        
-		size_t size( void )
+
+		/**
+		   \brief Approximated number of elements in the queue
+
+		   \remarks The returned value might be outdated by the time this
+		   function returns if other threads are accessing the queue.
+		 */
+		size_t size( void ) const
 		{
-			Lock lock( _mutex );
-			return _elems.size();
+			auto b = _bottom.load( std::memory_order_relaxed );
+			auto t = _top.load( std::memory_order_relaxed );
+			return b > t ? static_cast< size_t >( b - t ) : 0;
 		}
 
-		bool empty( void )
+		bool empty( void ) const
 		{
 			return size() == 0;
 		}
 
-		void clear( void )
+		size_t capacity( void ) const
 		{
-			Lock lock( _mutex );
+			return static_cast< size_t >( _buffer.load( std::memory_order_relaxed )->capacity() );
+		}
+
+		/**
+		   \brief Discards all elements
 
-			_elems.clear();
+		   \warning Only the owner thread can call this method and 
+		   no other thread should be accessing the queue.
+		 */
+		void clear( void )
+		{
+			_bottom.store( _top.load( std::memory_order_relaxed ), std::memory_order_relaxed );
 		}
 
 		/**
 		   \brief Adds an element to the private end of the queue (LIFO)
 
+		   \warning Only the owner thread can call this method
 		 */
 		void push( T const &elem )
 		{
-			Lock lock( _mutex );
-			_elems.push_back( elem );
+			auto b = _bottom.load( std::memory_order_relaxed );
+			auto t = _top.load( std::memory_order_acquire );
+			auto buffer = _buffer.load( std::memory_order_relaxed );
+
+			if ( b - t > buffer->capacity() - 1 ) {
+				// queue is full. Grow it
+				_retiredBuffers.push_back( buffer );
+				buffer = buffer->grow( b, t );
+				_buffer.store( buffer, std::memory_order_release );
+			}
+
+			buffer->put( b, elem );
+			// release store instead of a standalone fence, which is
+			// equivalent here and is understood by ThreadSanitizer
+			_bottom.store( b + 1, std::memory_order_release );
 		}
 
 		/**
 		   \brief Retrieves an element from the private end of the queue (LIFO)
 
-		   \warning You should check if the collection is empty before calling this method.
+		   \warning Only the owner thread can call this method
 		 */
 		T pop( void )
 		{
-			Lock lock( _mutex );
-
-            if ( _elems.size() == 0 ) {
-                return nullptr;
-            }
-            
-			auto e = _elems.back();
-			_elems.pop_back();
-			return e;
+			auto b = _bottom.load( std::memory_order_relaxed ) - 1;
+			auto buffer = _buffer.load( std::memory_order_relaxed );
+			_bottom.store( b, std::memory_order_relaxed );
+			std::atomic_thread_fence( std::memory_order_seq_cst );
+			auto t = _top.load( std::memory_order_relaxed );
+
+			if ( t > b ) {
+				// queue was already empty
+				_bottom.store( b + 1, std::memory_order_relaxed );
+				return T();
+			}
+
+			auto elem = buffer->get( b );
+			if ( t == b ) {
+				// last element. Compete with thieves for it
+				if ( !_top.compare_exchange_strong( t, t + 1, std::memory_order_seq_cst, std::memory_order_relaxed ) ) {
+					elem = T();
+				}
+				_bottom.store( b + 1, std::memory_order_relaxed );
+			}
+
+			return elem;
 		}
 
 		/**
 		   \brief Retrieves an element from the public end of the queue (FIFO)
 
-		   \warning You should check if the collection is empty before calling this method
+		   Any thread can call this method. A default-constructed T is returned
+		   if the queue is empty or if another thread won the race for the 
+		   same element.
 		 */
 		T steal( void )
 		{
-			Lock lock( _mutex );
-            
-            if ( _elems.size() == 0 ) {
-                return nullptr;
-            }
-
-			auto e = _elems.front();
-			_elems.pop_front();
-			return e;
+			auto t = _top.load( std::memory_order_acquire );
+			std::atomic_thread_fence( std::memory_order_seq_cst );
+			auto b = _bottom.load( std::memory_order_acquire );
+
+			if ( t >= b ) {
+				return T();
+			}
+
+			auto buffer = _buffer.load( std::memory_order_acquire );
+			auto elem = buffer->get( t );
+			if ( !_top.compare_exchange_strong( t, t + 1, std::memory_order_seq_cst, std::memory_order_relaxed ) ) {
+				// lost the race
+				return T();
+			}
+
+			return elem;
 		}
 
 	private:
-        std::list< T > _elems;
-		std::mutex _mutex;
+		// top is modified by thieves while bottom is only modified by 
+		// the owner, so keep them in different cache lines
+		std::atomic< Index > _top;
+		char _topPadding[ 64 - sizeof( std::atomic< Index > ) ];
+		std::atomic< Index > _bottom;
+		std::atomic< Buffer * > _buffer;
+
+		/**
+		   \brief Buffers replaced after growing
+
+		   Only accessed by the owner thread
+		 */
+		std::vector< Buffer * > _retiredBuffers;
 	};
 
 }
 
 #endif
-
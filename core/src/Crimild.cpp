@@ -53,6 +53,7 @@ void crimild::init( void )
 	CRIMILD_REGISTER_OBJECT_BUILDER( crimild::SkinnedMesh );
     CRIMILD_REGISTER_OBJECT_BUILDER( crimild::Texture );
     CRIMILD_REGISTER_OBJECT_BUILDER( crimild::VertexBufferObject );
+    CRIMILD_REGISTER_OBJECT_BUILDER( crimild::StreamingVertexBufferObject );
     
 	CRIMILD_REGISTER_OBJECT_BUILDER( crimild::FreeLookCameraComponent );
     CRIMILD_REGISTER_OBJECT_BUILDER( crimild::MaterialComponent );
@@ -139,6 +140,9 @@ void crimild::init( void )
 
 	CRIMILD_REGISTER_OBJECT_BUILDER( crimild::animation::Animation );
 	CRIMILD_REGISTER_OBJECT_BUILDER( crimild::animation::Clip );
+	CRIMILD_REGISTER_OBJECT_BUILDER( crimild::animation::CompressedQuaternion4fChannel );
+	CRIMILD_REGISTER_OBJECT_BUILDER( crimild::animation::CompressedReal32Channel );
+	CRIMILD_REGISTER_OBJECT_BUILDER( crimild::animation::CompressedVector3fChannel );
 	CRIMILD_REGISTER_OBJECT_BUILDER( crimild::animation::Joint );
 	CRIMILD_REGISTER_OBJECT_BUILDER( crimild::animation::Quaternion4fChannel );	
 	CRIMILD_REGISTER_OBJECT_BUILDER( crimild::animation::Real32Channel );
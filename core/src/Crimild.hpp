@@ -39,6 +39,7 @@
 #include "Mathematics/Quaternion.hpp"
 #include "Mathematics/Random.hpp"
 #include "Mathematics/Ray.hpp"
+#include "Mathematics/RayPacket.hpp"
 #include "Mathematics/Rect.hpp"
 #include "Mathematics/Root.hpp"
 #include "Mathematics/Sphere.hpp"
@@ -55,6 +56,8 @@
 #include "Foundation/Singleton.hpp"
 #include "Foundation/Profiler.hpp"
 #include "Foundation/Version.hpp"
+#include "Foundation/RadixSort.hpp"
+#include "Foundation/MappedFile.hpp"
 
 #include "Foundation/Containers/Array.hpp"
 #include "Foundation/Containers/Map.hpp"
@@ -72,6 +75,9 @@
 #include "Coding/MemoryDecoder.hpp"
 #include "Coding/FileEncoder.hpp"
 #include "Coding/FileDecoder.hpp"
+#include "Coding/BinaryFormat.hpp"
+#include "Coding/BinaryEncoder.hpp"
+#include "Coding/BinaryDecoder.hpp"
 #include "Coding/Tags.hpp"
 
 #include "Audio/AudioListener.hpp"
@@ -82,6 +88,8 @@
 #include "Boundings/PlaneBoundingVolume.hpp"
 #include "Boundings/SphereBoundingVolume.hpp"
 #include "Boundings/AABBBoundingVolume.hpp"
+#include "Boundings/BatchCulling.hpp"
+#include "Boundings/DynamicAABBTree.hpp"
 
 #include "Exceptions/Exception.hpp"
 #include "Exceptions/FileNotFoundException.hpp"
@@ -95,6 +103,8 @@
 #include "SceneGraph/Node.hpp"
 #include "SceneGraph/Switch.hpp"
 #include "SceneGraph/Text.hpp"
+#include "SceneGraph/TransformHierarchy.hpp"
+#include "SceneGraph/SpatialIndex.hpp"
 
 #include "Behaviors/Behavior.hpp"
 #include "Behaviors/BehaviorContext.hpp"
@@ -161,7 +171,11 @@
 
 #include "Concurrency/Async.hpp"
 #include "Concurrency/Job.hpp"
+#include "Concurrency/JobArena.hpp"
+#include "Concurrency/JobClosure.hpp"
 #include "Concurrency/JobScheduler.hpp"
+#include "Concurrency/ParallelFor.hpp"
+#include "Concurrency/TaskGraph.hpp"
 #include "Concurrency/WorkStealingDeque.hpp"
 
 #include "Visitors/Apply.hpp"
@@ -180,6 +194,9 @@
 
 #include "ParticleSystem/ParticleData.hpp"
 #include "ParticleSystem/ParticleSystemComponent.hpp"
+#include "ParticleSystem/ParticleSystemBatch.hpp"
+#include "ParticleSystem/ParticleKernels.hpp"
+#include "ParticleSystem/ParticleSorter.hpp"
 #include "ParticleSystem/Generators/BoxPositionParticleGenerator.hpp"
 #include "ParticleSystem/Generators/GridPositionParticleGenerator.hpp"
 #include "ParticleSystem/Generators/VelocityParticleGenerator.hpp"
@@ -232,6 +249,7 @@
 #include "Rendering/IndexBufferObject.hpp"
 #include "Rendering/Material.hpp"
 #include "Rendering/RenderState.hpp"
+#include "Rendering/RenderStateCache.hpp"
 #include "Rendering/Renderer.hpp"
 #include "Rendering/Shader.hpp"
 #include "Rendering/ShaderLocation.hpp"
@@ -241,6 +259,7 @@
 #include "Rendering/SkinnedMesh.hpp"
 #include "Rendering/Texture.hpp"
 #include "Rendering/VertexBufferObject.hpp"
+#include "Rendering/StreamingVertexBufferObject.hpp"
 #include "Rendering/VertexFormat.hpp"
 
 #include "Rendering/RenderPasses/CompositeRenderPass.hpp"
@@ -286,6 +305,13 @@
 #include "Animation/Skeleton.hpp"
 #include "Animation/Animation.hpp"
 #include "Animation/ChannelImpl.hpp"
+#include "Animation/KeyframeCursor.hpp"
+#include "Animation/CompressedChannel.hpp"
+#include "Animation/Pose.hpp"
+#include "Animation/ClipBinding.hpp"
+#include "Animation/PoseAnimator.hpp"
+#include "Animation/PoseBatch.hpp"
+#include "Animation/SkinningEngine.hpp"
 
 #include "Debug/DebugRenderHelper.hpp"
 #include "Debug/SceneDebugDump.hpp"
@@ -0,0 +1,140 @@
+/*
+ * Copyright (c) 2013, Hernan Saez
+ * All rights reserved.
+ * 
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *     * Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in the
+ *       documentation and/or other materials provided with the distribution.
+ *     * Neither the name of the <organization> nor the
+ *       names of its contributors may be used to endorse or promote products
+ *       derived from this software without specific prior written permission.
+ * 
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL <COPYRIGHT HOLDER> BE LIABLE FOR ANY
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "MappedFile.hpp"
+#include "Log.hpp"
+#include "Macros.hpp"
+
+#include <cstdio>
+
+#if !defined( CRIMILD_PLATFORM_WIN32 ) && !defined( CRIMILD_PLATFORM_EMSCRIPTEN )
+	#define CRIMILD_MAPPED_FILE_USE_MMAP 1
+	#include <fcntl.h>
+	#include <sys/mman.h>
+	#include <sys/stat.h>
+	#include <unistd.h>
+#endif
+
+using namespace crimild;
+
+MappedFile::MappedFile( void )
+{
+
+}
+
+MappedFile::~MappedFile( void )
+{
+	close();
+}
+
+crimild::Bool MappedFile::open( std::string path )
+{
+	close();
+
+#ifdef CRIMILD_MAPPED_FILE_USE_MMAP
+	int fd = ::open( path.c_str(), O_RDONLY );
+	if ( fd < 0 ) {
+		Log::error( CRIMILD_CURRENT_CLASS_NAME, "Cannot open file ", path );
+		return false;
+	}
+
+	struct stat st;
+	if ( fstat( fd, &st ) != 0 || st.st_size <= 0 ) {
+		Log::error( CRIMILD_CURRENT_CLASS_NAME, "Cannot map empty file ", path );
+		::close( fd );
+		return false;
+	}
+
+	auto size = static_cast< crimild::Size >( st.st_size );
+	auto data = mmap( nullptr, size, PROT_READ | PROT_WRITE, MAP_PRIVATE, fd, 0 );
+
+	// the mapping remains valid after closing the descriptor
+	::close( fd );
+
+	if ( data == MAP_FAILED ) {
+		Log::error( CRIMILD_CURRENT_CLASS_NAME, "Cannot map file ", path );
+		return false;
+	}
+
+	_data = static_cast< crimild::Byte * >( data );
+	_size = size;
+	_mapped = true;
+
+	return true;
+#else
+	FILE *file = fopen( path.c_str(), "rb" );
+	if ( file == nullptr ) {
+		Log::error( CRIMILD_CURRENT_CLASS_NAME, "Cannot open file ", path );
+		return false;
+	}
+
+	fseek( file, 0, SEEK_END );
+	auto size = ftell( file );
+	fseek( file, 0, SEEK_SET );
+
+	if ( size <= 0 ) {
+		Log::error( CRIMILD_CURRENT_CLASS_NAME, "Cannot read empty file ", path );
+		fclose( file );
+		return false;
+	}
+
+	_buffer.resize( size );
+	auto readCount = fread( _buffer.getData(), 1, size, file );
+	fclose( file );
+
+	if ( readCount != static_cast< crimild::Size >( size ) ) {
+		Log::error( CRIMILD_CURRENT_CLASS_NAME, "Cannot read file ", path );
+		_buffer.clear();
+		return false;
+	}
+
+	_data = _buffer.getData();
+	_size = size;
+	_mapped = false;
+
+	return true;
+#endif
+}
+
+void MappedFile::close( void )
+{
+	if ( _data == nullptr ) {
+		return;
+	}
+
+#ifdef CRIMILD_MAPPED_FILE_USE_MMAP
+	if ( _mapped ) {
+		munmap( _data, _size );
+	}
+#endif
+
+	_buffer.clear();
+	_data = nullptr;
+	_size = 0;
+	_mapped = false;
+}
+
@@ -0,0 +1,85 @@
+/*
+ * Copyright (c) 2013, Hernan Saez
+ * All rights reserved.
+ * 
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *     * Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in the
+ *       documentation and/or other materials provided with the distribution.
+ *     * Neither the name of the <organization> nor the
+ *       names of its contributors may be used to endorse or promote products
+ *       derived from this software without specific prior written permission.
+ * 
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL <COPYRIGHT HOLDER> BE LIABLE FOR ANY
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef CRIMILD_FOUNDATION_MAPPED_FILE_
+#define CRIMILD_FOUNDATION_MAPPED_FILE_
+
+#include "SharedObject.hpp"
+#include "Types.hpp"
+#include "Containers/Array.hpp"
+
+#include <string>
+
+namespace crimild {
+
+	/**
+		\brief Provides access to the contents of a file as a single block of memory
+
+		On platforms supporting it, files are memory-mapped so pages are only
+		loaded when they are actually accessed. Mappings are private (copy-on-write), 
+		meaning the returned memory can be modified without changing the file 
+		on disk. On other platforms, the whole file is read into memory instead.
+
+		Objects pointing to the mapped memory should keep a reference to
+		the MappedFile in order to prevent it from being unmapped. Files
+		must not be modified while they are mapped.
+	*/
+	class MappedFile : public SharedObject {
+	public:
+		MappedFile( void );
+		virtual ~MappedFile( void );
+
+		crimild::Bool open( std::string path );
+		void close( void );
+
+		crimild::Bool isOpen( void ) const { return _data != nullptr; }
+
+		/**
+			\brief Indicates if the file is memory-mapped or it has been read into memory
+		*/
+		crimild::Bool isMapped( void ) const { return _mapped; }
+
+		crimild::Byte *getData( void ) { return _data; }
+		const crimild::Byte *getData( void ) const { return _data; }
+
+		crimild::Size getSize( void ) const { return _size; }
+
+	private:
+		crimild::Byte *_data = nullptr;
+		crimild::Size _size = 0;
+		crimild::Bool _mapped = false;
+
+		/**
+			\brief Fallback storage when memory-mapping is not available
+		*/
+		containers::ByteArray _buffer;
+	};
+
+}
+
+#endif
+
@@ -120,6 +120,13 @@ void ProfilerOutputHandler::sample( float minPc, float avgPc, float maxPc, unsig
 			<< "\n";
 }
 
+void ProfilerOutputHandler::counter( std::string name, crimild::Size value )
+{
+	_output << std::setw( 10 ) << std::right << value << " | "
+			<< std::left << name
+			<< "\n";
+}
+
 void ProfilerOutputHandler::endOutput( void )
 {
     _output << "\n";
@@ -296,6 +303,11 @@ void Profiler::resetAll( void )
 	_lastFrameTime = getTime();
 }
 
+void Profiler::setCounter( std::string name, crimild::Size value )
+{
+	_counters[ name ] = value;
+}
+
 void Profiler::step( void )
 {
 	_frameCount++;
@@ -342,6 +354,10 @@ void Profiler::dump( void )
 		}
 	}
 
+	for ( auto &it : _counters ) {
+		getOutputHandler()->counter( it.first, it.second );
+	}
+
     getOutputHandler()->endOutput();
 
     const auto HISTOGRAM_WIDTH = 1.1f;
@@ -61,6 +61,7 @@ namespace crimild {
 
         virtual void beginOutput( crimild::Size fps, crimild::Real64 avgFrameTime, crimild::Real64 minFrameTime, crimild::Real64 maxFrameTime );
         virtual void sample( float minPc, float avgPc, float maxPc, unsigned int totalTime, unsigned int callCount, std::string name, unsigned int parentCount );
+        virtual void counter( std::string name, crimild::Size value );
         virtual void endOutput( void );
 
     protected:
@@ -103,6 +104,14 @@ namespace crimild {
         void resetAll( void );
         void reset( std::string name );
 
+        /**
+            \brief Sets the value for a counter (i.e. number of updated nodes)
+
+            Counters keep the last value set and are displayed 
+            after all samples when dumping results.
+         */
+        void setCounter( std::string name, crimild::Size value );
+
         void setOutputHandler( ProfilerOutputHandlerPtr const &handler ) { _outputHandler = handler; }
         ProfilerOutputHandlerPtr &getOutputHandler( void ) { return _outputHandler; }
 
@@ -139,6 +148,8 @@ namespace crimild {
 
         ProfilerSampleInfo _samples[ MAX_SAMPLES ];
 
+        std::map< std::string, crimild::Size > _counters;
+
         int _lastOpenedSample = -1;
         int _openSampleCount = 0;
         float _rootBegin = 0.0f;
@@ -161,8 +172,10 @@ namespace crimild {
 
 #if CRIMILD_PROFILER_ENABLED
     #define CRIMILD_PROFILE( X ) crimild::ProfilerSample __crimild__profile__sample__instance__( X );
+    #define CRIMILD_PROFILE_COUNTER( X, VALUE ) crimild::Profiler::getInstance()->setCounter( X, VALUE );
 #else
     #define CRIMILD_PROFILE( X )
+    #define CRIMILD_PROFILE_COUNTER( X, VALUE )
 #endif
 
 #endif
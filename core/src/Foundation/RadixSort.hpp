@@ -0,0 +1,163 @@
+/*
+ * Copyright (c) 2013, Hernan Saez
+ * All rights reserved.
+ * 
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *     * Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in the
+ *       documentation and/or other materials provided with the distribution.
+ *     * Neither the name of the <organization> nor the
+ *       names of its contributors may be used to endorse or promote products
+ *       derived from this software without specific prior written permission.
+ * 
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL <COPYRIGHT HOLDER> BE LIABLE FOR ANY
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef CRIMILD_FOUNDATION_RADIX_SORT_
+#define CRIMILD_FOUNDATION_RADIX_SORT_
+
+#include "Foundation/Types.hpp"
+
+#include <algorithm>
+#include <cstring>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace crimild {
+
+	/**
+		\brief Stable LSD radix sort for unsigned integer keys
+
+		Keys are sorted DIGIT_BITS at a time along with their values 
+		(usually indices into some other array). Passes in which all keys 
+		share the same digit are skipped, so keys that only use a few bits
+		are cheap to sort.
+
+		Wider digits mean fewer passes over the data, at the cost of bigger
+		histograms. For example, 11-bit digits sort 32-bit keys in three 
+		passes instead of four, which pays off when sorting thousands of 
+		elements but not for small arrays.
+
+		Scratch buffers are kept between calls, meaning that sorting the 
+		same number of elements every frame does not allocate memory.
+	*/
+	template< typename KEY_TYPE, typename VALUE_TYPE, crimild::Size DIGIT_BITS = 8 >
+	class RadixSort {
+		static_assert( std::is_unsigned< KEY_TYPE >::value, "Radix sort keys must be unsigned integers" );
+		static_assert( DIGIT_BITS > 0 && DIGIT_BITS <= 16, "Invalid digit size" );
+
+	private:
+		static const crimild::Size KEY_BITS = 8 * sizeof( KEY_TYPE );
+		static const crimild::Size DIGIT_COUNT = ( KEY_BITS + DIGIT_BITS - 1 ) / DIGIT_BITS;
+		static const crimild::Size BUCKET_COUNT = crimild::Size( 1 ) << DIGIT_BITS;
+		static const crimild::Size DIGIT_MASK = BUCKET_COUNT - 1;
+
+	public:
+		/**
+			\brief Sorts keys in ascending order, moving values along
+
+			Elements with equal keys keep their relative order
+		*/
+		void sort( KEY_TYPE *keys, VALUE_TYPE *values, crimild::Size count )
+		{
+			if ( count < 2 ) {
+				return;
+			}
+
+			if ( _keys.size() < count ) {
+				_keys.resize( count );
+				_values.resize( count );
+			}
+
+			// compute histograms for all digits at once (kept between 
+			// calls, since wide digits don't fit in the stack)
+			_histograms.resize( DIGIT_COUNT * BUCKET_COUNT );
+			std::fill( _histograms.begin(), _histograms.end(), 0 );
+			auto histograms = &_histograms[ 0 ];
+			for ( crimild::Size i = 0; i < count; i++ ) {
+				auto key = keys[ i ];
+				for ( crimild::Size d = 0; d < DIGIT_COUNT; d++ ) {
+					++histograms[ d * BUCKET_COUNT + ( ( key >> ( d * DIGIT_BITS ) ) & DIGIT_MASK ) ];
+				}
+			}
+
+			auto srcKeys = keys;
+			auto srcValues = values;
+			auto dstKeys = &_keys[ 0 ];
+			auto dstValues = &_values[ 0 ];
+
+			for ( crimild::Size d = 0; d < DIGIT_COUNT; d++ ) {
+				auto histogram = histograms + d * BUCKET_COUNT;
+				auto shift = d * DIGIT_BITS;
+
+				// all keys share this digit, so there's nothing to do
+				if ( histogram[ ( srcKeys[ 0 ] >> shift ) & DIGIT_MASK ] == count ) {
+					continue;
+				}
+
+				crimild::Size offset = 0;
+				for ( crimild::Size b = 0; b < BUCKET_COUNT; b++ ) {
+					auto bucketCount = histogram[ b ];
+					histogram[ b ] = offset;
+					offset += bucketCount;
+				}
+
+				for ( crimild::Size i = 0; i < count; i++ ) {
+					auto key = srcKeys[ i ];
+					auto idx = histogram[ ( key >> shift ) & DIGIT_MASK ]++;
+					dstKeys[ idx ] = key;
+					dstValues[ idx ] = srcValues[ i ];
+				}
+
+				std::swap( srcKeys, dstKeys );
+				std::swap( srcValues, dstValues );
+			}
+
+			if ( srcKeys != keys ) {
+				std::memcpy( keys, srcKeys, count * sizeof( KEY_TYPE ) );
+				std::memcpy( values, srcValues, count * sizeof( VALUE_TYPE ) );
+			}
+		}
+
+		void sort( std::vector< KEY_TYPE > &keys, std::vector< VALUE_TYPE > &values )
+		{
+			if ( !keys.empty() ) {
+				sort( &keys[ 0 ], &values[ 0 ], keys.size() );
+			}
+		}
+
+	private:
+		std::vector< KEY_TYPE > _keys;
+		std::vector< VALUE_TYPE > _values;
+		std::vector< crimild::Size > _histograms;
+	};
+
+	/**
+		\brief Maps a float into an unsigned integer that preserves its order
+
+		Useful for sorting by depth. Positive values only need their sign bit
+		set, while negative ones are inverted so larger magnitudes come first.
+	*/
+	inline crimild::UInt32 radixSortKey( crimild::Real32 value )
+	{
+		crimild::UInt32 bits;
+		std::memcpy( &bits, &value, sizeof( bits ) );
+		return ( bits & 0x80000000 ) ? ~bits : ( bits | 0x80000000 );
+	}
+
+}
+
+#endif
@@ -0,0 +1,369 @@
+/*
+ * Copyright (c) 2013, Hernan Saez
+ * All rights reserved.
+ * 
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *     * Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in the
+ *       documentation and/or other materials provided with the distribution.
+ *     * Neither the name of the <organization> nor the
+ *       names of its contributors may be used to endorse or promote products
+ *       derived from this software without specific prior written permission.
+ * 
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL <COPYRIGHT HOLDER> BE LIABLE FOR ANY
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "Intersection.hpp"
+#include "Simd.hpp"
+
+#include <cmath>
+
+using namespace crimild;
+
+namespace crimild {
+
+	namespace internal {
+
+		/*
+		   All kernels compute dot products as ( x * x + y * y ) + z * z and 
+		   roots as ( -b -/+ sqrt( b * b - 4 * a * c ) ) / ( 2 * a ), choosing
+		   the nearest one inside the valid range. Keep it that way, or results
+		   will differ between kernels (that also means multiplications and 
+		   additions must not be contracted into FMA instructions).
+
+		   Box tests mirror the scalar slab test used for BVH traversal, 
+		   including how NaNs are handled when a ray lies on a slab plane.
+		 */
+
+		crimild::UInt32 findSphereScalar( const Sphere3f &sphere, const crimild::Real32 *ox, const crimild::Real32 *oy, const crimild::Real32 *oz, const crimild::Real32 *dx, const crimild::Real32 *dy, const crimild::Real32 *dz, crimild::Real32 *t, crimild::Real32 lowerBound, crimild::Size count )
+		{
+			const auto &center = sphere.getCenter();
+			const auto r2 = sphere.getRadius() * sphere.getRadius();
+
+			crimild::UInt32 result = 0;
+			for ( crimild::Size i = 0; i < count; i++ ) {
+				const crimild::Real32 cx = ox[ i ] - center[ 0 ];
+				const crimild::Real32 cy = oy[ i ] - center[ 1 ];
+				const crimild::Real32 cz = oz[ i ] - center[ 2 ];
+				const crimild::Real32 a = dx[ i ] * dx[ i ] + dy[ i ] * dy[ i ] + dz[ i ] * dz[ i ];
+				const crimild::Real32 b = 2.0f * ( cx * dx[ i ] + cy * dy[ i ] + cz * dz[ i ] );
+				const crimild::Real32 c = ( cx * cx + cy * cy + cz * cz ) - r2;
+				const crimild::Real32 discriminant = b * b - 4.0f * a * c;
+				if ( !( discriminant >= 0.0f ) ) {
+					continue;
+				}
+
+				const crimild::Real32 sqrtDiscriminant = std::sqrt( discriminant );
+				const crimild::Real32 twoA = 2.0f * a;
+				const crimild::Real32 t0 = ( -b - sqrtDiscriminant ) / twoA;
+				const crimild::Real32 t1 = ( -b + sqrtDiscriminant ) / twoA;
+				if ( t0 > lowerBound && t0 < t[ i ] ) {
+					t[ i ] = t0;
+					result |= ( 1u << i );
+				}
+				else if ( t1 > lowerBound && t1 < t[ i ] ) {
+					t[ i ] = t1;
+					result |= ( 1u << i );
+				}
+			}
+
+			return result;
+		}
+
+		crimild::UInt32 testBoxScalar( const Vector3f &min, const Vector3f &max, const crimild::Real32 *ox, const crimild::Real32 *oy, const crimild::Real32 *oz, const crimild::Real32 *ix, const crimild::Real32 *iy, const crimild::Real32 *iz, const crimild::Real32 *tMax, crimild::Real32 tMin, crimild::Size count )
+		{
+			crimild::UInt32 result = 0;
+			for ( crimild::Size i = 0; i < count; i++ ) {
+				const crimild::Real32 origin[] = { ox[ i ], oy[ i ], oz[ i ] };
+				const crimild::Real32 invDirection[] = { ix[ i ], iy[ i ], iz[ i ] };
+
+				auto tNear = tMin;
+				auto tFar = tMax[ i ];
+				for ( crimild::Size axis = 0; axis < 3; axis++ ) {
+					const crimild::Real32 t0 = ( min[ axis ] - origin[ axis ] ) * invDirection[ axis ];
+					const crimild::Real32 t1 = ( max[ axis ] - origin[ axis ] ) * invDirection[ axis ];
+					const auto lo = t0 > t1 ? t1 : t0;
+					const auto hi = t0 > t1 ? t0 : t1;
+					tNear = lo > tNear ? lo : tNear;
+					tFar = hi < tFar ? hi : tFar;
+				}
+
+				if ( tNear <= tFar ) {
+					result |= ( 1u << i );
+				}
+			}
+
+			return result;
+		}
+
+		/**
+		   \brief Stores the new intersection times for the rays in a mask
+		 */
+		inline void storeTimes( const crimild::Real32 *values, crimild::UInt32 mask, crimild::Real32 *t, crimild::Size count )
+		{
+			for ( crimild::Size i = 0; i < count; i++ ) {
+				if ( mask & ( 1u << i ) ) {
+					t[ i ] = values[ i ];
+				}
+			}
+		}
+
+#if defined( CRIMILD_SIMD_SSE )
+
+		crimild::UInt32 findSphereSSE( const Sphere3f &sphere, const crimild::Real32 *ox, const crimild::Real32 *oy, const crimild::Real32 *oz, const crimild::Real32 *dx, const crimild::Real32 *dy, const crimild::Real32 *dz, crimild::Real32 *t, crimild::Real32 lowerBound )
+		{
+			const auto &center = sphere.getCenter();
+
+			auto dirX = _mm_loadu_ps( dx );
+			auto dirY = _mm_loadu_ps( dy );
+			auto dirZ = _mm_loadu_ps( dz );
+			auto cx = _mm_sub_ps( _mm_loadu_ps( ox ), _mm_set1_ps( center[ 0 ] ) );
+			auto cy = _mm_sub_ps( _mm_loadu_ps( oy ), _mm_set1_ps( center[ 1 ] ) );
+			auto cz = _mm_sub_ps( _mm_loadu_ps( oz ), _mm_set1_ps( center[ 2 ] ) );
+
+			auto a = _mm_add_ps( _mm_add_ps( _mm_mul_ps( dirX, dirX ), _mm_mul_ps( dirY, dirY ) ), _mm_mul_ps( dirZ, dirZ ) );
+			auto b = _mm_mul_ps( _mm_set1_ps( 2.0f ), _mm_add_ps( _mm_add_ps( _mm_mul_ps( cx, dirX ), _mm_mul_ps( cy, dirY ) ), _mm_mul_ps( cz, dirZ ) ) );
+			auto c = _mm_sub_ps( _mm_add_ps( _mm_add_ps( _mm_mul_ps( cx, cx ), _mm_mul_ps( cy, cy ) ), _mm_mul_ps( cz, cz ) ), _mm_set1_ps( sphere.getRadius() * sphere.getRadius() ) );
+			auto discriminant = _mm_sub_ps( _mm_mul_ps( b, b ), _mm_mul_ps( _mm_mul_ps( _mm_set1_ps( 4.0f ), a ), c ) );
+			auto valid = _mm_cmpge_ps( discriminant, _mm_setzero_ps() );
+
+			// negative discriminants are masked out, so their roots don't matter
+			auto sqrtDiscriminant = _mm_sqrt_ps( _mm_and_ps( discriminant, valid ) );
+			auto twoA = _mm_mul_ps( _mm_set1_ps( 2.0f ), a );
+			auto negB = _mm_sub_ps( _mm_setzero_ps(), b );
+			auto t0 = _mm_div_ps( _mm_sub_ps( negB, sqrtDiscriminant ), twoA );
+			auto t1 = _mm_div_ps( _mm_add_ps( negB, sqrtDiscriminant ), twoA );
+
+			auto lower = _mm_set1_ps( lowerBound );
+			auto upper = _mm_loadu_ps( t );
+			auto in0 = _mm_and_ps( valid, _mm_and_ps( _mm_cmpgt_ps( t0, lower ), _mm_cmplt_ps( t0, upper ) ) );
+			auto in1 = _mm_and_ps( valid, _mm_and_ps( _mm_cmpgt_ps( t1, lower ), _mm_cmplt_ps( t1, upper ) ) );
+			auto nearest = _mm_or_ps( _mm_and_ps( in0, t0 ), _mm_andnot_ps( in0, t1 ) );
+
+			crimild::Real32 values[ 4 ];
+			_mm_storeu_ps( values, nearest );
+			auto mask = static_cast< crimild::UInt32 >( _mm_movemask_ps( _mm_or_ps( in0, in1 ) ) );
+			storeTimes( values, mask, t, 4 );
+			return mask;
+		}
+
+		crimild::UInt32 testBoxSSE( const Vector3f &min, const Vector3f &max, const crimild::Real32 *ox, const crimild::Real32 *oy, const crimild::Real32 *oz, const crimild::Real32 *ix, const crimild::Real32 *iy, const crimild::Real32 *iz, const crimild::Real32 *tMax, crimild::Real32 tMin )
+		{
+			const crimild::Real32 *origin[] = { ox, oy, oz };
+			const crimild::Real32 *invDirection[] = { ix, iy, iz };
+
+			auto tNear = _mm_set1_ps( tMin );
+			auto tFar = _mm_loadu_ps( tMax );
+			for ( crimild::Size axis = 0; axis < 3; axis++ ) {
+				auto o = _mm_loadu_ps( origin[ axis ] );
+				auto inv = _mm_loadu_ps( invDirection[ axis ] );
+				auto t0 = _mm_mul_ps( _mm_sub_ps( _mm_set1_ps( min[ axis ] ), o ), inv );
+				auto t1 = _mm_mul_ps( _mm_sub_ps( _mm_set1_ps( max[ axis ] ), o ), inv );
+
+				// operand order matters, since min/max return the second operand for NaNs
+				auto lo = _mm_min_ps( t1, t0 );
+				auto hi = _mm_max_ps( t0, t1 );
+				tNear = _mm_max_ps( lo, tNear );
+				tFar = _mm_min_ps( hi, tFar );
+			}
+
+			return static_cast< crimild::UInt32 >( _mm_movemask_ps( _mm_cmple_ps( tNear, tFar ) ) );
+		}
+
+#endif
+
+#if defined( CRIMILD_SIMD_AVX )
+
+		crimild::UInt32 findSphereAVX( const Sphere3f &sphere, const crimild::Real32 *ox, const crimild::Real32 *oy, const crimild::Real32 *oz, const crimild::Real32 *dx, const crimild::Real32 *dy, const crimild::Real32 *dz, crimild::Real32 *t, crimild::Real32 lowerBound )
+		{
+			const auto &center = sphere.getCenter();
+
+			auto dirX = _mm256_loadu_ps( dx );
+			auto dirY = _mm256_loadu_ps( dy );
+			auto dirZ = _mm256_loadu_ps( dz );
+			auto cx = _mm256_sub_ps( _mm256_loadu_ps( ox ), _mm256_set1_ps( center[ 0 ] ) );
+			auto cy = _mm256_sub_ps( _mm256_loadu_ps( oy ), _mm256_set1_ps( center[ 1 ] ) );
+			auto cz = _mm256_sub_ps( _mm256_loadu_ps( oz ), _mm256_set1_ps( center[ 2 ] ) );
+
+			auto a = _mm256_add_ps( _mm256_add_ps( _mm256_mul_ps( dirX, dirX ), _mm256_mul_ps( dirY, dirY ) ), _mm256_mul_ps( dirZ, dirZ ) );
+			auto b = _mm256_mul_ps( _mm256_set1_ps( 2.0f ), _mm256_add_ps( _mm256_add_ps( _mm256_mul_ps( cx, dirX ), _mm256_mul_ps( cy, dirY ) ), _mm256_mul_ps( cz, dirZ ) ) );
+			auto c = _mm256_sub_ps( _mm256_add_ps( _mm256_add_ps( _mm256_mul_ps( cx, cx ), _mm256_mul_ps( cy, cy ) ), _mm256_mul_ps( cz, cz ) ), _mm256_set1_ps( sphere.getRadius() * sphere.getRadius() ) );
+			auto discriminant = _mm256_sub_ps( _mm256_mul_ps( b, b ), _mm256_mul_ps( _mm256_mul_ps( _mm256_set1_ps( 4.0f ), a ), c ) );
+			auto valid = _mm256_cmp_ps( discriminant, _mm256_setzero_ps(), _CMP_GE_OQ );
+
+			auto sqrtDiscriminant = _mm256_sqrt_ps( _mm256_and_ps( discriminant, valid ) );
+			auto twoA = _mm256_mul_ps( _mm256_set1_ps( 2.0f ), a );
+			auto negB = _mm256_sub_ps( _mm256_setzero_ps(), b );
+			auto t0 = _mm256_div_ps( _mm256_sub_ps( negB, sqrtDiscriminant ), twoA );
+			auto t1 = _mm256_div_ps( _mm256_add_ps( negB, sqrtDiscriminant ), twoA );
+
+			auto lower = _mm256_set1_ps( lowerBound );
+			auto upper = _mm256_loadu_ps( t );
+			auto in0 = _mm256_and_ps( valid, _mm256_and_ps( _mm256_cmp_ps( t0, lower, _CMP_GT_OQ ), _mm256_cmp_ps( t0, upper, _CMP_LT_OQ ) ) );
+			auto in1 = _mm256_and_ps( valid, _mm256_and_ps( _mm256_cmp_ps( t1, lower, _CMP_GT_OQ ), _mm256_cmp_ps( t1, upper, _CMP_LT_OQ ) ) );
+			auto nearest = _mm256_blendv_ps( t1, t0, in0 );
+
+			crimild::Real32 values[ 8 ];
+			_mm256_storeu_ps( values, nearest );
+			auto mask = static_cast< crimild::UInt32 >( _mm256_movemask_ps( _mm256_or_ps( in0, in1 ) ) );
+			storeTimes( values, mask, t, 8 );
+			return mask;
+		}
+
+		crimild::UInt32 testBoxAVX( const Vector3f &min, const Vector3f &max, const crimild::Real32 *ox, const crimild::Real32 *oy, const crimild::Real32 *oz, const crimild::Real32 *ix, const crimild::Real32 *iy, const crimild::Real32 *iz, const crimild::Real32 *tMax, crimild::Real32 tMin )
+		{
+			const crimild::Real32 *origin[] = { ox, oy, oz };
+			const crimild::Real32 *invDirection[] = { ix, iy, iz };
+
+			auto tNear = _mm256_set1_ps( tMin );
+			auto tFar = _mm256_loadu_ps( tMax );
+			for ( crimild::Size axis = 0; axis < 3; axis++ ) {
+				auto o = _mm256_loadu_ps( origin[ axis ] );
+				auto inv = _mm256_loadu_ps( invDirection[ axis ] );
+				auto t0 = _mm256_mul_ps( _mm256_sub_ps( _mm256_set1_ps( min[ axis ] ), o ), inv );
+				auto t1 = _mm256_mul_ps( _mm256_sub_ps( _mm256_set1_ps( max[ axis ] ), o ), inv );
+
+				auto lo = _mm256_min_ps( t1, t0 );
+				auto hi = _mm256_max_ps( t0, t1 );
+				tNear = _mm256_max_ps( lo, tNear );
+				tFar = _mm256_min_ps( hi, tFar );
+			}
+
+			return static_cast< crimild::UInt32 >( _mm256_movemask_ps( _mm256_cmp_ps( tNear, tFar, _CMP_LE_OQ ) ) );
+		}
+
+#endif
+
+		/**
+		   \brief Dispatches a packet to a kernel
+
+		   Eight-wide packets are tested in two halves by the SSE kernel
+		 */
+		template< crimild::Size N >
+		crimild::UInt32 findSphere( const Sphere3f &sphere, const RayPacket< N > &packet, crimild::Real32 *t, crimild::Real32 lowerBound, Intersection::Kernel kernel )
+		{
+			crimild::UInt32 result = 0;
+
+			switch ( kernel ) {
+#if defined( CRIMILD_SIMD_AVX )
+				case Intersection::Kernel::AVX:
+					if ( N == 8 ) {
+						result = findSphereAVX( sphere, packet.getOriginX(), packet.getOriginY(), packet.getOriginZ(), packet.getDirectionX(), packet.getDirectionY(), packet.getDirectionZ(), t, lowerBound );
+						break;
+					}
+					// four-wide packets are tested using SSE
+#endif
+
+#if defined( CRIMILD_SIMD_SSE )
+				case Intersection::Kernel::SSE:
+					for ( crimild::Size i = 0; i < N; i += 4 ) {
+						result |= findSphereSSE( sphere, packet.getOriginX() + i, packet.getOriginY() + i, packet.getOriginZ() + i, packet.getDirectionX() + i, packet.getDirectionY() + i, packet.getDirectionZ() + i, t + i, lowerBound ) << i;
+					}
+					break;
+#endif
+
+				case Intersection::Kernel::SCALAR:
+					result = findSphereScalar( sphere, packet.getOriginX(), packet.getOriginY(), packet.getOriginZ(), packet.getDirectionX(), packet.getDirectionY(), packet.getDirectionZ(), t, lowerBound, N );
+					break;
+
+				default:
+					// not supported by this build
+					return findSphere( sphere, packet, t, lowerBound, Intersection::getDefaultKernel() );
+			}
+
+			return result & packet.getActiveMask();
+		}
+
+		template< crimild::Size N >
+		crimild::UInt32 testBox( const Vector3f &min, const Vector3f &max, const RayPacket< N > &packet, const crimild::Real32 *tMax, crimild::Real32 tMin, Intersection::Kernel kernel )
+		{
+			crimild::UInt32 result = 0;
+
+			switch ( kernel ) {
+#if defined( CRIMILD_SIMD_AVX )
+				case Intersection::Kernel::AVX:
+					if ( N == 8 ) {
+						result = testBoxAVX( min, max, packet.getOriginX(), packet.getOriginY(), packet.getOriginZ(), packet.getInverseDirectionX(), packet.getInverseDirectionY(), packet.getInverseDirectionZ(), tMax, tMin );
+						break;
+					}
+#endif
+
+#if defined( CRIMILD_SIMD_SSE )
+				case Intersection::Kernel::SSE:
+					for ( crimild::Size i = 0; i < N; i += 4 ) {
+						result |= testBoxSSE( min, max, packet.getOriginX() + i, packet.getOriginY() + i, packet.getOriginZ() + i, packet.getInverseDirectionX() + i, packet.getInverseDirectionY() + i, packet.getInverseDirectionZ() + i, tMax + i, tMin ) << i;
+					}
+					break;
+#endif
+
+				case Intersection::Kernel::SCALAR:
+					result = testBoxScalar( min, max, packet.getOriginX(), packet.getOriginY(), packet.getOriginZ(), packet.getInverseDirectionX(), packet.getInverseDirectionY(), packet.getInverseDirectionZ(), tMax, tMin, N );
+					break;
+
+				default:
+					// not supported by this build
+					return testBox( min, max, packet, tMax, tMin, Intersection::getDefaultKernel() );
+			}
+
+			return result & packet.getActiveMask();
+		}
+
+	}
+
+}
+
+Intersection::Kernel Intersection::getDefaultKernel( void )
+{
+#if defined( CRIMILD_SIMD_AVX )
+	return Kernel::AVX;
+#elif defined( CRIMILD_SIMD_SSE )
+	return Kernel::SSE;
+#else
+	return Kernel::SCALAR;
+#endif
+}
+
+const char *Intersection::getKernelName( Kernel kernel )
+{
+	switch ( kernel ) {
+		case Kernel::AVX:
+			return "AVX";
+		case Kernel::SSE:
+			return "SSE";
+		default:
+			return "Scalar";
+	}
+}
+
+crimild::UInt32 Intersection::find( const Sphere3f &sphere, const RayPacket4f &packet, crimild::Real32 *t, crimild::Real32 lowerBound, Kernel kernel )
+{
+	return internal::findSphere( sphere, packet, t, lowerBound, kernel );
+}
+
+crimild::UInt32 Intersection::find( const Sphere3f &sphere, const RayPacket8f &packet, crimild::Real32 *t, crimild::Real32 lowerBound, Kernel kernel )
+{
+	return internal::findSphere( sphere, packet, t, lowerBound, kernel );
+}
+
+crimild::UInt32 Intersection::test( const Vector3f &min, const Vector3f &max, const RayPacket4f &packet, const crimild::Real32 *tMax, crimild::Real32 tMin, Kernel kernel )
+{
+	return internal::testBox( min, max, packet, tMax, tMin, kernel );
+}
+
+crimild::UInt32 Intersection::test( const Vector3f &min, const Vector3f &max, const RayPacket8f &packet, const crimild::Real32 *tMax, crimild::Real32 tMin, Kernel kernel )
+{
+	return internal::testBox( min, max, packet, tMax, tMin, kernel );
+}
+
@@ -35,11 +35,61 @@
 #include "Root.hpp"
 #include "Vector.hpp"
 #include "LineSegment.hpp"
+#include "RayPacket.hpp"
 
 namespace crimild {
 
 	class Intersection {
 	public:
+		/**
+			\name Ray packets
+
+			Packets are tested four (SSE) or eight (AVX) rays at a time, 
+			depending on the instruction sets available at compile time
+			(see Simd.hpp). Eight-wide packets are split in two halves if
+			AVX is not available. All kernels perform the exact same 
+			floating point operations, so results do not depend on the
+			kernel being used.
+		 */
+		//@{
+
+		enum class Kernel {
+			SCALAR,
+			SSE,
+			AVX,
+		};
+
+		/**
+			\brief The widest kernel supported by this build
+		 */
+		static Kernel getDefaultKernel( void );
+
+		static const char *getKernelName( Kernel kernel );
+
+		/**
+			\brief Find the intersections between a sphere and a packet of rays
+
+			\param t One value per ray. On input, the upper bound for each ray.
+			Updated with the intersection time for every ray hitting the sphere
+			\param kernel Requested kernel. If not supported, the default one is used instead
+			\returns A mask with one bit set for every active ray hitting the sphere in the range ( lowerBound, t )
+		 */
+		static crimild::UInt32 find( const Sphere3f &sphere, const RayPacket4f &packet, crimild::Real32 *t, crimild::Real32 lowerBound = Numericf::ZERO_TOLERANCE, Kernel kernel = getDefaultKernel() );
+		static crimild::UInt32 find( const Sphere3f &sphere, const RayPacket8f &packet, crimild::Real32 *t, crimild::Real32 lowerBound = Numericf::ZERO_TOLERANCE, Kernel kernel = getDefaultKernel() );
+
+		/**
+			\brief Test for intersection between an axis-aligned box and a packet of rays
+
+			Uses the slab method with the packet's inverse directions
+
+			\param tMax One value per ray with the farthest distance to test
+			\returns A mask with one bit set for every active ray overlapping the box in the range [ tMin, tMax ]
+		 */
+		static crimild::UInt32 test( const Vector3f &min, const Vector3f &max, const RayPacket4f &packet, const crimild::Real32 *tMax, crimild::Real32 tMin = 0.0f, Kernel kernel = getDefaultKernel() );
+		static crimild::UInt32 test( const Vector3f &min, const Vector3f &max, const RayPacket8f &packet, const crimild::Real32 *tMax, crimild::Real32 tMin = 0.0f, Kernel kernel = getDefaultKernel() );
+
+		//@}
+
 		/**
 			\brief Test for intersection between a sphere and a ray
 		 */
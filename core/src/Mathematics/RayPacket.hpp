@@ -0,0 +1,151 @@
+/*
+ * Copyright (c) 2013, Hernan Saez
+ * All rights reserved.
+ * 
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *     * Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in the
+ *       documentation and/or other materials provided with the distribution.
+ *     * Neither the name of the <organization> nor the
+ *       names of its contributors may be used to endorse or promote products
+ *       derived from this software without specific prior written permission.
+ * 
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL <COPYRIGHT HOLDER> BE LIABLE FOR ANY
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef CRIMILD_MATHEMATICS_RAY_PACKET_
+#define CRIMILD_MATHEMATICS_RAY_PACKET_
+
+#include "Ray.hpp"
+#include "Vector.hpp"
+
+#include "Foundation/Types.hpp"
+
+namespace crimild {
+
+	/**
+	   \brief A fixed-size group of rays stored as a structure of arrays
+
+	   Packets are meant for coherent rays (i.e. primary rays for nearby 
+	   pixels) that are tested against the same primitives, so several 
+	   rays can be loaded into SIMD registers at once (see Intersection). 
+	   Inverse directions are precomputed for slab tests.
+
+	   Only rays in the active mask are tested. Inactive lanes keep
+	   a zero direction, so they never hit anything.
+	 */
+	template< crimild::Size N >
+	class RayPacket {
+	public:
+		static const crimild::Size SIZE = N;
+		static const crimild::UInt32 FULL_MASK = ( 1u << N ) - 1;
+
+	public:
+		RayPacket( void )
+		{
+			clear();
+		}
+
+		void clear( void )
+		{
+			for ( crimild::Size i = 0; i < N; i++ ) {
+				_originX[ i ] = _originY[ i ] = _originZ[ i ] = 0.0f;
+				_directionX[ i ] = _directionY[ i ] = _directionZ[ i ] = 0.0f;
+				_invDirectionX[ i ] = _invDirectionY[ i ] = _invDirectionZ[ i ] = 0.0f;
+			}
+			_activeMask = 0;
+		}
+
+		/**
+		   \brief Sets a ray and marks it as active
+		 */
+		void set( crimild::Size index, const Ray3f &ray )
+		{
+			const auto &o = ray.getOrigin();
+			const auto &d = ray.getDirection();
+
+			_originX[ index ] = o[ 0 ];
+			_originY[ index ] = o[ 1 ];
+			_originZ[ index ] = o[ 2 ];
+			_directionX[ index ] = d[ 0 ];
+			_directionY[ index ] = d[ 1 ];
+			_directionZ[ index ] = d[ 2 ];
+			_invDirectionX[ index ] = 1.0f / d[ 0 ];
+			_invDirectionY[ index ] = 1.0f / d[ 1 ];
+			_invDirectionZ[ index ] = 1.0f / d[ 2 ];
+
+			_activeMask |= ( 1u << index );
+		}
+
+		Ray3f getRay( crimild::Size index ) const
+		{
+			return Ray3f(
+				Vector3f( _originX[ index ], _originY[ index ], _originZ[ index ] ),
+				Vector3f( _directionX[ index ], _directionY[ index ], _directionZ[ index ] ) );
+		}
+
+		crimild::UInt32 getActiveMask( void ) const { return _activeMask; }
+		bool isActive( crimild::Size index ) const { return ( _activeMask & ( 1u << index ) ) != 0; }
+
+		/**
+		   \brief Checks if all active rays point to the same octant
+
+		   Rays that are not coherent will most likely visit different
+		   parts of a scene, so they should be traced individually.
+		 */
+		bool isCoherent( void ) const
+		{
+			crimild::UInt32 positive = 0;
+			crimild::UInt32 negative = 0;
+			for ( crimild::Size i = 0; i < N; i++ ) {
+				if ( isActive( i ) ) {
+					auto octant = ( _directionX[ i ] < 0.0f ? 1u : 0u ) | ( _directionY[ i ] < 0.0f ? 2u : 0u ) | ( _directionZ[ i ] < 0.0f ? 4u : 0u );
+					positive |= ~octant & 7u;
+					negative |= octant;
+				}
+			}
+			return ( positive & negative ) == 0;
+		}
+
+		const crimild::Real32 *getOriginX( void ) const { return _originX; }
+		const crimild::Real32 *getOriginY( void ) const { return _originY; }
+		const crimild::Real32 *getOriginZ( void ) const { return _originZ; }
+		const crimild::Real32 *getDirectionX( void ) const { return _directionX; }
+		const crimild::Real32 *getDirectionY( void ) const { return _directionY; }
+		const crimild::Real32 *getDirectionZ( void ) const { return _directionZ; }
+		const crimild::Real32 *getInverseDirectionX( void ) const { return _invDirectionX; }
+		const crimild::Real32 *getInverseDirectionY( void ) const { return _invDirectionY; }
+		const crimild::Real32 *getInverseDirectionZ( void ) const { return _invDirectionZ; }
+
+	private:
+		crimild::Real32 _originX[ N ];
+		crimild::Real32 _originY[ N ];
+		crimild::Real32 _originZ[ N ];
+		crimild::Real32 _directionX[ N ];
+		crimild::Real32 _directionY[ N ];
+		crimild::Real32 _directionZ[ N ];
+		crimild::Real32 _invDirectionX[ N ];
+		crimild::Real32 _invDirectionY[ N ];
+		crimild::Real32 _invDirectionZ[ N ];
+		crimild::UInt32 _activeMask;
+	};
+
+	typedef RayPacket< 4 > RayPacket4f;
+	typedef RayPacket< 8 > RayPacket8f;
+
+}
+
+#endif
+
@@ -0,0 +1,57 @@
+/*
+ * Copyright (c) 2013, Hernan Saez
+ * All rights reserved.
+ * 
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *     * Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in the
+ *       documentation and/or other materials provided with the distribution.
+ *     * Neither the name of the <organization> nor the
+ *       names of its contributors may be used to endorse or promote products
+ *       derived from this software without specific prior written permission.
+ * 
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL <COPYRIGHT HOLDER> BE LIABLE FOR ANY
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef CRIMILD_MATHEMATICS_SIMD_
+#define CRIMILD_MATHEMATICS_SIMD_
+
+/**
+   \file Simd.hpp
+   \brief Detects which SIMD instruction sets can be used
+
+   SIMD code paths are only enabled if CRIMILD_ENABLE_SIMD is defined
+   and the compiler targets the corresponding instruction set (i.e. 
+   AVX requires building with -mavx or /arch:AVX). Every SIMD kernel 
+   must provide a scalar fallback producing the same results.
+ */
+
+#if defined( CRIMILD_ENABLE_SIMD )
+	#if defined( __AVX__ )
+		#define CRIMILD_SIMD_AVX 1
+	#endif
+
+	#if defined( __SSE2__ ) || defined( _M_X64 ) || ( defined( _M_IX86_FP ) && _M_IX86_FP >= 2 )
+		#define CRIMILD_SIMD_SSE 1
+	#endif
+#endif
+
+#if defined( CRIMILD_SIMD_AVX )
+	#include <immintrin.h>
+#elif defined( CRIMILD_SIMD_SSE )
+	#include <emmintrin.h>
+#endif
+
+#endif
@@ -28,6 +28,7 @@
 #include "BoxPositionParticleGenerator.hpp"
 
 #include "Mathematics/Random.hpp"
+#include "ParticleSystem/ParticleKernels.hpp"
 #include "Coding/Encoder.hpp"
 #include "Coding/Decoder.hpp"
 #include "SceneGraph/Node.hpp"
@@ -63,15 +64,12 @@ void BoxPositionParticleGenerator::generate( Node *node, crimild::Real64 dt, Par
         auto x = Random::generate< Real32 >( posMin.x(), posMax.x() );
         auto y = Random::generate< Real32 >( posMin.y(), posMax.y() );
         auto z = Random::generate< Real32 >( posMin.z(), posMax.z() );
-		if ( particles->shouldComputeInWorldSpace() ) {
-			auto p = Vector3f( x, y, z );
-			node->getWorld().applyToPoint( p, p );
-			ps[ i ] = p;
-		}
-		else {
-			ps[ i ] = Vector3f( x, y, z );
-		}
+		ps[ i ] = Vector3f( x, y, z );
     }
+
+	if ( particles->shouldComputeInWorldSpace() ) {
+		ParticleKernels::transform( ps + startId, node->getWorld().computeModelMatrix(), endId - startId );
+	}
 }
 
 void BoxPositionParticleGenerator::encode( coding::Encoder &encoder ) 
@@ -28,6 +28,7 @@
 #include "SpherePositionParticleGenerator.hpp"
 
 #include "Mathematics/Random.hpp"
+#include "ParticleSystem/ParticleKernels.hpp"
 #include "Coding/Encoder.hpp"
 #include "Coding/Decoder.hpp"
 
@@ -62,10 +63,11 @@ void SpherePositionParticleGenerator::generate( Node *node, crimild::Real64 dt,
         auto y = Random::generate< Real32 >( posMin.y(), posMax.y() );
         auto z = Random::generate< Real32 >( posMin.z(), posMax.z() );
         ps[ i ] = _origin + Vector3f( x, y, z ).getNormalized().times( _size );
-		if ( particles->shouldComputeInWorldSpace() ) {
-			node->getWorld().applyToPoint( ps[ i ], ps[ i ] );
-		}
     }
+
+	if ( particles->shouldComputeInWorldSpace() ) {
+		ParticleKernels::transform( ps + startId, node->getWorld().computeModelMatrix(), endId - startId );
+	}
 }
 
 void SpherePositionParticleGenerator::encode( coding::Encoder &encoder ) 
@@ -85,6 +85,13 @@ namespace crimild {
 		 */
         virtual void swap( ParticleId a, ParticleId b ) = 0;
 
+		/**
+		   \brief Gathers the first elements in the given order
+
+		   \see ParticleData::permute()
+		 */
+		virtual void permute( const ParticleId *order, crimild::Size count ) = 0;
+
 		/**
 		   \brief Gets the number of elements in the array
 		 */
@@ -185,6 +192,22 @@ namespace crimild {
         	_data[ b ] = temp;
         }
 
+        virtual void permute( const ParticleId *order, crimild::Size count ) override
+        {
+        	if ( _scratch.size() < count ) {
+        		_scratch.resize( count );
+        	}
+
+        	auto data = _data.getData();
+        	auto scratch = _scratch.getData();
+        	for ( crimild::Size i = 0; i < count; i++ ) {
+        		scratch[ i ] = data[ order[ i ] ];
+        	}
+        	for ( crimild::Size i = 0; i < count; i++ ) {
+        		data[ i ] = scratch[ i ];
+        	}
+        }
+
     private:
 		/**
 		   \brief Holds the data for the attributes
@@ -192,6 +215,11 @@ namespace crimild {
 		   \remarks This member is NOT thread safe. 
 		 */
         containers::Array< T > _data;
+
+		/**
+		   \brief Temporary storage used when reordering elements
+		 */
+        containers::Array< T > _scratch;
     };
 
     using Vector3fParticleAttribArray = ParticleAttribArrayImpl< Vector3f >;
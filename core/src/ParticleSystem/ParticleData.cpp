@@ -98,6 +98,16 @@ void ParticleData::swap( ParticleId a, ParticleId b )
     }
 }
 
+void ParticleData::permute( const ParticleId *order, crimild::Size count )
+{
+	assert( count <= _aliveCount );
+
+	// alive flags don't change, since all particles in range are alive
+	_attribs.each( [ order, count ]( const ParticleAttribType &type, ParticleAttribArrayPtr &attr ) {
+		attr->permute( order, count );
+	});
+}
+
 void ParticleData::encode( coding::Encoder &encoder )
 {
 	Codable::encode( encoder );
@@ -116,6 +116,18 @@ namespace crimild {
 		 */
         void swap( ParticleId a, ParticleId b );
 
+		/**
+		   \brief Reorders the first particles
+
+		   After this call, particle i holds the attributes that particle
+		   order[ i ] had before. Used to apply a sorted order to all
+		   attributes at once, instead of swapping particles one at a time.
+
+		   \param order A permutation of [ 0, count )
+		   \param count Must not be greater than the alive count
+		 */
+		void permute( const ParticleId *order, crimild::Size count );
+
 		inline void setComputeInWorldSpace( crimild::Bool value ) { _computeInWorldSpace = value; }
 		inline crimild::Bool shouldComputeInWorldSpace( void ) const { return _computeInWorldSpace; }
 
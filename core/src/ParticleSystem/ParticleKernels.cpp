@@ -0,0 +1,693 @@
+/*
+ * Copyright (c) 2013, Hernan Saez
+ * All rights reserved.
+ * 
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *     * Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in the
+ *       documentation and/or other materials provided with the distribution.
+ *     * Neither the name of the <organization> nor the
+ *       names of its contributors may be used to endorse or promote products
+ *       derived from this software without specific prior written permission.
+ * 
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL <COPYRIGHT HOLDER> BE LIABLE FOR ANY
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "ParticleKernels.hpp"
+
+#include "Mathematics/Simd.hpp"
+
+#include <cmath>
+#include <limits>
+
+using namespace crimild;
+
+static_assert( sizeof( Vector3f ) == 3 * sizeof( crimild::Real32 ), "Vector3f must be tightly packed" );
+static_assert( sizeof( RGBAColorf ) == 4 * sizeof( crimild::Real32 ), "RGBAColorf must be tightly packed" );
+
+namespace crimild {
+
+	namespace internal {
+
+		/*
+		   Scalar loops below define the order of all floating point operations. 
+		   SIMD kernels must follow the exact same order, or results will differ
+		   between kernels (that also means multiplications and additions must
+		   not be contracted into FMA instructions).
+		 */
+
+		void addParticlesScalar( crimild::Real32 *values, const Vector3f &delta, crimild::Size begin, crimild::Size count )
+		{
+			for ( crimild::Size i = 3 * begin; i < 3 * count; i += 3 ) {
+				values[ i + 0 ] += delta[ 0 ];
+				values[ i + 1 ] += delta[ 1 ];
+				values[ i + 2 ] += delta[ 2 ];
+			}
+		}
+
+		void addScaledParticlesScalar( crimild::Real32 *values, const crimild::Real32 *deltas, crimild::Real32 scale, crimild::Size begin, crimild::Size count )
+		{
+			for ( crimild::Size i = 3 * begin; i < 3 * count; i++ ) {
+				values[ i ] += scale * deltas[ i ];
+			}
+		}
+
+		void subtractParticlesScalar( crimild::Real32 *values, crimild::Real32 delta, crimild::Size begin, crimild::Size count )
+		{
+			for ( crimild::Size i = begin; i < count; i++ ) {
+				values[ i ] -= delta;
+			}
+		}
+
+		void clampParticlesHeightScalar( crimild::Real32 *positions, crimild::Real32 height, crimild::Size begin, crimild::Size count )
+		{
+			for ( crimild::Size i = begin; i < count; i++ ) {
+				if ( positions[ 3 * i + 1 ] < height ) {
+					positions[ 3 * i + 1 ] = height;
+				}
+			}
+		}
+
+		void attractParticlesScalar( const crimild::Real32 *positions, crimild::Real32 *accelerations, const Vector3f &center, crimild::Real32 radius, crimild::Real32 strength, crimild::Size begin, crimild::Size count )
+		{
+			for ( crimild::Size i = begin; i < count; i++ ) {
+				const auto p = positions + 3 * i;
+				const auto dx = center[ 0 ] - p[ 0 ];
+				const auto dy = center[ 1 ] - p[ 1 ];
+				const auto dz = center[ 2 ] - p[ 2 ];
+				const auto d = std::sqrt( dx * dx + dy * dy + dz * dz );
+				if ( d > 0.0f && d <= radius ) {
+					const auto f = ( strength * ( 1.0f - d / radius ) ) / d;
+					auto a = accelerations + 3 * i;
+					a[ 0 ] += f * dx;
+					a[ 1 ] += f * dy;
+					a[ 2 ] += f * dz;
+				}
+			}
+		}
+
+		void interpolateParticlesScalar( const crimild::Real32 *from, const crimild::Real32 *to, const crimild::Real32 *times, const crimild::Real32 *lifetimes, crimild::Real32 *result, crimild::Size begin, crimild::Size count )
+		{
+			for ( crimild::Size i = begin; i < count; i++ ) {
+				const auto t = 1.0f - times[ i ] / lifetimes[ i ];
+				for ( crimild::Size j = 4 * i; j < 4 * i + 4; j++ ) {
+					result[ j ] = from[ j ] + t * ( to[ j ] - from[ j ] );
+				}
+			}
+		}
+
+		void transformParticlesScalar( crimild::Real32 *points, const crimild::Real32 *m, crimild::Size begin, crimild::Size count )
+		{
+			for ( crimild::Size i = begin; i < count; i++ ) {
+				auto p = points + 3 * i;
+				const auto x = p[ 0 ];
+				const auto y = p[ 1 ];
+				const auto z = p[ 2 ];
+				p[ 0 ] = m[ 0 ] * x + m[ 4 ] * y + m[ 8 ] * z + m[ 12 ];
+				p[ 1 ] = m[ 1 ] * x + m[ 5 ] * y + m[ 9 ] * z + m[ 13 ];
+				p[ 2 ] = m[ 2 ] * x + m[ 6 ] * y + m[ 10 ] * z + m[ 14 ];
+			}
+		}
+
+#if defined( CRIMILD_SIMD_SSE )
+
+		/**
+		   \brief Repeats ( a, b, c ) over the 12 floats of four packed particles
+		 */
+		inline void patternSSE( crimild::Real32 a, crimild::Real32 b, crimild::Real32 c, __m128 &p0, __m128 &p1, __m128 &p2 )
+		{
+			p0 = _mm_setr_ps( a, b, c, a );
+			p1 = _mm_setr_ps( b, c, a, b );
+			p2 = _mm_setr_ps( c, a, b, c );
+		}
+
+		/**
+		   \brief Loads four packed particles as x, y and z lanes
+		 */
+		inline void loadParticlesSSE( const crimild::Real32 *data, __m128 &x, __m128 &y, __m128 &z )
+		{
+			// r0 = ( x0, y0, z0, x1 ), r1 = ( y1, z1, x2, y2 ), r2 = ( z2, x3, y3, z3 )
+			const auto r0 = _mm_loadu_ps( data );
+			const auto r1 = _mm_loadu_ps( data + 4 );
+			const auto r2 = _mm_loadu_ps( data + 8 );
+
+			const auto x23 = _mm_shuffle_ps( r1, r2, _MM_SHUFFLE( 1, 1, 2, 2 ) );
+			x = _mm_shuffle_ps( r0, x23, _MM_SHUFFLE( 2, 0, 3, 0 ) );
+
+			const auto y01 = _mm_shuffle_ps( r0, r1, _MM_SHUFFLE( 0, 0, 1, 1 ) );
+			const auto y23 = _mm_shuffle_ps( r1, r2, _MM_SHUFFLE( 2, 2, 3, 3 ) );
+			y = _mm_shuffle_ps( y01, y23, _MM_SHUFFLE( 2, 0, 2, 0 ) );
+
+			const auto z01 = _mm_shuffle_ps( r0, r1, _MM_SHUFFLE( 1, 1, 2, 2 ) );
+			const auto z23 = _mm_shuffle_ps( r2, r2, _MM_SHUFFLE( 3, 3, 0, 0 ) );
+			z = _mm_shuffle_ps( z01, z23, _MM_SHUFFLE( 2, 0, 2, 0 ) );
+		}
+
+		/**
+		   \brief Stores x, y and z lanes as four packed particles
+		 */
+		inline void storeParticlesSSE( crimild::Real32 *data, __m128 x, __m128 y, __m128 z )
+		{
+			const auto x0y0 = _mm_shuffle_ps( x, y, _MM_SHUFFLE( 0, 0, 0, 0 ) );
+			const auto z0x1 = _mm_shuffle_ps( z, x, _MM_SHUFFLE( 1, 1, 0, 0 ) );
+			const auto y1z1 = _mm_shuffle_ps( y, z, _MM_SHUFFLE( 1, 1, 1, 1 ) );
+			const auto x2y2 = _mm_shuffle_ps( x, y, _MM_SHUFFLE( 2, 2, 2, 2 ) );
+			const auto z2x3 = _mm_shuffle_ps( z, x, _MM_SHUFFLE( 3, 3, 2, 2 ) );
+			const auto y3z3 = _mm_shuffle_ps( y, z, _MM_SHUFFLE( 3, 3, 3, 3 ) );
+
+			_mm_storeu_ps( data, _mm_shuffle_ps( x0y0, z0x1, _MM_SHUFFLE( 2, 0, 2, 0 ) ) );
+			_mm_storeu_ps( data + 4, _mm_shuffle_ps( y1z1, x2y2, _MM_SHUFFLE( 2, 0, 2, 0 ) ) );
+			_mm_storeu_ps( data + 8, _mm_shuffle_ps( z2x3, y3z3, _MM_SHUFFLE( 2, 0, 2, 0 ) ) );
+		}
+
+		inline __m128 selectSSE( __m128 mask, __m128 a, __m128 b )
+		{
+			return _mm_or_ps( _mm_and_ps( mask, a ), _mm_andnot_ps( mask, b ) );
+		}
+
+		crimild::Size addParticlesSSE( crimild::Real32 *values, const Vector3f &delta, crimild::Size count )
+		{
+			__m128 d0, d1, d2;
+			patternSSE( delta[ 0 ], delta[ 1 ], delta[ 2 ], d0, d1, d2 );
+
+			crimild::Size i = 0;
+			for ( ; i + 4 <= count; i += 4 ) {
+				auto v = values + 3 * i;
+				_mm_storeu_ps( v, _mm_add_ps( _mm_loadu_ps( v ), d0 ) );
+				_mm_storeu_ps( v + 4, _mm_add_ps( _mm_loadu_ps( v + 4 ), d1 ) );
+				_mm_storeu_ps( v + 8, _mm_add_ps( _mm_loadu_ps( v + 8 ), d2 ) );
+			}
+
+			return i;
+		}
+
+		crimild::Size addScaledParticlesSSE( crimild::Real32 *values, const crimild::Real32 *deltas, crimild::Real32 scale, crimild::Size count )
+		{
+			const auto s = _mm_set1_ps( scale );
+
+			crimild::Size i = 0;
+			for ( ; i + 4 <= count; i += 4 ) {
+				auto v = values + 3 * i;
+				auto d = deltas + 3 * i;
+				_mm_storeu_ps( v, _mm_add_ps( _mm_loadu_ps( v ), _mm_mul_ps( s, _mm_loadu_ps( d ) ) ) );
+				_mm_storeu_ps( v + 4, _mm_add_ps( _mm_loadu_ps( v + 4 ), _mm_mul_ps( s, _mm_loadu_ps( d + 4 ) ) ) );
+				_mm_storeu_ps( v + 8, _mm_add_ps( _mm_loadu_ps( v + 8 ), _mm_mul_ps( s, _mm_loadu_ps( d + 8 ) ) ) );
+			}
+
+			return i;
+		}
+
+		crimild::Size subtractParticlesSSE( crimild::Real32 *values, crimild::Real32 delta, crimild::Size count )
+		{
+			const auto d = _mm_set1_ps( delta );
+
+			crimild::Size i = 0;
+			for ( ; i + 4 <= count; i += 4 ) {
+				_mm_storeu_ps( values + i, _mm_sub_ps( _mm_loadu_ps( values + i ), d ) );
+			}
+
+			return i;
+		}
+
+		crimild::Size clampParticlesHeightSSE( crimild::Real32 *positions, crimild::Real32 height, crimild::Size count )
+		{
+			// x and z are compared against -inf, so they're never modified.
+			// max() returns its second operand if any of them is NaN, matching
+			// the scalar comparison
+			const auto lowest = -std::numeric_limits< crimild::Real32 >::infinity();
+			__m128 b0, b1, b2;
+			patternSSE( lowest, height, lowest, b0, b1, b2 );
+
+			crimild::Size i = 0;
+			for ( ; i + 4 <= count; i += 4 ) {
+				auto p = positions + 3 * i;
+				_mm_storeu_ps( p, _mm_max_ps( b0, _mm_loadu_ps( p ) ) );
+				_mm_storeu_ps( p + 4, _mm_max_ps( b1, _mm_loadu_ps( p + 4 ) ) );
+				_mm_storeu_ps( p + 8, _mm_max_ps( b2, _mm_loadu_ps( p + 8 ) ) );
+			}
+
+			return i;
+		}
+
+		crimild::Size attractParticlesSSE( const crimild::Real32 *positions, crimild::Real32 *accelerations, const Vector3f &center, crimild::Real32 radius, crimild::Real32 strength, crimild::Size count )
+		{
+			const auto cx = _mm_set1_ps( center[ 0 ] );
+			const auto cy = _mm_set1_ps( center[ 1 ] );
+			const auto cz = _mm_set1_ps( center[ 2 ] );
+			const auto r = _mm_set1_ps( radius );
+			const auto s = _mm_set1_ps( strength );
+			const auto zero = _mm_setzero_ps();
+			const auto one = _mm_set1_ps( 1.0f );
+
+			crimild::Size i = 0;
+			for ( ; i + 4 <= count; i += 4 ) {
+				__m128 px, py, pz;
+				loadParticlesSSE( positions + 3 * i, px, py, pz );
+
+				const auto dx = _mm_sub_ps( cx, px );
+				const auto dy = _mm_sub_ps( cy, py );
+				const auto dz = _mm_sub_ps( cz, pz );
+				const auto d = _mm_sqrt_ps( _mm_add_ps( _mm_add_ps( _mm_mul_ps( dx, dx ), _mm_mul_ps( dy, dy ) ), _mm_mul_ps( dz, dz ) ) );
+
+				const auto inside = _mm_and_ps( _mm_cmpgt_ps( d, zero ), _mm_cmple_ps( d, r ) );
+				if ( _mm_movemask_ps( inside ) == 0 ) {
+					continue;
+				}
+
+				const auto f = _mm_div_ps( _mm_mul_ps( s, _mm_sub_ps( one, _mm_div_ps( d, r ) ) ), d );
+
+				__m128 ax, ay, az;
+				loadParticlesSSE( accelerations + 3 * i, ax, ay, az );
+				ax = selectSSE( inside, _mm_add_ps( ax, _mm_mul_ps( f, dx ) ), ax );
+				ay = selectSSE( inside, _mm_add_ps( ay, _mm_mul_ps( f, dy ) ), ay );
+				az = selectSSE( inside, _mm_add_ps( az, _mm_mul_ps( f, dz ) ), az );
+				storeParticlesSSE( accelerations + 3 * i, ax, ay, az );
+			}
+
+			return i;
+		}
+
+		inline void interpolateColorSSE( const crimild::Real32 *from, const crimild::Real32 *to, __m128 t, crimild::Real32 *result )
+		{
+			const auto a = _mm_loadu_ps( from );
+			const auto b = _mm_loadu_ps( to );
+			_mm_storeu_ps( result, _mm_add_ps( a, _mm_mul_ps( t, _mm_sub_ps( b, a ) ) ) );
+		}
+
+		crimild::Size interpolateParticlesSSE( const crimild::Real32 *from, const crimild::Real32 *to, const crimild::Real32 *times, const crimild::Real32 *lifetimes, crimild::Real32 *result, crimild::Size count )
+		{
+			const auto one = _mm_set1_ps( 1.0f );
+
+			crimild::Size i = 0;
+			for ( ; i + 4 <= count; i += 4 ) {
+				const auto t = _mm_sub_ps( one, _mm_div_ps( _mm_loadu_ps( times + i ), _mm_loadu_ps( lifetimes + i ) ) );
+				const auto j = 4 * i;
+				interpolateColorSSE( from + j, to + j, _mm_shuffle_ps( t, t, _MM_SHUFFLE( 0, 0, 0, 0 ) ), result + j );
+				interpolateColorSSE( from + j + 4, to + j + 4, _mm_shuffle_ps( t, t, _MM_SHUFFLE( 1, 1, 1, 1 ) ), result + j + 4 );
+				interpolateColorSSE( from + j + 8, to + j + 8, _mm_shuffle_ps( t, t, _MM_SHUFFLE( 2, 2, 2, 2 ) ), result + j + 8 );
+				interpolateColorSSE( from + j + 12, to + j + 12, _mm_shuffle_ps( t, t, _MM_SHUFFLE( 3, 3, 3, 3 ) ), result + j + 12 );
+			}
+
+			return i;
+		}
+
+		inline __m128 transformLaneSSE( const crimild::Real32 *m, crimild::Size row, __m128 x, __m128 y, __m128 z )
+		{
+			const auto mx = _mm_set1_ps( m[ row ] );
+			const auto my = _mm_set1_ps( m[ row + 4 ] );
+			const auto mz = _mm_set1_ps( m[ row + 8 ] );
+			const auto mw = _mm_set1_ps( m[ row + 12 ] );
+			return _mm_add_ps( _mm_add_ps( _mm_add_ps( _mm_mul_ps( mx, x ), _mm_mul_ps( my, y ) ), _mm_mul_ps( mz, z ) ), mw );
+		}
+
+		crimild::Size transformParticlesSSE( crimild::Real32 *points, const crimild::Real32 *m, crimild::Size count )
+		{
+			crimild::Size i = 0;
+			for ( ; i + 4 <= count; i += 4 ) {
+				__m128 x, y, z;
+				loadParticlesSSE( points + 3 * i, x, y, z );
+				storeParticlesSSE( 
+					points + 3 * i, 
+					transformLaneSSE( m, 0, x, y, z ), 
+					transformLaneSSE( m, 1, x, y, z ), 
+					transformLaneSSE( m, 2, x, y, z ) );
+			}
+
+			return i;
+		}
+
+#endif
+
+#if defined( CRIMILD_SIMD_AVX )
+
+		/*
+		   Transposing packed particles requires shuffling values across
+		   128-bit lanes, which is expensive with AVX. Kernels working with
+		   x, y and z lanes (attract and transform) use SSE registers even
+		   when the AVX kernel is requested.
+		 */
+
+		/**
+		   \brief Repeats ( a, b, c ) over the 24 floats of eight packed particles
+		 */
+		inline void patternAVX( crimild::Real32 a, crimild::Real32 b, crimild::Real32 c, __m256 &p0, __m256 &p1, __m256 &p2 )
+		{
+			p0 = _mm256_setr_ps( a, b, c, a, b, c, a, b );
+			p1 = _mm256_setr_ps( c, a, b, c, a, b, c, a );
+			p2 = _mm256_setr_ps( b, c, a, b, c, a, b, c );
+		}
+
+		crimild::Size addParticlesAVX( crimild::Real32 *values, const Vector3f &delta, crimild::Size count )
+		{
+			__m256 d0, d1, d2;
+			patternAVX( delta[ 0 ], delta[ 1 ], delta[ 2 ], d0, d1, d2 );
+
+			crimild::Size i = 0;
+			for ( ; i + 8 <= count; i += 8 ) {
+				auto v = values + 3 * i;
+				_mm256_storeu_ps( v, _mm256_add_ps( _mm256_loadu_ps( v ), d0 ) );
+				_mm256_storeu_ps( v + 8, _mm256_add_ps( _mm256_loadu_ps( v + 8 ), d1 ) );
+				_mm256_storeu_ps( v + 16, _mm256_add_ps( _mm256_loadu_ps( v + 16 ), d2 ) );
+			}
+
+			return i;
+		}
+
+		crimild::Size addScaledParticlesAVX( crimild::Real32 *values, const crimild::Real32 *deltas, crimild::Real32 scale, crimild::Size count )
+		{
+			const auto s = _mm256_set1_ps( scale );
+
+			crimild::Size i = 0;
+			for ( ; i + 8 <= count; i += 8 ) {
+				auto v = values + 3 * i;
+				auto d = deltas + 3 * i;
+				_mm256_storeu_ps( v, _mm256_add_ps( _mm256_loadu_ps( v ), _mm256_mul_ps( s, _mm256_loadu_ps( d ) ) ) );
+				_mm256_storeu_ps( v + 8, _mm256_add_ps( _mm256_loadu_ps( v + 8 ), _mm256_mul_ps( s, _mm256_loadu_ps( d + 8 ) ) ) );
+				_mm256_storeu_ps( v + 16, _mm256_add_ps( _mm256_loadu_ps( v + 16 ), _mm256_mul_ps( s, _mm256_loadu_ps( d + 16 ) ) ) );
+			}
+
+			return i;
+		}
+
+		crimild::Size subtractParticlesAVX( crimild::Real32 *values, crimild::Real32 delta, crimild::Size count )
+		{
+			const auto d = _mm256_set1_ps( delta );
+
+			crimild::Size i = 0;
+			for ( ; i + 8 <= count; i += 8 ) {
+				_mm256_storeu_ps( values + i, _mm256_sub_ps( _mm256_loadu_ps( values + i ), d ) );
+			}
+
+			return i;
+		}
+
+		crimild::Size clampParticlesHeightAVX( crimild::Real32 *positions, crimild::Real32 height, crimild::Size count )
+		{
+			const auto lowest = -std::numeric_limits< crimild::Real32 >::infinity();
+			__m256 b0, b1, b2;
+			patternAVX( lowest, height, lowest, b0, b1, b2 );
+
+			crimild::Size i = 0;
+			for ( ; i + 8 <= count; i += 8 ) {
+				auto p = positions + 3 * i;
+				_mm256_storeu_ps( p, _mm256_max_ps( b0, _mm256_loadu_ps( p ) ) );
+				_mm256_storeu_ps( p + 8, _mm256_max_ps( b1, _mm256_loadu_ps( p + 8 ) ) );
+				_mm256_storeu_ps( p + 16, _mm256_max_ps( b2, _mm256_loadu_ps( p + 16 ) ) );
+			}
+
+			return i;
+		}
+
+		inline void interpolateColorsAVX( const crimild::Real32 *from, const crimild::Real32 *to, __m256 t, crimild::Real32 *result )
+		{
+			const auto a = _mm256_loadu_ps( from );
+			const auto b = _mm256_loadu_ps( to );
+			_mm256_storeu_ps( result, _mm256_add_ps( a, _mm256_mul_ps( t, _mm256_sub_ps( b, a ) ) ) );
+		}
+
+		crimild::Size interpolateParticlesAVX( const crimild::Real32 *from, const crimild::Real32 *to, const crimild::Real32 *times, const crimild::Real32 *lifetimes, crimild::Real32 *result, crimild::Size count )
+		{
+			const auto one = _mm256_set1_ps( 1.0f );
+
+			// each register holds two colors, so every t is broadcasted to half of it
+			const auto evenPairs = _mm256_setr_epi32( 0, 0, 0, 0, 1, 1, 1, 1 );
+			const auto oddPairs = _mm256_setr_epi32( 2, 2, 2, 2, 3, 3, 3, 3 );
+
+			crimild::Size i = 0;
+			for ( ; i + 8 <= count; i += 8 ) {
+				const auto t = _mm256_sub_ps( one, _mm256_div_ps( _mm256_loadu_ps( times + i ), _mm256_loadu_ps( lifetimes + i ) ) );
+				const auto t0123 = _mm256_permute2f128_ps( t, t, 0x00 );
+				const auto t4567 = _mm256_permute2f128_ps( t, t, 0x11 );
+
+				const auto j = 4 * i;
+				interpolateColorsAVX( from + j, to + j, _mm256_permutevar_ps( t0123, evenPairs ), result + j );
+				interpolateColorsAVX( from + j + 8, to + j + 8, _mm256_permutevar_ps( t0123, oddPairs ), result + j + 8 );
+				interpolateColorsAVX( from + j + 16, to + j + 16, _mm256_permutevar_ps( t4567, evenPairs ), result + j + 16 );
+				interpolateColorsAVX( from + j + 24, to + j + 24, _mm256_permutevar_ps( t4567, oddPairs ), result + j + 24 );
+			}
+
+			return i;
+		}
+
+#endif
+
+	}
+
+}
+
+ParticleKernels::Kernel ParticleKernels::getDefaultKernel( void )
+{
+#if defined( CRIMILD_SIMD_AVX )
+	return Kernel::AVX;
+#elif defined( CRIMILD_SIMD_SSE )
+	return Kernel::SSE;
+#else
+	return Kernel::SCALAR;
+#endif
+}
+
+const char *ParticleKernels::getKernelName( Kernel kernel )
+{
+	switch ( kernel ) {
+		case Kernel::AVX:
+			return "AVX";
+		case Kernel::SSE:
+			return "SSE";
+		default:
+			return "Scalar";
+	}
+}
+
+void ParticleKernels::add( Vector3f *values, const Vector3f &delta, crimild::Size count, Kernel kernel )
+{
+	auto data = reinterpret_cast< crimild::Real32 * >( values );
+	crimild::Size begin = 0;
+
+	switch ( kernel ) {
+#if defined( CRIMILD_SIMD_AVX )
+		case Kernel::AVX:
+			begin = internal::addParticlesAVX( data, delta, count );
+			break;
+#endif
+
+#if defined( CRIMILD_SIMD_SSE )
+		case Kernel::SSE:
+			begin = internal::addParticlesSSE( data, delta, count );
+			break;
+#endif
+
+		case Kernel::SCALAR:
+			break;
+
+		default:
+			// not supported by this build
+			if ( getDefaultKernel() != Kernel::SCALAR ) {
+				add( values, delta, count, getDefaultKernel() );
+				return;
+			}
+			break;
+	}
+
+	internal::addParticlesScalar( data, delta, begin, count );
+}
+
+void ParticleKernels::addScaled( Vector3f *values, const Vector3f *deltas, crimild::Real32 scale, crimild::Size count, Kernel kernel )
+{
+	auto data = reinterpret_cast< crimild::Real32 * >( values );
+	auto deltaData = reinterpret_cast< const crimild::Real32 * >( deltas );
+	crimild::Size begin = 0;
+
+	switch ( kernel ) {
+#if defined( CRIMILD_SIMD_AVX )
+		case Kernel::AVX:
+			begin = internal::addScaledParticlesAVX( data, deltaData, scale, count );
+			break;
+#endif
+
+#if defined( CRIMILD_SIMD_SSE )
+		case Kernel::SSE:
+			begin = internal::addScaledParticlesSSE( data, deltaData, scale, count );
+			break;
+#endif
+
+		case Kernel::SCALAR:
+			break;
+
+		default:
+			if ( getDefaultKernel() != Kernel::SCALAR ) {
+				addScaled( values, deltas, scale, count, getDefaultKernel() );
+				return;
+			}
+			break;
+	}
+
+	internal::addScaledParticlesScalar( data, deltaData, scale, begin, count );
+}
+
+void ParticleKernels::subtract( crimild::Real32 *values, crimild::Real32 delta, crimild::Size count, Kernel kernel )
+{
+	crimild::Size begin = 0;
+
+	switch ( kernel ) {
+#if defined( CRIMILD_SIMD_AVX )
+		case Kernel::AVX:
+			begin = internal::subtractParticlesAVX( values, delta, count );
+			break;
+#endif
+
+#if defined( CRIMILD_SIMD_SSE )
+		case Kernel::SSE:
+			begin = internal::subtractParticlesSSE( values, delta, count );
+			break;
+#endif
+
+		case Kernel::SCALAR:
+			break;
+
+		default:
+			if ( getDefaultKernel() != Kernel::SCALAR ) {
+				subtract( values, delta, count, getDefaultKernel() );
+				return;
+			}
+			break;
+	}
+
+	internal::subtractParticlesScalar( values, delta, begin, count );
+}
+
+void ParticleKernels::clampHeight( Vector3f *positions, crimild::Real32 height, crimild::Size count, Kernel kernel )
+{
+	auto data = reinterpret_cast< crimild::Real32 * >( positions );
+	crimild::Size begin = 0;
+
+	switch ( kernel ) {
+#if defined( CRIMILD_SIMD_AVX )
+		case Kernel::AVX:
+			begin = internal::clampParticlesHeightAVX( data, height, count );
+			break;
+#endif
+
+#if defined( CRIMILD_SIMD_SSE )
+		case Kernel::SSE:
+			begin = internal::clampParticlesHeightSSE( data, height, count );
+			break;
+#endif
+
+		case Kernel::SCALAR:
+			break;
+
+		default:
+			if ( getDefaultKernel() != Kernel::SCALAR ) {
+				clampHeight( positions, height, count, getDefaultKernel() );
+				return;
+			}
+			break;
+	}
+
+	internal::clampParticlesHeightScalar( data, height, begin, count );
+}
+
+void ParticleKernels::attract( const Vector3f *positions, Vector3f *accelerations, const Vector3f &center, crimild::Real32 radius, crimild::Real32 strength, crimild::Size count, Kernel kernel )
+{
+	auto positionData = reinterpret_cast< const crimild::Real32 * >( positions );
+	auto accelerationData = reinterpret_cast< crimild::Real32 * >( accelerations );
+	crimild::Size begin = 0;
+
+	switch ( kernel ) {
+#if defined( CRIMILD_SIMD_AVX )
+		case Kernel::AVX:
+#endif
+#if defined( CRIMILD_SIMD_SSE )
+		case Kernel::SSE:
+			begin = internal::attractParticlesSSE( positionData, accelerationData, center, radius, strength, count );
+			break;
+#endif
+
+		case Kernel::SCALAR:
+			break;
+
+		default:
+			if ( getDefaultKernel() != Kernel::SCALAR ) {
+				attract( positions, accelerations, center, radius, strength, count, getDefaultKernel() );
+				return;
+			}
+			break;
+	}
+
+	internal::attractParticlesScalar( positionData, accelerationData, center, radius, strength, begin, count );
+}
+
+void ParticleKernels::interpolate( const RGBAColorf *from, const RGBAColorf *to, const crimild::Real32 *times, const crimild::Real32 *lifetimes, RGBAColorf *result, crimild::Size count, Kernel kernel )
+{
+	auto fromData = reinterpret_cast< const crimild::Real32 * >( from );
+	auto toData = reinterpret_cast< const crimild::Real32 * >( to );
+	auto resultData = reinterpret_cast< crimild::Real32 * >( result );
+	crimild::Size begin = 0;
+
+	switch ( kernel ) {
+#if defined( CRIMILD_SIMD_AVX )
+		case Kernel::AVX:
+			begin = internal::interpolateParticlesAVX( fromData, toData, times, lifetimes, resultData, count );
+			break;
+#endif
+
+#if defined( CRIMILD_SIMD_SSE )
+		case Kernel::SSE:
+			begin = internal::interpolateParticlesSSE( fromData, toData, times, lifetimes, resultData, count );
+			break;
+#endif
+
+		case Kernel::SCALAR:
+			break;
+
+		default:
+			if ( getDefaultKernel() != Kernel::SCALAR ) {
+				interpolate( from, to, times, lifetimes, result, count, getDefaultKernel() );
+				return;
+			}
+			break;
+	}
+
+	internal::interpolateParticlesScalar( fromData, toData, times, lifetimes, resultData, begin, count );
+}
+
+void ParticleKernels::transform( Vector3f *points, const Matrix4f &model, crimild::Size count, Kernel kernel )
+{
+	auto data = reinterpret_cast< crimild::Real32 * >( points );
+	crimild::Size begin = 0;
+
+	switch ( kernel ) {
+#if defined( CRIMILD_SIMD_AVX )
+		case Kernel::AVX:
+#endif
+#if defined( CRIMILD_SIMD_SSE )
+		case Kernel::SSE:
+			begin = internal::transformParticlesSSE( data, model.getData(), count );
+			break;
+#endif
+
+		case Kernel::SCALAR:
+			break;
+
+		default:
+			if ( getDefaultKernel() != Kernel::SCALAR ) {
+				transform( points, model, count, getDefaultKernel() );
+				return;
+			}
+			break;
+	}
+
+	internal::transformParticlesScalar( data, model.getData(), begin, count );
+}
@@ -0,0 +1,120 @@
+/*
+ * Copyright (c) 2013, Hernan Saez
+ * All rights reserved.
+ * 
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *     * Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in the
+ *       documentation and/or other materials provided with the distribution.
+ *     * Neither the name of the <organization> nor the
+ *       names of its contributors may be used to endorse or promote products
+ *       derived from this software without specific prior written permission.
+ * 
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL <COPYRIGHT HOLDER> BE LIABLE FOR ANY
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef CRIMILD_PARTICLE_SYSTEM_KERNELS_
+#define CRIMILD_PARTICLE_SYSTEM_KERNELS_
+
+#include "Foundation/Types.hpp"
+#include "Mathematics/Vector.hpp"
+#include "Mathematics/Matrix.hpp"
+
+namespace crimild {
+
+	/**
+	   \brief Batched operations over particle attributes
+
+	   Attributes are stored as packed arrays of Vector3f, RGBAColorf or 
+	   Real32 values (see ParticleAttribArray), so kernels work on them 
+	   as flat streams of floats. Whenever a kernel needs one component 
+	   at a time (i.e. computing distances), four particles are loaded 
+	   into three registers and transposed into x, y and z lanes, 
+	   processed and then transposed back before storing them.
+
+	   Depending on the instruction sets available at compile time (see 
+	   Simd.hpp), particles are processed eight (AVX) or four (SSE) at a 
+	   time and the remaining ones are handled by a scalar loop. All 
+	   kernels perform the exact same floating point operations, so 
+	   results do not depend on the kernel being used. 
+	 */
+	class ParticleKernels {
+	public:
+		enum class Kernel {
+			SCALAR,
+			SSE,
+			AVX,
+		};
+
+		/**
+		   \brief The widest kernel supported by this build
+		 */
+		static Kernel getDefaultKernel( void );
+
+		static const char *getKernelName( Kernel kernel );
+
+		/**
+		   \brief Computes values[ i ] += delta
+
+		   \param kernel Requested kernel. If not supported, the default one is used instead
+		 */
+		static void add( Vector3f *values, const Vector3f &delta, crimild::Size count, Kernel kernel = getDefaultKernel() );
+
+		/**
+		   \brief Computes values[ i ] += scale * deltas[ i ]
+
+		   Used for Euler integration
+		 */
+		static void addScaled( Vector3f *values, const Vector3f *deltas, crimild::Real32 scale, crimild::Size count, Kernel kernel = getDefaultKernel() );
+
+		/**
+		   \brief Computes values[ i ] -= delta
+		 */
+		static void subtract( crimild::Real32 *values, crimild::Real32 delta, crimild::Size count, Kernel kernel = getDefaultKernel() );
+
+		/**
+		   \brief Makes sure no position is below the given height
+		 */
+		static void clampHeight( Vector3f *positions, crimild::Real32 height, crimild::Size count, Kernel kernel = getDefaultKernel() );
+
+		/**
+		   \brief Pulls particles towards a center
+
+		   Particles inside the sphere are accelerated towards its center,
+		   with an intensity that decreases linearly with the distance. 
+
+		   \param strength Scaled by the elapsed time
+		 */
+		static void attract( const Vector3f *positions, Vector3f *accelerations, const Vector3f &center, crimild::Real32 radius, crimild::Real32 strength, crimild::Size count, Kernel kernel = getDefaultKernel() );
+
+		/**
+		   \brief Interpolates colors based on the particles' remaining life time
+
+		   Computes result[ i ] = from[ i ] + t * ( to[ i ] - from[ i ] ), where 
+		   t = 1 - times[ i ] / lifetimes[ i ]
+		 */
+		static void interpolate( const RGBAColorf *from, const RGBAColorf *to, const crimild::Real32 *times, const crimild::Real32 *lifetimes, RGBAColorf *result, crimild::Size count, Kernel kernel = getDefaultKernel() );
+
+		/**
+		   \brief Transforms points in place
+
+		   \param model Affine transformation, usually computed with Transformation::computeModelMatrix()
+		 */
+		static void transform( Vector3f *points, const Matrix4f &model, crimild::Size count, Kernel kernel = getDefaultKernel() );
+	};
+
+}
+
+#endif
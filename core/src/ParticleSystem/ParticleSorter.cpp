@@ -0,0 +1,104 @@
+/*
+ * Copyright (c) 2013, Hernan Saez
+ * All rights reserved.
+ * 
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *     * Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in the
+ *       documentation and/or other materials provided with the distribution.
+ *     * Neither the name of the <organization> nor the
+ *       names of its contributors may be used to endorse or promote products
+ *       derived from this software without specific prior written permission.
+ * 
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL <COPYRIGHT HOLDER> BE LIABLE FOR ANY
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "ParticleSorter.hpp"
+
+using namespace crimild;
+
+namespace crimild {
+
+	namespace internal {
+
+		/**
+		   \brief Stable insertion sort that gives up after moving too many elements
+
+		   If aborted, keys and indices are still paired together, so the 
+		   arrays can be sorted using any other algorithm.
+
+		   \returns The number of moved elements or, if the limit was exceeded,
+		   a value greater than maxShifts
+		 */
+		crimild::Size insertionSortParticles( crimild::UInt32 *keys, ParticleId *order, crimild::Size count, crimild::Size maxShifts )
+		{
+			crimild::Size shifts = 0;
+			for ( crimild::Size i = 1; i < count; i++ ) {
+				const auto key = keys[ i ];
+				if ( keys[ i - 1 ] <= key ) {
+					continue;
+				}
+
+				const auto pid = order[ i ];
+				auto j = i;
+				while ( j > 0 && keys[ j - 1 ] > key ) {
+					keys[ j ] = keys[ j - 1 ];
+					order[ j ] = order[ j - 1 ];
+					--j;
+					if ( ++shifts > maxShifts ) {
+						break;
+					}
+				}
+				keys[ j ] = key;
+				order[ j ] = pid;
+
+				if ( shifts > maxShifts ) {
+					break;
+				}
+			}
+
+			return shifts;
+		}
+
+	}
+
+}
+
+void ParticleSorter::sortKeys( ParticleData *particles, crimild::Size count )
+{
+	_lastSortIncremental = false;
+
+	if ( count < 2 ) {
+		return;
+	}
+
+	auto keys = &_keys[ 0 ];
+	auto order = &_order[ 0 ];
+
+	if ( _coherenceEnabled ) {
+		// allow as many moves as elements, keeping the worst case linear
+		const auto shifts = internal::insertionSortParticles( keys, order, count, count );
+		if ( shifts <= count ) {
+			_lastSortIncremental = true;
+			if ( shifts > 0 ) {
+				particles->permute( order, count );
+			}
+			return;
+		}
+	}
+
+	_radixSort.sort( keys, order, count );
+	particles->permute( order, count );
+}
@@ -0,0 +1,104 @@
+/*
+ * Copyright (c) 2013, Hernan Saez
+ * All rights reserved.
+ * 
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *     * Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in the
+ *       documentation and/or other materials provided with the distribution.
+ *     * Neither the name of the <organization> nor the
+ *       names of its contributors may be used to endorse or promote products
+ *       derived from this software without specific prior written permission.
+ * 
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL <COPYRIGHT HOLDER> BE LIABLE FOR ANY
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef CRIMILD_PARTICLE_SYSTEM_SORTER_
+#define CRIMILD_PARTICLE_SYSTEM_SORTER_
+
+#include "ParticleData.hpp"
+
+#include "Foundation/RadixSort.hpp"
+
+#include <vector>
+
+namespace crimild {
+
+	/**
+	   \brief Sorts alive particles by depth
+
+	   Depths are mapped to integer keys (see radixSortKey()) and sorted 
+	   along with particle indices. The resulting order is then applied 
+	   to all attributes at once using ParticleData::permute(), instead 
+	   of swapping particles for every inversion.
+
+	   Particles usually move very little between frames, so the order
+	   computed in the previous frame is often almost correct. When 
+	   coherence is enabled, an insertion sort is attempted first and 
+	   the radix sort is only used if too many particles need to move.
+	 */
+	class ParticleSorter {
+	public:
+		enum class Order {
+			ASCENDING,
+			DESCENDING,
+		};
+
+	public:
+		crimild::Bool isCoherenceEnabled( void ) const { return _coherenceEnabled; }
+		void setCoherenceEnabled( crimild::Bool enabled ) { _coherenceEnabled = enabled; }
+
+		/**
+		   \brief Indicates if the last sort was solved by insertion sort
+		 */
+		crimild::Bool wasLastSortIncremental( void ) const { return _lastSortIncremental; }
+
+		/**
+		   \brief Sorts all alive particles
+
+		   \param depth Computes the depth for a given particle id
+		 */
+		template< typename DepthFn >
+		void sort( ParticleData *particles, Order order, DepthFn depth )
+		{
+			const auto count = particles->getAliveCount();
+			_keys.resize( count );
+			_order.resize( count );
+
+			for ( crimild::Size i = 0; i < count; i++ ) {
+				const auto key = radixSortKey( depth( i ) );
+				_keys[ i ] = ( order == Order::ASCENDING ? key : ~key );
+				_order[ i ] = i;
+			}
+
+			sortKeys( particles, count );
+		}
+
+	private:
+		void sortKeys( ParticleData *particles, crimild::Size count );
+
+	private:
+		crimild::Bool _coherenceEnabled = true;
+		crimild::Bool _lastSortIncremental = false;
+
+		std::vector< crimild::UInt32 > _keys;
+		std::vector< ParticleId > _order;
+		// 11-bit digits sort depth keys in three passes instead of four
+		RadixSort< crimild::UInt32, ParticleId, 11 > _radixSort;
+	};
+
+}
+
+#endif
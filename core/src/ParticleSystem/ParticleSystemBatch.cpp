@@ -0,0 +1,100 @@
+/*
+ * Copyright (c) 2013, Hernan Saez
+ * All rights reserved.
+ * 
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *     * Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in the
+ *       documentation and/or other materials provided with the distribution.
+ *     * Neither the name of the <organization> nor the
+ *       names of its contributors may be used to endorse or promote products
+ *       derived from this software without specific prior written permission.
+ * 
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL <COPYRIGHT HOLDER> BE LIABLE FOR ANY
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "ParticleSystemBatch.hpp"
+
+#include "Concurrency/ParallelFor.hpp"
+
+#include <algorithm>
+
+using namespace crimild;
+
+namespace crimild {
+
+	namespace internal {
+
+		static thread_local ParticleSystemBatch *t_currentParticleSystemBatch = nullptr;
+
+	}
+
+}
+
+ParticleSystemBatch::ParticleSystemBatch( void )
+{
+
+}
+
+ParticleSystemBatch::~ParticleSystemBatch( void )
+{
+
+}
+
+ParticleSystemBatch *ParticleSystemBatch::getCurrent( void )
+{
+	return internal::t_currentParticleSystemBatch;
+}
+
+void ParticleSystemBatch::collect( std::function< void( void ) > const &fn )
+{
+	// batches might be nested, even if that's not very useful
+	auto previous = internal::t_currentParticleSystemBatch;
+	internal::t_currentParticleSystemBatch = this;
+	fn();
+	internal::t_currentParticleSystemBatch = previous;
+}
+
+void ParticleSystemBatch::add( ParticleSystemComponent *component, crimild::Real64 dt )
+{
+	// keep components alive, in case they're detached before the batch is executed
+	_entries.push_back( Entry { crimild::retain( component ), dt } );
+}
+
+void ParticleSystemBatch::execute( void )
+{
+	// components might have been detached after they were collected
+	_entries.erase( std::remove_if( _entries.begin(), _entries.end(), []( Entry const &e ) {
+		return e.component->getNode() == nullptr;
+	}), _entries.end() );
+
+	for ( auto &e : _entries ) {
+		e.component->emit( e.dt );
+	}
+
+	const auto rangeSize = _rangeSize;
+	concurrency::parallel_for( concurrency::Range( 0, _entries.size() ), 1, [ this, rangeSize ]( concurrency::Range const &r ) {
+		for ( auto i = r.begin; i < r.end; i++ ) {
+			_entries[ i ].component->simulate( _entries[ i ].dt, rangeSize );
+		}
+	});
+
+	for ( auto &e : _entries ) {
+		e.component->render( e.dt );
+	}
+
+	_entries.clear();
+}
+
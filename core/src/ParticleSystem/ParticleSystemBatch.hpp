@@ -0,0 +1,102 @@
+/*
+ * Copyright (c) 2013, Hernan Saez
+ * All rights reserved.
+ * 
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *     * Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in the
+ *       documentation and/or other materials provided with the distribution.
+ *     * Neither the name of the <organization> nor the
+ *       names of its contributors may be used to endorse or promote products
+ *       derived from this software without specific prior written permission.
+ * 
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL <COPYRIGHT HOLDER> BE LIABLE FOR ANY
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef CRIMILD_PARTICLE_SYSTEM_BATCH_
+#define CRIMILD_PARTICLE_SYSTEM_BATCH_
+
+#include "ParticleSystemComponent.hpp"
+
+#include <functional>
+#include <vector>
+
+namespace crimild {
+
+	/**
+	   \brief Updates all particle systems in a scene together
+
+	   While a batch is collecting (see collect()), ParticleSystemComponent::update() 
+	   does not simulate particles. Instead, components register themselves 
+	   in the batch, which is updated later by calling execute().
+
+	   Emission and rendering are performed in the same order in which components 
+	   were collected, since generators share a random number generator and 
+	   renderers may modify the scene. Updaters are executed in parallel using 
+	   the JobScheduler, if available. Big emitters are further split into 
+	   particle ranges (see ParticleUpdater::isRangeUpdateSupported()).
+
+	   Since execute() blocks until all components are updated, particle buffers
+	   are always complete before render queues are computed.
+	 */
+	class ParticleSystemBatch {
+	public:
+		ParticleSystemBatch( void );
+		~ParticleSystemBatch( void );
+
+		/**
+		   \brief The batch collecting components in the current thread, if any
+		 */
+		static ParticleSystemBatch *getCurrent( void );
+
+		/**
+		   \brief Invokes a function while this batch is collecting components
+
+		   Usually, the function updates all components in a scene.
+		 */
+		void collect( std::function< void( void ) > const &fn );
+
+		void add( ParticleSystemComponent *component, crimild::Real64 dt );
+
+		crimild::Size getComponentCount( void ) const { return _entries.size(); }
+
+		/**
+		   \brief Maximum number of particles per job
+
+		   Emitters with more alive particles than this are split into
+		   several jobs. If zero, emitters are never split.
+		 */
+		void setRangeSize( crimild::Size value ) { _rangeSize = value; }
+		crimild::Size getRangeSize( void ) const { return _rangeSize; }
+
+		/**
+		   \brief Updates all collected components and clears the batch
+		 */
+		void execute( void );
+
+	private:
+		struct Entry {
+			SharedPointer< ParticleSystemComponent > component;
+			crimild::Real64 dt;
+		};
+
+		std::vector< Entry > _entries;
+		crimild::Size _rangeSize = 8192;
+	};
+
+}
+
+#endif
+
@@ -26,6 +26,8 @@
  */
 
 #include "ParticleSystemComponent.hpp"
+#include "ParticleSystemBatch.hpp"
+#include "Concurrency/ParallelFor.hpp"
 #include "Coding/Encoder.hpp"
 #include "Coding/Decoder.hpp"
 
@@ -101,15 +103,34 @@ void ParticleSystemComponent::update( const Clock &c )
 {
     const auto dt = c.getDeltaTime();
 
-	auto node = getNode();
-	auto particles = getParticles();
+	if ( auto batch = ParticleSystemBatch::getCurrent() ) {
+		// particles will be updated later, together with other particle systems
+		batch->add( this, dt );
+		return;
+	}
 
+	emit( dt );
+	simulate( dt );
+	render( dt );
+}
+
+void ParticleSystemComponent::emit( crimild::Real64 dt )
+{
 	if ( isAnimationEnabled() ) {
-		updateGenerators( node, dt, particles );
-		updateUpdaters( node, dt, particles );
+		updateGenerators( getNode(), dt, getParticles() );
+	}
+}
+
+void ParticleSystemComponent::simulate( crimild::Real64 dt, crimild::Size rangeSize )
+{
+	if ( isAnimationEnabled() ) {
+		updateUpdaters( getNode(), dt, getParticles(), rangeSize );
 	}
-	
-	updateRenderers( node, dt, particles );
+}
+
+void ParticleSystemComponent::render( crimild::Real64 dt )
+{
+	updateRenderers( getNode(), dt, getParticles() );
 }
 
 void ParticleSystemComponent::updateGenerators( Node *node, crimild::Real64 dt, ParticleData *particles )
@@ -134,11 +155,42 @@ void ParticleSystemComponent::updateGenerators( Node *node, crimild::Real64 dt,
     }
 }
 
-void ParticleSystemComponent::updateUpdaters( Node *node, crimild::Real64 dt, ParticleData *particles )
+void ParticleSystemComponent::updateUpdaters( Node *node, crimild::Real64 dt, ParticleData *particles, crimild::Size rangeSize )
 {
-	_updaters.each( [ node, dt, particles ]( SharedPointer< ParticleUpdater > &u ) {
-		u->update( node, dt, particles );
-	});
+	const auto canSplit = rangeSize > 0 && particles->getAliveCount() > rangeSize;
+
+	if ( !canSplit ) {
+		_updaters.each( [ node, dt, particles ]( SharedPointer< ParticleUpdater > &u ) {
+			u->update( node, dt, particles );
+		});
+		return;
+	}
+
+	// Consecutive updaters supporting range updates are executed together 
+	// for each range. Since particles do not depend on each other, results
+	// are the same as updating the whole array one updater at a time.
+	const auto updaterCount = _updaters.size();
+	crimild::Size i = 0;
+	while ( i < updaterCount ) {
+		const auto first = i++;
+		if ( !_updaters[ first ]->isRangeUpdateSupported() ) {
+			_updaters[ first ]->update( node, dt, particles );
+			continue;
+		}
+
+		while ( i < updaterCount && _updaters[ i ]->isRangeUpdateSupported() ) {
+			i++;
+		}
+		const auto last = i;
+
+		// previous updaters might have killed some particles
+		const auto aliveCount = particles->getAliveCount();
+		concurrency::parallel_for( concurrency::Range( 0, aliveCount ), rangeSize, [ this, node, dt, particles, first, last ]( concurrency::Range const &r ) {
+			for ( auto u = first; u < last; u++ ) {
+				_updaters[ u ]->updateRange( node, dt, particles, r.begin, r.end );
+			}
+		});
+	}
 }
 
 void ParticleSystemComponent::updateRenderers( Node *node, crimild::Real64 dt, ParticleData *particles )
@@ -60,8 +60,37 @@ namespace crimild {
         inline ParticleData *getParticles( void ) { return crimild::get_ptr( _particles ); }
 
 		virtual void start( void ) override;
+
+		/**
+		   \brief Updates the particle system
+
+		   If a ParticleSystemBatch is collecting components in the current
+		   thread, this component is added to it and no particles are updated.
+		 */
 		virtual void update( const Clock & ) override;
 
+		/**
+		   \name Batched updates
+
+		   Invoked by ParticleSystemBatch, in this order. Emission and
+		   rendering must happen in the update thread, but updaters for 
+		   different particle systems may be executed in parallel.
+		 */
+		//@{
+
+		void emit( crimild::Real64 dt );
+
+		/**
+		   \param rangeSize If greater than zero and there are more alive 
+		   particles than that, updaters supporting range updates are 
+		   executed in parallel jobs of at most rangeSize particles each.
+		 */
+		void simulate( crimild::Real64 dt, crimild::Size rangeSize = 0 );
+
+		void render( crimild::Real64 dt );
+
+		//@}
+
     private:
         SharedPointer< ParticleData > _particles;
 
@@ -152,6 +181,20 @@ namespace crimild {
 
 			virtual void configure( Node *node, ParticleData *particles ) = 0;
             virtual void update( Node *node, crimild::Real64 dt, ParticleData *particles ) = 0;
+
+			/**
+			   \brief Indicates if particles are updated independently of each other
+
+			   If true, updateRange() may be invoked concurrently for disjoint 
+			   ranges of alive particles. Updaters that kill or reorder particles
+			   must not support range updates.
+			 */
+			virtual crimild::Bool isRangeUpdateSupported( void ) const { return false; }
+
+			/**
+			   \brief Updates alive particles in [ begin, end ) only
+			 */
+			virtual void updateRange( Node *node, crimild::Real64 dt, ParticleData *particles, ParticleId begin, ParticleId end ) { }
         };
 
         using ParticleUpdaterPtr =  SharedPointer< ParticleUpdater >;
@@ -163,7 +206,7 @@ namespace crimild {
 
 	private:
 		void configureUpdaters( Node *node, ParticleData *particles );
-		void updateUpdaters( Node *node, crimild::Real64 dt, ParticleData *particles );
+		void updateUpdaters( Node *node, crimild::Real64 dt, ParticleData *particles, crimild::Size rangeSize = 0 );
 		
     private:
         containers::Array< ParticleUpdaterPtr > _updaters;
@@ -35,7 +35,7 @@
 
 #include "SceneGraph/Camera.hpp"
 
-#include "Concurrency/Async.hpp"
+#include <limits>
 
 using namespace crimild;
 
@@ -65,82 +65,95 @@ void OrientedQuadParticleRenderer::configure( Node *node, ParticleData *particle
 	_positions = particles->getAttrib( ParticleAttrib::POSITION );
 	_sizes = particles->getAttrib( ParticleAttrib::UNIFORM_SCALE );
 
+	// four vertices per particle and indices are 16-bit values
+	const crimild::Size maxVertexCount = std::numeric_limits< IndexPrecision >::max() + 1;
+	const auto maxParticles = Numeric< crimild::Size >::min( particles->getParticleCount(), maxVertexCount / 4 );
+
+	// vertices are rewritten every frame, but indices never change
+	_vertices = crimild::alloc< StreamingVertexBufferObject >( VertexFormat::VF_P3_UV2, 4 * maxParticles );
+	auto ibo = crimild::alloc< IndexBufferObject >( 6 * maxParticles );
+	for ( crimild::Size i = 0; i < maxParticles; i++ ) {
+		const auto idx = i * 6;
+		const auto vdx = i * 4;
+		ibo->setIndexAt( idx + 0, vdx + 0 );
+		ibo->setIndexAt( idx + 1, vdx + 1 );
+		ibo->setIndexAt( idx + 2, vdx + 2 );
+		ibo->setIndexAt( idx + 3, vdx + 0 );
+		ibo->setIndexAt( idx + 4, vdx + 2 );
+		ibo->setIndexAt( idx + 5, vdx + 3 );
+	}
+
     _primitive = crimild::alloc< Primitive >( Primitive::Type::TRIANGLES );
+	_primitive->setVertexBuffer( _vertices );
+	_primitive->setIndexBuffer( ibo );
+	_primitive->setIndexCount( 0 );
 
 	_geometry->attachPrimitive( _primitive );
 }
 
 void OrientedQuadParticleRenderer::update( Node *node, crimild::Real64 dt, ParticleData *particles )
 {
-    const auto pCount = particles->getAliveCount();
-    if ( pCount == 0 ) {
-        return;
-    }
-    
-    auto vbo = crimild::alloc< VertexBufferObject >( VertexFormat::VF_P3_UV2, 4 * pCount );
-	auto ibo = crimild::alloc< IndexBufferObject >( 6 * pCount );
+	const auto pCount = Numeric< crimild::Size >::min( particles->getAliveCount(), _vertices->getMaxVertexCount() / 4 );
 
 	const auto camera = Camera::getMainCamera();
 	auto cameraUp = camera->getWorld().computeUp();
 	auto cameraRight = camera->getWorld().computeRight();
 
-	node->getWorld().applyInverseToVector( cameraUp, cameraUp );
-	node->getWorld().applyInverseToVector( cameraRight, cameraRight );
+	const auto &world = node->getWorld();
+	world.applyInverseToVector( cameraUp, cameraUp );
+	world.applyInverseToVector( cameraRight, cameraRight );
 
-	const auto offset0 = cameraUp - cameraRight;
-	const auto offset1 = -cameraUp - cameraRight;
-	const auto offset2 = -cameraUp + cameraRight;
-	const auto offset3 = cameraUp + cameraRight;
+	const Vector3f offsets[] = {
+		cameraUp - cameraRight,
+		-cameraUp - cameraRight,
+		-cameraUp + cameraRight,
+		cameraUp + cameraRight,
+	};
 
-	const auto uv0 = Vector2f( 0.0f, 0.0f );
-	const auto uv1 = Vector2f( 0.0f, 1.0f );
-	const auto uv2 = Vector2f( 1.0f, 1.0f );
-	const auto uv3 = Vector2f( 1.0f, 0.0f );
+	const Vector2f uvs[] = {
+		Vector2f( 0.0f, 0.0f ),
+		Vector2f( 0.0f, 1.0f ),
+		Vector2f( 1.0f, 1.0f ),
+		Vector2f( 1.0f, 0.0f ),
+	};
 
 	const auto ps = _positions->getData< Vector3f >();
 	const auto ss = _sizes->getData< crimild::Real32 >();
 
-	// Vertex data is interleaved, so it should be more efficient
-	// to set each vertex attribute per loop (as below) instead of
-	// using separated loops (as in the case of other updaters/renderers)
-	// TODO: I need to confirm this somehow
-	for ( auto i = 0; i < pCount; i++ ) {
-		auto idx = i * 4;
+	const auto &format = _vertices->getVertexFormat();
+	const auto stride = format.getVertexSize();
+	const auto positionsOffset = format.getPositionsOffset();
+	const auto uvsOffset = format.getTextureCoordsOffset();
+
+	// Vertex data is interleaved and written in place (which might 
+	// be GPU memory), so all attributes are set for each vertex in 
+	// order, without reading from the destination buffer
+	auto vertices = _vertices->beginStreaming( 4 * pCount );
+
+	const auto computeInWorldSpace = particles->shouldComputeInWorldSpace();
+
+	for ( crimild::Size i = 0; i < pCount; i++ ) {
 		auto pos = ps[ i ];
-		if ( particles->shouldComputeInWorldSpace() ) {
-			// TODO: cache inverse transform?
-			node->getWorld().applyInverseToPoint( pos, pos );
+		if ( computeInWorldSpace ) {
+			world.applyInverseToPoint( pos, pos );
+		}
+		const auto s = ss[ i ];
+
+		auto v = vertices + 4 * i * stride;
+		for ( crimild::Size j = 0; j < 4; j++ ) {
+			const auto p = pos + s * offsets[ j ];
+			v[ positionsOffset + 0 ] = p[ 0 ];
+			v[ positionsOffset + 1 ] = p[ 1 ];
+			v[ positionsOffset + 2 ] = p[ 2 ];
+			v[ uvsOffset + 0 ] = uvs[ j ][ 0 ];
+			v[ uvsOffset + 1 ] = uvs[ j ][ 1 ];
+			v += stride;
 		}
-		auto s = ss[ i ];
-		
-		vbo->setPositionAt( idx + 0, pos + s * offset0 );
-		vbo->setTextureCoordAt( idx + 0, uv0 );
-		
-		vbo->setPositionAt( idx + 1, pos + s * offset1 );
-		vbo->setTextureCoordAt( idx + 1, uv1 );
-		
-		vbo->setPositionAt( idx + 2, pos + s * offset2 );
-		vbo->setTextureCoordAt( idx + 2, uv2 );
-
-		vbo->setPositionAt( idx + 3, pos + s * offset3 );
-		vbo->setTextureCoordAt( idx + 3, uv3 );
 	}
 
-	for ( auto i = 0; i < pCount; i++ ) {
-		const auto idx = i * 6;
-		const auto vdx = i * 4;
-		ibo->setIndexAt( idx + 0, vdx + 0 );
-		ibo->setIndexAt( idx + 1, vdx + 1 );
-		ibo->setIndexAt( idx + 2, vdx + 2 );
-		ibo->setIndexAt( idx + 3, vdx + 0 );
-		ibo->setIndexAt( idx + 4, vdx + 2 );
-		ibo->setIndexAt( idx + 5, vdx + 3 );
-	}
+	_vertices->endStreaming();
 
-    crimild::concurrency::sync_frame( [this, vbo, ibo] {
-        _primitive->setVertexBuffer( vbo );
-        _primitive->setIndexBuffer( ibo );
-    });
+	_primitive->setIndexCount( 6 * pCount );
 }
 
 void OrientedQuadParticleRenderer::encode( coding::Encoder &encoder ) 
@@ -34,6 +34,7 @@
 
 #include "SceneGraph/Geometry.hpp"
 #include "Primitives/Primitive.hpp"
+#include "Rendering/StreamingVertexBufferObject.hpp"
 
 namespace crimild {
 
@@ -53,6 +54,7 @@ namespace crimild {
 		MaterialPtr _material;
 		PrimitivePtr _primitive;
 		GeometryPtr _geometry;
+		StreamingVertexBufferObjectPtr _vertices;
 		
 		ParticleAttribArray *_positions = nullptr;
 		ParticleAttribArray *_sizes = nullptr;
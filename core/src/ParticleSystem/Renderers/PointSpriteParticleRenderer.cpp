@@ -30,7 +30,8 @@
 #include "Simulation/AssetManager.hpp"
 #include "Rendering/Renderer.hpp"
 #include "Components/MaterialComponent.hpp"
-#include "Concurrency/Async.hpp"
+
+#include <limits>
 
 using namespace crimild;
 
@@ -61,55 +62,66 @@ void PointSpriteParticleRenderer::configure( Node *node, ParticleData *particles
 	_colors = particles->getAttrib( ParticleAttrib::COLOR );
 	_sizes = particles->getAttrib( ParticleAttrib::UNIFORM_SCALE );
 
+	// indices are 16-bit values
+	const crimild::Size maxIndexCount = std::numeric_limits< IndexPrecision >::max() + 1;
+	const auto maxParticles = Numeric< crimild::Size >::min( particles->getParticleCount(), maxIndexCount );
+
+	// vertices are rewritten every frame, but indices never change
+	_vertices = crimild::alloc< StreamingVertexBufferObject >( VertexFormat::VF_P3_C4_UV2, maxParticles );
+	auto ibo = crimild::alloc< IndexBufferObject >( maxParticles );
+	ibo->generateIncrementalIndices();
+
     _primitive = crimild::alloc< Primitive >( Primitive::Type::POINTS );
+	_primitive->setVertexBuffer( _vertices );
+	_primitive->setIndexBuffer( ibo );
+	_primitive->setIndexCount( 0 );
 
 	_geometry->attachPrimitive( _primitive );
 }
 
 void PointSpriteParticleRenderer::update( Node *node, crimild::Real64 dt, ParticleData *particles )
 {
-    const auto pCount = particles->getAliveCount();
-    if ( pCount == 0 ) {
-        return;
-    }
-    
-    auto vbo = crimild::alloc< VertexBufferObject >( VertexFormat::VF_P3_C4_UV2, pCount );
+	const auto pCount = Numeric< crimild::Size >::min( particles->getAliveCount(), _vertices->getMaxVertexCount() );
 
 	const auto ps = _positions->getData< Vector3f >();
 	const auto ss = _sizes->getData< crimild::Real32 >();
 	const auto cs = _colors->getData< RGBAColorf >();
-    
-    // TODO: should I traverse the arrays by grouping data in 4/8 byte touples?
-
-	if ( particles->shouldComputeInWorldSpace() ) {
-		for ( auto i = 0; i < pCount; i++ ) {
-			auto p = ps[ i ];
-			// TODO: cache inverse transform?
-			node->getWorld().applyInverseToPoint( p, p );
-			vbo->setPositionAt( i, p );
-		}
-	}
-	else {
-		for ( auto i = 0; i < pCount; i++ ) {
-			vbo->setPositionAt( i, ps[ i ] );
+
+	const auto &format = _vertices->getVertexFormat();
+	const auto stride = format.getVertexSize();
+	const auto positionsOffset = format.getPositionsOffset();
+	const auto colorsOffset = format.getColorsOffset();
+	const auto uvsOffset = format.getTextureCoordsOffset();
+
+	// vertices are written in place, which might be GPU memory
+	auto vertices = _vertices->beginStreaming( pCount );
+
+	const auto &world = node->getWorld();
+	const auto computeInWorldSpace = particles->shouldComputeInWorldSpace();
+
+	for ( crimild::Size i = 0; i < pCount; i++ ) {
+		auto p = ps[ i ];
+		if ( computeInWorldSpace ) {
+			world.applyInverseToPoint( p, p );
 		}
-	}
 
-	for ( auto i = 0; i < pCount; i++ ) {
-		vbo->setTextureCoordAt( i, Vector2f( ss[ i ], 0.0f ) );
+		const auto &c = cs[ i ];
+
+		auto v = vertices + i * stride;
+		v[ positionsOffset + 0 ] = p[ 0 ];
+		v[ positionsOffset + 1 ] = p[ 1 ];
+		v[ positionsOffset + 2 ] = p[ 2 ];
+		v[ colorsOffset + 0 ] = c[ 0 ];
+		v[ colorsOffset + 1 ] = c[ 1 ];
+		v[ colorsOffset + 2 ] = c[ 2 ];
+		v[ colorsOffset + 3 ] = c[ 3 ];
+		v[ uvsOffset + 0 ] = ss[ i ];
+		v[ uvsOffset + 1 ] = 0.0f;
 	}
 
-	for ( auto i = 0; i < pCount; i++ ) {
-		vbo->setRGBAColorAt( i, cs[ i ] );
-	}
+	_vertices->endStreaming();
 
-    auto ibo = crimild::alloc< IndexBufferObject >( pCount );
-    ibo->generateIncrementalIndices();
-    
-    crimild::concurrency::sync_frame( [this, vbo, ibo] {
-        _primitive->setVertexBuffer( vbo );
-        _primitive->setIndexBuffer( ibo );
-    });
+	_primitive->setIndexCount( pCount );
 }
 
 void PointSpriteParticleRenderer::encode( coding::Encoder &encoder ) 
@@ -33,6 +33,7 @@
 #include "Rendering/Material.hpp"
 #include "SceneGraph/Geometry.hpp"
 #include "Primitives/Primitive.hpp"
+#include "Rendering/StreamingVertexBufferObject.hpp"
 
 namespace crimild {
 
@@ -52,6 +53,7 @@ namespace crimild {
 		MaterialPtr _material;
 		PrimitivePtr _primitive;
 		GeometryPtr _geometry;
+		StreamingVertexBufferObjectPtr _vertices;
 		
 		ParticleAttribArray *_positions = nullptr;
 		ParticleAttribArray *_colors = nullptr;
@@ -26,6 +26,7 @@
  */
 
 #include "AttractorParticleUpdater.hpp"
+#include "ParticleSystem/ParticleKernels.hpp"
 #include "Coding/Encoder.hpp"
 #include "Coding/Decoder.hpp"
 
@@ -50,26 +51,20 @@ void AttractorParticleUpdater::configure( Node *node, ParticleData *particles )
 }
 
 void AttractorParticleUpdater::update( Node *node, crimild::Real64 dt, ParticleData *particles )
+{
+	updateRange( node, dt, particles, 0, particles->getAliveCount() );
+}
+
+void AttractorParticleUpdater::updateRange( Node *node, crimild::Real64 dt, ParticleData *particles, ParticleId begin, ParticleId end )
 {
 	const auto center = _attractor.getCenter();
 	const auto radius = _attractor.getRadius();
-	const auto count = particles->getAliveCount();
-
-	const auto ps = _positions->getData< Vector3f >();
-	auto as = _accelerations->getData< Vector3f >();
-	
-	for ( crimild::Size i = 0; i < count; i++ ) {
-		const auto p = ps[ i ];
-
-		auto direction = center - p;
-		auto d = direction.getMagnitude();
-		if ( d > 0.0 && d <= radius ) {
-			direction /= d;
-			const auto pct = 1.0 - ( d / radius );
-			
-			as[ i ] += dt * pct * _strength * direction;
-		}
-	}
+	const auto count = end - begin;
+
+	const auto ps = _positions->getData< Vector3f >() + begin;
+	auto as = _accelerations->getData< Vector3f >() + begin;
+
+	ParticleKernels::attract( ps, as, center, radius, static_cast< crimild::Real32 >( dt ) * _strength, count );
 }
 
 void AttractorParticleUpdater::encode( coding::Encoder &encoder ) 
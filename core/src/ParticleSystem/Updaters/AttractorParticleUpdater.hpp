@@ -55,6 +55,9 @@ namespace crimild {
 		virtual void configure( Node *node, ParticleData *particles ) override;
         virtual void update( Node *node, crimild::Real64 dt, ParticleData *particles ) override;
 
+		virtual crimild::Bool isRangeUpdateSupported( void ) const override { return true; }
+		virtual void updateRange( Node *node, crimild::Real64 dt, ParticleData *particles, ParticleId begin, ParticleId end ) override;
+
 	private:
 		Sphere3f _attractor;
 		crimild::Real32 _strength;
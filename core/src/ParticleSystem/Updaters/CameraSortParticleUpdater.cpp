@@ -58,28 +58,14 @@ void CameraSortParticleUpdater::update( Node *node, double dt, ParticleData *par
 		node->getWorld().applyInverseToVector( cameraDirection, cameraDirection );
 	}
 
-	const auto pCount = particles->getAliveCount();
-
 	const auto ps = _positions->getData< Vector3f >();
 
 	const auto cameraPlane = Plane3f( cameraDirection, cameraPos );
 
-	// precompute distances to camera plane for each particle
-	containers::Array< double > ds( pCount );
-	for ( crimild::Size i = 0; i < pCount; i++ ) {
-		ds[ i ] = Distance::compute( cameraPlane, ps[ i ] );
-	}
-
-	// sort partices
-	// TODO: I know, bubble sort is slow...
-	for ( int i = 1; i < pCount; i++ ) {
-		for ( int j = 0; j < pCount - i; j++ ) {
-			if ( ds[ j ] < ds[ j + 1 ] ) {
-				particles->swap( j, j + 1 );
-				Numericd::swap( ds[ j ], ds[ j + 1 ] );
-			}
-		}
-	}
+	// farthest particles first
+	_sorter.sort( particles, ParticleSorter::Order::DESCENDING, [ ps, &cameraPlane ]( ParticleId pid ) {
+		return static_cast< crimild::Real32 >( Distance::compute( cameraPlane, ps[ pid ] ) );
+	});
 }
 
 void CameraSortParticleUpdater::encode( coding::Encoder &encoder ) 
@@ -26,6 +26,7 @@
  */
 
 #include "FloorParticleUpdater.hpp"
+#include "ParticleSystem/ParticleKernels.hpp"
 
 using namespace crimild;
 
@@ -46,15 +47,16 @@ void FloorParticleUpdater::configure( Node *node, ParticleData *particles )
 
 void FloorParticleUpdater::update( Node *node, double dt, ParticleData *particles )
 {
-    const auto count = particles->getAliveCount();
+	updateRange( node, dt, particles, 0, particles->getAliveCount() );
+}
+
+void FloorParticleUpdater::updateRange( Node *node, crimild::Real64 dt, ParticleData *particles, ParticleId begin, ParticleId end )
+{
+    const auto count = end - begin;
 
-	auto ps = _positions->getData< Vector3f >();
+	auto ps = _positions->getData< Vector3f >() + begin;
 
-    for ( int i = 0; i < count; i++ ) {
-        if ( ps[ i ].y() < 0.0f ) {
-            ps[ i ].y() = 0.0f;
-        }
-    }
+    ParticleKernels::clampHeight( ps, 0.0f, count );
 }
 
 void FloorParticleUpdater::encode( coding::Encoder &encoder ) 
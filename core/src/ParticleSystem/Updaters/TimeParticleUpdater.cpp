@@ -26,6 +26,7 @@
  */
 
 #include "TimeParticleUpdater.hpp"
+#include "ParticleSystem/ParticleKernels.hpp"
 
 using namespace crimild;
 
@@ -52,10 +53,13 @@ void TimeParticleUpdater::update( Node *node, double dt, ParticleData *particles
 	auto ts = _times->getData< crimild::Real32 >();
 	assert( ts != nullptr );
 
-	for ( int i = 0; i < count; i++ ) {
-		ts[ i ] -= dt;
-		if ( ts[ i ] <= 0.0f ) {
-			particles->kill( i );
+	ParticleKernels::subtract( ts, static_cast< crimild::Real32 >( dt ), count );
+
+	// kill particles in reverse order, since killing one swaps it with
+	// the last alive particle (which has already been checked)
+	for ( auto i = count; i > 0; i-- ) {
+		if ( ts[ i - 1 ] <= 0.0f ) {
+			particles->kill( i - 1 );
 		}
 	}
 }
@@ -48,18 +48,11 @@ void ZSortParticleUpdater::configure( Node *node, ParticleData *particles )
 
 void ZSortParticleUpdater::update( Node *node, double dt, ParticleData *particles )
 {
-	const auto pCount = particles->getAliveCount();
-
 	const auto ps = _positions->getData< Vector3f >();
 
-	// TODO: I know, bubble sort is slow...
-	for ( int i = 1; i < pCount; i++ ) {
-		for ( int j = 0; j < pCount - i; j++ ) {
-			if ( ps[ j ].z() > ps[ j + 1 ].z() ) {
-				particles->swap( j, j + 1 );
-			}
-		}
-	}
+	_sorter.sort( particles, ParticleSorter::Order::ASCENDING, [ ps ]( ParticleId pid ) {
+		return ps[ pid ].z();
+	});
 }
 
 void ZSortParticleUpdater::encode( coding::Encoder &encoder ) 
@@ -29,6 +29,7 @@
 #define CRIMILD_PARTICLE_UPDATER_Z_SORT_
 
 #include "../ParticleSystemComponent.hpp"
+#include "../ParticleSorter.hpp"
 
 namespace crimild {
 
@@ -49,9 +50,18 @@ namespace crimild {
 
         virtual void configure( Node *node, ParticleData *particles ) override;
         virtual void update( Node *node, crimild::Real64 dt, ParticleData *particles ) override;
+
+		/**
+		   \brief Reuse the previous order if it's almost sorted (enabled by default)
+
+		   \see ParticleSorter
+		 */
+		inline void setCoherenceEnabled( crimild::Bool enabled ) { _sorter.setCoherenceEnabled( enabled ); }
+		inline crimild::Bool isCoherenceEnabled( void ) const { return _sorter.isCoherenceEnabled(); }
         
     private:
         ParticleAttribArray *_positions = nullptr;
+		ParticleSorter _sorter;
 
 		/** 
 		 	\name Coding support
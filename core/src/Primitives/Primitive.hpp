@@ -65,10 +65,29 @@ namespace crimild {
         void setIndexBuffer( SharedPointer< IndexBufferObject > const &ibo ) { _indexBuffer = ibo; }
         IndexBufferObject *getIndexBuffer( void ) { return crimild::get_ptr( _indexBuffer ); }
 
+        /**
+            \brief Number of indices to be drawn
+
+            By default, all indices in the index buffer are drawn. Streamed 
+            primitives allocate index buffers for the maximum number of vertices
+            and draw only the ones that are needed every frame.
+         */
+        crimild::UInt32 getIndexCount( void ) const
+        {
+            if ( _indexCountEnabled ) {
+                return _indexCount;
+            }
+            return _indexBuffer != nullptr ? _indexBuffer->getIndexCount() : 0;
+        }
+
+        void setIndexCount( crimild::UInt32 count ) { _indexCount = count; _indexCountEnabled = true; }
+
 	private:
 		Primitive::Type _type;
 		SharedPointer< VertexBufferObject > _vertexBuffer;
 		SharedPointer< IndexBufferObject > _indexBuffer;
+		crimild::UInt32 _indexCount = 0;
+		crimild::Bool _indexCountEnabled = false;
         
         /**
          */
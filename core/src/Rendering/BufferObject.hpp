@@ -60,20 +60,70 @@ namespace crimild {
 
 		}
 
-		inline unsigned int getSize( void ) const { return _data.size() / sizeof( T ); }
+		inline unsigned int getSize( void ) const { return getSizeInBytes() / sizeof( T ); }
         
-        inline unsigned int getSizeInBytes( void ) const { return _data.size(); }
+        inline unsigned int getSizeInBytes( void ) const { return _external.data != nullptr ? _external.size : _data.size(); }
 
-		inline T *data( void ) { return ( T * ) &_data[ 0 ]; }
+		inline T *data( void ) { return ( T * ) getBytes(); }
 
-		inline const T *getData( void ) const { return ( const T * ) &_data[ 0 ]; }
+		inline const T *getData( void ) const { return ( const T * ) getBytes(); }
 
 		inline crimild::Size getUsedCount( void ) const { return getSize(); }
 
-		inline void setUsedCount( crimild::Size count ) { _data.resize( count * sizeof( T ) ); }
+		inline void setUsedCount( crimild::Size count )
+		{
+			if ( _external.data != nullptr && count * sizeof( T ) <= _external.size ) {
+				_external.size = count * sizeof( T );
+				return;
+			}
+
+			detach();
+			_data.resize( count * sizeof( T ) );
+		}
+
+		/**
+			\brief Indicates if data is stored outside this buffer (i.e. in a memory-mapped file)
+		 */
+		inline crimild::Bool isExternal( void ) const { return _external.data != nullptr; }
+
+		/**
+			\brief Use an external block of memory as data, without copying it
+			
+			The blob's storage object is retained by this buffer for as long 
+			as the data is in use. Resizing the buffer will copy the external 
+			data into the buffer's own storage. 
+		 */
+		void setExternalData( coding::Decoder::BlobView const &blob )
+		{
+			_external = blob;
+			_data.clear();
+		}
+
+	private:
+		crimild::Byte *getBytes( void ) const
+		{
+			return _external.data != nullptr ? _external.data : const_cast< crimild::Byte * >( _data.getData() );
+		}
+
+		/**
+			\brief Copies external data (if any) into the buffer's own storage
+		 */
+		void detach( void )
+		{
+			if ( _external.data == nullptr ) {
+				return;
+			}
+
+			_data.resize( _external.size );
+			if ( _external.size > 0 ) {
+				memcpy( _data.getData(), _external.data, _external.size );
+			}
+			_external = coding::Decoder::BlobView();
+		}
 
 	private:
         containers::ByteArray _data;
+        coding::Decoder::BlobView _external;
         
         /**
             name Coding
@@ -84,15 +134,24 @@ namespace crimild {
         virtual void encode( coding::Encoder &encoder ) override
         {
             Codable::encode( encoder );
-            
-            encoder.encode( "data", _data );
+
+            // external data is encoded in place, without detaching it
+            encoder.encodeBytes( "data", getBytes(), getSizeInBytes() );
         }
         
         virtual void decode( coding::Decoder &decoder ) override
         {
             Codable::decode( decoder );
-            
-            decoder.decode( "data", _data );
+
+            // try to avoid copying large buffers if possible
+            coding::Decoder::BlobView blob;
+            if ( decoder.decodeBlob( "data", blob ) ) {
+                setExternalData( blob );
+            }
+            else {
+                _external = coding::Decoder::BlobView();
+                decoder.decode( "data", _data );
+            }
         }
         
         //@}
@@ -115,13 +174,13 @@ namespace crimild {
 		{
 			StreamObject::save( s );
 
-			unsigned int size = _data.size();
+			unsigned int size = getSizeInBytes();
 			s.write( size );
             
 			s.write( size ); // used count
 			
 			if ( size > 0 ) {
-				s.writeRawBytes( &_data[ 0 ], size );
+				s.writeRawBytes( getBytes(), size );
 			}
 		}
 
@@ -136,6 +195,8 @@ namespace crimild {
 				s.read( size );
 			}
 
+			_external = coding::Decoder::BlobView();
+
 			if ( size > 0 ) {
 				_data.resize( size );
 				s.readRawBytes( &_data[ 0 ], size );
@@ -58,6 +58,7 @@ void Image::setData( int width, int height, int bpp, const unsigned char *data,
 	_height = height;
 	_bpp = bpp;
     _pixelFormat = format;
+	_external = coding::Decoder::BlobView();
 
 	int size = _width * _height * _bpp;
 	if ( size > 0 ) {
@@ -86,6 +87,7 @@ void Image::unload( void )
 	_height = 0;
 	_bpp = 0;
     _data.resize( 0 );
+	_external = coding::Decoder::BlobView();
 }
 
 void Image::encode( coding::Encoder &encoder )
@@ -95,7 +97,14 @@ void Image::encode( coding::Encoder &encoder )
 	encoder.encode( "width", _width );
 	encoder.encode( "height", _height );
 	encoder.encode( "bpp", _bpp );
-    encoder.encode( "data", _data );
+
+	if ( _external.data != nullptr ) {
+		// pixels are not owned by this image
+		encoder.encodeBytes( "data", _external.data, _external.size );
+	}
+	else {
+		encoder.encode( "data", _data );
+	}
 }
 
 void Image::decode( coding::Decoder &decoder )
@@ -105,7 +114,17 @@ void Image::decode( coding::Decoder &decoder )
 	decoder.decode( "width", _width );
 	decoder.decode( "height", _height );
 	decoder.decode( "bpp", _bpp );
-	decoder.decode( "data", _data );
+
+	// try to avoid copying pixels if possible
+	coding::Decoder::BlobView blob;
+	if ( decoder.decodeBlob( "data", blob ) ) {
+		_external = blob;
+		_data.resize( 0 );
+	}
+	else {
+		_external = coding::Decoder::BlobView();
+		decoder.decode( "data", _data );
+	}
 }
 
 bool Image::registerInStream( Stream &s )
@@ -124,7 +143,7 @@ void Image::save( Stream &s )
 	s.write( _width );
 	s.write( _height );
 	s.write( _bpp );
-	s.writeRawBytes( &_data[ 0 ], _width * _height * _bpp * sizeof( unsigned char ) );
+	s.writeRawBytes( getData(), _width * _height * _bpp * sizeof( unsigned char ) );
 }
 
 void Image::load( Stream &s )
@@ -134,6 +153,7 @@ void Image::load( Stream &s )
 	s.read( _width );
 	s.read( _height );
 	s.read( _bpp );
+	_external = coding::Decoder::BlobView();
 	_data.resize( _width * _height * _bpp );
 	s.readRawBytes( &_data[ 0 ], _data.size() * sizeof( unsigned char ) );
 }
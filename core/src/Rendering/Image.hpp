@@ -31,6 +31,7 @@
 #include "Foundation/Containers/Array.hpp"
 #include "Streaming/Stream.hpp"
 #include "Coding/Codable.hpp"
+#include "Coding/Decoder.hpp"
 
 #include <vector>
 
@@ -56,12 +57,17 @@ namespace crimild {
 		int getHeight( void ) const { return _height; }
 		int getBpp( void ) const { return _bpp; }
         PixelFormat getPixelFormat( void ) const { return _pixelFormat; }
-		unsigned char *getData( void ) { return &_data[ 0 ]; }
-		const unsigned char *getData( void ) const { return &_data[ 0 ]; }
+		unsigned char *getData( void ) { return _external.data != nullptr ? _external.data : &_data[ 0 ]; }
+		const unsigned char *getData( void ) const { return _external.data != nullptr ? _external.data : &_data[ 0 ]; }
 
 		void setData( int width, int height, int bpp, const unsigned char *data, PixelFormat format = PixelFormat::RGBA );
 
-		bool isLoaded( void ) const { return _data.size() > 0; }
+		/**
+			\brief Indicates if pixels are stored outside this image (i.e. in a memory-mapped file)
+		*/
+		bool isExternal( void ) const { return _external.data != nullptr; }
+
+		bool isLoaded( void ) const { return _data.size() > 0 || _external.size > 0; }
 		virtual void load( void );
 		virtual void unload( void );
 
@@ -72,6 +78,11 @@ namespace crimild {
         PixelFormat _pixelFormat;
         containers::ByteArray _data;
 
+		/**
+			\brief Pixel data owned by a decoder's storage, if any
+		*/
+		coding::Decoder::BlobView _external;
+
 		/**
             \name Coding support
          */
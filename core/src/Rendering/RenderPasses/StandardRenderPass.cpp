@@ -93,26 +93,40 @@ void StandardRenderPass::renderOccluders( Renderer *renderer, RenderQueue *rende
     if ( renderables->size() == 0 ) {
         return;
     }
+
+    // occluders are sorted by state, so programs are only
+    // bound when they change
+    ShaderProgram *currentProgram = nullptr;
+    Material *currentMaterial = nullptr;
     
-    renderQueue->each( renderables, [this, renderer, renderQueue]( RenderQueue::Renderable *renderable ) {
+    renderQueue->each( renderables, [ this, renderer, renderQueue, &currentProgram, &currentMaterial ]( RenderQueue::Renderable *renderable ) {
         auto material = crimild::get_ptr( renderable->material );
         auto program = material->getProgram();
         if ( program == nullptr ) {
             program = getStandardProgram();
         }
+
+        // a material is only unbound once all objects using it have been rendered
+        auto materialChanged = material != currentMaterial;
+        if ( materialChanged && currentMaterial != nullptr ) {
+            renderer->unbindMaterial( currentProgram, currentMaterial );
+        }
+
+        if ( program != currentProgram ) {
+            if ( currentProgram != nullptr ) {
+                renderer->unbindProgram( currentProgram );
+            }
+
+            bindProgram( renderer, renderQueue, program );
+            currentProgram = program;
+        }
         
-        renderer->bindProgram( program );
-        
-        auto projection = renderQueue->getProjectionMatrix();
-        renderer->bindUniform( program->getStandardLocation( ShaderProgram::StandardLocation::PROJECTION_MATRIX_UNIFORM ), projection );
-        
-        auto view = renderQueue->getViewMatrix();
-        renderer->bindUniform( program->getStandardLocation( ShaderProgram::StandardLocation::VIEW_MATRIX_UNIFORM ), view );
-        
-        renderStandardGeometry( renderer, crimild::get_ptr( renderable->geometry ), program, material, renderable->modelTransform );
-        
-        renderer->unbindProgram( program );
+        renderStandardGeometry( renderer, crimild::get_ptr( renderable->geometry ), program, materialChanged ? material : nullptr, renderable->modelTransform );
+        currentMaterial = material;
     });
+
+    renderer->unbindMaterial( currentProgram, currentMaterial );
+    renderer->unbindProgram( currentProgram );
 }
 
 void StandardRenderPass::renderOpaqueObjects( Renderer *renderer, RenderQueue *renderQueue, Camera *camera )
@@ -123,82 +137,44 @@ void StandardRenderPass::renderOpaqueObjects( Renderer *renderer, RenderQueue *r
     if ( renderables->size() == 0 ) {
         return;
     }
+
+    // opaque objects are sorted by state, so programs (along with 
+    // lights and shadow maps) are only bound when they change
+    ShaderProgram *currentProgram = nullptr;
+    Material *currentMaterial = nullptr;
     
-    renderQueue->each( renderables, [this, renderer, renderQueue]( RenderQueue::Renderable *renderable ) {
+    renderQueue->each( renderables, [ this, renderer, renderQueue, &currentProgram, &currentMaterial ]( RenderQueue::Renderable *renderable ) {
         auto material = crimild::get_ptr( renderable->material );
         auto program = material->getProgram();
         if ( program == nullptr ) {
             program = getStandardProgram();
         }
-        
-        renderer->bindProgram( program );
-        
-        auto projection = renderQueue->getProjectionMatrix();
-        renderer->bindUniform( program->getStandardLocation( ShaderProgram::StandardLocation::PROJECTION_MATRIX_UNIFORM ), projection );
-        
-        auto view = renderQueue->getViewMatrix();
-        renderer->bindUniform( program->getStandardLocation( ShaderProgram::StandardLocation::VIEW_MATRIX_UNIFORM ), view );
-        
-        renderer->bindUniform( program->getStandardLocation( ShaderProgram::StandardLocation::USE_SHADOW_MAP_UNIFORM ), false );
-        if ( isShadowMappingEnabled() ) {
-            renderQueue->each( [ this, renderer, program, renderQueue ]( Light *light, int ) {        
-                if ( !light->castShadows() ) {
-                    return;
-                }
-
-                auto map = light->getShadowMap();
-                if ( map == nullptr ) {
-                    return;
-                }
-
-                if ( map->getTexture() == nullptr || map->getTexture()->getCatalog() == nullptr ) {
-                    return;
-                }
-
-                renderer->bindUniform( program->getStandardLocation( ShaderProgram::StandardLocation::USE_SHADOW_MAP_UNIFORM ), true );
-                renderer->bindUniform( program->getStandardLocation( ShaderProgram::StandardLocation::LIGHT_SOURCE_PROJECTION_MATRIX_UNIFORM ), map->getLightProjectionMatrix() );
-                renderer->bindUniform( program->getStandardLocation( ShaderProgram::StandardLocation::LIGHT_SOURCE_VIEW_MATRIX_UNIFORM ), map->getLightViewMatrix() );
-                renderer->bindTexture( program->getStandardLocation( ShaderProgram::StandardLocation::SHADOW_MAP_UNIFORM ), map->getTexture() );
-                renderer->bindUniform( program->getStandardLocation( ShaderProgram::StandardLocation::SHADOW_MAP_BIAS_UNIFORM ), map->getBias() );
-                renderer->bindUniform( program->getStandardLocation( ShaderProgram::StandardLocation::SHADOW_MAP_OFFSET_UNIFORM ), map->getOffset() );
-            });
-        }
-        
-        if ( isLightingEnabled() ) {
-            renderQueue->each( [renderer, program]( Light *light, int ) {
-                renderer->bindLight( program, light );
-            });
-        }
-        
-        renderStandardGeometry( renderer, crimild::get_ptr( renderable->geometry ), program, material, renderable->modelTransform );
-        
-        if ( isLightingEnabled() ) {
-            renderQueue->each( [ renderer, program ]( Light *light, int ) {
-                renderer->unbindLight( program, light );
-            });
+
+        // a material is only unbound once all objects using it have been rendered
+        auto materialChanged = material != currentMaterial;
+        if ( materialChanged && currentMaterial != nullptr ) {
+            renderer->unbindMaterial( currentProgram, currentMaterial );
         }
-        
-        if ( isShadowMappingEnabled() ) {
-            renderQueue->each( [ this, renderer, program, renderQueue ]( Light *light, int ) {        
-                if ( !light->castShadows() ) {
-                    return;
-                }
-
-                auto map = light->getShadowMap();
-                if ( map == nullptr ) {
-                    return;
-                }
-
-                if ( map->getTexture() == nullptr || map->getTexture()->getCatalog() == nullptr ) {
-                    return;
-                }
-
-                renderer->unbindTexture( program->getStandardLocation( ShaderProgram::StandardLocation::SHADOW_MAP_UNIFORM ), map->getTexture() );
-            });
+
+        if ( program != currentProgram ) {
+            if ( currentProgram != nullptr ) {
+                unbindLights( renderer, renderQueue, currentProgram );
+                renderer->unbindProgram( currentProgram );
+            }
+
+            bindProgram( renderer, renderQueue, program );
+            bindLights( renderer, renderQueue, program );
+            currentProgram = program;
         }
         
-        renderer->unbindProgram( program );
+        renderStandardGeometry( renderer, crimild::get_ptr( renderable->geometry ), program, materialChanged ? material : nullptr, renderable->modelTransform );
+        currentMaterial = material;
     });
+
+    renderer->unbindMaterial( currentProgram, currentMaterial );
+
+    unbindLights( renderer, renderQueue, currentProgram );
+    renderer->unbindProgram( currentProgram );
 }
 
 void StandardRenderPass::renderTranslucentObjects( Renderer *renderer, RenderQueue *renderQueue, Camera *camera )
@@ -209,26 +185,105 @@ void StandardRenderPass::renderTranslucentObjects( Renderer *renderer, RenderQue
     if ( renderables->size() == 0 ) {
         return;
     }
+
+    // translucent objects are sorted back-to-front, but consecutive 
+    // objects might still share the same program
+    ShaderProgram *currentProgram = nullptr;
     
-    renderQueue->each( renderables, [this, renderer, renderQueue]( RenderQueue::Renderable *renderable ) {
+    renderQueue->each( renderables, [ this, renderer, renderQueue, &currentProgram ]( RenderQueue::Renderable *renderable ) {
         auto material = crimild::get_ptr( renderable->material );
         auto program = material->getProgram();
         if ( program == nullptr ) {
             program = getStandardProgram();
         }
-        
-        renderer->bindProgram( program );
-        
-        auto projection = renderQueue->getProjectionMatrix();
-        renderer->bindUniform( program->getStandardLocation( ShaderProgram::StandardLocation::PROJECTION_MATRIX_UNIFORM ), projection );
-        
-        auto view = renderQueue->getViewMatrix();
-        renderer->bindUniform( program->getStandardLocation( ShaderProgram::StandardLocation::VIEW_MATRIX_UNIFORM ), view );
+
+        if ( program != currentProgram ) {
+            if ( currentProgram != nullptr ) {
+                renderer->unbindProgram( currentProgram );
+            }
+
+            bindProgram( renderer, renderQueue, program );
+            currentProgram = program;
+        }
         
         renderStandardGeometry( renderer, crimild::get_ptr( renderable->geometry ), program, material, renderable->modelTransform );
-        
-        renderer->unbindProgram( program );
+        renderer->unbindMaterial( program, material );
     });
+
+    renderer->unbindProgram( currentProgram );
+}
+
+void StandardRenderPass::bindProgram( Renderer *renderer, RenderQueue *renderQueue, ShaderProgram *program )
+{
+    renderer->bindProgram( program );
+    
+    auto projection = renderQueue->getProjectionMatrix();
+    renderer->bindUniform( program->getStandardLocation( ShaderProgram::StandardLocation::PROJECTION_MATRIX_UNIFORM ), projection );
+    
+    auto view = renderQueue->getViewMatrix();
+    renderer->bindUniform( program->getStandardLocation( ShaderProgram::StandardLocation::VIEW_MATRIX_UNIFORM ), view );
+}
+
+void StandardRenderPass::bindLights( Renderer *renderer, RenderQueue *renderQueue, ShaderProgram *program )
+{
+    renderer->bindUniform( program->getStandardLocation( ShaderProgram::StandardLocation::USE_SHADOW_MAP_UNIFORM ), false );
+    if ( isShadowMappingEnabled() ) {
+        renderQueue->each( [ renderer, program ]( Light *light, int ) {        
+            if ( !light->castShadows() ) {
+                return;
+            }
+
+            auto map = light->getShadowMap();
+            if ( map == nullptr ) {
+                return;
+            }
+
+            if ( map->getTexture() == nullptr || map->getTexture()->getCatalog() == nullptr ) {
+                return;
+            }
+
+            renderer->bindUniform( program->getStandardLocation( ShaderProgram::StandardLocation::USE_SHADOW_MAP_UNIFORM ), true );
+            renderer->bindUniform( program->getStandardLocation( ShaderProgram::StandardLocation::LIGHT_SOURCE_PROJECTION_MATRIX_UNIFORM ), map->getLightProjectionMatrix() );
+            renderer->bindUniform( program->getStandardLocation( ShaderProgram::StandardLocation::LIGHT_SOURCE_VIEW_MATRIX_UNIFORM ), map->getLightViewMatrix() );
+            renderer->bindTexture( program->getStandardLocation( ShaderProgram::StandardLocation::SHADOW_MAP_UNIFORM ), map->getTexture() );
+            renderer->bindUniform( program->getStandardLocation( ShaderProgram::StandardLocation::SHADOW_MAP_BIAS_UNIFORM ), map->getBias() );
+            renderer->bindUniform( program->getStandardLocation( ShaderProgram::StandardLocation::SHADOW_MAP_OFFSET_UNIFORM ), map->getOffset() );
+        });
+    }
+    
+    if ( isLightingEnabled() ) {
+        renderQueue->each( [ renderer, program ]( Light *light, int ) {
+            renderer->bindLight( program, light );
+        });
+    }
+}
+
+void StandardRenderPass::unbindLights( Renderer *renderer, RenderQueue *renderQueue, ShaderProgram *program )
+{
+    if ( isLightingEnabled() ) {
+        renderQueue->each( [ renderer, program ]( Light *light, int ) {
+            renderer->unbindLight( program, light );
+        });
+    }
+    
+    if ( isShadowMappingEnabled() ) {
+        renderQueue->each( [ renderer, program ]( Light *light, int ) {        
+            if ( !light->castShadows() ) {
+                return;
+            }
+
+            auto map = light->getShadowMap();
+            if ( map == nullptr ) {
+                return;
+            }
+
+            if ( map->getTexture() == nullptr || map->getTexture()->getCatalog() == nullptr ) {
+                return;
+            }
+
+            renderer->unbindTexture( program->getStandardLocation( ShaderProgram::StandardLocation::SHADOW_MAP_UNIFORM ), map->getTexture() );
+        });
+    }
 }
 
 void StandardRenderPass::renderStandardGeometry( Renderer *renderer, Geometry *geometry, ShaderProgram *program, Material *material, const Matrix4f &modelTransform )
@@ -274,9 +329,5 @@ void StandardRenderPass::renderStandardGeometry( Renderer *renderer, Geometry *g
         renderer->unbindVertexBuffer( program, vbo );
         renderer->unbindIndexBuffer( program, ibo );
     });
-    
-    if ( material != nullptr ) {
-        renderer->unbindMaterial( program, material );
-    }
 }
 
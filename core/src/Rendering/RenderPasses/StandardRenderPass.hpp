@@ -56,8 +56,23 @@ namespace crimild {
         virtual void renderOpaqueObjects( Renderer *renderer, RenderQueue *renderQueue, Camera *camera );
         virtual void renderTranslucentObjects( Renderer *renderer, RenderQueue *renderQueue, Camera *camera );
         
+        /**
+            \brief Binds the model matrix and, if not null, the material
+
+            The material is not unbound, so it can be shared by consecutive
+            objects. Callers must unbind it once it changes.
+         */
         void renderStandardGeometry( Renderer *renderer, Geometry *geometry, ShaderProgram *program, Material *material, const Matrix4f &modelTransform );
 
+    private:
+        /**
+            \brief Binds a program along with the camera matrices
+         */
+        void bindProgram( Renderer *renderer, RenderQueue *renderQueue, ShaderProgram *program );
+
+        void bindLights( Renderer *renderer, RenderQueue *renderQueue, ShaderProgram *program );
+        void unbindLights( Renderer *renderer, RenderQueue *renderQueue, ShaderProgram *program );
+
     protected:
         inline ShaderProgram *getStandardProgram( void );
 
@@ -31,6 +31,42 @@
 
 using namespace crimild;
 
+namespace crimild {
+
+    namespace internal {
+
+        /*
+            Sort key layout (from highest to lowest bits):
+
+            - State sorted (occluders, opaque):
+                [type:3][program:14][texture:14][material:14][depth:19]
+            - Depth sorted (shadow casters, translucent, screen):
+                [type:3][depth:32][unused:29]
+         */
+        static const crimild::UInt64 SORT_KEY_TYPE_SHIFT = 61;
+        static const crimild::UInt64 SORT_KEY_PROGRAM_SHIFT = 47;
+        static const crimild::UInt64 SORT_KEY_TEXTURE_SHIFT = 33;
+        static const crimild::UInt64 SORT_KEY_MATERIAL_SHIFT = 19;
+        static const crimild::UInt64 SORT_KEY_STATE_BITS = 14;
+        static const crimild::UInt64 SORT_KEY_STATE_DEPTH_BITS = 19;
+        static const crimild::UInt64 SORT_KEY_DEPTH_SHIFT = 29;
+
+        /**
+            \brief Maps a pointer into a small id used for state sorting
+
+            Different objects may end up with the same id, which only
+            costs an additional state change. Null pointers always map to zero.
+         */
+        static crimild::UInt64 sortKeyId( const void *ptr )
+        {
+            auto value = static_cast< crimild::UInt64 >( reinterpret_cast< uintptr_t >( ptr ) ) >> 4;
+            return ( value * 0x9E3779B97F4A7C15ull ) >> ( 64 - SORT_KEY_STATE_BITS );
+        }
+
+    }
+
+}
+
 RenderQueue::RenderQueue( void )
 {
     setTimestamp( ( unsigned long ) std::chrono::duration_cast< std::chrono::milliseconds >( std::chrono::system_clock::now().time_since_epoch() ).count() );
@@ -45,12 +81,17 @@ void RenderQueue::reset( void )
 {
     setCamera( nullptr );
 
+    // clearing vectors does not release their memory, so
+    // the same queue can be filled again without allocations
     _lights.clear();
+    _renderables.clear();
+    _keys.clear();
+    _indices.clear();
 
-    for ( auto &it : _renderables ) {
-        it.second.clear();
+    for ( auto &range : _ranges ) {
+        range = Renderables();
     }
-    _renderables.clear();
+    _sorted = true;
 }
 
 void RenderQueue::setCamera( Camera *camera )
@@ -74,13 +115,29 @@ void RenderQueue::push( Geometry *geometry )
         return;
     }
     
-    bool renderOnScreen = rs->renderOnScreen();
+    // shared by all materials. Keep the lambda's capture small
+    // so std::function does not need to allocate memory for it
+    struct {
+        RenderQueue::Renderable renderable;
+        bool renderOnScreen;
+    } context = {
+        RenderQueue::Renderable {
+            crimild::retain( geometry ),
+            nullptr,
+            
+            geometry->getWorld().computeModelMatrix(),
+            
+            // we use the squared distance to avoid performance penalties
+            Distance::computeSquared( geometry->getWorld().getTranslate(), getCamera()->getWorld().getTranslate() ),
+        },
+        rs->renderOnScreen(),
+    };
     
-    rs->forEachMaterial( [this, geometry, renderOnScreen]( Material *material ) {
+    rs->forEachMaterial( [ this, &context ]( Material *material ) {
         auto renderableType = RenderQueue::RenderableType::OPAQUE;
         bool castShadows = false;
         
-        if ( renderOnScreen ) {
+        if ( context.renderOnScreen ) {
             renderableType = RenderQueue::RenderableType::SCREEN;
         }
         else if ( material->getColorMaskState()->isEnabled() &&
@@ -100,69 +157,123 @@ void RenderQueue::push( Geometry *geometry )
             castShadows = material->castShadows();
             renderableType = RenderQueue::RenderableType::OPAQUE;
         }
-        
-        auto renderable = RenderQueue::Renderable {
-            crimild::retain( geometry ),
-            crimild::retain( material ),
-            
-            geometry->getWorld().computeModelMatrix(),
-            
-            // we use the squared distance to avoid performance penalties
-            Distance::computeSquared( geometry->getWorld().getTranslate(), getCamera()->getWorld().getTranslate() ),
-        };
-        
-        auto queue = &_renderables[ renderableType ];
-        
-        if ( renderableType == RenderQueue::RenderableType::TRANSLUCENT ) {
-            // order BACK_TO_FRONT for translucent objects
-            auto it = queue->begin();
-            while ( it != queue->end() && ( *it ).distanceFromCamera >= renderable.distanceFromCamera ) {
-                it++;
-            }
-            queue->insert( it, renderable );
-        }
-        else {
-            // order FRONT_TO_BACK for everything else
-            auto it = queue->begin();
-            while ( it != queue->end() && ( *it ).distanceFromCamera <= renderable.distanceFromCamera ) {
-                it++;
-            }
-            queue->insert( it, renderable );
-        }
+
+        auto renderableIndex = _renderables.size();
+        _renderables.push_back( context.renderable );
+        _renderables.back().material = crimild::retain( material );
+
+        push( renderableType, renderableIndex );
         
         if ( castShadows ) {
             // if the geometry is supposed to cast shadows, we also add it to that queue
-            // order FRONT_TO_BACK
-            auto casters = &_renderables[ RenderQueue::RenderableType::SHADOW_CASTER ];
-            auto it = casters->begin();
-            while ( it != casters->end() && ( *it ).distanceFromCamera <= renderable.distanceFromCamera ) {
-                it++;
-            }
-            casters->insert( it, renderable );
+            push( RenderQueue::RenderableType::SHADOW_CASTER, renderableIndex );
         }
     });
 }
 
+void RenderQueue::push( RenderableType type, crimild::Size renderableIndex )
+{
+    const auto &renderable = _renderables[ renderableIndex ];
+
+    auto typeBits = static_cast< crimild::UInt64 >( type ) << internal::SORT_KEY_TYPE_SHIFT;
+    crimild::UInt64 depth = radixSortKey( static_cast< crimild::Real32 >( renderable.distanceFromCamera ) );
+
+    crimild::UInt64 key = 0;
+    switch ( type ) {
+        case RenderableType::OCCLUDER:
+        case RenderableType::OPAQUE: {
+            // minimize state changes first, then order FRONT_TO_BACK
+            auto material = crimild::get_ptr( renderable.material );
+            key = typeBits
+                | ( internal::sortKeyId( material->getProgram() ) << internal::SORT_KEY_PROGRAM_SHIFT )
+                | ( internal::sortKeyId( material->getColorMap() ) << internal::SORT_KEY_TEXTURE_SHIFT )
+                | ( internal::sortKeyId( material ) << internal::SORT_KEY_MATERIAL_SHIFT )
+                | ( depth >> ( 32 - internal::SORT_KEY_STATE_DEPTH_BITS ) );
+            break;
+        }
+
+        case RenderableType::TRANSLUCENT:
+            // order BACK_TO_FRONT for translucent objects
+            key = typeBits | ( ( ~depth & 0xFFFFFFFF ) << internal::SORT_KEY_DEPTH_SHIFT );
+            break;
+
+        default:
+            // order FRONT_TO_BACK for everything else
+            key = typeBits | ( depth << internal::SORT_KEY_DEPTH_SHIFT );
+            break;
+    }
+
+    _keys.push_back( key );
+    _indices.push_back( static_cast< crimild::UInt32 >( renderableIndex ) );
+    _sorted = false;
+}
+
 void RenderQueue::push( Light *light )
 {
     _lights.push_back( crimild::retain( light ) );
 }
 
+void RenderQueue::append( RenderQueue *other )
+{
+    auto offset = static_cast< crimild::UInt32 >( _renderables.size() );
+
+    _lights.insert( _lights.end(), other->_lights.begin(), other->_lights.end() );
+    _renderables.insert( _renderables.end(), other->_renderables.begin(), other->_renderables.end() );
+    _keys.insert( _keys.end(), other->_keys.begin(), other->_keys.end() );
+    for ( auto index : other->_indices ) {
+        _indices.push_back( offset + index );
+    }
+
+    if ( !other->_keys.empty() ) {
+        _sorted = false;
+    }
+}
+
+void RenderQueue::sort( void )
+{
+    if ( _sorted ) {
+        return;
+    }
+
+    // the radix sort is stable, so objects at the same depth
+    // are kept in the same order they were pushed
+    _radixSort.sort( _keys, _indices );
+
+    // keys are sorted by type first, so each type is a contiguous range
+    crimild::Size counts[ RENDERABLE_TYPE_COUNT ] = { 0 };
+    for ( auto key : _keys ) {
+        ++counts[ key >> internal::SORT_KEY_TYPE_SHIFT ];
+    }
+
+    crimild::Size offset = 0;
+    for ( crimild::Size i = 0; i < RENDERABLE_TYPE_COUNT; i++ ) {
+        _ranges[ i ]._begin = offset;
+        offset += counts[ i ];
+        _ranges[ i ]._end = offset;
+    }
+
+    _sorted = true;
+}
+
+RenderQueue::Renderables *RenderQueue::getRenderables( RenderableType type )
+{
+    sort();
+    return &_ranges[ static_cast< crimild::Size >( type ) ];
+}
+
 void RenderQueue::each( Renderables *renderables, std::function< void( Renderable * ) > callback )
 {
-    for ( auto &r : *renderables ) {
-        callback( &r );
+    for ( auto i = renderables->_begin; i < renderables->_end; i++ ) {
+        callback( &_renderables[ _indices[ i ] ] );
     }
 }
 
 void RenderQueue::each( std::function< void ( Light *, int ) > callback )
 {
-    auto lights = _lights;
     int i = 0;
-    for ( auto l : lights ) {
+    for ( auto &l : _lights ) {
         if ( l->isEnabled() ) {
             callback( crimild::get_ptr( l ), i++ );
         }
     }
 }
-
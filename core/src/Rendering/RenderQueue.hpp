@@ -29,6 +29,7 @@
 #define CRIMILD_CORE_RENDERING_RENDER_QUEUE_
 
 #include "Foundation/SharedObject.hpp"
+#include "Foundation/RadixSort.hpp"
 #include "Foundation/Containers/Array.hpp"
 
 #include "SceneGraph/Geometry.hpp"
@@ -47,6 +48,23 @@ namespace crimild {
 
     using RenderQueuePtr = SharedPointer< RenderQueue >;
 
+    /**
+        \brief Sorted list of objects to be rendered by a camera
+
+        Renderables are stored in a single contiguous array along with a
+        64-bit sort key for each of them. Keys encode the renderable type 
+        (pass) in the highest bits, so once sorted every type is a 
+        contiguous range:
+        
+        - Occluders and opaque objects are sorted by state 
+          (shader program, texture, material) first and then front-to-back
+        - Shadow casters and screen objects are sorted front-to-back
+        - Translucent objects are sorted back-to-front
+
+        Queues are meant to be reused between frames. Calling reset() 
+        does not free any memory, so computing a queue for a scene of 
+        a similar size does not allocate at all.
+     */
     class RenderQueue : public SharedObject {
     public:
         struct Renderable {
@@ -63,8 +81,23 @@ namespace crimild {
             TRANSLUCENT,
             SCREEN, // deprecated
         };
-        
-        using Renderables = std::list< Renderable >;
+
+        static constexpr crimild::Size RENDERABLE_TYPE_COUNT = 5;
+
+        /**
+            \brief A range of sorted renderables with the same type
+         */
+        class Renderables {
+            friend class RenderQueue;
+
+        public:
+            crimild::Size size( void ) const { return _end - _begin; }
+            bool empty( void ) const { return _begin == _end; }
+
+        private:
+            crimild::Size _begin = 0;
+            crimild::Size _end = 0;
+        };
 
     public:
         explicit RenderQueue( void );
@@ -82,11 +115,32 @@ namespace crimild {
         void push( Geometry *geometry );
         void push( Light *light );
 
-        Renderables *getRenderables( RenderableType type ) { return &_renderables[ type ]; }
+        /**
+            \brief Appends all renderables and lights from another queue
+
+            Used for merging partial queues computed in parallel, which must
+            use the same camera. Sorting is stable, so appending partial queues
+            in traversal order gives the same result as pushing everything 
+            into a single queue.
+         */
+        void append( RenderQueue *other );
+
+        /**
+            \brief Sorts all renderables pushed since the last reset
+
+            Called automatically when accessing renderables. Use it to
+            control in which thread the sorting takes place.
+         */
+        void sort( void );
+
+        Renderables *getRenderables( RenderableType type );
         
         void each( Renderables *renderables, std::function< void( Renderable * ) > callback );
         void each( std::function< void( Light *, int ) > callback );
 
+    private:
+        void push( RenderableType type, crimild::Size renderableIndex );
+
     private:
         SharedPointer< Camera > _camera;
         
@@ -95,7 +149,21 @@ namespace crimild {
         
         std::vector< SharedPointer< Light >> _lights;
 
-        std::map< RenderableType, Renderables > _renderables;
+        std::vector< Renderable > _renderables;
+
+        /**
+            \brief Sort keys and the renderable each of them refers to
+
+            A renderable may be referenced by more than one key (i.e. 
+            opaque objects that also cast shadows)
+         */
+        std::vector< crimild::UInt64 > _keys;
+        std::vector< crimild::UInt32 > _indices;
+
+        RadixSort< crimild::UInt64, crimild::UInt32 > _radixSort;
+
+        Renderables _ranges[ RENDERABLE_TYPE_COUNT ];
+        bool _sorted = true;
         
     public:
         unsigned long getTimestamp( void ) const { return _timestamp; }
@@ -116,4 +184,3 @@ namespace crimild {
 }
 
 #endif
-
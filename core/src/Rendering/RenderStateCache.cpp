@@ -0,0 +1,282 @@
+/*
+ * Copyright (c) 2013, Hernan Saez
+ * All rights reserved.
+ * 
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *     * Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in the
+ *       documentation and/or other materials provided with the distribution.
+ *     * Neither the name of the <organization> nor the
+ *       names of its contributors may be used to endorse or promote products
+ *       derived from this software without specific prior written permission.
+ * 
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL <COPYRIGHT HOLDER> BE LIABLE FOR ANY
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "RenderStateCache.hpp"
+
+#include <cstring>
+
+using namespace crimild;
+
+constexpr crimild::Size RenderStateCache::CALL_TYPE_COUNT;
+constexpr crimild::UInt32 RenderStateCache::UNKNOWN;
+constexpr crimild::Int32 RenderStateCache::MAX_CACHED_UNIFORM_LOCATION;
+constexpr crimild::Size RenderStateCache::MAX_CACHED_UNIFORM_SIZE;
+
+RenderStateCache::RenderStateCache( void )
+{
+    invalidateAll();
+    resetCounters();
+}
+
+RenderStateCache::~RenderStateCache( void )
+{
+
+}
+
+void RenderStateCache::invalidate( void )
+{
+    _program = UNKNOWN;
+    _boundUniforms = nullptr;
+
+    _activeTextureUnit = UNKNOWN;
+    for ( auto &texture : _textures ) {
+        texture = UNKNOWN;
+    }
+
+    _vertexArray = UNKNOWN;
+    _vertexBuffer = UNKNOWN;
+    _indexBuffer = UNKNOWN;
+
+    _blendEnabled = UNKNOWN;
+    _blendSrcFunc = UNKNOWN;
+    _blendDstFunc = UNKNOWN;
+
+    _depthTestEnabled = UNKNOWN;
+    _depthFunc = UNKNOWN;
+    _depthMask = UNKNOWN;
+
+    _cullFaceEnabled = UNKNOWN;
+    _cullFaceMode = UNKNOWN;
+
+    _colorMask = UNKNOWN;
+}
+
+void RenderStateCache::invalidateAll( void )
+{
+    invalidate();
+    _uniforms.clear();
+}
+
+bool RenderStateCache::update( CallType type, crimild::UInt32 &current, crimild::UInt32 value )
+{
+    if ( current == value ) {
+        return filter( type );
+    }
+
+    current = value;
+    return issue( type );
+}
+
+bool RenderStateCache::bindProgram( crimild::UInt32 programId )
+{
+    if ( !update( CallType::PROGRAM, _program, programId ) ) {
+        return false;
+    }
+
+    _boundUniforms = &_uniforms[ programId ];
+    return true;
+}
+
+void RenderStateCache::invalidateProgram( crimild::UInt32 programId )
+{
+    _uniforms.erase( programId );
+
+    if ( _program == programId ) {
+        _program = UNKNOWN;
+        _boundUniforms = nullptr;
+    }
+}
+
+bool RenderStateCache::setActiveTextureUnit( crimild::UInt32 unit )
+{
+    if ( !update( CallType::TEXTURE, _activeTextureUnit, unit ) ) {
+        return false;
+    }
+
+    if ( unit >= _textures.size() ) {
+        _textures.resize( unit + 1, UNKNOWN );
+    }
+
+    return true;
+}
+
+bool RenderStateCache::bindTexture( crimild::UInt32 textureId )
+{
+    if ( _activeTextureUnit == UNKNOWN ) {
+        return issue( CallType::TEXTURE );
+    }
+
+    return update( CallType::TEXTURE, _textures[ _activeTextureUnit ], textureId );
+}
+
+crimild::UInt32 RenderStateCache::getBoundTexture( crimild::UInt32 unit ) const
+{
+    return unit < _textures.size() ? _textures[ unit ] : UNKNOWN;
+}
+
+void RenderStateCache::invalidateTexture( crimild::UInt32 textureId )
+{
+    for ( auto &texture : _textures ) {
+        if ( texture == textureId ) {
+            texture = 0;
+        }
+    }
+}
+
+bool RenderStateCache::bindVertexArray( crimild::UInt32 vertexArrayId )
+{
+    if ( !update( CallType::VERTEX_ARRAY, _vertexArray, vertexArrayId ) ) {
+        return false;
+    }
+
+    // the index buffer binding belongs to the vertex array
+    _indexBuffer = UNKNOWN;
+    return true;
+}
+
+bool RenderStateCache::bindVertexBuffer( crimild::UInt32 bufferId )
+{
+    return update( CallType::VERTEX_BUFFER, _vertexBuffer, bufferId );
+}
+
+bool RenderStateCache::bindIndexBuffer( crimild::UInt32 bufferId )
+{
+    return update( CallType::INDEX_BUFFER, _indexBuffer, bufferId );
+}
+
+void RenderStateCache::invalidateVertexArray( crimild::UInt32 vertexArrayId )
+{
+    if ( _vertexArray == vertexArrayId ) {
+        _vertexArray = 0;
+        _indexBuffer = UNKNOWN;
+    }
+}
+
+void RenderStateCache::invalidateBuffer( crimild::UInt32 bufferId )
+{
+    if ( _vertexBuffer == bufferId ) {
+        _vertexBuffer = 0;
+    }
+
+    if ( _indexBuffer == bufferId ) {
+        _indexBuffer = 0;
+    }
+}
+
+bool RenderStateCache::setBlendEnabled( bool enabled )
+{
+    return update( CallType::BLEND, _blendEnabled, enabled ? 1 : 0 );
+}
+
+bool RenderStateCache::setBlendFunc( crimild::UInt32 srcFunc, crimild::UInt32 dstFunc )
+{
+    if ( _blendSrcFunc == srcFunc && _blendDstFunc == dstFunc ) {
+        return filter( CallType::BLEND );
+    }
+
+    _blendSrcFunc = srcFunc;
+    _blendDstFunc = dstFunc;
+    return issue( CallType::BLEND );
+}
+
+bool RenderStateCache::setDepthTestEnabled( bool enabled )
+{
+    return update( CallType::DEPTH, _depthTestEnabled, enabled ? 1 : 0 );
+}
+
+bool RenderStateCache::setDepthFunc( crimild::UInt32 func )
+{
+    return update( CallType::DEPTH, _depthFunc, func );
+}
+
+bool RenderStateCache::setDepthMask( bool writable )
+{
+    return update( CallType::DEPTH, _depthMask, writable ? 1 : 0 );
+}
+
+bool RenderStateCache::setCullFaceEnabled( bool enabled )
+{
+    return update( CallType::CULL_FACE, _cullFaceEnabled, enabled ? 1 : 0 );
+}
+
+bool RenderStateCache::setCullFaceMode( crimild::UInt32 mode )
+{
+    return update( CallType::CULL_FACE, _cullFaceMode, mode );
+}
+
+bool RenderStateCache::setColorMask( bool r, bool g, bool b, bool a )
+{
+    crimild::UInt32 mask = ( r ? 1 : 0 ) | ( g ? 2 : 0 ) | ( b ? 4 : 0 ) | ( a ? 8 : 0 );
+    return update( CallType::COLOR_MASK, _colorMask, mask );
+}
+
+bool RenderStateCache::setUniform( crimild::Int32 location, const void *data, crimild::Size size )
+{
+    if ( _boundUniforms == nullptr || location < 0 || location > MAX_CACHED_UNIFORM_LOCATION || size > MAX_CACHED_UNIFORM_SIZE ) {
+        return issue( CallType::UNIFORM );
+    }
+
+    if ( static_cast< crimild::Size >( location ) >= _boundUniforms->size() ) {
+        _boundUniforms->resize( location + 1 );
+    }
+
+    auto &value = ( *_boundUniforms )[ location ];
+    if ( value.size == size && std::memcmp( value.data, data, size ) == 0 ) {
+        return filter( CallType::UNIFORM );
+    }
+
+    value.size = size;
+    std::memcpy( value.data, data, size );
+    return issue( CallType::UNIFORM );
+}
+
+void RenderStateCache::resetCounters( void )
+{
+    for ( crimild::Size i = 0; i < CALL_TYPE_COUNT; i++ ) {
+        _issued[ i ] = 0;
+        _filtered[ i ] = 0;
+    }
+}
+
+crimild::Size RenderStateCache::getIssuedCount( void ) const
+{
+    crimild::Size count = 0;
+    for ( crimild::Size i = 0; i < CALL_TYPE_COUNT; i++ ) {
+        count += _issued[ i ];
+    }
+    return count;
+}
+
+crimild::Size RenderStateCache::getFilteredCount( void ) const
+{
+    crimild::Size count = 0;
+    for ( crimild::Size i = 0; i < CALL_TYPE_COUNT; i++ ) {
+        count += _filtered[ i ];
+    }
+    return count;
+}
+
@@ -0,0 +1,267 @@
+/*
+ * Copyright (c) 2013, Hernan Saez
+ * All rights reserved.
+ * 
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *     * Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in the
+ *       documentation and/or other materials provided with the distribution.
+ *     * Neither the name of the <organization> nor the
+ *       names of its contributors may be used to endorse or promote products
+ *       derived from this software without specific prior written permission.
+ * 
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL <COPYRIGHT HOLDER> BE LIABLE FOR ANY
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef CRIMILD_CORE_RENDERING_RENDER_STATE_CACHE_
+#define CRIMILD_CORE_RENDERING_RENDER_STATE_CACHE_
+
+#include "Foundation/Types.hpp"
+
+#include <unordered_map>
+#include <vector>
+
+namespace crimild {
+
+    /**
+        \brief Shadow copy of the driver state
+
+        Renderer backends query the cache before forwarding a state change
+        to the driver. Every method returns true if the call must be issued
+        (the value changed or the current one is unknown) and false if it's
+        redundant and can be dropped. Values are opaque to the cache, so 
+        backends are free to store their native enums and object ids.
+
+        The cache also keeps track of the last value written to each uniform 
+        location for every shader program, since uniforms are part of the 
+        program state and survive across program switches.
+
+        Counters for issued and filtered calls are reset at the beginning
+        of each frame (see Renderer::beginRender())
+     */
+    class RenderStateCache {
+    public:
+        enum class CallType {
+            PROGRAM,
+            TEXTURE,
+            VERTEX_ARRAY,
+            VERTEX_BUFFER,
+            INDEX_BUFFER,
+            BLEND,
+            DEPTH,
+            CULL_FACE,
+            COLOR_MASK,
+            UNIFORM,
+        };
+
+        static constexpr crimild::Size CALL_TYPE_COUNT = 10;
+
+        /**
+            \brief Value used for bindings that are not known to the cache
+         */
+        static constexpr crimild::UInt32 UNKNOWN = 0xFFFFFFFF;
+
+        /**
+            \brief Uniform locations greater than this one are never cached
+         */
+        static constexpr crimild::Int32 MAX_CACHED_UNIFORM_LOCATION = 1024;
+
+        /**
+            \brief Uniform values bigger than this (in bytes) are never cached
+         */
+        static constexpr crimild::Size MAX_CACHED_UNIFORM_SIZE = 16 * sizeof( crimild::Real32 );
+
+    public:
+        RenderStateCache( void );
+        ~RenderStateCache( void );
+
+        /**
+            \brief Forgets about all bindings and render states
+
+            Must be called whenever the driver state might have been
+            modified behind the cache's back. Uniform values are kept,
+            since they belong to programs.
+         */
+        void invalidate( void );
+
+        /**
+            \brief Forgets about everything, including uniform values
+         */
+        void invalidateAll( void );
+
+    public:
+        bool bindProgram( crimild::UInt32 programId );
+        crimild::UInt32 getBoundProgram( void ) const { return _program; }
+
+        /**
+            \brief Must be called when a program is deleted or relinked
+         */
+        void invalidateProgram( crimild::UInt32 programId );
+
+    public:
+        bool setActiveTextureUnit( crimild::UInt32 unit );
+        crimild::UInt32 getActiveTextureUnit( void ) const { return _activeTextureUnit; }
+
+        /**
+            \brief Binds a texture to the active texture unit
+         */
+        bool bindTexture( crimild::UInt32 textureId );
+        crimild::UInt32 getBoundTexture( crimild::UInt32 unit ) const;
+
+        /**
+            \brief Must be called when a texture is deleted
+
+            Deleted textures are implicitly unbound from all units
+         */
+        void invalidateTexture( crimild::UInt32 textureId );
+
+    public:
+        /**
+            \brief Binds a vertex array
+
+            Changing the vertex array also changes the index buffer 
+            binding, since the latter is part of the vertex array state
+         */
+        bool bindVertexArray( crimild::UInt32 vertexArrayId );
+        bool bindVertexBuffer( crimild::UInt32 bufferId );
+        bool bindIndexBuffer( crimild::UInt32 bufferId );
+
+        crimild::UInt32 getBoundVertexArray( void ) const { return _vertexArray; }
+        crimild::UInt32 getBoundVertexBuffer( void ) const { return _vertexBuffer; }
+        crimild::UInt32 getBoundIndexBuffer( void ) const { return _indexBuffer; }
+
+        /**
+            \brief Must be called when a vertex array is deleted
+         */
+        void invalidateVertexArray( crimild::UInt32 vertexArrayId );
+
+        /**
+            \brief Must be called when a vertex or index buffer is deleted
+         */
+        void invalidateBuffer( crimild::UInt32 bufferId );
+
+    public:
+        bool setBlendEnabled( bool enabled );
+        bool setBlendFunc( crimild::UInt32 srcFunc, crimild::UInt32 dstFunc );
+
+        bool setDepthTestEnabled( bool enabled );
+        bool setDepthFunc( crimild::UInt32 func );
+        bool setDepthMask( bool writable );
+
+        bool setCullFaceEnabled( bool enabled );
+        bool setCullFaceMode( crimild::UInt32 mode );
+
+        bool setColorMask( bool r, bool g, bool b, bool a );
+
+    public:
+        /**
+            \brief Writes a uniform value for the bound program
+
+            Values are compared byte by byte with the last one written
+            to the same location. If the bound program is unknown, the
+            call is always issued and the value is not recorded.
+         */
+        bool setUniform( crimild::Int32 location, const void *data, crimild::Size size );
+
+        template< typename T >
+        bool setUniform( crimild::Int32 location, const T &value )
+        {
+            return setUniform( location, &value, sizeof( T ) );
+        }
+
+    private:
+        struct UniformValue {
+            crimild::UInt32 size = 0;
+            crimild::UInt8 data[ MAX_CACHED_UNIFORM_SIZE ];
+        };
+
+        using UniformValueArray = std::vector< UniformValue >;
+
+        bool update( CallType type, crimild::UInt32 &current, crimild::UInt32 value );
+
+        bool issue( CallType type )
+        {
+            ++_issued[ static_cast< crimild::Size >( type ) ];
+            return true;
+        }
+
+        bool filter( CallType type )
+        {
+            ++_filtered[ static_cast< crimild::Size >( type ) ];
+            return false;
+        }
+
+    private:
+        crimild::UInt32 _program;
+
+        crimild::UInt32 _activeTextureUnit;
+        std::vector< crimild::UInt32 > _textures;
+
+        crimild::UInt32 _vertexArray;
+        crimild::UInt32 _vertexBuffer;
+        crimild::UInt32 _indexBuffer;
+
+        crimild::UInt32 _blendEnabled;
+        crimild::UInt32 _blendSrcFunc;
+        crimild::UInt32 _blendDstFunc;
+
+        crimild::UInt32 _depthTestEnabled;
+        crimild::UInt32 _depthFunc;
+        crimild::UInt32 _depthMask;
+
+        crimild::UInt32 _cullFaceEnabled;
+        crimild::UInt32 _cullFaceMode;
+
+        crimild::UInt32 _colorMask;
+
+        /**
+            \brief Last uniform values, indexed by program id and location
+
+            References to elements in an unordered_map are stable, so we 
+            can keep a pointer to the values for the bound program
+         */
+        std::unordered_map< crimild::UInt32, UniformValueArray > _uniforms;
+        UniformValueArray *_boundUniforms = nullptr;
+
+        /**
+            \name Counters
+         */
+        //@{
+
+    public:
+        /**
+            \brief Resets all counters
+
+            Invoked by the renderer at the beginning of every frame
+         */
+        void resetCounters( void );
+
+        crimild::Size getIssuedCount( CallType type ) const { return _issued[ static_cast< crimild::Size >( type ) ]; }
+        crimild::Size getFilteredCount( CallType type ) const { return _filtered[ static_cast< crimild::Size >( type ) ]; }
+
+        crimild::Size getIssuedCount( void ) const;
+        crimild::Size getFilteredCount( void ) const;
+
+    private:
+        crimild::Size _issued[ CALL_TYPE_COUNT ];
+        crimild::Size _filtered[ CALL_TYPE_COUNT ];
+
+        //@}
+    };
+
+}
+
+#endif
+
@@ -127,6 +127,10 @@ SharedPointer< FrameBufferObject > Renderer::generateAuxFBO( std::string name, i
 
 void Renderer::beginRender( void )
 {
+    // the driver state might have been modified outside the renderer
+    _stateCache.invalidate();
+    _stateCache.resetCounters();
+
     static const Rectf VIEWPORT( 0.0f, 0.0f, 1.0f, 1.0f );
     setViewport( VIEWPORT );
 }
@@ -33,6 +33,8 @@
 
 #include "Primitives/Primitive.hpp"
 
+#include "Rendering/RenderStateCache.hpp"
+
 #include "Mathematics/Vector.hpp"
 #include "Mathematics/Matrix.hpp"
 #include "Mathematics/Rect.hpp"
@@ -85,6 +87,18 @@ namespace crimild {
             
         virtual void presentFrame( void );
 
+	public:
+		/**
+			\brief Shadow copy of the driver state
+
+			Backends use it to drop redundant state changes. The cache
+			is invalidated and its counters are reset in beginRender()
+		 */
+		RenderStateCache *getStateCache( void ) { return &_stateCache; }
+
+	private:
+		RenderStateCache _stateCache;
+
 	public:
 		virtual void bindFrameBuffer( FrameBufferObject *fbo );
 		virtual void unbindFrameBuffer( FrameBufferObject *fbo );
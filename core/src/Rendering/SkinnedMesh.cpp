@@ -30,6 +30,7 @@
 #include "Coding/Decoder.hpp"
 
 #include "Foundation/Log.hpp"
+#include "Animation/KeyframeCursor.hpp"
 
 using namespace crimild;
 
@@ -209,26 +210,62 @@ SkinnedMeshAnimationChannel::~SkinnedMeshAnimationChannel( void )
 	
 }
 
+namespace crimild {
+
+	namespace internal {
+
+		/**
+		   \brief Finds the keys surrounding animationTime and computes the interpolation factor
+		 */
+		template< typename KeyArray >
+		crimild::Size findAnimationKey( KeyArray const &keys, float animationTime, crimild::Size &cursor, float &factor )
+		{
+			const auto count = keys.size();
+			const auto data = keys.getData();
+
+			if ( animationTime <= data[ 0 ].time ) {
+				factor = 0.0f;
+				return 0;
+			}
+
+			if ( animationTime >= data[ count - 1 ].time ) {
+				factor = 1.0f;
+				return count - 2;
+			}
+
+			auto index = animation::findKeyframe( count, animationTime, cursor, [ data ]( crimild::Size i ) { return data[ i ].time; } );
+
+			float dt = data[ index + 1 ].time - data[ index ].time;
+			factor = ( animationTime - data[ index ].time ) / dt;
+			return index;
+		}
+
+	}
+
+}
+
 bool SkinnedMeshAnimationChannel::computePosition( float animationTime, Vector3f &result )
 {
+	crimild::Size cursor = 0;
+	return computePosition( animationTime, result, cursor );
+}
+
+bool SkinnedMeshAnimationChannel::computePosition( float animationTime, Vector3f &result, crimild::Size &cursor )
+{
+	if ( getPositionKeys().size() == 0 ) {
+		return false;
+	}
+
 	if ( getPositionKeys().size() == 1 ) {
 		result = getPositionKeys()[ 0 ].value;
 		return true;
 	}
 
-	unsigned int positionIndex = 0;
-	for ( int i = 0; i < getPositionKeys().size() - 1; i++ ) {
-		if ( animationTime < getPositionKeys()[ i + 1 ].time ) {
-			positionIndex = i;
-			break;
-		}
-	}
+	float factor;
+	auto positionIndex = internal::findAnimationKey( getPositionKeys(), animationTime, cursor, factor );
 
 	auto const &p0 = getPositionKeys()[ positionIndex ];
 	auto const &p1 = getPositionKeys()[ positionIndex + 1 ];
-
-	float dt = p1.time - p0.time;
-	float factor = ( animationTime - p0.time ) / dt;
 	Interpolation::linear( p0.value, p1.value, factor, result );
 
 	return true;
@@ -236,24 +273,26 @@ bool SkinnedMeshAnimationChannel::computePosition( float animationTime, Vector3f
 
 bool SkinnedMeshAnimationChannel::computeRotation( float animationTime, Quaternion4f &result )
 {
+	crimild::Size cursor = 0;
+	return computeRotation( animationTime, result, cursor );
+}
+
+bool SkinnedMeshAnimationChannel::computeRotation( float animationTime, Quaternion4f &result, crimild::Size &cursor )
+{
+	if ( getRotationKeys().size() == 0 ) {
+		return false;
+	}
+
 	if ( getRotationKeys().size() == 1 ) {
 		result = getRotationKeys()[ 0 ].value;
 		return true;
 	}
 
-	unsigned int rotationIndex = 0;
-	for ( int i = 0; i < getRotationKeys().size() - 1; i++ ) {
-		if ( animationTime < getRotationKeys()[ i + 1 ].time ) {
-			rotationIndex = i;
-			break;
-		}
-	}
+	float factor;
+	auto rotationIndex = internal::findAnimationKey( getRotationKeys(), animationTime, cursor, factor );
 
 	auto const &r0 = getRotationKeys()[ rotationIndex ];
 	auto const &r1 = getRotationKeys()[ rotationIndex + 1 ];
-
-	float dt = r1.time - r0.time;
-	float factor = ( animationTime - r0.time ) / dt;
 	Interpolation::slerp( r0.value, r1.value, factor, result );
 
 	return true;
@@ -261,24 +300,26 @@ bool SkinnedMeshAnimationChannel::computeRotation( float animationTime, Quaterni
 
 bool SkinnedMeshAnimationChannel::computeScale( float animationTime, float &result )
 {
+	crimild::Size cursor = 0;
+	return computeScale( animationTime, result, cursor );
+}
+
+bool SkinnedMeshAnimationChannel::computeScale( float animationTime, float &result, crimild::Size &cursor )
+{
+	if ( getScaleKeys().size() == 0 ) {
+		return false;
+	}
+
 	if ( getScaleKeys().size() == 1 ) {
 		result = getScaleKeys()[ 0 ].value;
 		return true;
 	}
 
-	unsigned int scaleIndex = 0;
-	for ( int i = 0; i < getScaleKeys().size() - 1; i++ ) {
-		if ( animationTime < getScaleKeys()[ i + 1 ].time ) {
-			scaleIndex = i;
-			break;
-		}
-	}
+	float factor;
+	auto scaleIndex = internal::findAnimationKey( getScaleKeys(), animationTime, cursor, factor );
 
 	auto const &s0 = getScaleKeys()[ scaleIndex ];
 	auto const &s1 = getScaleKeys()[ scaleIndex + 1 ];
-
-	float dt = s1.time - s0.time;
-	float factor = ( animationTime - s0.time ) / dt;
 	Interpolation::linear( s0.value, s1.value, factor, result );
 
 	return true;
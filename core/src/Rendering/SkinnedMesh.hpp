@@ -158,9 +158,24 @@ namespace crimild {
 		ScaleKeyArray &getScaleKeys( void ) { return _scaleKeys; }
 		const ScaleKeyArray &getScaleKeys( void ) const { return _scaleKeys; }
 
+		/**
+		   \brief Cached key indices for each of the channel's tracks
+
+		   Channels are shared by all instances of a skinned mesh, so cursors
+		   must be kept by whoever is playing the animation.
+		 */
+		struct Cursor {
+			crimild::Size position = 0;
+			crimild::Size rotation = 0;
+			crimild::Size scale = 0;
+		};
+
 		bool computePosition( float animationTime, Vector3f &result );
+		bool computePosition( float animationTime, Vector3f &result, crimild::Size &cursor );
 		bool computeRotation( float animationTime, Quaternion4f &result );
+		bool computeRotation( float animationTime, Quaternion4f &result, crimild::Size &cursor );
 		bool computeScale( float animationTime, float &result );
+		bool computeScale( float animationTime, float &result, crimild::Size &cursor );
 
 	private:
 		PositionKeyArray _positionKeys;
@@ -0,0 +1,91 @@
+/*
+ * Copyright (c) 2013, Hernan Saez
+ * All rights reserved.
+ * 
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *     * Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in the
+ *       documentation and/or other materials provided with the distribution.
+ *     * Neither the name of the <organization> nor the
+ *       names of its contributors may be used to endorse or promote products
+ *       derived from this software without specific prior written permission.
+ * 
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL <COPYRIGHT HOLDER> BE LIABLE FOR ANY
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "StreamingVertexBufferObject.hpp"
+
+#include "Foundation/Log.hpp"
+
+using namespace crimild;
+
+const crimild::Size StreamingVertexBufferObject::SEGMENT_COUNT;
+
+StreamingVertexBufferObject::StreamingVertexBufferObject( void )
+{
+
+}
+
+StreamingVertexBufferObject::StreamingVertexBufferObject( const VertexFormat &vf, crimild::UInt32 maxVertexCount )
+	: VertexBufferObject( vf, SEGMENT_COUNT * maxVertexCount )
+{
+
+}
+
+StreamingVertexBufferObject::~StreamingVertexBufferObject( void )
+{
+
+}
+
+VertexPrecision *StreamingVertexBufferObject::beginStreaming( crimild::UInt32 vertexCount )
+{
+	assert( !_streaming && "Streaming already in progress" );
+
+	if ( vertexCount > getMaxVertexCount() ) {
+		Log::warning( CRIMILD_CURRENT_CLASS_NAME, "Too many vertices (", vertexCount, "). Only ", getMaxVertexCount(), " will be streamed" );
+		vertexCount = getMaxVertexCount();
+	}
+
+	_streaming = true;
+	_writeSegment = ( _segment + 1 ) % SEGMENT_COUNT;
+	_writeVertexCount = vertexCount;
+
+	const auto offset = _writeSegment * getSegmentSizeInBytes();
+
+	_mapped = _mapper != nullptr && vertexCount > 0;
+	if ( _mapped ) {
+		// the whole buffer can be discarded when the ring wraps around, since
+		// all segments have been written since the last time it was discarded
+		const auto discard = _writeSegment == 0;
+		return _mapper->map( this, offset, vertexCount * getVertexFormat().getVertexSizeInBytes(), discard );
+	}
+
+	return data() + offset / sizeof( VertexPrecision );
+}
+
+void StreamingVertexBufferObject::endStreaming( void )
+{
+	assert( _streaming && "Streaming not started" );
+
+	if ( _mapped ) {
+		_mapper->unmap( this, _writeSegment * getSegmentSizeInBytes(), _writeVertexCount * getVertexFormat().getVertexSizeInBytes() );
+		_mapped = false;
+	}
+
+	_segment = _writeSegment;
+	_streamedVertexCount = _writeVertexCount;
+	_streaming = false;
+}
+
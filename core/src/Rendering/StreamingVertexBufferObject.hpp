@@ -0,0 +1,148 @@
+/*
+ * Copyright (c) 2013, Hernan Saez
+ * All rights reserved.
+ * 
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *     * Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in the
+ *       documentation and/or other materials provided with the distribution.
+ *     * Neither the name of the <organization> nor the
+ *       names of its contributors may be used to endorse or promote products
+ *       derived from this software without specific prior written permission.
+ * 
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL <COPYRIGHT HOLDER> BE LIABLE FOR ANY
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef CRIMILD_RENDERING_STREAMING_VERTEX_BUFFER_OBJECT_
+#define CRIMILD_RENDERING_STREAMING_VERTEX_BUFFER_OBJECT_
+
+#include "VertexBufferObject.hpp"
+
+namespace crimild {
+
+	/**
+	   \brief A vertex buffer whose contents are rewritten every frame
+
+	   Storage is split into SEGMENT_COUNT segments that are used as a ring, 
+	   so the CPU never writes into a segment that the GPU might still be 
+	   reading from a previous frame. Only the last segment written is drawn.
+
+	   Vertex data is written with beginStreaming()/endStreaming(). If a 
+	   Mapper has been set (usually by the renderer, once the buffer has been
+	   loaded), the returned pointer refers to GPU memory directly. Otherwise,
+	   vertices are written into this buffer's own storage.
+
+	   \remarks Streaming must happen in the same thread as rendering, since
+	   mapping buffers requires access to the rendering context
+	 */
+	class StreamingVertexBufferObject : public VertexBufferObject {
+		CRIMILD_IMPLEMENT_RTTI( crimild::StreamingVertexBufferObject )
+
+	public:
+		static const crimild::Size SEGMENT_COUNT = 3;
+
+		/**
+		   \brief Provides access to the memory backing a streaming buffer
+		 */
+		class Mapper {
+		public:
+			virtual ~Mapper( void ) { }
+
+			/**
+			   \brief Maps a region of the buffer for writing
+
+			   \param offset Offset of the region, in bytes
+			   \param size Size of the region, in bytes
+			   \param discard If true, the previous contents of the whole 
+			   buffer are no longer needed (i.e. the buffer can be orphaned)
+			 */
+			virtual VertexPrecision *map( StreamingVertexBufferObject *vbo, crimild::Size offset, crimild::Size size, crimild::Bool discard ) = 0;
+
+			/**
+			   \brief Flushes a region previously mapped by map()
+			 */
+			virtual void unmap( StreamingVertexBufferObject *vbo, crimild::Size offset, crimild::Size size ) = 0;
+		};
+
+	public:
+		/**
+		   \param maxVertexCount Maximum number of vertices per frame
+		 */
+		StreamingVertexBufferObject( const VertexFormat &vf, crimild::UInt32 maxVertexCount );
+		virtual ~StreamingVertexBufferObject( void );
+
+		crimild::UInt32 getMaxVertexCount( void ) const { return getVertexCount() / SEGMENT_COUNT; }
+
+		Mapper *getMapper( void ) { return _mapper; }
+		void setMapper( Mapper *mapper ) { _mapper = mapper; }
+
+		/**
+		   \brief Starts writing vertices for a new frame
+
+		   \returns A pointer to interleaved vertex data (see getVertexFormat())
+		   with room for vertexCount vertices. The pointer is only valid until 
+		   endStreaming() is called.
+		 */
+		VertexPrecision *beginStreaming( crimild::UInt32 vertexCount );
+
+		void endStreaming( void );
+
+		/**
+		   \brief Number of vertices written in the last frame
+		 */
+		crimild::UInt32 getStreamedVertexCount( void ) const { return _streamedVertexCount; }
+
+		/**
+		   \brief Segment containing the vertices written in the last frame
+		 */
+		crimild::Size getStreamedSegment( void ) const { return _segment; }
+
+		/**
+		   \brief Offset in bytes for the first vertex written in the last frame
+		 */
+		crimild::Size getStreamedOffset( void ) const { return _segment * getSegmentSizeInBytes(); }
+
+	private:
+		crimild::Size getSegmentSizeInBytes( void ) const { return getMaxVertexCount() * getVertexFormat().getVertexSizeInBytes(); }
+
+	private:
+		Mapper *_mapper = nullptr;
+		crimild::Bool _mapped = false;
+
+		crimild::Size _segment = 0;
+		crimild::UInt32 _streamedVertexCount = 0;
+
+		/**
+		   \brief The segment being written, if any
+		 */
+		crimild::Size _writeSegment = 0;
+		crimild::UInt32 _writeVertexCount = 0;
+		crimild::Bool _streaming = false;
+
+	public:
+		/**
+		   \brief Default constructor
+
+		   \warning Used only for coding purposes
+		 */
+		StreamingVertexBufferObject( void );
+	};
+
+	using StreamingVertexBufferObjectPtr = SharedPointer< StreamingVertexBufferObject >;
+
+}
+
+#endif
+
@@ -119,9 +119,21 @@ namespace crimild {
 
 		bool culled( const BoundingVolume *volume ) const;
 
+        /**
+            \brief Gets one of the planes computed by computeCullingPlanes()
+         */
+        const Plane3f &getCullingPlane( crimild::Size index ) const { return _cullingPlanes[ index ]; }
+
+        /**
+            \brief All culling planes, packed (see BatchCulling)
+         */
+        const Plane3f *getCullingPlanes( void ) const { return _cullingPlanes; }
+
+        static constexpr crimild::Size CULLING_PLANE_COUNT = 6;
+
 	private:
         bool _cullingEnabled = true;
-		Plane3f _cullingPlanes[ 6 ];
+		Plane3f _cullingPlanes[ CULLING_PLANE_COUNT ];
 	};
 
 }
@@ -69,12 +69,27 @@ void Group::attachNode( SharedPointer< Node > const &node )
 	node->setParent( this );
 
 	_nodes.add( node );
+
+	if ( node->getSubtreeLightCount() > 0 ) {
+		addSubtreeLights( node->getSubtreeLightCount() );
+	}
+
+	markHierarchyChanged();
+
+	// the node's world state is now relative to this group
+	node->markWorldDirty();
 }
 
 void Group::detachNode( Node *node )
 {
     if ( node->getParent() == this ) {
+        markHierarchyChanged();
+        if ( node->getSubtreeLightCount() > 0 ) {
+            addSubtreeLights( -static_cast< crimild::Int32 >( node->getSubtreeLightCount() ) );
+        }
+        markBoundDirty();
         node->setParent( nullptr );
+        node->markWorldDirty();
         _nodes.remove( crimild::retain( node ) );
     }
 }
@@ -86,7 +101,22 @@ void Group::detachNode( SharedPointer< Node > const &node )
 
 void Group::detachAllNodes( void )
 {
-	_nodes.each( []( SharedPointer< Node > &node ) { node->setParent( nullptr ); } );
+	if ( hasNodes() ) {
+		markHierarchyChanged();
+		markBoundDirty();
+	}
+
+	crimild::Int32 lightCount = 0;
+	_nodes.each( [ &lightCount ]( SharedPointer< Node > &node ) {
+		lightCount += node->getSubtreeLightCount();
+		node->setParent( nullptr );
+		node->markWorldDirty();
+	});
+
+	if ( lightCount > 0 ) {
+		addSubtreeLights( -lightCount );
+	}
+
 	_nodes.clear();
 }
 
@@ -42,7 +42,7 @@ Light::Light( Type type )
 	  _exponent( 0.0f ),
       _ambient( 0.0f, 0.0f, 0.0f, 0.0f )
 {
-    
+	addSubtreeLights( 1 );
 }
 
 Light::~Light( void )
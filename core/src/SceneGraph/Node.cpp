@@ -46,6 +46,10 @@ Node::Node( std::string name )
 
 Node::~Node( void )
 {
+	if ( _transformHierarchy != nullptr ) {
+		_transformHierarchy->invalidate();
+	}
+
 	detachAllComponents();
 }
 
@@ -74,6 +78,73 @@ SharedPointer< Node > Node::detachFromParent( void )
     return node;
 }
 
+void Node::setLocalBound( SharedPointer< BoundingVolume > const &bound )
+{
+	_localBound = bound;
+	++_localRevision;
+	markBoundDirty();
+	if ( _transformHierarchy != nullptr ) {
+		_transformHierarchy->updateBounds( _transformIndex, this );
+	}
+}
+
+void Node::setWorldBound( SharedPointer< BoundingVolume > const &bound )
+{
+	_worldBound = bound;
+	markBoundDirty();
+	if ( _transformHierarchy != nullptr ) {
+		_transformHierarchy->updateBounds( _transformIndex, this );
+	}
+}
+
+void Node::setEnabled( bool enabled )
+{
+	if ( _enabled == enabled ) {
+		return;
+	}
+
+	_enabled = enabled;
+	markHierarchyChanged();
+
+	if ( enabled ) {
+		// the world state might be outdated
+		markWorldDirty();
+	}
+	else if ( _parent != nullptr ) {
+		// the parent's bound must not include this node anymore
+		_parent->markBoundDirty();
+	}
+}
+
+void Node::markHierarchyChanged( void )
+{
+	for ( auto node = this; node != nullptr; node = node->_parent ) {
+		++node->_hierarchyRevision;
+	}
+
+	invalidateTransformHierarchy();
+}
+
+void Node::addSubtreeLights( crimild::Int32 delta )
+{
+	for ( auto node = this; node != nullptr; node = node->_parent ) {
+		node->_subtreeLightCount += delta;
+	}
+}
+
+void Node::invalidateTransformHierarchy( void )
+{
+	// disabled nodes are not bound, so check the parent too
+	auto hierarchy = _transformHierarchy;
+	if ( hierarchy == nullptr && _parent != nullptr ) {
+		hierarchy = _parent->_transformHierarchy;
+	}
+
+	if ( hierarchy != nullptr ) {
+		hierarchy->invalidate();
+	}
+}
+
 void Node::perform( NodeVisitor &visitor )
 {
 	visitor.traverse( this );
@@ -235,7 +306,7 @@ void Node::save( Stream &s )
 
     s.write( getName() );
 
-    s.write( _local );
+    s.write( getLocal() );
 
     std::vector< SharedPointer< NodeComponent >> cs;
     for ( auto &it : _components ) {
@@ -254,7 +325,7 @@ void Node::load( Stream &s )
     s.read( name );
     setName( name );
 
-    s.read( _local );
+    s.read( local() );
 
     std::vector< SharedPointer< NodeComponent >> cmps;
     s.read( cmps );
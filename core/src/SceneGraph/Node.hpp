@@ -36,6 +36,7 @@
 #include "Components/NodeComponent.hpp"
 #include "Mathematics/Transformation.hpp"
 #include "Boundings/BoundingVolume.hpp"
+#include "SceneGraph/TransformHierarchy.hpp"
 
 #include <map>
 
@@ -93,15 +94,20 @@ namespace crimild {
 		virtual void accept( NodeVisitor &visitor );
 
 	public:
-        NodeComponent *getComponentWithName( std::string name )
+        NodeComponent *getComponentWithName( std::string const &name )
         {
-            return crimild::get_ptr( _components[ name ] );
+            // lookups must not modify the collection, since they
+            // might happen in parallel (i.e. when computing render queues)
+            auto it = _components.find( name );
+            return it != _components.end() ? crimild::get_ptr( it->second ) : nullptr;
         }
         
         template< class NODE_COMPONENT_CLASS >
         NODE_COMPONENT_CLASS *getComponent( void )
         {
-            return static_cast< NODE_COMPONENT_CLASS * >( getComponentWithName( NODE_COMPONENT_CLASS::__CLASS_NAME ) );
+            // avoid creating a new string on every call
+            static const std::string name( NODE_COMPONENT_CLASS::__CLASS_NAME );
+            return static_cast< NODE_COMPONENT_CLASS * >( getComponentWithName( name ) );
         }
         
         bool hasComponent( SharedPointer< NodeComponent > const &component )
@@ -143,16 +149,16 @@ namespace crimild {
 		std::map< std::string, SharedPointer< NodeComponent >> _components;
 
 	public:
-		void setLocal( const Transformation &t ) { _local = t; }
-		const Transformation &getLocal( void ) const { return _local; }
-		Transformation &local( void ) { return _local; }
+		void setLocal( const Transformation &t ) { *_localTransform = t; markLocalChanged(); }
+		const Transformation &getLocal( void ) const { return *_localTransform; }
+		Transformation &local( void ) { markLocalChanged(); return *_localTransform; }
 
-		void setWorld( const Transformation &t ) { _world = t; }
-		const Transformation &getWorld( void ) const { return _world; }
-		Transformation &world( void ) { return _world; }
+		void setWorld( const Transformation &t ) { *_worldTransform = t; markWorldDirty(); }
+		const Transformation &getWorld( void ) const { return *_worldTransform; }
+		Transformation &world( void ) { markWorldDirty(); return *_worldTransform; }
 
 		bool worldIsCurrent( void ) const { return _worldIsCurrent; }
-		void setWorldIsCurrent( bool isCurrent ) { _worldIsCurrent = isCurrent; }
+		void setWorldIsCurrent( bool isCurrent ) { _worldIsCurrent = isCurrent; markWorldDirty(); }
 
 	private:
 		Transformation _local;
@@ -169,22 +175,175 @@ namespace crimild {
 		bool _worldIsCurrent;
 
 	public:
-        BoundingVolume *localBound( void ) { return crimild::get_ptr( _localBound ); }
+        BoundingVolume *localBound( void ) { ++_localRevision; markBoundDirty(); return crimild::get_ptr( _localBound ); }
 		const BoundingVolume *getLocalBound( void ) const { return crimild::get_ptr( _localBound ); }
-        void setLocalBound( BoundingVolume *bound ) { _localBound = crimild::retain( bound ); }
-        void setLocalBound( SharedPointer< BoundingVolume > const &bound ) { _localBound = bound; }
+        void setLocalBound( BoundingVolume *bound ) { setLocalBound( crimild::retain( bound ) ); }
+        void setLocalBound( SharedPointer< BoundingVolume > const &bound );
 
 		BoundingVolume *worldBound( void ) { return crimild::get_ptr( _worldBound ); }
 		const BoundingVolume *getWorldBound( void ) const { return crimild::get_ptr( _worldBound ); }
-        void setWorldBound( BoundingVolume *bound ) { _worldBound = crimild::retain( bound ); }
-        void setWorldBound( SharedPointer< BoundingVolume > const &bound ) { _worldBound = bound; }
+        void setWorldBound( BoundingVolume *bound ) { setWorldBound( crimild::retain( bound ) ); }
+        void setWorldBound( SharedPointer< BoundingVolume > const &bound );
 
 	private:
 		SharedPointer< BoundingVolume > _localBound;
 		SharedPointer< BoundingVolume > _worldBound;
 
+		/**
+			\name Dirty tracking
+
+			Changing a node's local transformation or bounds marks it as dirty
+			and flags all of its ancestors as having a dirty subtree, so 
+			UpdateWorldState can skip subtrees that did not change at all.
+
+			Revision counters are increased every time the corresponding
+			value changes and can be used to detect changes between frames.
+		*/
+		//@{
+
+	public:
+		/**
+			\brief Increased whenever the local transformation or local bound changes
+		*/
+		crimild::UInt32 getLocalRevision( void ) const { return _localRevision; }
+
+		/**
+			\brief Increased whenever the world transformation is recomputed
+		*/
+		crimild::UInt32 getWorldRevision( void ) const { return _worldRevision; }
+
+		/**
+			\brief Increased whenever the world bound is recomputed
+		*/
+		crimild::UInt32 getBoundRevision( void ) const { return _boundRevision; }
+
+		/**
+			\brief Increased whenever nodes are attached, detached, enabled or 
+			disabled anywhere in this node's subtree
+		*/
+		crimild::UInt32 getHierarchyRevision( void ) const { return _hierarchyRevision; }
+
+		/**
+			\brief Notifies this node and its ancestors that the hierarchy has changed
+		*/
+		void markHierarchyChanged( void );
+
+		bool isWorldDirty( void ) const { return _worldDirty; }
+		bool isBoundDirty( void ) const { return _boundDirty; }
+		bool isSubtreeDirty( void ) const { return _subtreeDirty; }
+
+		/**
+			\brief Forces the world transformation (and bound) to be recomputed
+		*/
+		void markWorldDirty( void )
+		{
+			_worldDirty = true;
+			markParentsSubtreeDirty();
+			if ( _transformHierarchy != nullptr ) {
+				_transformHierarchy->markDirty( _transformIndex );
+			}
+		}
+
+		/**
+			\brief Forces the world bound to be recomputed
+		*/
+		void markBoundDirty( void )
+		{
+			_boundDirty = true;
+			markParentsSubtreeDirty();
+			if ( _transformHierarchy != nullptr ) {
+				_transformHierarchy->markDirty( _transformIndex );
+			}
+		}
+
+	private:
+		void markLocalChanged( void )
+		{
+			++_localRevision;
+			markWorldDirty();
+		}
+
+		void markParentsSubtreeDirty( void )
+		{
+			// if a parent is already flagged, so are all of its ancestors
+			for ( auto parent = _parent; parent != nullptr && !parent->_subtreeDirty; parent = parent->_parent ) {
+				parent->_subtreeDirty = true;
+			}
+		}
+
+	private:
+		friend class UpdateWorldState;
+
+		crimild::UInt32 _localRevision = 0;
+		crimild::UInt32 _worldRevision = 0;
+		crimild::UInt32 _boundRevision = 0;
+		crimild::UInt32 _hierarchyRevision = 0;
+
+		bool _worldDirty = true;
+		bool _boundDirty = true;
+		bool _subtreeDirty = false;
+
+		//@}
+
+		/**
+			\name Light tracking
+		*/
+		//@{
+
+	public:
+		/**
+			\brief Number of lights in this node's subtree (including itself)
+
+			Used to discard whole subtrees while computing render queues
+		*/
+		crimild::Size getSubtreeLightCount( void ) const { return _subtreeLightCount; }
+
+	protected:
+		/**
+			\brief Updates the light count for this node and all of its ancestors
+		*/
+		void addSubtreeLights( crimild::Int32 delta );
+
+	private:
+		crimild::Size _subtreeLightCount = 0;
+
+		//@}
+
+		/**
+			\name Transform hierarchy support
+		*/
+		//@{
+
+	public:
+		/**
+			\brief The store this node's transformations live in, if any
+		*/
+		TransformHierarchy *getTransformHierarchy( void ) { return _transformHierarchy; }
+
+		/**
+			\brief Invalidates the store this node (or its parent) is bound to
+
+			Must be called whenever the hierarchy changes
+		*/
+		void invalidateTransformHierarchy( void );
+
+	private:
+		friend class TransformHierarchy;
+
+		/**
+			\brief Either point to this node's own transformations or to 
+			the elements in a TransformHierarchy
+		*/
+		Transformation *_localTransform = &_local;
+		Transformation *_worldTransform = &_world;
+
+		TransformHierarchy *_transformHierarchy = nullptr;
+		crimild::Size _transformIndex = 0;
+
+		//@}
+
 	public:
-		void setEnabled( bool enabled ) { _enabled = enabled; }
+		void setEnabled( bool enabled );
 		bool isEnabled( void ) { return _enabled; }
 
 	private:
@@ -0,0 +1,207 @@
+/*
+ * Copyright (c) 2013, Hernan Saez
+ * All rights reserved.
+ * 
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *     * Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in the
+ *       documentation and/or other materials provided with the distribution.
+ *     * Neither the name of the <organization> nor the
+ *       names of its contributors may be used to endorse or promote products
+ *       derived from this software without specific prior written permission.
+ * 
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL <COPYRIGHT HOLDER> BE LIABLE FOR ANY
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "SpatialIndex.hpp"
+
+#include "SceneGraph/Group.hpp"
+#include "Boundings/PlaneBoundingVolume.hpp"
+#include "Visitors/NodeVisitor.hpp"
+
+#include <cmath>
+#include <unordered_map>
+
+using namespace crimild;
+
+namespace crimild {
+
+	namespace internal {
+
+		class CollectSpatialNodes : public NodeVisitor {
+		public:
+			CollectSpatialNodes( std::vector< Geometry * > &geometries, std::vector< Light * > &lights )
+				: _geometries( geometries ),
+				  _lights( lights )
+			{
+
+			}
+
+			virtual void visitGeometry( Geometry *geometry ) override
+			{
+				_geometries.push_back( geometry );
+			}
+
+			virtual void visitLight( Light *light ) override
+			{
+				_lights.push_back( light );
+			}
+
+		private:
+			std::vector< Geometry * > &_geometries;
+			std::vector< Light * > &_lights;
+		};
+
+	}
+
+}
+
+SpatialIndex::SpatialIndex( void )
+{
+
+}
+
+SpatialIndex::~SpatialIndex( void )
+{
+	clear();
+}
+
+void SpatialIndex::clear( void )
+{
+	_tree.clear();
+	_entries.clear();
+	_proxyEntries.clear();
+	_unbounded.clear();
+	_lights.clear();
+	_root = nullptr;
+	_hierarchyRevision = 0;
+	_reinsertedCount = 0;
+}
+
+void SpatialIndex::update( Node *root )
+{
+	_reinsertedCount = 0;
+
+	if ( root == nullptr ) {
+		clear();
+		return;
+	}
+
+	if ( root != getRoot() || root->getHierarchyRevision() != _hierarchyRevision ) {
+		rebuild( root );
+	}
+
+	refit();
+}
+
+void SpatialIndex::rebuild( Node *root )
+{
+	// keep proxies for geometries that are still in the scene, so 
+	// attaching or detaching a single node does not rebuild the whole tree
+	std::unordered_map< Geometry *, DynamicAABBTree::ProxyId > proxies;
+	proxies.reserve( _entries.size() );
+	for ( auto &entry : _entries ) {
+		proxies[ entry.geometry ] = entry.proxy;
+	}
+
+	std::vector< Geometry * > geometries;
+	geometries.reserve( _entries.size() + _unbounded.size() );
+
+	_lights.clear();
+	internal::CollectSpatialNodes collect( geometries, _lights );
+	root->perform( collect );
+
+	_entries.clear();
+	_entries.reserve( geometries.size() );
+	_unbounded.clear();
+
+	for ( auto geometry : geometries ) {
+		if ( !isBounded( geometry ) ) {
+			_unbounded.push_back( geometry );
+			continue;
+		}
+
+		auto it = proxies.find( geometry );
+		if ( it != proxies.end() ) {
+			// force a refit, since the geometry might have been moved
+			// somewhere else in the scene (or the address reused)
+			_entries.push_back( Entry { geometry, it->second, geometry->getBoundRevision() - 1 } );
+			proxies.erase( it );
+		}
+		else {
+			Vector3f min, max;
+			computeBox( geometry, min, max );
+			auto proxy = _tree.createProxy( min, max, geometry );
+			_entries.push_back( Entry { geometry, proxy, geometry->getBoundRevision() } );
+			++_reinsertedCount;
+		}
+	}
+
+	// whatever is left is no longer part of the scene
+	for ( auto &it : proxies ) {
+		_tree.destroyProxy( it.second );
+	}
+
+	for ( crimild::UInt32 i = 0; i < _entries.size(); i++ ) {
+		auto proxy = static_cast< crimild::Size >( _entries[ i ].proxy );
+		if ( proxy >= _proxyEntries.size() ) {
+			_proxyEntries.resize( proxy + 1 );
+		}
+		_proxyEntries[ proxy ] = i;
+	}
+
+	_root = crimild::retain( root );
+	_hierarchyRevision = root->getHierarchyRevision();
+}
+
+void SpatialIndex::refit( void )
+{
+	for ( auto &entry : _entries ) {
+		auto revision = entry.geometry->getBoundRevision();
+		if ( revision == entry.boundRevision ) {
+			continue;
+		}
+
+		entry.boundRevision = revision;
+
+		Vector3f min, max;
+		computeBox( entry.geometry, min, max );
+		if ( _tree.moveProxy( entry.proxy, min, max ) ) {
+			++_reinsertedCount;
+		}
+	}
+}
+
+bool SpatialIndex::isBounded( const Geometry *geometry )
+{
+	auto bound = geometry->getWorldBound();
+	if ( bound == nullptr || dynamic_cast< const PlaneBoundingVolume * >( bound ) != nullptr ) {
+		return false;
+	}
+
+	return std::isfinite( bound->getRadius() );
+}
+
+void SpatialIndex::computeBox( const Geometry *geometry, Vector3f &min, Vector3f &max )
+{
+	// use a box enclosing the bounding sphere, since that's what the 
+	// culling test in Camera::culled() uses for every bounding volume
+	auto bound = geometry->getWorldBound();
+	const auto &center = bound->getCenter();
+	auto r = bound->getRadius();
+	auto extents = Vector3f( r, r, r );
+	min = center - extents;
+	max = center + extents;
+}
@@ -0,0 +1,220 @@
+/*
+ * Copyright (c) 2013, Hernan Saez
+ * All rights reserved.
+ * 
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *     * Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in the
+ *       documentation and/or other materials provided with the distribution.
+ *     * Neither the name of the <organization> nor the
+ *       names of its contributors may be used to endorse or promote products
+ *       derived from this software without specific prior written permission.
+ * 
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL <COPYRIGHT HOLDER> BE LIABLE FOR ANY
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef CRIMILD_SCENE_GRAPH_SPATIAL_INDEX_
+#define CRIMILD_SCENE_GRAPH_SPATIAL_INDEX_
+
+#include "Foundation/SharedObject.hpp"
+#include "Foundation/Types.hpp"
+#include "Boundings/BatchCulling.hpp"
+#include "Boundings/DynamicAABBTree.hpp"
+#include "Mathematics/Distance.hpp"
+#include "SceneGraph/Camera.hpp"
+#include "SceneGraph/Geometry.hpp"
+#include "SceneGraph/Light.hpp"
+
+#include <algorithm>
+#include <vector>
+
+namespace crimild {
+
+	/**
+	   \brief Keeps all geometries in a scene in a DynamicAABBTree
+
+	   The index is synchronized with the scene on every update(). The 
+	   set of geometries and lights is only collected again whenever the
+	   scene's hierarchy changes (see Node::getHierarchyRevision()). Otherwise,
+	   only geometries whose world bound changed since the last update 
+	   (see Node::getBoundRevision()) are refitted in the tree.
+
+	   Lights are kept in a separate list, since they affect the scene
+	   even if they are not visible.
+
+	   Queries are read-only, so several cameras can be culled in parallel 
+	   once the index has been updated.
+	 */
+	class SpatialIndex : public SharedObject {
+	public:
+		SpatialIndex( void );
+		virtual ~SpatialIndex( void );
+
+		Node *getRoot( void ) { return crimild::get_ptr( _root ); }
+
+		/**
+		   \brief Synchronizes the index with the scene
+
+		   World bounds must be up to date (i.e. after UpdateWorldState)
+		 */
+		void update( Node *root );
+
+		void clear( void );
+
+		crimild::Size getGeometryCount( void ) const { return _entries.size() + _unbounded.size(); }
+		crimild::Size getLightCount( void ) const { return _lights.size(); }
+
+		/**
+		   \brief Number of geometries that were reinserted in the tree during the last update
+		 */
+		crimild::Size getReinsertedCount( void ) const { return _reinsertedCount; }
+
+		const DynamicAABBTree &getTree( void ) const { return _tree; }
+
+		template< typename Fn >
+		void forEachLight( Fn const &callback ) const
+		{
+			for ( auto light : _lights ) {
+				callback( light );
+			}
+		}
+
+		/**
+		   \brief Invokes callback for every geometry that is not culled by the camera
+
+		   Whole branches of the tree are discarded if they are outside
+		   of the camera's frustum, and accepted without further testing if 
+		   they're completely inside it. Remaining geometries are tested 
+		   with BatchCulling, so the results are the same as testing each
+		   geometry individually with Camera::culled(). Geometries are 
+		   visited in the same order as in a scene traversal.
+
+		   \remarks Camera::computeCullingPlanes() must be called first
+		 */
+		template< typename Fn >
+		void forEachVisibleGeometry( const Camera *camera, Fn const &callback ) const
+		{
+			if ( camera == nullptr || !camera->isCullingEnabled() ) {
+				for ( auto &entry : _entries ) {
+					callback( entry.geometry );
+				}
+				for ( auto geometry : _unbounded ) {
+					callback( geometry );
+				}
+				return;
+			}
+
+			std::vector< crimild::UInt32 > visible;
+			visible.reserve( _entries.size() / 4 );
+
+			// leaves intersecting the frustum are culled in a batch later
+			std::vector< crimild::UInt32 > candidates;
+			SphereBatch candidateBounds;
+
+			_tree.query(
+				[ camera ]( const Vector3f &min, const Vector3f &max ) {
+					auto center = 0.5f * ( min + max );
+					auto extents = 0.5f * ( max - min );
+					auto result = DynamicAABBTree::TestResult::INSIDE;
+					for ( crimild::Size i = 0; i < Camera::CULLING_PLANE_COUNT; i++ ) {
+						const auto &plane = camera->getCullingPlane( i );
+						const auto &n = plane.getNormal();
+						auto r = extents[ 0 ] * Numericf::fabs( n[ 0 ] ) + extents[ 1 ] * Numericf::fabs( n[ 1 ] ) + extents[ 2 ] * Numericf::fabs( n[ 2 ] );
+						auto d = Distance::compute( plane, center );
+						if ( d < -r ) {
+							return DynamicAABBTree::TestResult::OUTSIDE;
+						}
+						else if ( d <= r ) {
+							result = DynamicAABBTree::TestResult::INTERSECTS;
+						}
+					}
+					return result;
+				},
+				[ this, &visible, &candidates, &candidateBounds ]( DynamicAABBTree::ProxyId proxy, void *userData, bool inside ) {
+					if ( inside ) {
+						visible.push_back( _proxyEntries[ proxy ] );
+					}
+					else {
+						candidates.push_back( _proxyEntries[ proxy ] );
+						candidateBounds.push( static_cast< Geometry * >( userData )->getWorldBound() );
+					}
+				}
+			);
+
+			if ( !candidates.empty() ) {
+				std::vector< crimild::UInt8 > candidateVisible( candidates.size() );
+				BatchCulling::cull( candidateBounds, camera->getCullingPlanes(), Camera::CULLING_PLANE_COUNT, &candidateVisible[ 0 ] );
+				for ( crimild::Size i = 0; i < candidates.size(); i++ ) {
+					if ( candidateVisible[ i ] ) {
+						visible.push_back( candidates[ i ] );
+					}
+				}
+			}
+
+			// entries are stored in scene order. Visiting geometries in the same order
+			// as a traversal produces the same render queues and it's also cache friendly
+			std::sort( visible.begin(), visible.end() );
+			for ( auto idx : visible ) {
+				callback( _entries[ idx ].geometry );
+			}
+
+			for ( auto geometry : _unbounded ) {
+				if ( !camera->culled( geometry->getWorldBound() ) ) {
+					callback( geometry );
+				}
+			}
+		}
+
+	private:
+		void rebuild( Node *root );
+		void refit( void );
+
+		static bool isBounded( const Geometry *geometry );
+		static void computeBox( const Geometry *geometry, Vector3f &min, Vector3f &max );
+
+	private:
+		SharedPointer< Node > _root;
+		crimild::UInt32 _hierarchyRevision = 0;
+
+		DynamicAABBTree _tree;
+
+		struct Entry {
+			Geometry *geometry;
+			DynamicAABBTree::ProxyId proxy;
+			crimild::UInt32 boundRevision;
+		};
+
+		std::vector< Entry > _entries;
+
+		/**
+		   \brief Maps proxies in the tree to their entries
+		 */
+		std::vector< crimild::UInt32 > _proxyEntries;
+
+		/**
+		   \brief Geometries that cannot be described by a box (i.e. planes)
+		 */
+		std::vector< Geometry * > _unbounded;
+
+		std::vector< Light * > _lights;
+
+		crimild::Size _reinsertedCount = 0;
+	};
+
+	using SpatialIndexPtr = SharedPointer< SpatialIndex >;
+
+}
+
+#endif
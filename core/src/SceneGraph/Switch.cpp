@@ -51,13 +51,26 @@ void Switch::forEachNode( std::function< void( Node * ) > callback )
     }
 }
 
+void Switch::setCurrentNodeIndex( int index )
+{
+    _currentIndex = index;
+
+    markHierarchyChanged();
+
+    // only the current node is included in this node's bound
+    markBoundDirty();
+    if ( index >= 0 && index < static_cast< int >( getNodeCount() ) ) {
+        getNodeAt( index )->markWorldDirty();
+    }
+}
+
 void Switch::selectNextNode( void )
 {
     if ( !hasNodes() ) {
         return;
     }
 
-    _currentIndex = ( _currentIndex + 1 ) % getNodeCount();
+    setCurrentNodeIndex( ( _currentIndex + 1 ) % getNodeCount() );
 }
 
 void Switch::selectPrevNode( void )
@@ -66,7 +79,7 @@ void Switch::selectPrevNode( void )
         return;
     }
     
-    _currentIndex = ( _currentIndex + getNodeCount() - 1 ) % getNodeCount();
+    setCurrentNodeIndex( ( _currentIndex + getNodeCount() - 1 ) % getNodeCount() );
 }
 
 Node *Switch::getCurrentNode( void )
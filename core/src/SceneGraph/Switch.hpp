@@ -42,7 +42,7 @@ namespace crimild {
         Node *getCurrentNode( void );
         
         int getCurrentNodeIndex( void ) const { return _currentIndex; }
-        void setCurrentNodeIndex( int index ) { _currentIndex = index; }
+        void setCurrentNodeIndex( int index );
         
         void selectNextNode( void );
         void selectPrevNode( void );
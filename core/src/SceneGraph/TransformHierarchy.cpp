@@ -0,0 +1,302 @@
+/*
+ * Copyright (c) 2013, Hernan Saez
+ * All rights reserved.
+ * 
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *     * Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in the
+ *       documentation and/or other materials provided with the distribution.
+ *     * Neither the name of the <organization> nor the
+ *       names of its contributors may be used to endorse or promote products
+ *       derived from this software without specific prior written permission.
+ * 
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL <COPYRIGHT HOLDER> BE LIABLE FOR ANY
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "TransformHierarchy.hpp"
+#include "Node.hpp"
+#include "Group.hpp"
+
+#include "Concurrency/ParallelFor.hpp"
+#include "Visitors/NodeVisitor.hpp"
+
+using namespace crimild;
+using namespace crimild::concurrency;
+
+namespace crimild {
+
+	namespace internal {
+
+		/**
+		   \brief Collects the active children of a node, without recursion
+		 */
+		class CollectChildren : public NodeVisitor {
+		public:
+			explicit CollectChildren( std::vector< Node * > &nodes ) : _nodes( nodes ) { }
+			virtual ~CollectChildren( void ) { }
+
+			virtual void visitGroup( Group *group ) override
+			{
+				group->forEachNode( [ this ]( Node *node ) {
+					_nodes.push_back( node );
+				});
+			}
+
+		private:
+			std::vector< Node * > &_nodes;
+		};
+
+		/**
+		   \brief Levels smaller than this are updated in the calling thread
+		 */
+		const crimild::Size TRANSFORM_HIERARCHY_PARALLEL_THRESHOLD = 2048;
+
+		/**
+		   \brief Executes fn for a level, splitting big ones in parallel
+		 */
+		template< typename Fn >
+		void forEachLevelRange( crimild::Size begin, crimild::Size end, Fn const &fn )
+		{
+			if ( end - begin < TRANSFORM_HIERARCHY_PARALLEL_THRESHOLD ) {
+				fn( begin, end );
+				return;
+			}
+
+			parallel_for( Range( begin, end ), 0, [ &fn ]( Range const &r ) {
+				fn( r.begin, r.end );
+			});
+		}
+
+	}
+
+}
+
+TransformHierarchy::TransformHierarchy( void )
+	: _hasDirty( false ),
+	  _updatedNodeCount( 0 )
+{
+
+}
+
+TransformHierarchy::~TransformHierarchy( void )
+{
+	unbindAll();
+}
+
+void TransformHierarchy::invalidate( void )
+{
+	if ( _root == nullptr ) {
+		// already invalidated
+		return;
+	}
+
+	unbindAll();
+
+	_root = nullptr;
+	_nodes.clear();
+	_parents.clear();
+	_firstChild.clear();
+	_childCount.clear();
+	_local.clear();
+	_world.clear();
+	_localBounds.clear();
+	_worldBounds.clear();
+	_dirty.reset();
+	_changed.clear();
+	_levels.clear();
+	_hasDirty = false;
+}
+
+void TransformHierarchy::build( Node *root )
+{
+	invalidate();
+
+	if ( root == nullptr ) {
+		return;
+	}
+
+	// breadth-first, so parents precede children and siblings are adjacent
+	_nodes.push_back( root );
+	_parents.push_back( -1 );
+	_levels.push_back( 0 );
+
+	internal::CollectChildren collect( _nodes );
+	crimild::Size levelEnd = 1;
+	for ( crimild::Size i = 0; i < _nodes.size(); i++ ) {
+		if ( i == levelEnd ) {
+			_levels.push_back( i );
+			levelEnd = _nodes.size();
+		}
+
+		auto first = _nodes.size();
+		_nodes[ i ]->accept( collect );
+		auto count = _nodes.size() - first;
+
+		_firstChild.push_back( static_cast< crimild::UInt32 >( first ) );
+		_childCount.push_back( static_cast< crimild::UInt32 >( count ) );
+		_parents.resize( _nodes.size(), static_cast< crimild::Int32 >( i ) );
+	}
+	_levels.push_back( _nodes.size() );
+
+	auto count = _nodes.size();
+	_local.resize( count );
+	_world.resize( count );
+	_localBounds.resize( count );
+	_worldBounds.resize( count );
+	_dirty.reset( new std::atomic< crimild::UInt8 >[ count ] );
+	for ( crimild::Size i = 0; i < count; i++ ) {
+		_dirty[ i ].store( 1, std::memory_order_relaxed );
+	}
+	_changed.assign( count, 0 );
+
+	_root = root;
+	for ( crimild::Size i = 0; i < count; i++ ) {
+		bind( i );
+	}
+	_hasDirty = true;
+}
+
+void TransformHierarchy::bind( crimild::Size index )
+{
+	auto node = _nodes[ index ];
+
+	_local[ index ] = *node->_localTransform;
+	_world[ index ] = *node->_worldTransform;
+
+	node->_localTransform = &_local[ index ];
+	node->_worldTransform = &_world[ index ];
+	node->_transformHierarchy = this;
+	node->_transformIndex = index;
+
+	updateBounds( index, node );
+}
+
+void TransformHierarchy::unbindAll( void )
+{
+	for ( auto node : _nodes ) {
+		node->_local = *node->_localTransform;
+		node->_world = *node->_worldTransform;
+		node->_localTransform = &node->_local;
+		node->_worldTransform = &node->_world;
+		node->_transformHierarchy = nullptr;
+		node->_transformIndex = 0;
+	}
+}
+
+void TransformHierarchy::updateBounds( crimild::Size index, Node *node )
+{
+	_localBounds[ index ] = node->getLocalBound();
+	_worldBounds[ index ] = node->worldBound();
+	markDirty( index );
+}
+
+void TransformHierarchy::update( Node *root )
+{
+	if ( root != _root ) {
+		build( root );
+	}
+
+	_updatedNodeCount = 0;
+
+	if ( _root == nullptr || !_hasDirty.exchange( false, std::memory_order_acq_rel ) ) {
+		// nothing changed
+		return;
+	}
+
+	auto levelCount = getLevelCount();
+
+	// Levels are processed one at a time. forEachLevelRange() does not return
+	// until all jobs for a level are completed, so results for parents (top-down)
+	// or children (bottom-up) are always visible when the next level starts.
+
+	for ( crimild::Size l = 0; l < levelCount; l++ ) {
+		internal::forEachLevelRange( _levels[ l ], _levels[ l + 1 ], [ this ]( crimild::Size begin, crimild::Size end ) {
+			updateWorldTransforms( begin, end );
+		});
+	}
+
+	for ( crimild::Size l = levelCount; l > 0; l-- ) {
+		internal::forEachLevelRange( _levels[ l - 1 ], _levels[ l ], [ this ]( crimild::Size begin, crimild::Size end ) {
+			updateWorldBounds( begin, end );
+		});
+	}
+}
+
+void TransformHierarchy::updateWorldTransforms( crimild::Size begin, crimild::Size end )
+{
+	crimild::Size updatedCount = 0;
+
+	for ( auto i = begin; i < end; i++ ) {
+		auto parent = _parents[ i ];
+		auto changed = _dirty[ i ].exchange( 0, std::memory_order_relaxed ) != 0 || ( parent >= 0 && _changed[ parent ] );
+		_changed[ i ] = changed;
+
+		if ( !changed || _nodes[ i ]->worldIsCurrent() ) {
+			continue;
+		}
+
+		++_nodes[ i ]->_worldRevision;
+		++updatedCount;
+
+		if ( parent >= 0 ) {
+			_world[ i ].computeFrom( _world[ parent ], _local[ i ] );
+		}
+		else if ( _nodes[ i ]->hasParent() ) {
+			// the store may be bound to a subtree
+			_world[ i ].computeFrom( _nodes[ i ]->getParent()->getWorld(), _local[ i ] );
+		}
+		else {
+			_world[ i ] = _local[ i ];
+		}
+	}
+
+	_updatedNodeCount += updatedCount;
+}
+
+void TransformHierarchy::updateWorldBounds( crimild::Size begin, crimild::Size end )
+{
+	for ( auto i = begin; i < end; i++ ) {
+		auto first = _firstChild[ i ];
+		auto last = first + _childCount[ i ];
+
+		// children are always processed before their parents
+		auto changed = _changed[ i ] != 0;
+		for ( auto c = first; !changed && c < last; c++ ) {
+			changed = _changed[ c ] != 0;
+		}
+		_changed[ i ] = changed;
+
+		if ( !changed ) {
+			continue;
+		}
+
+		++_nodes[ i ]->_boundRevision;
+
+		auto bound = _worldBounds[ i ];
+
+		if ( !_nodes[ i ]->worldIsCurrent() ) {
+			bound->computeFrom( _localBounds[ i ], _world[ i ] );
+		}
+
+		for ( auto c = first; c < last; c++ ) {
+			if ( c == first ) {
+				bound->computeFrom( _worldBounds[ c ] );
+			}
+			else {
+				bound->expandToContain( _worldBounds[ c ] );
+			}
+		}
+	}
+}
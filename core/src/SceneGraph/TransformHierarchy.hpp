@@ -0,0 +1,168 @@
+/*
+ * Copyright (c) 2013, Hernan Saez
+ * All rights reserved.
+ * 
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *     * Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in the
+ *       documentation and/or other materials provided with the distribution.
+ *     * Neither the name of the <organization> nor the
+ *       names of its contributors may be used to endorse or promote products
+ *       derived from this software without specific prior written permission.
+ * 
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL <COPYRIGHT HOLDER> BE LIABLE FOR ANY
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef CRIMILD_SCENE_GRAPH_TRANSFORM_HIERARCHY_
+#define CRIMILD_SCENE_GRAPH_TRANSFORM_HIERARCHY_
+
+#include "Foundation/SharedObject.hpp"
+#include "Foundation/Types.hpp"
+#include "Mathematics/Transformation.hpp"
+
+#include <atomic>
+#include <memory>
+#include <vector>
+
+namespace crimild {
+
+	class Node;
+	class BoundingVolume;
+
+	/**
+	   \brief A flat store for the transformations of a scene
+
+	   Nodes are stored in contiguous arrays sorted by hierarchy level
+	   (breadth-first), so every parent precedes its children and all of
+	   the children of a node are adjacent. Once a scene is bound to the
+	   store, Node::getLocal() and Node::getWorld() return references to
+	   elements of these arrays instead of the node's own members.
+
+	   Modifying a node's local transformation marks it as dirty and update()
+	   only recomputes world transformations for dirty subtrees. Levels
+	   are processed in order and each one is split in parallel. World
+	   bounds are then propagated bottom-up only for the affected branches.
+
+	   The store follows the same rules as UpdateWorldState: disabled nodes
+	   and inactive Switch children are not included, and nodes flagged 
+	   with worldIsCurrent() keep their world transformation untouched.
+
+	   Attaching, detaching, enabling or disabling nodes invalidates the 
+	   store, which is rebuilt on the next update. All nodes are unbound 
+	   when invalidated, so they remain valid even if the store is destroyed.
+	 */
+	class TransformHierarchy : public SharedObject {
+	public:
+		TransformHierarchy( void );
+		virtual ~TransformHierarchy( void );
+
+		Node *getRoot( void ) { return _root; }
+
+		crimild::Size getNodeCount( void ) const { return _nodes.size(); }
+		crimild::Size getLevelCount( void ) const { return _levels.empty() ? 0 : _levels.size() - 1; }
+
+		/**
+		   \brief Recomputes world transformations and bounds for all dirty subtrees
+
+		   The store is rebuilt first if the hierarchy changed or if root is
+		   not the one currently bound.
+		 */
+		void update( Node *root );
+
+		/**
+		   \brief Unbinds all nodes and forces a rebuild on the next update
+		 */
+		void invalidate( void );
+
+		bool isValid( void ) const { return _root != nullptr; }
+
+		/**
+		   \brief Number of nodes whose world transformation changed during the last update
+		 */
+		crimild::Size getUpdatedNodeCount( void ) const { return _updatedNodeCount; }
+
+		/**
+		   \brief Flags a node's local transformation as modified
+		 */
+		void markDirty( crimild::Size index )
+		{
+			_dirty[ index ].store( 1, std::memory_order_relaxed );
+			_hasDirty.store( true, std::memory_order_release );
+		}
+
+		/**
+		   \brief Refreshes the bounding volume references for a node
+
+		   Invoked when a node replaces its local or world bound
+		 */
+		void updateBounds( crimild::Size index, Node *node );
+
+	private:
+		void build( Node *root );
+		void bind( crimild::Size index );
+		void unbindAll( void );
+
+		void updateWorldTransforms( crimild::Size begin, crimild::Size end );
+		void updateWorldBounds( crimild::Size begin, crimild::Size end );
+
+	private:
+		Node *_root = nullptr;
+
+		std::vector< Node * > _nodes;
+		std::vector< crimild::Int32 > _parents;
+		std::vector< crimild::UInt32 > _firstChild;
+		std::vector< crimild::UInt32 > _childCount;
+
+		std::vector< Transformation > _local;
+		std::vector< Transformation > _world;
+
+		std::vector< const BoundingVolume * > _localBounds;
+		std::vector< BoundingVolume * > _worldBounds;
+
+		/**
+		   \brief Nodes whose local transformation or bounds were modified
+
+		   Stored as atomics, since flags are read and cleared by the jobs
+		   processing each level
+		 */
+		std::unique_ptr< std::atomic< crimild::UInt8 >[] > _dirty;
+
+		/**
+		   \brief Indicates which nodes were updated in the current pass
+
+		   During the top-down pass, a node changes if it's dirty or if its
+		   parent changed. During the bottom-up pass, it also changes if
+		   any of its children's bounds changed.
+
+		   Each element is only written by the job processing its node. 
+		   Parents and children belong to other levels, which are read
+		   only after their level is completed (see update()).
+		 */
+		std::vector< crimild::UInt8 > _changed;
+
+		/**
+		   \brief Offsets for each level (plus one at the end)
+		 */
+		std::vector< crimild::Size > _levels;
+
+		std::atomic< bool > _hasDirty;
+		std::atomic< crimild::Size > _updatedNodeCount;
+	};
+
+	using TransformHierarchyPtr = SharedPointer< TransformHierarchy >;
+
+}
+
+#endif
@@ -33,6 +33,9 @@ using namespace crimild;
 const char *Settings::SETTINGS_RENDERING_SHADOWS_ENABLED = "crimild.rendering.shadows.enabled";
 const char *Settings::SETTINGS_RENDERING_SHADOWS_RESOLUTION_WIDTH = "crimild.rendering.shadows.resolution.width";
 const char *Settings::SETTINGS_RENDERING_SHADOWS_RESOLUTION_HEIGHT = "crimild.rendering.shadows.resolution.height";
+const char *Settings::SETTINGS_SIMULATION_TRANSFORM_HIERARCHY_ENABLED = "crimild.simulation.transformHierarchy.enabled";
+const char *Settings::SETTINGS_SIMULATION_SPATIAL_INDEX_ENABLED = "crimild.simulation.spatialIndex.enabled";
+const char *Settings::SETTINGS_SIMULATION_PARALLEL_PARTICLES_ENABLED = "crimild.simulation.parallelParticles.enabled";
 
 Settings::Settings( void )
 {
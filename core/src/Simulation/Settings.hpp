@@ -42,6 +42,9 @@ namespace crimild {
     	static const char *SETTINGS_RENDERING_SHADOWS_ENABLED;
     	static const char *SETTINGS_RENDERING_SHADOWS_RESOLUTION_WIDTH;
     	static const char *SETTINGS_RENDERING_SHADOWS_RESOLUTION_HEIGHT;
+    	static const char *SETTINGS_SIMULATION_TRANSFORM_HIERARCHY_ENABLED;
+    	static const char *SETTINGS_SIMULATION_SPATIAL_INDEX_ENABLED;
+    	static const char *SETTINGS_SIMULATION_PARALLEL_PARTICLES_ENABLED;
 
 	public:
 		Settings( void );
@@ -116,6 +116,9 @@ void RenderSystem::renderFrame( void )
         renderer->endRender();
     }
 
+    CRIMILD_PROFILE_COUNTER( "Renderer: Issued State Changes", renderer->getStateCache()->getIssuedCount() )
+    CRIMILD_PROFILE_COUNTER( "Renderer: Filtered State Changes", renderer->getStateCache()->getFilteredCount() )
+
     broadcastMessage( messaging::DidRenderScene {} );
 }
 
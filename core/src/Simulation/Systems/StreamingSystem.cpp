@@ -32,13 +32,30 @@
  
 #include "Concurrency/Async.hpp"
 
+#include "SceneGraph/Group.hpp"
+#include "SceneGraph/Geometry.hpp"
+#include "Components/MaterialComponent.hpp"
+#include "Rendering/Renderer.hpp"
+#include "Rendering/Material.hpp"
+#include "Primitives/Primitive.hpp"
+#include "Visitors/Apply.hpp"
+#include "Visitors/UpdateWorldState.hpp"
+#include "Visitors/UpdateRenderState.hpp"
+#include "Visitors/StartComponents.hpp"
+
+#include <chrono>
+#include <unordered_set>
+
 using namespace crimild;
 
 StreamingSystem::StreamingSystem( void )
+    : _sceneGeneration( 0 ),
+      _lastLoadId( 0 )
 {
 	CRIMILD_BIND_MEMBER_MESSAGE_HANDLER( messaging::LoadScene, StreamingSystem, onLoadScene );
 	CRIMILD_BIND_MEMBER_MESSAGE_HANDLER( messaging::AppendScene, StreamingSystem, onAppendScene );
 	CRIMILD_BIND_MEMBER_MESSAGE_HANDLER( messaging::ReloadScene, StreamingSystem, onReloadScene );
+	CRIMILD_BIND_MEMBER_MESSAGE_HANDLER( messaging::RemoveScene, StreamingSystem, onRemoveScene );
 }
 
 StreamingSystem::~StreamingSystem( void )
@@ -48,30 +65,135 @@ StreamingSystem::~StreamingSystem( void )
 
 bool StreamingSystem::start( void )
 {
-    return System::start();
+    if ( !System::start() ) {
+        return false;
+    }
+
+    crimild::concurrency::sync_frame( std::bind( &StreamingSystem::integrate, this ) );
+
+    return true;
 }
 
 void StreamingSystem::stop( void )
 {
+    System::stop();
 
+    {
+        std::lock_guard< std::mutex > lock( _incomingMutex );
+        _incoming.clear();
+    }
+
+    _pending.clear();
+    _appendedSubtrees.clear();
+    _removedLoads.clear();
 }
 
-void StreamingSystem::onLoadScene( messaging::LoadScene const &message )
+crimild::Bool StreamingSystem::canLoad( std::string fileName )
 {
-    auto fileName = message.fileName;
     auto fileType = StringUtils::getFileExtension( fileName );
 
-    if ( !_builders.contains( fileType ) ) {
+    if ( !_builders.contains( fileType ) && !_streamingBuilders.contains( fileType ) ) {
         std::string message = "Cannot find builder for file" + fileName;
         crimild::Log::error( CRIMILD_CURRENT_CLASS_NAME, message );
         broadcastMessage( messaging::SceneLoadFailed { fileName, message } );
+        return false;
+    }
+
+    return true;
+}
+
+void StreamingSystem::onLoadScene( messaging::LoadScene const &message )
+{
+    auto fileName = message.fileName;
+    auto fileType = StringUtils::getFileExtension( fileName );
+
+    if ( !canLoad( fileName ) ) {
         return;
     }
 
     _lastSceneFileName = fileName;
-    auto builder = _builders[ fileType ];
 
-    crimild::concurrency::async_frame( [ builder, fileName ] {
+    if ( _streamingBuilders.contains( fileType ) ) {
+        streamScene( fileName );
+    }
+    else {
+        loadScene( fileName );
+    }
+}
+
+void StreamingSystem::onAppendScene( messaging::AppendScene const &message )
+{
+    auto fileName = message.fileName;
+
+    if ( !canLoad( fileName ) ) {
+        return;
+    }
+
+    auto parentNode = message.parentNode != nullptr ? message.parentNode : Simulation::getInstance()->getScene();
+    auto parent = dynamic_cast< Group * >( parentNode );
+    if ( parent == nullptr ) {
+        std::string message = "Cannot append scene from file " + fileName + ". Parent node must be a group";
+        crimild::Log::error( CRIMILD_CURRENT_CLASS_NAME, message );
+        broadcastMessage( messaging::SceneLoadFailed { fileName, message } );
+        return;
+    }
+
+    appendScene( fileName, crimild::retain( parent ) );
+}
+
+void StreamingSystem::onReloadScene( messaging::ReloadScene const &message )
+{
+    auto fileName = _lastSceneFileName;
+    auto fileType = StringUtils::getFileExtension( fileName );
+
+    if ( !canLoad( fileName ) ) {
+        return;
+    }
+
+    auto streaming = _streamingBuilders.contains( fileType );
+
+    crimild::concurrency::sync_frame( [ this, fileName, streaming ] {
+        Simulation::getInstance()->setScene( nullptr );
+
+        if ( streaming ) {
+            streamScene( fileName );
+        }
+        else {
+            loadScene( fileName );
+        }
+    });
+}
+
+void StreamingSystem::onRemoveScene( messaging::RemoveScene const &message )
+{
+    auto fileName = message.fileName;
+
+    // discard anything that is still loading
+    _removedLoads[ fileName ] = _lastLoadId;
+
+    if ( !_appendedSubtrees.contains( fileName ) ) {
+        return;
+    }
+
+    // subtrees are detached across frames as well
+    auto generation = _sceneGeneration.load();
+    for ( auto &subtree : _appendedSubtrees[ fileName ] ) {
+        PendingSubtree pending;
+        pending.action = PendingSubtree::Action::DETACH;
+        pending.subtree = subtree;
+        pending.generation = generation;
+        _pending.push_back( std::move( pending ) );
+    }
+
+    _appendedSubtrees.remove( fileName );
+}
+
+void StreamingSystem::loadScene( std::string fileName )
+{
+    auto builder = _builders[ StringUtils::getFileExtension( fileName ) ];
+    auto generation = ++_sceneGeneration;
+
+    crimild::concurrency::async_frame( [ this, builder, fileName, generation ] {
         AssetManager::getInstance()->clear();
 
         auto scene = builder( fileName );
@@ -81,50 +203,288 @@ void StreamingSystem::onLoadScene( messaging::LoadScene const &message )
             MessageQueue::getInstance()->broadcastMessage( messaging::SceneLoadFailed { fileName, message } );
             return;
         }
-        
-        crimild::concurrency::sync_frame( [ scene ] {
-            Simulation::getInstance()->setScene( scene );
-        });
+
+        PendingSubtree pending;
+        pending.subtree = scene;
+        pending.generation = generation;
+        enqueue( std::move( pending ) );
     });
 }
 
-void StreamingSystem::onAppendScene( messaging::AppendScene const &message )
+void StreamingSystem::streamScene( std::string fileName )
 {
-    // TODO
+    auto builder = _streamingBuilders[ StringUtils::getFileExtension( fileName ) ];
+    auto generation = ++_sceneGeneration;
+
+    crimild::concurrency::async_frame( [ this, builder, fileName, generation ] {
+        AssetManager::getInstance()->clear();
+
+        auto scene = crimild::alloc< Group >( fileName );
+        auto first = true;
+
+        auto success = builder( fileName, [ this, scene, generation, &first ]( SharedPointer< Node > const &subtree ) {
+            PendingSubtree pending;
+            pending.generation = generation;
+
+            if ( first ) {
+                // the first subtree sets up the scene (i.e. cameras). It's safe 
+                // to modify the scene here since it's not in use yet
+                first = false;
+                scene->attachNode( subtree );
+                pending.subtree = scene;
+            }
+            else {
+                pending.subtree = subtree;
+                pending.parent = scene;
+            }
+
+            enqueue( std::move( pending ) );
+        });
+
+        if ( !success ) {
+            std::string message = "Cannot load scene from file: " + fileName;
+            crimild::Log::error( CRIMILD_CURRENT_CLASS_NAME, message );
+            MessageQueue::getInstance()->broadcastMessage( messaging::SceneLoadFailed { fileName, message } );
+        }
+    });
 }
 
-void StreamingSystem::onReloadScene( messaging::ReloadScene const &message )
+void StreamingSystem::appendScene( std::string fileName, SharedPointer< Group > const &parent )
 {
-    auto fileName = _lastSceneFileName;
     auto fileType = StringUtils::getFileExtension( fileName );
+    auto streamingBuilder = _streamingBuilders.contains( fileType ) ? _streamingBuilders[ fileType ] : nullptr;
+    auto builder = streamingBuilder == nullptr ? _builders[ fileType ] : nullptr;
+    auto generation = _sceneGeneration.load();
+    auto loadId = ++_lastLoadId;
+
+    crimild::concurrency::async_frame( [ this, streamingBuilder, builder, fileName, parent, generation, loadId ] {
+        auto onSubtree = [ this, fileName, parent, generation, loadId ]( SharedPointer< Node > const &subtree ) {
+            PendingSubtree pending;
+            pending.subtree = subtree;
+            pending.parent = parent;
+            pending.fileName = fileName;
+            pending.loadId = loadId;
+            pending.generation = generation;
+            enqueue( std::move( pending ) );
+        };
+
+        auto success = false;
+        if ( streamingBuilder != nullptr ) {
+            success = streamingBuilder( fileName, onSubtree );
+        }
+        else if ( auto subtree = builder( fileName ) ) {
+            onSubtree( subtree );
+            success = true;
+        }
+
+        if ( !success ) {
+            std::string message = "Cannot append scene from file: " + fileName;
+            crimild::Log::error( CRIMILD_CURRENT_CLASS_NAME, message );
+            MessageQueue::getInstance()->broadcastMessage( messaging::SceneLoadFailed { fileName, message } );
+        }
+    });
+}
+
+namespace crimild {
+
+    namespace internal {
+
+        /**
+           \brief Creates a step loading a resource into the renderer's catalog
+
+           Resources are skipped if they were loaded already (i.e. shared ones)
+         */
+        template< typename RESOURCE_TYPE >
+        std::function< void( Renderer * ) > uploadResource( RESOURCE_TYPE *resource, Catalog< RESOURCE_TYPE > *( Renderer::*getCatalog )( void ) )
+        {
+            return [ resource, getCatalog ]( Renderer *renderer ) {
+                auto catalog = ( renderer->*getCatalog )();
+                if ( catalog != nullptr && resource->getCatalog() == nullptr ) {
+                    catalog->load( resource );
+                }
+            };
+        }
 
-    if ( !_builders.contains( fileType ) ) {
-        std::string message = "Cannot find builder for file" + fileName;
-        crimild::Log::error( CRIMILD_CURRENT_CLASS_NAME, message );
-        broadcastMessage( messaging::SceneLoadFailed { fileName, message } );
-        return;
     }
 
-    auto builder = _builders[ fileType ];
+}
 
-    crimild::concurrency::sync_frame( [ builder, fileName ] {
-        Simulation::getInstance()->setScene( nullptr );
+void StreamingSystem::enqueue( PendingSubtree &&pending )
+{
+    // Collect resources on the calling thread, since traversing big 
+    // subtrees might be expensive. Subtrees are not in use yet
+    std::unordered_set< void * > visited;
+    auto &uploads = pending.uploads;
 
-        crimild::concurrency::async_frame( [ builder, fileName ] {
-            AssetManager::getInstance()->clear();
+    auto addTexture = [ &uploads, &visited ]( Texture *texture ) {
+        if ( texture != nullptr && visited.insert( texture ).second ) {
+            uploads.push_back( internal::uploadResource( texture, &Renderer::getTextureCatalog ) );
+        }
+    };
 
-            auto scene = builder( fileName );
-            if ( scene == nullptr ) {
-                std::string message = "Cannot load scene from file: " + fileName;
-                crimild::Log::error( CRIMILD_CURRENT_CLASS_NAME, message );
-                MessageQueue::getInstance()->broadcastMessage( messaging::SceneLoadFailed { fileName, message } );
-                return;
+    pending.subtree->perform( Apply( [ &uploads, &visited, &addTexture ]( Node *node ) {
+        auto geometry = dynamic_cast< Geometry * >( node );
+        if ( geometry == nullptr ) {
+            return;
+        }
+
+        geometry->forEachPrimitive( [ &uploads, &visited ]( Primitive *primitive ) {
+            auto vbo = primitive->getVertexBuffer();
+            if ( vbo != nullptr && visited.insert( vbo ).second ) {
+                uploads.push_back( internal::uploadResource( vbo, &Renderer::getVertexBufferObjectCatalog ) );
+            }
+
+            auto ibo = primitive->getIndexBuffer();
+            if ( ibo != nullptr && visited.insert( ibo ).second ) {
+                uploads.push_back( internal::uploadResource( ibo, &Renderer::getIndexBufferObjectCatalog ) );
             }
-            
-            crimild::concurrency::sync_frame( [ scene ] {
-                Simulation::getInstance()->setScene( scene );
+        });
+
+        if ( auto materials = geometry->getComponent< MaterialComponent >() ) {
+            materials->forEachMaterial( [ &addTexture ]( Material *material ) {
+                addTexture( material->getColorMap() );
+                addTexture( material->getNormalMap() );
+                addTexture( material->getSpecularMap() );
+                addTexture( material->getEmissiveMap() );
             });
-        });        
-    });
+        }
+    }));
+
+    std::lock_guard< std::mutex > lock( _incomingMutex );
+    _incoming.push_back( std::move( pending ) );
+}
+
+void StreamingSystem::integrate( void )
+{
+    CRIMILD_PROFILE( "Streaming System" )
+
+    using Clock = std::chrono::high_resolution_clock;
+    auto startTime = Clock::now();
+    auto elapsedMicroseconds = [ startTime ]( void ) -> crimild::Size {
+        return std::chrono::duration_cast< std::chrono::microseconds >( Clock::now() - startTime ).count();
+    };
+
+    {
+        std::lock_guard< std::mutex > lock( _incomingMutex );
+        _pending.splice( _pending.end(), _incoming );
+    }
+
+    auto generation = _sceneGeneration.load();
+    if ( generation != _integratedGeneration ) {
+        // appended subtrees belong to a previous scene
+        _integratedGeneration = generation;
+        _appendedSubtrees.clear();
+        _removedLoads.clear();
+    }
+
+    const auto budget = static_cast< crimild::Size >( 1000.0 * getFrameBudget() );
+
+    crimild::Size steps = 0;
+    while ( !_pending.empty() ) {
+        if ( steps > 0 && elapsedMicroseconds() >= budget ) {
+            break;
+        }
+
+        if ( integrateStep( _pending.front() ) ) {
+            // discarded subtrees are destroyed here, within budget
+            _pending.pop_front();
+        }
+
+        ++steps;
+    }
+
+    CRIMILD_PROFILE_COUNTER( "Streaming: Integration Time (us)", elapsedMicroseconds() )
+    CRIMILD_PROFILE_COUNTER( "Streaming: Integration Steps", steps )
+    CRIMILD_PROFILE_COUNTER( "Streaming: Pending Subtrees", _pending.size() )
+    CRIMILD_PROFILE_COUNTER( "Streaming: Uploaded Resources", _uploadCount )
+
+    // schedule next integration
+    crimild::concurrency::sync_frame( std::bind( &StreamingSystem::integrate, this ) );
+}
+
+crimild::Bool StreamingSystem::isDiscarded( PendingSubtree const &pending )
+{
+    if ( pending.generation != _sceneGeneration.load() ) {
+        // scene changed while loading
+        return true;
+    }
+
+    if ( pending.action == PendingSubtree::Action::ATTACH && !pending.fileName.empty() && _removedLoads.contains( pending.fileName ) ) {
+        // removed while loading
+        return pending.loadId <= _removedLoads[ pending.fileName ];
+    }
+
+    return false;
 }
 
+crimild::Bool StreamingSystem::integrateStep( PendingSubtree &pending )
+{
+    if ( isDiscarded( pending ) ) {
+        return true;
+    }
+
+    if ( pending.action == PendingSubtree::Action::DETACH ) {
+        detachSubtree( pending );
+        return true;
+    }
+
+    if ( pending.nextUpload < pending.uploads.size() ) {
+        auto renderer = Simulation::getInstance()->getRenderer();
+        if ( renderer == nullptr ) {
+            // nothing to upload to
+            pending.nextUpload = pending.uploads.size();
+            return false;
+        }
+
+        pending.uploads[ pending.nextUpload++ ]( renderer );
+        ++_uploadCount;
+        return false;
+    }
+
+    attachSubtree( pending );
+    return true;
+}
+
+void StreamingSystem::attachSubtree( PendingSubtree &pending )
+{
+    auto subtree = pending.subtree;
+
+    if ( pending.parent == nullptr ) {
+        Simulation::getInstance()->setScene( subtree );
+        return;
+    }
+
+    pending.parent->attachNode( subtree );
+    subtree->perform( UpdateWorldState() );
+    subtree->perform( StartComponents() );
+    subtree->perform( UpdateWorldState() );
+
+    if ( subtree->getSubtreeLightCount() > 0 ) {
+        // new lights affect the rest of the scene too
+        subtree->getRootParent()->perform( UpdateRenderState() );
+    }
+    else {
+        subtree->perform( UpdateRenderState() );
+    }
+
+    if ( !pending.fileName.empty() ) {
+        _appendedSubtrees[ pending.fileName ].push_back( subtree );
+    }
+}
+
+void StreamingSystem::detachSubtree( PendingSubtree &pending )
+{
+    auto subtree = pending.subtree;
+    if ( !subtree->hasParent() ) {
+        return;
+    }
+
+    auto root = subtree->getRootParent();
+    auto hasLights = subtree->getSubtreeLightCount() > 0;
+
+    subtree->detachFromParent();
+
+    if ( hasLights ) {
+        root->perform( UpdateRenderState() );
+    }
+}
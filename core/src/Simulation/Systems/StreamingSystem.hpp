@@ -31,10 +31,15 @@
 #include "System.hpp"
 
 #include "Foundation/Containers/Map.hpp"
+#include "SceneGraph/Node.hpp"
 
-namespace crimild {
+#include <atomic>
+#include <functional>
+#include <list>
+#include <mutex>
+#include <vector>
 
-	class Node;
+namespace crimild {
 
 	namespace messaging {
 
@@ -42,11 +47,26 @@ namespace crimild {
 			std::string fileName;
 		};
 
+		/**
+			\brief Loads a file and attaches its contents to an existing node
+
+			If parentNode is null, subtrees are attached to the current scene.
+			In both cases, the target node must be a group.
+		 */
 		struct AppendScene {
 			std::string fileName;
 			Node *parentNode;
 		};
 
+		/**
+			\brief Detaches all subtrees appended from a file (see AppendScene)
+
+			Subtrees that are still loading are discarded as well
+		 */
+		struct RemoveScene {
+			std::string fileName;
+		};
+
 		struct ReloadScene { };
 
 		struct SceneLoadFailed {
@@ -56,6 +76,18 @@ namespace crimild {
 		
 	}
 
+	class Group;
+	class Renderer;
+
+	/**
+		\brief Loads scenes in the background
+
+		Subtrees are built on worker threads and then integrated into the 
+		simulation on the main thread, one step at a time: GPU resources are 
+		uploaded through the renderer's catalogs first and then the subtree is
+		attached and started. Steps are spread across frames so they don't take
+		more than getFrameBudget() milliseconds per frame.
+	 */
 	class StreamingSystem : public System {
 		CRIMILD_IMPLEMENT_RTTI( crimild::StreamingSystem )
 		
@@ -89,14 +121,173 @@ namespace crimild {
 			});
 		}
 
+		/**
+			\brief Builds a scene incrementally
+
+			The callback must be invoked for every subtree as soon as it's ready.
+			Returns false if the file cannot be loaded.
+		 */
+		using StreamingBuilder = std::function< crimild::Bool( std::string, std::function< void( SharedPointer< Node > const & ) > const & ) >;
+
+		/**
+			\brief Register a builder for incremental loading 
+
+			Subtrees are attached to the current scene as soon as they are 
+			built, before the whole file is loaded.
+		 */
+		void registerStreamingBuilder( std::string extension, StreamingBuilder const &builder ) { _streamingBuilders[ extension ] = builder; }
+
+		/**
+			\brief Register a decoder supporting incremental reads (i.e. FileDecoder)
+
+			Each root object in the file is handled as a different subtree
+		 */
+		template< class DECODER_CLASS >
+		void registerStreamingDecoder( std::string extension )
+		{
+			registerStreamingBuilder( extension, []( std::string filePath, std::function< void( SharedPointer< Node > const & ) > const &callback ) -> crimild::Bool {
+				auto decoder = crimild::alloc< DECODER_CLASS >();
+				return decoder->read( filePath, [ &callback ]( SharedPointer< SharedObject > const &obj ) {
+					auto node = crimild::dynamic_cast_ptr< Node >( obj );
+					if ( node != nullptr ) {
+						callback( node );
+					}
+				});
+			});
+		}
+
+		/**
+			\brief Maximum time spent integrating subtrees every frame, in milliseconds
+
+			At least one step is executed every frame, so loading always
+			makes progress even if a single step exceeds the budget.
+		 */
+		crimild::Real64 getFrameBudget( void ) const { return _frameBudget; }
+		void setFrameBudget( crimild::Real64 milliseconds ) { _frameBudget = milliseconds; }
+
+	private:
+		crimild::Real64 _frameBudget = 2.0;
+
 	private:
 		void onLoadScene( messaging::LoadScene const &message );
 		void onAppendScene( messaging::AppendScene const &message );
 		void onReloadScene( messaging::ReloadScene const &message );
+		void onRemoveScene( messaging::RemoveScene const &message );
         
+		/**
+			\brief Loads a scene on a background thread and sets it as the current one
+		 */
+		void loadScene( std::string fileName );
+
+		/**
+			\brief Loads a scene incrementally on a background thread
+
+			The first subtree becomes the current scene (wrapped in a group), while 
+			the following ones are attached to it as they are loaded
+		 */
+		void streamScene( std::string fileName );
+
+		/**
+			\brief Loads a file on a background thread and attaches its subtrees to parent
+		 */
+		void appendScene( std::string fileName, SharedPointer< Group > const &parent );
+
+		/**
+			\brief Checks if there's a builder for the given file, broadcasting SceneLoadFailed otherwise
+		 */
+		crimild::Bool canLoad( std::string fileName );
+
 	private:
 		containers::Map< std::string, Builder > _builders;
+		containers::Map< std::string, StreamingBuilder > _streamingBuilders;
 		std::string _lastSceneFileName;
+
+		/**
+			\name Main thread integration
+		 */
+		//@{
+
+	private:
+		/**
+			\brief A subtree waiting to be attached to (or detached from) the simulation
+		 */
+		struct PendingSubtree {
+			enum class Action {
+				ATTACH,
+				DETACH,
+			};
+
+			Action action = Action::ATTACH;
+			SharedPointer< Node > subtree;
+
+			/**
+				\brief The node the subtree is attached to
+
+				If null, the subtree becomes the current scene
+			 */
+			SharedPointer< Group > parent;
+
+			/**
+				\brief The file an appended subtree comes from. Empty otherwise
+			 */
+			std::string fileName;
+			crimild::UInt32 loadId = 0;
+			crimild::UInt32 generation = 0;
+
+			/**
+				\brief GPU resources to be loaded before attaching the subtree
+			 */
+			std::vector< std::function< void( Renderer * ) >> uploads;
+			crimild::Size nextUpload = 0;
+		};
+
+		/**
+			\brief Queues a subtree for integration. Can be called from any thread
+
+			Resources that need to be uploaded are collected on the calling thread.
+		 */
+		void enqueue( PendingSubtree &&pending );
+
+		/**
+			\brief Integrates pending subtrees until the frame budget is exhausted
+
+			Executed once per frame on the main thread
+		 */
+		void integrate( void );
+
+		/**
+			\brief Executes a single integration step
+
+			Returns true once the subtree has been fully integrated (or discarded)
+		 */
+		crimild::Bool integrateStep( PendingSubtree &pending );
+
+		void attachSubtree( PendingSubtree &pending );
+		void detachSubtree( PendingSubtree &pending );
+
+		/**
+			\brief Checks if a subtree must be discarded before being integrated
+		 */
+		crimild::Bool isDiscarded( PendingSubtree const &pending );
+
+	private:
+		std::mutex _incomingMutex;
+		std::list< PendingSubtree > _incoming;
+
+		// only accessed from the main thread
+		std::list< PendingSubtree > _pending;
+		containers::Map< std::string, std::vector< SharedPointer< Node >>> _appendedSubtrees;
+		containers::Map< std::string, crimild::UInt32 > _removedLoads;
+		crimild::UInt32 _integratedGeneration = 0;
+		crimild::Size _uploadCount = 0;
+
+		/**
+			\brief Increased every time the scene is replaced, discarding pending subtrees
+		 */
+		std::atomic< crimild::UInt32 > _sceneGeneration;
+		std::atomic< crimild::UInt32 > _lastLoadId;
+
+		//@}
 	};
 
 }
@@ -2,6 +2,7 @@
 #include "RenderSystem.hpp"
 
 #include "Concurrency/Async.hpp"
+#include "Concurrency/TaskGraph.hpp"
 
 #include "Visitors/UpdateWorldState.hpp"
 #include "Visitors/ComputeRenderQueue.hpp"
@@ -60,65 +61,193 @@ void UpdateSystem::update( void )
     // prevent integration errors when delta is too big (i.e. after loading a new scene)
     _accumulator += Numericd::min( 4 * Clock::getScaledTickTime(), c.getDeltaTime() );
 
-	updateBehaviors( crimild::get_ptr( scene ) );
-
-    computeRenderQueues( crimild::get_ptr( scene ) );
+	updateFrame( crimild::get_ptr( scene ) );
     
     // schedule next update
     crimild::concurrency::sync_frame( std::bind( &UpdateSystem::update, this ) );
 }
 
-void UpdateSystem::updateBehaviors( Node *scene )
+void UpdateSystem::updateFrame( Node *scene )
 {
+	using concurrency::TaskGraph;
+
     broadcastMessage( messaging::WillUpdateScene { scene } );
 
+	// Describe the whole frame as a graph. Components are not thread-safe
+	// and messages must be broadcasted from this thread, so only render
+	// queues (one per camera) are computed in parallel. Big scenes are 
+	// further split into subtree jobs (see ComputeRenderQueue)
+	TaskGraph frame;
+
+	auto updateComponents = frame.addTask( "Update Components", [ this, scene ] {
+		updateBehaviors( scene );
+	}, TaskGraph::Affinity::CALLER );
+
+	auto updateWorld = frame.addTask( "Update World State", [ this, scene ] {
+		updateWorldState( scene );
+	}, TaskGraph::Affinity::CALLER );
+	frame.addDependency( updateWorld, updateComponents );
+
+	auto didUpdate = frame.addTask( "Did Update Scene", [ this, scene ] {
+	    broadcastMessage( messaging::DidUpdateScene { scene } );
+	}, TaskGraph::Affinity::CALLER );
+	frame.addDependency( didUpdate, updateWorld );
+
+	// the index is shared by all cameras and it's only read while computing
+	// render queues, so it must be updated before any of them starts
+	SpatialIndex *spatialIndex = nullptr;
+	auto updateIndex = frame.addTask( "Update Spatial Index", [ this, scene, &spatialIndex ] {
+		spatialIndex = updateSpatialIndex( scene );
+	}, TaskGraph::Affinity::CALLER );
+	frame.addDependency( updateIndex, didUpdate );
+
+	crimild::Size cameraCount = 0;
+	Simulation::getInstance()->forEachCamera( [ this, &frame, &cameraCount, &spatialIndex, updateIndex, scene ]( Camera *camera ) {
+		if ( camera == nullptr ) {
+			return;
+		}
+
+		auto idx = cameraCount++;
+		if ( idx == _cameraQueues.size() ) {
+			_cameraQueues.push_back( CameraQueue() );
+		}
+
+		auto &entry = _cameraQueues[ idx ];
+		if ( entry.camera != camera ) {
+			entry.camera = camera;
+			entry.renderQueue = crimild::alloc< RenderQueue >();
+			entry.computeRenderQueue = crimild::alloc_unique< ComputeRenderQueue >( camera, crimild::get_ptr( entry.renderQueue ) );
+		}
+		entry.active = false;
+		entry.visitedNodeCount = 0;
+		entry.jobCount = 0;
+
+		auto task = frame.addTask( "Compute Render Queue", [ this, &spatialIndex, idx, scene ] {
+			auto &entry = _cameraQueues[ idx ];
+
+			// cameras might be enabled or disabled while updating components
+			if ( entry.camera->isEnabled() ) {
+				entry.computeRenderQueue->setSpatialIndex( spatialIndex );
+				scene->perform( *entry.computeRenderQueue );
+				entry.visitedNodeCount = entry.computeRenderQueue->getVisitedNodeCount();
+				entry.jobCount = entry.computeRenderQueue->getJobCount();
+				entry.active = true;
+			}
+		});
+		frame.addDependency( task, updateIndex );
+	});
+
+	// discard queues for cameras that are no longer available
+	_cameraQueues.resize( cameraCount );
+
+	{
+		CRIMILD_PROFILE( "Update Frame" )
+		frame.execute();
+	}
+
+	crimild::Size visitedNodeCount = 0;
+	crimild::Size jobCount = 0;
+	for ( auto &entry : _cameraQueues ) {
+		visitedNodeCount += entry.visitedNodeCount;
+		jobCount += entry.jobCount;
+	}
+	CRIMILD_PROFILE_COUNTER( "Render Queues: Visited Nodes", visitedNodeCount )
+	CRIMILD_PROFILE_COUNTER( "Render Queues: Subtree Jobs", jobCount )
+
+	// keep the same order as cameras
+	containers::Array< SharedPointer< RenderQueue >> renderQueues;
+	for ( auto &entry : _cameraQueues ) {
+		if ( entry.active ) {
+			renderQueues.add( entry.renderQueue );
+		}
+	}
+    
+    crimild::concurrency::sync_frame( [ this, renderQueues ]() {
+        broadcastMessage( messaging::RenderQueueAvailable { renderQueues } );
+    });
+}
+
+void UpdateSystem::updateBehaviors( Node *scene )
+{
 	// const double FIXED_TIME = Clock::getScaledTickTime();
     // const Clock FIXED_CLOCK( FIXED_TIME );
     const auto FIXED_CLOCK = Simulation::getInstance()->getSimulationClock();
 
 	CRIMILD_PROFILE( "Updating Components" )
-		
-	scene->perform( Apply( [ &FIXED_CLOCK ]( Node *node ) {
-		node->updateComponents( FIXED_CLOCK );
-	}));
-    
-    updateWorldState( scene );
 
-    broadcastMessage( messaging::DidUpdateScene { scene } );	
+	auto updateComponents = [ scene, &FIXED_CLOCK ] {
+		scene->perform( Apply( [ &FIXED_CLOCK ]( Node *node ) {
+			node->updateComponents( FIXED_CLOCK );
+		}));
+	};
+
+	auto parallelParticles = Simulation::getInstance()->getSettings()->get< crimild::Bool >( Settings::SETTINGS_SIMULATION_PARALLEL_PARTICLES_ENABLED, false );
+	if ( !parallelParticles ) {
+		updateComponents();
+		return;
+	}
+
+	// particle systems are updated after all other components, but still
+	// within this task so they are done before computing render queues
+	_particleBatch.collect( updateComponents );
+	CRIMILD_PROFILE_COUNTER( "Particles: Batched Systems", _particleBatch.getComponentCount() )
+
+	{
+		CRIMILD_PROFILE( "Updating Particles" )
+		_particleBatch.execute();
+	}
 }
 
 void UpdateSystem::updateWorldState( Node *scene )
 {
 	CRIMILD_PROFILE( "Updating World State" )
-	
-    scene->perform( UpdateWorldState() );
+
+	auto useHierarchy = Simulation::getInstance()->getSettings()->get< crimild::Bool >( Settings::SETTINGS_SIMULATION_TRANSFORM_HIERARCHY_ENABLED, false );
+	if ( !useHierarchy ) {
+		_transformHierarchy = nullptr;
+
+		UpdateWorldState updateWorldState;
+		scene->perform( updateWorldState );
+		CRIMILD_PROFILE_COUNTER( "World State: Updated Nodes", updateWorldState.getUpdatedNodeCount() )
+		return;
+	}
+
+	if ( _transformHierarchy == nullptr ) {
+		_transformHierarchy = crimild::alloc< TransformHierarchy >();
+	}
+
+	_transformHierarchy->update( scene );
+	CRIMILD_PROFILE_COUNTER( "World State: Updated Nodes", _transformHierarchy->getUpdatedNodeCount() )
 }
 
-void UpdateSystem::computeRenderQueues( Node *scene )
+SpatialIndex *UpdateSystem::updateSpatialIndex( Node *scene )
 {
-	containers::Array< SharedPointer< RenderQueue >> renderQueues;
+	auto useIndex = Simulation::getInstance()->getSettings()->get< crimild::Bool >( Settings::SETTINGS_SIMULATION_SPATIAL_INDEX_ENABLED, false );
+	if ( !useIndex ) {
+		_spatialIndex = nullptr;
+		return nullptr;
+	}
 
-	{
-		CRIMILD_PROFILE( "Compute Render Queue" )
-	
-		Simulation::getInstance()->forEachCamera( [ this, &renderQueues, scene ]( Camera *camera ) {
-			if ( camera != nullptr && camera->isEnabled() ) {
-				auto renderQueue = crimild::alloc< RenderQueue >();
-				scene->perform( ComputeRenderQueue( camera, crimild::get_ptr( renderQueue ) ) );
-				renderQueues.add( renderQueue );
-			}
-		});
+	CRIMILD_PROFILE( "Updating Spatial Index" )
+
+	if ( _spatialIndex == nullptr ) {
+		_spatialIndex = crimild::alloc< SpatialIndex >();
 	}
-    
-    crimild::concurrency::sync_frame( [ this, renderQueues ]() {
-        broadcastMessage( messaging::RenderQueueAvailable { renderQueues } );
-    });
+
+	_spatialIndex->update( scene );
+	CRIMILD_PROFILE_COUNTER( "Spatial Index: Reinserted Geometries", _spatialIndex->getReinsertedCount() )
+
+	return crimild::get_ptr( _spatialIndex );
 }
 
 void UpdateSystem::stop( void )
 {
 	System::stop();
 
+	_transformHierarchy = nullptr;
+	_spatialIndex = nullptr;
+	_cameraQueues.clear();
+
     unregisterMessageHandler< messaging::SimulationWillUpdate >();
 }
 
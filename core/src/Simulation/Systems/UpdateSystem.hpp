@@ -32,6 +32,13 @@
 
 #include "SceneGraph/Node.hpp"
 #include "SceneGraph/Camera.hpp"
+#include "SceneGraph/TransformHierarchy.hpp"
+#include "SceneGraph/SpatialIndex.hpp"
+#include "Rendering/RenderQueue.hpp"
+#include "Visitors/ComputeRenderQueue.hpp"
+#include "ParticleSystem/ParticleSystemBatch.hpp"
+
+#include <vector>
 
 namespace crimild {
     
@@ -65,12 +72,70 @@ namespace crimild {
 		virtual void stop( void ) override;
         
     private:
+        /**
+            \brief Executes all update tasks for the current frame
+
+            Components and world state are updated first. Then, 
+            render queues are computed for all cameras in parallel
+         */
+        void updateFrame( Node *scene );
+
         void updateBehaviors( Node *scene );
         void updateWorldState( Node *scene );
-        void computeRenderQueues( Node *scene );
+
+        /**
+            \returns The index to be used when computing render queues, or
+            null if disabled
+         */
+        SpatialIndex *updateSpatialIndex( Node *scene );
 
 	private:
 		double _accumulator = 0.0;
+
+		/**
+		   \brief Flat transform store for the current scene
+
+		   Only used if the SETTINGS_SIMULATION_TRANSFORM_HIERARCHY_ENABLED 
+		   setting is true. Otherwise, UpdateWorldState is used instead.
+		 */
+		TransformHierarchyPtr _transformHierarchy;
+
+		/**
+		   \brief Culling structure for the current scene
+
+		   Only used if the SETTINGS_SIMULATION_SPATIAL_INDEX_ENABLED
+		   setting is true.
+		 */
+		SpatialIndexPtr _spatialIndex;
+
+		/**
+		   \brief Collects particle systems while updating components
+
+		   Only used if the SETTINGS_SIMULATION_PARALLEL_PARTICLES_ENABLED
+		   setting is true. Otherwise, particle systems are updated along
+		   with all other components.
+		 */
+		ParticleSystemBatch _particleBatch;
+
+		/**
+		   \brief Render queue and visitor for a camera
+
+		   Kept between frames, so computing render queues does
+		   not allocate memory as long as the scene is stable
+		 */
+		struct CameraQueue {
+			Camera *camera = nullptr;
+			RenderQueuePtr renderQueue;
+			UniquePointer< ComputeRenderQueue > computeRenderQueue;
+			crimild::Size visitedNodeCount = 0;
+			crimild::Size jobCount = 0;
+			bool active = false;
+		};
+
+		/**
+		   \brief One entry per camera, in the same order as cameras
+		 */
+		std::vector< CameraQueue > _cameraQueues;
 	};
     
 }
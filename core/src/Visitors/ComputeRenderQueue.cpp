@@ -31,13 +31,50 @@
 
 #include "SceneGraph/Camera.hpp"
 #include "SceneGraph/Group.hpp"
+#include "SceneGraph/SpatialIndex.hpp"
+#include "Concurrency/ParallelFor.hpp"
+
+#include <algorithm>
 
 
 using namespace crimild;
+using namespace crimild::concurrency;
+
+namespace crimild {
+
+    namespace internal {
+
+        /**
+            \brief Scenes smaller than this are traversed sequentially
+         */
+        const crimild::Size COMPUTE_RENDER_QUEUE_PARALLEL_THRESHOLD = 4096;
+
+        /**
+            \brief Aim for several jobs per worker, since subtrees are rarely balanced
+         */
+        const crimild::Size COMPUTE_RENDER_QUEUE_JOBS_PER_WORKER = 4;
+
+        /**
+            \brief Deepest level used when looking for subtrees
+         */
+        const crimild::Size COMPUTE_RENDER_QUEUE_MAX_SPLIT_DEPTH = 4;
+
+    }
+
+}
 
 ComputeRenderQueue::ComputeRenderQueue( Camera *camera, RenderQueue *result )
     : _camera( camera ),
-      _result( result )
+      _result( result ),
+      _parallelThreshold( internal::COMPUTE_RENDER_QUEUE_PARALLEL_THRESHOLD )
+{
+}
+
+ComputeRenderQueue::ComputeRenderQueue( Camera *camera, RenderQueue *result, SpatialIndex *spatialIndex )
+    : _camera( camera ),
+      _result( result ),
+      _spatialIndex( spatialIndex ),
+      _parallelThreshold( internal::COMPUTE_RENDER_QUEUE_PARALLEL_THRESHOLD )
 {
 }
 
@@ -48,6 +85,9 @@ ComputeRenderQueue::~ComputeRenderQueue( void )
 
 void ComputeRenderQueue::traverse( Node *scene )
 {
+    _visitedNodeCount = 0;
+    _jobCount = 0;
+
     _result->reset();
     _result->setCamera( _camera );
 
@@ -55,28 +95,163 @@ void ComputeRenderQueue::traverse( Node *scene )
         _camera->computeCullingPlanes();
     }
 
-    NodeVisitor::traverse( scene );
+    if ( _spatialIndex != nullptr && _spatialIndex->getRoot() == scene ) {
+        _spatialIndex->forEachLight( [ this ]( Light *light ) {
+            visitLight( light );
+        });
+        _spatialIndex->forEachVisibleGeometry( _camera, [ this ]( Geometry *geometry ) {
+            ++_visitedNodeCount;
+            _result->push( geometry );
+        });
+    }
+    else if ( _previousVisitedNodeCount >= _parallelThreshold 
+              && JobScheduler::hasInstance() 
+              && JobScheduler::getInstance()->isRunning() 
+              && JobScheduler::getInstance()->getNumWorkers() > 0 ) {
+        traverseParallel( scene );
+    }
+    else {
+        _geometries.clear();
+        _geometryBounds.clear();
+
+        NodeVisitor::traverse( scene );
+
+        flushGeometries();
+    }
+
+    _previousVisitedNodeCount = _visitedNodeCount;
+
+    // sort in the calling thread instead of when rendering
+    _result->sort();
+}
+
+void ComputeRenderQueue::traverseParallel( Node *scene )
+{
+    auto workerCount = static_cast< crimild::Size >( JobScheduler::getInstance()->getNumWorkers() + 1 );
+    auto targetJobCount = workerCount * internal::COMPUTE_RENDER_QUEUE_JOBS_PER_WORKER;
+
+    // go deeper until there are enough subtrees for all jobs. Groups above 
+    // the split depth are visited (and culled) by this visitor
+    for ( _splitDepth = 1; _splitDepth <= internal::COMPUTE_RENDER_QUEUE_MAX_SPLIT_DEPTH; _splitDepth++ ) {
+        _visitedNodeCount = 0;
+        _depth = 0;
+        _subtrees.clear();
+
+        NodeVisitor::traverse( scene );
+
+        if ( _subtrees.size() >= targetJobCount ) {
+            break;
+        }
+    }
+    _splitDepth = 0;
+
+    if ( _subtrees.empty() ) {
+        return;
+    }
+
+    _jobCount = std::min( _subtrees.size(), targetJobCount );
+    while ( _partialVisitors.size() < _jobCount ) {
+        auto queue = crimild::alloc< RenderQueue >();
+        _partialVisitors.push_back( crimild::alloc_unique< ComputeRenderQueue >( _camera, crimild::get_ptr( queue ) ) );
+        _partialQueues.push_back( queue );
+    }
+
+    auto jobCount = _jobCount;
+    auto subtreeCount = _subtrees.size();
+    parallel_for( Range( 0, jobCount ), 1, [ this, jobCount, subtreeCount ]( Range const &jobs ) {
+        for ( auto j = jobs.begin; j < jobs.end; j++ ) {
+            auto begin = j * subtreeCount / jobCount;
+            auto end = ( j + 1 ) * subtreeCount / jobCount;
+            _partialVisitors[ j ]->collect( &_subtrees[ begin ], end - begin );
+        }
+    });
+
+    // merge in the same order subtrees were found, so the 
+    // result does not depend on how jobs were scheduled
+    for ( crimild::Size j = 0; j < jobCount; j++ ) {
+        _visitedNodeCount += _partialVisitors[ j ]->getVisitedNodeCount();
+        _result->append( crimild::get_ptr( _partialQueues[ j ] ) );
+    }
+}
+
+void ComputeRenderQueue::collect( Node * const *nodes, crimild::Size count )
+{
+    _visitedNodeCount = 0;
+
+    _result->reset();
+    _result->setCamera( _camera );
+
+    _geometries.clear();
+    _geometryBounds.clear();
+
+    for ( crimild::Size i = 0; i < count; i++ ) {
+        nodes[ i ]->accept( *this );
+    }
+
+    flushGeometries();
 }
 
 void ComputeRenderQueue::visitGroup( Group *group )
 {
+    if ( _splitDepth > 0 && _depth == _splitDepth ) {
+        _subtrees.push_back( group );
+        return;
+    }
+
+    ++_visitedNodeCount;
+
     // we should not discard groups based on culling
     // since there could be lights or other nodes
     // that affect the scene even if they are not visible
+    ++_depth;
     NodeVisitor::visitGroup( group );
+    --_depth;
 }
 
 void ComputeRenderQueue::visitGeometry( Geometry *geometry )
 {
-    if ( _camera != nullptr && _camera->culled( geometry->getWorldBound() ) ) {
+    if ( _splitDepth > 0 ) {
+        _subtrees.push_back( geometry );
         return;
     }
 
-    _result->push( geometry );
+    ++_visitedNodeCount;
+
+    if ( _camera == nullptr || !_camera->isCullingEnabled() ) {
+        _result->push( geometry );
+        return;
+    }
+
+    // geometries are culled in batches once the traversal is completed
+    _geometries.push_back( geometry );
+    _geometryBounds.push( geometry->getWorldBound() );
 }
 
 void ComputeRenderQueue::visitLight( Light *light )
 {
+    if ( _splitDepth > 0 ) {
+        _subtrees.push_back( light );
+        return;
+    }
+
+    ++_visitedNodeCount;
+
     _result->push( light );
 }
 
+
+void ComputeRenderQueue::flushGeometries( void )
+{
+    if ( _geometries.empty() ) {
+        return;
+    }
+
+    _visibleGeometries.resize( _geometries.size() );
+    BatchCulling::cull( _geometryBounds, _camera->getCullingPlanes(), Camera::CULLING_PLANE_COUNT, &_visibleGeometries[ 0 ] );
+
+    for ( crimild::Size i = 0; i < _geometries.size(); i++ ) {
+        if ( _visibleGeometries[ i ] ) {
+            _result->push( _geometries[ i ] );
+        }
+    }
+}
@@ -30,25 +30,114 @@
 
 #include "Visitors/NodeVisitor.hpp"
 
+#include "Foundation/Types.hpp"
+#include "Foundation/Memory.hpp"
+#include "Boundings/BatchCulling.hpp"
+
+#include <vector>
+
 namespace crimild {
     
     class Camera;
     class RenderQueue;
+    class SpatialIndex;
     
     class ComputeRenderQueue : public NodeVisitor {
     public:
         ComputeRenderQueue( Camera *camera, RenderQueue *result );
+
+        /**
+            \brief Computes the render queue using a spatial index
+
+            Instead of traversing the scene, geometries are culled
+            using the index's tree. The index must be up to date.
+         */
+        ComputeRenderQueue( Camera *camera, RenderQueue *result, SpatialIndex *spatialIndex );
         virtual ~ComputeRenderQueue( void );
+
+        /**
+            \brief Sets the index used in the next traversals, if any
+         */
+        void setSpatialIndex( SpatialIndex *spatialIndex ) { _spatialIndex = spatialIndex; }
         
         virtual void traverse( Node *scene ) override;
         
         virtual void visitGroup( Group *group ) override;
         virtual void visitGeometry( Geometry *geometry ) override;
         virtual void visitLight( Light *light ) override;
+
+        /**
+            \brief Number of nodes visited during the last traversal
+
+            When using a spatial index, only geometries and lights 
+            accepted by the index are counted.
+         */
+        crimild::Size getVisitedNodeCount( void ) const { return _visitedNodeCount; }
+
+        /**
+            \brief Minimum number of nodes visited in the previous traversal
+            for splitting the next one into parallel jobs
+
+            The top levels of the scene are split into subtrees and each job
+            traverses a contiguous range of them, filling a partial queue. 
+            Partial queues are merged in traversal order, so the result is the 
+            same as when traversing the whole scene sequentially.
+
+            Scenes are never split if the JobScheduler has no workers.
+         */
+        void setParallelThreshold( crimild::Size threshold ) { _parallelThreshold = threshold; }
+        crimild::Size getParallelThreshold( void ) const { return _parallelThreshold; }
+
+        /**
+            \brief Number of jobs used during the last traversal (zero if sequential)
+         */
+        crimild::Size getJobCount( void ) const { return _jobCount; }
+
+    private:
+        /**
+            \brief Collects subtrees from the top levels of the scene and
+            traverses them in parallel
+         */
+        void traverseParallel( Node *scene );
+
+        /**
+            \brief Fills the queue with a range of subtrees
+
+            Used by partial visitors. Culling planes must be computed in advance
+         */
+        void collect( Node * const *nodes, crimild::Size count );
+
+    private:
+        /**
+            \brief Culls all collected geometries at once (see BatchCulling)
+            and pushes the visible ones in traversal order
+         */
+        void flushGeometries( void );
         
     private:
         Camera *_camera = nullptr;
         RenderQueue *_result = nullptr;
+        SpatialIndex *_spatialIndex = nullptr;
+        crimild::Size _visitedNodeCount = 0;
+
+        std::vector< Geometry * > _geometries;
+        SphereBatch _geometryBounds;
+        std::vector< crimild::UInt8 > _visibleGeometries;
+
+        crimild::Size _parallelThreshold;
+        crimild::Size _previousVisitedNodeCount = 0;
+        crimild::Size _jobCount = 0;
+
+        /**
+            \brief While splitting, nodes at this depth are collected
+            instead of visited. Zero means no splitting.
+         */
+        crimild::Size _splitDepth = 0;
+        crimild::Size _depth = 0;
+        std::vector< Node * > _subtrees;
+
+        std::vector< SharedPointer< RenderQueue >> _partialQueues;
+        std::vector< UniquePointer< ComputeRenderQueue >> _partialVisitors;
     };
     
 }
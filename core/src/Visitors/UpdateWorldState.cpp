@@ -41,26 +41,40 @@ UpdateWorldState::~UpdateWorldState( void )
 
 }
 
+void UpdateWorldState::traverse( Node *node )
+{
+	_updatedNodeCount = 0;
+
+	// there's no way to know if the parent of the starting 
+	// node has changed, so assume it did
+	_parentChanged = node->hasParent();
+
+	NodeVisitor::traverse( node );
+}
+
 void UpdateWorldState::visitNode( Node *node )
 {
-	if ( node->worldIsCurrent() ) {
+	if ( !_parentChanged && !node->isWorldDirty() && !node->isBoundDirty() ) {
 		return;
 	}
 
-	if ( node->hasParent() ) {
-		node->world().computeFrom( node->getParent()->getWorld(), node->getLocal() );
-	}
-	else {
-		node->setWorld( node->getLocal() );
-	}
-
-	node->worldBound()->computeFrom( node->getLocalBound(), node->getWorld() );
+	updateNode( node );
 }
 
 void UpdateWorldState::visitGroup( Group *group )
 {
-	visitNode( group );
+	if ( !_parentChanged && !group->isWorldDirty() && !group->isBoundDirty() && !group->isSubtreeDirty() ) {
+		// nothing changed in this subtree
+		return;
+	}
+
+	auto boundRevision = group->_boundRevision;
+	auto worldChanged = updateNode( group );
+
+	auto parentChanged = _parentChanged;
+	_parentChanged = worldChanged;
 	NodeVisitor::visitGroup( group );
+	_parentChanged = parentChanged;
 
 	if ( group->hasNodes() ) {
 		bool firstChild = true;
@@ -74,5 +88,38 @@ void UpdateWorldState::visitGroup( Group *group )
 			}
 		});
 	}
+
+	// bounds may be computed twice, but that's a single change
+	group->_boundRevision = boundRevision + 1;
+	group->_subtreeDirty = false;
 }
 
+bool UpdateWorldState::updateNode( Node *node )
+{
+	++_updatedNodeCount;
+
+	auto worldChanged = _parentChanged || node->_worldDirty;
+	node->_worldDirty = false;
+	node->_boundDirty = false;
+
+	if ( node->worldIsCurrent() ) {
+		// world was provided by the user, but children might still need to be updated
+		return worldChanged;
+	}
+
+	if ( worldChanged ) {
+		// don't use world() here, since it would mark the node as dirty again
+		if ( node->hasParent() ) {
+			node->_worldTransform->computeFrom( node->getParent()->getWorld(), node->getLocal() );
+		}
+		else {
+			*node->_worldTransform = node->getLocal();
+		}
+		++node->_worldRevision;
+	}
+
+	node->worldBound()->computeFrom( node->getLocalBound(), node->getWorld() );
+	++node->_boundRevision;
+
+	return worldChanged;
+}
@@ -30,15 +30,42 @@
 
 #include "NodeVisitor.hpp"
 
+#include "Foundation/Types.hpp"
+
 namespace crimild {
 
+	/**
+		\brief Computes world transformations and bounds
+
+		Only dirty nodes are updated (see Node::isWorldDirty()). Subtrees 
+		without any changes are skipped entirely.
+	*/
 	class UpdateWorldState : public NodeVisitor {
 	public:
 		UpdateWorldState( void );
 		virtual ~UpdateWorldState( void );
 
+		virtual void traverse( Node *node ) override;
+
         virtual void visitNode( Node *node ) override;
         virtual void visitGroup( Group *node ) override;
+
+		/**
+			\brief Number of nodes updated during the last traversal
+		*/
+		crimild::Size getUpdatedNodeCount( void ) const { return _updatedNodeCount; }
+
+	private:
+		/**
+			\brief Updates a single node
+
+			\returns true if the world transformation was recomputed
+		*/
+		bool updateNode( Node *node );
+
+	private:
+		bool _parentChanged = false;
+		crimild::Size _updatedNodeCount = 0;
 	};
 
 }
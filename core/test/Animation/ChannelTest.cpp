@@ -0,0 +1,184 @@
+/*
+ * Copyright (c) 2013, Hernan Saez
+ * All rights reserved.
+ * 
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *     * Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in the
+ *       documentation and/or other materials provided with the distribution.
+ *     * Neither the name of the <organization> nor the
+ *       names of its contributors may be used to endorse or promote products
+ *       derived from this software without specific prior written permission.
+ * 
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL <COPYRIGHT HOLDER> BE LIABLE FOR ANY
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "Animation/ChannelImpl.hpp"
+#include "Animation/Clip.hpp"
+#include "Animation/Animation.hpp"
+#include "Animation/KeyframeCursor.hpp"
+#include "Coding/MemoryEncoder.hpp"
+#include "Coding/MemoryDecoder.hpp"
+
+#include "gtest/gtest.h"
+
+using namespace crimild;
+using namespace crimild::animation;
+
+namespace crimild {
+
+	namespace test {
+
+		static SharedPointer< Real32Channel > createRampChannel( std::string name, containers::Array< crimild::Real32 > const &times )
+		{
+			// values are equal to times, so evaluating the channel at t returns t
+			return crimild::alloc< Real32Channel >( name, times, times );
+		}
+
+		static crimild::Real32 evaluateRamp( Animation *animation, std::string name )
+		{
+			crimild::Real32 value = -1.0f;
+			animation->getValue( name, value );
+			return value;
+		}
+
+	}
+
+}
+
+TEST( KeyframeCursor, findKeyframe )
+{
+	crimild::Real32 times[] = { 0.0f, 0.5f, 1.0f, 3.0f, 3.5f, 10.0f };
+	auto timeAt = [ &times ]( crimild::Size i ) { return times[ i ]; };
+
+	crimild::Size cursor = 0;
+	EXPECT_EQ( 0, findKeyframe( 6, 0.2f, cursor, timeAt ) );
+	EXPECT_EQ( 0, cursor );
+	EXPECT_EQ( 1, findKeyframe( 6, 0.7f, cursor, timeAt ) );
+	EXPECT_EQ( 1, cursor );
+	EXPECT_EQ( 4, findKeyframe( 6, 9.0f, cursor, timeAt ) );
+	EXPECT_EQ( 4, cursor );
+	EXPECT_EQ( 2, findKeyframe( 6, 1.0f, cursor, timeAt ) );
+	EXPECT_EQ( 2, cursor );
+	EXPECT_EQ( 0, findKeyframe( 6, 0.0f, cursor, timeAt ) );
+	EXPECT_EQ( 0, cursor );
+
+	// invalid cursors are ignored
+	cursor = 100;
+	EXPECT_EQ( 3, findKeyframe( 6, 3.2f, cursor, timeAt ) );
+	EXPECT_EQ( 3, cursor );
+}
+
+TEST( Channel, evaluateWithCursors )
+{
+	auto clip = crimild::alloc< Clip >( "clip" );
+	clip->addChannel( test::createRampChannel( "a", { 0.0f, 1.0f, 2.0f, 4.0f, 8.0f } ) );
+	clip->addChannel( test::createRampChannel( "b", { 0.0f, 8.0f } ) );
+
+	auto animation = crimild::alloc< Animation >( clip );
+	animation->setPlaybackMode( Animation::PlaybackMode::ONCE );
+
+	for ( crimild::Real32 t = 0.0f; t <= 8.0f; t += 0.25f ) {
+		animation->update( Clock( 0.25 ) );
+		auto expected = Numericf::min( 8.0f, animation->getClock().getAccumTime() );
+		EXPECT_FLOAT_EQ( expected, test::evaluateRamp( crimild::get_ptr( animation ), "a" ) );
+		EXPECT_FLOAT_EQ( expected, test::evaluateRamp( crimild::get_ptr( animation ), "b" ) );
+	}
+
+	EXPECT_EQ( 3, animation->getChannelCursor( 0 ) );
+	EXPECT_EQ( 0, animation->getChannelCursor( 1 ) );
+}
+
+TEST( Channel, cursorsArePerAnimation )
+{
+	auto clip = crimild::alloc< Clip >( "clip" );
+	clip->addChannel( test::createRampChannel( "a", { 0.0f, 1.0f, 2.0f, 3.0f, 4.0f } ) );
+
+	auto a0 = crimild::alloc< Animation >( clip );
+	auto a1 = crimild::alloc< Animation >( clip );
+
+	a0->update( Clock( 0.5 ) );
+	a1->update( Clock( 3.5 ) );
+
+	EXPECT_FLOAT_EQ( 0.5f, test::evaluateRamp( crimild::get_ptr( a0 ), "a" ) );
+	EXPECT_FLOAT_EQ( 3.5f, test::evaluateRamp( crimild::get_ptr( a1 ), "a" ) );
+	EXPECT_EQ( 0, a0->getChannelCursor( 0 ) );
+	EXPECT_EQ( 3, a1->getChannelCursor( 0 ) );
+}
+
+TEST( Channel, resample )
+{
+	auto channel = crimild::alloc< Vector3fChannel >(
+		"p",
+		containers::Array< crimild::Real32 > { 0.0f, 0.1f, 1.5f, 2.0f },
+		containers::Array< Vector3f > { Vector3f( 0.0f, 0.0f, 0.0f ), Vector3f( 1.0f, 0.0f, 0.0f ), Vector3f( 1.0f, 2.0f, 0.0f ), Vector3f( 1.0f, 2.0f, 3.0f ) } );
+
+	EXPECT_EQ( 0.0f, channel->getSampleRate() );
+
+	containers::Array< Vector3f > expected;
+	crimild::Size cursor = 0;
+	for ( crimild::Real32 t = 0.0f; t <= 2.0f; t += 0.1f ) {
+		Vector3f v;
+		channel->sample( t, cursor, v );
+		expected.add( v );
+	}
+
+	channel->resample( 10.0f );
+	EXPECT_EQ( 10.0f, channel->getSampleRate() );
+	EXPECT_EQ( 2.0f, channel->getDuration() );
+
+	crimild::Size i = 0;
+	for ( crimild::Real32 t = 0.0f; t <= 2.0f; t += 0.1f ) {
+		Vector3f v;
+		channel->sample( t, cursor, v );
+		EXPECT_TRUE( Numericf::fabs( ( v - expected[ i++ ] ).getMagnitude() ) < 1e-4f );
+	}
+}
+
+TEST( Channel, resampleUniformKeys )
+{
+	auto channel = test::createRampChannel( "a", { 1.0f, 1.5f, 2.0f, 2.5f } );
+
+	// keys are already evenly spaced, so the requested rate is ignored
+	channel->resample( 30.0f );
+	EXPECT_FLOAT_EQ( 2.0f, channel->getSampleRate() );
+
+	crimild::Size cursor = 0;
+	crimild::Real32 value;
+	channel->sample( 1.75f, cursor, value );
+	EXPECT_FLOAT_EQ( 1.75f, value );
+	channel->sample( 0.0f, cursor, value );
+	EXPECT_FLOAT_EQ( 1.0f, value );
+	channel->sample( 3.0f, cursor, value );
+	EXPECT_FLOAT_EQ( 2.5f, value );
+}
+
+TEST( Channel, codingSampleRate )
+{
+	auto channel = test::createRampChannel( "a", { 0.0f, 0.5f, 2.0f } );
+	channel->resample( 4.0f );
+
+	auto encoder = crimild::alloc< coding::MemoryEncoder >();
+	encoder->encode( channel );
+	auto bytes = encoder->getBytes();
+	auto decoder = crimild::alloc< coding::MemoryDecoder >();
+	decoder->fromBytes( bytes );
+
+	auto decoded = decoder->getObjectAt< Real32Channel >( 0 );
+	ASSERT_TRUE( decoded != nullptr );
+	EXPECT_EQ( "a", decoded->getName() );
+	EXPECT_EQ( channel->getSampleRate(), decoded->getSampleRate() );
+	EXPECT_EQ( channel->getDuration(), decoded->getDuration() );
+}
@@ -0,0 +1,277 @@
+/*
+ * Copyright (c) 2013, Hernan Saez
+ * All rights reserved.
+ * 
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *     * Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in the
+ *       documentation and/or other materials provided with the distribution.
+ *     * Neither the name of the <organization> nor the
+ *       names of its contributors may be used to endorse or promote products
+ *       derived from this software without specific prior written permission.
+ * 
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL <COPYRIGHT HOLDER> BE LIABLE FOR ANY
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "Animation/CompressedChannel.hpp"
+#include "Animation/ChannelImpl.hpp"
+#include "Animation/Clip.hpp"
+#include "Coding/MemoryEncoder.hpp"
+#include "Coding/MemoryDecoder.hpp"
+
+#include "gtest/gtest.h"
+
+#include <cmath>
+#include <random>
+
+using namespace crimild;
+using namespace crimild::animation;
+
+namespace crimild {
+
+	namespace test {
+
+		static crimild::Real32 angleBetween( const Quaternion4f &a, const Quaternion4f &b )
+		{
+			return compression::KeyCodec< Quaternion4f >::error( a, b );
+		}
+
+	}
+
+}
+
+TEST( CompressedChannel, packQuaternion )
+{
+	std::mt19937 rng( 1234 );
+	std::uniform_real_distribution< crimild::Real32 > axis( -1.0f, 1.0f );
+	std::uniform_real_distribution< crimild::Real32 > angle( -Numericf::PI, Numericf::PI );
+
+	for ( crimild::Size i = 0; i < 1000; i++ ) {
+		auto q = Quaternion4f::createFromAxisAngle( Vector3f( axis( rng ), axis( rng ), axis( rng ) + 1.5f ).getNormalized(), angle( rng ) );
+		if ( i % 2 == 0 ) {
+			// both hemispheres must be supported
+			q = -q;
+		}
+
+		crimild::UInt16 packed[ 3 ];
+		compression::packQuaternion( q, packed );
+		auto unpacked = compression::unpackQuaternion( packed );
+
+		EXPECT_LT( test::angleBetween( q, unpacked ), 1e-3f );
+	}
+}
+
+TEST( CompressedChannel, constantTrack )
+{
+	auto channel = crimild::alloc< CompressedVector3fChannel >(
+		"p",
+		containers::Array< crimild::Real32 > { 0.0f, 1.0f, 2.0f, 3.0f },
+		containers::Array< Vector3f > { Vector3f( 1.0f, 2.0f, 3.0f ), Vector3f( 1.0f, 2.0f, 3.0f ), Vector3f( 1.0f, 2.0f, 3.0001f ), Vector3f( 1.0f, 2.0f, 3.0f ) },
+		0.001f );
+
+	EXPECT_EQ( 1, channel->getKeyCount() );
+	EXPECT_EQ( 3.0f, channel->getDuration() );
+
+	crimild::Size cursor = 0;
+	Vector3f value;
+	channel->sample( 1.5f, cursor, value );
+	EXPECT_LT( ( value - Vector3f( 1.0f, 2.0f, 3.0f ) ).getMagnitude(), 0.001f );
+}
+
+TEST( CompressedChannel, keyReduction )
+{
+	// a ramp going up and then down. Only the extremes are needed
+	containers::Array< crimild::Real32 > times;
+	containers::Array< crimild::Real32 > keys;
+	for ( crimild::Size i = 0; i <= 100; i++ ) {
+		times.add( 0.1f * i );
+		keys.add( i <= 50 ? 0.2f * i : 20.0f - 0.2f * i );
+	}
+
+	auto source = crimild::alloc< Real32Channel >( "s", times, keys );
+	auto channel = crimild::alloc< CompressedReal32Channel >( "s", times, keys, 0.001f );
+
+	EXPECT_EQ( 3, channel->getKeyCount() );
+	EXPECT_FLOAT_EQ( 10.0f, channel->getDuration() );
+
+	crimild::Size sourceCursor = 0;
+	crimild::Size cursor = 0;
+	for ( crimild::Real32 t = -1.0f; t <= 11.0f; t += 0.05f ) {
+		crimild::Real32 expected;
+		source->sample( t, sourceCursor, expected );
+		crimild::Real32 value;
+		channel->sample( t, cursor, value );
+		EXPECT_NEAR( expected, value, 0.002f );
+	}
+}
+
+TEST( CompressedChannel, rotations )
+{
+	std::mt19937 rng( 1234 );
+	std::uniform_real_distribution< crimild::Real32 > noise( -0.2f, 0.2f );
+
+	containers::Array< crimild::Real32 > times;
+	containers::Array< Quaternion4f > keys;
+	for ( crimild::Size i = 0; i < 200; i++ ) {
+		times.add( i / 30.0f );
+		keys.add( Quaternion4f::createFromAxisAngle( Vector3f( 0.0f, 1.0f, 0.0f ), 0.05f * i + noise( rng ) ) );
+	}
+
+	const auto TOLERANCE = 0.01f;
+	auto source = crimild::alloc< Quaternion4fChannel >( "r", times, keys );
+	auto channel = crimild::alloc< CompressedQuaternion4fChannel >( "r", times, keys, TOLERANCE );
+
+	EXPECT_LE( channel->getKeyCount(), 200 );
+
+	crimild::Size sourceCursor = 0;
+	crimild::Size cursor = 0;
+	for ( crimild::Size i = 0; i < 200; i++ ) {
+		Quaternion4f expected;
+		source->sample( times[ i ], sourceCursor, expected );
+		Quaternion4f value;
+		channel->sample( times[ i ], cursor, value );
+		EXPECT_LT( test::angleBetween( expected, value ), TOLERANCE + 0.001f );
+	}
+}
+
+TEST( CompressedChannel, compressClip )
+{
+	auto clip = crimild::alloc< Clip >( "clip" );
+	clip->addChannel( crimild::alloc< Vector3fChannel >(
+		"p",
+		containers::Array< crimild::Real32 > { 0.0f, 1.0f, 2.0f },
+		containers::Array< Vector3f > { Vector3f( 0.0f, 0.0f, 0.0f ), Vector3f( 1.0f, 0.0f, 0.0f ), Vector3f( 1.0f, 1.0f, 0.0f ) } ) );
+	clip->addChannel( crimild::alloc< Real32Channel >(
+		"s",
+		containers::Array< crimild::Real32 > { 0.0f, 2.0f },
+		containers::Array< crimild::Real32 > { 1.0f, 1.0f } ) );
+
+	clip->compress( 0.001f );
+
+	EXPECT_TRUE( dynamic_cast< CompressedVector3fChannel * >( crimild::get_ptr( clip->getChannels()[ 0 ] ) ) != nullptr );
+	EXPECT_TRUE( dynamic_cast< CompressedReal32Channel * >( crimild::get_ptr( clip->getChannels()[ 1 ] ) ) != nullptr );
+
+	auto animation = crimild::alloc< Animation >( clip );
+	animation->update( Clock( 1.5 ) );
+
+	Vector3f p;
+	animation->getValue( "p", p );
+	EXPECT_LT( ( p - Vector3f( 1.0f, 0.5f, 0.0f ) ).getMagnitude(), 0.001f );
+
+	crimild::Real32 s = 0.0f;
+	animation->getValue( "s", s );
+	EXPECT_FLOAT_EQ( 1.0f, s );
+}
+
+TEST( CompressedChannel, coding )
+{
+	auto channel = crimild::alloc< CompressedVector3fChannel >(
+		"p",
+		containers::Array< crimild::Real32 > { 0.0f, 1.0f, 2.0f },
+		containers::Array< Vector3f > { Vector3f( 0.0f, 0.0f, 0.0f ), Vector3f( 1.0f, 0.0f, 0.0f ), Vector3f( 1.0f, 1.0f, 0.0f ) },
+		0.001f );
+
+	auto encoder = crimild::alloc< coding::MemoryEncoder >();
+	encoder->encode( channel );
+	auto bytes = encoder->getBytes();
+	auto decoder = crimild::alloc< coding::MemoryDecoder >();
+	decoder->fromBytes( bytes );
+
+	auto decoded = decoder->getObjectAt< CompressedVector3fChannel >( 0 );
+	ASSERT_TRUE( decoded != nullptr );
+	EXPECT_EQ( "p", decoded->getName() );
+	EXPECT_EQ( channel->getKeyCount(), decoded->getKeyCount() );
+	EXPECT_EQ( channel->getDuration(), decoded->getDuration() );
+
+	crimild::Size c0 = 0;
+	crimild::Size c1 = 0;
+	for ( crimild::Real32 t = 0.0f; t <= 2.0f; t += 0.25f ) {
+		Vector3f v0, v1;
+		channel->sample( t, c0, v0 );
+		decoded->sample( t, c1, v1 );
+		EXPECT_EQ( v0, v1 );
+	}
+}
+
+TEST( CompressedChannel, codingIsSmallerThanSource )
+{
+	std::mt19937 rng( 1234 );
+	std::uniform_real_distribution< crimild::Real32 > value( -10.0f, 10.0f );
+
+	// random keys cannot be reduced, so all of them are stored
+	containers::Array< crimild::Real32 > times;
+	containers::Array< Vector3f > keys;
+	for ( crimild::Size i = 0; i < 200; i++ ) {
+		times.add( i / 30.0f );
+		keys.add( Vector3f( value( rng ), value( rng ), value( rng ) ) );
+	}
+
+	auto source = crimild::alloc< Vector3fChannel >( "p", times, keys );
+	auto channel = crimild::alloc< CompressedVector3fChannel >( "p", times, keys, 0.001f );
+	EXPECT_EQ( 200, channel->getKeyCount() );
+
+	auto sourceEncoder = crimild::alloc< coding::MemoryEncoder >();
+	sourceEncoder->encode( source );
+	auto sourceBytes = sourceEncoder->getBytes();
+
+	auto encoder = crimild::alloc< coding::MemoryEncoder >();
+	encoder->encode( channel );
+	auto bytes = encoder->getBytes();
+
+	EXPECT_LT( bytes.size(), sourceBytes.size() / 1.5 );
+
+	auto decoder = crimild::alloc< coding::MemoryDecoder >();
+	decoder->fromBytes( bytes );
+	auto decoded = decoder->getObjectAt< CompressedVector3fChannel >( 0 );
+	ASSERT_TRUE( decoded != nullptr );
+	EXPECT_EQ( channel->getKeyCount(), decoded->getKeyCount() );
+
+	crimild::Size c0 = 0;
+	crimild::Size c1 = 0;
+	for ( crimild::Size i = 0; i < times.size(); i++ ) {
+		Vector3f v0, v1;
+		channel->sample( times[ i ], c0, v0 );
+		decoded->sample( times[ i ], c1, v1 );
+		EXPECT_EQ( v0, v1 );
+	}
+}
+
+TEST( CompressedChannel, errorIncludesQuantization )
+{
+	std::mt19937 rng( 1234 );
+	std::uniform_real_distribution< crimild::Real32 > noise( -0.005f, 0.005f );
+
+	// a wide range makes quantization errors comparable to the tolerance
+	containers::Array< crimild::Real32 > times;
+	containers::Array< Vector3f > keys;
+	for ( crimild::Size i = 0; i <= 300; i++ ) {
+		auto x = 400.0f * i / 300.0f;
+		times.add( i / 30.0f );
+		keys.add( Vector3f( x + noise( rng ), -0.5f * x + noise( rng ), 20.0f * std::sin( 0.1f * i ) + noise( rng ) ) );
+	}
+
+	const auto TOLERANCE = 0.01f;
+	auto channel = crimild::alloc< CompressedVector3fChannel >( "p", times, keys, TOLERANCE );
+	EXPECT_LT( channel->getKeyCount(), 301 );
+
+	crimild::Size cursor = 0;
+	crimild::Real32 maxError = 0.0f;
+	for ( crimild::Size i = 0; i < times.size(); i++ ) {
+		Vector3f value;
+		channel->sample( times[ i ], cursor, value );
+		maxError = Numericf::max( maxError, ( value - keys[ i ] ).getMagnitude() );
+	}
+	EXPECT_LE( maxError, TOLERANCE );
+}
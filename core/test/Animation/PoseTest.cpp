@@ -0,0 +1,306 @@
+/*
+ * Copyright (c) 2013, Hernan Saez
+ * All rights reserved.
+ * 
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *     * Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in the
+ *       documentation and/or other materials provided with the distribution.
+ *     * Neither the name of the <organization> nor the
+ *       names of its contributors may be used to endorse or promote products
+ *       derived from this software without specific prior written permission.
+ * 
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL <COPYRIGHT HOLDER> BE LIABLE FOR ANY
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "Animation/Pose.hpp"
+#include "Animation/PoseBatch.hpp"
+#include "Animation/ClipBinding.hpp"
+#include "Animation/ChannelImpl.hpp"
+#include "Animation/Clip.hpp"
+#include "Animation/Skeleton.hpp"
+#include "Concurrency/JobScheduler.hpp"
+#include "SceneGraph/Group.hpp"
+#include "Visitors/UpdateWorldState.hpp"
+
+#include "gtest/gtest.h"
+
+using namespace crimild;
+using namespace crimild::animation;
+
+namespace crimild {
+
+	namespace test {
+
+		/**
+		   \brief A root node with a chain of three joints plus a non-joint node
+		 */
+		static SharedPointer< Group > createCharacter( void )
+		{
+			auto root = crimild::alloc< Group >( "root" );
+			Group *parent = crimild::get_ptr( root );
+			for ( crimild::UInt32 i = 0; i < 3; i++ ) {
+				auto node = crimild::alloc< Group >();
+				node->local().setTranslate( 0.0f, 1.0f, 0.0f );
+				node->attachComponent< Joint >( "j" + std::to_string( i ), i );
+				parent->attachNode( node );
+				parent = crimild::get_ptr( node );
+			}
+			parent->attachNode( crimild::alloc< Group >( "tip" ) );
+			root->attachComponent< Skeleton >()->bind();
+			root->perform( UpdateWorldState() );
+			return root;
+		}
+
+		static SharedPointer< Clip > createClip( std::string name, crimild::Real32 angle )
+		{
+			auto clip = crimild::alloc< Clip >( name );
+			for ( crimild::Size i = 0; i < 3; i++ ) {
+				auto jointName = "j" + std::to_string( i );
+				clip->addChannel( crimild::alloc< Quaternion4fChannel >(
+					jointName + "[r]",
+					containers::Array< crimild::Real32 > { 0.0f, 1.0f, 2.0f },
+					containers::Array< Quaternion4f > {
+						Quaternion4f::createFromAxisAngle( Vector3f( 0.0f, 0.0f, 1.0f ), 0.0f ),
+						Quaternion4f::createFromAxisAngle( Vector3f( 0.0f, 0.0f, 1.0f ), angle ),
+						Quaternion4f::createFromAxisAngle( Vector3f( 0.0f, 0.0f, 1.0f ), 0.0f ) } ) );
+				clip->addChannel( crimild::alloc< Vector3fChannel >(
+					jointName + "[p]",
+					containers::Array< crimild::Real32 > { 0.0f, 2.0f },
+					containers::Array< Vector3f > { Vector3f( 0.0f, 1.0f, 0.0f ), Vector3f( 0.0f, 2.0f, 0.0f ) } ) );
+			}
+			// not bound to any joint
+			clip->addChannel( crimild::alloc< Real32Channel >(
+				"other",
+				containers::Array< crimild::Real32 > { 0.0f, 2.0f },
+				containers::Array< crimild::Real32 > { 0.0f, 1.0f } ) );
+			return clip;
+		}
+
+		static void expectSameMatrix( const Matrix4f &expected, const Matrix4f &actual )
+		{
+			for ( crimild::Size i = 0; i < 16; i++ ) {
+				EXPECT_NEAR( expected[ i ], actual[ i ], 1e-4f );
+			}
+		}
+
+	}
+
+}
+
+TEST( Pose, lerp )
+{
+	Pose a( 2 );
+	Pose b( 2 );
+
+	a.set( 0, Vector3f( 0.0f, 0.0f, 0.0f ) );
+	b.set( 0, Vector3f( 2.0f, 4.0f, 6.0f ) );
+	a.set( 1, Quaternion4f::createFromAxisAngle( Vector3f( 0.0f, 1.0f, 0.0f ), 0.0f ) );
+	b.set( 1, -Quaternion4f::createFromAxisAngle( Vector3f( 0.0f, 1.0f, 0.0f ), 0.2f ) );
+	b.set( 1, 3.0f );
+
+	Pose result;
+	Pose::lerp( a, b, 0.5f, result );
+
+	EXPECT_EQ( 2, result.getJointCount() );
+	EXPECT_EQ( Vector3f( 1.0f, 2.0f, 3.0f ), result.getTranslation( 0 ) );
+	EXPECT_FLOAT_EQ( 2.0f, result.getScale( 1 ) );
+
+	// shortest path, even if b is in the other hemisphere
+	auto expected = Quaternion4f::createFromAxisAngle( Vector3f( 0.0f, 1.0f, 0.0f ), 0.1f );
+	EXPECT_NEAR( 1.0f, Numericf::fabs( expected.getRawData() * result.getRotation( 1 ).getRawData() ), 1e-5f );
+}
+
+TEST( Pose, add )
+{
+	Pose base( 1 );
+	Pose additive( 1 );
+
+	auto q0 = Quaternion4f::createFromAxisAngle( Vector3f( 0.0f, 1.0f, 0.0f ), 0.5f );
+	auto q1 = Quaternion4f::createFromAxisAngle( Vector3f( 1.0f, 0.0f, 0.0f ), 0.3f );
+	base.set( 0, Transformation( Vector3f( 1.0f, 0.0f, 0.0f ), q0, 1.0f ) );
+	additive.set( 0, Transformation( Vector3f( 0.0f, 1.0f, 0.0f ), q1, 0.5f ) );
+
+	Pose result;
+	Pose::add( base, additive, 1.0f, result );
+
+	EXPECT_EQ( Vector3f( 1.0f, 1.0f, 0.0f ), result.getTranslation( 0 ) );
+	EXPECT_FLOAT_EQ( 1.5f, result.getScale( 0 ) );
+	EXPECT_NEAR( 1.0f, Numericf::fabs( ( q0 * q1 ).getRawData() * result.getRotation( 0 ).getRawData() ), 1e-5f );
+
+	// no contribution
+	Pose::add( base, additive, 0.0f, result );
+	EXPECT_NEAR( 1.0f, Numericf::fabs( q0.getRawData() * result.getRotation( 0 ).getRawData() ), 1e-5f );
+}
+
+TEST( Skeleton, bind )
+{
+	auto character = test::createCharacter();
+	auto skeleton = character->getComponent< Skeleton >();
+
+	EXPECT_EQ( 3, skeleton->getJointCount() );
+	for ( crimild::Size i = 0; i < 3; i++ ) {
+		EXPECT_EQ( "j" + std::to_string( i ), skeleton->getJointAt( i )->getName() );
+		EXPECT_EQ( crimild::Int32( i ), skeleton->getJointIndex( "j" + std::to_string( i ) ) );
+		EXPECT_EQ( crimild::Int32( i ) - 1, skeleton->getParentJointIndex( i ) );
+	}
+	EXPECT_EQ( -1, skeleton->getJointIndex( "tip" ) );
+
+	Pose pose;
+	skeleton->getCurrentPose( pose );
+	EXPECT_EQ( 3, pose.getJointCount() );
+	EXPECT_EQ( Vector3f( 0.0f, 1.0f, 0.0f ), pose.getTranslation( 2 ) );
+}
+
+TEST( ClipBinding, evaluate )
+{
+	auto character = test::createCharacter();
+	auto skeleton = character->getComponent< Skeleton >();
+
+	auto binding = crimild::alloc< ClipBinding >( test::createClip( "clip", 1.0f ), skeleton );
+	EXPECT_EQ( 6, binding->getChannelCount() );
+	EXPECT_EQ( 2.0f, binding->getDuration() );
+
+	Pose pose;
+	skeleton->getCurrentPose( pose );
+
+	std::vector< crimild::Size > cursors( binding->getChannelCount(), 0 );
+	binding->evaluate( 1.0f, pose, cursors.data() );
+
+	for ( crimild::Size i = 0; i < 3; i++ ) {
+		EXPECT_EQ( Vector3f( 0.0f, 1.5f, 0.0f ), pose.getTranslation( i ) );
+		auto expected = Quaternion4f::createFromAxisAngle( Vector3f( 0.0f, 0.0f, 1.0f ), 1.0f );
+		EXPECT_NEAR( 1.0f, Numericf::fabs( expected.getRawData() * pose.getRotation( i ).getRawData() ), 1e-5f );
+	}
+}
+
+TEST( PoseAnimator, matchesAnimation )
+{
+	auto clip = test::createClip( "clip", 1.0f );
+
+	auto expected = test::createCharacter();
+	auto expectedSkeleton = expected->getComponent< Skeleton >();
+	auto animation = crimild::alloc< Animation >( clip );
+
+	auto actual = test::createCharacter();
+	auto actualSkeleton = actual->getComponent< Skeleton >();
+	auto animator = crimild::alloc< PoseAnimator >( crimild::retain( actualSkeleton ) );
+	animator->addLayer( crimild::alloc< ClipBinding >( clip, actualSkeleton ) );
+
+	for ( crimild::Size frame = 0; frame < 10; frame++ ) {
+		const auto dt = 0.3;
+
+		animation->update( Clock( dt ) );
+		expectedSkeleton->animate( animation );
+		expected->perform( UpdateWorldState() );
+		// Skeleton::animate() uses parent transformations from the previous update
+		expectedSkeleton->animate( animation );
+
+		animator->update( Clock( dt ) );
+		animator->evaluate();
+		animator->apply();
+		actual->perform( UpdateWorldState() );
+
+		for ( crimild::Size i = 0; i < 3; i++ ) {
+			auto name = "j" + std::to_string( i );
+			test::expectSameMatrix(
+				expectedSkeleton->getJoints()[ name ]->getPoseMatrix(),
+				actualSkeleton->getJointAt( i )->getPoseMatrix() );
+			test::expectSameMatrix(
+				expectedSkeleton->getJoints()[ name ]->getNode()->getWorld().computeModelMatrix(),
+				actualSkeleton->getJointAt( i )->getNode()->getWorld().computeModelMatrix() );
+		}
+	}
+}
+
+TEST( PoseAnimator, layers )
+{
+	auto character = test::createCharacter();
+	auto skeleton = character->getComponent< Skeleton >();
+
+	auto animator = crimild::alloc< PoseAnimator >( crimild::retain( skeleton ) );
+	animator->addLayer( crimild::alloc< ClipBinding >( test::createClip( "a", 0.0f ), skeleton ) );
+	auto layer = animator->addLayer( crimild::alloc< ClipBinding >( test::createClip( "b", 1.0f ), skeleton ), 0.0f );
+	EXPECT_EQ( 2, animator->getLayerCount() );
+
+	animator->update( Clock( 1.0 ) );
+	animator->evaluate();
+	EXPECT_NEAR( 1.0f, Numericf::fabs( animator->getPose().getRotation( 0 ).getRawData()[ 3 ] ), 1e-5f );
+
+	animator->setLayerWeight( layer, 0.5f );
+	animator->evaluate();
+	auto expected = Quaternion4f::createFromAxisAngle( Vector3f( 0.0f, 0.0f, 1.0f ), 0.5f );
+	EXPECT_NEAR( 1.0f, Numericf::fabs( expected.getRawData() * animator->getPose().getRotation( 0 ).getRawData() ), 1e-5f );
+}
+
+TEST( PoseBatch, matchesSequentialEvaluation )
+{
+	const crimild::Size CHARACTER_COUNT = 50;
+
+	auto clip = test::createClip( "clip", 1.0f );
+
+	std::vector< SharedPointer< Group >> expected;
+	std::vector< SharedPointer< PoseAnimator >> expectedAnimators;
+	std::vector< SharedPointer< Group >> actual;
+	std::vector< SharedPointer< PoseAnimator >> actualAnimators;
+
+	for ( crimild::Size i = 0; i < CHARACTER_COUNT; i++ ) {
+		expected.push_back( test::createCharacter() );
+		actual.push_back( test::createCharacter() );
+
+		auto s0 = expected.back()->getComponent< Skeleton >();
+		auto a0 = crimild::alloc< PoseAnimator >( crimild::retain( s0 ) );
+		a0->addLayer( crimild::alloc< ClipBinding >( clip, s0 ) );
+		a0->setTimeOffset( 0.1f * i );
+		expectedAnimators.push_back( a0 );
+
+		auto s1 = actual.back()->getComponent< Skeleton >();
+		auto a1 = crimild::alloc< PoseAnimator >( crimild::retain( s1 ) );
+		a1->addLayer( crimild::alloc< ClipBinding >( clip, s1 ) );
+		a1->setTimeOffset( 0.1f * i );
+		actualAnimators.push_back( a1 );
+	}
+
+	concurrency::JobScheduler scheduler;
+	scheduler.configure( 3 );
+	scheduler.start();
+
+	PoseBatch batch;
+	batch.setGrainSize( 4 );
+	for ( crimild::Size frame = 0; frame < 5; frame++ ) {
+		for ( crimild::Size i = 0; i < CHARACTER_COUNT; i++ ) {
+			expectedAnimators[ i ]->update( Clock( 0.25 ) );
+			expectedAnimators[ i ]->evaluate();
+			expectedAnimators[ i ]->apply();
+
+			actualAnimators[ i ]->update( Clock( 0.25 ) );
+			batch.add( actualAnimators[ i ] );
+		}
+		EXPECT_EQ( CHARACTER_COUNT, batch.getAnimatorCount() );
+		batch.execute();
+		EXPECT_EQ( 0, batch.getAnimatorCount() );
+	}
+
+	scheduler.stop();
+
+	for ( crimild::Size i = 0; i < CHARACTER_COUNT; i++ ) {
+		auto s0 = expected[ i ]->getComponent< Skeleton >();
+		auto s1 = actual[ i ]->getComponent< Skeleton >();
+		for ( crimild::Size j = 0; j < 3; j++ ) {
+			test::expectSameMatrix( s0->getJointAt( j )->getPoseMatrix(), s1->getJointAt( j )->getPoseMatrix() );
+			test::expectSameMatrix( s0->getJointAt( j )->getNode()->getLocal().computeModelMatrix(), s1->getJointAt( j )->getNode()->getLocal().computeModelMatrix() );
+		}
+	}
+}
@@ -0,0 +1,312 @@
+/*
+ * Copyright (c) 2013, Hernan Saez
+ * All rights reserved.
+ * 
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *     * Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in the
+ *       documentation and/or other materials provided with the distribution.
+ *     * Neither the name of the <organization> nor the
+ *       names of its contributors may be used to endorse or promote products
+ *       derived from this software without specific prior written permission.
+ * 
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL <COPYRIGHT HOLDER> BE LIABLE FOR ANY
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "Animation/SkinningEngine.hpp"
+#include "Animation/Skeleton.hpp"
+#include "Concurrency/JobScheduler.hpp"
+#include "Rendering/VertexBufferObject.hpp"
+#include "SceneGraph/Group.hpp"
+
+#include "gtest/gtest.h"
+
+using namespace crimild;
+using namespace crimild::animation;
+
+namespace crimild {
+
+	namespace test {
+
+		static const VertexFormat SKINNED_VERTEX_FORMAT( 3, 0, 3, 0, 0, 4, 4 );
+
+		static Transformation createJointTransformation( crimild::Size index )
+		{
+			Transformation t;
+			t.setTranslate( 0.5f * index, 1.0f - index, 0.25f * index );
+			t.setRotate( Quaternion4f::createFromAxisAngle( Vector3f( 1.0f, 2.0f, 3.0f - index ).getNormalized(), 0.4f * index ) );
+			t.setScale( 1.0f + 0.1f * index );
+			return t;
+		}
+
+		static std::vector< Transformation > createPalette( SkinningPalette &palette, crimild::Size jointCount )
+		{
+			std::vector< Transformation > transforms;
+			palette.resize( jointCount );
+			for ( crimild::Size i = 0; i < jointCount; i++ ) {
+				transforms.push_back( createJointTransformation( i ) );
+				palette.set( i, transforms.back().computeModelMatrix() );
+			}
+			return transforms;
+		}
+
+		/**
+		   \brief Vertices with up to four influences. Some weights are zero
+		 */
+		static SharedPointer< VertexBufferObject > createSkinnedVertices( crimild::Size vertexCount, crimild::Size jointCount, crimild::Size influences )
+		{
+			auto vbo = crimild::alloc< VertexBufferObject >( SKINNED_VERTEX_FORMAT, vertexCount );
+			for ( crimild::Size v = 0; v < vertexCount; v++ ) {
+				vbo->setPositionAt( v, Vector3f( std::sin( 0.1f * v ), 0.01f * v, std::cos( 0.3f * v ) ) );
+				vbo->setNormalAt( v, Vector3f( 1.0f, 0.5f * std::sin( 0.7f * v ), 0.25f ).getNormalized() );
+
+				const auto count = 1 + v % influences;
+				crimild::Real32 total = 0.0f;
+				for ( crimild::Size k = 0; k < count; k++ ) {
+					total += 1.0f + k;
+				}
+				for ( crimild::Size k = 0; k < 4; k++ ) {
+					vbo->setBoneIdAt( v, k, ( v + 3 * k ) % jointCount );
+					vbo->setBoneWeightAt( v, k, k < count ? ( 1.0f + k ) / total : 0.0f );
+				}
+			}
+			return vbo;
+		}
+
+		static void expectSameVertices( const VertexBufferObject *expected, const VertexBufferObject *actual, crimild::Real32 tolerance )
+		{
+			ASSERT_EQ( expected->getVertexCount(), actual->getVertexCount() );
+			for ( crimild::Size v = 0; v < expected->getVertexCount(); v++ ) {
+				for ( crimild::Size i = 0; i < 3; i++ ) {
+					EXPECT_NEAR( expected->getPositionAt( v )[ i ], actual->getPositionAt( v )[ i ], tolerance );
+					EXPECT_NEAR( expected->getNormalAt( v )[ i ], actual->getNormalAt( v )[ i ], tolerance );
+				}
+			}
+		}
+
+	}
+
+}
+
+TEST( SkinningEngine, linearBlend )
+{
+	const crimild::Size JOINT_COUNT = 5;
+
+	SkinningPalette palette;
+	auto transforms = test::createPalette( palette, JOINT_COUNT );
+	auto input = test::createSkinnedVertices( 37, JOINT_COUNT, 4 );
+
+	const SkinningEngine::Kernel kernels[] = { SkinningEngine::Kernel::SCALAR, SkinningEngine::Kernel::SSE, SkinningEngine::Kernel::AVX };
+	for ( auto kernel : kernels ) {
+		SkinningEngine engine;
+		engine.setKernel( kernel );
+
+		auto output = SkinningEngine::createOutputBuffer( crimild::get_ptr( input ) );
+		ASSERT_TRUE( engine.skin( palette, crimild::get_ptr( input ), crimild::get_ptr( output ) ) );
+
+		for ( crimild::Size v = 0; v < input->getVertexCount(); v++ ) {
+			// same as the standard shader program
+			Vector3f expectedPosition( 0.0f, 0.0f, 0.0f );
+			Vector3f expectedNormal( 0.0f, 0.0f, 0.0f );
+			for ( crimild::Size k = 0; k < 4; k++ ) {
+				const auto &t = transforms[ static_cast< crimild::Size >( input->getBoneIdAt( v, k ) ) ];
+				const auto w = input->getBoneWeightAt( v, k );
+				Vector3f p, n;
+				t.applyToPoint( input->getPositionAt( v ), p );
+				t.applyToVector( input->getNormalAt( v ), n );
+				expectedPosition += w * p;
+				expectedNormal += w * n;
+			}
+			expectedNormal.normalize();
+
+			for ( crimild::Size i = 0; i < 3; i++ ) {
+				EXPECT_NEAR( expectedPosition[ i ], output->getPositionAt( v )[ i ], 1e-4f );
+				EXPECT_NEAR( expectedNormal[ i ], output->getNormalAt( v )[ i ], 1e-4f );
+			}
+		}
+	}
+}
+
+TEST( SkinningEngine, kernelsProduceSameResults )
+{
+	const crimild::Size JOINT_COUNT = 8;
+
+	SkinningPalette palette;
+	test::createPalette( palette, JOINT_COUNT );
+	auto input = test::createSkinnedVertices( 101, JOINT_COUNT, 4 );
+
+	const SkinningEngine::Method methods[] = { SkinningEngine::Method::LINEAR_BLEND, SkinningEngine::Method::DUAL_QUATERNION };
+	const SkinningEngine::Kernel kernels[] = { SkinningEngine::Kernel::SSE, SkinningEngine::Kernel::AVX };
+
+	for ( auto method : methods ) {
+		SkinningEngine reference;
+		reference.setMethod( method );
+		reference.setKernel( SkinningEngine::Kernel::SCALAR );
+		auto expected = SkinningEngine::createOutputBuffer( crimild::get_ptr( input ) );
+		reference.skin( palette, crimild::get_ptr( input ), crimild::get_ptr( expected ) );
+
+		for ( auto kernel : kernels ) {
+			SkinningEngine engine;
+			engine.setMethod( method );
+			engine.setKernel( kernel );
+			auto output = SkinningEngine::createOutputBuffer( crimild::get_ptr( input ) );
+			engine.skin( palette, crimild::get_ptr( input ), crimild::get_ptr( output ) );
+
+			test::expectSameVertices( crimild::get_ptr( expected ), crimild::get_ptr( output ), 1e-5f );
+		}
+	}
+}
+
+TEST( SkinningEngine, dualQuaternionRigid )
+{
+	const crimild::Size JOINT_COUNT = 6;
+
+	SkinningPalette palette;
+	test::createPalette( palette, JOINT_COUNT );
+
+	// a single influence per vertex
+	auto input = test::createSkinnedVertices( 50, JOINT_COUNT, 1 );
+
+	SkinningEngine linear;
+	auto expected = SkinningEngine::createOutputBuffer( crimild::get_ptr( input ) );
+	linear.skin( palette, crimild::get_ptr( input ), crimild::get_ptr( expected ) );
+
+	SkinningEngine dualQuaternion;
+	dualQuaternion.setMethod( SkinningEngine::Method::DUAL_QUATERNION );
+	auto output = SkinningEngine::createOutputBuffer( crimild::get_ptr( input ) );
+	dualQuaternion.skin( palette, crimild::get_ptr( input ), crimild::get_ptr( output ) );
+
+	test::expectSameVertices( crimild::get_ptr( expected ), crimild::get_ptr( output ), 1e-4f );
+}
+
+TEST( SkinningEngine, dualQuaternionPreservesVolume )
+{
+	// a twisted joint collapses vertices when using linear blending
+	SkinningPalette palette;
+	palette.resize( 2 );
+
+	Transformation twist;
+	twist.setRotate( Quaternion4f::createFromAxisAngle( Vector3f( 1.0f, 0.0f, 0.0f ), Numericf::PI ) );
+	palette.set( 1, twist.computeModelMatrix() );
+
+	auto input = crimild::alloc< VertexBufferObject >( test::SKINNED_VERTEX_FORMAT, 1 );
+	input->setPositionAt( 0, Vector3f( 0.0f, 1.0f, 0.0f ) );
+	input->setNormalAt( 0, Vector3f( 0.0f, 1.0f, 0.0f ) );
+	input->setBoneIdAt( 0, 0, 0 );
+	input->setBoneIdAt( 0, 1, 1 );
+	input->setBoneWeightAt( 0, 0, 0.5f );
+	input->setBoneWeightAt( 0, 1, 0.5f );
+
+	auto output = SkinningEngine::createOutputBuffer( crimild::get_ptr( input ) );
+
+	SkinningEngine engine;
+	engine.skin( palette, crimild::get_ptr( input ), crimild::get_ptr( output ) );
+	EXPECT_NEAR( 0.0f, output->getPositionAt( 0 ).getMagnitude(), 1e-5f );
+
+	engine.setMethod( SkinningEngine::Method::DUAL_QUATERNION );
+	engine.skin( palette, crimild::get_ptr( input ), crimild::get_ptr( output ) );
+	EXPECT_NEAR( 1.0f, output->getPositionAt( 0 ).getMagnitude(), 1e-5f );
+	EXPECT_NEAR( 1.0f, output->getNormalAt( 0 ).getMagnitude(), 1e-5f );
+}
+
+TEST( SkinningEngine, bounds )
+{
+	const crimild::Size JOINT_COUNT = 4;
+
+	SkinningPalette palette;
+	test::createPalette( palette, JOINT_COUNT );
+	auto input = test::createSkinnedVertices( 64, JOINT_COUNT, 3 );
+	auto output = SkinningEngine::createOutputBuffer( crimild::get_ptr( input ) );
+
+	SkinningEngine engine;
+	engine.skin( palette, crimild::get_ptr( input ), crimild::get_ptr( output ) );
+
+	Vector3f min = output->getPositionAt( 0 );
+	Vector3f max = output->getPositionAt( 0 );
+	for ( crimild::Size v = 1; v < output->getVertexCount(); v++ ) {
+		const auto &p = output->getPositionAt( v );
+		for ( crimild::Size i = 0; i < 3; i++ ) {
+			min[ i ] = Numericf::min( min[ i ], p[ i ] );
+			max[ i ] = Numericf::max( max[ i ], p[ i ] );
+		}
+	}
+
+	EXPECT_EQ( min, engine.getBoundsMin() );
+	EXPECT_EQ( max, engine.getBoundsMax() );
+}
+
+TEST( SkinningEngine, parallel )
+{
+	const crimild::Size JOINT_COUNT = 8;
+
+	SkinningPalette palette;
+	test::createPalette( palette, JOINT_COUNT );
+	auto input = test::createSkinnedVertices( 1000, JOINT_COUNT, 4 );
+
+	SkinningEngine engine;
+	engine.setGrainSize( 64 );
+
+	auto expected = SkinningEngine::createOutputBuffer( crimild::get_ptr( input ) );
+	engine.skin( palette, crimild::get_ptr( input ), crimild::get_ptr( expected ) );
+	auto expectedMin = engine.getBoundsMin();
+	auto expectedMax = engine.getBoundsMax();
+
+	concurrency::JobScheduler scheduler;
+	scheduler.configure( 3 );
+	scheduler.start();
+
+	auto output = SkinningEngine::createOutputBuffer( crimild::get_ptr( input ) );
+	engine.skin( palette, crimild::get_ptr( input ), crimild::get_ptr( output ) );
+
+	scheduler.stop();
+
+	test::expectSameVertices( crimild::get_ptr( expected ), crimild::get_ptr( output ), 0.0f );
+	EXPECT_EQ( expectedMin, engine.getBoundsMin() );
+	EXPECT_EQ( expectedMax, engine.getBoundsMax() );
+}
+
+TEST( SkinningPalette, update )
+{
+	auto root = crimild::alloc< Group >();
+	for ( crimild::UInt32 id : { 2, 0 } ) {
+		auto node = crimild::alloc< Group >();
+		auto joint = node->attachComponent< Joint >( "j" + std::to_string( id ), id );
+		joint->setPoseMatrix( test::createJointTransformation( id ).computeModelMatrix() );
+		root->attachNode( node );
+	}
+	auto skeleton = root->attachComponent< Skeleton >();
+	skeleton->bind();
+
+	SkinningPalette palette;
+	palette.update( skeleton );
+
+	// joints are indexed by id
+	ASSERT_EQ( 3, palette.getJointCount() );
+
+	for ( crimild::Size id : { 0, 2 } ) {
+		auto m = test::createJointTransformation( id ).computeModelMatrix();
+		auto rows = palette.getRows() + 12 * id;
+		for ( crimild::Size r = 0; r < 3; r++ ) {
+			for ( crimild::Size c = 0; c < 4; c++ ) {
+				EXPECT_EQ( m[ 4 * c + r ], rows[ 4 * r + c ] );
+			}
+		}
+		EXPECT_NEAR( test::createJointTransformation( id ).getScale(), palette.getScales()[ id ], 1e-5f );
+	}
+
+	// unused joints are set to identity
+	EXPECT_EQ( 1.0f, palette.getRows()[ 12 ] );
+	EXPECT_EQ( 1.0f, palette.getScales()[ 1 ] );
+}
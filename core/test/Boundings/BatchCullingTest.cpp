@@ -0,0 +1,181 @@
+/*
+ * Copyright (c) 2013, Hernan Saez
+ * All rights reserved.
+ * 
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *     * Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in the
+ *       documentation and/or other materials provided with the distribution.
+ *     * Neither the name of the <organization> nor the
+ *       names of its contributors may be used to endorse or promote products
+ *       derived from this software without specific prior written permission.
+ * 
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL <COPYRIGHT HOLDER> BE LIABLE FOR ANY
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "Boundings/BatchCulling.hpp"
+#include "Boundings/AABBBoundingVolume.hpp"
+#include "Boundings/PlaneBoundingVolume.hpp"
+#include "Boundings/SphereBoundingVolume.hpp"
+#include "SceneGraph/Camera.hpp"
+#include "Visitors/UpdateWorldState.hpp"
+
+#include "gtest/gtest.h"
+
+#include <random>
+#include <vector>
+
+using namespace crimild;
+
+namespace crimild {
+
+	namespace test {
+
+		SharedPointer< Camera > buildBatchCullingCamera( void )
+		{
+			auto camera = crimild::alloc< Camera >( 60.0f, 4.0f / 3.0f, 0.1f, 100.0f );
+			camera->local().setTranslate( 1.0f, 2.0f, 3.0f );
+			camera->local().rotate().fromAxisAngle( Vector3f( 1.0f, 1.0f, 0.0f ).getNormalized(), 0.3f );
+			camera->perform( UpdateWorldState() );
+			camera->computeCullingPlanes();
+			return camera;
+		}
+
+		std::vector< BatchCulling::Kernel > getBatchCullingKernels( void )
+		{
+			return { BatchCulling::Kernel::SCALAR, BatchCulling::Kernel::SSE, BatchCulling::Kernel::AVX };
+		}
+
+	}
+
+}
+
+TEST( BatchCullingTest, spheresMatchCamera )
+{
+	auto camera = test::buildBatchCullingCamera();
+
+	std::mt19937 rng( 1234 );
+	std::uniform_real_distribution< crimild::Real32 > position( -150.0f, 150.0f );
+	std::uniform_real_distribution< crimild::Real32 > radius( 0.0f, 20.0f );
+
+	// use an odd count, so SIMD kernels have remaining elements
+	const crimild::Size COUNT = 10007;
+
+	std::vector< SharedPointer< BoundingVolume >> volumes;
+	SphereBatch batch;
+	for ( crimild::Size i = 0; i < COUNT; i++ ) {
+		auto center = Vector3f( position( rng ), position( rng ), position( rng ) );
+		if ( i % 3 == 0 ) {
+			volumes.push_back( crimild::alloc< AABBBoundingVolume >( center, radius( rng ) ) );
+		}
+		else {
+			volumes.push_back( crimild::alloc< SphereBoundingVolume >( center, radius( rng ) ) );
+		}
+		batch.push( crimild::get_ptr( volumes.back() ) );
+	}
+
+	// planes are never culled
+	volumes.push_back( crimild::alloc< PlaneBoundingVolume >( Plane3f( Vector3f( 0.0f, 1.0f, 0.0f ), -1000.0f ) ) );
+	batch.push( crimild::get_ptr( volumes.back() ) );
+
+	ASSERT_EQ( volumes.size(), batch.getCount() );
+
+	crimild::Size culledCount = 0;
+	for ( auto kernel : test::getBatchCullingKernels() ) {
+		std::vector< crimild::UInt8 > visible( batch.getCount(), 2 );
+		BatchCulling::cull( batch, camera->getCullingPlanes(), Camera::CULLING_PLANE_COUNT, &visible[ 0 ], kernel );
+
+		culledCount = 0;
+		for ( crimild::Size i = 0; i < volumes.size(); i++ ) {
+			auto expected = !camera->culled( crimild::get_ptr( volumes[ i ] ) );
+			EXPECT_EQ( expected ? 1 : 0, visible[ i ] ) << "kernel: " << BatchCulling::getKernelName( kernel ) << ", index: " << i;
+			culledCount += expected ? 0 : 1;
+		}
+	}
+
+	EXPECT_GT( culledCount, 0 );
+	EXPECT_LT( culledCount, volumes.size() );
+}
+
+TEST( BatchCullingTest, spheresOnPlaneBoundaries )
+{
+	auto camera = test::buildBatchCullingCamera();
+
+	// spheres tangent to each plane from both sides, where rounding matters the most
+	SphereBatch batch;
+	std::vector< SharedPointer< BoundingVolume >> volumes;
+	for ( crimild::Size p = 0; p < Camera::CULLING_PLANE_COUNT; p++ ) {
+		const auto &plane = camera->getCullingPlane( p );
+		auto origin = -plane.getConstant() * plane.getNormal();
+		for ( int j = -8; j <= 8; j++ ) {
+			auto r = 0.5f + 0.001f * j;
+			volumes.push_back( crimild::alloc< SphereBoundingVolume >( origin - 0.5f * plane.getNormal(), r ) );
+			batch.push( crimild::get_ptr( volumes.back() ) );
+		}
+	}
+
+	std::vector< crimild::UInt8 > expected( batch.getCount() );
+	BatchCulling::cull( batch, camera->getCullingPlanes(), Camera::CULLING_PLANE_COUNT, &expected[ 0 ], BatchCulling::Kernel::SCALAR );
+	for ( crimild::Size i = 0; i < volumes.size(); i++ ) {
+		EXPECT_EQ( camera->culled( crimild::get_ptr( volumes[ i ] ) ) ? 0 : 1, expected[ i ] );
+	}
+
+	for ( auto kernel : test::getBatchCullingKernels() ) {
+		std::vector< crimild::UInt8 > visible( batch.getCount() );
+		BatchCulling::cull( batch, camera->getCullingPlanes(), Camera::CULLING_PLANE_COUNT, &visible[ 0 ], kernel );
+		EXPECT_EQ( expected, visible ) << "kernel: " << BatchCulling::getKernelName( kernel );
+	}
+}
+
+TEST( BatchCullingTest, boxesMatchScalar )
+{
+	auto camera = test::buildBatchCullingCamera();
+
+	std::mt19937 rng( 4321 );
+	std::uniform_real_distribution< crimild::Real32 > position( -150.0f, 150.0f );
+	std::uniform_real_distribution< crimild::Real32 > size( 0.0f, 20.0f );
+
+	BoxBatch batch;
+	for ( crimild::Size i = 0; i < 5003; i++ ) {
+		auto min = Vector3f( position( rng ), position( rng ), position( rng ) );
+		batch.push( min, min + Vector3f( size( rng ), size( rng ), size( rng ) ) );
+	}
+
+	std::vector< crimild::UInt8 > expected( batch.getCount() );
+	BatchCulling::cull( batch, camera->getCullingPlanes(), Camera::CULLING_PLANE_COUNT, &expected[ 0 ], BatchCulling::Kernel::SCALAR );
+
+	crimild::Size visibleCount = 0;
+	for ( auto v : expected ) {
+		visibleCount += v;
+	}
+	EXPECT_GT( visibleCount, 0 );
+	EXPECT_LT( visibleCount, batch.getCount() );
+
+	for ( auto kernel : test::getBatchCullingKernels() ) {
+		std::vector< crimild::UInt8 > visible( batch.getCount() );
+		BatchCulling::cull( batch, camera->getCullingPlanes(), Camera::CULLING_PLANE_COUNT, &visible[ 0 ], kernel );
+		EXPECT_EQ( expected, visible ) << "kernel: " << BatchCulling::getKernelName( kernel );
+	}
+}
+
+TEST( BatchCullingTest, emptyBatch )
+{
+	auto camera = test::buildBatchCullingCamera();
+
+	SphereBatch batch;
+	BatchCulling::cull( batch, camera->getCullingPlanes(), Camera::CULLING_PLANE_COUNT, nullptr );
+
+	EXPECT_EQ( 0, batch.getCount() );
+}
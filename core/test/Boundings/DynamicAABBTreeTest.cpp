@@ -0,0 +1,178 @@
+/*
+ * Copyright (c) 2013, Hernan Saez
+ * All rights reserved.
+ * 
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *     * Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in the
+ *       documentation and/or other materials provided with the distribution.
+ *     * Neither the name of the <organization> nor the
+ *       names of its contributors may be used to endorse or promote products
+ *       derived from this software without specific prior written permission.
+ * 
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL <COPYRIGHT HOLDER> BE LIABLE FOR ANY
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "Boundings/DynamicAABBTree.hpp"
+
+#include "gtest/gtest.h"
+
+#include <algorithm>
+#include <vector>
+
+using namespace crimild;
+
+namespace crimild {
+
+	namespace test {
+
+		std::vector< crimild::Int32 > queryTree( const DynamicAABBTree &tree, const Vector3f &min, const Vector3f &max )
+		{
+			std::vector< crimild::Int32 > result;
+			tree.query(
+				[ &min, &max ]( const Vector3f &nodeMin, const Vector3f &nodeMax ) {
+					for ( int i = 0; i < 3; i++ ) {
+						if ( nodeMax[ i ] < min[ i ] || nodeMin[ i ] > max[ i ] ) {
+							return DynamicAABBTree::TestResult::OUTSIDE;
+						}
+					}
+					return DynamicAABBTree::TestResult::INTERSECTS;
+				},
+				[ &result ]( DynamicAABBTree::ProxyId, void *userData, bool ) {
+					result.push_back( *static_cast< crimild::Int32 * >( userData ) );
+				}
+			);
+			std::sort( result.begin(), result.end() );
+			return result;
+		}
+
+	}
+
+}
+
+TEST( DynamicAABBTreeTest, construction )
+{
+	DynamicAABBTree tree;
+
+	EXPECT_EQ( 0, tree.getProxyCount() );
+	EXPECT_EQ( 0, tree.getHeight() );
+	EXPECT_TRUE( tree.validate() );
+}
+
+TEST( DynamicAABBTreeTest, createProxies )
+{
+	DynamicAABBTree tree( 0.0f );
+
+	std::vector< crimild::Int32 > values( 100 );
+	for ( crimild::Int32 i = 0; i < 100; i++ ) {
+		values[ i ] = i;
+		auto p = Vector3f( i * 10.0f, 0.0f, 0.0f );
+		auto proxy = tree.createProxy( p - Vector3f( 1.0f, 1.0f, 1.0f ), p + Vector3f( 1.0f, 1.0f, 1.0f ), &values[ i ] );
+		EXPECT_EQ( &values[ i ], tree.getUserData( proxy ) );
+	}
+
+	EXPECT_EQ( 100, tree.getProxyCount() );
+	EXPECT_TRUE( tree.validate() );
+
+	// balanced trees for 100 leaves should be close to log2( 100 )
+	EXPECT_LE( tree.getHeight(), 10 );
+
+	auto result = test::queryTree( tree, Vector3f( 15.0f, -1.0f, -1.0f ), Vector3f( 35.0f, 1.0f, 1.0f ) );
+	ASSERT_EQ( 2, result.size() );
+	EXPECT_EQ( 2, result[ 0 ] );
+	EXPECT_EQ( 3, result[ 1 ] );
+}
+
+TEST( DynamicAABBTreeTest, moveProxy )
+{
+	DynamicAABBTree tree( 0.5f );
+
+	crimild::Int32 value = 1;
+	auto proxy = tree.createProxy( Vector3f( -1.0f, -1.0f, -1.0f ), Vector3f( 1.0f, 1.0f, 1.0f ), &value );
+
+	// small movements are absorbed by the fat box
+	EXPECT_FALSE( tree.moveProxy( proxy, Vector3f( -0.9f, -1.0f, -1.0f ), Vector3f( 1.1f, 1.0f, 1.0f ) ) );
+
+	EXPECT_TRUE( tree.moveProxy( proxy, Vector3f( 9.0f, -1.0f, -1.0f ), Vector3f( 11.0f, 1.0f, 1.0f ) ) );
+	EXPECT_TRUE( tree.validate() );
+	EXPECT_EQ( 1, tree.getProxyCount() );
+
+	EXPECT_TRUE( test::queryTree( tree, Vector3f( -1.0f, -1.0f, -1.0f ), Vector3f( 1.0f, 1.0f, 1.0f ) ).empty() );
+	EXPECT_EQ( 1, test::queryTree( tree, Vector3f( 9.0f, -1.0f, -1.0f ), Vector3f( 11.0f, 1.0f, 1.0f ) ).size() );
+}
+
+TEST( DynamicAABBTreeTest, destroyProxies )
+{
+	DynamicAABBTree tree;
+
+	std::vector< crimild::Int32 > values( 50 );
+	std::vector< DynamicAABBTree::ProxyId > proxies;
+	for ( crimild::Int32 i = 0; i < 50; i++ ) {
+		values[ i ] = i;
+		auto p = Vector3f( 0.0f, i * 3.0f, 0.0f );
+		proxies.push_back( tree.createProxy( p, p + Vector3f( 1.0f, 1.0f, 1.0f ), &values[ i ] ) );
+	}
+
+	for ( crimild::Int32 i = 0; i < 50; i += 2 ) {
+		tree.destroyProxy( proxies[ i ] );
+	}
+
+	EXPECT_EQ( 25, tree.getProxyCount() );
+	EXPECT_TRUE( tree.validate() );
+
+	auto result = test::queryTree( tree, Vector3f( -100.0f, -100.0f, -100.0f ), Vector3f( 100.0f, 200.0f, 100.0f ) );
+	ASSERT_EQ( 25, result.size() );
+	for ( auto v : result ) {
+		EXPECT_EQ( 1, v % 2 );
+	}
+
+	// freed nodes are recycled
+	crimild::Int32 extra = 100;
+	tree.createProxy( Vector3f( 0.0f, 0.0f, 0.0f ), Vector3f( 1.0f, 1.0f, 1.0f ), &extra );
+	EXPECT_EQ( 26, tree.getProxyCount() );
+	EXPECT_TRUE( tree.validate() );
+
+	tree.clear();
+	EXPECT_EQ( 0, tree.getProxyCount() );
+	EXPECT_TRUE( tree.validate() );
+}
+
+TEST( DynamicAABBTreeTest, insideBranchesSkipTests )
+{
+	DynamicAABBTree tree;
+
+	std::vector< crimild::Int32 > values( 16 );
+	for ( crimild::Int32 i = 0; i < 16; i++ ) {
+		values[ i ] = i;
+		auto p = Vector3f( i * 2.0f, 0.0f, 0.0f );
+		tree.createProxy( p, p + Vector3f( 1.0f, 1.0f, 1.0f ), &values[ i ] );
+	}
+
+	crimild::Size testCount = 0;
+	crimild::Size visitCount = 0;
+	tree.query(
+		[ &testCount ]( const Vector3f &, const Vector3f & ) {
+			++testCount;
+			return DynamicAABBTree::TestResult::INSIDE;
+		},
+		[ &visitCount ]( DynamicAABBTree::ProxyId, void *, bool inside ) {
+			EXPECT_TRUE( inside );
+			++visitCount;
+		}
+	);
+
+	EXPECT_EQ( 1, testCount );
+	EXPECT_EQ( 16, visitCount );
+}
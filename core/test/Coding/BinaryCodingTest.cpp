@@ -0,0 +1,396 @@
+/*
+ * Copyright (c) 2013, Hernan Saez
+ * All rights reserved.
+ * 
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *     * Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in the
+ *       documentation and/or other materials provided with the distribution.
+ *     * Neither the name of the <organization> nor the
+ *       names of its contributors may be used to endorse or promote products
+ *       derived from this software without specific prior written permission.
+ * 
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL <COPYRIGHT HOLDER> BE LIABLE FOR ANY
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "Coding/Codable.hpp"
+#include "Coding/BinaryEncoder.hpp"
+#include "Coding/BinaryDecoder.hpp"
+#include "SceneGraph/Node.hpp"
+#include "SceneGraph/Group.hpp"
+#include "Rendering/VertexBufferObject.hpp"
+#include "Rendering/IndexBufferObject.hpp"
+#include "Rendering/Image.hpp"
+#include "Foundation/ObjectFactory.hpp"
+
+#include "gtest/gtest.h"
+
+#include <cstddef>
+
+namespace crimild {
+    
+    class BinaryCodableNode : public Node {
+        CRIMILD_IMPLEMENT_RTTI( crimild::BinaryCodableNode )
+        
+    public:
+		explicit BinaryCodableNode( std::string name = "" ) : Node( name ) { }
+        virtual ~BinaryCodableNode( void ) { }
+
+		containers::Array< int > &getValues( void ) { return _values; }
+		containers::Array< Vector3f > &getPositions( void ) { return _positions; }
+		containers::Array< SharedPointer< BinaryCodableNode > > &getChildren( void ) { return _children; }
+		SharedPointer< Group > &getGroup( void ) { return _group; }
+		SharedPointer< VertexBufferObject > &getVBO( void ) { return _vbo; }
+		SharedPointer< IndexBufferObject > &getIBO( void ) { return _ibo; }
+		SharedPointer< Image > &getImage( void ) { return _image; }
+        
+    private:
+		containers::Array< int > _values;
+		containers::Array< Vector3f > _positions;
+        containers::Array< SharedPointer< BinaryCodableNode >> _children;
+        SharedPointer< Group > _group;
+        SharedPointer< VertexBufferObject > _vbo;
+        SharedPointer< IndexBufferObject > _ibo;
+        SharedPointer< Image > _image;
+        
+    public:
+        virtual void encode( coding::Encoder &encoder ) override
+        {
+            Node::encode( encoder );
+            
+            encoder.encode( "values", _values );
+            encoder.encode( "positions", _positions );
+            encoder.encode( "children", _children );
+            encoder.encode( "group", _group );
+            encoder.encode( "vbo", _vbo );
+            encoder.encode( "ibo", _ibo );
+            encoder.encode( "image", _image );
+        }
+        
+        virtual void decode( coding::Decoder &decoder ) override
+        {
+            Node::decode( decoder );
+            
+            decoder.decode( "values", _values );
+            decoder.decode( "positions", _positions );
+            decoder.decode( "children", _children );
+            decoder.decode( "group", _group );
+            decoder.decode( "vbo", _vbo );
+            decoder.decode( "ibo", _ibo );
+            decoder.decode( "image", _image );
+        }
+        
+    };
+
+	static void registerBinaryCodingBuilders( void )
+	{
+		CRIMILD_REGISTER_OBJECT_BUILDER( crimild::BinaryCodableNode )
+		CRIMILD_REGISTER_OBJECT_BUILDER( crimild::Group )
+		CRIMILD_REGISTER_OBJECT_BUILDER( crimild::VertexBufferObject )
+		CRIMILD_REGISTER_OBJECT_BUILDER( crimild::IndexBufferObject )
+		CRIMILD_REGISTER_OBJECT_BUILDER( crimild::Image )
+	}
+
+	static SharedPointer< BinaryCodableNode > createBinaryCodableScene( void )
+	{
+		auto n = crimild::alloc< BinaryCodableNode >( "a scene" );
+		n->getValues() = { 1, 2, 3, 4, 5 };
+		n->getPositions() = { Vector3f( 1, 2, 3 ), Vector3f( 4, 5, 6 ) };
+		n->local().setTranslate( 10, 20, 30 );
+		n->world().setTranslate( 50, 70, 90 );
+		n->setWorldIsCurrent( true );
+
+		VertexPrecision vertices[] = {
+			-1.0f, -1.0f, 0.0f,
+			1.0f, -1.0f, 0.0f,
+			0.0f, 1.0f, 0.0f,
+		};
+		n->getVBO() = crimild::alloc< VertexBufferObject >( VertexFormat::VF_P3, 3, vertices );
+
+		IndexPrecision indices[] = { 0, 1, 2 };
+		n->getIBO() = crimild::alloc< IndexBufferObject >( 3, indices );
+
+		unsigned char pixels[] = {
+			255, 0, 0, 255,
+			0, 255, 0, 255,
+			0, 0, 255, 255,
+			255, 255, 255, 255,
+		};
+		n->getImage() = crimild::alloc< Image >( 2, 2, 4, pixels );
+
+		return n;
+	}
+    
+}
+
+using namespace crimild;
+
+TEST( BinaryCodingTest, codingEncoding )
+{
+	registerBinaryCodingBuilders();
+
+	auto n = createBinaryCodableScene();
+
+	auto encoder = crimild::alloc< coding::BinaryEncoder >();
+	encoder->encode( n );
+	auto bytes = encoder->getBytes();
+
+	auto decoder = crimild::alloc< coding::BinaryDecoder >();
+	EXPECT_TRUE( decoder->fromBytes( bytes ) );
+	ASSERT_EQ( 1, decoder->getObjectCount() );
+
+	auto n2 = decoder->getObjectAt< BinaryCodableNode >( 0 );
+	ASSERT_TRUE( n2 != nullptr );
+
+	EXPECT_EQ( n->getName(), n2->getName() );
+	EXPECT_EQ( n->getValues(), n2->getValues() );
+	EXPECT_EQ( n->getPositions(), n2->getPositions() );
+	EXPECT_EQ( n->getLocal().getTranslate(), n2->getLocal().getTranslate() );
+	EXPECT_EQ( n->getWorld().getTranslate(), n2->getWorld().getTranslate() );
+	EXPECT_EQ( n->worldIsCurrent(), n2->worldIsCurrent() );
+	EXPECT_EQ( nullptr, n2->getGroup() );
+
+	ASSERT_TRUE( n2->getVBO() != nullptr );
+	EXPECT_EQ( n->getVBO()->getVertexCount(), n2->getVBO()->getVertexCount() );
+	EXPECT_EQ( n->getVBO()->getVertexFormat(), n2->getVBO()->getVertexFormat() );
+	EXPECT_EQ( 0, memcmp( n->getVBO()->getData(), n2->getVBO()->getData(), n->getVBO()->getSizeInBytes() ) );
+
+	ASSERT_TRUE( n2->getIBO() != nullptr );
+	EXPECT_EQ( n->getIBO()->getIndexCount(), n2->getIBO()->getIndexCount() );
+	EXPECT_EQ( 0, memcmp( n->getIBO()->getData(), n2->getIBO()->getData(), n->getIBO()->getSizeInBytes() ) );
+
+	ASSERT_TRUE( n2->getImage() != nullptr );
+	EXPECT_EQ( 2, n2->getImage()->getWidth() );
+	EXPECT_EQ( 2, n2->getImage()->getHeight() );
+	EXPECT_EQ( 4, n2->getImage()->getBpp() );
+	EXPECT_EQ( 0, memcmp( n->getImage()->getData(), n2->getImage()->getData(), 16 ) );
+}
+
+TEST( BinaryCodingTest, codingArray )
+{
+	registerBinaryCodingBuilders();
+
+	auto n = crimild::alloc< BinaryCodableNode >( "a scene" );
+	for ( int i = 0; i < 3; i++ ) {
+		auto child = crimild::alloc< BinaryCodableNode >( "child " + std::to_string( i ) );
+		child->getValues() = { i, i + 1 };
+		child->getChildren().add( crimild::alloc< BinaryCodableNode >( "grandchild " + std::to_string( i ) ) );
+		n->getChildren().add( child );
+	}
+	n->getValues() = { 42 };
+
+	auto encoder = crimild::alloc< coding::BinaryEncoder >();
+	encoder->encode( n );
+
+	auto decoder = crimild::alloc< coding::BinaryDecoder >();
+	EXPECT_TRUE( decoder->fromBytes( encoder->getBytes() ) );
+
+	auto n2 = decoder->getObjectAt< BinaryCodableNode >( 0 );
+	ASSERT_TRUE( n2 != nullptr );
+
+	// values encoded after nested arrays must not be affected by them
+	EXPECT_EQ( n->getValues(), n2->getValues() );
+
+	ASSERT_EQ( 3, n2->getChildren().size() );
+	for ( int i = 0; i < 3; i++ ) {
+		auto child = n2->getChildren()[ i ];
+		ASSERT_TRUE( child != nullptr );
+		EXPECT_EQ( "child " + std::to_string( i ), child->getName() );
+		EXPECT_EQ( n->getChildren()[ i ]->getValues(), child->getValues() );
+		ASSERT_EQ( 1, child->getChildren().size() );
+		EXPECT_EQ( "grandchild " + std::to_string( i ), child->getChildren()[ 0 ]->getName() );
+	}
+}
+
+TEST( BinaryCodingTest, sharedObjects )
+{
+	registerBinaryCodingBuilders();
+
+	auto group = crimild::alloc< Group >( "shared" );
+
+	auto n = crimild::alloc< BinaryCodableNode >( "a scene" );
+	n->getGroup() = group;
+	for ( int i = 0; i < 2; i++ ) {
+		auto child = crimild::alloc< BinaryCodableNode >();
+		child->getGroup() = group;
+		n->getChildren().add( child );
+	}
+
+	// the same child twice
+	auto first = n->getChildren()[ 0 ];
+	n->getChildren().add( first );
+
+	auto encoder = crimild::alloc< coding::BinaryEncoder >();
+	encoder->encode( n );
+
+	auto decoder = crimild::alloc< coding::BinaryDecoder >();
+	EXPECT_TRUE( decoder->fromBytes( encoder->getBytes() ) );
+
+	auto n2 = decoder->getObjectAt< BinaryCodableNode >( 0 );
+	ASSERT_TRUE( n2 != nullptr );
+	ASSERT_TRUE( n2->getGroup() != nullptr );
+	EXPECT_EQ( "shared", n2->getGroup()->getName() );
+
+	ASSERT_EQ( 3, n2->getChildren().size() );
+	EXPECT_EQ( n2->getGroup(), n2->getChildren()[ 0 ]->getGroup() );
+	EXPECT_EQ( n2->getGroup(), n2->getChildren()[ 1 ]->getGroup() );
+	EXPECT_EQ( n2->getChildren()[ 0 ], n2->getChildren()[ 2 ] );
+	EXPECT_NE( n2->getChildren()[ 0 ], n2->getChildren()[ 1 ] );
+}
+
+TEST( BinaryCodingTest, zeroCopy )
+{
+	registerBinaryCodingBuilders();
+
+	auto n = createBinaryCodableScene();
+
+	auto encoder = crimild::alloc< coding::BinaryEncoder >();
+	encoder->encode( n );
+	ASSERT_TRUE( encoder->write( "binary_coding.crimild" ) );
+
+	SharedPointer< BinaryCodableNode > n2;
+	{
+		// decoder goes out of scope, but data must remain valid
+		auto decoder = crimild::alloc< coding::BinaryDecoder >();
+		ASSERT_TRUE( decoder->read( "binary_coding.crimild" ) );
+		n2 = decoder->getObjectAt< BinaryCodableNode >( 0 );
+	}
+
+	ASSERT_TRUE( n2 != nullptr );
+
+	auto vbo = n2->getVBO();
+	ASSERT_TRUE( vbo != nullptr );
+	EXPECT_TRUE( vbo->isExternal() );
+	EXPECT_EQ( 0, reinterpret_cast< std::uintptr_t >( vbo->getData() ) % coding::binary::ALIGNMENT );
+	EXPECT_EQ( 0, memcmp( n->getVBO()->getData(), vbo->getData(), n->getVBO()->getSizeInBytes() ) );
+
+	auto ibo = n2->getIBO();
+	ASSERT_TRUE( ibo != nullptr );
+	EXPECT_TRUE( ibo->isExternal() );
+	EXPECT_EQ( 3, ibo->getIndexCount() );
+	EXPECT_EQ( 2, ibo->getIndexAt( 2 ) );
+
+	auto image = n2->getImage();
+	ASSERT_TRUE( image != nullptr );
+	EXPECT_TRUE( image->isExternal() );
+	EXPECT_TRUE( image->isLoaded() );
+	EXPECT_EQ( 0, memcmp( n->getImage()->getData(), image->getData(), 16 ) );
+
+	// modifying data must not affect the file
+	ibo->setIndexAt( 0, 2 );
+	EXPECT_EQ( 2, ibo->getIndexAt( 0 ) );
+
+	// growing the buffer copies external data
+	ibo->setUsedCount( 6 );
+	EXPECT_FALSE( ibo->isExternal() );
+	EXPECT_EQ( 2, ibo->getIndexAt( 0 ) );
+	EXPECT_EQ( 1, ibo->getIndexAt( 1 ) );
+	EXPECT_EQ( 2, ibo->getIndexAt( 2 ) );
+
+	auto decoder = crimild::alloc< coding::BinaryDecoder >();
+	ASSERT_TRUE( decoder->read( "binary_coding.crimild" ) );
+	auto n3 = decoder->getObjectAt< BinaryCodableNode >( 0 );
+	EXPECT_EQ( 0, n3->getIBO()->getIndexAt( 0 ) );
+}
+
+TEST( BinaryCodingTest, encodeExternalData )
+{
+	registerBinaryCodingBuilders();
+
+	auto n = createBinaryCodableScene();
+
+	auto encoder = crimild::alloc< coding::BinaryEncoder >();
+	encoder->encode( n );
+
+	auto decoder = crimild::alloc< coding::BinaryDecoder >();
+	ASSERT_TRUE( decoder->fromBytes( encoder->getBytes() ) );
+	auto n2 = decoder->getObjectAt< BinaryCodableNode >( 0 );
+	ASSERT_TRUE( n2 != nullptr );
+	ASSERT_TRUE( n2->getVBO()->isExternal() );
+	ASSERT_TRUE( n2->getImage()->isExternal() );
+
+	// encoding must not copy external data into the objects
+	auto reencoder = crimild::alloc< coding::BinaryEncoder >();
+	reencoder->encode( n2 );
+	EXPECT_TRUE( n2->getVBO()->isExternal() );
+	EXPECT_TRUE( n2->getIBO()->isExternal() );
+	EXPECT_TRUE( n2->getImage()->isExternal() );
+
+	auto redecoder = crimild::alloc< coding::BinaryDecoder >();
+	ASSERT_TRUE( redecoder->fromBytes( reencoder->getBytes() ) );
+	auto n3 = redecoder->getObjectAt< BinaryCodableNode >( 0 );
+	ASSERT_TRUE( n3 != nullptr );
+	ASSERT_EQ( n->getVBO()->getSizeInBytes(), n3->getVBO()->getSizeInBytes() );
+	EXPECT_EQ( 0, memcmp( n->getVBO()->getData(), n3->getVBO()->getData(), n->getVBO()->getSizeInBytes() ) );
+	EXPECT_EQ( 0, memcmp( n->getImage()->getData(), n3->getImage()->getData(), 16 ) );
+}
+
+TEST( BinaryCodingTest, invalidData )
+{
+	registerBinaryCodingBuilders();
+
+	containers::ByteArray garbage( 256 );
+	for ( crimild::Size i = 0; i < garbage.size(); i++ ) {
+		garbage[ i ] = i;
+	}
+
+	auto decoder = crimild::alloc< coding::BinaryDecoder >();
+	EXPECT_FALSE( decoder->fromBytes( garbage ) );
+	EXPECT_EQ( 0, decoder->getObjectCount() );
+
+	// truncated data
+	auto encoder = crimild::alloc< coding::BinaryEncoder >();
+	encoder->encode( createBinaryCodableScene() );
+	auto bytes = encoder->getBytes();
+
+	containers::ByteArray truncated( bytes.size() / 2 );
+	memcpy( truncated.getData(), bytes.getData(), truncated.size() );
+
+	decoder = crimild::alloc< coding::BinaryDecoder >();
+	EXPECT_FALSE( decoder->fromBytes( truncated ) );
+	EXPECT_EQ( 0, decoder->getObjectCount() );
+}
+
+TEST( BinaryCodingTest, misalignedSections )
+{
+	registerBinaryCodingBuilders();
+
+	auto encoder = crimild::alloc< coding::BinaryEncoder >();
+	encoder->encode( createBinaryCodableScene() );
+	auto bytes = encoder->getBytes();
+
+	auto corrupt = [ &bytes ]( crimild::Size fieldOffset ) {
+		containers::ByteArray corrupted( bytes );
+		crimild::UInt64 offset;
+		memcpy( &offset, corrupted.getData() + fieldOffset, sizeof( offset ) );
+		offset += 4;
+		memcpy( corrupted.getData() + fieldOffset, &offset, sizeof( offset ) );
+		return corrupted;
+	};
+
+	const crimild::Size sectionOffsets[] = {
+		offsetof( coding::binary::Header, stringsOffset ),
+		offsetof( coding::binary::Header, objectsOffset ),
+		offsetof( coding::binary::Header, fieldsOffset ),
+		offsetof( coding::binary::Header, rootsOffset ),
+		offsetof( coding::binary::Header, blobsOffset ),
+	};
+
+	for ( auto sectionOffset : sectionOffsets ) {
+		auto decoder = crimild::alloc< coding::BinaryDecoder >();
+		EXPECT_FALSE( decoder->fromBytes( corrupt( sectionOffset ) ) ) << "header offset: " << sectionOffset;
+		EXPECT_EQ( 0, decoder->getObjectCount() );
+	}
+}
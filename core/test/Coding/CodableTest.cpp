@@ -30,12 +30,18 @@
 #include "Coding/Decoder.hpp"
 #include "Coding/MemoryEncoder.hpp"
 #include "Coding/MemoryDecoder.hpp"
+#include "Coding/FileEncoder.hpp"
+#include "Coding/FileDecoder.hpp"
 #include "SceneGraph/Node.hpp"
 #include "SceneGraph/Group.hpp"
 #include "Foundation/ObjectFactory.hpp"
+#include "Concurrency/JobScheduler.hpp"
 
 #include "gtest/gtest.h"
 
+#include <cstdio>
+#include <cstdlib>
+
 namespace crimild {
     
     class CodableNode : public Node {
@@ -132,3 +138,206 @@ TEST( CodableTest, codingArray )
 	EXPECT_EQ( n->getChildren()[ 2 ]->getName(), n2->getChildren()[ 2 ]->getName() );	
 }
 
+TEST( CodableTest, codingSharedObjects )
+{
+    CRIMILD_REGISTER_OBJECT_BUILDER( crimild::CodableNode )
+
+    auto shared = crimild::alloc< crimild::CodableNode >( "shared" );
+    shared->getValues() = { 1, 2, 3 };
+
+    auto n = crimild::alloc< crimild::CodableNode >( "a scene" );
+    n->getChildren().add( shared );
+    n->getChildren().add( crimild::alloc< crimild::CodableNode >( "child" ) );
+    n->getChildren().add( shared );
+    n->getChildren()[ 1 ]->getChildren().add( shared );
+
+	auto encoder = crimild::alloc< crimild::coding::MemoryEncoder >();
+	encoder->encode( n );
+
+	auto decoder = crimild::alloc< crimild::coding::MemoryDecoder >();
+	EXPECT_TRUE( decoder->fromBytes( encoder->getBytes() ) );
+	auto n2 = decoder->getObjectAt< crimild::CodableNode >( 0 );
+
+	ASSERT_TRUE( n2 != nullptr );
+	ASSERT_EQ( 3, n2->getChildren().size() );
+	EXPECT_EQ( n2->getChildren()[ 0 ], n2->getChildren()[ 2 ] );
+	EXPECT_EQ( n2->getChildren()[ 0 ], n2->getChildren()[ 1 ]->getChildren()[ 0 ] );
+	EXPECT_EQ( shared->getValues(), n2->getChildren()[ 0 ]->getValues() );
+}
+
+static std::string getTemporaryFilePath( std::string fileName )
+{
+	const char *dir = std::getenv( "TMPDIR" );
+	if ( dir == nullptr ) {
+		dir = std::getenv( "TEMP" );
+	}
+	if ( dir == nullptr ) {
+#ifdef _WIN32
+		dir = ".";
+#else
+		dir = "/tmp";
+#endif
+	}
+
+	return std::string( dir ) + "/" + fileName;
+}
+
+TEST( CodableTest, codingIncremental )
+{
+    CRIMILD_REGISTER_OBJECT_BUILDER( crimild::CodableNode )
+
+	auto encoder = crimild::alloc< crimild::coding::FileEncoder >();
+
+	auto shared = crimild::alloc< crimild::CodableNode >( "shared" );
+	for ( int i = 0; i < 3; i++ ) {
+		auto root = crimild::alloc< crimild::CodableNode >( "root " + std::to_string( i ) );
+		root->getChildren().add( shared );
+
+		containers::Array< int > values( 100 );
+		for ( int j = 0; j < 100; j++ ) {
+			values[ j ] = i * j;
+		}
+		root->getValues() = values;
+
+		encoder->encode( root );
+	}
+
+	auto path = getTemporaryFilePath( "codable_incremental.crimild" );
+	ASSERT_TRUE( encoder->write( path ) );
+
+	auto decoder = crimild::alloc< crimild::coding::FileDecoder >();
+
+	// smaller than most records
+	decoder->setChunkSize( 16 );
+
+	std::vector< SharedPointer< crimild::CodableNode >> roots;
+	EXPECT_TRUE( decoder->read( path, [ & ]( SharedPointer< SharedObject > const &obj ) {
+		auto root = crimild::cast_ptr< crimild::CodableNode >( obj );
+		ASSERT_TRUE( root != nullptr );
+
+		// roots are fully decoded as soon as they are read
+		EXPECT_EQ( roots.size() + 1, decoder->getObjectCount() );
+		EXPECT_EQ( "root " + std::to_string( roots.size() ), root->getName() );
+		ASSERT_EQ( 100, root->getValues().size() );
+		EXPECT_EQ( roots.size() * 99, root->getValues()[ 99 ] );
+		ASSERT_EQ( 1, root->getChildren().size() );
+		EXPECT_EQ( "shared", root->getChildren()[ 0 ]->getName() );
+
+		roots.push_back( root );
+	}));
+
+	ASSERT_EQ( 3, roots.size() );
+	EXPECT_EQ( roots[ 0 ]->getChildren()[ 0 ], roots[ 1 ]->getChildren()[ 0 ] );
+	EXPECT_EQ( roots[ 0 ]->getChildren()[ 0 ], roots[ 2 ]->getChildren()[ 0 ] );
+
+	std::remove( path.c_str() );
+}
+
+
+namespace crimild {
+
+	/**
+	   \brief Builds a few levels of nodes with shared leaves
+	 */
+	static SharedPointer< CodableNode > createParallelCodingScene( void )
+	{
+		auto shared = crimild::alloc< CodableNode >( "shared" );
+		shared->getValues() = { 7, 8, 9 };
+
+		auto scene = crimild::alloc< CodableNode >( "scene" );
+		for ( int i = 0; i < 5; i++ ) {
+			auto branch = crimild::alloc< CodableNode >( "branch " + std::to_string( i ) );
+			for ( int j = 0; j < 5; j++ ) {
+				auto leaf = crimild::alloc< CodableNode >( "leaf " + std::to_string( i ) + " " + std::to_string( j ) );
+				leaf->getValues() = { i, j };
+				leaf->local().setTranslate( i, j, 0 );
+				branch->getChildren().add( leaf );
+			}
+			branch->getChildren().add( shared );
+			scene->getChildren().add( branch );
+		}
+		return scene;
+	}
+
+	static void expectParallelCodingScene( SharedPointer< CodableNode > const &scene )
+	{
+		ASSERT_TRUE( scene != nullptr );
+		EXPECT_EQ( "scene", scene->getName() );
+		ASSERT_EQ( 5, scene->getChildren().size() );
+		for ( int i = 0; i < 5; i++ ) {
+			auto branch = scene->getChildren()[ i ];
+			EXPECT_EQ( "branch " + std::to_string( i ), branch->getName() );
+			ASSERT_EQ( 6, branch->getChildren().size() );
+			for ( int j = 0; j < 5; j++ ) {
+				auto leaf = branch->getChildren()[ j ];
+				EXPECT_EQ( "leaf " + std::to_string( i ) + " " + std::to_string( j ), leaf->getName() );
+				EXPECT_EQ( containers::Array< int >( { i, j } ), leaf->getValues() );
+				EXPECT_EQ( Vector3f( i, j, 0 ), leaf->getLocal().getTranslate() );
+			}
+			EXPECT_EQ( scene->getChildren()[ 0 ]->getChildren()[ 5 ], branch->getChildren()[ 5 ] );
+		}
+		EXPECT_EQ( containers::Array< int >( { 7, 8, 9 } ), scene->getChildren()[ 0 ]->getChildren()[ 5 ]->getValues() );
+	}
+
+}
+
+TEST( CodableTest, codingParallel )
+{
+    CRIMILD_REGISTER_OBJECT_BUILDER( crimild::CodableNode )
+
+	auto encoder = crimild::alloc< crimild::coding::MemoryEncoder >();
+	encoder->encode( createParallelCodingScene() );
+	auto bytes = encoder->getBytes();
+
+	// no scheduler: everything is decoded on the calling thread
+	{
+		auto decoder = crimild::alloc< crimild::coding::MemoryDecoder >();
+		decoder->setParallelDecodingEnabled( true );
+		EXPECT_TRUE( decoder->fromBytes( bytes ) );
+		ASSERT_EQ( 1, decoder->getObjectCount() );
+		expectParallelCodingScene( decoder->getObjectAt< crimild::CodableNode >( 0 ) );
+	}
+
+	concurrency::JobScheduler scheduler;
+	scheduler.configure( 3 );
+	scheduler.start();
+
+	{
+		auto decoder = crimild::alloc< crimild::coding::MemoryDecoder >();
+		decoder->setParallelDecodingEnabled( true );
+		EXPECT_TRUE( decoder->fromBytes( bytes ) );
+		ASSERT_EQ( 1, decoder->getObjectCount() );
+		expectParallelCodingScene( decoder->getObjectAt< crimild::CodableNode >( 0 ) );
+	}
+
+	scheduler.stop();
+}
+
+TEST( CodableTest, codingParallelFile )
+{
+    CRIMILD_REGISTER_OBJECT_BUILDER( crimild::CodableNode )
+
+	auto encoder = crimild::alloc< crimild::coding::FileEncoder >();
+	encoder->encode( createParallelCodingScene() );
+	encoder->encode( crimild::alloc< crimild::CodableNode >( "second" ) );
+	ASSERT_TRUE( encoder->write( "codable_parallel.crimild" ) );
+
+	concurrency::JobScheduler scheduler;
+	scheduler.configure( 3 );
+	scheduler.start();
+
+	auto decoder = crimild::alloc< crimild::coding::FileDecoder >();
+	decoder->setParallelDecodingEnabled( true );
+
+	std::vector< SharedPointer< SharedObject >> roots;
+	EXPECT_TRUE( decoder->read( "codable_parallel.crimild", [ &roots ]( SharedPointer< SharedObject > const &obj ) {
+		roots.push_back( obj );
+	}));
+
+	scheduler.stop();
+
+	// roots are notified in order
+	ASSERT_EQ( 2, roots.size() );
+	expectParallelCodingScene( crimild::cast_ptr< crimild::CodableNode >( roots[ 0 ] ) );
+	EXPECT_EQ( "second", crimild::cast_ptr< crimild::CodableNode >( roots[ 1 ] )->getName() );
+}
@@ -0,0 +1,107 @@
+/*
+ * Copyright (c) 2013, Hernan Saez
+ * All rights reserved.
+ * 
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *     * Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in the
+ *       documentation and/or other materials provided with the distribution.
+ *     * Neither the name of the <organization> nor the
+ *       names of its contributors may be used to endorse or promote products
+ *       derived from this software without specific prior written permission.
+ * 
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL <COPYRIGHT HOLDER> BE LIABLE FOR ANY
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "Concurrency/JobArena.hpp"
+
+#include "gtest/gtest.h"
+
+#include <deque>
+#include <set>
+
+using namespace crimild;
+using namespace crimild::concurrency;
+
+TEST( JobArenaTest, rewindsWhenIdle )
+{
+	JobArena arena;
+
+	for ( int frame = 0; frame < 10; frame++ ) {
+		std::vector< Job * > jobs;
+		for ( crimild::Size i = 0; i < 3 * JobArena::BLOCK_SIZE; i++ ) {
+			jobs.push_back( arena.allocate() );
+		}
+		for ( auto job : jobs ) {
+			arena.release( job );
+		}
+		EXPECT_EQ( 0, arena.getPendingCount() );
+	}
+
+	EXPECT_EQ( 3 * JobArena::BLOCK_SIZE, arena.getCapacity() );
+}
+
+TEST( JobArenaTest, steadyLoad )
+{
+	JobArena arena;
+
+	// the arena is never idle, but only a few jobs are pending at a time
+	const crimild::Size IN_FLIGHT = JobArena::BLOCK_SIZE / 2;
+	std::deque< Job * > jobs;
+	for ( crimild::Size i = 0; i < 100 * JobArena::BLOCK_SIZE; i++ ) {
+		jobs.push_back( arena.allocate() );
+		if ( jobs.size() > IN_FLIGHT ) {
+			arena.release( jobs.front() );
+			jobs.pop_front();
+		}
+	}
+
+	EXPECT_EQ( IN_FLIGHT, arena.getPendingCount() );
+	EXPECT_LE( arena.getCapacity(), 2 * JobArena::BLOCK_SIZE );
+}
+
+TEST( JobArenaTest, pendingJobsAreNotReused )
+{
+	JobArena arena;
+
+	// keep one job from the first block alive
+	auto longJob = arena.allocate();
+
+	std::set< Job * > pending;
+	pending.insert( longJob );
+
+	std::deque< Job * > jobs;
+	for ( crimild::Size i = 0; i < 10 * JobArena::BLOCK_SIZE; i++ ) {
+		auto job = arena.allocate();
+		EXPECT_EQ( 0, pending.count( job ) );
+		pending.insert( job );
+		jobs.push_back( job );
+
+		if ( jobs.size() > 10 ) {
+			pending.erase( jobs.front() );
+			arena.release( jobs.front() );
+			jobs.pop_front();
+		}
+	}
+
+	EXPECT_LE( arena.getCapacity(), 3 * JobArena::BLOCK_SIZE );
+
+	arena.release( longJob );
+	while ( !jobs.empty() ) {
+		arena.release( jobs.front() );
+		jobs.pop_front();
+	}
+	EXPECT_EQ( 0, arena.getPendingCount() );
+}
@@ -0,0 +1,96 @@
+/*
+ * Copyright (c) 2013, Hernan Saez
+ * All rights reserved.
+ * 
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *     * Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in the
+ *       documentation and/or other materials provided with the distribution.
+ *     * Neither the name of the <organization> nor the
+ *       names of its contributors may be used to endorse or promote products
+ *       derived from this software without specific prior written permission.
+ * 
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL <COPYRIGHT HOLDER> BE LIABLE FOR ANY
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "Concurrency/JobClosure.hpp"
+
+#include "gtest/gtest.h"
+
+#include <memory>
+
+using namespace crimild;
+using namespace crimild::concurrency;
+
+TEST( JobClosureTest, basicConstruction )
+{
+	JobClosure closure;
+
+	EXPECT_FALSE( closure.isValid() );
+}
+
+TEST( JobClosureTest, invoke )
+{
+	int count = 0;
+
+	JobClosure closure;
+	closure.set( [ &count ] { count++; } );
+
+	EXPECT_TRUE( closure.isValid() );
+
+	closure();
+	closure();
+
+	EXPECT_EQ( 2, count );
+}
+
+TEST( JobClosureTest, releaseCapturedValues )
+{
+	auto value = std::make_shared< int >( 5 );
+
+	JobClosure closure;
+	closure.set( [ value ] { } );
+
+	EXPECT_EQ( 2, value.use_count() );
+
+	closure.reset();
+
+	EXPECT_FALSE( closure.isValid() );
+	EXPECT_EQ( 1, value.use_count() );
+}
+
+TEST( JobClosureTest, bigCallable )
+{
+	struct Big {
+		char data[ 2 * JobClosure::STORAGE_SIZE ];
+	};
+
+	Big big;
+	big.data[ 0 ] = 'a';
+	char result = 0;
+
+	auto value = std::make_shared< int >( 5 );
+
+	{
+		JobClosure closure;
+		closure.set( [ big, value, &result ] { result = big.data[ 0 ]; } );
+		EXPECT_EQ( 2, value.use_count() );
+
+		closure();
+	}
+
+	EXPECT_EQ( 'a', result );
+	EXPECT_EQ( 1, value.use_count() );
+}
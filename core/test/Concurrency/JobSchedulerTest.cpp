@@ -0,0 +1,200 @@
+/*
+ * Copyright (c) 2013, Hernan Saez
+ * All rights reserved.
+ * 
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *     * Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in the
+ *       documentation and/or other materials provided with the distribution.
+ *     * Neither the name of the <organization> nor the
+ *       names of its contributors may be used to endorse or promote products
+ *       derived from this software without specific prior written permission.
+ * 
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL <COPYRIGHT HOLDER> BE LIABLE FOR ANY
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "Concurrency/JobScheduler.hpp"
+#include "Concurrency/Async.hpp"
+
+#include "gtest/gtest.h"
+
+#include <atomic>
+
+using namespace crimild;
+using namespace crimild::concurrency;
+
+TEST( JobSchedulerTest, workerIndex )
+{
+	JobScheduler scheduler;
+	scheduler.configure( 2 );
+
+	EXPECT_EQ( -1, scheduler.getWorkerIndex() );
+
+	scheduler.start();
+
+	EXPECT_EQ( 0, scheduler.getWorkerIndex() );
+	EXPECT_TRUE( scheduler.isMainWorker() );
+
+	scheduler.stop();
+}
+
+TEST( JobSchedulerTest, mainWorkerOnly )
+{
+	JobScheduler scheduler;
+	scheduler.configure( 0 );
+	scheduler.start();
+
+	std::atomic< int > count( 0 );
+
+	auto parent = crimild::concurrency::async();
+	for ( int i = 0; i < 100; i++ ) {
+		crimild::concurrency::async( parent, [ &count ] {
+			count++;
+		});
+	}
+	crimild::concurrency::wait( parent );
+
+	EXPECT_EQ( 100, count );
+
+	scheduler.stop();
+}
+
+TEST( JobSchedulerTest, stress )
+{
+	const int JOB_COUNT = 50000;
+
+	JobScheduler scheduler;
+	scheduler.configure( 4 );
+	scheduler.start();
+
+	std::atomic< int > count( 0 );
+
+	auto parent = crimild::concurrency::async();
+	for ( int i = 0; i < JOB_COUNT / 10; i++ ) {
+		// jobs spawning jobs, so workers push into their own queues
+		crimild::concurrency::async( parent, [ parent, &count ] {
+			for ( int j = 0; j < 9; j++ ) {
+				crimild::concurrency::async( parent, [ &count ] {
+					count++;
+				});
+			}
+			count++;
+		});
+	}
+	crimild::concurrency::wait( parent );
+
+	EXPECT_EQ( JOB_COUNT, count );
+
+	size_t total = 0;
+	scheduler.eachWorkerStat( [ &total ]( JobScheduler::WorkerId, const JobScheduler::WorkerStat &stat ) {
+		total += stat.jobCount;
+	});
+	EXPECT_GE( total, JOB_COUNT - 4 );
+
+	scheduler.stop();
+}
+
+TEST( JobSchedulerTest, restart )
+{
+	JobScheduler scheduler;
+
+	for ( int run = 0; run < 3; run++ ) {
+		scheduler.configure( 2 );
+		scheduler.start();
+
+		std::atomic< int > count( 0 );
+		auto parent = crimild::concurrency::async();
+		for ( int i = 0; i < 1000; i++ ) {
+			crimild::concurrency::async( parent, [ &count ] { count++; } );
+		}
+		crimild::concurrency::wait( parent );
+		EXPECT_EQ( 1000, count );
+
+		scheduler.stop();
+	}
+}
+
+TEST( JobSchedulerTest, arenaJobs )
+{
+	JobScheduler scheduler;
+	scheduler.configure( 2 );
+	scheduler.start();
+
+	std::atomic< int > count( 0 );
+
+	auto parent = crimild::concurrency::async_arena();
+	EXPECT_TRUE( parent->isArenaJob() );
+	for ( int i = 0; i < 10000; i++ ) {
+		crimild::concurrency::async_arena( parent, [ &count ] {
+			count++;
+		});
+	}
+	crimild::concurrency::wait( parent );
+
+	EXPECT_EQ( 10000, count );
+
+	scheduler.stop();
+}
+
+TEST( JobSchedulerTest, nestedArenaJobs )
+{
+	JobScheduler scheduler;
+	scheduler.configure( 2 );
+	scheduler.start();
+
+	std::atomic< int > count( 0 );
+
+	auto parent = crimild::concurrency::async_arena();
+	for ( int i = 0; i < 100; i++ ) {
+		crimild::concurrency::async_arena( parent, [ parent, &count ] {
+			for ( int j = 0; j < 100; j++ ) {
+				crimild::concurrency::async_arena( parent, [ &count ] {
+					count++;
+				});
+			}
+		});
+	}
+	crimild::concurrency::wait( parent );
+
+	EXPECT_EQ( 10000, count );
+
+	scheduler.stop();
+}
+
+TEST( JobSchedulerTest, arenaRecycling )
+{
+	JobScheduler scheduler;
+	scheduler.configure( 0 );
+	scheduler.start();
+
+	Job *firstParent = nullptr;
+
+	for ( int frame = 0; frame < 10; frame++ ) {
+		auto parent = crimild::concurrency::async_arena();
+		if ( firstParent == nullptr ) {
+			firstParent = parent;
+		}
+
+		// the same memory is reused on every frame
+		EXPECT_EQ( firstParent, parent );
+
+		for ( int i = 0; i < 100; i++ ) {
+			crimild::concurrency::async_arena( parent, [] { } );
+		}
+		crimild::concurrency::wait( parent );
+	}
+
+	scheduler.stop();
+}
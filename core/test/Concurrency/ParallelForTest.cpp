@@ -0,0 +1,185 @@
+/*
+ * Copyright (c) 2013, Hernan Saez
+ * All rights reserved.
+ * 
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *     * Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in the
+ *       documentation and/or other materials provided with the distribution.
+ *     * Neither the name of the <organization> nor the
+ *       names of its contributors may be used to endorse or promote products
+ *       derived from this software without specific prior written permission.
+ * 
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL <COPYRIGHT HOLDER> BE LIABLE FOR ANY
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "Concurrency/ParallelFor.hpp"
+#include "Concurrency/TaskGraph.hpp"
+
+#include "gtest/gtest.h"
+
+#include <atomic>
+#include <thread>
+#include <vector>
+
+using namespace crimild;
+using namespace crimild::concurrency;
+
+TEST( ParallelForTest, visitsAllIndicesOnce )
+{
+	JobScheduler scheduler;
+	scheduler.configure( 3 );
+	scheduler.start();
+
+	const crimild::Size COUNT = 100000;
+	std::vector< std::atomic< int >> hits( COUNT );
+	for ( auto &h : hits ) {
+		h = 0;
+	}
+
+	crimild::concurrency::parallel_for( Range( 0, COUNT ), 100, [ &hits ]( Range const &r ) {
+		EXPECT_LE( r.size(), 100 );
+		for ( auto i = r.begin; i < r.end; i++ ) {
+			hits[ i ]++;
+		}
+	});
+
+	for ( crimild::Size i = 0; i < COUNT; i++ ) {
+		ASSERT_EQ( 1, hits[ i ] );
+	}
+
+	scheduler.stop();
+}
+
+TEST( ParallelForTest, automaticGrain )
+{
+	JobScheduler scheduler;
+	scheduler.configure( 2 );
+	scheduler.start();
+
+	std::atomic< crimild::Size > count( 0 );
+	crimild::concurrency::parallel_for( Range( 10, 1010 ), 0, [ &count ]( Range const &r ) {
+		count += r.size();
+	});
+
+	EXPECT_EQ( 1000, count );
+
+	scheduler.stop();
+}
+
+TEST( ParallelForTest, emptyRange )
+{
+	JobScheduler scheduler;
+	scheduler.configure( 0 );
+	scheduler.start();
+
+	bool called = false;
+	crimild::concurrency::parallel_for( Range( 5, 5 ), 1, [ &called ]( Range const & ) {
+		called = true;
+	});
+
+	EXPECT_FALSE( called );
+
+	scheduler.stop();
+}
+
+TEST( ParallelForTest, withoutScheduler )
+{
+	std::vector< int > hits( 1000, 0 );
+	auto callerId = std::this_thread::get_id();
+
+	crimild::concurrency::parallel_for( Range( 0, hits.size() ), 10, [ &hits, callerId ]( Range const &r ) {
+		EXPECT_EQ( callerId, std::this_thread::get_id() );
+		for ( auto i = r.begin; i < r.end; i++ ) {
+			hits[ i ]++;
+		}
+	});
+
+	for ( auto h : hits ) {
+		ASSERT_EQ( 1, h );
+	}
+}
+
+TEST( ParallelForTest, reduce )
+{
+	JobScheduler scheduler;
+	scheduler.configure( 3 );
+	scheduler.start();
+
+	auto sum = crimild::concurrency::parallel_reduce(
+		Range( 1, 10001 ),
+		64,
+		crimild::Size( 0 ),
+		[]( Range const &r ) {
+			crimild::Size s = 0;
+			for ( auto i = r.begin; i < r.end; i++ ) {
+				s += i;
+			}
+			return s;
+		},
+		[]( crimild::Size a, crimild::Size b ) {
+			return a + b;
+		}
+	);
+
+	EXPECT_EQ( 50005000, sum );
+
+	scheduler.stop();
+}
+
+TEST( ParallelForTest, deterministicReduce )
+{
+	const crimild::Size COUNT = 100000;
+	std::vector< float > values( COUNT );
+	for ( crimild::Size i = 0; i < COUNT; i++ ) {
+		values[ i ] = 1.0f / ( 1.0f + i );
+	}
+
+	auto sum = [ &values ] {
+		return crimild::concurrency::parallel_reduce(
+			Range( 0, values.size() ),
+			128,
+			0.0f,
+			[ &values ]( Range const &r ) {
+				float s = 0.0f;
+				for ( auto i = r.begin; i < r.end; i++ ) {
+					s += values[ i ];
+				}
+				return s;
+			},
+			[]( float a, float b ) { return a + b; }
+		);
+	};
+
+	// without a scheduler, all chunks are computed in the calling thread
+	auto expected = sum();
+
+	{
+		JobScheduler scheduler;
+		scheduler.configure( 0 );
+		scheduler.start();
+		EXPECT_EQ( expected, sum() );
+		scheduler.stop();
+	}
+
+	// floating point results must not depend on the number of workers
+	JobScheduler scheduler;
+	scheduler.configure( 4 );
+	scheduler.start();
+	for ( int i = 0; i < 10; i++ ) {
+		EXPECT_EQ( expected, sum() );
+	}
+	scheduler.stop();
+}
@@ -0,0 +1,141 @@
+/*
+ * Copyright (c) 2013, Hernan Saez
+ * All rights reserved.
+ * 
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *     * Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in the
+ *       documentation and/or other materials provided with the distribution.
+ *     * Neither the name of the <organization> nor the
+ *       names of its contributors may be used to endorse or promote products
+ *       derived from this software without specific prior written permission.
+ * 
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL <COPYRIGHT HOLDER> BE LIABLE FOR ANY
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "Concurrency/TaskGraph.hpp"
+#include "Concurrency/JobScheduler.hpp"
+
+#include "gtest/gtest.h"
+
+#include <atomic>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+using namespace crimild;
+using namespace crimild::concurrency;
+
+TEST( TaskGraphTest, basicConstruction )
+{
+	TaskGraph graph;
+
+	EXPECT_EQ( 0, graph.getTaskCount() );
+	EXPECT_TRUE( graph.isValid() );
+}
+
+TEST( TaskGraphTest, executeInOrder )
+{
+	JobScheduler scheduler;
+	scheduler.configure( 3 );
+	scheduler.start();
+
+	std::mutex mutex;
+	std::vector< std::string > trace;
+	auto log = [ &mutex, &trace ]( std::string name ) {
+		std::lock_guard< std::mutex > lock( mutex );
+		trace.push_back( name );
+	};
+
+	TaskGraph graph;
+	auto a = graph.addTask( "a", [ &log ] { log( "a" ); } );
+	auto b = graph.addTask( "b", [ &log ] { log( "b" ); } );
+	auto c1 = graph.addTask( "c1", [ &log ] { log( "c" ); } );
+	auto c2 = graph.addTask( "c2", [ &log ] { log( "c" ); } );
+	auto c3 = graph.addTask( "c3", [ &log ] { log( "c" ); } );
+	graph.addDependency( b, a );
+	graph.addDependency( c1, b );
+	graph.addDependency( c2, b );
+	graph.addDependency( c3, b );
+
+	EXPECT_EQ( 5, graph.getTaskCount() );
+	EXPECT_EQ( "c2", graph.getTaskName( c2 ) );
+
+	for ( int run = 0; run < 10; run++ ) {
+		trace.clear();
+
+		EXPECT_TRUE( graph.execute() );
+
+		ASSERT_EQ( 5, trace.size() );
+		EXPECT_EQ( "a", trace[ 0 ] );
+		EXPECT_EQ( "b", trace[ 1 ] );
+		EXPECT_EQ( "c", trace[ 2 ] );
+		EXPECT_EQ( "c", trace[ 3 ] );
+		EXPECT_EQ( "c", trace[ 4 ] );
+	}
+
+	scheduler.stop();
+}
+
+TEST( TaskGraphTest, callerAffinity )
+{
+	JobScheduler scheduler;
+	scheduler.configure( 3 );
+	scheduler.start();
+
+	auto caller = std::this_thread::get_id();
+	std::atomic< int > count( 0 );
+	std::atomic< bool > wrongThread( false );
+
+	TaskGraph graph;
+	auto first = graph.addTask( "first", [ &count ] { count++; } );
+	for ( int i = 0; i < 20; i++ ) {
+		auto t = graph.addTask( "caller", [ &, caller ] {
+			if ( std::this_thread::get_id() != caller ) {
+				wrongThread = true;
+			}
+			count++;
+		}, TaskGraph::Affinity::CALLER );
+		graph.addDependency( t, first );
+	}
+
+	EXPECT_TRUE( graph.execute() );
+
+	EXPECT_EQ( 21, count );
+	EXPECT_FALSE( wrongThread );
+
+	scheduler.stop();
+}
+
+TEST( TaskGraphTest, cycles )
+{
+	JobScheduler scheduler;
+	scheduler.configure( 0 );
+	scheduler.start();
+
+	bool executed = false;
+
+	TaskGraph graph;
+	auto a = graph.addTask( "a", [ &executed ] { executed = true; } );
+	auto b = graph.addTask( "b", [ &executed ] { executed = true; } );
+	graph.addDependency( a, b );
+	graph.addDependency( b, a );
+
+	EXPECT_FALSE( graph.isValid() );
+	EXPECT_FALSE( graph.execute() );
+	EXPECT_FALSE( executed );
+
+	scheduler.stop();
+}
@@ -0,0 +1,161 @@
+/*
+ * Copyright (c) 2013, Hernan Saez
+ * All rights reserved.
+ * 
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *     * Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in the
+ *       documentation and/or other materials provided with the distribution.
+ *     * Neither the name of the <organization> nor the
+ *       names of its contributors may be used to endorse or promote products
+ *       derived from this software without specific prior written permission.
+ * 
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL <COPYRIGHT HOLDER> BE LIABLE FOR ANY
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "Concurrency/WorkStealingDeque.hpp"
+
+#include "gtest/gtest.h"
+
+#include <thread>
+#include <vector>
+#include <atomic>
+
+using namespace crimild;
+
+TEST( WorkStealingQueueTest, basicConstruction )
+{
+	WorkStealingQueue< int * > q;
+
+	EXPECT_EQ( 0, q.size() );
+	EXPECT_TRUE( q.empty() );
+	EXPECT_EQ( nullptr, q.pop() );
+	EXPECT_EQ( nullptr, q.steal() );
+}
+
+TEST( WorkStealingQueueTest, pushPop )
+{
+	int values[] = { 1, 2, 3 };
+
+	WorkStealingQueue< int * > q;
+	q.push( &values[ 0 ] );
+	q.push( &values[ 1 ] );
+	q.push( &values[ 2 ] );
+
+	EXPECT_EQ( 3, q.size() );
+
+	EXPECT_EQ( &values[ 2 ], q.pop() );
+	EXPECT_EQ( &values[ 1 ], q.pop() );
+	EXPECT_EQ( &values[ 0 ], q.pop() );
+	EXPECT_EQ( nullptr, q.pop() );
+	EXPECT_TRUE( q.empty() );
+}
+
+TEST( WorkStealingQueueTest, steal )
+{
+	int values[] = { 1, 2, 3 };
+
+	WorkStealingQueue< int * > q;
+	q.push( &values[ 0 ] );
+	q.push( &values[ 1 ] );
+	q.push( &values[ 2 ] );
+
+	EXPECT_EQ( &values[ 0 ], q.steal() );
+	EXPECT_EQ( &values[ 2 ], q.pop() );
+	EXPECT_EQ( &values[ 1 ], q.steal() );
+	EXPECT_EQ( nullptr, q.steal() );
+	EXPECT_TRUE( q.empty() );
+}
+
+TEST( WorkStealingQueueTest, grow )
+{
+	const int COUNT = 100;
+	std::vector< int > values( COUNT );
+
+	WorkStealingQueue< int * > q( 4 );
+	for ( int i = 0; i < COUNT; i++ ) {
+		values[ i ] = i;
+		q.push( &values[ i ] );
+	}
+
+	EXPECT_EQ( COUNT, q.size() );
+	EXPECT_LE( COUNT, q.capacity() );
+
+	for ( int i = 0; i < COUNT; i++ ) {
+		EXPECT_EQ( i, *q.steal() );
+	}
+
+	EXPECT_TRUE( q.empty() );
+}
+
+TEST( WorkStealingQueueTest, stress )
+{
+	const int COUNT = 200000;
+	const int THIEVES = 4;
+
+	std::vector< int > values( COUNT );
+	std::vector< std::atomic< int >> hits( COUNT );
+	for ( int i = 0; i < COUNT; i++ ) {
+		values[ i ] = i;
+		hits[ i ] = 0;
+	}
+
+	// start with a small capacity to force the queue to grow while thieves are running
+	WorkStealingQueue< int * > q( 16 );
+	std::atomic< int > remaining( COUNT );
+
+	std::vector< std::thread > thieves;
+	for ( int t = 0; t < THIEVES; t++ ) {
+		thieves.push_back( std::thread( [ &q, &hits, &remaining ] {
+			while ( remaining > 0 ) {
+				auto v = q.steal();
+				if ( v != nullptr ) {
+					hits[ *v ]++;
+					remaining--;
+				}
+			}
+		}));
+	}
+
+	// owner interleaves pushes and pops
+	for ( int i = 0; i < COUNT; i++ ) {
+		q.push( &values[ i ] );
+		if ( i % 3 == 0 ) {
+			auto v = q.pop();
+			if ( v != nullptr ) {
+				hits[ *v ]++;
+				remaining--;
+			}
+		}
+	}
+
+	while ( remaining > 0 ) {
+		auto v = q.pop();
+		if ( v != nullptr ) {
+			hits[ *v ]++;
+			remaining--;
+		}
+	}
+
+	for ( auto &t : thieves ) {
+		t.join();
+	}
+
+	// every element must be retrieved exactly once
+	for ( int i = 0; i < COUNT; i++ ) {
+		ASSERT_EQ( 1, hits[ i ] ) << "Element " << i;
+	}
+	EXPECT_TRUE( q.empty() );
+}
@@ -0,0 +1,119 @@
+/*
+ * Copyright (c) 2013, Hernan Saez
+ * All rights reserved.
+ * 
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *     * Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in the
+ *       documentation and/or other materials provided with the distribution.
+ *     * Neither the name of the <organization> nor the
+ *       names of its contributors may be used to endorse or promote products
+ *       derived from this software without specific prior written permission.
+ * 
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL <COPYRIGHT HOLDER> BE LIABLE FOR ANY
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "Foundation/RadixSort.hpp"
+
+#include "gtest/gtest.h"
+
+#include <algorithm>
+#include <random>
+#include <vector>
+
+using namespace crimild;
+
+TEST( RadixSortTest, matchesStableSort )
+{
+	std::mt19937_64 rng( 42 );
+
+	std::vector< crimild::UInt64 > keys;
+	std::vector< crimild::UInt32 > values;
+	for ( crimild::UInt32 i = 0; i < 1000; i++ ) {
+		// only a few distinct keys, so there are plenty of ties
+		keys.push_back( ( rng() % 50 ) << ( 8 * ( i % 8 ) ) );
+		values.push_back( i );
+	}
+
+	std::vector< std::pair< crimild::UInt64, crimild::UInt32 >> expected;
+	for ( crimild::Size i = 0; i < keys.size(); i++ ) {
+		expected.push_back( std::make_pair( keys[ i ], values[ i ] ) );
+	}
+	std::stable_sort( expected.begin(), expected.end(), []( std::pair< crimild::UInt64, crimild::UInt32 > const &a, std::pair< crimild::UInt64, crimild::UInt32 > const &b ) {
+		return a.first < b.first;
+	});
+
+	RadixSort< crimild::UInt64, crimild::UInt32 > radixSort;
+	radixSort.sort( keys, values );
+
+	for ( crimild::Size i = 0; i < keys.size(); i++ ) {
+		EXPECT_EQ( expected[ i ].first, keys[ i ] );
+		EXPECT_EQ( expected[ i ].second, values[ i ] );
+	}
+}
+
+TEST( RadixSortTest, sharedDigits )
+{
+	std::vector< crimild::UInt32 > keys = { 0x0300, 0x0100, 0x0200, 0x0100 };
+	std::vector< crimild::UInt32 > values = { 0, 1, 2, 3 };
+
+	RadixSort< crimild::UInt32, crimild::UInt32 > radixSort;
+	radixSort.sort( keys, values );
+
+	EXPECT_EQ( 1, values[ 0 ] );
+	EXPECT_EQ( 3, values[ 1 ] );
+	EXPECT_EQ( 2, values[ 2 ] );
+	EXPECT_EQ( 0, values[ 3 ] );
+}
+
+TEST( RadixSortTest, floatKeys )
+{
+	std::vector< crimild::Real32 > input = { 3.5f, -1.0f, 0.0f, -20.0f, 1e10f, 0.25f };
+
+	for ( crimild::Size i = 0; i < input.size(); i++ ) {
+		for ( crimild::Size j = 0; j < input.size(); j++ ) {
+			EXPECT_EQ( input[ i ] < input[ j ], radixSortKey( input[ i ] ) < radixSortKey( input[ j ] ) );
+		}
+	}
+}
+
+TEST( RadixSortTest, wideDigits )
+{
+	std::mt19937 rng( 7 );
+
+	std::vector< crimild::UInt32 > keys;
+	std::vector< crimild::UInt32 > values;
+	for ( crimild::UInt32 i = 0; i < 5000; i++ ) {
+		keys.push_back( rng() % 100000 );
+		values.push_back( i );
+	}
+
+	std::vector< std::pair< crimild::UInt32, crimild::UInt32 >> expected;
+	for ( crimild::Size i = 0; i < keys.size(); i++ ) {
+		expected.push_back( std::make_pair( keys[ i ], values[ i ] ) );
+	}
+	std::stable_sort( expected.begin(), expected.end(), []( std::pair< crimild::UInt32, crimild::UInt32 > const &a, std::pair< crimild::UInt32, crimild::UInt32 > const &b ) {
+		return a.first < b.first;
+	});
+
+	// 11-bit digits sort 32-bit keys in three passes (the last one is only 10 bits wide)
+	RadixSort< crimild::UInt32, crimild::UInt32, 11 > radixSort;
+	radixSort.sort( keys, values );
+
+	for ( crimild::Size i = 0; i < keys.size(); i++ ) {
+		EXPECT_EQ( expected[ i ].first, keys[ i ] );
+		EXPECT_EQ( expected[ i ].second, values[ i ] );
+	}
+}
@@ -29,8 +29,50 @@
 
 #include "gtest/gtest.h"
 
+#include <limits>
+#include <random>
+#include <vector>
+
 using namespace crimild;
 
+namespace crimild {
+
+	namespace test {
+
+		std::vector< Intersection::Kernel > getIntersectionKernels( void )
+		{
+			return { Intersection::Kernel::SCALAR, Intersection::Kernel::SSE, Intersection::Kernel::AVX };
+		}
+
+		/**
+		   \brief Random rays aiming at the given point, plus a few axis-aligned ones
+		 */
+		std::vector< Ray3f > buildIntersectionRays( crimild::Size count, const Vector3f &target )
+		{
+			std::mt19937 rng( 4321 );
+			std::uniform_real_distribution< crimild::Real32 > value( -10.0f, 10.0f );
+			std::uniform_real_distribution< crimild::Real32 > noise( -2.0f, 2.0f );
+
+			std::vector< Ray3f > rays;
+			for ( crimild::Size i = 0; i < count; i++ ) {
+				Vector3f origin( value( rng ), value( rng ), value( rng ) );
+				Vector3f direction = target + Vector3f( noise( rng ), noise( rng ), noise( rng ) ) - origin;
+				rays.push_back( Ray3f( origin, direction.getNormalized() ) );
+			}
+
+			// rays lying on slab planes
+			rays.push_back( Ray3f( Vector3f( -1.0f, 0.0f, -5.0f ), Vector3f( 0.0f, 0.0f, 1.0f ) ) );
+			rays.push_back( Ray3f( Vector3f( 0.0f, 1.0f, -5.0f ), Vector3f( 0.0f, 0.0f, 1.0f ) ) );
+			rays.push_back( Ray3f( Vector3f( 0.0f, 0.0f, -5.0f ), Vector3f( 0.0f, 0.0f, 1.0f ) ) );
+			rays.push_back( Ray3f( Vector3f( 5.0f, 0.0f, 0.0f ), Vector3f( -1.0f, 0.0f, 0.0f ) ) );
+
+			return rays;
+		}
+
+	}
+
+}
+
 TEST( IntersectionTest, testRaySphere )
 {
 	Sphere3f s0( Vector3f( 0.0f, 0.0f, 0.0f ), 2.0f );
@@ -117,3 +159,125 @@ TEST( IntersectionTest, testRayTriangle )
 	//EXPECT_TRUE( Intersection::test( ray, p0, p1, p2 ) == false );
 }
 
+
+TEST( IntersectionTest, rayPacketCoherence )
+{
+	RayPacket4f packet;
+	EXPECT_EQ( 0, packet.getActiveMask() );
+	EXPECT_TRUE( packet.isCoherent() );
+
+	packet.set( 0, Ray3f( Vector3f( 0.0f, 0.0f, 0.0f ), Vector3f( 1.0f, 1.0f, -1.0f ).getNormalized() ) );
+	packet.set( 2, Ray3f( Vector3f( 1.0f, 0.0f, 0.0f ), Vector3f( 0.5f, 1.0f, -1.0f ).getNormalized() ) );
+	EXPECT_EQ( 0x5, packet.getActiveMask() );
+	EXPECT_TRUE( packet.isCoherent() );
+
+	packet.set( 3, Ray3f( Vector3f( 1.0f, 0.0f, 0.0f ), Vector3f( -0.5f, 1.0f, -1.0f ).getNormalized() ) );
+	EXPECT_EQ( 0xD, packet.getActiveMask() );
+	EXPECT_FALSE( packet.isCoherent() );
+
+	auto ray = packet.getRay( 2 );
+	EXPECT_EQ( Vector3f( 1.0f, 0.0f, 0.0f ), ray.getOrigin() );
+	EXPECT_EQ( Vector3f( 0.5f, 1.0f, -1.0f ).getNormalized(), ray.getDirection() );
+}
+
+TEST( IntersectionTest, rayPacketSphere )
+{
+	Sphere3f sphere( Vector3f( 0.0f, 0.0f, -10.0f ), 2.0f );
+
+	RayPacket8f packet;
+	packet.set( 0, Ray3f( Vector3f( 0.0f, 0.0f, 0.0f ), Vector3f( 0.0f, 0.0f, -1.0f ) ) );
+	packet.set( 1, Ray3f( Vector3f( 1.0f, 0.0f, 0.0f ), Vector3f( 0.0f, 0.0f, -1.0f ) ) );
+	packet.set( 2, Ray3f( Vector3f( 0.0f, 1.9f, 0.0f ), Vector3f( 0.0f, 0.0f, -1.0f ) ) );
+	packet.set( 3, Ray3f( Vector3f( 0.0f, 2.1f, 0.0f ), Vector3f( 0.0f, 0.0f, -1.0f ) ) );
+	packet.set( 4, Ray3f( Vector3f( 0.0f, 0.0f, 0.0f ), Vector3f( 0.0f, 0.0f, 1.0f ) ) );
+	// starts inside the sphere
+	packet.set( 5, Ray3f( Vector3f( 0.0f, 0.0f, -10.0f ), Vector3f( 1.0f, 0.0f, 0.0f ) ) );
+	packet.set( 6, Ray3f( Vector3f( 0.0f, 0.0f, 0.0f ), Vector3f( 0.0f, 0.0f, -1.0f ) ) );
+	// lane 7 is inactive
+
+	for ( auto kernel : test::getIntersectionKernels() ) {
+		crimild::Real32 t[ 8 ];
+		for ( auto &value : t ) {
+			value = std::numeric_limits< crimild::Real32 >::max();
+		}
+		// too far away
+		t[ 6 ] = 5.0f;
+
+		auto mask = Intersection::find( sphere, packet, t, Numericf::ZERO_TOLERANCE, kernel );
+		EXPECT_EQ( 0x27, mask ) << "kernel: " << Intersection::getKernelName( kernel );
+
+		for ( crimild::Size i = 0; i < 8; i++ ) {
+			if ( mask & ( 1u << i ) ) {
+				EXPECT_NEAR( Intersection::find( sphere, packet.getRay( i ) ), t[ i ], 1e-4f ) << "kernel: " << Intersection::getKernelName( kernel ) << ", index: " << i;
+			}
+		}
+		EXPECT_EQ( 5.0f, t[ 6 ] );
+	}
+}
+
+TEST( IntersectionTest, rayPacketSphereKernels )
+{
+	Sphere3f sphere( Vector3f( 1.0f, -2.0f, 3.0f ), 2.5f );
+	auto rays = test::buildIntersectionRays( 256, sphere.getCenter() );
+
+	for ( crimild::Size first = 0; first + 8 <= rays.size(); first += 8 ) {
+		RayPacket8f packet;
+		for ( crimild::Size i = 0; i < 8; i++ ) {
+			packet.set( i, rays[ first + i ] );
+		}
+
+		crimild::Real32 expected[ 8 ];
+		for ( auto &value : expected ) {
+			value = 100.0f;
+		}
+		auto expectedMask = Intersection::find( sphere, packet, expected, Numericf::ZERO_TOLERANCE, Intersection::Kernel::SCALAR );
+
+		for ( auto kernel : test::getIntersectionKernels() ) {
+			crimild::Real32 t[ 8 ];
+			for ( auto &value : t ) {
+				value = 100.0f;
+			}
+			EXPECT_EQ( expectedMask, Intersection::find( sphere, packet, t, Numericf::ZERO_TOLERANCE, kernel ) ) << "kernel: " << Intersection::getKernelName( kernel );
+			for ( crimild::Size i = 0; i < 8; i++ ) {
+				EXPECT_EQ( expected[ i ], t[ i ] ) << "kernel: " << Intersection::getKernelName( kernel ) << ", index: " << first + i;
+			}
+		}
+	}
+}
+
+TEST( IntersectionTest, rayPacketBox )
+{
+	Vector3f min( -1.0f, -1.0f, -1.0f );
+	Vector3f max( 1.0f, 1.0f, 1.0f );
+	auto rays = test::buildIntersectionRays( 256, Vector3f( 0.0f, 0.0f, 0.0f ) );
+
+	for ( crimild::Size first = 0; first + 4 <= rays.size(); first += 4 ) {
+		RayPacket4f packet;
+		for ( crimild::Size i = 0; i < 4; i++ ) {
+			packet.set( i, rays[ first + i ] );
+		}
+
+		const crimild::Real32 tMax[] = { 100.0f, 100.0f, 100.0f, 100.0f };
+		auto expected = Intersection::test( min, max, packet, tMax, 0.0f, Intersection::Kernel::SCALAR );
+
+		for ( crimild::Size i = 0; i < 4; i++ ) {
+			const auto &ray = rays[ first + i ];
+			if ( ray.getDirection()[ 0 ] != 0.0f && ray.getDirection()[ 1 ] != 0.0f && ray.getDirection()[ 2 ] != 0.0f ) {
+				EXPECT_EQ( Intersection::test( min, max, ray ), ( expected & ( 1u << i ) ) != 0 ) << "index: " << first + i;
+			}
+		}
+
+		for ( auto kernel : test::getIntersectionKernels() ) {
+			EXPECT_EQ( expected, Intersection::test( min, max, packet, tMax, 0.0f, kernel ) ) << "kernel: " << Intersection::getKernelName( kernel ) << ", index: " << first;
+		}
+	}
+
+	// the box is farther than tMax
+	RayPacket8f packet;
+	packet.set( 0, Ray3f( Vector3f( 0.0f, 0.0f, 10.0f ), Vector3f( 0.0f, 0.0f, -1.0f ) ) );
+	packet.set( 1, Ray3f( Vector3f( 0.0f, 0.0f, 10.0f ), Vector3f( 0.0f, 0.0f, -1.0f ) ) );
+	const crimild::Real32 tMax[] = { 5.0f, 20.0f, 20.0f, 20.0f, 20.0f, 20.0f, 20.0f, 20.0f };
+	for ( auto kernel : test::getIntersectionKernels() ) {
+		EXPECT_EQ( 0x2, Intersection::test( min, max, packet, tMax, 0.0f, kernel ) ) << "kernel: " << Intersection::getKernelName( kernel );
+	}
+}
@@ -0,0 +1,249 @@
+/*
+ * Copyright (c) 2013, Hernan Saez
+ * All rights reserved.
+ * 
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *     * Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in the
+ *       documentation and/or other materials provided with the distribution.
+ *     * Neither the name of the <organization> nor the
+ *       names of its contributors may be used to endorse or promote products
+ *       derived from this software without specific prior written permission.
+ * 
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL <COPYRIGHT HOLDER> BE LIABLE FOR ANY
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "ParticleSystem/ParticleKernels.hpp"
+#include "ParticleSystem/ParticleData.hpp"
+#include "ParticleSystem/Updaters/TimeParticleUpdater.hpp"
+#include "Mathematics/Transformation.hpp"
+
+#include "gtest/gtest.h"
+
+#include <random>
+#include <vector>
+
+using namespace crimild;
+
+namespace crimild {
+
+	namespace test {
+
+		// use an odd count, so SIMD kernels have remaining elements
+		const crimild::Size PARTICLE_KERNELS_COUNT = 1003;
+
+		std::vector< ParticleKernels::Kernel > getParticleKernels( void )
+		{
+			return { ParticleKernels::Kernel::SCALAR, ParticleKernels::Kernel::SSE, ParticleKernels::Kernel::AVX };
+		}
+
+		std::vector< Vector3f > buildParticleVectors( crimild::UInt32 seed, crimild::Real32 range )
+		{
+			std::mt19937 rng( seed );
+			std::uniform_real_distribution< crimild::Real32 > value( -range, range );
+
+			std::vector< Vector3f > result( PARTICLE_KERNELS_COUNT );
+			for ( auto &v : result ) {
+				v = Vector3f( value( rng ), value( rng ), value( rng ) );
+			}
+			return result;
+		}
+
+		void expectParticleVectorsEq( const std::vector< Vector3f > &expected, const std::vector< Vector3f > &actual, ParticleKernels::Kernel kernel )
+		{
+			ASSERT_EQ( expected.size(), actual.size() );
+			for ( crimild::Size i = 0; i < expected.size(); i++ ) {
+				for ( crimild::Size j = 0; j < 3; j++ ) {
+					EXPECT_EQ( expected[ i ][ j ], actual[ i ][ j ] ) << "kernel: " << ParticleKernels::getKernelName( kernel ) << ", index: " << i;
+				}
+			}
+		}
+
+	}
+
+}
+
+TEST( ParticleKernelsTest, integrate )
+{
+	const auto velocities = test::buildParticleVectors( 1, 10.0f );
+	const auto positions = test::buildParticleVectors( 2, 100.0f );
+	const auto g = Vector3f( 0.0f, -9.8f, 0.5f );
+	const crimild::Real32 dt = 0.016f;
+
+	for ( auto kernel : test::getParticleKernels() ) {
+		auto vs = velocities;
+		auto ps = positions;
+		ParticleKernels::add( &vs[ 0 ], g, vs.size(), kernel );
+		ParticleKernels::addScaled( &ps[ 0 ], &vs[ 0 ], dt, ps.size(), kernel );
+
+		auto expectedVs = velocities;
+		auto expectedPs = positions;
+		for ( crimild::Size i = 0; i < expectedVs.size(); i++ ) {
+			expectedVs[ i ] += g;
+			expectedPs[ i ] += dt * expectedVs[ i ];
+		}
+
+		test::expectParticleVectorsEq( expectedVs, vs, kernel );
+		test::expectParticleVectorsEq( expectedPs, ps, kernel );
+	}
+}
+
+TEST( ParticleKernelsTest, clampHeight )
+{
+	const auto positions = test::buildParticleVectors( 3, 10.0f );
+
+	for ( auto kernel : test::getParticleKernels() ) {
+		auto ps = positions;
+		ParticleKernels::clampHeight( &ps[ 0 ], 1.0f, ps.size(), kernel );
+
+		auto expected = positions;
+		for ( auto &p : expected ) {
+			if ( p.y() < 1.0f ) {
+				p.y() = 1.0f;
+			}
+		}
+
+		test::expectParticleVectorsEq( expected, ps, kernel );
+	}
+}
+
+TEST( ParticleKernelsTest, attract )
+{
+	const auto positions = test::buildParticleVectors( 4, 10.0f );
+	const auto accelerations = test::buildParticleVectors( 5, 1.0f );
+	const auto center = Vector3f( 1.0f, 2.0f, 3.0f );
+	const crimild::Real32 radius = 8.0f;
+
+	std::vector< Vector3f > reference;
+	for ( auto kernel : test::getParticleKernels() ) {
+		auto ps = positions;
+		auto as = accelerations;
+
+		// one particle at the center, which must be ignored
+		ps[ 5 ] = center;
+
+		ParticleKernels::attract( &ps[ 0 ], &as[ 0 ], center, radius, 0.5f, ps.size(), kernel );
+
+		crimild::Size affected = 0;
+		for ( crimild::Size i = 0; i < ps.size(); i++ ) {
+			auto direction = center - ps[ i ];
+			auto d = direction.getMagnitude();
+			if ( d > 0.0f && d <= radius ) {
+				auto expected = accelerations[ i ] + ( 0.5f * ( 1.0f - d / radius ) ) * ( direction / d );
+				for ( crimild::Size j = 0; j < 3; j++ ) {
+					EXPECT_NEAR( expected[ j ], as[ i ][ j ], 1e-5f ) << "index: " << i;
+				}
+				affected++;
+			}
+			else {
+				EXPECT_EQ( accelerations[ i ], as[ i ] ) << "index: " << i;
+			}
+		}
+		EXPECT_GT( affected, 0 );
+		EXPECT_LT( affected, ps.size() );
+
+		// all kernels must produce the exact same results
+		if ( reference.empty() ) {
+			reference = as;
+		}
+		test::expectParticleVectorsEq( reference, as, kernel );
+	}
+}
+
+TEST( ParticleKernelsTest, interpolate )
+{
+	std::mt19937 rng( 6 );
+	std::uniform_real_distribution< crimild::Real32 > value( 0.0f, 1.0f );
+
+	const auto COUNT = test::PARTICLE_KERNELS_COUNT;
+	std::vector< RGBAColorf > from( COUNT );
+	std::vector< RGBAColorf > to( COUNT );
+	std::vector< crimild::Real32 > times( COUNT );
+	std::vector< crimild::Real32 > lifetimes( COUNT );
+	for ( crimild::Size i = 0; i < COUNT; i++ ) {
+		from[ i ] = RGBAColorf( value( rng ), value( rng ), value( rng ), value( rng ) );
+		to[ i ] = RGBAColorf( value( rng ), value( rng ), value( rng ), value( rng ) );
+		lifetimes[ i ] = 1.0f + value( rng );
+		times[ i ] = lifetimes[ i ] * value( rng );
+	}
+
+	for ( auto kernel : test::getParticleKernels() ) {
+		std::vector< RGBAColorf > colors( COUNT );
+		ParticleKernels::interpolate( &from[ 0 ], &to[ 0 ], &times[ 0 ], &lifetimes[ 0 ], &colors[ 0 ], COUNT, kernel );
+
+		for ( crimild::Size i = 0; i < COUNT; i++ ) {
+			const auto t = 1.0f - ( times[ i ] / lifetimes[ i ] );
+			const auto expected = from[ i ] + t * ( to[ i ] - from[ i ] );
+			for ( crimild::Size j = 0; j < 4; j++ ) {
+				EXPECT_EQ( expected[ j ], colors[ i ][ j ] ) << "kernel: " << ParticleKernels::getKernelName( kernel ) << ", index: " << i;
+			}
+		}
+	}
+}
+
+TEST( ParticleKernelsTest, transform )
+{
+	const auto points = test::buildParticleVectors( 7, 10.0f );
+
+	Transformation t;
+	t.setTranslate( 1.0f, -2.0f, 3.0f );
+	t.rotate().fromAxisAngle( Vector3f( 1.0f, 1.0f, 0.0f ).getNormalized(), 0.7f );
+	t.setScale( 2.0f );
+	const auto m = t.computeModelMatrix();
+
+	std::vector< Vector3f > reference;
+	for ( auto kernel : test::getParticleKernels() ) {
+		auto ps = points;
+		ParticleKernels::transform( &ps[ 0 ], m, ps.size(), kernel );
+
+		for ( crimild::Size i = 0; i < ps.size(); i++ ) {
+			Vector3f expected;
+			t.applyToPoint( points[ i ], expected );
+			for ( crimild::Size j = 0; j < 3; j++ ) {
+				EXPECT_NEAR( expected[ j ], ps[ i ][ j ], 1e-4f ) << "index: " << i;
+			}
+		}
+
+		if ( reference.empty() ) {
+			reference = ps;
+		}
+		test::expectParticleVectorsEq( reference, ps, kernel );
+	}
+}
+
+TEST( ParticleKernelsTest, timeUpdaterKillsAllExpiredParticles )
+{
+	const crimild::Size COUNT = test::PARTICLE_KERNELS_COUNT;
+
+	ParticleData particles( COUNT );
+	TimeParticleUpdater updater;
+	updater.configure( nullptr, &particles );
+	particles.generate();
+
+	auto ts = particles.getAttrib( ParticleAttrib::TIME )->getData< crimild::Real32 >();
+	for ( crimild::Size i = 0; i < COUNT; i++ ) {
+		particles.wake( i );
+		// consecutive particles expiring together used to be skipped
+		ts[ i ] = ( i % 3 == 0 ) ? 2.0f : 0.5f;
+	}
+
+	updater.update( nullptr, 1.0, &particles );
+
+	const auto alive = particles.getAliveCount();
+	EXPECT_EQ( ( COUNT + 2 ) / 3, alive );
+	for ( crimild::Size i = 0; i < alive; i++ ) {
+		EXPECT_EQ( 1.0f, ts[ i ] ) << "index: " << i;
+	}
+}
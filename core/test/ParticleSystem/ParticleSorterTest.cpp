@@ -0,0 +1,154 @@
+/*
+ * Copyright (c) 2013, Hernan Saez
+ * All rights reserved.
+ * 
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *     * Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in the
+ *       documentation and/or other materials provided with the distribution.
+ *     * Neither the name of the <organization> nor the
+ *       names of its contributors may be used to endorse or promote products
+ *       derived from this software without specific prior written permission.
+ * 
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL <COPYRIGHT HOLDER> BE LIABLE FOR ANY
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "ParticleSystem/ParticleSorter.hpp"
+#include "ParticleSystem/Updaters/ZSortParticleUpdater.hpp"
+
+#include "gtest/gtest.h"
+
+#include <random>
+
+using namespace crimild;
+
+namespace crimild {
+
+	namespace test {
+
+		void buildSortedParticles( ParticleData &particles, crimild::Size count, crimild::UInt32 seed )
+		{
+			auto positions = particles.createAttribArray< Vector3f >( ParticleAttrib::POSITION );
+			auto times = particles.createAttribArray< crimild::Real32 >( ParticleAttrib::TIME );
+			particles.generate();
+
+			std::mt19937 rng( seed );
+			std::uniform_real_distribution< crimild::Real32 > value( -100.0f, 100.0f );
+
+			auto ps = positions->getData< Vector3f >();
+			auto ts = times->getData< crimild::Real32 >();
+			for ( crimild::Size i = 0; i < count; i++ ) {
+				particles.wake( i );
+				ps[ i ] = Vector3f( value( rng ), value( rng ), value( rng ) );
+				// keep track of each particle's position
+				ts[ i ] = ps[ i ].z();
+			}
+		}
+
+		void expectSortedParticles( ParticleData &particles, crimild::Bool ascending )
+		{
+			auto ps = particles.getAttrib( ParticleAttrib::POSITION )->getData< Vector3f >();
+			auto ts = particles.getAttrib( ParticleAttrib::TIME )->getData< crimild::Real32 >();
+			for ( crimild::Size i = 0; i < particles.getAliveCount(); i++ ) {
+				EXPECT_EQ( ps[ i ].z(), ts[ i ] ) << "index: " << i;
+				if ( i > 0 ) {
+					if ( ascending ) {
+						EXPECT_LE( ps[ i - 1 ].z(), ps[ i ].z() ) << "index: " << i;
+					}
+					else {
+						EXPECT_GE( ps[ i - 1 ].z(), ps[ i ].z() ) << "index: " << i;
+					}
+				}
+			}
+		}
+
+	}
+
+}
+
+TEST( ParticleSorterTest, zSort )
+{
+	const crimild::Size COUNT = 5000;
+
+	ParticleData particles( COUNT + 100 );
+	ZSortParticleUpdater updater;
+	updater.configure( nullptr, &particles );
+	test::buildSortedParticles( particles, COUNT, 1 );
+
+	updater.update( nullptr, 0.0, &particles );
+
+	EXPECT_EQ( COUNT, particles.getAliveCount() );
+	test::expectSortedParticles( particles, true );
+}
+
+TEST( ParticleSorterTest, descending )
+{
+	const crimild::Size COUNT = 5000;
+
+	ParticleData particles( COUNT );
+	test::buildSortedParticles( particles, COUNT, 2 );
+
+	auto ps = particles.getAttrib( ParticleAttrib::POSITION )->getData< Vector3f >();
+
+	ParticleSorter sorter;
+	sorter.sort( &particles, ParticleSorter::Order::DESCENDING, [ ps ]( ParticleId pid ) { return ps[ pid ].z(); } );
+
+	test::expectSortedParticles( particles, false );
+}
+
+TEST( ParticleSorterTest, coherence )
+{
+	const crimild::Size COUNT = 5000;
+
+	ParticleData particles( COUNT );
+	test::buildSortedParticles( particles, COUNT, 3 );
+
+	auto ps = particles.getAttrib( ParticleAttrib::POSITION )->getData< Vector3f >();
+	auto ts = particles.getAttrib( ParticleAttrib::TIME )->getData< crimild::Real32 >();
+	auto depth = [ ps ]( ParticleId pid ) { return ps[ pid ].z(); };
+
+	ParticleSorter sorter;
+	EXPECT_TRUE( sorter.isCoherenceEnabled() );
+
+	// random order requires too many moves
+	sorter.sort( &particles, ParticleSorter::Order::ASCENDING, depth );
+	EXPECT_FALSE( sorter.wasLastSortIncremental() );
+	test::expectSortedParticles( particles, true );
+
+	// swap a few neighbors, like particles moving a little bit
+	for ( crimild::Size i = 0; i + 1 < COUNT; i += 50 ) {
+		std::swap( ps[ i ], ps[ i + 1 ] );
+		std::swap( ts[ i ], ts[ i + 1 ] );
+	}
+
+	sorter.sort( &particles, ParticleSorter::Order::ASCENDING, depth );
+	EXPECT_TRUE( sorter.wasLastSortIncremental() );
+	test::expectSortedParticles( particles, true );
+
+	// reversed order
+	for ( crimild::Size i = 0; i < COUNT / 2; i++ ) {
+		std::swap( ps[ i ], ps[ COUNT - i - 1 ] );
+		std::swap( ts[ i ], ts[ COUNT - i - 1 ] );
+	}
+
+	sorter.sort( &particles, ParticleSorter::Order::ASCENDING, depth );
+	EXPECT_FALSE( sorter.wasLastSortIncremental() );
+	test::expectSortedParticles( particles, true );
+
+	sorter.setCoherenceEnabled( false );
+	sorter.sort( &particles, ParticleSorter::Order::ASCENDING, depth );
+	EXPECT_FALSE( sorter.wasLastSortIncremental() );
+	test::expectSortedParticles( particles, true );
+}
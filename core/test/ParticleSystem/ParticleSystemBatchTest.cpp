@@ -0,0 +1,312 @@
+/*
+ * Copyright (c) 2013, Hernan Saez
+ * All rights reserved.
+ * 
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *     * Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in the
+ *       documentation and/or other materials provided with the distribution.
+ *     * Neither the name of the <organization> nor the
+ *       names of its contributors may be used to endorse or promote products
+ *       derived from this software without specific prior written permission.
+ * 
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL <COPYRIGHT HOLDER> BE LIABLE FOR ANY
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "ParticleSystem/ParticleSystemBatch.hpp"
+#include "ParticleSystem/Updaters/EulerParticleUpdater.hpp"
+#include "ParticleSystem/Updaters/FloorParticleUpdater.hpp"
+#include "Concurrency/JobScheduler.hpp"
+#include "SceneGraph/Group.hpp"
+#include "Visitors/Apply.hpp"
+
+#include "gtest/gtest.h"
+
+#include <string>
+#include <vector>
+
+using namespace crimild;
+
+namespace crimild {
+
+	namespace test {
+
+		/**
+		   \brief Generates particles without using random numbers
+		 */
+		class LinearParticleGenerator : public ParticleSystemComponent::ParticleGenerator {
+			CRIMILD_IMPLEMENT_RTTI( crimild::test::LinearParticleGenerator )
+
+		public:
+			virtual void configure( Node *node, ParticleData *particles ) override
+			{
+				_positions = particles->createAttribArray< Vector3f >( ParticleAttrib::POSITION );
+				_velocities = particles->createAttribArray< Vector3f >( ParticleAttrib::VELOCITY );
+				_accelerations = particles->createAttribArray< Vector3f >( ParticleAttrib::ACCELERATION );
+			}
+
+			virtual void generate( Node *node, crimild::Real64 dt, ParticleData *particles, ParticleId startId, ParticleId endId ) override
+			{
+				auto ps = _positions->getData< Vector3f >();
+				auto vs = _velocities->getData< Vector3f >();
+				auto as = _accelerations->getData< Vector3f >();
+				for ( auto i = startId; i < endId; i++ ) {
+					ps[ i ] = Vector3f( 0.05f * _generated, 1.0f + ( _generated % 7 ), 0.0f );
+					vs[ i ] = Vector3f( 1.0f, 0.5f * ( _generated % 5 ), -1.0f );
+					as[ i ] = Vector3f::ZERO;
+					++_generated;
+				}
+			}
+
+		private:
+			crimild::Size _generated = 0;
+			ParticleAttribArray *_positions = nullptr;
+			ParticleAttribArray *_velocities = nullptr;
+			ParticleAttribArray *_accelerations = nullptr;
+		};
+
+		/**
+		   \brief Kills particles beyond a given distance
+
+		   Does not support range updates, since killing particles reorders them
+		 */
+		class KillParticleUpdater : public ParticleSystemComponent::ParticleUpdater {
+			CRIMILD_IMPLEMENT_RTTI( crimild::test::KillParticleUpdater )
+
+		public:
+			virtual void configure( Node *node, ParticleData *particles ) override
+			{
+				_positions = particles->createAttribArray< Vector3f >( ParticleAttrib::POSITION );
+			}
+
+			virtual void update( Node *node, crimild::Real64 dt, ParticleData *particles ) override
+			{
+				auto ps = _positions->getData< Vector3f >();
+				for ( auto i = particles->getAliveCount(); i > 0; i-- ) {
+					if ( ps[ i - 1 ].x() > 40.0f ) {
+						particles->kill( i - 1 );
+					}
+				}
+			}
+
+		private:
+			ParticleAttribArray *_positions = nullptr;
+		};
+
+		/**
+		   \brief Records which particle systems were rendered
+		 */
+		class RecordingParticleRenderer : public ParticleSystemComponent::ParticleRenderer {
+			CRIMILD_IMPLEMENT_RTTI( crimild::test::RecordingParticleRenderer )
+
+		public:
+			explicit RecordingParticleRenderer( std::vector< std::string > *log ) : _log( log ) { }
+
+			virtual void configure( Node *node, ParticleData *particles ) override { }
+
+			virtual void update( Node *node, crimild::Real64 dt, ParticleData *particles ) override
+			{
+				_log->push_back( node->getName() );
+			}
+
+		private:
+			std::vector< std::string > *_log;
+		};
+
+		SharedPointer< Group > buildParticleSystemBatchScene( std::vector< std::string > *log )
+		{
+			auto scene = crimild::alloc< Group >( "scene" );
+
+			const crimild::Size counts[] = { 1000, 50, 3000, 10 };
+			for ( crimild::Size i = 0; i < 4; i++ ) {
+				auto node = crimild::alloc< Group >( "emitter" + std::to_string( i ) );
+
+				auto ps = crimild::alloc< ParticleSystemComponent >( counts[ i ] );
+				ps->setEmitRate( 0.1f * counts[ i ] );
+				ps->setBurst( true );
+				ps->addGenerator( crimild::alloc< LinearParticleGenerator >() );
+
+				auto euler = crimild::alloc< EulerParticleUpdater >();
+				euler->setGlobalAcceleration( Vector3f( 0.0f, -9.8f, 0.0f ) );
+				ps->addUpdater( euler );
+				ps->addUpdater( crimild::alloc< KillParticleUpdater >() );
+				ps->addUpdater( crimild::alloc< FloorParticleUpdater >() );
+				ps->addRenderer( crimild::alloc< RecordingParticleRenderer >( log ) );
+
+				node->attachComponent( ps );
+				scene->attachNode( node );
+			}
+
+			scene->perform( Apply( []( Node *node ) {
+				node->startComponents();
+			}));
+
+			return scene;
+		}
+
+		std::vector< ParticleSystemComponent * > getParticleSystems( Node *scene )
+		{
+			std::vector< ParticleSystemComponent * > result;
+			scene->perform( Apply( [ &result ]( Node *node ) {
+				if ( auto ps = node->getComponent< ParticleSystemComponent >() ) {
+					result.push_back( ps );
+				}
+			}));
+			return result;
+		}
+
+		void updateParticleSystemBatchScene( Node *scene, ParticleSystemBatch &batch, const Clock &clock )
+		{
+			batch.collect( [ scene, &clock ] {
+				scene->perform( Apply( [ &clock ]( Node *node ) {
+					node->updateComponents( clock );
+				}));
+			});
+			batch.execute();
+		}
+
+		void expectSameParticles( Node *expected, Node *actual )
+		{
+			auto expectedSystems = getParticleSystems( expected );
+			auto actualSystems = getParticleSystems( actual );
+			ASSERT_EQ( expectedSystems.size(), actualSystems.size() );
+
+			for ( crimild::Size i = 0; i < expectedSystems.size(); i++ ) {
+				auto a = expectedSystems[ i ]->getParticles();
+				auto b = actualSystems[ i ]->getParticles();
+				ASSERT_EQ( a->getAliveCount(), b->getAliveCount() );
+
+				auto pa = a->getAttrib( ParticleAttrib::POSITION )->getData< Vector3f >();
+				auto pb = b->getAttrib( ParticleAttrib::POSITION )->getData< Vector3f >();
+				for ( crimild::Size j = 0; j < a->getAliveCount(); j++ ) {
+					for ( crimild::Size k = 0; k < 3; k++ ) {
+						EXPECT_EQ( pa[ j ][ k ], pb[ j ][ k ] ) << "system: " << i << ", particle: " << j;
+					}
+				}
+			}
+		}
+
+	}
+
+}
+
+TEST( ParticleSystemBatchTest, collectDefersUpdates )
+{
+	std::vector< std::string > log;
+	auto scene = test::buildParticleSystemBatchScene( &log );
+
+	ParticleSystemBatch batch;
+	EXPECT_EQ( nullptr, ParticleSystemBatch::getCurrent() );
+
+	Clock clock( 1.0 / 60.0 );
+	batch.collect( [ &scene, &clock, &batch ] {
+		EXPECT_EQ( &batch, ParticleSystemBatch::getCurrent() );
+		scene->perform( Apply( [ &clock ]( Node *node ) {
+			node->updateComponents( clock );
+		}));
+	});
+
+	EXPECT_EQ( nullptr, ParticleSystemBatch::getCurrent() );
+	EXPECT_EQ( 4, batch.getComponentCount() );
+	EXPECT_TRUE( log.empty() );
+	for ( auto ps : test::getParticleSystems( crimild::get_ptr( scene ) ) ) {
+		EXPECT_EQ( 0, ps->getParticles()->getAliveCount() );
+	}
+
+	batch.execute();
+
+	EXPECT_EQ( 0, batch.getComponentCount() );
+	for ( auto ps : test::getParticleSystems( crimild::get_ptr( scene ) ) ) {
+		EXPECT_LT( 0, ps->getParticles()->getAliveCount() );
+	}
+
+	// renderers are invoked in scene order
+	std::vector< std::string > expectedLog = { "emitter0", "emitter1", "emitter2", "emitter3" };
+	EXPECT_EQ( expectedLog, log );
+}
+
+TEST( ParticleSystemBatchTest, matchesSequentialUpdates )
+{
+	std::vector< std::string > expectedLog;
+	auto expected = test::buildParticleSystemBatchScene( &expectedLog );
+
+	std::vector< std::string > serialLog;
+	auto serial = test::buildParticleSystemBatchScene( &serialLog );
+	ParticleSystemBatch serialBatch;
+
+	std::vector< std::string > parallelLog;
+	auto parallel = test::buildParticleSystemBatchScene( &parallelLog );
+	ParticleSystemBatch parallelBatch;
+	// split big emitters into several jobs
+	parallelBatch.setRangeSize( 64 );
+
+	const crimild::Size FRAME_COUNT = 120;
+	Clock clock( 1.0 / 60.0 );
+
+	for ( crimild::Size frame = 0; frame < FRAME_COUNT; frame++ ) {
+		expected->perform( Apply( [ &clock ]( Node *node ) {
+			node->updateComponents( clock );
+		}));
+	}
+
+	// without workers, batched components are updated sequentially
+	for ( crimild::Size frame = 0; frame < FRAME_COUNT; frame++ ) {
+		test::updateParticleSystemBatchScene( crimild::get_ptr( serial ), serialBatch, clock );
+	}
+
+	concurrency::JobScheduler scheduler;
+	scheduler.configure( 3 );
+	scheduler.start();
+
+	for ( crimild::Size frame = 0; frame < FRAME_COUNT; frame++ ) {
+		test::updateParticleSystemBatchScene( crimild::get_ptr( parallel ), parallelBatch, clock );
+	}
+
+	scheduler.stop();
+
+	test::expectSameParticles( crimild::get_ptr( expected ), crimild::get_ptr( serial ) );
+	test::expectSameParticles( crimild::get_ptr( expected ), crimild::get_ptr( parallel ) );
+	EXPECT_EQ( expectedLog, serialLog );
+	EXPECT_EQ( expectedLog, parallelLog );
+}
+
+TEST( ParticleSystemBatchTest, rangeUpdates )
+{
+	auto euler = crimild::alloc< EulerParticleUpdater >();
+	euler->setGlobalAcceleration( Vector3f( 0.0f, -9.8f, 0.0f ) );
+
+	EXPECT_TRUE( euler->isRangeUpdateSupported() );
+	EXPECT_TRUE( crimild::alloc< FloorParticleUpdater >()->isRangeUpdateSupported() );
+	EXPECT_FALSE( crimild::alloc< test::KillParticleUpdater >()->isRangeUpdateSupported() );
+
+	ParticleData particles( 100 );
+	euler->configure( nullptr, &particles );
+	particles.generate();
+	for ( ParticleId i = 0; i < 100; i++ ) {
+		particles.wake( i );
+		particles.getAttrib( ParticleAttrib::POSITION )->getData< Vector3f >()[ i ] = Vector3f::ZERO;
+		particles.getAttrib( ParticleAttrib::VELOCITY )->getData< Vector3f >()[ i ] = Vector3f::ZERO;
+		particles.getAttrib( ParticleAttrib::ACCELERATION )->getData< Vector3f >()[ i ] = Vector3f::ZERO;
+	}
+
+	euler->updateRange( nullptr, 1.0, &particles, 10, 20 );
+
+	auto ps = particles.getAttrib( ParticleAttrib::POSITION )->getData< Vector3f >();
+	for ( ParticleId i = 0; i < 100; i++ ) {
+		auto expectedY = ( i >= 10 && i < 20 ) ? -9.8f : 0.0f;
+		EXPECT_EQ( expectedY, ps[ i ][ 1 ] ) << "index: " << i;
+	}
+}
+
@@ -0,0 +1,193 @@
+/*
+ * Copyright (c) 2013, Hernan Saez
+ * All rights reserved.
+ * 
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *     * Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in the
+ *       documentation and/or other materials provided with the distribution.
+ *     * Neither the name of the <organization> nor the
+ *       names of its contributors may be used to endorse or promote products
+ *       derived from this software without specific prior written permission.
+ * 
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL <COPYRIGHT HOLDER> BE LIABLE FOR ANY
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "Rendering/RenderQueue.hpp"
+#include "Rendering/AlphaState.hpp"
+#include "Components/RenderStateComponent.hpp"
+#include "SceneGraph/Group.hpp"
+#include "Visitors/UpdateWorldState.hpp"
+
+#include "gtest/gtest.h"
+
+#include <vector>
+
+using namespace crimild;
+
+namespace crimild {
+
+	namespace test {
+
+		SharedPointer< Geometry > createRenderQueueGeometry( float z, SharedPointer< Material > const &material )
+		{
+			auto geometry = crimild::alloc< Geometry >();
+			geometry->local().setTranslate( 0.0f, 0.0f, z );
+			geometry->attachComponent< RenderStateComponent >()->attachMaterial( material );
+			geometry->perform( UpdateWorldState() );
+			return geometry;
+		}
+
+		std::vector< Geometry * > collectRenderables( RenderQueue &renderQueue, RenderQueue::RenderableType type )
+		{
+			std::vector< Geometry * > result;
+			renderQueue.each( renderQueue.getRenderables( type ), [ &result ]( RenderQueue::Renderable *renderable ) {
+				result.push_back( crimild::get_ptr( renderable->geometry ) );
+			});
+			return result;
+		}
+
+	}
+
+}
+
+TEST( RenderQueueTest, opaqueObjectsSortedByState )
+{
+	auto camera = crimild::alloc< Camera >();
+
+	std::vector< SharedPointer< Material >> materials;
+	for ( int i = 0; i < 2; i++ ) {
+		auto material = crimild::alloc< Material >();
+		material->setProgram( crimild::alloc< ShaderProgram >() );
+		materials.push_back( material );
+	}
+
+	// interleave materials so depth ordering alone would switch programs every time
+	std::vector< SharedPointer< Geometry >> geometries;
+	for ( int i = 0; i < 10; i++ ) {
+		geometries.push_back( test::createRenderQueueGeometry( -1.0f - i, materials[ i % 2 ] ) );
+	}
+
+	RenderQueue renderQueue;
+	renderQueue.setCamera( crimild::get_ptr( camera ) );
+	for ( auto &g : geometries ) {
+		renderQueue.push( crimild::get_ptr( g ) );
+	}
+
+	EXPECT_EQ( 10, renderQueue.getRenderables( RenderQueue::RenderableType::OPAQUE )->size() );
+
+	crimild::Size programChanges = 0;
+	ShaderProgram *program = nullptr;
+	double distance = 0.0;
+	renderQueue.each( renderQueue.getRenderables( RenderQueue::RenderableType::OPAQUE ), [ & ]( RenderQueue::Renderable *renderable ) {
+		if ( renderable->material->getProgram() != program ) {
+			program = renderable->material->getProgram();
+			distance = 0.0;
+			++programChanges;
+		}
+
+		// front-to-back for the same program
+		EXPECT_LT( distance, renderable->distanceFromCamera );
+		distance = renderable->distanceFromCamera;
+	});
+	EXPECT_EQ( 2, programChanges );
+}
+
+TEST( RenderQueueTest, translucentObjectsBackToFront )
+{
+	auto camera = crimild::alloc< Camera >();
+
+	auto material = crimild::alloc< Material >();
+	material->setAlphaState( AlphaState::ENABLED );
+
+	std::vector< SharedPointer< Geometry >> geometries = {
+		test::createRenderQueueGeometry( -5.0f, material ),
+		test::createRenderQueueGeometry( -20.0f, material ),
+		test::createRenderQueueGeometry( -1.0f, material ),
+		test::createRenderQueueGeometry( -10.0f, material ),
+	};
+
+	RenderQueue renderQueue;
+	renderQueue.setCamera( crimild::get_ptr( camera ) );
+	for ( auto &g : geometries ) {
+		renderQueue.push( crimild::get_ptr( g ) );
+	}
+
+	EXPECT_TRUE( renderQueue.getRenderables( RenderQueue::RenderableType::OPAQUE )->empty() );
+
+	auto translucent = test::collectRenderables( renderQueue, RenderQueue::RenderableType::TRANSLUCENT );
+	ASSERT_EQ( 4, translucent.size() );
+	EXPECT_EQ( crimild::get_ptr( geometries[ 1 ] ), translucent[ 0 ] );
+	EXPECT_EQ( crimild::get_ptr( geometries[ 3 ] ), translucent[ 1 ] );
+	EXPECT_EQ( crimild::get_ptr( geometries[ 0 ] ), translucent[ 2 ] );
+	EXPECT_EQ( crimild::get_ptr( geometries[ 2 ] ), translucent[ 3 ] );
+}
+
+TEST( RenderQueueTest, shadowCastersFrontToBack )
+{
+	auto camera = crimild::alloc< Camera >();
+
+	auto caster = crimild::alloc< Material >();
+	caster->setCastShadows( true );
+
+	auto other = crimild::alloc< Material >();
+	other->setCastShadows( false );
+
+	std::vector< SharedPointer< Geometry >> geometries = {
+		test::createRenderQueueGeometry( -5.0f, caster ),
+		test::createRenderQueueGeometry( -2.0f, other ),
+		test::createRenderQueueGeometry( -1.0f, caster ),
+	};
+
+	RenderQueue renderQueue;
+	renderQueue.setCamera( crimild::get_ptr( camera ) );
+	for ( auto &g : geometries ) {
+		renderQueue.push( crimild::get_ptr( g ) );
+	}
+
+	EXPECT_EQ( 3, renderQueue.getRenderables( RenderQueue::RenderableType::OPAQUE )->size() );
+
+	auto casters = test::collectRenderables( renderQueue, RenderQueue::RenderableType::SHADOW_CASTER );
+	ASSERT_EQ( 2, casters.size() );
+	EXPECT_EQ( crimild::get_ptr( geometries[ 2 ] ), casters[ 0 ] );
+	EXPECT_EQ( crimild::get_ptr( geometries[ 0 ] ), casters[ 1 ] );
+}
+
+TEST( RenderQueueTest, reset )
+{
+	auto camera = crimild::alloc< Camera >();
+	auto material = crimild::alloc< Material >();
+	auto geometry = test::createRenderQueueGeometry( -1.0f, material );
+	auto light = crimild::alloc< Light >();
+
+	RenderQueue renderQueue;
+	for ( int frame = 0; frame < 2; frame++ ) {
+		renderQueue.reset();
+		renderQueue.setCamera( crimild::get_ptr( camera ) );
+		renderQueue.push( crimild::get_ptr( geometry ) );
+		renderQueue.push( crimild::get_ptr( light ) );
+
+		EXPECT_EQ( 1, renderQueue.getRenderables( RenderQueue::RenderableType::OPAQUE )->size() );
+
+		crimild::Size lightCount = 0;
+		renderQueue.each( [ &lightCount ]( Light *, int ) { ++lightCount; } );
+		EXPECT_EQ( 1, lightCount );
+	}
+
+	renderQueue.reset();
+	EXPECT_EQ( nullptr, renderQueue.getCamera() );
+	EXPECT_TRUE( renderQueue.getRenderables( RenderQueue::RenderableType::OPAQUE )->empty() );
+	EXPECT_TRUE( renderQueue.getRenderables( RenderQueue::RenderableType::SHADOW_CASTER )->empty() );
+}
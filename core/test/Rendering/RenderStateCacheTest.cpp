@@ -0,0 +1,431 @@
+/*
+ * Copyright (c) 2013, Hernan Saez
+ * All rights reserved.
+ * 
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *     * Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in the
+ *       documentation and/or other materials provided with the distribution.
+ *     * Neither the name of the <organization> nor the
+ *       names of its contributors may be used to endorse or promote products
+ *       derived from this software without specific prior written permission.
+ * 
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL <COPYRIGHT HOLDER> BE LIABLE FOR ANY
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "Rendering/RenderStateCache.hpp"
+#include "Rendering/Renderer.hpp"
+#include "Rendering/Catalog.hpp"
+#include "Rendering/Material.hpp"
+#include "Rendering/ShaderProgram.hpp"
+#include "Simulation/AssetManager.hpp"
+
+#include "gtest/gtest.h"
+
+using namespace crimild;
+
+namespace crimild {
+
+    namespace test {
+
+        /**
+            \brief Mimics a backend by forwarding state changes to a fake 
+            driver only when the state cache says so
+         */
+        class MockRenderer : public Renderer {
+        public:
+            class MockShaderProgramCatalog : public Catalog< ShaderProgram > {
+            public:
+                explicit MockShaderProgramCatalog( MockRenderer *renderer ) : _renderer( renderer ) { }
+                virtual ~MockShaderProgramCatalog( void ) { }
+
+                // zero is reserved for "no program", like in OpenGL
+                virtual int getNextResourceId( void ) override { return Catalog< ShaderProgram >::getNextResourceId() + 1; }
+
+                virtual void bind( ShaderProgram *program ) override
+                {
+                    Catalog< ShaderProgram >::bind( program );
+                    if ( _renderer->getStateCache()->bindProgram( program->getCatalogId() ) ) {
+                        ++_renderer->driverCalls;
+                    }
+                }
+
+                virtual void unbind( ShaderProgram *program ) override
+                {
+                    Catalog< ShaderProgram >::unbind( program );
+                    if ( _renderer->getStateCache()->bindProgram( 0 ) ) {
+                        ++_renderer->driverCalls;
+                    }
+                }
+
+            private:
+                MockRenderer *_renderer;
+            };
+
+        public:
+            MockRenderer( void )
+            {
+                setShaderProgramCatalog( crimild::alloc< MockShaderProgramCatalog >( this ) );
+            }
+
+            virtual ~MockRenderer( void ) { }
+
+            virtual void configure( void ) override { }
+            virtual void clearBuffers( void ) override { }
+
+            virtual void bindUniform( ShaderLocation *location, int value ) override { uniform( location, &value, sizeof( int ) ); }
+            virtual void bindUniform( ShaderLocation *location, float value ) override { uniform( location, &value, sizeof( float ) ); }
+            virtual void bindUniform( ShaderLocation *location, const Vector3f &vector ) override { uniform( location, vector.getData(), 3 * sizeof( float ) ); }
+            virtual void bindUniform( ShaderLocation *location, const Vector2f &vector ) override { uniform( location, vector.getData(), 2 * sizeof( float ) ); }
+            virtual void bindUniform( ShaderLocation *location, const RGBAColorf &color ) override { uniform( location, color.getData(), 4 * sizeof( float ) ); }
+            virtual void bindUniform( ShaderLocation *location, const Matrix4f &matrix ) override { uniform( location, matrix.getData(), 16 * sizeof( float ) ); }
+
+            virtual void setDepthState( DepthState *state ) override
+            {
+                call( getStateCache()->setDepthTestEnabled( state->isEnabled() ) );
+                call( getStateCache()->setDepthFunc( ( UInt32 ) state->getCompareFunc() ) );
+                call( getStateCache()->setDepthMask( state->isWritable() ) );
+            }
+
+            virtual void setAlphaState( AlphaState *state ) override
+            {
+                call( getStateCache()->setBlendEnabled( state->isEnabled() ) );
+                if ( state->isEnabled() ) {
+                    call( getStateCache()->setBlendFunc( ( UInt32 ) state->getSrcBlendFunc(), ( UInt32 ) state->getDstBlendFunc() ) );
+                }
+            }
+
+            virtual void setCullFaceState( CullFaceState *state ) override
+            {
+                call( getStateCache()->setCullFaceEnabled( state->isEnabled() ) );
+                if ( state->isEnabled() ) {
+                    call( getStateCache()->setCullFaceMode( ( UInt32 ) state->getCullFaceMode() ) );
+                }
+            }
+
+            virtual void setColorMaskState( ColorMaskState *state ) override
+            {
+                call( getStateCache()->setColorMask( state->getRMask(), state->getGMask(), state->getBMask(), state->getAMask() ) );
+            }
+
+            virtual void drawPrimitive( ShaderProgram *program, Primitive *primitive ) override
+            {
+                ++driverCalls;
+            }
+
+        public:
+            crimild::Size driverCalls = 0;
+
+        private:
+            void call( bool issued )
+            {
+                if ( issued ) {
+                    ++driverCalls;
+                }
+            }
+
+            void uniform( ShaderLocation *location, const void *data, crimild::Size size )
+            {
+                if ( location != nullptr && location->isValid() ) {
+                    call( getStateCache()->setUniform( location->getLocation(), data, size ) );
+                }
+            }
+        };
+
+        SharedPointer< ShaderProgram > createMockProgram( void )
+        {
+            auto program = crimild::alloc< ShaderProgram >();
+
+            int location = 0;
+            for ( auto id : {
+                ShaderProgram::StandardLocation::PROJECTION_MATRIX_UNIFORM,
+                ShaderProgram::StandardLocation::VIEW_MATRIX_UNIFORM,
+                ShaderProgram::StandardLocation::MODEL_MATRIX_UNIFORM,
+                ShaderProgram::StandardLocation::MATERIAL_DIFFUSE_UNIFORM,
+                ShaderProgram::StandardLocation::MATERIAL_SHININESS_UNIFORM,
+            } ) {
+                auto name = "uniform" + std::to_string( location );
+                program->registerStandardLocation( ShaderLocation::Type::UNIFORM, id, name )->setLocation( location++ );
+            }
+
+            return program;
+        }
+
+    }
+
+}
+
+TEST( RenderStateCacheTest, bindProgram )
+{
+    RenderStateCache cache;
+
+    EXPECT_EQ( RenderStateCache::UNKNOWN, cache.getBoundProgram() );
+
+    EXPECT_TRUE( cache.bindProgram( 1 ) );
+    EXPECT_FALSE( cache.bindProgram( 1 ) );
+    EXPECT_TRUE( cache.bindProgram( 2 ) );
+    EXPECT_EQ( 2, cache.getBoundProgram() );
+
+    EXPECT_EQ( 2, cache.getIssuedCount( RenderStateCache::CallType::PROGRAM ) );
+    EXPECT_EQ( 1, cache.getFilteredCount( RenderStateCache::CallType::PROGRAM ) );
+
+    cache.invalidate();
+    EXPECT_TRUE( cache.bindProgram( 2 ) );
+
+    cache.invalidateProgram( 2 );
+    EXPECT_TRUE( cache.bindProgram( 2 ) );
+
+    cache.resetCounters();
+    EXPECT_EQ( 0, cache.getIssuedCount() );
+    EXPECT_EQ( 0, cache.getFilteredCount() );
+}
+
+TEST( RenderStateCacheTest, uniformsArePerProgram )
+{
+    RenderStateCache cache;
+
+    Matrix4f m;
+    m.makeIdentity();
+
+    EXPECT_TRUE( cache.setUniform( 0, 1.0f ) ) << "Program is unknown";
+    EXPECT_TRUE( cache.setUniform( 0, 1.0f ) ) << "Program is unknown";
+
+    cache.bindProgram( 1 );
+    EXPECT_TRUE( cache.setUniform( 0, 1.0f ) );
+    EXPECT_FALSE( cache.setUniform( 0, 1.0f ) );
+    EXPECT_TRUE( cache.setUniform( 0, 2.0f ) );
+    EXPECT_TRUE( cache.setUniform( 3, m ) );
+    EXPECT_FALSE( cache.setUniform( 3, m ) );
+
+    cache.bindProgram( 2 );
+    EXPECT_TRUE( cache.setUniform( 0, 2.0f ) );
+    EXPECT_FALSE( cache.setUniform( 0, 2.0f ) );
+
+    // values survive program switches and invalidation
+    cache.bindProgram( 1 );
+    EXPECT_FALSE( cache.setUniform( 0, 2.0f ) );
+    cache.invalidate();
+    cache.bindProgram( 1 );
+    EXPECT_FALSE( cache.setUniform( 3, m ) );
+
+    // relinking a program resets its uniforms
+    cache.invalidateProgram( 1 );
+    cache.bindProgram( 1 );
+    EXPECT_TRUE( cache.setUniform( 0, 2.0f ) );
+    EXPECT_TRUE( cache.setUniform( 3, m ) );
+
+    EXPECT_TRUE( cache.setUniform( RenderStateCache::MAX_CACHED_UNIFORM_LOCATION + 1, 1 ) );
+    EXPECT_TRUE( cache.setUniform( RenderStateCache::MAX_CACHED_UNIFORM_LOCATION + 1, 1 ) );
+}
+
+TEST( RenderStateCacheTest, textureUnits )
+{
+    RenderStateCache cache;
+
+    EXPECT_TRUE( cache.bindTexture( 5 ) ) << "Active unit is unknown";
+
+    EXPECT_TRUE( cache.setActiveTextureUnit( 0 ) );
+    EXPECT_TRUE( cache.bindTexture( 5 ) );
+    EXPECT_FALSE( cache.bindTexture( 5 ) );
+
+    EXPECT_TRUE( cache.setActiveTextureUnit( 1 ) );
+    EXPECT_FALSE( cache.setActiveTextureUnit( 1 ) );
+    EXPECT_TRUE( cache.bindTexture( 5 ) );
+    EXPECT_TRUE( cache.bindTexture( 7 ) );
+
+    EXPECT_EQ( 5, cache.getBoundTexture( 0 ) );
+    EXPECT_EQ( 7, cache.getBoundTexture( 1 ) );
+    EXPECT_EQ( RenderStateCache::UNKNOWN, cache.getBoundTexture( 2 ) );
+
+    // deleted textures are unbound from every unit
+    cache.invalidateTexture( 5 );
+    EXPECT_EQ( 0, cache.getBoundTexture( 0 ) );
+    EXPECT_EQ( 7, cache.getBoundTexture( 1 ) );
+}
+
+TEST( RenderStateCacheTest, buffers )
+{
+    RenderStateCache cache;
+
+    EXPECT_TRUE( cache.bindVertexArray( 1 ) );
+    EXPECT_TRUE( cache.bindVertexBuffer( 2 ) );
+    EXPECT_TRUE( cache.bindIndexBuffer( 3 ) );
+
+    EXPECT_FALSE( cache.bindVertexArray( 1 ) );
+    EXPECT_FALSE( cache.bindVertexBuffer( 2 ) );
+    EXPECT_FALSE( cache.bindIndexBuffer( 3 ) );
+
+    // index buffer bindings are part of the vertex array state
+    EXPECT_TRUE( cache.bindVertexArray( 4 ) );
+    EXPECT_TRUE( cache.bindIndexBuffer( 3 ) );
+
+    cache.invalidateBuffer( 3 );
+    EXPECT_EQ( 0, cache.getBoundIndexBuffer() );
+    EXPECT_EQ( 2, cache.getBoundVertexBuffer() );
+
+    cache.invalidateVertexArray( 4 );
+    EXPECT_EQ( 0, cache.getBoundVertexArray() );
+}
+
+TEST( RenderStateCacheTest, redundantBinds )
+{
+    RenderStateCache cache;
+
+    EXPECT_TRUE( cache.bindProgram( 1 ) );
+    EXPECT_FALSE( cache.bindProgram( 1 ) );
+    EXPECT_EQ( 1, cache.getIssuedCount( RenderStateCache::CallType::PROGRAM ) );
+    EXPECT_EQ( 1, cache.getFilteredCount( RenderStateCache::CallType::PROGRAM ) );
+
+    // unbinding is a real state change, so the next bind must be issued again
+    EXPECT_TRUE( cache.bindProgram( 0 ) );
+    EXPECT_FALSE( cache.bindProgram( 0 ) );
+    EXPECT_TRUE( cache.bindProgram( 1 ) );
+
+    EXPECT_TRUE( cache.setActiveTextureUnit( 0 ) );
+    EXPECT_TRUE( cache.bindTexture( 3 ) );
+    EXPECT_FALSE( cache.bindTexture( 3 ) );
+    EXPECT_TRUE( cache.bindTexture( 0 ) );
+    EXPECT_TRUE( cache.bindTexture( 3 ) );
+
+    EXPECT_TRUE( cache.bindVertexBuffer( 2 ) );
+    EXPECT_FALSE( cache.bindVertexBuffer( 2 ) );
+    EXPECT_TRUE( cache.bindVertexBuffer( 0 ) );
+    EXPECT_TRUE( cache.bindVertexBuffer( 2 ) );
+}
+
+TEST( RenderStateCacheTest, vertexArrayInvalidatesIndexBuffer )
+{
+    RenderStateCache cache;
+
+    EXPECT_TRUE( cache.bindVertexArray( 1 ) );
+    EXPECT_TRUE( cache.bindIndexBuffer( 5 ) );
+    EXPECT_FALSE( cache.bindIndexBuffer( 5 ) );
+
+    // a different vertex array carries its own index buffer binding
+    EXPECT_TRUE( cache.bindVertexArray( 2 ) );
+    EXPECT_TRUE( cache.bindIndexBuffer( 5 ) );
+
+    // same for unbinding the vertex array
+    EXPECT_TRUE( cache.bindVertexArray( 0 ) );
+    EXPECT_TRUE( cache.bindIndexBuffer( 0 ) );
+    EXPECT_FALSE( cache.bindIndexBuffer( 0 ) );
+
+    // rebinding the same vertex array is filtered and keeps the index buffer
+    EXPECT_FALSE( cache.bindVertexArray( 0 ) );
+    EXPECT_FALSE( cache.bindIndexBuffer( 0 ) );
+
+    EXPECT_EQ( 3, cache.getIssuedCount( RenderStateCache::CallType::INDEX_BUFFER ) );
+    EXPECT_EQ( 3, cache.getFilteredCount( RenderStateCache::CallType::INDEX_BUFFER ) );
+}
+
+TEST( RenderStateCacheTest, renderStates )
+{
+    RenderStateCache cache;
+
+    EXPECT_TRUE( cache.setBlendEnabled( true ) );
+    EXPECT_FALSE( cache.setBlendEnabled( true ) );
+    EXPECT_TRUE( cache.setBlendFunc( 1, 2 ) );
+    EXPECT_FALSE( cache.setBlendFunc( 1, 2 ) );
+    EXPECT_TRUE( cache.setBlendFunc( 1, 3 ) );
+
+    EXPECT_TRUE( cache.setDepthTestEnabled( false ) );
+    EXPECT_FALSE( cache.setDepthTestEnabled( false ) );
+    EXPECT_TRUE( cache.setDepthFunc( 1 ) );
+    EXPECT_FALSE( cache.setDepthFunc( 1 ) );
+    EXPECT_TRUE( cache.setDepthMask( false ) );
+    EXPECT_FALSE( cache.setDepthMask( false ) );
+
+    EXPECT_TRUE( cache.setCullFaceEnabled( true ) );
+    EXPECT_FALSE( cache.setCullFaceEnabled( true ) );
+    EXPECT_TRUE( cache.setCullFaceMode( 1 ) );
+    EXPECT_FALSE( cache.setCullFaceMode( 1 ) );
+
+    EXPECT_TRUE( cache.setColorMask( true, true, true, true ) );
+    EXPECT_FALSE( cache.setColorMask( true, true, true, true ) );
+    EXPECT_TRUE( cache.setColorMask( true, true, true, false ) );
+
+    EXPECT_EQ( 10, cache.getIssuedCount() );
+    EXPECT_EQ( 8, cache.getFilteredCount() );
+
+    cache.invalidate();
+    EXPECT_TRUE( cache.setBlendEnabled( true ) );
+    EXPECT_TRUE( cache.setDepthTestEnabled( false ) );
+    EXPECT_TRUE( cache.setCullFaceEnabled( true ) );
+    EXPECT_TRUE( cache.setColorMask( true, true, true, false ) );
+}
+
+TEST( RenderStateCacheTest, mockRenderer )
+{
+    AssetManager assets;
+    test::MockRenderer renderer;
+
+    auto program = test::createMockProgram();
+    auto material = crimild::alloc< Material >();
+
+    Matrix4f projection, view, model;
+    projection.makeIdentity();
+    view.makeIdentity();
+
+    const crimild::Size OBJECT_COUNT = 10;
+
+    auto renderFrame = [&]() {
+        renderer.beginRender();
+
+        // render several objects sharing the same program and material,
+        // like a render pass would do without any batching
+        for ( crimild::Size i = 0; i < OBJECT_COUNT; i++ ) {
+            model.makeIdentity();
+            model[ 12 ] = i;
+
+            renderer.bindProgram( crimild::get_ptr( program ) );
+            renderer.bindMaterial( crimild::get_ptr( program ), crimild::get_ptr( material ) );
+            renderer.applyTransformations( crimild::get_ptr( program ), projection, view, model );
+            renderer.drawPrimitive( crimild::get_ptr( program ), nullptr );
+            renderer.unbindMaterial( crimild::get_ptr( program ), crimild::get_ptr( material ) );
+            renderer.unbindProgram( crimild::get_ptr( program ) );
+        }
+
+        renderer.endRender();
+    };
+
+    renderFrame();
+
+    auto stateCache = renderer.getStateCache();
+
+    // the program is bound and unbound for each object, but render states,
+    // material uniforms and projection/view matrices are issued once since
+    // uniform values are kept per program. Model matrices change for each object
+    EXPECT_EQ( 2 * OBJECT_COUNT, stateCache->getIssuedCount( RenderStateCache::CallType::PROGRAM ) );
+    EXPECT_EQ( 0, stateCache->getFilteredCount( RenderStateCache::CallType::PROGRAM ) );
+    EXPECT_EQ( 3, stateCache->getIssuedCount( RenderStateCache::CallType::DEPTH ) );
+    EXPECT_EQ( 1, stateCache->getIssuedCount( RenderStateCache::CallType::BLEND ) );
+    EXPECT_EQ( 2, stateCache->getIssuedCount( RenderStateCache::CallType::CULL_FACE ) );
+    EXPECT_EQ( 1, stateCache->getIssuedCount( RenderStateCache::CallType::COLOR_MASK ) );
+    EXPECT_EQ( 4 + OBJECT_COUNT, stateCache->getIssuedCount( RenderStateCache::CallType::UNIFORM ) );
+    EXPECT_EQ( 4 * ( OBJECT_COUNT - 1 ), stateCache->getFilteredCount( RenderStateCache::CallType::UNIFORM ) );
+
+    // every issued call reaches the driver, plus draw calls
+    EXPECT_EQ( stateCache->getIssuedCount() + OBJECT_COUNT, renderer.driverCalls );
+
+    // on the next frame, render states are issued again but uniform 
+    // values are still known
+    renderer.driverCalls = 0;
+    renderFrame();
+
+    EXPECT_EQ( 2 * OBJECT_COUNT, stateCache->getIssuedCount( RenderStateCache::CallType::PROGRAM ) );
+    EXPECT_EQ( OBJECT_COUNT, stateCache->getIssuedCount( RenderStateCache::CallType::UNIFORM ) );
+    EXPECT_EQ( stateCache->getIssuedCount() + OBJECT_COUNT, renderer.driverCalls );
+}
+
@@ -213,6 +213,55 @@ TEST( SkinnedMeshAnimationChannel, coding )
 	EXPECT_EQ( 3, decodedChannel->getScaleKeys()[ 2 ].value );
 }
 
+TEST( SkinnedMeshAnimationChannel, computeWithCursor )
+{
+	auto channel = crimild::alloc< SkinnedMeshAnimationChannel >();
+
+	channel->getPositionKeys().resize( 3 );
+	channel->getPositionKeys()[ 0 ].time = 0;
+	channel->getPositionKeys()[ 0 ].value = Vector3f( 0.0f, 0.0f, 0.0f );
+	channel->getPositionKeys()[ 1 ].time = 5;
+	channel->getPositionKeys()[ 1 ].value = Vector3f( 5.0f, 0.0f, 0.0f );
+	channel->getPositionKeys()[ 2 ].time = 10;
+	channel->getPositionKeys()[ 2 ].value = Vector3f( 5.0f, 5.0f, 0.0f );
+
+	channel->getScaleKeys().resize( 3 );
+	channel->getScaleKeys()[ 0 ].time = 0;
+	channel->getScaleKeys()[ 0 ].value = 1;
+	channel->getScaleKeys()[ 1 ].time = 5;
+	channel->getScaleKeys()[ 1 ].value = 2;
+	channel->getScaleKeys()[ 2 ].time = 10;
+	channel->getScaleKeys()[ 2 ].value = 3;
+
+	SkinnedMeshAnimationChannel::Cursor cursor;
+	Vector3f position;
+	float scale;
+
+	EXPECT_TRUE( channel->computePosition( 2.5f, position, cursor.position ) );
+	EXPECT_EQ( Vector3f( 2.5f, 0.0f, 0.0f ), position );
+	EXPECT_EQ( 0, cursor.position );
+
+	EXPECT_TRUE( channel->computePosition( 7.5f, position, cursor.position ) );
+	EXPECT_EQ( Vector3f( 5.0f, 2.5f, 0.0f ), position );
+	EXPECT_EQ( 1, cursor.position );
+
+	// jumping back in time works too
+	EXPECT_TRUE( channel->computePosition( 1.0f, position, cursor.position ) );
+	EXPECT_EQ( Vector3f( 1.0f, 0.0f, 0.0f ), position );
+	EXPECT_EQ( 0, cursor.position );
+
+	// times outside the channel are clamped
+	EXPECT_TRUE( channel->computePosition( 20.0f, position, cursor.position ) );
+	EXPECT_EQ( Vector3f( 5.0f, 5.0f, 0.0f ), position );
+
+	EXPECT_TRUE( channel->computeScale( 7.5f, scale, cursor.scale ) );
+	EXPECT_FLOAT_EQ( 2.5f, scale );
+
+	// no rotation keys
+	Quaternion4f rotation;
+	EXPECT_FALSE( channel->computeRotation( 7.5f, rotation, cursor.rotation ) );
+}
+
 TEST( SkinnedMesh, streamSkinnedMeshAnimationChannel )
 {
 	{
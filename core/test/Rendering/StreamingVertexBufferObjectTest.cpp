@@ -0,0 +1,170 @@
+/*
+ * Copyright (c) 2013, Hernan Saez
+ * All rights reserved.
+ * 
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *     * Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in the
+ *       documentation and/or other materials provided with the distribution.
+ *     * Neither the name of the <organization> nor the
+ *       names of its contributors may be used to endorse or promote products
+ *       derived from this software without specific prior written permission.
+ * 
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL <COPYRIGHT HOLDER> BE LIABLE FOR ANY
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "Rendering/StreamingVertexBufferObject.hpp"
+
+#include "gtest/gtest.h"
+
+#include <vector>
+
+using namespace crimild;
+
+namespace crimild {
+
+	namespace test {
+
+		/**
+		   \brief Simulates GPU memory and keeps track of mapped regions
+		 */
+		class MockStreamingMapper : public StreamingVertexBufferObject::Mapper {
+		public:
+			struct Region {
+				crimild::Size offset;
+				crimild::Size size;
+				crimild::Bool discard;
+			};
+
+			explicit MockStreamingMapper( crimild::Size sizeInBytes ) : memory( sizeInBytes / sizeof( VertexPrecision ) ) { }
+
+			virtual VertexPrecision *map( StreamingVertexBufferObject *vbo, crimild::Size offset, crimild::Size size, crimild::Bool discard ) override
+			{
+				mapped.push_back( Region { offset, size, discard } );
+				return &memory[ offset / sizeof( VertexPrecision ) ];
+			}
+
+			virtual void unmap( StreamingVertexBufferObject *vbo, crimild::Size offset, crimild::Size size ) override
+			{
+				unmapped.push_back( Region { offset, size, false } );
+			}
+
+			std::vector< VertexPrecision > memory;
+			std::vector< Region > mapped;
+			std::vector< Region > unmapped;
+		};
+
+	}
+
+}
+
+TEST( StreamingVertexBufferObjectTest, construction )
+{
+	StreamingVertexBufferObject vbo( VertexFormat::VF_P3, 10 );
+
+	EXPECT_EQ( 10, vbo.getMaxVertexCount() );
+	EXPECT_EQ( StreamingVertexBufferObject::SEGMENT_COUNT * 10, vbo.getVertexCount() );
+	EXPECT_EQ( 0, vbo.getStreamedVertexCount() );
+	EXPECT_EQ( nullptr, vbo.getMapper() );
+}
+
+TEST( StreamingVertexBufferObjectTest, segmentsAreUsedAsRing )
+{
+	StreamingVertexBufferObject vbo( VertexFormat::VF_P3, 10 );
+
+	const auto segmentSize = 10 * VertexFormat::VF_P3.getVertexSize();
+
+	for ( crimild::Size frame = 0; frame < 2 * StreamingVertexBufferObject::SEGMENT_COUNT; frame++ ) {
+		auto vertices = vbo.beginStreaming( 5 );
+		const auto segment = ( frame + 1 ) % StreamingVertexBufferObject::SEGMENT_COUNT;
+		EXPECT_EQ( vbo.data() + segment * segmentSize, vertices );
+
+		for ( crimild::Size i = 0; i < 5 * VertexFormat::VF_P3.getVertexSize(); i++ ) {
+			vertices[ i ] = frame;
+		}
+		vbo.endStreaming();
+
+		EXPECT_EQ( 5, vbo.getStreamedVertexCount() );
+		EXPECT_EQ( segment, vbo.getStreamedSegment() );
+		EXPECT_EQ( segment * segmentSize * sizeof( VertexPrecision ), vbo.getStreamedOffset() );
+		EXPECT_EQ( Vector3f( frame, frame, frame ), vbo.getPositionAt( segment * 10 + 4 ) );
+	}
+}
+
+TEST( StreamingVertexBufferObjectTest, tooManyVertices )
+{
+	StreamingVertexBufferObject vbo( VertexFormat::VF_P3, 10 );
+
+	vbo.beginStreaming( 100 );
+	vbo.endStreaming();
+
+	EXPECT_EQ( 10, vbo.getStreamedVertexCount() );
+}
+
+TEST( StreamingVertexBufferObjectTest, mapper )
+{
+	StreamingVertexBufferObject vbo( VertexFormat::VF_P3_C4, 10 );
+
+	const auto vertexSize = VertexFormat::VF_P3_C4.getVertexSizeInBytes();
+	const auto segmentSize = 10 * vertexSize;
+
+	test::MockStreamingMapper mapper( vbo.getSizeInBytes() );
+	vbo.setMapper( &mapper );
+
+	for ( crimild::Size frame = 0; frame < 4; frame++ ) {
+		auto vertices = vbo.beginStreaming( 3 );
+		vertices[ 0 ] = frame;
+		vbo.endStreaming();
+	}
+
+	ASSERT_EQ( 4, mapper.mapped.size() );
+	ASSERT_EQ( 4, mapper.unmapped.size() );
+
+	const crimild::Size expectedSegments[] = { 1, 2, 0, 1 };
+	for ( crimild::Size i = 0; i < 4; i++ ) {
+		const auto segment = expectedSegments[ i ];
+		EXPECT_EQ( segment * segmentSize, mapper.mapped[ i ].offset );
+		EXPECT_EQ( 3 * vertexSize, mapper.mapped[ i ].size );
+		// buffer contents are discarded only when wrapping around
+		EXPECT_EQ( segment == 0, mapper.mapped[ i ].discard );
+		EXPECT_EQ( mapper.mapped[ i ].offset, mapper.unmapped[ i ].offset );
+		EXPECT_EQ( mapper.mapped[ i ].size, mapper.unmapped[ i ].size );
+	}
+
+	// data is written directly into the mapped memory (the first 
+	// frame was overwritten by the last one)
+	for ( crimild::Size i = 1; i < 4; i++ ) {
+		EXPECT_EQ( i, mapper.memory[ expectedSegments[ i ] * segmentSize / sizeof( VertexPrecision ) ] );
+	}
+
+	EXPECT_EQ( 1, vbo.getStreamedSegment() );
+	EXPECT_EQ( 3, vbo.getStreamedVertexCount() );
+}
+
+TEST( StreamingVertexBufferObjectTest, emptyFramesAreNotMapped )
+{
+	StreamingVertexBufferObject vbo( VertexFormat::VF_P3, 10 );
+
+	test::MockStreamingMapper mapper( vbo.getSizeInBytes() );
+	vbo.setMapper( &mapper );
+
+	vbo.beginStreaming( 0 );
+	vbo.endStreaming();
+
+	EXPECT_EQ( 0, mapper.mapped.size() );
+	EXPECT_EQ( 0, mapper.unmapped.size() );
+	EXPECT_EQ( 0, vbo.getStreamedVertexCount() );
+}
+
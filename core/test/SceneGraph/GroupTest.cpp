@@ -26,6 +26,7 @@
  */
 
 #include "SceneGraph/Group.hpp"
+#include "SceneGraph/Light.hpp"
 #include "Exceptions/HasParentException.hpp"
 #include "Streaming/FileStream.hpp"
 #include "Coding/MemoryEncoder.hpp"
@@ -375,3 +376,28 @@ TEST( GroupTest, coding )
 	}
 }
 
+
+TEST( GroupNodeTest, subtreeLightCount )
+{
+	auto scene = crimild::alloc< Group >();
+	auto group = crimild::alloc< Group >();
+	scene->attachNode( group );
+
+	EXPECT_EQ( 0, scene->getSubtreeLightCount() );
+
+	auto light = crimild::alloc< Light >();
+	EXPECT_EQ( 1, light->getSubtreeLightCount() );
+
+	group->attachNode( light );
+	group->attachNode( crimild::alloc< Light >() );
+	EXPECT_EQ( 2, group->getSubtreeLightCount() );
+	EXPECT_EQ( 2, scene->getSubtreeLightCount() );
+
+	group->detachNode( light );
+	EXPECT_EQ( 1, group->getSubtreeLightCount() );
+	EXPECT_EQ( 1, scene->getSubtreeLightCount() );
+
+	scene->detachAllNodes();
+	EXPECT_EQ( 0, scene->getSubtreeLightCount() );
+	EXPECT_EQ( 1, group->getSubtreeLightCount() );
+}
@@ -0,0 +1,220 @@
+/*
+ * Copyright (c) 2013, Hernan Saez
+ * All rights reserved.
+ * 
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *     * Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in the
+ *       documentation and/or other materials provided with the distribution.
+ *     * Neither the name of the <organization> nor the
+ *       names of its contributors may be used to endorse or promote products
+ *       derived from this software without specific prior written permission.
+ * 
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL <COPYRIGHT HOLDER> BE LIABLE FOR ANY
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "SceneGraph/SpatialIndex.hpp"
+#include "SceneGraph/Group.hpp"
+#include "Boundings/PlaneBoundingVolume.hpp"
+#include "Rendering/RenderQueue.hpp"
+#include "Visitors/ComputeRenderQueue.hpp"
+#include "Visitors/UpdateWorldState.hpp"
+
+#include "gtest/gtest.h"
+
+#include <algorithm>
+#include <cstdlib>
+#include <vector>
+
+using namespace crimild;
+
+namespace crimild {
+
+	namespace test {
+
+		SharedPointer< Group > buildSpatialIndexScene( std::vector< Geometry * > &geometries )
+		{
+			std::srand( 1234 );
+
+			auto scene = crimild::alloc< Group >();
+			for ( int i = 0; i < 20; i++ ) {
+				auto group = crimild::alloc< Group >();
+				group->local().setTranslate( 5.0f * ( i % 5 ) - 10.0f, 0.0f, -5.0f * ( i / 5 ) );
+				scene->attachNode( group );
+				for ( int j = 0; j < 20; j++ ) {
+					auto geometry = crimild::alloc< Geometry >();
+					geometry->local().setTranslate( 
+						-20.0f + 40.0f * std::rand() / RAND_MAX, 
+						-20.0f + 40.0f * std::rand() / RAND_MAX, 
+						-40.0f + 60.0f * std::rand() / RAND_MAX );
+					group->attachNode( geometry );
+					geometries.push_back( crimild::get_ptr( geometry ) );
+				}
+			}
+
+			scene->perform( UpdateWorldState() );
+
+			return scene;
+		}
+
+		std::vector< Geometry * > computeVisibleGeometries( Camera *camera, const std::vector< Geometry * > &geometries )
+		{
+			std::vector< Geometry * > result;
+			for ( auto geometry : geometries ) {
+				if ( !camera->culled( geometry->getWorldBound() ) ) {
+					result.push_back( geometry );
+				}
+			}
+			std::sort( result.begin(), result.end() );
+			return result;
+		}
+
+		std::vector< Geometry * > computeVisibleGeometries( Camera *camera, const SpatialIndex &index )
+		{
+			std::vector< Geometry * > result;
+			index.forEachVisibleGeometry( camera, [ &result ]( Geometry *geometry ) {
+				result.push_back( geometry );
+			});
+			std::sort( result.begin(), result.end() );
+			return result;
+		}
+
+	}
+
+}
+
+TEST( SpatialIndexTest, construction )
+{
+	std::vector< Geometry * > geometries;
+	auto scene = test::buildSpatialIndexScene( geometries );
+
+	SpatialIndex index;
+	index.update( crimild::get_ptr( scene ) );
+
+	EXPECT_EQ( crimild::get_ptr( scene ), index.getRoot() );
+	EXPECT_EQ( geometries.size(), index.getGeometryCount() );
+	EXPECT_EQ( geometries.size(), index.getReinsertedCount() );
+	EXPECT_TRUE( index.getTree().validate() );
+
+	// nothing changed
+	index.update( crimild::get_ptr( scene ) );
+	EXPECT_EQ( 0, index.getReinsertedCount() );
+}
+
+TEST( SpatialIndexTest, matchesCulling )
+{
+	std::vector< Geometry * > geometries;
+	auto scene = test::buildSpatialIndexScene( geometries );
+
+	SpatialIndex index;
+	index.update( crimild::get_ptr( scene ) );
+
+	auto camera = crimild::alloc< Camera >( 45.0f, 4.0f / 3.0f, 0.1f, 30.0f );
+	for ( int i = 0; i < 8; i++ ) {
+		camera->local().setTranslate( 0.0f, 0.0f, 10.0f - 5.0f * i );
+		camera->local().rotate().fromAxisAngle( Vector3f( 0.0f, 1.0f, 0.0f ), 0.4f * i );
+		camera->perform( UpdateWorldState() );
+		camera->computeCullingPlanes();
+
+		auto expected = test::computeVisibleGeometries( crimild::get_ptr( camera ), geometries );
+		auto result = test::computeVisibleGeometries( crimild::get_ptr( camera ), index );
+
+		EXPECT_GT( expected.size(), 0 );
+		EXPECT_LT( expected.size(), geometries.size() );
+		EXPECT_EQ( expected, result );
+	}
+
+	camera->setCullingEnabled( false );
+	EXPECT_EQ( geometries.size(), test::computeVisibleGeometries( crimild::get_ptr( camera ), index ).size() );
+}
+
+TEST( SpatialIndexTest, refitMovedGeometries )
+{
+	std::vector< Geometry * > geometries;
+	auto scene = test::buildSpatialIndexScene( geometries );
+
+	SpatialIndex index;
+	index.update( crimild::get_ptr( scene ) );
+
+	auto camera = crimild::alloc< Camera >( 45.0f, 4.0f / 3.0f, 0.1f, 30.0f );
+	camera->perform( UpdateWorldState() );
+	camera->computeCullingPlanes();
+
+	// move some geometries far away and some others right in front of the camera
+	for ( crimild::Size i = 0; i < geometries.size(); i += 7 ) {
+		geometries[ i ]->local().setTranslate( 0.0f, 1000.0f, 0.0f );
+	}
+	for ( crimild::Size i = 3; i < geometries.size(); i += 7 ) {
+		geometries[ i ]->world().setTranslate( 0.0f, 0.0f, -5.0f );
+		geometries[ i ]->setWorldIsCurrent( true );
+	}
+	scene->perform( UpdateWorldState() );
+	index.update( crimild::get_ptr( scene ) );
+
+	EXPECT_GT( index.getReinsertedCount(), 0 );
+	EXPECT_TRUE( index.getTree().validate() );
+	EXPECT_EQ( test::computeVisibleGeometries( crimild::get_ptr( camera ), geometries ), test::computeVisibleGeometries( crimild::get_ptr( camera ), index ) );
+}
+
+TEST( SpatialIndexTest, hierarchyChanges )
+{
+	std::vector< Geometry * > geometries;
+	auto scene = test::buildSpatialIndexScene( geometries );
+
+	SpatialIndex index;
+	index.update( crimild::get_ptr( scene ) );
+
+	auto group = scene->getNodeAt( 0 );
+	group->setEnabled( false );
+	scene->perform( UpdateWorldState() );
+	index.update( crimild::get_ptr( scene ) );
+	EXPECT_EQ( geometries.size() - 20, index.getGeometryCount() );
+	EXPECT_EQ( 0, index.getReinsertedCount() );
+	EXPECT_TRUE( index.getTree().validate() );
+
+	group->setEnabled( true );
+	scene->perform( UpdateWorldState() );
+	index.update( crimild::get_ptr( scene ) );
+	EXPECT_EQ( geometries.size(), index.getGeometryCount() );
+
+	auto geometry = crimild::alloc< Geometry >();
+	geometry->setWorldBound( crimild::alloc< PlaneBoundingVolume >( Plane3f( Vector3f( 0.0f, 1.0f, 0.0f ), 0.0f ) ) );
+	geometry->setWorldIsCurrent( true );
+	scene->attachNode( geometry );
+	auto light = crimild::alloc< Light >();
+	scene->attachNode( light );
+	scene->perform( UpdateWorldState() );
+	index.update( crimild::get_ptr( scene ) );
+	EXPECT_EQ( geometries.size() + 1, index.getGeometryCount() );
+	EXPECT_EQ( 1, index.getLightCount() );
+
+	auto camera = crimild::alloc< Camera >( 45.0f, 4.0f / 3.0f, 0.1f, 30.0f );
+	camera->perform( UpdateWorldState() );
+
+	camera->computeCullingPlanes();
+	auto expected = test::computeVisibleGeometries( crimild::get_ptr( camera ), geometries );
+	EXPECT_FALSE( expected.empty() );
+
+	// lights are always collected, and geometries with unbounded volumes are tested individually
+	RenderQueue renderQueue;
+	ComputeRenderQueue computeRenderQueue( crimild::get_ptr( camera ), &renderQueue, &index );
+	scene->perform( computeRenderQueue );
+	auto planeCount = camera->culled( geometry->getWorldBound() ) ? 0 : 1;
+	EXPECT_EQ( expected.size() + planeCount + 1, computeRenderQueue.getVisitedNodeCount() );
+
+	crimild::Size lightCount = 0;
+	renderQueue.each( [ &lightCount ]( Light *, int ) { ++lightCount; } );
+	EXPECT_EQ( 1, lightCount );
+}
@@ -0,0 +1,286 @@
+/*
+ * Copyright (c) 2013, Hernan Saez
+ * All rights reserved.
+ * 
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *     * Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in the
+ *       documentation and/or other materials provided with the distribution.
+ *     * Neither the name of the <organization> nor the
+ *       names of its contributors may be used to endorse or promote products
+ *       derived from this software without specific prior written permission.
+ * 
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL <COPYRIGHT HOLDER> BE LIABLE FOR ANY
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "SceneGraph/TransformHierarchy.hpp"
+#include "SceneGraph/Group.hpp"
+#include "SceneGraph/Switch.hpp"
+#include "Visitors/UpdateWorldState.hpp"
+#include "Concurrency/JobScheduler.hpp"
+
+#include "gtest/gtest.h"
+
+using namespace crimild;
+
+namespace crimild {
+
+	namespace test {
+
+		SharedPointer< Group > buildTransformHierarchyScene( std::vector< Node * > &nodes )
+		{
+			auto scene = crimild::alloc< Group >( "scene" );
+			scene->local().setTranslate( 1.0f, 0.0f, 0.0f );
+			nodes.push_back( crimild::get_ptr( scene ) );
+
+			for ( int i = 0; i < 3; i++ ) {
+				auto group = crimild::alloc< Group >();
+				group->local().setTranslate( 0.0f, i + 1.0f, 0.0f );
+				group->local().setScale( 2.0f );
+				scene->attachNode( group );
+				nodes.push_back( crimild::get_ptr( group ) );
+
+				for ( int j = 0; j < 4; j++ ) {
+					auto node = crimild::alloc< Node >();
+					node->local().setTranslate( 0.0f, 0.0f, j + 1.0f );
+					group->attachNode( node );
+					nodes.push_back( crimild::get_ptr( node ) );
+				}
+			}
+
+			return scene;
+		}
+
+	}
+
+}
+
+TEST( TransformHierarchyTest, basicConstruction )
+{
+	std::vector< Node * > nodes;
+	auto scene = test::buildTransformHierarchyScene( nodes );
+
+	TransformHierarchy hierarchy;
+	EXPECT_FALSE( hierarchy.isValid() );
+
+	hierarchy.update( crimild::get_ptr( scene ) );
+
+	EXPECT_TRUE( hierarchy.isValid() );
+	EXPECT_EQ( crimild::get_ptr( scene ), hierarchy.getRoot() );
+	EXPECT_EQ( nodes.size(), hierarchy.getNodeCount() );
+	EXPECT_EQ( 3, hierarchy.getLevelCount() );
+
+	for ( auto node : nodes ) {
+		EXPECT_EQ( &hierarchy, node->getTransformHierarchy() );
+	}
+}
+
+TEST( TransformHierarchyTest, matchesUpdateWorldState )
+{
+	std::vector< Node * > expectedNodes;
+	auto expected = test::buildTransformHierarchyScene( expectedNodes );
+	expected->perform( UpdateWorldState() );
+
+	std::vector< Node * > nodes;
+	auto scene = test::buildTransformHierarchyScene( nodes );
+
+	TransformHierarchy hierarchy;
+	hierarchy.update( crimild::get_ptr( scene ) );
+
+	ASSERT_EQ( expectedNodes.size(), nodes.size() );
+	for ( crimild::Size i = 0; i < nodes.size(); i++ ) {
+		EXPECT_EQ( expectedNodes[ i ]->getWorld().getTranslate(), nodes[ i ]->getWorld().getTranslate() );
+		EXPECT_EQ( expectedNodes[ i ]->getWorld().getScale(), nodes[ i ]->getWorld().getScale() );
+		EXPECT_EQ( expectedNodes[ i ]->getWorldBound()->getCenter(), nodes[ i ]->getWorldBound()->getCenter() );
+		EXPECT_EQ( expectedNodes[ i ]->getWorldBound()->getRadius(), nodes[ i ]->getWorldBound()->getRadius() );
+	}
+}
+
+TEST( TransformHierarchyTest, incrementalUpdate )
+{
+	std::vector< Node * > nodes;
+	auto scene = test::buildTransformHierarchyScene( nodes );
+
+	TransformHierarchy hierarchy;
+	hierarchy.update( crimild::get_ptr( scene ) );
+
+	auto group = nodes[ 1 ];
+	auto child = nodes[ 2 ];
+	auto sibling = nodes[ 6 ];
+	auto siblingWorld = sibling->getWorld().getTranslate();
+
+	group->local().setTranslate( 0.0f, 10.0f, 0.0f );
+
+	// world transformations are not updated until the next update
+	EXPECT_EQ( Vector3f( 1.0f, 1.0f, 2.0f ), child->getWorld().getTranslate() );
+
+	hierarchy.update( crimild::get_ptr( scene ) );
+
+	EXPECT_EQ( Vector3f( 1.0f, 10.0f, 0.0f ), group->getWorld().getTranslate() );
+	EXPECT_EQ( Vector3f( 1.0f, 10.0f, 2.0f ), child->getWorld().getTranslate() );
+	EXPECT_EQ( siblingWorld, sibling->getWorld().getTranslate() );
+
+	// bounds must be the same as if the whole scene was updated
+	std::vector< Node * > expectedNodes;
+	auto expected = test::buildTransformHierarchyScene( expectedNodes );
+	expectedNodes[ 1 ]->local().setTranslate( 0.0f, 10.0f, 0.0f );
+	expected->perform( UpdateWorldState() );
+
+	EXPECT_EQ( expected->getWorldBound()->getCenter(), scene->getWorldBound()->getCenter() );
+	EXPECT_EQ( expected->getWorldBound()->getRadius(), scene->getWorldBound()->getRadius() );
+}
+
+TEST( TransformHierarchyTest, worldIsCurrent )
+{
+	std::vector< Node * > nodes;
+	auto scene = test::buildTransformHierarchyScene( nodes );
+
+	auto group = nodes[ 1 ];
+	auto child = nodes[ 2 ];
+
+	group->setWorldIsCurrent( true );
+	group->world().setTranslate( 5.0f, 5.0f, 5.0f );
+
+	TransformHierarchy hierarchy;
+	hierarchy.update( crimild::get_ptr( scene ) );
+
+	EXPECT_EQ( Vector3f( 5.0f, 5.0f, 5.0f ), group->getWorld().getTranslate() );
+	EXPECT_EQ( Vector3f( 5.0f, 5.0f, 5.0f + 1.0f ), child->getWorld().getTranslate() );
+}
+
+TEST( TransformHierarchyTest, hierarchyChanges )
+{
+	std::vector< Node * > nodes;
+	auto scene = test::buildTransformHierarchyScene( nodes );
+
+	TransformHierarchy hierarchy;
+	hierarchy.update( crimild::get_ptr( scene ) );
+	EXPECT_EQ( 16, hierarchy.getNodeCount() );
+
+	auto node = crimild::alloc< Node >();
+	node->local().setTranslate( 0.0f, 0.0f, 3.0f );
+	scene->attachNode( node );
+
+	EXPECT_FALSE( hierarchy.isValid() );
+	EXPECT_EQ( nullptr, scene->getTransformHierarchy() );
+
+	hierarchy.update( crimild::get_ptr( scene ) );
+	EXPECT_EQ( 17, hierarchy.getNodeCount() );
+	EXPECT_EQ( Vector3f( 1.0f, 0.0f, 3.0f ), node->getWorld().getTranslate() );
+
+	// detached nodes keep their values
+	scene->detachNode( node );
+	EXPECT_EQ( nullptr, node->getTransformHierarchy() );
+	EXPECT_EQ( Vector3f( 0.0f, 0.0f, 3.0f ), node->getLocal().getTranslate() );
+	EXPECT_EQ( Vector3f( 1.0f, 0.0f, 3.0f ), node->getWorld().getTranslate() );
+
+	nodes[ 1 ]->setEnabled( false );
+	hierarchy.update( crimild::get_ptr( scene ) );
+	EXPECT_EQ( 11, hierarchy.getNodeCount() );
+	EXPECT_EQ( nullptr, nodes[ 2 ]->getTransformHierarchy() );
+
+	nodes[ 1 ]->setEnabled( true );
+	hierarchy.update( crimild::get_ptr( scene ) );
+	EXPECT_EQ( 16, hierarchy.getNodeCount() );
+}
+
+TEST( TransformHierarchyTest, switchNodes )
+{
+	auto s = crimild::alloc< Switch >();
+	s->attachNode( crimild::alloc< Node >() );
+	s->attachNode( crimild::alloc< Node >() );
+	s->getNodeAt( 1 )->local().setTranslate( 1.0f, 2.0f, 3.0f );
+
+	TransformHierarchy hierarchy;
+	hierarchy.update( crimild::get_ptr( s ) );
+	EXPECT_EQ( 2, hierarchy.getNodeCount() );
+	EXPECT_EQ( nullptr, s->getNodeAt( 1 )->getTransformHierarchy() );
+
+	s->selectNextNode();
+	hierarchy.update( crimild::get_ptr( s ) );
+	EXPECT_EQ( 2, hierarchy.getNodeCount() );
+	EXPECT_EQ( Vector3f( 1.0f, 2.0f, 3.0f ), s->getNodeAt( 1 )->getWorld().getTranslate() );
+}
+
+TEST( TransformHierarchyTest, destruction )
+{
+	std::vector< Node * > nodes;
+	auto scene = test::buildTransformHierarchyScene( nodes );
+
+	{
+		TransformHierarchy hierarchy;
+		hierarchy.update( crimild::get_ptr( scene ) );
+	}
+
+	for ( auto node : nodes ) {
+		EXPECT_EQ( nullptr, node->getTransformHierarchy() );
+	}
+	EXPECT_EQ( Vector3f( 1.0f, 1.0f, 2.0f ), nodes[ 2 ]->getWorld().getTranslate() );
+
+	// destroying the scene invalidates the hierarchy
+	TransformHierarchy hierarchy;
+	hierarchy.update( crimild::get_ptr( scene ) );
+	scene = nullptr;
+	EXPECT_FALSE( hierarchy.isValid() );
+}
+
+TEST( TransformHierarchyTest, parallelLevels )
+{
+	concurrency::JobScheduler scheduler;
+	scheduler.configure( 3 );
+	scheduler.start();
+
+	// big enough for levels to be split in parallel
+	auto buildScene = []( std::vector< Node * > &nodes ) {
+		auto scene = crimild::alloc< Group >();
+		for ( int i = 0; i < 64; i++ ) {
+			auto group = crimild::alloc< Group >();
+			group->local().setTranslate( i, 0.0f, 0.0f );
+			scene->attachNode( group );
+			for ( int j = 0; j < 64; j++ ) {
+				auto node = crimild::alloc< Node >();
+				node->local().setTranslate( 0.0f, j, 0.0f );
+				group->attachNode( node );
+				nodes.push_back( crimild::get_ptr( node ) );
+			}
+		}
+		return scene;
+	};
+
+	std::vector< Node * > expectedNodes;
+	auto expected = buildScene( expectedNodes );
+
+	std::vector< Node * > nodes;
+	auto scene = buildScene( nodes );
+
+	TransformHierarchy hierarchy;
+	hierarchy.update( crimild::get_ptr( scene ) );
+
+	for ( int frame = 0; frame < 4; frame++ ) {
+		for ( crimild::Size i = frame % 3; i < nodes.size(); i += 3 ) {
+			nodes[ i ]->local().setTranslate( frame, i, 0.0f );
+			expectedNodes[ i ]->local().setTranslate( frame, i, 0.0f );
+		}
+
+		hierarchy.update( crimild::get_ptr( scene ) );
+		expected->perform( UpdateWorldState() );
+
+		for ( crimild::Size i = 0; i < nodes.size(); i++ ) {
+			ASSERT_EQ( expectedNodes[ i ]->getWorld().getTranslate(), nodes[ i ]->getWorld().getTranslate() );
+		}
+	}
+
+	scheduler.stop();
+}
@@ -0,0 +1,112 @@
+/*
+ * Copyright (c) 2013, Hernan Saez
+ * All rights reserved.
+ * 
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *     * Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in the
+ *       documentation and/or other materials provided with the distribution.
+ *     * Neither the name of the <organization> nor the
+ *       names of its contributors may be used to endorse or promote products
+ *       derived from this software without specific prior written permission.
+ * 
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL <COPYRIGHT HOLDER> BE LIABLE FOR ANY
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "Simulation/Simulation.hpp"
+#include "Simulation/Systems/StreamingSystem.hpp"
+#include "SceneGraph/Group.hpp"
+#include "Concurrency/JobScheduler.hpp"
+
+#include "gtest/gtest.h"
+
+#include <chrono>
+#include <thread>
+
+using namespace crimild;
+
+namespace crimild {
+
+	/**
+	   \brief Steps the simulation until the condition is met or too many frames have passed
+	 */
+	static bool updateUntil( Simulation *simulation, std::function< bool( void ) > const &condition )
+	{
+		for ( int i = 0; i < 1000; i++ ) {
+			if ( condition() ) {
+				return true;
+			}
+			simulation->update();
+			std::this_thread::sleep_for( std::chrono::milliseconds( 1 ) );
+		}
+		return condition();
+	}
+
+}
+
+TEST( StreamingSystemTest, appendAndRemoveScene )
+{
+	auto simulation = crimild::alloc< Simulation >( "a simulation", crimild::alloc< Settings >() );
+	concurrency::JobScheduler::getInstance()->configure( 1 );
+
+	auto streaming = simulation->getSystem< StreamingSystem >();
+	ASSERT_TRUE( streaming != nullptr );
+
+	streaming->registerBuilder( "scene", []( std::string fileName ) -> SharedPointer< Node > {
+		return crimild::alloc< Group >( fileName );
+	});
+
+	// subtrees are built in the background
+	streaming->registerStreamingBuilder( "chunk", []( std::string fileName, std::function< void( SharedPointer< Node > const & ) > const &callback ) -> crimild::Bool {
+		for ( int i = 0; i < 3; i++ ) {
+			callback( crimild::alloc< Node >( fileName + " " + std::to_string( i ) ) );
+		}
+		return true;
+	});
+
+	streaming->setFrameBudget( 0 );
+
+	simulation->start();
+
+	MessageQueue::getInstance()->broadcastMessage( messaging::LoadScene { "world.scene" } );
+	ASSERT_TRUE( updateUntil( crimild::get_ptr( simulation ), [ &simulation ] {
+		return simulation->getScene() != nullptr;
+	}));
+
+	auto scene = static_cast< Group * >( simulation->getScene() );
+	EXPECT_EQ( "world.scene", scene->getName() );
+
+	MessageQueue::getInstance()->broadcastMessage( messaging::AppendScene { "a.chunk", nullptr } );
+	MessageQueue::getInstance()->broadcastMessage( messaging::AppendScene { "b.chunk", nullptr } );
+	ASSERT_TRUE( updateUntil( crimild::get_ptr( simulation ), [ scene ] {
+		return scene->getNodeCount() == 6;
+	}));
+
+	MessageQueue::getInstance()->broadcastMessage( messaging::RemoveScene { "a.chunk" } );
+
+	// no budget: subtrees are detached one per frame
+	simulation->update();
+	EXPECT_EQ( 5, scene->getNodeCount() );
+
+	ASSERT_TRUE( updateUntil( crimild::get_ptr( simulation ), [ scene ] {
+		return scene->getNodeCount() == 3;
+	}));
+
+	scene->forEachNode( []( Node *node ) {
+		EXPECT_EQ( 0, node->getName().find( "b.chunk" ) );
+	});
+
+	simulation->stop();
+}
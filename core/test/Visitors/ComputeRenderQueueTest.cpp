@@ -0,0 +1,220 @@
+/*
+ * Copyright (c) 2013, Hernan Saez
+ * All rights reserved.
+ * 
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *     * Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *     * Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in the
+ *       documentation and/or other materials provided with the distribution.
+ *     * Neither the name of the <organization> nor the
+ *       names of its contributors may be used to endorse or promote products
+ *       derived from this software without specific prior written permission.
+ * 
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ * ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL <COPYRIGHT HOLDER> BE LIABLE FOR ANY
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ * LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "Visitors/ComputeRenderQueue.hpp"
+#include "Visitors/UpdateWorldState.hpp"
+#include "Rendering/RenderQueue.hpp"
+#include "Rendering/AlphaState.hpp"
+#include "Components/RenderStateComponent.hpp"
+#include "Concurrency/JobScheduler.hpp"
+#include "SceneGraph/Group.hpp"
+
+#include "gtest/gtest.h"
+
+#include <cstdlib>
+#include <vector>
+
+using namespace crimild;
+using namespace crimild::concurrency;
+
+namespace crimild {
+
+	namespace test {
+
+		SharedPointer< Group > buildComputeRenderQueueScene( void )
+		{
+			std::srand( 4321 );
+
+			std::vector< SharedPointer< Material >> materials;
+			for ( int i = 0; i < 8; i++ ) {
+				auto material = crimild::alloc< Material >();
+				material->setProgram( crimild::alloc< ShaderProgram >() );
+				material->setCastShadows( i % 2 == 0 );
+				if ( i == 7 ) {
+					material->setAlphaState( AlphaState::ENABLED );
+				}
+				materials.push_back( material );
+			}
+
+			auto scene = crimild::alloc< Group >();
+			for ( int i = 0; i < 8; i++ ) {
+				auto group = crimild::alloc< Group >();
+				// some groups end up behind the camera
+				group->local().setTranslate( 0.0f, 0.0f, i % 4 == 3 ? 100.0f : -10.0f * i );
+				scene->attachNode( group );
+
+				for ( int j = 0; j < 10; j++ ) {
+					auto subgroup = crimild::alloc< Group >();
+					group->attachNode( subgroup );
+
+					if ( i == 2 && j == 5 ) {
+						subgroup->attachNode( crimild::alloc< Light >() );
+					}
+
+					for ( int k = 0; k < 20; k++ ) {
+						auto geometry = crimild::alloc< Geometry >();
+						geometry->local().setTranslate(
+							-20.0f + 40.0f * std::rand() / RAND_MAX,
+							-20.0f + 40.0f * std::rand() / RAND_MAX,
+							-20.0f + 40.0f * std::rand() / RAND_MAX );
+						geometry->attachComponent< RenderStateComponent >()->attachMaterial( materials[ std::rand() % materials.size() ] );
+						subgroup->attachNode( geometry );
+					}
+				}
+			}
+
+			// lights at the top level too
+			scene->attachNode( crimild::alloc< Light >() );
+
+			scene->perform( UpdateWorldState() );
+
+			return scene;
+		}
+
+		std::vector< void * > dumpRenderQueue( RenderQueue &renderQueue )
+		{
+			std::vector< void * > result;
+
+			const RenderQueue::RenderableType types[] = {
+				RenderQueue::RenderableType::OCCLUDER,
+				RenderQueue::RenderableType::SHADOW_CASTER,
+				RenderQueue::RenderableType::OPAQUE,
+				RenderQueue::RenderableType::TRANSLUCENT,
+				RenderQueue::RenderableType::SCREEN,
+			};
+
+			for ( auto type : types ) {
+				result.push_back( nullptr );
+				renderQueue.each( renderQueue.getRenderables( type ), [ &result ]( RenderQueue::Renderable *renderable ) {
+					result.push_back( crimild::get_ptr( renderable->geometry ) );
+					result.push_back( crimild::get_ptr( renderable->material ) );
+				});
+			}
+
+			result.push_back( nullptr );
+			renderQueue.each( [ &result ]( Light *light, int ) {
+				result.push_back( light );
+			});
+
+			return result;
+		}
+
+	}
+
+}
+
+TEST( ComputeRenderQueueTest, parallelMatchesSequential )
+{
+	auto scene = test::buildComputeRenderQueueScene();
+	auto camera = crimild::alloc< Camera >();
+
+	RenderQueue expected;
+	ComputeRenderQueue sequential( crimild::get_ptr( camera ), &expected );
+	scene->perform( sequential );
+	EXPECT_EQ( 0, sequential.getJobCount() );
+
+	auto expectedDump = test::dumpRenderQueue( expected );
+	EXPECT_LT( 100, expected.getRenderables( RenderQueue::RenderableType::OPAQUE )->size() );
+	EXPECT_LT( 0, expected.getRenderables( RenderQueue::RenderableType::TRANSLUCENT )->size() );
+
+	JobScheduler scheduler;
+	scheduler.configure( 3 );
+	scheduler.start();
+
+	RenderQueue result;
+	ComputeRenderQueue parallel( crimild::get_ptr( camera ), &result );
+	parallel.setParallelThreshold( 0 );
+
+	// queues are reused, so results must not depend on previous frames either
+	for ( int frame = 0; frame < 10; frame++ ) {
+		scene->perform( parallel );
+
+		EXPECT_LT( 1, parallel.getJobCount() );
+		EXPECT_EQ( sequential.getVisitedNodeCount(), parallel.getVisitedNodeCount() );
+		EXPECT_EQ( expectedDump, test::dumpRenderQueue( result ) );
+	}
+
+	scheduler.stop();
+}
+
+TEST( ComputeRenderQueueTest, smallScenesAreSequential )
+{
+	auto scene = test::buildComputeRenderQueueScene();
+	auto camera = crimild::alloc< Camera >();
+
+	JobScheduler scheduler;
+	scheduler.configure( 3 );
+	scheduler.start();
+
+	RenderQueue result;
+	ComputeRenderQueue computeRenderQueue( crimild::get_ptr( camera ), &result );
+	computeRenderQueue.setParallelThreshold( 1000000 );
+
+	scene->perform( computeRenderQueue );
+	scene->perform( computeRenderQueue );
+	EXPECT_EQ( 0, computeRenderQueue.getJobCount() );
+
+	scheduler.stop();
+}
+
+TEST( ComputeRenderQueueTest, noWorkers )
+{
+	auto scene = test::buildComputeRenderQueueScene();
+	auto camera = crimild::alloc< Camera >();
+
+	RenderQueue result;
+	ComputeRenderQueue computeRenderQueue( crimild::get_ptr( camera ), &result );
+	computeRenderQueue.setParallelThreshold( 0 );
+
+	scene->perform( computeRenderQueue );
+	EXPECT_EQ( 0, computeRenderQueue.getJobCount() );
+	EXPECT_LT( 0, result.getRenderables( RenderQueue::RenderableType::OPAQUE )->size() );
+}
+
+TEST( ComputeRenderQueueTest, groupsAreNotCulled )
+{
+	auto scene = test::buildComputeRenderQueueScene();
+	auto camera = crimild::alloc< Camera >();
+
+	RenderQueue result;
+	ComputeRenderQueue computeRenderQueue( crimild::get_ptr( camera ), &result );
+	computeRenderQueue.setParallelThreshold( 1000000 );
+
+	scene->perform( computeRenderQueue );
+
+	// groups behind the camera are still traversed, since they
+	// might contain nodes affecting the scene. Only geometries
+	// are culled
+	const crimild::Size nodeCount = 1 + 8 * ( 1 + 10 * ( 1 + 20 ) ) + 2;
+	EXPECT_EQ( nodeCount, computeRenderQueue.getVisitedNodeCount() );
+
+	crimild::Size lightCount = 0;
+	result.each( [ &lightCount ]( Light *, int ) {
+		lightCount++;
+	});
+	EXPECT_EQ( 2, lightCount );
+}
@@ -26,6 +26,7 @@
  */
 
 #include "Visitors/UpdateWorldState.hpp"
+#include "SceneGraph/Node.hpp"
 #include "SceneGraph/Group.hpp"
 #include "SceneGraph/Geometry.hpp"
 
@@ -101,3 +102,74 @@ TEST( UpdateWorldStateTest, hierarchy )
 
 */
 
+
+TEST( UpdateWorldStateTest, skipCleanSubtrees )
+{
+	auto scene = crimild::alloc< Group >();
+	auto group1 = crimild::alloc< Group >();
+	auto group2 = crimild::alloc< Group >();
+	auto node1 = crimild::alloc< Node >();
+	auto node2 = crimild::alloc< Node >();
+
+	scene->attachNode( group1 );
+	scene->attachNode( group2 );
+	group1->attachNode( node1 );
+	group2->attachNode( node2 );
+
+	UpdateWorldState updateWorldState;
+
+	scene->perform( updateWorldState );
+	EXPECT_EQ( 5, updateWorldState.getUpdatedNodeCount() );
+	EXPECT_FALSE( scene->isSubtreeDirty() );
+	EXPECT_FALSE( node1->isWorldDirty() );
+
+	// nothing changed
+	scene->perform( updateWorldState );
+	EXPECT_EQ( 0, updateWorldState.getUpdatedNodeCount() );
+
+	// only the path to the changed node is updated
+	auto worldRevision = node2->getWorldRevision();
+	node1->local().setTranslate( 0.0f, 0.0f, -5.0f );
+	EXPECT_TRUE( node1->isWorldDirty() );
+	EXPECT_TRUE( group1->isSubtreeDirty() );
+	EXPECT_TRUE( scene->isSubtreeDirty() );
+	EXPECT_FALSE( group2->isSubtreeDirty() );
+
+	scene->perform( updateWorldState );
+	EXPECT_EQ( 3, updateWorldState.getUpdatedNodeCount() );
+	EXPECT_EQ( Vector3f( 0.0f, 0.0f, -5.0f ), node1->getWorld().getTranslate() );
+	EXPECT_EQ( worldRevision, node2->getWorldRevision() );
+
+	// children of changed nodes are updated too
+	group2->local().setTranslate( 1.0f, 0.0f, 0.0f );
+	scene->perform( updateWorldState );
+	EXPECT_EQ( 3, updateWorldState.getUpdatedNodeCount() );
+	EXPECT_EQ( Vector3f( 1.0f, 0.0f, 0.0f ), node2->getWorld().getTranslate() );
+	EXPECT_EQ( worldRevision + 1, node2->getWorldRevision() );
+}
+
+TEST( UpdateWorldStateTest, hierarchyChanges )
+{
+	auto scene = crimild::alloc< Group >();
+	auto group = crimild::alloc< Group >();
+	group->local().setTranslate( 1.0f, 0.0f, 0.0f );
+	scene->attachNode( group );
+
+	UpdateWorldState updateWorldState;
+	scene->perform( updateWorldState );
+
+	auto node = crimild::alloc< Node >();
+	node->local().setTranslate( 0.0f, 1.0f, 0.0f );
+	node->perform( updateWorldState );
+	EXPECT_EQ( Vector3f( 0.0f, 1.0f, 0.0f ), node->getWorld().getTranslate() );
+
+	group->attachNode( node );
+	scene->perform( updateWorldState );
+	EXPECT_EQ( Vector3f( 1.0f, 1.0f, 0.0f ), node->getWorld().getTranslate() );
+
+	// disabled nodes are not included in the parent's bound
+	auto boundRevision = group->getBoundRevision();
+	node->setEnabled( false );
+	scene->perform( updateWorldState );
+	EXPECT_EQ( boundRevision + 1, group->getBoundRevision() );
+}
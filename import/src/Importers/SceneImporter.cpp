@@ -415,6 +415,11 @@ void SceneImporter::loadAnimations( const aiScene *scene, SharedPointer< Skinned
 			clip->addChannel( sChannel );
 		}
 
+		// resample keys so channels don't need to search for them when evaluated
+		const crimild::Real32 SAMPLES_PER_SECOND = 30.0f;
+		const crimild::Real32 ticksPerSecond = inAnimation->mTicksPerSecond > 0.0 ? inAnimation->mTicksPerSecond : 25.0;
+		clip->resample( SAMPLES_PER_SECOND / ticksPerSecond );
+
 		_skeleton->getClips()[ clip->getName() ] = clip;
 	}
 }
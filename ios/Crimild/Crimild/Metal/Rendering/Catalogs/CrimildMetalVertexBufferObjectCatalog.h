@@ -38,7 +38,9 @@ namespace crimild {
         
         class MetalRenderer;
         
-        class VertexBufferObjectCatalog : public Catalog< VertexBufferObject > {
+        class VertexBufferObjectCatalog :
+            public Catalog< VertexBufferObject >,
+            public StreamingVertexBufferObject::Mapper {
         public:
             VertexBufferObjectCatalog( MetalRenderer *renderer );
             virtual ~VertexBufferObjectCatalog( void );
@@ -53,6 +55,9 @@ namespace crimild {
             
             virtual void cleanup( void ) override;
             
+            virtual VertexPrecision *map( StreamingVertexBufferObject *vbo, crimild::Size offset, crimild::Size size, crimild::Bool discard ) override;
+            virtual void unmap( StreamingVertexBufferObject *vbo, crimild::Size offset, crimild::Size size ) override;
+            
         protected:
             MetalRenderer *getRenderer( void ) { return _renderer; }
             
@@ -60,8 +60,16 @@ void VertexBufferObjectCatalog::bind( ShaderProgram *program, VertexBufferObject
         return;
     }
     
+    NSUInteger offset = 0;
+    
+    auto streaming = dynamic_cast< StreamingVertexBufferObject * >( vbo );
+    if ( streaming != nullptr ) {
+        // only the segment written in the last frame is drawn
+        offset = streaming->getStreamedOffset();
+    }
+    
     [getRenderer()->getRenderEncoder() setVertexBuffer: _vbos[ vbo->getCatalogId() ]
-                                                offset: 0
+                                                offset: offset
                                                atIndex: 0];
 }
 
@@ -79,11 +87,22 @@ void VertexBufferObjectCatalog::load( VertexBufferObject *vbo )
                                                                               length: vbo->getSizeInBytes()
                                                                              options: MTLResourceOptionCPUCacheModeDefault];
         _vbos[ vbo->getCatalogId() ] = vertexArray;
+        
+        auto streaming = dynamic_cast< StreamingVertexBufferObject * >( vbo );
+        if ( streaming != nullptr ) {
+            // from now on, vertices are written directly into the Metal buffer
+            streaming->setMapper( this );
+        }
     }
 }
 
 void VertexBufferObjectCatalog::unload( VertexBufferObject *vbo )
 {
+    auto streaming = dynamic_cast< StreamingVertexBufferObject * >( vbo );
+    if ( streaming != nullptr && streaming->getMapper() == this ) {
+        streaming->setMapper( nullptr );
+    }
+    
     _vbos[ vbo->getCatalogId() ] = nullptr;
     
     Catalog< VertexBufferObject >::unload( vbo );
@@ -94,5 +113,24 @@ void VertexBufferObjectCatalog::cleanup( void )
     Catalog< VertexBufferObject >::cleanup();
 }
 
+VertexPrecision *VertexBufferObjectCatalog::map( StreamingVertexBufferObject *vbo, crimild::Size offset, crimild::Size size, crimild::Bool discard )
+{
+    // buffers use shared storage, so their contents can be written directly. 
+    // There is no need to discard anything, since the ring guarantees the 
+    // GPU is not reading from the segment being written
+    id< MTLBuffer > buffer = _vbos[ vbo->getCatalogId() ];
+    if ( buffer == nil ) {
+        return vbo->data() + offset / sizeof( VertexPrecision );
+    }
+    
+    return reinterpret_cast< VertexPrecision * >( static_cast< unsigned char * >( [buffer contents] ) + offset );
+}
+
+void VertexBufferObjectCatalog::unmap( StreamingVertexBufferObject *vbo, crimild::Size offset, crimild::Size size )
+{
+    // writes to shared storage are visible to the GPU once the command
+    // buffer is committed, so there is nothing to flush
+}
+
 #endif // TARGET_OS_SIMULATOR
 
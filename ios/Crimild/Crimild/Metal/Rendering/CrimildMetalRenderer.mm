@@ -337,7 +337,7 @@ void MetalRenderer::drawPrimitive( ShaderProgram *program, Primitive *primitive
     [getRenderEncoder() setVertexBuffer: uniforms offset: 0 atIndex: location->getLocation()];
     [getRenderEncoder() setFragmentBuffer: uniforms offset: 0 atIndex: location->getLocation()];
 
-    auto indexCount = primitive->getIndexBuffer()->getIndexCount();
+    auto indexCount = primitive->getIndexCount();
     auto indexBuffer = static_cast< IndexBufferObjectCatalog * >( getIndexBufferObjectCatalog() )->getMetalIndexBuffer( primitive->getIndexBuffer() );
     
     [getRenderEncoder() drawIndexedPrimitives: MTLPrimitiveTypeTriangle
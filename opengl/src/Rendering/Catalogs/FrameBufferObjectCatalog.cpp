@@ -204,7 +204,9 @@ void FrameBufferObjectCatalog::load( FrameBufferObject *fbo )
                     target->getTexture()->setName( rtName );
                     target->getTexture()->setCatalogInfo( getRenderer()->getTextureCatalog(), textureId );
                     
-                    glBindTexture( GL_TEXTURE_2D, target->getTexture()->getCatalogId() );
+                    if ( getRenderer()->getStateCache()->bindTexture( target->getTexture()->getCatalogId() ) ) {
+                        glBindTexture( GL_TEXTURE_2D, target->getTexture()->getCatalogId() );
+                    }
                     glTexParameteri( GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_NEAREST );
                     glTexParameteri( GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_NEAREST );
                     glTexParameteri( GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE );
@@ -314,6 +316,7 @@ void FrameBufferObjectCatalog::cleanup( void )
     
     for ( auto id : _textureIdsToDelete ) {
         GLuint textureId = id;
+        getRenderer()->getStateCache()->invalidateTexture( textureId );
         glDeleteTextures( 1, &textureId );
     }
     _textureIdsToDelete.clear();
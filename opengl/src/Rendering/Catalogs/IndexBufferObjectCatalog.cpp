@@ -29,11 +29,13 @@
 #include "Rendering/OpenGLUtils.hpp"
 
 #include <Rendering/IndexBufferObject.hpp>
+#include <Rendering/Renderer.hpp>
 
 using namespace crimild;
 using namespace crimild::opengl;
 
-IndexBufferObjectCatalog::IndexBufferObjectCatalog( void )
+IndexBufferObjectCatalog::IndexBufferObjectCatalog( Renderer *renderer )
+    : _renderer( renderer )
 {
 
 }
@@ -61,7 +63,9 @@ void IndexBufferObjectCatalog::bind( ShaderProgram *program, IndexBufferObject *
     
 	Catalog< IndexBufferObject >::bind( program, ibo );
 
-	glBindBuffer( GL_ELEMENT_ARRAY_BUFFER, ibo->getCatalogId() );
+	if ( getRenderer()->getStateCache()->bindIndexBuffer( ibo->getCatalogId() ) ) {
+		glBindBuffer( GL_ELEMENT_ARRAY_BUFFER, ibo->getCatalogId() );
+	}
     
     CRIMILD_CHECK_GL_ERRORS_AFTER_CURRENT_FUNCTION;
 }
@@ -72,7 +76,9 @@ void IndexBufferObjectCatalog::unbind( ShaderProgram *program, IndexBufferObject
     
 	Catalog< IndexBufferObject >::unbind( program, ibo );
 
-	glBindBuffer( GL_ELEMENT_ARRAY_BUFFER, 0 );
+	if ( getRenderer()->getStateCache()->bindIndexBuffer( 0 ) ) {
+		glBindBuffer( GL_ELEMENT_ARRAY_BUFFER, 0 );
+	}
     
     CRIMILD_CHECK_GL_ERRORS_AFTER_CURRENT_FUNCTION;
 }
@@ -84,7 +90,9 @@ void IndexBufferObjectCatalog::load( IndexBufferObject *ibo )
 	Catalog< IndexBufferObject >::load( ibo );
 
 	int id = ibo->getCatalogId();
-	glBindBuffer( GL_ELEMENT_ARRAY_BUFFER, id );
+	if ( getRenderer()->getStateCache()->bindIndexBuffer( id ) ) {
+		glBindBuffer( GL_ELEMENT_ARRAY_BUFFER, id );
+	}
 	glBufferData( GL_ELEMENT_ARRAY_BUFFER, 
 		sizeof( IndexPrecision ) * ibo->getIndexCount(), 
 		ibo->getData(), 
@@ -109,6 +117,7 @@ void IndexBufferObjectCatalog::cleanup( void )
     
     for ( auto id : _unusedIBOIds ) {
         GLuint bufferId = id;
+        getRenderer()->getStateCache()->invalidateBuffer( bufferId );
         glDeleteBuffers( 1, &bufferId );
     }
     
@@ -33,14 +33,17 @@
 namespace crimild {
     
     class IndexBufferObject;
+    class Renderer;
 
 	namespace opengl {
 
 		class IndexBufferObjectCatalog : public Catalog< IndexBufferObject > {
 		public:
-			IndexBufferObjectCatalog( void );
+			explicit IndexBufferObjectCatalog( Renderer *renderer );
 			virtual ~IndexBufferObjectCatalog( void );
 
+			Renderer *getRenderer( void ) { return _renderer; }
+
 			virtual int getNextResourceId( void ) override;
 
 			virtual void bind( ShaderProgram *program, IndexBufferObject *ibo ) override;
@@ -52,6 +55,7 @@ namespace crimild {
             virtual void cleanup( void ) override;
             
         private:
+            Renderer *_renderer = nullptr;
             std::list< int > _unusedIBOIds;
 		};
 
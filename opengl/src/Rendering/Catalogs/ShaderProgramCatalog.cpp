@@ -30,11 +30,13 @@
 
 #include <Foundation/Log.hpp>
 #include <Rendering/ShaderProgram.hpp>
+#include <Rendering/Renderer.hpp>
 
 using namespace crimild;
 using namespace crimild::opengl;
 
-ShaderProgramCatalog::ShaderProgramCatalog( void )
+ShaderProgramCatalog::ShaderProgramCatalog( Renderer *renderer )
+    : _renderer( renderer )
 {
 
 }
@@ -55,7 +57,9 @@ void ShaderProgramCatalog::bind( ShaderProgram *program )
 
 	Catalog< ShaderProgram >::bind( program );
 
-	glUseProgram( program->getCatalogId() );
+	if ( getRenderer()->getStateCache()->bindProgram( program->getCatalogId() ) ) {
+		glUseProgram( program->getCatalogId() );
+	}
 
     CRIMILD_CHECK_GL_ERRORS_AFTER_CURRENT_FUNCTION;
 }
@@ -66,7 +70,9 @@ void ShaderProgramCatalog::unbind( ShaderProgram *program )
 
 	Catalog< ShaderProgram >::unbind( program );
 
-	glUseProgram( 0 );
+	if ( getRenderer()->getStateCache()->bindProgram( 0 ) ) {
+		glUseProgram( 0 );
+	}
 
     CRIMILD_CHECK_GL_ERRORS_AFTER_CURRENT_FUNCTION;
 }
@@ -79,6 +85,9 @@ void ShaderProgramCatalog::load( ShaderProgram *program )
 
 	int programId = program->getCatalogId();
 	if ( programId > 0 ) {
+		// linking resets all uniform values
+		getRenderer()->getStateCache()->invalidateProgram( programId );
+
 		int vsId = compileShader( program->getVertexShader(), GL_VERTEX_SHADER );
 		int fsId = compileShader( program->getFragmentShader(), GL_FRAGMENT_SHADER );
 
@@ -109,6 +118,7 @@ void ShaderProgramCatalog::load( ShaderProgram *program )
                     }
                 }
 
+                getRenderer()->getStateCache()->invalidateProgram( programId );
                 glDeleteProgram( programId );
                 programId = 0;
             }
@@ -144,6 +154,7 @@ void ShaderProgramCatalog::unload( ShaderProgram *program )
 void ShaderProgramCatalog::cleanup( void )
 {
     for ( auto id : _shaderIdsToDelete ) {
+        getRenderer()->getStateCache()->invalidateProgram( id );
         glDeleteProgram( id );
     }
     _shaderIdsToDelete.clear();
@@ -34,14 +34,17 @@ namespace crimild {
     
     class Shader;
     class ShaderProgram;
+    class Renderer;
 
 	namespace opengl {
 
 		class ShaderProgramCatalog : public Catalog< ShaderProgram > {
 		public:
-			ShaderProgramCatalog( void );
+			explicit ShaderProgramCatalog( Renderer *renderer );
 			virtual ~ShaderProgramCatalog( void );
 
+			Renderer *getRenderer( void ) { return _renderer; }
+
 			virtual int getNextResourceId( void ) override;
 
 			virtual void bind( ShaderProgram *program ) override;
@@ -59,6 +62,7 @@ namespace crimild {
 			void fetchUniformLocation( ShaderProgram *program, ShaderLocation *location );
             
         private:
+            Renderer *_renderer = nullptr;
             std::list< int > _shaderIdsToDelete;
 		};
 
@@ -32,6 +32,7 @@
 #include <Foundation/Log.hpp>
 #include <Rendering/Texture.hpp>
 #include <Rendering/ShaderLocation.hpp>
+#include <Rendering/Renderer.hpp>
 
 // TODO: this will cause visual artifacts in some platforms. use with care
 #ifndef GL_BGR
@@ -47,8 +48,9 @@
 using namespace crimild;
 using namespace crimild::opengl;
 
-TextureCatalog::TextureCatalog( void )
-	: _boundTextureCount( 0 )
+TextureCatalog::TextureCatalog( Renderer *renderer )
+	: _renderer( renderer ),
+	  _boundTextureCount( 0 )
 {
 
 }
@@ -87,9 +89,16 @@ void TextureCatalog::bind( ShaderLocation *location, Texture *texture )
 	}
 
 	if ( location && location->isValid() ) {
-		glActiveTexture( GL_TEXTURE0 + _boundTextureCount );
-		glBindTexture( GL_TEXTURE_2D, texture->getCatalogId() );
-		glUniform1i( location->getLocation(), _boundTextureCount );
+		auto stateCache = getRenderer()->getStateCache();
+		if ( stateCache->setActiveTextureUnit( _boundTextureCount ) ) {
+			glActiveTexture( GL_TEXTURE0 + _boundTextureCount );
+		}
+		if ( stateCache->bindTexture( texture->getCatalogId() ) ) {
+			glBindTexture( GL_TEXTURE_2D, texture->getCatalogId() );
+		}
+		if ( stateCache->setUniform( location->getLocation(), _boundTextureCount ) ) {
+			glUniform1i( location->getLocation(), _boundTextureCount );
+		}
 
 		++_boundTextureCount;
 	} 
@@ -107,8 +116,14 @@ void TextureCatalog::unbind( ShaderLocation *location, Texture *texture )
 
 	if ( _boundTextureCount > 0 ) {
 		--_boundTextureCount;
-		glActiveTexture( GL_TEXTURE0 + _boundTextureCount );
-		glBindTexture( GL_TEXTURE_2D, 0 );
+
+		auto stateCache = getRenderer()->getStateCache();
+		if ( stateCache->setActiveTextureUnit( _boundTextureCount ) ) {
+			glActiveTexture( GL_TEXTURE0 + _boundTextureCount );
+		}
+		if ( stateCache->bindTexture( 0 ) ) {
+			glBindTexture( GL_TEXTURE_2D, 0 );
+		}
 	}
 	
 	Catalog< Texture >::unbind( location, texture );
@@ -128,7 +143,9 @@ void TextureCatalog::load( Texture *texture )
 	Catalog< Texture >::load( texture );
 
 	int textureId = texture->getCatalogId();
-    glBindTexture( GL_TEXTURE_2D, textureId );
+    if ( getRenderer()->getStateCache()->bindTexture( textureId ) ) {
+        glBindTexture( GL_TEXTURE_2D, textureId );
+    }
     glTexParameterf( GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, OpenGLUtils::TEXTURE_FILTER_MAP[ ( uint8_t ) texture->getMinFilter() ] );
     glTexParameterf( GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, OpenGLUtils::TEXTURE_FILTER_MAP[ ( uint8_t ) texture->getMagFilter() ] );
     glTexParameteri( GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, OpenGLUtils::TEXTURE_WRAP_MODE_CLAMP[ ( uint8_t ) texture->getWrapMode() ] );
@@ -187,6 +204,7 @@ void TextureCatalog::cleanup( void )
     
     for ( auto id : _textureIdsToDelete ) {
         GLuint textureId = id;
+        getRenderer()->getStateCache()->invalidateTexture( textureId );
         glDeleteTextures( 1, &textureId );
     }
     
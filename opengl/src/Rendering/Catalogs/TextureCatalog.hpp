@@ -33,14 +33,17 @@
 namespace crimild {
     
     class Texture;
+    class Renderer;
 
 	namespace opengl {
 
 		class TextureCatalog : public Catalog< Texture > {
 		public:
-			TextureCatalog( void );
+			explicit TextureCatalog( Renderer *renderer );
 			virtual ~TextureCatalog( void );
 
+			Renderer *getRenderer( void ) { return _renderer; }
+
 			virtual int getNextResourceId( void ) override;
 
 			virtual void bind( ShaderLocation *location, Texture *texture ) override;
@@ -52,6 +55,7 @@ namespace crimild {
             virtual void cleanup( void ) override;
 
 		private:
+			Renderer *_renderer = nullptr;
 			int _boundTextureCount;
             
             std::list< int > _textureIdsToDelete;
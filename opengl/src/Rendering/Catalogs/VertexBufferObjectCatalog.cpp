@@ -31,11 +31,14 @@
 
 #include <Rendering/ShaderProgram.hpp>
 #include <Rendering/VertexBufferObject.hpp>
+#include <Rendering/Renderer.hpp>
+#include <Foundation/Log.hpp>
 
 using namespace crimild;
 using namespace crimild::opengl;
 
-VertexBufferObjectCatalog::VertexBufferObjectCatalog( void )
+VertexBufferObjectCatalog::VertexBufferObjectCatalog( Renderer *renderer )
+    : _renderer( renderer )
 {
 
 }
@@ -53,7 +56,9 @@ int VertexBufferObjectCatalog::getNextResourceId( void )
 
 #ifndef CRIMILD_FORCE_OPENGL_COMPATIBILITY_MODE
     glGenVertexArrays( 1, &vaoId );
-  	glBindVertexArray( vaoId );
+    if ( getRenderer()->getStateCache()->bindVertexArray( vaoId ) ) {
+        glBindVertexArray( vaoId );
+    }
 #endif
 	
 	GLuint vboId;    
@@ -97,13 +102,25 @@ void VertexBufferObjectCatalog::bind( ShaderProgram *program, VertexBufferObject
 
     extractId( vbo->getCatalogId(), vaoId, vboId );
 
+    auto stateCache = getRenderer()->getStateCache();
+
 #ifndef CRIMILD_FORCE_OPENGL_COMPATIBILITY_MODE
-    glBindVertexArray( vaoId );
+    if ( stateCache->bindVertexArray( vaoId ) ) {
+        glBindVertexArray( vaoId );
+    }
 #endif
 
-    glBindBuffer( GL_ARRAY_BUFFER, vboId );
+    if ( stateCache->bindVertexBuffer( vboId ) ) {
+        glBindBuffer( GL_ARRAY_BUFFER, vboId );
+    }
     float *baseOffset = 0;
 
+    auto streaming = dynamic_cast< StreamingVertexBufferObject * >( vbo );
+    if ( streaming != nullptr ) {
+        // only the segment written in the last frame is drawn
+        baseOffset += streaming->getStreamedOffset() / sizeof( VertexPrecision );
+    }
+
     const VertexFormat &format = vbo->getVertexFormat();
 
     auto positionLocation = program->getStandardLocation( ShaderProgram::StandardLocation::POSITION_ATTRIBUTE );
@@ -204,11 +221,17 @@ void VertexBufferObjectCatalog::unbind( ShaderProgram *program, VertexBufferObje
 {
 	CRIMILD_CHECK_GL_ERRORS_BEFORE_CURRENT_FUNCTION;
 
+    auto stateCache = getRenderer()->getStateCache();
+
 #ifndef CRIMILD_FORCE_OPENGL_COMPATIBILITY_MODE
-    glBindVertexArray( 0 );
+    if ( stateCache->bindVertexArray( 0 ) ) {
+        glBindVertexArray( 0 );
+    }
 #endif
 
-    glBindBuffer( GL_ARRAY_BUFFER, 0 );
+    if ( stateCache->bindVertexBuffer( 0 ) ) {
+        glBindBuffer( GL_ARRAY_BUFFER, 0 );
+    }
     
 	Catalog< VertexBufferObject >::unbind( program, vbo );
 
@@ -224,15 +247,29 @@ void VertexBufferObjectCatalog::load( VertexBufferObject *vbo )
 	GLuint vaoId, vboId;
 	extractId( vbo->getCatalogId(), vaoId, vboId );
 
+    auto stateCache = getRenderer()->getStateCache();
+
 #ifndef CRIMILD_FORCE_OPENGL_COMPATIBILITY_MODE
-	glBindVertexArray( vaoId );
+	if ( stateCache->bindVertexArray( vaoId ) ) {
+		glBindVertexArray( vaoId );
+	}
 #endif
 
-    glBindBuffer( GL_ARRAY_BUFFER, vboId );
+    if ( stateCache->bindVertexBuffer( vboId ) ) {
+        glBindBuffer( GL_ARRAY_BUFFER, vboId );
+    }
+
+    auto streaming = dynamic_cast< StreamingVertexBufferObject * >( vbo );
+
     glBufferData( GL_ARRAY_BUFFER,
          vbo->getVertexFormat().getVertexSizeInBytes() * vbo->getVertexCount(),
          vbo->getData(),
-         GL_STATIC_DRAW );
+         streaming != nullptr ? GL_STREAM_DRAW : GL_STATIC_DRAW );
+
+    if ( streaming != nullptr ) {
+        // from now on, vertices are written directly into GPU memory
+        streaming->setMapper( this );
+    }
 
     CRIMILD_CHECK_GL_ERRORS_AFTER_CURRENT_FUNCTION;
 }
@@ -245,6 +282,11 @@ void VertexBufferObjectCatalog::unload( VertexBufferObject *vbo )
       	_unusedVBOIds.push_back( vbo->getCatalogId() );
     }
 
+    auto streaming = dynamic_cast< StreamingVertexBufferObject * >( vbo );
+    if ( streaming != nullptr && streaming->getMapper() == this ) {
+        streaming->setMapper( nullptr );
+    }
+
     Catalog< VertexBufferObject >::unload( vbo );
     
     CRIMILD_CHECK_GL_ERRORS_AFTER_CURRENT_FUNCTION;
@@ -258,8 +300,10 @@ void VertexBufferObjectCatalog::cleanup( void )
         GLuint vaoId, vboId;
         extractId( id, vaoId, vboId );
         
+        getRenderer()->getStateCache()->invalidateBuffer( vboId );
         glDeleteBuffers( 1, &vboId );
 #ifndef CRIMILD_FORCE_OPENGL_COMPATIBILITY_MODE
+        getRenderer()->getStateCache()->invalidateVertexArray( vaoId );
         glDeleteVertexArrays( 1, &vaoId );
 #endif
     }
@@ -269,3 +313,65 @@ void VertexBufferObjectCatalog::cleanup( void )
     CRIMILD_CHECK_GL_ERRORS_AFTER_CURRENT_FUNCTION;
 }
 
+VertexPrecision *VertexBufferObjectCatalog::map( StreamingVertexBufferObject *vbo, crimild::Size offset, crimild::Size size, crimild::Bool discard )
+{
+    CRIMILD_CHECK_GL_ERRORS_BEFORE_CURRENT_FUNCTION;
+
+    GLuint vaoId, vboId;
+    extractId( vbo->getCatalogId(), vaoId, vboId );
+
+    if ( getRenderer()->getStateCache()->bindVertexBuffer( vboId ) ) {
+        glBindBuffer( GL_ARRAY_BUFFER, vboId );
+    }
+
+    _mappedInGPU = false;
+
+#ifndef CRIMILD_FORCE_OPENGL_COMPATIBILITY_MODE
+    if ( discard ) {
+        // Orphan the buffer. The driver allocates new storage while
+        // the GPU is still reading from the previous one
+        glBufferData( GL_ARRAY_BUFFER, vbo->getSizeInBytes(), nullptr, GL_STREAM_DRAW );
+    }
+
+    // Segments are never written while the GPU might be reading them,
+    // so there is no need to synchronize
+    auto data = glMapBufferRange( GL_ARRAY_BUFFER, offset, size, GL_MAP_WRITE_BIT | GL_MAP_INVALIDATE_RANGE_BIT | GL_MAP_UNSYNCHRONIZED_BIT );
+    if ( data != nullptr ) {
+        _mappedInGPU = true;
+        CRIMILD_CHECK_GL_ERRORS_AFTER_CURRENT_FUNCTION;
+        return static_cast< VertexPrecision * >( data );
+    }
+#endif
+
+    // buffer mapping is not available. Write into the buffer's own storage instead
+    CRIMILD_CHECK_GL_ERRORS_AFTER_CURRENT_FUNCTION;
+    return vbo->data() + offset / sizeof( VertexPrecision );
+}
+
+void VertexBufferObjectCatalog::unmap( StreamingVertexBufferObject *vbo, crimild::Size offset, crimild::Size size )
+{
+    CRIMILD_CHECK_GL_ERRORS_BEFORE_CURRENT_FUNCTION;
+
+    GLuint vaoId, vboId;
+    extractId( vbo->getCatalogId(), vaoId, vboId );
+
+    if ( getRenderer()->getStateCache()->bindVertexBuffer( vboId ) ) {
+        glBindBuffer( GL_ARRAY_BUFFER, vboId );
+    }
+
+#ifndef CRIMILD_FORCE_OPENGL_COMPATIBILITY_MODE
+    if ( _mappedInGPU ) {
+        _mappedInGPU = false;
+        if ( glUnmapBuffer( GL_ARRAY_BUFFER ) == GL_FALSE ) {
+            Log::warning( CRIMILD_CURRENT_CLASS_NAME, "Streaming buffer contents were lost" );
+        }
+        CRIMILD_CHECK_GL_ERRORS_AFTER_CURRENT_FUNCTION;
+        return;
+    }
+#endif
+
+    glBufferSubData( GL_ARRAY_BUFFER, offset, size, vbo->getData() + offset / sizeof( VertexPrecision ) );
+
+    CRIMILD_CHECK_GL_ERRORS_AFTER_CURRENT_FUNCTION;
+}
+
@@ -29,18 +29,30 @@
 #define CRIMILD_OPENGL_VERTEX_BUFFER_OBJECT_CATALOG_
 
 #include <Rendering/Catalog.hpp>
+#include <Rendering/StreamingVertexBufferObject.hpp>
 
 namespace crimild {
     
     class VertexBufferObject;    
+    class Renderer;
 
 	namespace opengl {
 
-		class VertexBufferObjectCatalog : public Catalog< VertexBufferObject > {
+		/**
+		   \brief Manages vertex buffers in GPU memory
+
+		   Also maps streaming vertex buffers (see StreamingVertexBufferObject)
+		   once they are loaded, so vertices are written directly into GPU memory
+		 */
+		class VertexBufferObjectCatalog : 
+			public Catalog< VertexBufferObject >,
+			public StreamingVertexBufferObject::Mapper {
 		public:
-			VertexBufferObjectCatalog( void );
+			explicit VertexBufferObjectCatalog( Renderer *renderer );
 			virtual ~VertexBufferObjectCatalog( void );
 
+			Renderer *getRenderer( void ) { return _renderer; }
+
 			virtual int getNextResourceId( void ) override;
 
 			virtual void bind( ShaderProgram *program, VertexBufferObject *vbo ) override;
@@ -51,12 +63,24 @@ namespace crimild {
             
             virtual void cleanup( void ) override;
 
+			virtual VertexPrecision *map( StreamingVertexBufferObject *vbo, crimild::Size offset, crimild::Size size, crimild::Bool discard ) override;
+			virtual void unmap( StreamingVertexBufferObject *vbo, crimild::Size offset, crimild::Size size ) override;
+
 		private:
 			int composeId( unsigned int vaoId, unsigned int vboId );
 			bool extractId( int compositeId, unsigned int &vaoId, unsigned int &vboId );
             
         private:
+            Renderer *_renderer = nullptr;
             std::list< int > _unusedVBOIds;
+
+            /**
+               \brief Indicates if the last call to map() returned GPU memory
+
+               Otherwise, vertices were written into the buffer's own storage 
+               and must be uploaded when unmapping it
+             */
+            bool _mappedInGPU = false;
 		};
 
 	}
@@ -65,11 +65,11 @@ OpenGLRenderer::OpenGLRenderer( void )
 
 OpenGLRenderer::OpenGLRenderer( SharedPointer< FrameBufferObject > const &screenBuffer )
 {
-    setShaderProgramCatalog( crimild::alloc< ShaderProgramCatalog >() );
-	setVertexBufferObjectCatalog( crimild::alloc< VertexBufferObjectCatalog >() );
-	setIndexBufferObjectCatalog( crimild::alloc< IndexBufferObjectCatalog >() );
+    setShaderProgramCatalog( crimild::alloc< ShaderProgramCatalog >( this ) );
+	setVertexBufferObjectCatalog( crimild::alloc< VertexBufferObjectCatalog >( this ) );
+	setIndexBufferObjectCatalog( crimild::alloc< IndexBufferObjectCatalog >( this ) );
 	setFrameBufferObjectCatalog( crimild::alloc< FrameBufferObjectCatalog >( this ) );
-	setTextureCatalog( crimild::alloc< TextureCatalog >() );
+	setTextureCatalog( crimild::alloc< TextureCatalog >( this ) );
 
 	if ( screenBuffer != nullptr ) {
 		setScreenBuffer( screenBuffer );
@@ -193,7 +193,7 @@ void OpenGLRenderer::bindUniform( ShaderLocation *location, int value )
 {
 	CRIMILD_CHECK_GL_ERRORS_BEFORE_CURRENT_FUNCTION;
 
-	if ( location != nullptr && location->isValid() ) {
+	if ( location != nullptr && location->isValid() && getStateCache()->setUniform( location->getLocation(), value ) ) {
 		glUniform1i( location->getLocation(), value );
 	}
 
@@ -204,7 +204,7 @@ void OpenGLRenderer::bindUniform( ShaderLocation *location, float value )
 {
 	CRIMILD_CHECK_GL_ERRORS_BEFORE_CURRENT_FUNCTION;
 
-	if ( location != nullptr && location->isValid() ) {
+	if ( location != nullptr && location->isValid() && getStateCache()->setUniform( location->getLocation(), value ) ) {
 		glUniform1f( location->getLocation(), value );
 	}
 
@@ -215,7 +215,7 @@ void OpenGLRenderer::bindUniform( ShaderLocation *location, const Vector3f &vect
 {
 	CRIMILD_CHECK_GL_ERRORS_BEFORE_CURRENT_FUNCTION;
 
-	if ( location != nullptr && location->isValid() ) {
+	if ( location != nullptr && location->isValid() && getStateCache()->setUniform( location->getLocation(), vector.getData(), 3 * sizeof( GLfloat ) ) ) {
 		glUniform3fv( location->getLocation(), 1, static_cast< const GLfloat * >( vector.getData() ) );
 	}
 
@@ -226,7 +226,7 @@ void OpenGLRenderer::bindUniform( ShaderLocation *location, const Vector2f &vect
 {
 	CRIMILD_CHECK_GL_ERRORS_BEFORE_CURRENT_FUNCTION;
 
-	if ( location != nullptr && location->isValid() ) {
+	if ( location != nullptr && location->isValid() && getStateCache()->setUniform( location->getLocation(), vector.getData(), 2 * sizeof( GLfloat ) ) ) {
 		glUniform2fv( location->getLocation(), 1, static_cast< const GLfloat * >( vector.getData() ) );
 	}
 
@@ -237,7 +237,7 @@ void OpenGLRenderer::bindUniform( ShaderLocation *location, const RGBAColorf &co
 {
 	CRIMILD_CHECK_GL_ERRORS_BEFORE_CURRENT_FUNCTION;
 
-	if ( location != nullptr && location->isValid() ) {
+	if ( location != nullptr && location->isValid() && getStateCache()->setUniform( location->getLocation(), color.getData(), 4 * sizeof( GLfloat ) ) ) {
 		glUniform4fv( location->getLocation(), 1, static_cast< const GLfloat * >( color.getData() ) );
 	}
 
@@ -248,7 +248,7 @@ void OpenGLRenderer::bindUniform( ShaderLocation *location, const Matrix4f &matr
 {
 	CRIMILD_CHECK_GL_ERRORS_BEFORE_CURRENT_FUNCTION;
 
-	if ( location != nullptr && location->isValid() ) {
+	if ( location != nullptr && location->isValid() && getStateCache()->setUniform( location->getLocation(), matrix.getData(), 16 * sizeof( GLfloat ) ) ) {
 		glUniformMatrix4fv( location->getLocation(), 1, GL_FALSE, static_cast< const GLfloat * >( matrix.getData() ) );
 	}
 
@@ -263,7 +263,7 @@ void OpenGLRenderer::drawPrimitive( ShaderProgram *program, Primitive *primitive
 
 	unsigned short *base = 0;
 	glDrawElements( type,
-				   primitive->getIndexBuffer()->getIndexCount(),
+				   primitive->getIndexCount(),
 				   GL_UNSIGNED_SHORT,
 				   ( const GLvoid * ) base );
 	
@@ -290,15 +290,21 @@ void OpenGLRenderer::setAlphaState( AlphaState *state )
 {
     CRIMILD_CHECK_GL_ERRORS_BEFORE_CURRENT_FUNCTION;
     
+	auto stateCache = getStateCache();
+
 	if ( state->isEnabled() ) {
-		glEnable( GL_BLEND );
+		if ( stateCache->setBlendEnabled( true ) ) {
+			glEnable( GL_BLEND );
+		}
 
 		GLenum srcBlendFunc = OpenGLUtils::ALPHA_SRC_BLEND_FUNC[ ( uint8_t ) state->getSrcBlendFunc() ];
 		GLenum dstBlendFunc = OpenGLUtils::ALPHA_DST_BLEND_FUNC[ ( uint8_t ) state->getDstBlendFunc() ];
 
-		glBlendFunc( srcBlendFunc, dstBlendFunc );
+		if ( stateCache->setBlendFunc( srcBlendFunc, dstBlendFunc ) ) {
+			glBlendFunc( srcBlendFunc, dstBlendFunc );
+		}
 	}
-	else {
+	else if ( stateCache->setBlendEnabled( false ) ) {
 		glDisable( GL_BLEND );
 	}
     
@@ -309,17 +315,25 @@ void OpenGLRenderer::setDepthState( DepthState *state )
 {
     CRIMILD_CHECK_GL_ERRORS_BEFORE_CURRENT_FUNCTION;
     
-	if ( state->isEnabled() ) {
-		glEnable( GL_DEPTH_TEST );
-	}
-	else {
-		glDisable( GL_DEPTH_TEST );
+	auto stateCache = getStateCache();
+
+	if ( stateCache->setDepthTestEnabled( state->isEnabled() ) ) {
+		if ( state->isEnabled() ) {
+			glEnable( GL_DEPTH_TEST );
+		}
+		else {
+			glDisable( GL_DEPTH_TEST );
+		}
 	}
     
     GLenum compareFunc = OpenGLUtils::DEPTH_COMPARE_FUNC[ ( uint8_t ) state->getCompareFunc() ];
-    glDepthFunc( compareFunc );
+    if ( stateCache->setDepthFunc( compareFunc ) ) {
+        glDepthFunc( compareFunc );
+    }
     
-    glDepthMask( state->isWritable() ? GL_TRUE : GL_FALSE );
+    if ( stateCache->setDepthMask( state->isWritable() ) ) {
+        glDepthMask( state->isWritable() ? GL_TRUE : GL_FALSE );
+    }
 
     CRIMILD_CHECK_GL_ERRORS_AFTER_CURRENT_FUNCTION;
 }
@@ -328,14 +342,19 @@ void OpenGLRenderer::setCullFaceState( CullFaceState *state )
 {
     CRIMILD_CHECK_GL_ERRORS_BEFORE_CURRENT_FUNCTION;
     
+	auto stateCache = getStateCache();
+
 	if ( state->isEnabled() ) {
-	    glEnable( GL_CULL_FACE );
+		if ( stateCache->setCullFaceEnabled( true ) ) {
+		    glEnable( GL_CULL_FACE );
+		}
 
 	    GLenum mode = OpenGLUtils::CULL_FACE_MODE[ ( uint8_t ) state->getCullFaceMode() ];
-    	glCullFace( mode );
-
+	    if ( stateCache->setCullFaceMode( mode ) ) {
+	    	glCullFace( mode );
+	    }
 	}
-	else {
+	else if ( stateCache->setCullFaceEnabled( false ) ) {
 		glDisable( GL_CULL_FACE );
 	}
     
@@ -346,15 +365,17 @@ void OpenGLRenderer::setColorMaskState( ColorMaskState *state )
 {
     CRIMILD_CHECK_GL_ERRORS_BEFORE_CURRENT_FUNCTION;
     
-	if ( state->isEnabled() ) {
+	bool r = !state->isEnabled() || state->getRMask();
+	bool g = !state->isEnabled() || state->getGMask();
+	bool b = !state->isEnabled() || state->getBMask();
+	bool a = !state->isEnabled() || state->getAMask();
+
+	if ( getStateCache()->setColorMask( r, g, b, a ) ) {
 		glColorMask( 
-			state->getRMask() ? GL_TRUE : GL_FALSE,
-			state->getGMask() ? GL_TRUE : GL_FALSE,
-			state->getBMask() ? GL_TRUE : GL_FALSE,
-			state->getAMask() ? GL_TRUE : GL_FALSE );
-	}
-	else {
-		glColorMask( GL_TRUE, GL_TRUE, GL_TRUE, GL_TRUE );
+			r ? GL_TRUE : GL_FALSE,
+			g ? GL_TRUE : GL_FALSE,
+			b ? GL_TRUE : GL_FALSE,
+			a ? GL_TRUE : GL_FALSE );
 	}
 
     CRIMILD_CHECK_GL_ERRORS_AFTER_CURRENT_FUNCTION;
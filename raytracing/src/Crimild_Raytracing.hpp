@@ -30,6 +30,7 @@
 
 #include "Rendering/RTRenderer.hpp"
 #include "Rendering/RTMaterial.hpp"
+#include "Rendering/RTBVH.hpp"
 
 #include "Visitors/RTRayCaster.hpp"
 
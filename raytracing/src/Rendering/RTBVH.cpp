@@ -0,0 +1,558 @@
+#include "RTBVH.hpp"
+
+#include "SceneGraph/Geometry.hpp"
+#include "Primitives/Primitive.hpp"
+#include "Visitors/ApplyToGeometries.hpp"
+#include "Mathematics/Intersection.hpp"
+
+#include <algorithm>
+#include <limits>
+
+using namespace crimild;
+using namespace crimild::raytracing;
+
+namespace crimild {
+
+	namespace raytracing {
+
+		namespace internal {
+
+			static const crimild::Size SAH_BIN_COUNT = 12;
+
+			/**
+			   \brief Relative cost of visiting a node, compared to intersecting a triangle
+			 */
+			static const crimild::Real32 SAH_TRAVERSAL_COST = 1.0f;
+
+			struct SAHBin {
+				Vector3f min;
+				Vector3f max;
+				crimild::UInt32 count;
+			};
+
+			inline void resetBounds( Vector3f &min, Vector3f &max )
+			{
+				const auto inf = std::numeric_limits< crimild::Real32 >::infinity();
+				min = Vector3f( inf, inf, inf );
+				max = Vector3f( -inf, -inf, -inf );
+			}
+
+			inline void growBounds( Vector3f &min, Vector3f &max, const Vector3f &otherMin, const Vector3f &otherMax )
+			{
+				for ( crimild::Size i = 0; i < 3; i++ ) {
+					min[ i ] = std::min( min[ i ], otherMin[ i ] );
+					max[ i ] = std::max( max[ i ], otherMax[ i ] );
+				}
+			}
+
+			inline crimild::Real32 surfaceArea( const Vector3f &min, const Vector3f &max )
+			{
+				const auto d = max - min;
+				if ( d[ 0 ] < 0.0f || d[ 1 ] < 0.0f || d[ 2 ] < 0.0f ) {
+					// empty
+					return 0.0f;
+				}
+				return 2.0f * ( d[ 0 ] * d[ 1 ] + d[ 1 ] * d[ 2 ] + d[ 2 ] * d[ 0 ] );
+			}
+
+			inline crimild::Size computeBin( crimild::Real32 value, crimild::Real32 min, crimild::Real32 scale )
+			{
+				auto bin = static_cast< crimild::Size >( ( value - min ) * scale );
+				return std::min( bin, SAH_BIN_COUNT - 1 );
+			}
+
+			/**
+			   \brief Slab test. Returns false if the box is missed or it's farther than tMax
+			 */
+			inline bool intersectBox( const RTBVH::BVHNode &node, const Vector3f &origin, const Vector3f &invDirection, crimild::Real32 tMin, crimild::Real32 tMax )
+			{
+				for ( crimild::Size i = 0; i < 3; i++ ) {
+					auto t0 = ( node.min[ i ] - origin[ i ] ) * invDirection[ i ];
+					auto t1 = ( node.max[ i ] - origin[ i ] ) * invDirection[ i ];
+					if ( t0 > t1 ) {
+						std::swap( t0, t1 );
+					}
+					tMin = t0 > tMin ? t0 : tMin;
+					tMax = t1 < tMax ? t1 : tMax;
+					if ( tMin > tMax ) {
+						return false;
+					}
+				}
+				return true;
+			}
+
+		}
+
+	}
+
+}
+
+RTBVH::RTBVH( void )
+{
+
+}
+
+RTBVH::~RTBVH( void )
+{
+
+}
+
+void RTBVH::clear( void )
+{
+	_triangles.clear();
+	_normals.clear();
+	_owners.clear();
+	_nodes.clear();
+}
+
+void RTBVH::build( Node *scene )
+{
+	clear();
+
+	scene->perform( ApplyToGeometries( [ this ]( Geometry *geometry ) {
+		addGeometry( geometry );
+	}));
+
+	build();
+}
+
+void RTBVH::addGeometry( Geometry *geometry )
+{
+	geometry->forEachPrimitive( [ this, geometry ]( Primitive *primitive ) {
+		addPrimitive( geometry, primitive );
+	});
+}
+
+void RTBVH::addPrimitive( Geometry *geometry, Primitive *primitive )
+{
+	const auto type = primitive->getType();
+	if ( type != Primitive::Type::TRIANGLES && type != Primitive::Type::TRIANGLE_STRIP && type != Primitive::Type::TRIANGLE_FAN ) {
+		return;
+	}
+
+	auto vbo = primitive->getVertexBuffer();
+	if ( vbo == nullptr || vbo->getVertexFormat().getPositionComponents() != 3 ) {
+		return;
+	}
+
+	auto ibo = primitive->getIndexBuffer();
+	const auto indexCount = ibo != nullptr ? ibo->getIndexCount() : vbo->getVertexCount();
+	auto index = [ ibo ]( crimild::Size i ) -> crimild::Size {
+		return ibo != nullptr ? ibo->getIndexAt( i ) : i;
+	};
+
+	const auto &world = geometry->getWorld();
+	const auto hasNormals = vbo->getVertexFormat().getNormalComponents() == 3;
+
+	auto add = [ this, geometry, vbo, &world, hasNormals ]( crimild::Size a, crimild::Size b, crimild::Size c ) {
+		Vector3f positions[ 3 ];
+		Vector3f normals[ 3 ];
+		const crimild::Size indices[] = { a, b, c };
+		for ( crimild::Size i = 0; i < 3; i++ ) {
+			world.applyToPoint( vbo->getPositionAt( indices[ i ] ), positions[ i ] );
+			if ( hasNormals ) {
+				world.applyToUnitVector( vbo->getNormalAt( indices[ i ] ), normals[ i ] );
+			}
+		}
+		addTriangle( geometry, positions, hasNormals ? normals : nullptr );
+	};
+
+	switch ( type ) {
+		case Primitive::Type::TRIANGLES:
+			for ( crimild::Size i = 0; i + 2 < indexCount; i += 3 ) {
+				add( index( i ), index( i + 1 ), index( i + 2 ) );
+			}
+			break;
+
+		case Primitive::Type::TRIANGLE_STRIP:
+			for ( crimild::Size i = 0; i + 2 < indexCount; i++ ) {
+				// keep winding consistent
+				if ( i % 2 == 0 ) {
+					add( index( i ), index( i + 1 ), index( i + 2 ) );
+				}
+				else {
+					add( index( i + 1 ), index( i ), index( i + 2 ) );
+				}
+			}
+			break;
+
+		case Primitive::Type::TRIANGLE_FAN:
+			for ( crimild::Size i = 1; i + 1 < indexCount; i++ ) {
+				add( index( 0 ), index( i ), index( i + 1 ) );
+			}
+			break;
+
+		default:
+			break;
+	}
+}
+
+void RTBVH::addTriangle( Geometry *geometry, const Vector3f *positions, const Vector3f *normals )
+{
+	Triangle triangle;
+	triangle.v0 = positions[ 0 ];
+	triangle.e1 = positions[ 1 ] - positions[ 0 ];
+	triangle.e2 = positions[ 2 ] - positions[ 0 ];
+
+	TriangleNormals n;
+	if ( normals != nullptr ) {
+		n.n0 = normals[ 0 ];
+		n.n1 = normals[ 1 ];
+		n.n2 = normals[ 2 ];
+	}
+	else {
+		auto faceNormal = triangle.e1 ^ triangle.e2;
+		if ( faceNormal.getSquaredMagnitude() > 0.0f ) {
+			faceNormal.normalize();
+		}
+		n.n0 = n.n1 = n.n2 = faceNormal;
+	}
+
+	_triangles.push_back( triangle );
+	_normals.push_back( n );
+	_owners.push_back( geometry );
+}
+
+void RTBVH::build( void )
+{
+	_nodes.clear();
+
+	const auto count = static_cast< crimild::UInt32 >( _triangles.size() );
+	if ( count == 0 ) {
+		return;
+	}
+
+	_indices.resize( count );
+	_triangleMin.resize( count );
+	_triangleMax.resize( count );
+	_centroids.resize( count );
+
+	for ( crimild::UInt32 i = 0; i < count; i++ ) {
+		const auto &t = _triangles[ i ];
+		const auto v1 = t.v0 + t.e1;
+		const auto v2 = t.v0 + t.e2;
+		internal::resetBounds( _triangleMin[ i ], _triangleMax[ i ] );
+		internal::growBounds( _triangleMin[ i ], _triangleMax[ i ], t.v0, t.v0 );
+		internal::growBounds( _triangleMin[ i ], _triangleMax[ i ], v1, v1 );
+		internal::growBounds( _triangleMin[ i ], _triangleMax[ i ], v2, v2 );
+		_centroids[ i ] = 0.5f * ( _triangleMin[ i ] + _triangleMax[ i ] );
+		_indices[ i ] = i;
+	}
+
+	// a binary tree has at most 2N - 1 nodes
+	_nodes.reserve( 2 * count - 1 );
+	buildNode( 0, count );
+
+	// store triangles in the order they're referenced by leaves
+	std::vector< Triangle > triangles( count );
+	std::vector< TriangleNormals > normals( count );
+	std::vector< Node * > owners( count );
+	for ( crimild::UInt32 i = 0; i < count; i++ ) {
+		triangles[ i ] = _triangles[ _indices[ i ] ];
+		normals[ i ] = _normals[ _indices[ i ] ];
+		owners[ i ] = _owners[ _indices[ i ] ];
+	}
+	_triangles.swap( triangles );
+	_normals.swap( normals );
+	_owners.swap( owners );
+
+	_indices.clear();
+	_triangleMin.clear();
+	_triangleMax.clear();
+	_centroids.clear();
+}
+
+crimild::UInt32 RTBVH::buildNode( crimild::UInt32 begin, crimild::UInt32 end )
+{
+	const auto nodeIndex = static_cast< crimild::UInt32 >( _nodes.size() );
+	_nodes.push_back( BVHNode() );
+
+	Vector3f min, max, centroidMin, centroidMax;
+	internal::resetBounds( min, max );
+	internal::resetBounds( centroidMin, centroidMax );
+	for ( auto i = begin; i < end; i++ ) {
+		const auto idx = _indices[ i ];
+		internal::growBounds( min, max, _triangleMin[ idx ], _triangleMax[ idx ] );
+		internal::growBounds( centroidMin, centroidMax, _centroids[ idx ], _centroids[ idx ] );
+	}
+
+	_nodes[ nodeIndex ].min = min;
+	_nodes[ nodeIndex ].max = max;
+
+	const auto count = end - begin;
+
+	// find the split with the lowest cost
+	crimild::Int32 bestAxis = -1;
+	crimild::Size bestSplit = 0;
+	crimild::Real32 bestCost = std::numeric_limits< crimild::Real32 >::max();
+
+	if ( count > 2 ) {
+		for ( crimild::Size axis = 0; axis < 3; axis++ ) {
+			const auto extent = centroidMax[ axis ] - centroidMin[ axis ];
+			if ( extent <= 0.0f ) {
+				continue;
+			}
+
+			const auto scale = internal::SAH_BIN_COUNT / extent;
+
+			internal::SAHBin bins[ internal::SAH_BIN_COUNT ];
+			for ( auto &bin : bins ) {
+				internal::resetBounds( bin.min, bin.max );
+				bin.count = 0;
+			}
+
+			for ( auto i = begin; i < end; i++ ) {
+				const auto idx = _indices[ i ];
+				auto &bin = bins[ internal::computeBin( _centroids[ idx ][ axis ], centroidMin[ axis ], scale ) ];
+				internal::growBounds( bin.min, bin.max, _triangleMin[ idx ], _triangleMax[ idx ] );
+				++bin.count;
+			}
+
+			// sweep from the right, storing the cost for the right side of each split
+			crimild::Real32 rightCosts[ internal::SAH_BIN_COUNT ];
+			Vector3f rightMin, rightMax;
+			internal::resetBounds( rightMin, rightMax );
+			crimild::UInt32 rightCount = 0;
+			for ( auto b = internal::SAH_BIN_COUNT - 1; b > 0; b-- ) {
+				internal::growBounds( rightMin, rightMax, bins[ b ].min, bins[ b ].max );
+				rightCount += bins[ b ].count;
+				rightCosts[ b ] = rightCount * internal::surfaceArea( rightMin, rightMax );
+			}
+
+			Vector3f leftMin, leftMax;
+			internal::resetBounds( leftMin, leftMax );
+			crimild::UInt32 leftCount = 0;
+			for ( crimild::Size b = 1; b < internal::SAH_BIN_COUNT; b++ ) {
+				internal::growBounds( leftMin, leftMax, bins[ b - 1 ].min, bins[ b - 1 ].max );
+				leftCount += bins[ b - 1 ].count;
+				if ( leftCount == 0 || leftCount == count ) {
+					continue;
+				}
+
+				const auto cost = leftCount * internal::surfaceArea( leftMin, leftMax ) + rightCosts[ b ];
+				if ( cost < bestCost ) {
+					bestCost = cost;
+					bestAxis = axis;
+					bestSplit = b;
+				}
+			}
+		}
+	}
+
+	const auto area = internal::surfaceArea( min, max );
+	const auto leafCost = count * area;
+	const auto splitCost = internal::SAH_TRAVERSAL_COST * area + bestCost;
+
+	auto mid = begin;
+	if ( bestAxis >= 0 && ( splitCost < leafCost || count > _maxLeafSize ) ) {
+		const auto axis = bestAxis;
+		const auto scale = internal::SAH_BIN_COUNT / ( centroidMax[ axis ] - centroidMin[ axis ] );
+		const auto minValue = centroidMin[ axis ];
+		auto it = std::partition( _indices.begin() + begin, _indices.begin() + end, [ this, axis, scale, minValue, bestSplit ]( crimild::UInt32 idx ) {
+			return internal::computeBin( _centroids[ idx ][ axis ], minValue, scale ) < bestSplit;
+		});
+		mid = static_cast< crimild::UInt32 >( it - _indices.begin() );
+	}
+	else if ( bestAxis < 0 && count > _maxLeafSize ) {
+		// all centroids are the same. Split in half to keep leaves small
+		mid = begin + count / 2;
+	}
+
+	if ( mid == begin || mid == end ) {
+		auto &leaf = _nodes[ nodeIndex ];
+		leaf.offset = begin;
+		leaf.count = count;
+		leaf.miss = nodeIndex + 1;
+		return nodeIndex;
+	}
+
+	// first child is always the next node
+	buildNode( begin, mid );
+	buildNode( mid, end );
+
+	auto &node = _nodes[ nodeIndex ];
+	node.offset = 0;
+	node.count = 0;
+	node.miss = static_cast< crimild::UInt32 >( _nodes.size() );
+	return nodeIndex;
+}
+
+bool RTBVH::intersectTriangle( crimild::UInt32 index, const Vector3f &origin, const Vector3f &direction, crimild::Real32 &t, crimild::Real32 &u, crimild::Real32 &v ) const
+{
+	const auto &triangle = _triangles[ index ];
+	const auto p = direction ^ triangle.e2;
+	const auto det = triangle.e1 * p;
+	if ( det == 0.0f ) {
+		// parallel to the triangle's plane
+		return false;
+	}
+
+	const auto invDet = 1.0f / det;
+	const auto s = origin - triangle.v0;
+	u = ( s * p ) * invDet;
+	if ( u < 0.0f || u > 1.0f ) {
+		return false;
+	}
+
+	const auto q = s ^ triangle.e1;
+	v = ( direction * q ) * invDet;
+	if ( v < 0.0f || u + v > 1.0f ) {
+		return false;
+	}
+
+	t = ( triangle.e2 * q ) * invDet;
+	return true;
+}
+
+void RTBVH::computeResult( const Ray3f &ray, crimild::UInt32 triangle, crimild::Real32 t, crimild::Real32 u, crimild::Real32 v, Result &result ) const
+{
+	const auto &n = _normals[ triangle ];
+	auto normal = ( 1.0f - u - v ) * n.n0 + u * n.n1 + v * n.n2;
+	if ( normal.getSquaredMagnitude() > 0.0f ) {
+		normal.normalize();
+	}
+
+	result.t = t;
+	result.position = ray.getPointAt( t );
+	result.normal = normal;
+	result.node = _owners[ triangle ];
+}
+
+template< typename OnHit >
+void RTBVH::traverse( const Ray3f &ray, crimild::Real32 tMin, crimild::Real32 &tMax, OnHit const &onHit ) const
+{
+	const auto &origin = ray.getOrigin();
+	const auto &direction = ray.getDirection();
+	const Vector3f invDirection( 1.0f / direction[ 0 ], 1.0f / direction[ 1 ], 1.0f / direction[ 2 ] );
+
+	const auto nodeCount = static_cast< crimild::UInt32 >( _nodes.size() );
+	crimild::UInt32 current = 0;
+	while ( current < nodeCount ) {
+		const auto &node = _nodes[ current ];
+
+		if ( !internal::intersectBox( node, origin, invDirection, tMin, tMax ) ) {
+			current = node.miss;
+			continue;
+		}
+
+		if ( node.count == 0 ) {
+			++current;
+			continue;
+		}
+
+		for ( auto i = node.offset; i < node.offset + node.count; i++ ) {
+			crimild::Real32 t, u, v;
+			if ( intersectTriangle( i, origin, direction, t, u, v ) && t > tMin && t < tMax ) {
+				if ( onHit( i, t, u, v ) ) {
+					// any hit is enough
+					return;
+				}
+				tMax = t;
+			}
+		}
+
+		current = node.miss;
+	}
+}
+
+template< crimild::Size N >
+crimild::UInt32 RTBVH::traverse( const RayPacket< N > &packet, crimild::Real32 tMin, crimild::Real32 tMax, Result *results ) const
+{
+	crimild::Real32 nearest[ N ];
+	crimild::Real32 hitU[ N ];
+	crimild::Real32 hitV[ N ];
+	crimild::Int32 hits[ N ];
+	for ( crimild::Size i = 0; i < N; i++ ) {
+		nearest[ i ] = tMax;
+		hits[ i ] = -1;
+	}
+
+	const auto nodeCount = static_cast< crimild::UInt32 >( _nodes.size() );
+	crimild::UInt32 current = 0;
+	while ( current < nodeCount ) {
+		const auto &node = _nodes[ current ];
+
+		// boxes farther than the nearest hit for each ray are skipped
+		auto mask = Intersection::test( node.min, node.max, packet, nearest, tMin );
+		if ( mask == 0 ) {
+			current = node.miss;
+			continue;
+		}
+
+		if ( node.count == 0 ) {
+			++current;
+			continue;
+		}
+
+		for ( crimild::Size r = 0; r < N; r++ ) {
+			if ( ( mask & ( 1u << r ) ) == 0 ) {
+				continue;
+			}
+
+			const Vector3f origin( packet.getOriginX()[ r ], packet.getOriginY()[ r ], packet.getOriginZ()[ r ] );
+			const Vector3f direction( packet.getDirectionX()[ r ], packet.getDirectionY()[ r ], packet.getDirectionZ()[ r ] );
+			for ( auto i = node.offset; i < node.offset + node.count; i++ ) {
+				crimild::Real32 t, u, v;
+				if ( intersectTriangle( i, origin, direction, t, u, v ) && t > tMin && t < nearest[ r ] ) {
+					nearest[ r ] = t;
+					hitU[ r ] = u;
+					hitV[ r ] = v;
+					hits[ r ] = i;
+				}
+			}
+		}
+
+		current = node.miss;
+	}
+
+	crimild::UInt32 result = 0;
+	for ( crimild::Size r = 0; r < N; r++ ) {
+		if ( hits[ r ] >= 0 ) {
+			computeResult( packet.getRay( r ), hits[ r ], nearest[ r ], hitU[ r ], hitV[ r ], results[ r ] );
+			result |= ( 1u << r );
+		}
+	}
+	return result;
+}
+
+bool RTBVH::intersect( const Ray3f &ray, crimild::Real32 tMin, crimild::Real32 tMax, Result &result ) const
+{
+	crimild::Int32 hit = -1;
+	crimild::Real32 hitU = 0.0f;
+	crimild::Real32 hitV = 0.0f;
+
+	traverse( ray, tMin, tMax, [ &hit, &hitU, &hitV ]( crimild::UInt32 triangle, crimild::Real32, crimild::Real32 u, crimild::Real32 v ) {
+		hit = triangle;
+		hitU = u;
+		hitV = v;
+		return false;
+	});
+
+	if ( hit < 0 ) {
+		return false;
+	}
+
+	computeResult( ray, hit, tMax, hitU, hitV, result );
+
+	return true;
+}
+
+bool RTBVH::occluded( const Ray3f &ray, crimild::Real32 tMin, crimild::Real32 tMax ) const
+{
+	bool hit = false;
+	traverse( ray, tMin, tMax, [ &hit ]( crimild::UInt32, crimild::Real32, crimild::Real32, crimild::Real32 ) {
+		hit = true;
+		return true;
+	});
+	return hit;
+}
+
+crimild::UInt32 RTBVH::intersect( const RayPacket4f &packet, crimild::Real32 tMin, crimild::Real32 tMax, Result *results ) const
+{
+	return traverse( packet, tMin, tMax, results );
+}
+
+crimild::UInt32 RTBVH::intersect( const RayPacket8f &packet, crimild::Real32 tMin, crimild::Real32 tMax, Result *results ) const
+{
+	return traverse( packet, tMin, tMax, results );
+}
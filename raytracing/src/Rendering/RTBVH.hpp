@@ -0,0 +1,175 @@
+#ifndef CRIMILD_RAYTRACING_RENDERING_BVH_
+#define CRIMILD_RAYTRACING_RENDERING_BVH_
+
+#include "Visitors/RTRayCaster.hpp"
+
+#include "Foundation/SharedObject.hpp"
+#include "Mathematics/Vector.hpp"
+#include "Mathematics/Ray.hpp"
+#include "Mathematics/RayPacket.hpp"
+
+#include <vector>
+
+namespace crimild {
+
+	class Node;
+	class Geometry;
+	class Primitive;
+
+	namespace raytracing {
+
+		/**
+		   \brief A bounding volume hierarchy over world-space triangles
+
+		   Triangles are collected from the primitives in a scene and the 
+		   hierarchy is built once using the surface area heuristic (SAH), 
+		   evaluated over a fixed number of bins per axis.
+
+		   Nodes are stored in depth-first order, so the first child of an 
+		   interior node is always the next one in the array. Each node also
+		   keeps the index of the node to visit if its subtree is skipped, 
+		   which allows traversing the hierarchy without a stack. Subtrees
+		   farther away than the nearest hit found so far are skipped.
+		 */
+		class RTBVH : public SharedObject {
+		public:
+			using Result = RTRayCaster::Result;
+
+			struct BVHNode {
+				Vector3f min;
+				Vector3f max;
+
+				/**
+				   \brief Index of the first triangle in a leaf
+				 */
+				crimild::UInt32 offset;
+
+				/**
+				   \brief Number of triangles in a leaf, or zero for interior nodes
+				 */
+				crimild::UInt32 count;
+
+				/**
+				   \brief Index of the next node to visit if this one is skipped
+				 */
+				crimild::UInt32 miss;
+			};
+
+		public:
+			RTBVH( void );
+			virtual ~RTBVH( void );
+
+			void clear( void );
+
+			/**
+			   \brief Collects triangles from all geometries in a scene and builds the hierarchy
+
+			   World transformations must be up to date
+			 */
+			void build( Node *scene );
+
+			/**
+			   \brief Adds the world-space triangles for all primitives in a geometry
+
+			   Only triangle lists, strips and fans are supported. Call build()
+			   after adding all geometries.
+			 */
+			void addGeometry( Geometry *geometry );
+
+			void build( void );
+
+			crimild::Size getTriangleCount( void ) const { return _triangles.size(); }
+			crimild::Size getNodeCount( void ) const { return _nodes.size(); }
+			const BVHNode &getNodeAt( crimild::Size index ) const { return _nodes[ index ]; }
+
+			/**
+			   \brief Maximum number of triangles in a leaf, unless they cannot be split
+			 */
+			void setMaxLeafSize( crimild::Size value ) { _maxLeafSize = value; }
+			crimild::Size getMaxLeafSize( void ) const { return _maxLeafSize; }
+
+			/**
+			   \brief Finds the nearest triangle hit by a ray in the range ( tMin, tMax )
+
+			   Normals are interpolated if primitives include them. Otherwise,
+			   the face normal is used.
+			 */
+			bool intersect( const Ray3f &ray, crimild::Real32 tMin, crimild::Real32 tMax, Result &result ) const;
+
+			/**
+			   \brief Checks if a ray hits any triangle in the range ( tMin, tMax )
+			 */
+			bool occluded( const Ray3f &ray, crimild::Real32 tMin, crimild::Real32 tMax ) const;
+
+			/**
+			   \brief Finds the nearest triangle hit by each active ray in a packet
+
+			   The hierarchy is traversed once for the whole packet, visiting
+			   every node hit by at least one ray, and boxes are tested using
+			   SIMD kernels (see Intersection). Works best with coherent rays.
+
+			   \param results One element per ray. Only set for rays hitting a triangle
+			   \returns A mask with one bit set for every ray hitting a triangle
+			 */
+			crimild::UInt32 intersect( const RayPacket4f &packet, crimild::Real32 tMin, crimild::Real32 tMax, Result *results ) const;
+			crimild::UInt32 intersect( const RayPacket8f &packet, crimild::Real32 tMin, crimild::Real32 tMax, Result *results ) const;
+
+		private:
+			void addPrimitive( Geometry *geometry, Primitive *primitive );
+			void addTriangle( Geometry *geometry, const Vector3f *positions, const Vector3f *normals );
+
+			crimild::UInt32 buildNode( crimild::UInt32 begin, crimild::UInt32 end );
+
+			template< typename OnHit >
+			void traverse( const Ray3f &ray, crimild::Real32 tMin, crimild::Real32 &tMax, OnHit const &onHit ) const;
+
+			template< crimild::Size N >
+			crimild::UInt32 traverse( const RayPacket< N > &packet, crimild::Real32 tMin, crimild::Real32 tMax, Result *results ) const;
+
+			/**
+			   \brief Möller-Trumbore test. Returns the hit time and barycentric coordinates
+			 */
+			bool intersectTriangle( crimild::UInt32 index, const Vector3f &origin, const Vector3f &direction, crimild::Real32 &t, crimild::Real32 &u, crimild::Real32 &v ) const;
+
+			void computeResult( const Ray3f &ray, crimild::UInt32 triangle, crimild::Real32 t, crimild::Real32 u, crimild::Real32 v, Result &result ) const;
+
+		private:
+			/**
+			   \brief A triangle stored as a vertex plus two edges, for faster intersections
+			 */
+			struct Triangle {
+				Vector3f v0;
+				Vector3f e1;
+				Vector3f e2;
+			};
+
+			struct TriangleNormals {
+				Vector3f n0;
+				Vector3f n1;
+				Vector3f n2;
+			};
+
+			std::vector< Triangle > _triangles;
+			std::vector< TriangleNormals > _normals;
+			std::vector< Node * > _owners;
+			std::vector< BVHNode > _nodes;
+			crimild::Size _maxLeafSize = 8;
+
+			/**
+			   \name Build data
+			 */
+			//@{
+
+			std::vector< crimild::UInt32 > _indices;
+			std::vector< Vector3f > _triangleMin;
+			std::vector< Vector3f > _triangleMax;
+			std::vector< Vector3f > _centroids;
+
+			//@}
+		};
+
+	}
+
+}
+
+#endif
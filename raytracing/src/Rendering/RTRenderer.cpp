@@ -1,10 +1,9 @@
 #include "RTRenderer.hpp"
 #include "RTMaterial.hpp"
+#include "RTBVH.hpp"
 
-#include "Visitors/RTRayCaster.hpp"
-#include "Concurrency/Async.hpp"
+#include "Concurrency/ParallelFor.hpp"
 #include "SceneGraph/Camera.hpp"
-#include "Mathematics/Random.hpp"
 #include "Mathematics/Interpolation.hpp"
 
 #include <iostream>
@@ -23,7 +22,8 @@ using namespace crimild::raytracing;
 RTRenderer::RTRenderer( int width, int height, int samples )
 	: _width( width ),
 	  _height( height ),
-	  _samples( samples )
+	  _samples( samples ),
+	  _cancelled( false )
 {
 	
 }
@@ -35,143 +35,279 @@ RTRenderer::~RTRenderer( void )
 
 SharedPointer< Image > RTRenderer::render( SharedPointer< Node > const &scene, SharedPointer< Camera > camera ) const
 {
-	int bpp = 3;
-	std::vector< unsigned char > pixels( _width * _height * bpp );
-	
-    // this might be overkill, but we're going to create a job
-    // for each pixel in the image
-    size_t dx = 1;
-    size_t dy = 1;
-	
-	auto parentJob = crimild::concurrency::async();
-    
-    std::atomic< long > jobCount( 0 );
-    const int JOB_TOTAL = _height * _width;
-    
-	for ( size_t y = 0; y < _height; y += dy ) {
-		for ( size_t x = 0; x < _width; x += dx ) {
-			crimild::concurrency::async( parentJob, [this, &jobCount, JOB_TOTAL, camera, x, y, dx, dy, bpp, scene, &pixels ]( void ) {
-				for ( size_t t = y; t < y + dy; t++ ) {
-					for ( size_t s = x; s < x + dx; s++ ) {
-						RGBColorf c = RGBColorf::ZERO;
-						Ray3f ray;
-						if ( _samples > 1 ) {
-							for ( int sample = 0; sample < _samples; sample++ ) {
-								float u = ( float ) ( s + getRandom() ) / ( float ) _width;
-								float v = ( float ) ( t + getRandom() ) / ( float ) _height;
-								
-								camera->getPickRay( u, v, ray );
-								c += computeColor( scene, ray );							
-							}
-							c /= ( float ) _samples;
-						}
-						else {
-							float u = ( float ) s / ( float ) _width;
-							float v = ( float ) t / ( float ) _height;
-							camera->getPickRay( u, v, ray );
-							c = computeColor( scene, ray );
-						}
-						
-						// gamma correction
-						c = RGBColorf( Numericf::sqrt( c[ 0 ] ), Numericf::sqrt( c[ 1 ] ), Numericf::sqrt( c[ 2 ] ) );
-						
-						for ( int i = 0; i < bpp; i++ ) {
-							pixels[ ( t * _width + s ) * bpp + i ] = ( unsigned char )( 255.99f * c[ i ] );
-						}
-                        
-                        jobCount++;
-                        Log::debug( CRIMILD_CURRENT_CLASS_NAME, "Progress: ", jobCount, "/", JOB_TOTAL );
-					}
+	RTRenderer renderer( _width, _height, _samples );
+	renderer.setTileSize( _tileSize );
+	renderer.setPacketTracingEnabled( _packetTracingEnabled );
+	renderer.setTimeBudget( _timeBudget );
+	renderer._owner = this;
+
+	renderer.begin( scene, camera );
+
+	while ( renderer.renderPass() ) {
+		Log::debug( CRIMILD_CURRENT_CLASS_NAME, "Progress: ", renderer.getCompletedPasses(), "/", _samples );
+	}
+
+	Log::debug( CRIMILD_CURRENT_CLASS_NAME, "Done rendering frames" );
+
+	return renderer.getImage();
+}
+
+void RTRenderer::begin( SharedPointer< Node > const &scene, SharedPointer< Camera > const &camera )
+{
+	_scene = scene;
+	_camera = camera;
+
+	// triangles are collected once and shared by all jobs
+	_bvh = crimild::alloc< RTBVH >();
+	_bvh->build( crimild::get_ptr( scene ) );
+
+	_tileSize = Numeric< int >::max( 1, _tileSize );
+	_tilesX = ( _width + _tileSize - 1 ) / _tileSize;
+	_tilesY = ( _height + _tileSize - 1 ) / _tileSize;
+
+	_accumulation.assign( 3 * _width * _height, 0.0f );
+	_tileSamples.assign( _tilesX * _tilesY, 0 );
+	_completedPasses = 0;
+
+	_cancelled = false;
+	_startTime = std::chrono::steady_clock::now();
+}
+
+bool RTRenderer::shouldStop( void ) const
+{
+	if ( _cancelled || ( _owner != nullptr && _owner->isCancelled() ) ) {
+		return true;
+	}
+
+	if ( _timeBudget > 0.0 ) {
+		std::chrono::duration< double > elapsed = std::chrono::steady_clock::now() - _startTime;
+		return elapsed.count() >= _timeBudget;
+	}
+
+	return false;
+}
+
+bool RTRenderer::renderPass( void )
+{
+	if ( _bvh == nullptr || _completedPasses >= _samples || shouldStop() ) {
+		return false;
+	}
+
+	const auto tileCount = _tilesX * _tilesY;
+
+	concurrency::parallel_for( concurrency::Range( 0, tileCount ), 1, [ this ]( concurrency::Range const &tiles ) {
+		for ( auto tile = tiles.begin; tile < tiles.end; tile++ ) {
+			renderTile( static_cast< int >( tile ) );
+		}
+	});
+
+	// tiles skipped by an interrupted pass are behind
+	for ( auto samples : _tileSamples ) {
+		if ( samples <= _completedPasses ) {
+			return false;
+		}
+	}
+
+	++_completedPasses;
+	return true;
+}
+
+void RTRenderer::renderTile( int tileIndex )
+{
+	const auto pass = _tileSamples[ tileIndex ];
+	if ( pass > _completedPasses || pass >= _samples ) {
+		// already done in an interrupted pass, or finished
+		return;
+	}
+
+	if ( shouldStop() ) {
+		return;
+	}
+
+	RandomGenerator rng;
+	rng.state = 0x9E3779B9u ^ ( static_cast< crimild::UInt32 >( tileIndex ) * 0x85EBCA6Bu ) ^ ( static_cast< crimild::UInt32 >( pass + 1 ) * 0xC2B2AE35u );
+	if ( rng.state == 0 ) {
+		// xorshift does not work with a zero state
+		rng.state = 1;
+	}
+
+	const auto x0 = ( tileIndex % _tilesX ) * _tileSize;
+	const auto y0 = ( tileIndex / _tilesX ) * _tileSize;
+	const auto x1 = Numeric< int >::min( x0 + _tileSize, _width );
+	const auto y1 = Numeric< int >::min( y0 + _tileSize, _height );
+
+	auto camera = crimild::get_ptr( _camera );
+
+	Ray3f ray;
+	RayPacket8f packet;
+	RTBVH::Result hits[ RayPacket8f::SIZE ];
+	for ( int t = y0; t < y1; t++ ) {
+		for ( int s = x0; s < x1; s += RayPacket8f::SIZE ) {
+			const auto count = Numeric< int >::min( RayPacket8f::SIZE, x1 - s );
+
+			packet.clear();
+			for ( int i = 0; i < count; i++ ) {
+				// jitter samples only if there's more than one per pixel
+				const auto dx = _samples > 1 ? rng.next() : 0.0f;
+				const auto dy = _samples > 1 ? rng.next() : 0.0f;
+				const auto u = ( s + i + dx ) / ( float ) _width;
+				const auto v = ( t + dy ) / ( float ) _height;
+				camera->getPickRay( u, v, ray );
+				packet.set( i, ray );
+			}
+
+			const auto usePacket = _packetTracingEnabled && packet.isCoherent();
+			const auto mask = usePacket ? _bvh->intersect( packet, Numericf::ZERO_TOLERANCE, std::numeric_limits< float >::max(), hits ) : 0;
+
+			for ( int i = 0; i < count; i++ ) {
+				ray = packet.getRay( i );
+
+				RGBColorf c;
+				if ( !usePacket ) {
+					c = computeColor( ray, rng );
 				}
-			});
+				else if ( mask & ( 1u << i ) ) {
+					c = shade( ray, hits[ i ], rng, 0 );
+				}
+				else {
+					c = computeBackground( ray );
+				}
+
+				auto pixel = &_accumulation[ 3 * ( t * _width + s + i ) ];
+				pixel[ 0 ] += c[ 0 ];
+				pixel[ 1 ] += c[ 1 ];
+				pixel[ 2 ] += c[ 2 ];
+			}
+		}
+	}
+
+	_tileSamples[ tileIndex ] = pass + 1;
+}
+
+void RTRenderer::getFramebuffer( std::vector< float > &result ) const
+{
+	result.resize( _accumulation.size() );
+
+	for ( int t = 0; t < _height; t++ ) {
+		for ( int s = 0; s < _width; s++ ) {
+			const auto samples = _tileSamples[ ( t / _tileSize ) * _tilesX + ( s / _tileSize ) ];
+			const auto scale = samples > 0 ? 1.0f / samples : 0.0f;
+			const auto idx = 3 * ( t * _width + s );
+			for ( int i = 0; i < 3; i++ ) {
+				result[ idx + i ] = _accumulation[ idx + i ] * scale;
+			}
 		}
 	}
+}
+
+SharedPointer< Image > RTRenderer::getImage( void ) const
+{
+	int bpp = 3;
+	std::vector< unsigned char > pixels( _width * _height * bpp );
+
+	std::vector< float > colors;
+	getFramebuffer( colors );
+
+	for ( crimild::Size i = 0; i < colors.size(); i++ ) {
+		// gamma correction
+		auto c = Numericf::sqrt( Numericf::clamp( colors[ i ], 0.0f, 1.0f ) );
+		pixels[ i ] = ( unsigned char )( 255.99f * c );
+	}
+
+	return crimild::alloc< Image >( _width, _height, bpp, &pixels[ 0 ], Image::PixelFormat::RGB );
+}
+
+RGBColorf RTRenderer::computeColor( const Ray3f &r, RandomGenerator &rng, int depth ) const
+{
+	RTBVH::Result hit;
+	if ( _bvh->intersect( r, Numericf::ZERO_TOLERANCE, std::numeric_limits< float >::max(), hit ) ) {
+		return shade( r, hit, rng, depth );
+	}
+
+	return computeBackground( r );
+}
+
+RGBColorf RTRenderer::shade( const Ray3f &r, const RTBVH::Result &hit, RandomGenerator &rng, int depth ) const
+{
+	auto material = hit.node->getComponent< RTMaterial >();
+	if ( material == nullptr ) {
+		// no material, so no light is reflected
+		return RGBColorf::ZERO;
+	}
+
+	Ray3f scattered;
+	RGBColorf attenuation = material->getAlbedo();
+	RGBColorf color = RGBColorf::ZERO;
+	bool visible = true;
 	
-	crimild::concurrency::wait( parentJob );
-    Log::debug( CRIMILD_CURRENT_CLASS_NAME, "Done rendering frames" );
-    
-    auto result = crimild::alloc< Image >( _width, _height, bpp, &pixels[ 0 ], Image::PixelFormat::RGB );
-    return result;
-}
-
-RGBColorf RTRenderer::computeColor( SharedPointer< Node > const &scene, const Ray3f &r, int depth ) const
-{
-	RTRayCaster caster( r );
-	scene->perform( caster );
-	if ( caster.hasMatches() ) {
-		auto &hit = caster.getBestMatch();
-		auto material = hit.node->getComponent< RTMaterial >();
-		Ray3f scattered;
-		RGBColorf attenuation = material->getAlbedo();
-		RGBColorf color = RGBColorf::ZERO;
-		bool visible = true;
+	switch ( material->getType() ) {
+	case RTMaterial::Type::METALLIC: {
+		auto reflected = reflect( r.getDirection(), hit.normal );
+		reflected += material->getFuzz() * randomInUnitSphere( rng );
+		reflected.normalize();
+		scattered = Ray3f( hit.position, reflected );
+		visible = ( scattered.getDirection() * hit.normal > 0 );
+		break;
+	}
+	case RTMaterial::Type::DIELECTRIC: {
+		Vector3f outwardNormal;
+		Vector3f reflected = reflect( r.getDirection(), hit.normal );
+		float refIndex;
+		Vector3f refracted;
+		float reflectProb;
+		float cosine;
 		
-		switch ( material->getType() ) {
-		case RTMaterial::Type::METALLIC: {
-			auto reflected = reflect( r.getDirection(), hit.normal );
-			reflected += material->getFuzz() * randomInUnitSphere();
-			reflected.normalize();
-			scattered = Ray3f( hit.position, reflected );
-			visible = ( scattered.getDirection() * hit.normal > 0 );
-			break;
+		if ( r.getDirection() * hit.normal > 0 ) {
+			outwardNormal = -hit.normal;
+			refIndex = material->getRefractionIndex();
+			// why not assume direction is unit-length?
+			cosine = ( r.getDirection() * hit.normal ) / ( r.getDirection().getMagnitude() );
+			cosine = Numericf::sqrt( 1.0f - refIndex * refIndex * ( 1.0f - cosine * cosine ) );
 		}
-		case RTMaterial::Type::DIELECTRIC: {
-			Vector3f outwardNormal;
-			Vector3f reflected = reflect( r.getDirection(), hit.normal );
-			float refIndex;
-			Vector3f refracted;
-			float reflectProb;
-			float cosine;
-			
-			if ( r.getDirection() * hit.normal > 0 ) {
-				outwardNormal = -hit.normal;
-				refIndex = material->getRefractionIndex();
-				// why not assume direction is unit-length?
-				cosine = ( r.getDirection() * hit.normal ) / ( r.getDirection().getMagnitude() );
-				cosine = Numericf::sqrt( 1.0f - refIndex * refIndex * ( 1.0f - cosine * cosine ) );
-			}
-			else {
-				outwardNormal = hit.normal;
-				refIndex = 1.0f / material->getRefractionIndex();
-				cosine = -( r.getDirection() * hit.normal ) / ( r.getDirection().getMagnitude() );
-			}
-			
-			if ( refract( r.getDirection(), outwardNormal, refIndex, refracted ) ) {
-				reflectProb = schlick( cosine, refIndex );
-			}
-			else {
-				reflectProb = 1.0f;
-			}
-			
-			if ( getRandom() < reflectProb ) {
-				scattered = Ray3f( hit.position, reflected );
-			}
-			else {
-				scattered = Ray3f( hit.position, refracted );
-			}
-			break;
+		else {
+			outwardNormal = hit.normal;
+			refIndex = 1.0f / material->getRefractionIndex();
+			cosine = -( r.getDirection() * hit.normal ) / ( r.getDirection().getMagnitude() );
 		}
-		case RTMaterial::Type::LAMBERTIAN: 
-		default: {
-			Vector3f target = hit.normal + randomInUnitSphere();
-			scattered = Ray3f( hit.position, target.getNormalized() );
-			break;
+		
+		if ( refract( r.getDirection(), outwardNormal, refIndex, refracted ) ) {
+			reflectProb = schlick( cosine, refIndex );
 		}
-		};
-
-		// TODO: max depth as a setting?
-		if ( depth < 50 && visible ) {
-			auto color = computeColor( scene, scattered, depth + 1 );
-			color.times( attenuation );
-			return color;
+		else {
+			reflectProb = 1.0f;
+		}
+		
+		if ( rng.next() < reflectProb ) {
+			scattered = Ray3f( hit.position, reflected );
 		}
 		else {
-			// the ray has scattered enough and it's colliding against
-			// multiple surfaces. No ambient light is applied
-			return RGBColorf::ZERO;
+			scattered = Ray3f( hit.position, refracted );
 		}
+		break;
 	}
-	
+	case RTMaterial::Type::LAMBERTIAN: 
+	default: {
+		Vector3f target = hit.normal + randomInUnitSphere( rng );
+		scattered = Ray3f( hit.position, target.getNormalized() );
+		break;
+	}
+	};
+
+	// TODO: max depth as a setting?
+	if ( depth < 50 && visible ) {
+		auto color = computeColor( scattered, rng, depth + 1 );
+		color.times( attenuation );
+		return color;
+	}
+	else {
+		// the ray has scattered enough and it's colliding against
+		// multiple surfaces. No ambient light is applied
+		return RGBColorf::ZERO;
+	}
+}
+
+RGBColorf RTRenderer::computeBackground( const Ray3f &r ) const
+{
 	Vector3f unitDirection = r.getDirection().getNormalized();
 	float t = 0.5f * ( unitDirection.y() + 1.0f );
 	RGBColorf output;
@@ -179,21 +315,12 @@ RGBColorf RTRenderer::computeColor( SharedPointer< Node > const &scene, const Ra
 	return output;
 }
 
-float RTRenderer::getRandom() const
-{
-#if 1
-	return Random::generate< float >();
-#else
-	return drand48();
-#endif
-}
-
-Vector3f RTRenderer::randomInUnitSphere( void ) const
+Vector3f RTRenderer::randomInUnitSphere( RandomGenerator &rng ) const
 {
 	return Vector3f(
-		2.0f * getRandom() - 1.0f,
-		2.0f * getRandom() - 1.0f,
-		2.0f * getRandom() -1.0f )
+		2.0f * rng.next() - 1.0f,
+		2.0f * rng.next() - 1.0f,
+		2.0f * rng.next() - 1.0f )
 	.getNormalized();
 }
 
@@ -1,10 +1,16 @@
 #ifndef CRIMILD_RAYTRACING_RENDERING_RENDERER_
 #define CRIMILD_RAYTRACING_RENDERING_RENDERER_
 
+#include "RTBVH.hpp"
+
 #include "Rendering/Image.hpp"
 #include "Mathematics/Vector.hpp"
 #include "Mathematics/Ray.hpp"
 
+#include <atomic>
+#include <chrono>
+#include <vector>
+
 namespace crimild {
     
     class Node;
@@ -12,6 +18,14 @@ namespace crimild {
 
 	namespace raytracing {
 
+		/**
+		   \brief A progressive path tracer
+
+		   The image is split into square tiles that are rendered in parallel
+		   using the job scheduler (if running). Each pass adds one sample per
+		   pixel to a floating point framebuffer, so partial images can be 
+		   fetched between passes.
+		 */
 		class RTRenderer : public SharedObject {
         private:
             using Mutex = std::mutex;
@@ -21,14 +35,150 @@ namespace crimild {
 			RTRenderer( int width, int height, int samples );
 			virtual ~RTRenderer( void );
 			
+			/**
+			   \brief Renders all samples and returns the final image
+
+			   Uses its own framebuffer, so it does not interfere with 
+			   progressive rendering. Stops early if cancelled or if the 
+			   time budget is exhausted
+			 */
 			SharedPointer< Image > render( SharedPointer< Node > const &scene, SharedPointer< Camera > camera ) const;
-			
+
+			void setTileSize( int size ) { _tileSize = size; }
+			int getTileSize( void ) const { return _tileSize; }
+
+			/**
+			   \brief Traces primary rays in packets (enabled by default)
+
+			   Packets are only used if all rays point to the same octant. 
+			   Otherwise, and for all bounces, rays are traced individually.
+			 */
+			void setPacketTracingEnabled( bool enabled ) { _packetTracingEnabled = enabled; }
+			bool isPacketTracingEnabled( void ) const { return _packetTracingEnabled; }
+
 		private:
-			RGBColorf computeColor( SharedPointer< Node > const &scene, const Ray3f &r, int depth = 0 ) const;
-			
-			float getRandom() const;
+			bool _packetTracingEnabled = true;
+
+			/**
+			   \name Progressive rendering
+			 */
+			//@{
+
+		public:
+			/**
+			   \brief Prepares the scene and clears the framebuffer
+			 */
+			void begin( SharedPointer< Node > const &scene, SharedPointer< Camera > const &camera );
+
+			/**
+			   \brief Adds one sample to every pixel
+
+			   \returns false if all samples were already rendered, or if the
+			   pass was interrupted. Tiles that were not rendered in an 
+			   interrupted pass are just left with fewer samples.
+			 */
+			bool renderPass( void );
+
+			int getCompletedPasses( void ) const { return _completedPasses; }
+
+			/**
+			   \brief Number of samples accumulated by a tile so far
+			 */
+			int getTileSamples( int tileIndex ) const { return _tileSamples[ tileIndex ]; }
+			int getTileCount( void ) const { return _tilesX * _tilesY; }
+
+			/**
+			   \brief Resolves the framebuffer into an 8-bit, gamma corrected image
+			 */
+			SharedPointer< Image > getImage( void ) const;
+
+			/**
+			   \brief Resolves the framebuffer into linear RGB values
+			 */
+			void getFramebuffer( std::vector< float > &result ) const;
+
+			/**
+			   \brief Requests the current pass (and render()) to stop as soon as possible
+
+			   Can be called from any thread. Cleared by begin()
+			 */
+			void cancel( void ) { _cancelled = true; }
+			bool isCancelled( void ) const { return _cancelled; }
+
+			/**
+			   \brief Maximum time for rendering, in seconds, starting at begin(). Zero means no limit
+			 */
+			void setTimeBudget( double seconds ) { _timeBudget = seconds; }
+			double getTimeBudget( void ) const { return _timeBudget; }
+
+		private:
+			using TimePoint = std::chrono::steady_clock::time_point;
+
+			bool shouldStop( void ) const;
+
+			void renderTile( int tileIndex );
+
+			SharedPointer< Node > _scene;
+			SharedPointer< Camera > _camera;
+			SharedPointer< RTBVH > _bvh;
+
+			/**
+			   \brief Accumulated RGB values for each pixel
+			 */
+			std::vector< float > _accumulation;
+
+			/**
+			   \brief Number of samples accumulated by each tile
+			 */
+			std::vector< int > _tileSamples;
+
+			int _tileSize = 32;
+			int _tilesX = 0;
+			int _tilesY = 0;
+			int _completedPasses = 0;
+
+			std::atomic< bool > _cancelled;
+			double _timeBudget = 0.0;
+
+			/**
+			   \brief The renderer that started render(), if any. Used to forward cancellation
+			 */
+			const RTRenderer *_owner = nullptr;
+			TimePoint _startTime;
+
+			//@}
+
+		private:
+			/**
+			   \brief A small random number generator
+
+			   Each tile uses its own generator, seeded from the tile and pass 
+			   indices, so there's no shared state between jobs and results do
+			   not depend on the number of workers
+			 */
+			struct RandomGenerator {
+				crimild::UInt32 state;
+
+				float next( void )
+				{
+					// xorshift32
+					state ^= state << 13;
+					state ^= state >> 17;
+					state ^= state << 5;
+					return ( state >> 8 ) * ( 1.0f / 16777216.0f );
+				}
+			};
+
+			RGBColorf computeColor( const Ray3f &r, RandomGenerator &rng, int depth = 0 ) const;
+
+			/**
+			   \brief Computes the light reflected by a surface hit by a ray
+			 */
+			RGBColorf shade( const Ray3f &r, const RTBVH::Result &hit, RandomGenerator &rng, int depth ) const;
+
+			RGBColorf computeBackground( const Ray3f &r ) const;
 			
-			Vector3f randomInUnitSphere( void ) const;
+			Vector3f randomInUnitSphere( RandomGenerator &rng ) const;
 			
 			Vector3f reflect( const Vector3f &v, const Vector3f &n ) const;
 			
@@ -50,4 +200,3 @@ namespace crimild {
 }
 
 #endif
-
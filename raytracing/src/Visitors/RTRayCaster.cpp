@@ -33,25 +33,24 @@ void RTRayCaster::visitGeometry( Geometry *geometry )
 	float t = Intersection::find( s, getRay() );
 	if ( t > _tMin && t < _tMax ) {
 		auto p = getRay().getPointAt( t );
-		_candidates.push_back( Result {
+		_bestMatch = Result {
 			t,
 			p,
 			( p - s.getCenter() ).getNormalized(),
 			geometry
-			});
+		};
+		_hasMatches = true;
+		_tMax = t;
 	}
 }
 
 bool RTRayCaster::hasMatches( void ) const
 {
-	return _candidates.size() > 0;
+	return _hasMatches;
 }
 
 const RTRayCaster::Result &RTRayCaster::getBestMatch( void )
 {
-	_candidates.sort( []( const Result &r1, const Result &r2 ) -> bool {
-		return r1.t < r2.t;
-	});
-	return _candidates.front();
+	return _bestMatch;
 }
 
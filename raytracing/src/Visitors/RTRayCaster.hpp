@@ -5,8 +5,6 @@
 #include "Mathematics/Ray.hpp"
 #include "Visitors/NodeVisitor.hpp"
 
-#include <list>
-
 namespace crimild {
     
 	namespace raytracing {
@@ -34,7 +32,12 @@ namespace crimild {
 
 		private:
 			Ray3f _ray;
-			std::list< Result > _candidates;
+
+			/**
+			   \brief Only the nearest hit is kept. The range is narrowed every time a new one is found
+			 */
+			Result _bestMatch;
+			bool _hasMatches = false;
 			float _tMin;
 			float _tMax;
 		};
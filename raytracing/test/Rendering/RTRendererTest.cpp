@@ -0,0 +1,148 @@
+#include "Rendering/RTRenderer.hpp"
+#include "Rendering/RTMaterial.hpp"
+
+#include "Concurrency/JobScheduler.hpp"
+#include "SceneGraph/Group.hpp"
+#include "SceneGraph/Geometry.hpp"
+#include "SceneGraph/Camera.hpp"
+#include "Primitives/SpherePrimitive.hpp"
+#include "Visitors/UpdateWorldState.hpp"
+
+#include "gtest/gtest.h"
+
+using namespace crimild;
+using namespace crimild::raytracing;
+
+namespace crimild {
+
+	namespace raytracing {
+
+		static SharedPointer< Group > createRTScene( void )
+		{
+			auto scene = crimild::alloc< Group >();
+
+			auto sphere = crimild::alloc< Geometry >();
+			sphere->attachPrimitive( crimild::alloc< SpherePrimitive >( 1.0f ) );
+			sphere->attachComponent( crimild::alloc< RTMaterial >() );
+			scene->attachNode( sphere );
+
+			auto metal = crimild::alloc< Geometry >();
+			metal->attachPrimitive( crimild::alloc< SpherePrimitive >( 0.5f ) );
+			auto material = crimild::alloc< RTMaterial >();
+			material->setType( RTMaterial::Type::METALLIC );
+			metal->attachComponent( material );
+			metal->local().setTranslate( 1.5f, 0.0f, 0.0f );
+			scene->attachNode( metal );
+
+			scene->perform( UpdateWorldState() );
+
+			return scene;
+		}
+
+		static SharedPointer< Camera > createRTCamera( int width, int height )
+		{
+			auto camera = crimild::alloc< Camera >( 45.0f, ( float ) width / ( float ) height, 0.1f, 100.0f );
+			camera->local().setTranslate( 0.0f, 0.0f, 5.0f );
+			camera->perform( UpdateWorldState() );
+			return camera;
+		}
+
+	}
+
+}
+
+TEST( RTRendererTest, tileSamples )
+{
+	const int WIDTH = 20;
+	const int HEIGHT = 12;
+	const int SAMPLES = 3;
+
+	auto scene = createRTScene();
+	auto camera = createRTCamera( WIDTH, HEIGHT );
+
+	RTRenderer renderer( WIDTH, HEIGHT, SAMPLES );
+	renderer.setTileSize( 8 );
+	renderer.begin( scene, camera );
+
+	// partial tiles are included
+	ASSERT_EQ( 6, renderer.getTileCount() );
+
+	for ( int pass = 0; pass < SAMPLES; pass++ ) {
+		EXPECT_TRUE( renderer.renderPass() );
+		EXPECT_EQ( pass + 1, renderer.getCompletedPasses() );
+		for ( int tile = 0; tile < renderer.getTileCount(); tile++ ) {
+			EXPECT_EQ( pass + 1, renderer.getTileSamples( tile ) );
+		}
+	}
+
+	// no more samples are added once all passes are done
+	EXPECT_FALSE( renderer.renderPass() );
+	EXPECT_EQ( SAMPLES, renderer.getCompletedPasses() );
+	for ( int tile = 0; tile < renderer.getTileCount(); tile++ ) {
+		EXPECT_EQ( SAMPLES, renderer.getTileSamples( tile ) );
+	}
+}
+
+TEST( RTRendererTest, cancelledPass )
+{
+	auto scene = createRTScene();
+	auto camera = createRTCamera( 16, 16 );
+
+	RTRenderer renderer( 16, 16, 2 );
+	renderer.setTileSize( 8 );
+	renderer.begin( scene, camera );
+
+	renderer.cancel();
+	EXPECT_FALSE( renderer.renderPass() );
+	EXPECT_EQ( 0, renderer.getCompletedPasses() );
+	for ( int tile = 0; tile < renderer.getTileCount(); tile++ ) {
+		EXPECT_EQ( 0, renderer.getTileSamples( tile ) );
+	}
+}
+
+TEST( RTRendererTest, deterministic )
+{
+	const int WIDTH = 24;
+	const int HEIGHT = 16;
+	const int SAMPLES = 4;
+
+	auto scene = createRTScene();
+	auto camera = createRTCamera( WIDTH, HEIGHT );
+
+	RTRenderer renderer( WIDTH, HEIGHT, SAMPLES );
+	renderer.setTileSize( 8 );
+
+	renderer.begin( scene, camera );
+	while ( renderer.renderPass() ) { }
+	std::vector< float > expected;
+	renderer.getFramebuffer( expected );
+
+	// the scene is visible
+	float sum = 0.0f;
+	for ( auto c : expected ) {
+		sum += c;
+	}
+	EXPECT_GT( sum, 0.0f );
+
+	// results do not depend on the number of workers
+	concurrency::JobScheduler scheduler;
+	scheduler.configure( 3 );
+	scheduler.start();
+
+	renderer.begin( scene, camera );
+	while ( renderer.renderPass() ) { }
+	std::vector< float > result;
+	renderer.getFramebuffer( result );
+
+	auto image = renderer.render( scene, camera );
+
+	scheduler.stop();
+
+	EXPECT_EQ( expected, result );
+
+	// render() uses its own framebuffer and produces the same image
+	auto progressive = renderer.getImage();
+	ASSERT_EQ( progressive->getWidth(), image->getWidth() );
+	ASSERT_EQ( progressive->getHeight(), image->getHeight() );
+	EXPECT_EQ( 0, memcmp( progressive->getData(), image->getData(), WIDTH * HEIGHT * 3 ) );
+}
@@ -0,0 +1,15 @@
+#include "gtest/gtest.h"
+#include "gmock/gmock.h"
+
+#include <Crimild.hpp>
+
+using namespace crimild;
+
+int main( int argc, char **argv )
+{
+    crimild::init();
+
+	::testing::InitGoogleTest( &argc, argv );
+	::testing::FLAGS_gmock_verbose = "error";
+  	return RUN_ALL_TESTS();
+}